@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Process.hpp"
+
+// * Helpers of the benchmark drivers timing the .fx programs of this directory. Such a driver takes the
+// * programs to run on its command line, and runs every .fx file of the benchmarks directory by default.
+// * Each program returns a checksum from 'main' that every way of running it must agree on.
+
+namespace fridayc::bench {
+
+  using Clock = std::chrono::steady_clock;
+
+  /// @brief Runs of a program timed by best()
+  constexpr u32 RUNS = 3;
+
+  /// @brief Directory of the benchmark programs
+  inline auto directory() -> std::filesystem::path {
+    return std::filesystem::path(__FILE__).parent_path();
+  }
+
+  /// @brief Programs named on the command line, by default every .fx file of the benchmarks directory in order
+  inline auto programs(i32 argc, const i8* argv[]) -> std::vector<std::filesystem::path> {
+    std::vector<std::filesystem::path> paths;
+    for(i32 i = 1; i < argc; ++i) paths.emplace_back(argv[i]);
+
+    if(paths.empty()) {
+      for(auto const& entry : std::filesystem::directory_iterator(directory()))
+        if(entry.path().extension() == ".fx") paths.push_back(entry.path());
+      std::ranges::sort(paths);
+    }
+    return paths;
+  }
+
+  inline auto read(std::filesystem::path const& path) -> std::string {
+    std::ifstream file { path };
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    return stream.str();
+  }
+
+  inline auto milliseconds(Clock::duration duration) -> f64 {
+    return std::chrono::duration<f64, std::milli>(duration).count();
+  }
+
+  inline auto tenths(f64 value) -> f64 {
+    return std::round(value * 10) / 10;
+  }
+
+  /// @brief Best time of a few runs of a function returning the status of 'main', std::nullopt if a run failed
+  template<class Run>
+  auto best(Run&& run) -> std::pair<f64, std::optional<i64>> {
+    f64 fastest = std::numeric_limits<f64>::infinity();
+    std::optional<i64> status;
+    for(u32 i = 0; i < RUNS; ++i) {
+      const auto start = Clock::now();
+      status = run();
+      fastest = std::min(fastest, milliseconds(Clock::now() - start));
+      if(not status) break;
+    }
+    return { fastest, status };
+  }
+
+  /// @brief Runs an executable with its output discarded, std::nullopt if it did not exit by itself
+  inline auto native(std::filesystem::path const& executable) -> std::optional<i64> {
+    return spawn({ executable.string() }, NOWHERE);
+  }
+
+}
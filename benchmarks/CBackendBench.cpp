@@ -0,0 +1,70 @@
+#include "Tokenizer.hpp"
+#include "Parser.hpp"
+#include "Analyzer.hpp"
+#include "ThreadPool.hpp"
+#include "Executor.hpp"
+#include "CBackend.hpp"
+#include "Bench.hpp"
+
+using namespace fridayc;
+using namespace fridayc::bench;
+
+// * Times every benchmark program under the Executor and as a native executable built by the CBackend.
+// * The C compiler is $CC, cc by default. Native times include starting the process, and the C compile is timed apart.
+// * The executable only exits with the low byte of the checksum, which is all the runs compare.
+
+auto main(i32 argc, const i8* argv[]) -> i32 {
+  const std::vector<std::filesystem::path> paths = programs(argc, argv);
+
+  const auto scratch = std::filesystem::temp_directory_path() / "fridayc-cbackend";
+  std::filesystem::create_directories(scratch);
+
+  ThreadPool pool;
+  i32 status = 0;
+  f64 speedup = 1;
+
+  for(auto const& path : paths) {
+    const u32 file = Sources::add(path.string(), read(path));
+    auto [program, errors] = Parser(Tokenizer(Sources::text(file)).collect<std::vector>(), file).parse();
+
+    TypeTable types;
+    Analyzer analyzer(types, pool);
+    if(errors.empty()) errors = analyzer.analyze(program);
+
+    const auto source = scratch / path.filename().replace_extension(".c");
+    const auto executable = scratch / path.filename().replace_extension("");
+    CBackend backend(analyzer, types);
+    if(errors.empty()) errors = backend.generate(program);
+    if(errors.empty()) errors = backend.write(source.string());
+
+    const auto start = Clock::now();
+    if(errors.empty()) errors = CBackend::build(source.string(), executable.string());
+    const f64 compiled = milliseconds(Clock::now() - start);
+
+    if(not errors.empty()) {
+      std::cerr << "{}: does not compile"f.format(path.filename().string()) << std::endl;
+      status = 1;
+      continue;
+    }
+
+    const auto [executed, expected] = best([&]() -> std::optional<i64> {
+      std::ostringstream out;
+      Executor executor(analyzer, types, out);
+      if(not executor.run(program).empty()) return std::nullopt;
+      return executor.status();
+    });
+    const auto [ran, by_native] = best([&] { return native(executable); });
+
+    const bool agree = expected and by_native and (*expected & 0xFF) == *by_native;
+    if(not agree) status = 1;
+    speedup *= executed / ran;
+
+    std::cout << "{}: executor {} ms, native {} ms ({}x the executor), C compile {} ms{}"f.format(
+      path.filename().string(), tenths(executed), tenths(ran), tenths(executed / ran), tenths(compiled),
+      agree ? ""s : ", results differ"s) << std::endl;
+  }
+
+  if(not paths.empty())
+    std::cout << "Geometric mean: native {}x the executor"f.format(tenths(std::pow(speedup, 1. / paths.size()))) << std::endl;
+  return status;
+}
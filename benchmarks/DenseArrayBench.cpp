@@ -0,0 +1,183 @@
+#include "DenseArray.hpp"
+
+using namespace fridayc;
+using namespace fridayc::runtime;
+
+// * Times element-wise addition, multiplication and sums on N-dimensional arrays of ints and floats,
+// * stored as nested vectors, the layout of arrays of arrays, and as DenseArrays on the scalar and the AVX2 kernels.
+// * Usage: DenseArrayBench [<extent>...], by default shapes that fit in the caches and shapes of 2^22 elements.
+// * Small shapes repeat the operations over 2^24 elements in all. Every layout must agree on the int checksums.
+// * Times are the best of a few runs.
+
+namespace {
+
+  using Clock = std::chrono::steady_clock;
+
+  constexpr u32 RUNS = 5;
+
+  /// @brief Elements each run goes through, repeating the operations on small shapes
+  constexpr u64 ELEMENTS = 1 << 24;
+
+  /// @brief Arrays of arrays nested to some depth, the baseline layout
+  template<class T, u32 DEPTH>
+  struct Nested {
+    using Type = std::vector<typename Nested<T, DEPTH - 1>::Type>;
+  };
+
+  template<class T>
+  struct Nested<T, 0> {
+    using Type = T;
+  };
+
+  /// @brief Best time of a few runs of a function returning a checksum
+  template<class Run>
+  auto best(Run&& run) -> std::pair<f64, f64> {
+    f64 fastest = std::numeric_limits<f64>::infinity(), checksum = 0;
+    for(u32 i = 0; i < RUNS; ++i) {
+      const auto start = Clock::now();
+      checksum = run();
+      fastest = std::min(fastest, std::chrono::duration<f64, std::milli>(Clock::now() - start).count());
+    }
+    return { fastest, checksum };
+  }
+
+  auto tenths(f64 value) -> f64 {
+    return std::round(value * 10) / 10;
+  }
+
+  // * Int arithmetic of the baseline is checked like the kernels'
+  template<class T>
+  auto plus(T lhs, T rhs) -> T {
+    if constexpr (std::same_as<T, i64>) return runtime::sum(lhs, rhs, Span{ });
+    else return lhs + rhs;
+  }
+
+  template<class T>
+  auto times(T lhs, T rhs) -> T {
+    if constexpr (std::same_as<T, i64>) return runtime::product(lhs, rhs, Span{ });
+    else return lhs * rhs;
+  }
+
+  /// @brief Nested vectors of a shape, each element set from its flat index
+  template<class T, class Value>
+  auto nest(std::span<u64 const> extents, u64& index, Value&& value) -> T {
+    if constexpr (std::is_arithmetic_v<T>) return value(index++);
+    else {
+      T result(extents[0]);
+      for(auto& part : result) part = nest<typename T::value_type>(extents.subspan(1), index, value);
+      return result;
+    }
+  }
+
+  /// @brief Calls a function on every element of nested vectors and their counterpart in two others
+  template<class T, class Function>
+  auto zip(T const& lhs, T const& rhs, T& out, Function&& function) -> void {
+    if constexpr (std::is_arithmetic_v<T>) out = function(lhs, rhs);
+    else for(u64 i = 0; i < out.size(); ++i) zip(lhs[i], rhs[i], out[i], function);
+  }
+
+  template<class T, class Function>
+  auto visit(T const& values, Function&& function) -> void {
+    if constexpr (std::is_arithmetic_v<T>) function(values);
+    else for(auto const& part : values) visit(part, function);
+  }
+
+  /// @brief Times the operations on one shape for one element type and nesting depth
+  template<class T, u32 DEPTH>
+  auto measure(std::span<u64 const> extents, std::string const& label) -> bool {
+    using Vectors = typename Nested<T, DEPTH>::Type;
+
+    // * Small values, so int products and sums never overflow
+    const auto lhs_of = [](u64 i) { return T(i % 97) - T(48); };
+    const auto rhs_of = [](u64 i) { return T(i % 13) + T(1); };
+
+    u64 index = 0;
+    Vectors nested_lhs = nest<Vectors>(extents, index, lhs_of);
+    index = 0;
+    Vectors nested_rhs = nest<Vectors>(extents, index, rhs_of);
+    Vectors nested_out = nested_lhs;
+
+    DenseArray<T> lhs(extents, Span{ }), rhs(extents, Span{ }), out(extents, Span{ });
+    for(u64 i = 0; i < lhs.size(); ++i) lhs.data()[i] = lhs_of(i), rhs.data()[i] = rhs_of(i);
+    const u64 repeats = std::max<u64>(1, ELEMENTS / std::max<u64>(1, lhs.size()));
+
+    const auto nested = [&](auto&& operation) {
+      return best([&] {
+        T total = 0;
+        for(u64 i = 0; i < repeats; ++i) {
+          zip(nested_lhs, nested_rhs, nested_out, operation);
+          total = 0;
+          visit(nested_out, [&](T value) { total = plus(total, value); });
+        }
+        return (f64)total;
+      });
+    };
+
+    // * The float sum of the nested vectors is sequential, so checksums are compared on the int sums only
+    const auto dense = [&](Kernels const& with, bool multiply) {
+      return best([&] {
+        f64 checksum = 0;
+        for(u64 i = 0; i < repeats; ++i) {
+          if constexpr (std::same_as<T, i64>) {
+            (multiply ? with.mul : with.add)(lhs.data(), rhs.data(), out.data(), out.size());
+            i64 total = 0;
+            with.sum(out.data(), out.size(), total);
+            checksum = (f64)total;
+          } else {
+            (multiply ? with.fmul : with.fadd)(lhs.data(), rhs.data(), out.data(), out.size());
+            checksum = with.fsum(out.data(), out.size());
+          }
+        }
+        return checksum;
+      });
+    };
+
+    bool agree = true;
+    for(bool multiply : { false, true }) {
+      const auto [baseline, expected] = multiply ? nested([](T a, T b) { return times(a, b); }) : nested([](T a, T b) { return plus(a, b); });
+      std::string line = "{} {}: nested {} ms"f.format(label, multiply ? "mul+sum"sv : "add+sum"sv, tenths(baseline));
+
+      for(Kernels::Isa isa : { Kernels::Isa::SCALAR, Kernels::Isa::AVX2 }) {
+        Kernels const* with = kernels(isa);
+        if(not with) continue;
+        const auto [time, checksum] = dense(*with, multiply);
+        const bool same = std::same_as<T, f64> or checksum == expected;
+        agree = agree and same;
+        line += ", dense {} {} ms ({}x){}"f.format(with->name, tenths(time), tenths(baseline / time), same ? ""s : " differs"s);
+      }
+      std::cout << line << std::endl;
+    }
+    return agree;
+  }
+
+  template<u32 DEPTH>
+  auto measure(std::span<u64 const> extents) -> bool {
+    const std::string shape = describe(extents);
+    const bool ints = measure<i64, DEPTH>(extents, "int" + shape);
+    const bool floats = measure<f64, DEPTH>(extents, "float" + shape);
+    return ints and floats;
+  }
+
+}
+
+auto main(i32 argc, const i8* argv[]) -> i32 {
+  std::vector<std::vector<u64>> shapes;
+  if(argc > 1) {
+    shapes.emplace_back();
+    for(i32 i = 1; i < argc; ++i) shapes.back().push_back(std::stoull(argv[i]));
+  } else shapes = { { 1 << 12 }, { 64, 64 }, { 16, 16, 16 }, { 1 << 22 }, { 2048, 2048 }, { 128, 128, 256 }, { 64, 64, 32, 32 } };
+
+  std::cout << "Selected kernels: {}"f.format(kernels().name) << std::endl;
+
+  bool agree = true;
+  for(auto const& shape : shapes) {
+    switch(shape.size()) {
+      case 1: agree = measure<1>(shape) and agree; break;
+      case 2: agree = measure<2>(shape) and agree; break;
+      case 3: agree = measure<3>(shape) and agree; break;
+      case 4: agree = measure<4>(shape) and agree; break;
+      default: std::cerr << "Shapes of 1 to 4 dimensions only"s << std::endl; return 1;
+    }
+  }
+  return agree ? 0 : 1;
+}
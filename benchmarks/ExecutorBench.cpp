@@ -0,0 +1,88 @@
+#include "Tokenizer.hpp"
+#include "Parser.hpp"
+#include "Analyzer.hpp"
+#include "ThreadPool.hpp"
+#include "Interpreter.hpp"
+#include "Executor.hpp"
+#include "Bench.hpp"
+
+using namespace fridayc;
+using namespace fridayc::bench;
+
+// * Times every benchmark program under the tree-walking Interpreter and under the Executor.
+
+namespace {
+
+  /// @brief Runs 'main' through the Interpreter, with every function callable and nothing memoized
+  auto interpret(Program& program, FunctionStatement& main) -> std::optional<i64> {
+    FlatMap<FunctionStatement const*, bool> callable;
+    for(auto& stmt : *program.block)
+      if(auto* function = dynamic_cast<FunctionStatement*>(stmt.get())) callable.insert(function, true);
+
+    const EvaluationLimits limits {
+      .steps = std::numeric_limits<u64>::max(),
+      .memory = std::numeric_limits<u64>::max(),
+      .depth = 100'000,
+      .memo = 0
+    };
+    Interpreter interpreter(callable, limits);
+
+    auto name = std::make_unique<Identifier>(main.name);
+    name->binding = Binding{ Binding::Kind::FUNCTION, 0, &main };
+    CallExpression call(std::move(name));
+
+    const std::optional<Value> value = interpreter.evaluate(call);
+    if(not value or not std::holds_alternative<Long>(value->data)) return std::nullopt;
+    return std::get<Long>(value->data).unwrap();
+  }
+
+}
+
+auto main(i32 argc, const i8* argv[]) -> i32 {
+  const std::vector<std::filesystem::path> paths = programs(argc, argv);
+
+  ThreadPool pool;
+  i32 status = 0;
+  f64 product = 1;
+
+  for(auto const& path : paths) {
+    const u32 file = Sources::add(path.string(), read(path));
+    auto [program, errors] = Parser(Tokenizer(Sources::text(file)).collect<std::vector>(), file).parse();
+
+    TypeTable types;
+    Analyzer analyzer(types, pool);
+    if(errors.empty()) errors = analyzer.analyze(program);
+
+    FunctionStatement* main = nullptr;
+    for(auto& stmt : *program.block)
+      if(auto* function = dynamic_cast<FunctionStatement*>(stmt.get()); function and function->name.view() == "main"sv) main = function;
+
+    if(not errors.empty() or not main) {
+      std::cerr << "{}: does not compile"f.format(path.filename().string()) << std::endl;
+      status = 1;
+      continue;
+    }
+
+    const auto interpreted_start = Clock::now();
+    const std::optional<i64> expected = interpret(program, *main);
+    const f64 interpreted = milliseconds(Clock::now() - interpreted_start);
+
+    std::ostringstream out;
+    Executor executor(analyzer, types, out);
+    const auto executed_start = Clock::now();
+    errors = executor.run(program);
+    const f64 executed = milliseconds(Clock::now() - executed_start);
+
+    const bool agree = errors.empty() and expected == executor.status();
+    if(not agree) status = 1;
+    product *= interpreted / executed;
+
+    std::cout << "{}: interpreter {} ms, executor {} ms, {}x faster{}"f.format(
+      path.filename().string(), (i64)interpreted, (i64)executed, tenths(interpreted / executed),
+      agree ? ""s : ", results differ"s) << std::endl;
+  }
+
+  if(not paths.empty())
+    std::cout << "Geometric mean: {}x faster"f.format(tenths(std::pow(product, 1. / paths.size()))) << std::endl;
+  return status;
+}
@@ -0,0 +1,85 @@
+#include "Tokenizer.hpp"
+#include "Parser.hpp"
+#include "Analyzer.hpp"
+#include "ThreadPool.hpp"
+#include "BytecodeCompiler.hpp"
+#include "Peephole.hpp"
+#include "VirtualMachine.hpp"
+#include "Jit.hpp"
+#include "Bench.hpp"
+
+using namespace fridayc;
+using namespace fridayc::bench;
+
+// * Times every benchmark program on the VirtualMachine with threaded dispatch and on the Jit,
+// * and how long the Jit takes to compile a function.
+// * Times are the best of a few runs.
+
+auto main(i32 argc, const i8* argv[]) -> i32 {
+  if(not Jit::available()) {
+    std::cerr << "The JIT does not run on this platform" << std::endl;
+    return 1;
+  }
+
+  const std::vector<std::filesystem::path> paths = programs(argc, argv);
+
+  ThreadPool pool;
+  i32 status = 0;
+  f64 speedup = 1;
+
+  for(auto const& path : paths) {
+    const u32 file = Sources::add(path.string(), read(path));
+    auto [program, errors] = Parser(Tokenizer(Sources::text(file)).collect<std::vector>(), file).parse();
+
+    TypeTable types;
+    Analyzer analyzer(types, pool);
+    if(errors.empty()) errors = analyzer.analyze(program);
+
+    BytecodeCompiler compiler(analyzer, types);
+    if(errors.empty()) errors = compiler.compile(program);
+
+    if(not errors.empty()) {
+      std::cerr << "{}: does not compile"f.format(path.filename().string()) << std::endl;
+      status = 1;
+      continue;
+    }
+
+    Peephole peephole;
+    peephole.optimize(compiler.module());
+
+    std::ostringstream out;
+    Jit jit(compiler.module(), out);
+    const auto start = Clock::now();
+    errors = jit.compile();
+    const f64 compiled = milliseconds(Clock::now() - start) * 1000 / std::max<u64>(jit.functions().size(), 1);
+    if(not errors.empty()) {
+      std::cerr << "{}: does not compile to machine code"f.format(path.filename().string()) << std::endl;
+      status = 1;
+      continue;
+    }
+
+    const auto [threaded, expected] = best([&]() -> std::optional<i64> {
+      std::ostringstream discarded;
+      VirtualMachine vm(compiler.module(), discarded);
+      if(not vm.run(VirtualMachine::Dispatch::THREADED).empty()) return std::nullopt;
+      return vm.status();
+    });
+    const auto [native, by_jit] = best([&]() -> std::optional<i64> {
+      out.str({ });
+      if(not jit.run().empty()) return std::nullopt;
+      return jit.status();
+    });
+
+    const bool agree = expected and expected == by_jit;
+    if(not agree) status = 1;
+    speedup *= threaded / native;
+
+    std::cout << "{}: threaded {} ms, jit {} ms ({}x the vm), {} us to compile a function{}"f.format(
+      path.filename().string(), tenths(threaded), tenths(native), tenths(threaded / native), tenths(compiled),
+      agree ? ""s : ", results differ"s) << std::endl;
+  }
+
+  if(not paths.empty())
+    std::cout << "Geometric mean: jit {}x the threaded vm"f.format(tenths(std::pow(speedup, 1. / paths.size()))) << std::endl;
+  return status;
+}
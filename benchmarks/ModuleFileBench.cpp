@@ -0,0 +1,113 @@
+#include "Tokenizer.hpp"
+#include "Parser.hpp"
+#include "Analyzer.hpp"
+#include "ThreadPool.hpp"
+#include "BytecodeCompiler.hpp"
+#include "Peephole.hpp"
+#include "VirtualMachine.hpp"
+#include "ModuleFile.hpp"
+
+using namespace fridayc;
+
+// * Times the startup of a program, up to its first instruction, from its source and from a precompiled module file.
+// * From source, the program is read, tokenized, parsed, analyzed, compiled and optimized; from the module file,
+// * the file is mapped, the source is hashed, and 'main' is materialized. Both then run, and must agree on the status.
+// * Usage: ModuleFileBench [<functions>], the size of the generated program, 5000 functions by default.
+// * Times are the best of a few runs.
+
+namespace {
+
+  using Clock = std::chrono::steady_clock;
+
+  constexpr u32 RUNS = 5;
+
+  /// @brief A program of many functions, all reachable from 'main' but only a few of them called
+  auto generate(u32 functions) -> std::string {
+    std::string source;
+    for(u32 k = 0; k < functions; ++k) {
+      source += "fn f{}(n: int) -> int {{\n  let total: int = {};\n  let i: int = 0;\n"f.format(k, k);
+      if(k + 1 < functions) source += "  if n < 0 {{\n    return f{}(n);\n  }}\n"f.format(k + 1);
+      source += "  for i = 0; i < n; i += 1; {{\n    if i % 3 == 0 {{\n      total += i * {};\n    }} else {{\n      total -= {};\n    }}\n  }}\n"
+        "  return total;\n}}\n\n"f.format(k % 7 + 1, k % 5);
+    }
+    source += "fn main() -> int {{\n  return f0(100) + f{}(100);\n}}\n"f.format(functions - 1);
+    return source;
+  }
+
+  /// @brief Module of a source file, compiled the way fridayc --vm compiles it
+  auto compile(std::string const& path, ThreadPool& pool) -> std::tuple<bytecode::Module, u32, std::vector<Error>> {
+    std::ifstream stream(path, std::ios::binary);
+    std::string text { std::istreambuf_iterator<i8>(stream), std::istreambuf_iterator<i8>() };
+    const u32 source = Sources::add(path, std::move(text));
+    auto [program, errors] = Parser(Tokenizer(Sources::text(source)).collect<std::vector>(), source).parse();
+
+    TypeTable types;
+    Analyzer analyzer(types, pool);
+    if(errors.empty()) errors = analyzer.analyze(program);
+
+    BytecodeCompiler compiler(analyzer, types);
+    if(errors.empty()) errors = compiler.compile(program);
+    if(errors.empty()) Peephole().optimize(compiler.module());
+    return { std::move(compiler.module()), source, std::move(errors) };
+  }
+
+  /// @brief Best time of a few runs of a function
+  template<class Run>
+  auto best(Run&& run) -> f64 {
+    f64 fastest = std::numeric_limits<f64>::infinity();
+    for(u32 i = 0; i < RUNS; ++i) {
+      const auto start = Clock::now();
+      run();
+      fastest = std::min(fastest, std::chrono::duration<f64, std::milli>(Clock::now() - start).count());
+    }
+    return fastest;
+  }
+
+  auto machine(bytecode::Module& module) -> std::optional<i64> {
+    std::ostringstream out;
+    VirtualMachine vm(module, out);
+    if(not vm.run().empty()) return std::nullopt;
+    return vm.status();
+  }
+
+  auto hundredths(f64 value) -> f64 {
+    return std::round(value * 100) / 100;
+  }
+
+}
+
+auto main(i32 argc, const i8* argv[]) -> i32 {
+  const u32 functions = argc > 1 ? (u32)std::stoul(argv[1]) : 5000;
+
+  const auto directory = std::filesystem::temp_directory_path();
+  const std::string source_path = (directory / "ModuleFileBench.fx").string();
+  const std::string module_path = (directory / "ModuleFileBench.fxc").string();
+  std::ofstream(source_path, std::ios::binary) << generate(functions);
+
+  ThreadPool pool;
+  auto [compiled, source, errors] = compile(source_path, pool);
+  if(errors.empty()) errors = bytecode::ModuleFile::write(compiled, source, module_path);
+  if(not errors.empty()) {
+    std::cerr << "The generated program does not compile" << std::endl;
+    return 1;
+  }
+
+  const f64 compiling = best([&] { compile(source_path, pool); });
+  const f64 loading = best([&] {
+    auto [module, loaded] = bytecode::ModuleFile::load(module_path);
+    if(loaded.empty()) module.materialize(0);
+  });
+
+  auto [module, loaded] = bytecode::ModuleFile::load(module_path);
+  const std::optional<i64> expected = machine(compiled);
+  const std::optional<i64> status = loaded.empty() ? machine(module) : std::nullopt;
+
+  const bool agree = expected and expected == status;
+  std::cout << "{} functions, {} KiB of source, {} KiB of module: from source {} ms, from the module file {} ms ({}x){}"f.format(
+    functions, std::filesystem::file_size(source_path) / 1024, std::filesystem::file_size(module_path) / 1024,
+    hundredths(compiling), hundredths(loading), std::round(compiling / loading), agree ? ""s : ", results differ"s) << std::endl;
+
+  std::filesystem::remove(source_path);
+  std::filesystem::remove(module_path);
+  return agree ? 0 : 1;
+}
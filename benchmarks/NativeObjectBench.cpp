@@ -0,0 +1,79 @@
+#include "Tokenizer.hpp"
+#include "Parser.hpp"
+#include "Analyzer.hpp"
+#include "ThreadPool.hpp"
+#include "BytecodeCompiler.hpp"
+#include "Peephole.hpp"
+#include "VirtualMachine.hpp"
+#include "NativeCompiler.hpp"
+#include "Bench.hpp"
+
+using namespace fridayc;
+using namespace fridayc::bench;
+
+// * Times every benchmark program on the VirtualMachine with threaded dispatch and as an executable
+// * linked from the object of the NativeCompiler, and reports how its registers were allocated.
+// * The object is linked with $CC, cc by default, against the fridaylib of the build. Native times include starting the process.
+// * The executable only exits with the low byte of the checksum, which is all the runs compare.
+
+auto main(i32 argc, const i8* argv[]) -> i32 {
+  const std::vector<std::filesystem::path> paths = programs(argc, argv);
+
+  const auto library = directory().parent_path() / "lib";
+  const auto scratch = std::filesystem::temp_directory_path() / "fridayc-object";
+  std::filesystem::create_directories(scratch);
+
+  ThreadPool pool;
+  i32 status = 0;
+  f64 speedup = 1;
+
+  for(auto const& path : paths) {
+    const u32 file = Sources::add(path.string(), read(path));
+    auto [program, errors] = Parser(Tokenizer(Sources::text(file)).collect<std::vector>(), file).parse();
+
+    TypeTable types;
+    Analyzer analyzer(types, pool);
+    if(errors.empty()) errors = analyzer.analyze(program);
+
+    BytecodeCompiler compiler(analyzer, types);
+    if(errors.empty()) errors = compiler.compile(program);
+
+    Peephole peephole;
+    if(errors.empty()) peephole.optimize(compiler.module());
+
+    const auto object = scratch / path.filename().replace_extension(".o");
+    const auto executable = scratch / path.filename().replace_extension("");
+    NativeCompiler backend(compiler.module(), file);
+    const auto start = Clock::now();
+    if(errors.empty()) errors = backend.compile();
+    const f64 compiled = milliseconds(Clock::now() - start);
+    if(errors.empty()) errors = backend.write(object.string());
+    if(errors.empty()) errors = NativeCompiler::link(object.string(), executable.string(), library.string());
+
+    if(not errors.empty()) {
+      std::cerr << "{}: does not compile"f.format(path.filename().string()) << std::endl;
+      status = 1;
+      continue;
+    }
+
+    const auto [threaded, expected] = best([&]() -> std::optional<i64> {
+      std::ostringstream discarded;
+      VirtualMachine vm(compiler.module(), discarded);
+      if(not vm.run(VirtualMachine::Dispatch::THREADED).empty()) return std::nullopt;
+      return vm.status();
+    });
+    const auto [ran, by_native] = best([&] { return native(executable); });
+
+    const bool agree = expected and by_native and (*expected & 0xFF) == *by_native;
+    if(not agree) status = 1;
+    speedup *= threaded / ran;
+
+    std::cout << "{}: threaded {} ms, native {} ms ({}x the vm), compiled in {} ms, {} registers allocated, {} spilled{}"f.format(
+      path.filename().string(), tenths(threaded), tenths(ran), tenths(threaded / ran), tenths(compiled),
+      backend.allocatedIntervals(), backend.spilledIntervals(), agree ? ""s : ", results differ"s) << std::endl;
+  }
+
+  if(not paths.empty())
+    std::cout << "Geometric mean: native {}x the threaded vm"f.format(tenths(std::pow(speedup, 1. / paths.size()))) << std::endl;
+  return status;
+}
@@ -0,0 +1,131 @@
+#include "Tokenizer.hpp"
+#include "Parser.hpp"
+#include "Analyzer.hpp"
+#include "ThreadPool.hpp"
+#include "EscapeAnalyzer.hpp"
+#include "Executor.hpp"
+
+using namespace fridayc;
+
+// * Times programs making many short-lived structs and arrays under the Executor, with every value on the heap
+// * and with the values the escape analysis proves dead at the end of their call or loop iteration in a region.
+// * Each program returns a checksum from 'main', both runs must agree on it. Times are the best of a few runs,
+// * the allocation counts are those of one run.
+
+namespace {
+
+  using Clock = std::chrono::steady_clock;
+
+  constexpr u32 RUNS = 5;
+
+  struct Workload {
+    std::string_view name;
+    std::string_view source;
+  };
+
+  // * Arrays of every iteration, structs of every call, and arrays returned to the caller, which escape
+  constexpr Workload WORKLOADS[] = {
+    { "iteration arrays"sv, R"(
+      fn main() -> int {
+        let total: int = 0;
+        let i: int = 0;
+        for i = 0; i < 1000000; i += 1; {
+          let v: int[] = [i, i + 1, i + 2, i + 3];
+          let w: int[] = [3, 2, 1, 0];
+          total += v[0] * w[0] + v[1] * w[1] + v[2] * w[2] + v[3] * w[3];
+        }
+        return total % 1000007;
+      }
+    )"sv },
+    { "call structs"sv, R"(
+      struct Point {
+        x: int;
+        y: int;
+      }
+
+      fn distance(a: int, b: int) -> int {
+        let p: Point = Point(a, b);
+        let q: Point = Point(b, a);
+        return (p.x - q.x) * (p.x - q.x) + (p.y - q.y) * (p.y - q.y);
+      }
+
+      fn main() -> int {
+        let total: int = 0;
+        let i: int = 0;
+        for i = 0; i < 1000000; i += 1; {
+          total += distance(i % 100, i % 37);
+        }
+        return total % 1000007;
+      }
+    )"sv },
+    { "escaping arrays"sv, R"(
+      fn pair(a: int, b: int) -> int[] {
+        return [a, b];
+      }
+
+      fn main() -> int {
+        let total: int = 0;
+        let i: int = 0;
+        for i = 0; i < 1000000; i += 1; {
+          let p: int[] = pair(i, i + 1);
+          total += p[1] - p[0];
+        }
+        return total;
+      }
+    )"sv },
+  };
+
+  auto tenths(f64 value) -> f64 {
+    return std::round(value * 10) / 10;
+  }
+
+  /// @brief Best time of a few runs of a program, with the executor of the last one
+  auto best(Analyzer const& analyzer, TypeTable const& types, Program& program, EscapeAnalyzer const* escapes, i64& status) -> std::pair<f64, Box<Executor>> {
+    f64 fastest = std::numeric_limits<f64>::infinity();
+    Box<Executor> executor;
+    std::ostringstream out;
+    for(u32 i = 0; i < RUNS; ++i) {
+      executor = std::make_unique<Executor>(analyzer, types, out, ExecutionLimits{ }, escapes);
+      const auto start = Clock::now();
+      const std::vector<Error> errors = executor->run(program);
+      fastest = std::min(fastest, std::chrono::duration<f64, std::milli>(Clock::now() - start).count());
+      status = errors.empty() ? executor->status() : std::numeric_limits<i64>::min();
+    }
+    return { fastest, std::move(executor) };
+  }
+
+}
+
+auto main() -> i32 {
+  ThreadPool pool;
+  i32 status = 0;
+
+  for(Workload const& workload : WORKLOADS) {
+    const u32 file = Sources::add(std::string(workload.name), std::string(workload.source));
+    auto [program, errors] = Parser(Tokenizer(Sources::text(file)).collect<std::vector>(), file).parse();
+
+    TypeTable types;
+    Analyzer analyzer(types, pool);
+    if(errors.empty()) errors = analyzer.analyze(program);
+    if(not errors.empty()) {
+      std::cerr << "{}: does not compile"f.format(workload.name) << std::endl;
+      status = 1;
+      continue;
+    }
+
+    EscapeAnalyzer escapes;
+    escapes.analyze(program);
+
+    i64 expected = 0, result = 0;
+    const f64 heap = best(analyzer, types, program, nullptr, expected).first;
+    const auto [regions, executor] = best(analyzer, types, program, &escapes, result);
+
+    const bool agree = expected == result and expected != std::numeric_limits<i64>::min();
+    if(not agree) status = 1;
+
+    std::cout << "{}: heap {} ms, regions {} ms ({}x), {} objects in regions, {} on the heap, regions peaked at {} bytes{}"f.format(
+      workload.name, tenths(heap), tenths(regions), tenths(heap / regions), executor->regionObjects(), executor->heapObjects(),
+      executor->regions().peakBytes(), agree ? ""s : ", results differ"s) << std::endl;
+  }
+  return status;
+}
@@ -0,0 +1,112 @@
+#include "String.hpp"
+
+using namespace fridayc;
+using namespace fridayc::runtime;
+
+// * Times string building and comparison on runtime Strings against std::string, the layout of Text before them.
+// * Usage: StringBench [<pieces>], by default 2^13 pieces for each concatenation loop.
+// * Appends build 's = s + x', prepends 's = x + s', both reading the result at the end like a print would.
+// * Comparisons repeat equality tests between short, long and interned names, as for field and global lookups.
+// * Every layout must agree on the checksums. Times are the best of a few runs.
+
+namespace {
+
+  using Clock = std::chrono::steady_clock;
+
+  constexpr u32 RUNS = 5;
+
+  /// @brief Equality tests each run goes through
+  constexpr u64 COMPARISONS = 1 << 22;
+
+  /// @brief Best time of a few runs of a function returning a checksum
+  template<class Run>
+  auto best(Run&& run) -> std::pair<f64, u64> {
+    f64 fastest = std::numeric_limits<f64>::infinity();
+    u64 checksum = 0;
+    for(u32 i = 0; i < RUNS; ++i) {
+      const auto start = Clock::now();
+      checksum = run();
+      fastest = std::min(fastest, std::chrono::duration<f64, std::milli>(Clock::now() - start).count());
+    }
+    return { fastest, checksum };
+  }
+
+  auto tenths(f64 value) -> f64 {
+    return std::round(value * 10) / 10;
+  }
+
+  auto report(std::string_view label, std::pair<f64, u64> baseline, std::pair<f64, u64> measured) -> bool {
+    const bool same = baseline.second == measured.second;
+    std::cout << "{}: std::string {} ms, String {} ms ({}x){}"f.format(label, tenths(baseline.first), tenths(measured.first), tenths(baseline.first / measured.first), same ? ""s : " differs"s) << std::endl;
+    return same;
+  }
+
+  /// @brief Checksum of some contents, the same for both layouts
+  auto digest(std::string_view text) -> u64 {
+    return std::hash<std::string_view>{}(text);
+  }
+
+  /// @brief Times a concatenation loop, the copy semantics of std::string standing for the immutable Text of the runtime
+  auto concatenate(u64 pieces, u64 width, bool prepend) -> bool {
+    std::vector<std::string> parts;
+    for(u64 i = 0; i < pieces; ++i) parts.push_back(std::string(width, i8('a' + i % 26)));
+    std::vector<String> strings(parts.begin(), parts.end());
+
+    const auto baseline = best([&] {
+      std::string text;
+      for(auto const& part : parts) text = prepend ? part + text : text + part;
+      return digest(text);
+    });
+    const auto measured = best([&] {
+      String text;
+      for(auto const& part : strings) text = prepend ? part + text : text + part;
+      return digest(text.view());
+    });
+    return report("{} {} pieces of {} bytes"f.format(prepend ? "prepend"sv : "append"sv, pieces, width), baseline, measured);
+  }
+
+  /// @brief Times equality between a few names, as every lookup of a field or global compares them
+  auto compare(std::string_view label, std::vector<std::string> const& names, bool interned) -> bool {
+    std::vector<String> strings;
+    for(auto const& name : names) strings.push_back(interned ? String::intern(name) : String(name));
+
+    const auto baseline = best([&] {
+      u64 equal = 0;
+      for(u64 i = 0; i < COMPARISONS; ++i) equal += names[i % names.size()] == names[(i * 7 + 3) % names.size()];
+      return equal;
+    });
+    const auto measured = best([&] {
+      u64 equal = 0;
+      for(u64 i = 0; i < COMPARISONS; ++i) equal += strings[i % strings.size()] == strings[(i * 7 + 3) % strings.size()];
+      return equal;
+    });
+    return report(label, baseline, measured);
+  }
+
+  /// @brief Names sharing a long prefix, so comparing their contents goes through most of their bytes
+  auto names(u64 count, u64 width) -> std::vector<std::string> {
+    std::vector<std::string> result;
+    for(u64 i = 0; i < count; ++i) {
+      std::string name(width, '_');
+      name.replace(width - 4, 4, "{:04}"f.format(i % 16));
+      result.push_back(std::move(name));
+    }
+    return result;
+  }
+
+}
+
+auto main(i32 argc, const i8* argv[]) -> i32 {
+  const u64 pieces = argc > 1 ? std::stoull(argv[1]) : 1 << 13;
+
+  bool agree = true;
+  for(u64 width : { 1, 8, 32 }) {
+    agree = concatenate(pieces, width, false) and agree;
+    agree = concatenate(pieces / 4, width, true) and agree;
+  }
+
+  agree = compare("equality of short names", names(32, 12), false) and agree;
+  agree = compare("equality of long names", names(32, 48), false) and agree;
+  agree = compare("equality of long interned names", names(32, 48), true) and agree;
+  return agree ? 0 : 1;
+}
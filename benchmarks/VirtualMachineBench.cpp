@@ -0,0 +1,83 @@
+#include "Tokenizer.hpp"
+#include "Parser.hpp"
+#include "Analyzer.hpp"
+#include "ThreadPool.hpp"
+#include "Executor.hpp"
+#include "BytecodeCompiler.hpp"
+#include "Peephole.hpp"
+#include "VirtualMachine.hpp"
+#include "Bench.hpp"
+
+using namespace fridayc;
+using namespace fridayc::bench;
+
+// * Times every benchmark program on the VirtualMachine with switch dispatch, the baseline,
+// * with threaded dispatch, and with threaded dispatch but no superinstructions, next to the Executor.
+// * Times are the best of a few runs.
+
+namespace {
+
+  auto machine(bytecode::Module& module, VirtualMachine::Dispatch dispatch) -> std::optional<i64> {
+    std::ostringstream out;
+    VirtualMachine vm(module, out);
+    if(not vm.run(dispatch).empty()) return std::nullopt;
+    return vm.status();
+  }
+
+}
+
+auto main(i32 argc, const i8* argv[]) -> i32 {
+  const std::vector<std::filesystem::path> paths = programs(argc, argv);
+
+  ThreadPool pool;
+  i32 status = 0;
+  f64 threading = 1, fusing = 1;
+
+  for(auto const& path : paths) {
+    const u32 file = Sources::add(path.string(), read(path));
+    auto [program, errors] = Parser(Tokenizer(Sources::text(file)).collect<std::vector>(), file).parse();
+
+    TypeTable types;
+    Analyzer analyzer(types, pool);
+    if(errors.empty()) errors = analyzer.analyze(program);
+
+    BytecodeCompiler plain(analyzer, types), fused(analyzer, types);
+    if(errors.empty()) errors = plain.compile(program);
+    if(errors.empty()) errors = fused.compile(program);
+
+    if(not errors.empty()) {
+      std::cerr << "{}: does not compile"f.format(path.filename().string()) << std::endl;
+      status = 1;
+      continue;
+    }
+
+    Peephole peephole;
+    peephole.optimize(fused.module());
+
+    const auto [executed, expected] = best([&]() -> std::optional<i64> {
+      std::ostringstream out;
+      Executor executor(analyzer, types, out);
+      if(not executor.run(program).empty()) return std::nullopt;
+      return executor.status();
+    });
+    const auto [switched, by_switch] = best([&] { return machine(fused.module(), VirtualMachine::Dispatch::SWITCH); });
+    const auto [threaded, by_threads] = best([&] { return machine(fused.module(), VirtualMachine::Dispatch::THREADED); });
+    const auto [unfused, by_plain] = best([&] { return machine(plain.module(), VirtualMachine::Dispatch::THREADED); });
+
+    const bool agree = expected and expected == by_switch and expected == by_threads and expected == by_plain;
+    if(not agree) status = 1;
+    threading *= switched / threaded;
+    fusing *= unfused / threaded;
+
+    std::cout << "{}: executor {} ms, switch {} ms, threaded {} ms ({}x the switch), without superinstructions {} ms ({} formed){}"f.format(
+      path.filename().string(), tenths(executed), tenths(switched), tenths(threaded), tenths(switched / threaded),
+      tenths(unfused), peephole.superinstructions(), agree ? ""s : ", results differ"s) << std::endl;
+  }
+
+  if(not paths.empty()) {
+    const f64 exponent = 1. / paths.size();
+    std::cout << "Geometric mean: threaded dispatch {}x the switch, superinstructions {}x"f.format(
+      tenths(std::pow(threading, exponent)), tenths(std::pow(fusing, exponent))) << std::endl;
+  }
+  return status;
+}
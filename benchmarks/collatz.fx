@@ -0,0 +1,28 @@
+// * Collatz chains: data-dependent branches, assignments to parameters
+
+fn steps(n: int) -> int {
+  let count: int = 0;
+  while n != 1 {
+    if n % 2 == 0 {
+      n = n / 2;
+    } else {
+      n = 3 * n + 1;
+    }
+    count += 1;
+  }
+  return count;
+}
+
+fn main() -> int {
+  let longest: int = 0;
+  let start: int = 0;
+  let n: int = 0;
+  for n = 1; n < 30000; n += 1; {
+    const length: int = steps(n);
+    if length > longest {
+      longest = length;
+      start = n;
+    }
+  }
+  return start * 1000 + longest;
+}
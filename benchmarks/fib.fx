@@ -0,0 +1,12 @@
+// * Calls: two recursive calls per call, 500k calls in total
+
+fn fib(n: int) -> int {
+  if n < 2 {
+    return n;
+  }
+  return fib(n - 1) + fib(n - 2);
+}
+
+fn main() -> int {
+  return fib(27);
+}
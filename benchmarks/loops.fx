@@ -0,0 +1,13 @@
+// * Nested loops: int arithmetic on locals, no calls
+
+fn main() -> int {
+  let sum: int = 0;
+  let i: int = 0;
+  let j: int = 0;
+  for i = 0; i < 700; i += 1; {
+    for j = 0; j < 700; j += 1; {
+      sum += (i * j) % 7 + (i & j) - (j >> 2);
+    }
+  }
+  return sum;
+}
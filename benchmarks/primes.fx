@@ -0,0 +1,27 @@
+// * Trial division: a call per candidate, a 'while' loop with early returns
+
+fn prime(n: int) -> bool {
+  if n < 2 {
+    return false;
+  }
+
+  let divisor: int = 2;
+  while divisor * divisor <= n {
+    if n % divisor == 0 {
+      return false;
+    }
+    divisor += 1;
+  }
+  return true;
+}
+
+fn main() -> int {
+  let count: int = 0;
+  let n: int = 0;
+  for n = 0; n < 100000; n += 1; {
+    if prime(n) {
+      count += 1;
+    }
+  }
+  return count;
+}
@@ -0,0 +1,23 @@
+// * Strings: character subscripts, char comparisons and 'or' chains
+
+fn vowels(text: string, length: int) -> int {
+  let count: int = 0;
+  let i: int = 0;
+  for i = 0; i < length; i += 1; {
+    const c: char = text[i];
+    if c == 'a' or c == 'e' or c == 'i' or c == 'o' or c == 'u' {
+      count += 1;
+    }
+  }
+  return count;
+}
+
+fn main() -> int {
+  const text: string = "the quick brown fox jumps over the lazy dog while the cat sleeps";
+  let total: int = 0;
+  let round: int = 0;
+  for round = 0; round < 20000; round += 1; {
+    total += vowels(text, 64);
+  }
+  return total;
+}
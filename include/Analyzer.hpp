@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Resolver.hpp"
+#include "TypeChecker.hpp"
+
+namespace fridayc {
+
+  class ThreadPool;
+
+  /// @brief Runs name resolution and type checking, function bodies in parallel
+  ///
+  /// Top-level declarations, struct fields and signatures are collected
+  /// sequentially. Function bodies only read them, so they are then resolved
+  /// and checked on the pool, each worker reusing one Resolver and one
+  /// TypeChecker as scratch state for every function it analyzes. The types
+  /// the workers record are then gathered into one table. Diagnostics come
+  /// out in source order whatever the schedule.
+  class Analyzer {
+    ThreadPool&                         pool;
+    Resolver                            declarations { };
+    TypeChecker                         signatures;
+    std::vector<Box<Resolver>>          resolvers    { };
+    std::vector<Box<TypeChecker>>       checkers     { };
+    FlatMap<Visitable const*, TypeId>   types        { };
+
+    public:
+    /// @brief Constructs an analyzer
+    /// @param table the table interning the types
+    /// @param pool the pool analyzing function bodies
+    Analyzer(TypeTable& table, ThreadPool& pool);
+
+    /// @brief Resolves and checks a program
+    /// @param program the program to analyze
+    /// @return the errors, empty on success
+    auto analyze(Program& program) -> std::vector<Error>;
+
+    /// @brief Type of an analyzed expression, type name or declaration
+    /// @return the type, TypeId::ERROR if the node was not checked
+    auto typeOf(Visitable const& node) const noexcept -> TypeId;
+  };
+
+}
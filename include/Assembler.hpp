@@ -0,0 +1,68 @@
+#pragma once
+
+/// @brief Encoding of the x86-64 machine code the Jit and the NativeCompiler write
+namespace fridayc::x86 {
+
+  enum Register : u8 {
+    RAX = 0, RCX = 1, RDX = 2, RBX = 3, RSP = 4, RBP = 5, RSI = 6, RDI = 7,
+    R8 = 8, R9 = 9, R10 = 10, R11 = 11, R12 = 12, R13 = 13, R14 = 14, R15 = 15
+  };
+
+  enum Condition : u8 { O = 0x0, B = 0x2, AE = 0x3, E = 0x4, NE = 0x5, A = 0x7, P = 0xA, NP = 0xB, L = 0xC, LE = 0xE };
+
+  /// @brief Encodes the handful of x86-64 forms the templates are made of
+  ///
+  /// Memory operands are always a base register plus a displacement, and
+  /// jumps always take a 32-bit displacement, returned as its position so
+  /// it can be patched once the target is known.
+  class Assembler {
+    std::vector<u8> bytes { };
+
+    public:
+    auto size() const noexcept -> u32;
+    auto code() const noexcept -> std::vector<u8> const&;
+
+    auto byte(u8 value) -> void;
+    auto raw(std::initializer_list<u8> values) -> void;
+    auto dword(u32 value) -> void;
+    auto qword(u64 value) -> void;
+
+    /// @brief REX prefix, left out when it would be empty
+    auto rex(bool wide, u8 reg, u8 base) -> void;
+
+    /// @brief ModRM of [base + disp], the shortest displacement that holds it
+    auto memory(u8 reg, u8 base, i32 disp) -> void;
+
+    /// @brief op reg, [base + disp], with a one or two byte opcode
+    auto load(u16 op, u8 reg, u8 base, i32 disp, bool wide = true) -> void;
+
+    /// @brief mov [base + disp], reg
+    auto store(u8 base, i32 disp, u8 reg, bool wide = true) -> void;
+
+    /// @brief op reg, rm between two registers, with a one or two byte opcode
+    auto direct(u16 op, u8 reg, u8 rm, bool wide = true) -> void;
+
+    /// @brief op [base + disp] with the register field of the ModRM holding an opcode extension
+    auto group(u8 op, u8 extension, u8 base, i32 disp, bool wide = true) -> void;
+
+    /// @brief Scalar double instruction between an xmm register and [base + disp]
+    auto sse(u8 prefix, u8 op, u8 xmm, u8 base, i32 disp) -> void;
+
+    /// @brief movq xmm, reg, or movq reg, xmm when to_general
+    auto movq(u8 xmm, u8 reg, bool to_general) -> void;
+
+    /// @brief mov reg, imm, in 32 bits when the value allows it
+    auto immediate(u8 reg, u64 value) -> void;
+
+    /// @brief setcc al, then zero-extends it to rax
+    auto set(Condition condition) -> void;
+
+    auto jump(Condition condition) -> u32;
+    auto jump() -> u32;
+    auto call() -> u32;
+
+    /// @brief Points the displacement at a position to a target
+    auto patch(u32 position, u32 target) noexcept -> void;
+  };
+
+}
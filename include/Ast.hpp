@@ -5,6 +5,8 @@
 
 namespace fridayc {
 
+  class ThreadPool;
+
   /// @brief A program is a list of statements
   struct Program final : public Visitable {
 
@@ -13,6 +15,17 @@ namespace fridayc {
 
     auto toString() const noexcept -> std::string;
 
+    /// @brief Converts the program into the same std::string as toString(), serializing top-level statements in parallel
+    /// @param pool the pool running the serialization tasks
+    /// @return std::string representation
+    auto toString(ThreadPool& pool) const -> std::string;
+
+    /// @brief Streams the representation of toString() to an output stream
+    /// @note Top-level statements are serialized in parallel and written in order as soon as they are ready
+    /// @param stream the output stream
+    /// @param pool the pool running the serialization tasks
+    auto write(std::ostream& stream, ThreadPool& pool) const -> void;
+
     auto operator()(Visitor& visitor) noexcept -> std::any override;
 
     /// @brief Block of statements
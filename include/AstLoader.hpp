@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Ast.hpp"
+#include "Error.hpp"
+
+namespace fridayc {
+
+  /// @brief Rebuilds an abstract syntax tree from the JSON written by Program::toString()
+  ///
+  /// The reader is specialized for that schema: it makes a single pass over
+  /// the text and constructs nodes directly, without an intermediate document.
+  /// Every node object must start with its "type" key, the remaining keys may
+  /// come in any order and unknown ones are skipped. Loading stops at the first
+  /// error. Loaded nodes have empty spans.
+  class AstLoader {
+    std::vector<Error> error_queue { };
+    std::string_view   input       { };
+    std::string        scratch     { };
+    u64                pos         { 0 };
+    u32                file        { Sources::NONE };
+
+    public:
+    /// @brief Constructs a loader for a registered source
+    /// @param file identifier of the registered JSON text, which must outlive the tree since unescaped strings are referenced in place
+    AstLoader(u32 file) noexcept;
+
+    /// @brief Loads the program
+    /// @return abstract syntax tree or errors
+    auto load() -> std::tuple<Program, std::vector<Error>>;
+
+    private:
+    using StatementLoader  = Box<Statement>(AstLoader::*)();
+    using ExpressionLoader = Box<Expression>(AstLoader::*)();
+
+    static const std::map<std::string_view, StatementLoader>  stmtLoaders;
+    static const std::map<std::string_view, ExpressionLoader> exprLoaders;
+    static const std::map<std::string_view, Token::Type>      operators;
+
+    auto good() const noexcept -> bool;
+    auto errorAt(u64 offset, std::string error) noexcept -> void;
+
+    auto skipWhitespace() noexcept -> void;
+    auto peek() noexcept -> i8;
+    auto expect(i8 c) noexcept -> void;
+
+    auto readString(bool* escaped = nullptr) noexcept -> std::string_view;
+    auto readSymbol() noexcept -> Symbol;
+    auto readInteger() noexcept -> i64;
+    auto readDouble() noexcept -> f64;
+    auto readBool() noexcept -> bool;
+    auto readOperator() noexcept -> Token::Type;
+    auto skipValue() noexcept -> void;
+
+    auto beginNode() noexcept -> std::string_view;
+    auto nextKey(std::string_view& key) noexcept -> bool;
+    auto nextElement(bool& first) noexcept -> bool;
+    auto require(void const* child, std::string_view node, std::string_view key, u64 at) noexcept -> void;
+
+    auto loadStatement() noexcept -> Box<Statement>;
+    auto loadExpression() noexcept -> Box<Expression>;
+    auto loadType() noexcept -> Box<TypeExpression>;
+    auto loadTypeFields() noexcept -> Box<TypeExpression>;
+    auto loadBlock() noexcept -> Box<BlockStatement>;
+    auto loadBlockFields() noexcept -> Box<BlockStatement>;
+    auto loadMembers(Members& members, std::string_view kind) noexcept -> void;
+    auto loadArguments(Container<Box<Expression>>& arguments) noexcept -> void;
+
+    auto loadExpressionStatement() noexcept -> Box<Statement>;
+    auto loadPrintStatement() noexcept -> Box<Statement>;
+    auto loadReturnStatement() noexcept -> Box<Statement>;
+    auto loadBlockStatement() noexcept -> Box<Statement>;
+    auto loadIfStatement() noexcept -> Box<Statement>;
+    auto loadWhileStatement() noexcept -> Box<Statement>;
+    auto loadForStatement() noexcept -> Box<Statement>;
+    auto loadStructStatement() noexcept -> Box<Statement>;
+    auto loadEnumStatement() noexcept -> Box<Statement>;
+    auto loadFunctionStatement() noexcept -> Box<Statement>;
+    auto loadNamespaceStatement() noexcept -> Box<Statement>;
+    auto loadUsingStatement() noexcept -> Box<Statement>;
+    auto loadDeclarationStatement() noexcept -> Box<Statement>;
+
+    auto loadIdentifier() noexcept -> Box<Expression>;
+    auto loadBoolLiteral() noexcept -> Box<Expression>;
+    auto loadObjectLiteral() noexcept -> Box<Expression>;
+    auto loadStringLiteral() noexcept -> Box<Expression>;
+    auto loadFloatLiteral() noexcept -> Box<Expression>;
+    auto loadIntLiteral() noexcept -> Box<Expression>;
+    auto loadCharLiteral() noexcept -> Box<Expression>;
+    auto loadArrayLiteral() noexcept -> Box<Expression>;
+    auto loadTypeExpression() noexcept -> Box<Expression>;
+    auto loadPrefixExpression() noexcept -> Box<Expression>;
+    auto loadInfixExpression() noexcept -> Box<Expression>;
+    auto loadCallExpression() noexcept -> Box<Expression>;
+    auto loadSubscriptExpression() noexcept -> Box<Expression>;
+  };
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Visitable.hpp"
+
+namespace fridayc {
+
+  /// @brief What a name refers to, filled by the Resolver
+  struct Binding {
+
+    enum struct Kind : u8 {
+      UNRESOLVED,
+      LOCAL,      // * declaration: DeclarationStatement, slot: frame slot
+      PARAMETER,  // * declaration: FunctionStatement, slot: frame slot (the parameter position)
+      FUNCTION,   // * declaration: FunctionStatement
+      STRUCT,     // * declaration: StructStatement
+      ENUM,       // * declaration: EnumStatement
+      CONSTANT,   // * declaration: EnumStatement, slot: ordinal of the constant
+      NAMESPACE,  // * declaration: NamespaceStatement
+      MEMBER,     // * right-hand side of a member access, left to the type checker
+      BUILTIN,    // * primitive type name
+    };
+
+    /// @brief Kind of the referenced declaration
+    Kind kind { Kind::UNRESOLVED };
+
+    /// @brief Frame slot or ordinal, meaning depends on the kind
+    u32 slot { 0 };
+
+    /// @brief Node declaring the name, nullptr for builtins and unresolved names
+    Visitable* declaration { nullptr };
+
+    constexpr auto resolved() const noexcept -> bool {
+      return kind != Kind::UNRESOLVED;
+    }
+  };
+
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "Walker.hpp"
+#include "FlatMap.hpp"
+
+namespace fridayc {
+
+  /// @brief How much checking a subscript needs to stay within its array
+  struct BoundsCheck {
+
+    enum struct Kind : u8 {
+      CHECKED,    // * the index is checked on every access
+      HOISTED,    // * one check on entry to the loop covers every access the loop makes
+      IN_BOUNDS,  // * the index is always within the array, no check is needed
+    };
+
+    /// @brief An invariant expression added to or subtracted from the index
+    struct Term {
+      Expression const* expr;
+      bool              negated;
+    };
+
+    /// @brief Kind of the check
+    Kind kind { Kind::CHECKED };
+
+    /// @brief For HOISTED, the 'for' or 'while' loop whose entry performs the check
+    Statement const* loop { nullptr };
+
+    /// @brief Induction variable of the loop, nullptr when the index is the same on every iteration
+    Identifier const* variable { nullptr };
+
+    /// @brief Bound the variable is compared with in the condition of the loop
+    Expression const* bound { nullptr };
+
+    /// @brief Positive amount the variable steps by after each iteration
+    i64 step { 0 };
+
+    /// @brief Whether the variable counts up towards the bound
+    bool ascending { true };
+
+    /// @brief Whether the variable can reach the bound ('<=' and '>=')
+    bool inclusive { false };
+
+    /// @brief The index is scale * variable + offset + the terms
+    i64 scale { 0 };
+    i64 offset { 0 };
+    std::vector<Term> terms { };
+  };
+
+  /// @brief Classifies every array and string subscript by the bounds check it needs
+  ///
+  /// The language has no way to ask for the length of an array, so lengths
+  /// are only known for string literals and for constants holding a string
+  /// or array literal. A subscript of such a value by an index whose range
+  /// is known is IN_BOUNDS.
+  ///
+  /// Other subscripts inside a loop are HOISTED when the array is a local
+  /// the loop leaves alone and the index is an affine function of the
+  /// induction variable of the loop, plus locals the loop leaves alone. The
+  /// variable must be stepped by a literal, as the last statement of a
+  /// 'while' body or as the modifier of a 'for', and compared with an
+  /// invariant bound in the condition. On entry to the loop, after the
+  /// initializer of a 'for', the variable holds its first value and the
+  /// bound its last, so checking the index at both ends, and that stepping
+  /// past the last value does not overflow, covers every iteration. When
+  /// the check fails the loop must still run with full checks, as the
+  /// failing access may never happen. An index that is the same on every
+  /// iteration is checked on entry to the outermost loop it does not
+  /// depend on. Subscripts in the condition and modifier of a loop belong
+  /// to the enclosing loop.
+  ///
+  /// Everything else is CHECKED. Runs on a resolved program.
+  class BoundsAnalyzer : public Walker {
+    struct Loop {
+      Statement const*  statement { nullptr };
+      std::vector<bool> variant   { };
+      Identifier const* variable  { nullptr };
+      Expression const* first     { nullptr };
+      Expression const* bound     { nullptr };
+      i64               step      { 0 };
+      bool              ascending { true };
+      bool              inclusive { false };
+    };
+
+    FunctionStatement const*                             function { nullptr };
+    std::vector<Loop>                                    loops    { };
+    FlatMap<SubscriptExpression const*, BoundsCheck>     checks   { };
+    std::vector<SubscriptExpression const*>              order    { };
+    u64                                                  counts[3] { 0, 0, 0 };
+
+    public:
+    /// @brief Classifies every subscript of a resolved program
+    /// @param program the program to analyze
+    auto analyze(Program& program) -> void;
+
+    /// @brief Finds the classification of a subscript
+    /// @param subscript a subscript of the analyzed program
+    /// @return the check, nullptr for subscripts outside of functions
+    auto check(SubscriptExpression const& subscript) const noexcept -> BoundsCheck const*;
+
+    /// @brief Number of subscripts classified as a kind
+    auto count(BoundsCheck::Kind kind) const noexcept -> u64;
+
+    /// @brief Writes the classification of every subscript, one per line, in the order of the program
+    /// @param out the stream to write to
+    auto report(std::ostream& out) const -> void;
+
+    using Walker::operator();
+
+    auto operator()(SubscriptExpression& arg) noexcept -> std::any override;
+    auto operator()(WhileStatement& arg) noexcept -> std::any override;
+    auto operator()(ForStatement& arg) noexcept -> std::any override;
+    auto operator()(FunctionStatement& arg) noexcept -> std::any override;
+
+    private:
+    auto enter(Statement const& stmt, Expression& condition, Expression* modifier, Expression* initializer, BlockStatement& block) noexcept -> void;
+    auto classify(SubscriptExpression const& arg) const noexcept -> BoundsCheck;
+    auto invariant(Expression const& expr, Loop const& loop) const noexcept -> bool;
+    auto affine(Expression const& expr, Loop const& loop, BoundsCheck& into, bool negated) const noexcept -> bool;
+    auto length(Expression const& array) const noexcept -> std::optional<i64>;
+    auto within(BoundsCheck const& check, Loop const* loop, i64 length) const noexcept -> bool;
+  };
+
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Runtime.hpp"
+
+/// @brief Register bytecode run by the VirtualMachine
+namespace fridayc::bytecode {
+
+  /// @brief Operation of an instruction, operands are named a, b and c
+  ///
+  /// Registers are numbered from the start of the frame. Scalars are
+  /// copied by their bits, references by their object, so every move,
+  /// load and store comes in both forms. Jumps take their target in c.
+  enum struct Opcode : u8 {
+    // * a = b, a = constants[b] of the module, a = zero and null
+    MOVE, MOVE_REF, CONSTANT, CLEAR,
+
+    // * a = b op c on ints, checked like the Executor
+    ADD, SUB, MUL, DIV, MOD, BIT_AND, BIT_OR, SHL, SHR,
+
+    // * a = op b on ints, a = b + c with c a signed immediate
+    NEG, BIT_NOT, ADD_IMM,
+
+    // * a = b op c, a = op b on floats
+    FADD, FSUB, FMUL, FDIV, FNEG,
+
+    // * a = b op c on ints, bools, chars and enum constants, on floats, by identity and on strings by value
+    EQ, NE, LT, LE, FEQ, FNE, FLT, FLE, REQ, RNE, SEQ, SNE,
+
+    // * a = not b, a = b + c on strings
+    NOT, CONCAT,
+
+    // * a = new struct or array of b cells, a = field c of b, field b of a = c
+    NEW, GET_FIELD, GET_FIELD_REF, SET_FIELD, SET_FIELD_REF,
+
+    // * a = b[c], a[b] = c, a = character c of the string b
+    GET_ELEM, GET_ELEM_REF, SET_ELEM, SET_ELEM_REF, GET_CHAR,
+
+    // * Jump to c, always, if a is true, if a is false, if a op b on ints
+    JUMP, JUMP_IF, JUMP_IF_NOT, JEQ, JNE, JLT, JLE,
+
+    // * a += 1, then jump to c if a < b
+    INC_JLT,
+
+    // * a = functions[b](c, c + 1...), the frame of the callee starts at register c
+    CALL,
+
+    // * Return a, return nothing, or fault on a function that ended without returning a value
+    RETURN, RETURN_REF, RETURN_VOID, FALL_OFF,
+
+    // * Print a with the format b of the module
+    PRINT,
+
+    COUNT
+  };
+
+  /// @brief Name of an opcode, as the disassembly shows it
+  auto nameOf(Opcode op) noexcept -> std::string_view;
+
+  /// @brief Tells whether an opcode jumps to c
+  constexpr auto jumps(Opcode op) noexcept -> bool;
+
+  /// @brief Tells whether an opcode writes a scalar to a and nothing else
+  constexpr auto producesScalar(Opcode op) noexcept -> bool;
+
+  /// @brief Tells whether an opcode writes a reference to a and nothing else
+  constexpr auto producesReference(Opcode op) noexcept -> bool;
+
+  struct Instruction {
+    Opcode op { Opcode::RETURN_VOID };
+    u16    a  { 0 };
+    u16    b  { 0 };
+    u16    c  { 0 };
+  };
+
+  static_assert(sizeof(Instruction) == 8);
+
+  /// @brief A compiled function
+  ///
+  /// Its frame holds the parameters and locals first, at the slots the
+  /// analysis gave them, then one register per distinct scalar constant,
+  /// copied from the constant pool on entry, then the temporaries.
+  struct Function {
+    Symbol                   name          { };
+    Span                     span          { };
+    std::vector<Instruction> code          { };
+
+    /// @brief Span of every instruction, for the faults it raises
+    std::vector<Span>        spans         { };
+
+    /// @brief Bits of the scalar constants, in register order
+    std::vector<i64>         constants     { };
+    u16                      parameters    { 0 };
+    u16                      constant_base { 0 };
+    u16                      temporaries   { 0 };
+    u16                      registers     { 0 };
+
+    /// @brief Whether any register may hold a reference, they are released on return then
+    bool                     references    { false };
+  };
+
+  class ModuleFile;
+
+  /// @brief Functions of a program reachable from 'main', which is the first one
+  struct Module {
+    /// @brief Functions, those of a module file have no code until they are materialized
+    std::vector<Function>                         functions   { };
+
+    /// @brief String constants
+    std::vector<runtime::Ref>                     constants   { };
+
+    /// @brief Formats of the printed types, owned by the printer
+    std::vector<runtime::Printer::Format const*>  formats     { };
+    Box<runtime::Printer>                         printer     { };
+
+    /// @brief Shape of every format in the printer
+    std::vector<u32>                              shapes      { };
+
+    /// @brief Whether 'main' returns an int, which is then the exit status
+    bool                                          returns_int { false };
+
+    /// @brief File the code of the functions is decoded from, null for a compiled module
+    std::shared_ptr<ModuleFile const>             file        { };
+
+    /// @brief Function of an index, decoded from the file on first use
+    auto materialize(u32 index) -> Function const&;
+
+    /// @brief Writes every function, one instruction per line
+    /// @note Functions that were not materialized are listed without their code
+    auto disassemble(std::ostream& out) const -> void;
+  };
+
+}
+
+#include "Bytecode.inl"
@@ -0,0 +1,47 @@
+#ifdef __INTELLISENSE__
+#include "Bytecode.hpp"
+#endif
+
+namespace fridayc::bytecode {
+
+  constexpr auto jumps(Opcode op) noexcept -> bool {
+    switch(op) {
+      case Opcode::JUMP:
+      case Opcode::JUMP_IF:
+      case Opcode::JUMP_IF_NOT:
+      case Opcode::JEQ:
+      case Opcode::JNE:
+      case Opcode::JLT:
+      case Opcode::JLE:
+      case Opcode::INC_JLT: return true;
+      default: return false;
+    }
+  }
+
+  constexpr auto producesScalar(Opcode op) noexcept -> bool {
+    switch(op) {
+      case Opcode::MOVE:
+      case Opcode::ADD: case Opcode::SUB: case Opcode::MUL: case Opcode::DIV: case Opcode::MOD:
+      case Opcode::BIT_AND: case Opcode::BIT_OR: case Opcode::SHL: case Opcode::SHR:
+      case Opcode::NEG: case Opcode::BIT_NOT: case Opcode::ADD_IMM:
+      case Opcode::FADD: case Opcode::FSUB: case Opcode::FMUL: case Opcode::FDIV: case Opcode::FNEG:
+      case Opcode::EQ: case Opcode::NE: case Opcode::LT: case Opcode::LE:
+      case Opcode::FEQ: case Opcode::FNE: case Opcode::FLT: case Opcode::FLE:
+      case Opcode::REQ: case Opcode::RNE: case Opcode::SEQ: case Opcode::SNE:
+      case Opcode::NOT: case Opcode::GET_FIELD: case Opcode::GET_ELEM: case Opcode::GET_CHAR: return true;
+      default: return false;
+    }
+  }
+
+  constexpr auto producesReference(Opcode op) noexcept -> bool {
+    switch(op) {
+      case Opcode::MOVE_REF:
+      case Opcode::CONSTANT:
+      case Opcode::CONCAT:
+      case Opcode::GET_FIELD_REF:
+      case Opcode::GET_ELEM_REF: return true;
+      default: return false;
+    }
+  }
+
+}
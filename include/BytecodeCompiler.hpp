@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Walker.hpp"
+#include "Bytecode.hpp"
+
+namespace fridayc {
+
+  /// @brief Compiles the functions reachable from 'main' into register bytecode
+  ///
+  /// Every expression is compiled into the register that holds its value:
+  /// locals and parameters are their own frame slot, literals and enum
+  /// constants are the register of their constant, anything else gets the
+  /// lowest free temporary. Temporaries are freed in stack order, so the
+  /// arguments of a call are the topmost registers and become the frame of
+  /// the callee in place. Conditions of branches compile to fused
+  /// compare-and-branch instructions where both sides are ints, and loops
+  /// test their condition at the bottom, so a loop runs one branch per
+  /// iteration. Runs on an analyzed program, like the Executor.
+  class BytecodeCompiler : public Walker {
+    public:
+    using Register = u16;
+
+    private:
+    Analyzer const&                         analyzer;
+    TypeTable const&                        table;
+    bytecode::Module                        compiled  { };
+    FlatMap<FunctionStatement const*, u16>  indices   { };
+    std::vector<FunctionStatement*>         pending   { };
+    FlatMap<std::string_view, u16>          strings   { };
+    FlatMap<TypeId, u16>                    formats   { };
+    FlatMap<i64, Register>                  constants { };
+    std::vector<Error>                      errors    { };
+    bytecode::Function*                     function  { nullptr };
+    u32                                     frame     { 0 };
+    u32                                     next      { 0 };
+    u32                                     peak      { 0 };
+
+    public:
+    /// @brief Constructs a compiler
+    /// @param analyzer the analyzer that checked the program
+    /// @param table the table interning the types of the program
+    BytecodeCompiler(Analyzer const& analyzer, TypeTable const& table) noexcept;
+
+    /// @brief Compiles 'main', which must take no parameters, and every function it may call
+    /// @param program the analyzed program to compile
+    /// @return the errors, empty if the whole program compiled
+    auto compile(Program& program) -> std::vector<Error>;
+
+    /// @brief Compiled module, 'main' is its first function
+    auto module() noexcept -> bytecode::Module&;
+
+    using Walker::operator();
+
+    auto operator()(Identifier& arg) noexcept -> std::any override;
+    auto operator()(BoolLiteral& arg) noexcept -> std::any override;
+    auto operator()(ObjectLiteral& arg) noexcept -> std::any override;
+    auto operator()(StringLiteral& arg) noexcept -> std::any override;
+    auto operator()(FloatLiteral& arg) noexcept -> std::any override;
+    auto operator()(IntLiteral& arg) noexcept -> std::any override;
+    auto operator()(CharLiteral& arg) noexcept -> std::any override;
+    auto operator()(PrefixExpression& arg) noexcept -> std::any override;
+    auto operator()(InfixExpression& arg) noexcept -> std::any override;
+    auto operator()(CallExpression& arg) noexcept -> std::any override;
+    auto operator()(SubscriptExpression& arg) noexcept -> std::any override;
+    auto operator()(ArrayLiteral& arg) noexcept -> std::any override;
+    auto operator()(ExpressionStatement& arg) noexcept -> std::any override;
+    auto operator()(ReturnStatement& arg) noexcept -> std::any override;
+    auto operator()(PrintStatement& arg) noexcept -> std::any override;
+    auto operator()(BlockStatement& arg) noexcept -> std::any override;
+    auto operator()(IfStatement& arg) noexcept -> std::any override;
+    auto operator()(WhileStatement& arg) noexcept -> std::any override;
+    auto operator()(ForStatement& arg) noexcept -> std::any override;
+    auto operator()(DeclarationStatement& arg) noexcept -> std::any override;
+
+    private:
+    /// @brief Index of a function, which is queued for compilation on first use
+    auto index(FunctionStatement& declaration) -> u16;
+    auto build(FunctionStatement& declaration, u16 index) -> void;
+    auto expression(Expression& expr) noexcept -> Register;
+    auto statement(Statement& stmt) noexcept -> void;
+    auto unsupported(Span span, std::string message) noexcept -> Register;
+    auto typeOf(Expression const& expr) const noexcept -> TypeId;
+    auto reference(TypeId type) const noexcept -> bool;
+
+    /// @brief Appends an instruction
+    /// @return its index
+    auto emit(bytecode::Opcode op, u32 a, u32 b, u32 c, Span span) -> u32;
+
+    /// @brief Points jumps at the next instruction emitted
+    auto land(std::vector<u32> const& jumps) noexcept -> void;
+
+    /// @brief Points jumps at an instruction
+    auto patch(std::vector<u32> const& jumps, u32 target) noexcept -> void;
+
+    auto temporary() noexcept -> Register;
+    auto constant(i64 bits, Span span) noexcept -> Register;
+    auto move(TypeId type) const noexcept -> bytecode::Opcode;
+
+    /// @brief Compiles an expression into a given register
+    auto into(Expression& expr, Register target) noexcept -> void;
+
+    /// @brief Copies a local to a temporary if code evaluated later assigns it
+    auto stable(Register value, TypeId type, Expression& later) noexcept -> Register;
+
+    /// @brief Compiles a condition into jumps taken when it is 'when'
+    /// @return the jumps to point at the target
+    auto branch(Expression& condition, bool when) noexcept -> std::vector<u32>;
+
+    /// @brief Opcode of a binary operator, and whether its operands are swapped
+    auto operation(Token::Type oper, TypeId lhs, TypeId rhs) const noexcept -> std::optional<std::pair<bytecode::Opcode, bool>>;
+
+    auto call(CallExpression& arg, FunctionStatement& callee) noexcept -> Register;
+    auto construct(Container<Box<Expression>>& values, Span span) noexcept -> Register;
+    auto member(InfixExpression& arg) noexcept -> Register;
+    auto binary(InfixExpression& arg) noexcept -> Register;
+    auto assign(InfixExpression& arg) noexcept -> Register;
+  };
+
+}
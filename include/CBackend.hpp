@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Walker.hpp"
+#include "Runtime.hpp"
+
+namespace fridayc {
+
+  /// @brief Lowers the functions reachable from 'main' to portable C99
+  ///
+  /// Every expression is computed into a C variable, in the order the
+  /// Executor evaluates it, so the C compiler's freedom to order operands
+  /// never shows. Locals and parameters are C variables read in place,
+  /// copied first if code evaluated later assigns them. Structs and arrays
+  /// are C structs of their field and element types, strings are a length
+  /// and their bytes; objects are never freed, a generated program is
+  /// expected to run and exit. Checked operations, null checks and bounds
+  /// checks fault like the Executor, with the same message at the same
+  /// span, and calls nest as deep as ExecutionLimits allows. Statements
+  /// carry #line directives, so the C compiler and debuggers point into the
+  /// .fx source. Runs on an analyzed program, like the Executor.
+  ///
+  /// The program exports 'fx_main', which runs 'main' and tells whether it
+  /// faulted; unless FX_LIBRARY is defined it also has a C 'main' whose exit
+  /// status is the one of fridayc --run.
+  class CBackend : public Walker {
+    public:
+    /// @brief C expression of a value, with the frame slot of the local it reads in place if any
+    struct Operand {
+      std::string        code { };
+      std::optional<u32> slot { };
+    };
+
+    private:
+    Analyzer const&                                 analyzer;
+    TypeTable const&                                table;
+    FlatMap<FunctionStatement const*, u32>          indices     { };
+    std::vector<FunctionStatement*>                 pending     { };
+    FlatMap<TypeId, u32>                            aggregates  { };
+    FlatMap<TypeId, u32>                            printers    { };
+    FlatMap<std::string_view, u32>                  strings     { };
+    FlatMap<u64, u32>                               sites       { };
+    FlatMap<u32, u32>                               lines       { };
+    FlatMap<DeclarationStatement const*, u32>       locals      { };
+    std::vector<Error>                              errors      { };
+
+    // * Sections of the generated file, in the order they are written after the runtime
+    std::string                                     site_table  { };
+    std::string                                     line_table  { };
+    std::string                                     forwards    { };
+    std::string                                     arrays      { };
+    std::string                                     structs     { };
+    std::string                                     literals    { };
+    std::string                                     prototypes  { };
+    std::string                                     prints      { };
+    std::string                                     entries     { };
+    std::string                                     functions   { };
+
+    FunctionStatement*                              function    { nullptr };
+    std::string                                     body        { };
+    u32                                             indent      { 0 };
+    u32                                             temporaries { 0 };
+    u32                                             file        { Sources::NONE };
+
+    /// @brief Row of the statement being generated, and the row the C compiler counts the next line of the body as
+    u32                                             row         { 0 };
+    u32                                             mapped      { 0 };
+
+    public:
+    /// @brief Constructs a backend
+    /// @param analyzer the analyzer that checked the program
+    /// @param table the table interning the types of the program
+    CBackend(Analyzer const& analyzer, TypeTable const& table) noexcept;
+
+    /// @brief Generates 'main', which must take no parameters, and every function it may call
+    /// @param program the analyzed program to generate
+    /// @return the errors, empty if the whole program was generated
+    auto generate(Program& program) -> std::vector<Error>;
+
+    /// @brief Writes the generated C to a file
+    /// @return the errors, empty if the file was written
+    auto write(std::string const& path) const -> std::vector<Error>;
+
+    /// @brief Compiles a generated C file with the system C compiler at -O2
+    /// @param source the generated file
+    /// @param output the executable, or a shared library if it ends in .so, .dylib or .dll
+    /// @return the errors, empty if the compiler succeeded
+    /// @note The compiler is $CC, cc by default, run without a shell
+    static auto build(std::string const& source, std::string const& output) -> std::vector<Error>;
+
+    using Walker::operator();
+
+    auto operator()(Identifier& arg) noexcept -> std::any override;
+    auto operator()(BoolLiteral& arg) noexcept -> std::any override;
+    auto operator()(ObjectLiteral& arg) noexcept -> std::any override;
+    auto operator()(StringLiteral& arg) noexcept -> std::any override;
+    auto operator()(FloatLiteral& arg) noexcept -> std::any override;
+    auto operator()(IntLiteral& arg) noexcept -> std::any override;
+    auto operator()(CharLiteral& arg) noexcept -> std::any override;
+    auto operator()(PrefixExpression& arg) noexcept -> std::any override;
+    auto operator()(InfixExpression& arg) noexcept -> std::any override;
+    auto operator()(CallExpression& arg) noexcept -> std::any override;
+    auto operator()(SubscriptExpression& arg) noexcept -> std::any override;
+    auto operator()(ArrayLiteral& arg) noexcept -> std::any override;
+    auto operator()(ExpressionStatement& arg) noexcept -> std::any override;
+    auto operator()(ReturnStatement& arg) noexcept -> std::any override;
+    auto operator()(PrintStatement& arg) noexcept -> std::any override;
+    auto operator()(BlockStatement& arg) noexcept -> std::any override;
+    auto operator()(IfStatement& arg) noexcept -> std::any override;
+    auto operator()(WhileStatement& arg) noexcept -> std::any override;
+    auto operator()(ForStatement& arg) noexcept -> std::any override;
+    auto operator()(DeclarationStatement& arg) noexcept -> std::any override;
+
+    private:
+    /// @brief C name of a function, which is queued for generation on first use
+    auto index(FunctionStatement& declaration) -> std::string;
+    auto build(FunctionStatement& declaration, u32 index) -> void;
+    auto signature(FunctionStatement& declaration, u32 index) -> std::string;
+    auto expression(Expression& expr) noexcept -> Operand;
+    auto statement(Statement& stmt) noexcept -> void;
+    auto unsupported(Span span, std::string message) noexcept -> Operand;
+    auto typeOf(Expression const& expr) const noexcept -> TypeId;
+
+    /// @brief Tells whether the end of a statement can be reached
+    auto falls(Statement const& stmt) const noexcept -> bool;
+
+    /// @brief Whether callers pass the site of the call, for the fault of ending without a value
+    auto passesSite(FunctionStatement& declaration) const noexcept -> bool;
+
+    /// @brief Appends a line of code at the current indentation, mapped to the row of the statement
+    auto line(std::string_view code) -> void;
+
+    /// @brief Generates the body of an if, a while or a for one level deeper
+    auto nested(Statement& stmt) noexcept -> void;
+
+    /// @brief Stores a C expression in a new variable
+    /// @return the variable
+    auto temporary(TypeId type, std::string_view code) -> Operand;
+
+    /// @brief Copies a local to a variable if code evaluated later assigns it
+    auto stable(Operand value, TypeId type, Expression& later) -> Operand;
+
+    /// @brief Index of the fault site of a span
+    auto site(Span span) -> u32;
+
+    /// @brief C type of values of a type
+    auto ctype(TypeId type) -> std::string;
+
+    /// @brief Name of the C print function of a type, generated on first use
+    auto printer(TypeId type) -> std::string;
+
+    /// @brief C expression of a binary operator, std::nullopt if it cannot run
+    auto operation(Token::Type oper, TypeId lhs, TypeId rhs, std::string_view left, std::string_view right, u32 at) const
+      -> std::optional<std::string>;
+
+    auto call(CallExpression& arg, FunctionStatement& callee) noexcept -> Operand;
+    auto construct(Container<Box<Expression>>& values, TypeId type, Span span) noexcept -> Operand;
+    auto member(InfixExpression& arg) noexcept -> Operand;
+    auto binary(InfixExpression& arg) noexcept -> Operand;
+    auto assign(InfixExpression& arg) noexcept -> Operand;
+
+    /// @brief Null and bounds checks of an element access, then the element as an lvalue
+    auto element(std::string_view array, std::string_view index, u32 at) -> std::string;
+  };
+
+}
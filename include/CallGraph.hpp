@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Walker.hpp"
+#include "FlatMap.hpp"
+
+namespace fridayc {
+
+  class ThreadPool;
+
+  /// @brief What a function and everything it may call do, as far as callers care
+  struct FunctionSummary {
+    /// @brief Stack estimate of functions that may recurse or call unknown code
+    static constexpr u64 UNBOUNDED = std::numeric_limits<u64>::max();
+
+    /// @brief Neither prints, assigns through a subscript or a member, nor calls a computed callee
+    bool pure      { true };
+
+    /// @brief Never constructs a struct or an array
+    bool no_alloc  { true };
+
+    /// @brief May call itself, directly or through other functions
+    bool recursive { false };
+
+    /// @brief Frame slots of the deepest chain of calls starting at the function
+    u64  stack     { 0 };
+  };
+
+  /// @brief Call graph of the functions of a resolved program, with bottom-up summaries
+  ///
+  /// Functions are numbered in program order and their distinct direct
+  /// callees are kept in compressed rows. Strongly connected components are
+  /// numbered callees first, so a component only calls components with a
+  /// lower number. The summary of a component depends on those of the
+  /// components it calls and nothing else: each one is computed on the pool
+  /// as soon as the last of them is done, so independent components run in
+  /// parallel. A call through anything but a function name is treated as a
+  /// call to unknown code, which may do anything.
+  class CallGraph {
+    ThreadPool&                             pool;
+    std::vector<FunctionStatement*>         functions  { };
+    FlatMap<FunctionStatement const*, u32>  indices    { };
+    std::vector<u32>                        offsets    { };
+    std::vector<u32>                        targets    { };
+    std::vector<FunctionSummary>            locals     { };
+    std::vector<u32>                        components { };
+    std::vector<u32>                        starts     { };
+    std::vector<u32>                        members    { };
+    std::vector<FunctionSummary>            summaries  { };
+
+    public:
+    /// @brief Constructs an empty call graph
+    /// @param pool the pool collecting calls and computing summaries
+    explicit CallGraph(ThreadPool& pool) noexcept;
+
+    /// @brief Builds the graph and the summaries of a resolved program
+    /// @param program the program to analyze
+    auto build(Program& program) -> void;
+
+    /// @brief Summary of a function
+    /// @return the summary, nullptr if the function is not part of the program
+    auto summary(FunctionStatement const& function) const noexcept -> FunctionSummary const*;
+
+    /// @brief Distinct functions called directly by a function, in no particular order
+    auto callees(FunctionStatement const& function) const -> std::vector<FunctionStatement const*>;
+
+    /// @brief Component of a function, components are numbered callees first
+    /// @return the component, std::nullopt if the function is not part of the program
+    auto component(FunctionStatement const& function) const noexcept -> std::optional<u32>;
+
+    /// @brief Number of functions
+    auto functionCount() const noexcept -> u64;
+
+    /// @brief Number of distinct caller and callee pairs
+    auto edgeCount() const noexcept -> u64;
+
+    /// @brief Number of strongly connected components
+    auto componentCount() const noexcept -> u64;
+
+    private:
+    auto collect(Program& program) -> void;
+    auto connect() -> void;
+    auto summarize() -> void;
+    auto summarize(u32 component) noexcept -> void;
+  };
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Walker.hpp"
+
+namespace fridayc {
+
+  /// @brief Deep copies expressions, keeping spans and bindings
+  ///
+  /// Visiting an expression returns the copy as an owning Expression*.
+  /// Passes that rewrite names while copying override the visit of an
+  /// Identifier.
+  class Cloner : public Walker {
+    public:
+    Cloner() noexcept = default;
+
+    /// @brief Copies an expression
+    /// @param expr the expression to copy
+    /// @return the copy
+    auto clone(Expression& expr) noexcept -> Box<Expression>;
+
+    using Walker::operator();
+
+    auto operator()(Identifier& arg) noexcept -> std::any override;
+    auto operator()(BoolLiteral& arg) noexcept -> std::any override;
+    auto operator()(ObjectLiteral& arg) noexcept -> std::any override;
+    auto operator()(StringLiteral& arg) noexcept -> std::any override;
+    auto operator()(FloatLiteral& arg) noexcept -> std::any override;
+    auto operator()(IntLiteral& arg) noexcept -> std::any override;
+    auto operator()(CharLiteral& arg) noexcept -> std::any override;
+    auto operator()(PrefixExpression& arg) noexcept -> std::any override;
+    auto operator()(InfixExpression& arg) noexcept -> std::any override;
+    auto operator()(CallExpression& arg) noexcept -> std::any override;
+    auto operator()(SubscriptExpression& arg) noexcept -> std::any override;
+    auto operator()(TypeExpression& arg) noexcept -> std::any override;
+    auto operator()(ArrayLiteral& arg) noexcept -> std::any override;
+
+    protected:
+    /// @brief Gives a copy the span of its original and releases it to be returned from a visit
+    auto copied(Expression const& original, Box<Expression> copy) const noexcept -> std::any;
+  };
+
+}
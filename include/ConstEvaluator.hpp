@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Interpreter.hpp"
+
+namespace fridayc {
+
+  /// @brief Replaces constant initializers and calls to pure functions by their values
+  ///
+  /// A function is pure when neither it nor anything it calls prints,
+  /// assigns through a subscript or a member, or calls a computed callee.
+  /// Initializers of 'const' locals and calls to pure functions are
+  /// evaluated by the Interpreter and, when the value can be written as a
+  /// literal, replaced by it. Uses of constants holding a scalar become
+  /// literals too. Constant strings and arrays are not known past their
+  /// initializer, their elements can still be assigned. Runs on a resolved
+  /// program.
+  class ConstEvaluator : public Walker {
+    FlatMap<FunctionStatement const*, bool>  pure        { };
+    Interpreter                              interpreter;
+    u64                                      constants   { 0 };
+    u64                                      calls       { 0 };
+
+    public:
+    /// @brief Constructs an evaluator
+    /// @param limits the bounds of each evaluation
+    explicit ConstEvaluator(EvaluationLimits limits = { }) noexcept;
+
+    /// @brief Evaluates and substitutes the constants of a resolved program
+    /// @param program the program to transform
+    auto evaluate(Program& program) -> void;
+
+    /// @brief Number of 'const' initializers evaluated
+    auto evaluatedConstants() const noexcept -> u64;
+
+    /// @brief Number of calls replaced by their value
+    auto substitutedCalls() const noexcept -> u64;
+
+    /// @brief Number of calls answered from the memo of the Interpreter
+    auto memoizedCalls() const noexcept -> u64;
+
+    using Walker::operator();
+
+    auto operator()(PrefixExpression& arg) noexcept -> std::any override;
+    auto operator()(InfixExpression& arg) noexcept -> std::any override;
+    auto operator()(CallExpression& arg) noexcept -> std::any override;
+    auto operator()(SubscriptExpression& arg) noexcept -> std::any override;
+    auto operator()(ExpressionStatement& arg) noexcept -> std::any override;
+    auto operator()(ArrayLiteral& arg) noexcept -> std::any override;
+    auto operator()(ReturnStatement& arg) noexcept -> std::any override;
+    auto operator()(PrintStatement& arg) noexcept -> std::any override;
+    auto operator()(IfStatement& arg) noexcept -> std::any override;
+    auto operator()(WhileStatement& arg) noexcept -> std::any override;
+    auto operator()(ForStatement& arg) noexcept -> std::any override;
+    auto operator()(DeclarationStatement& arg) noexcept -> std::any override;
+
+    private:
+    auto purity(Program& program) -> void;
+    auto substitute(Box<Expression>& slot) noexcept -> void;
+    auto literal(Value const& value, Span span) const -> Box<Expression>;
+  };
+
+}
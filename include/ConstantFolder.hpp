@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Walker.hpp"
+
+namespace fridayc {
+
+  /// @brief Collapses constant integer, float, boolean, character and bitwise expressions into literals
+  ///
+  /// Visiting a literal or an operator applied to constants returns the
+  /// constant. The parent of a constant expression replaces it with a single
+  /// literal, so only the largest constant subtrees are rebuilt. An operation
+  /// that would overflow, divide by zero or produce a non-finite float is left
+  /// in place for the program to perform at run time. Operands of different
+  /// types are left to the TypeChecker.
+  class ConstantFolder : public Walker {
+    u64 expressions { 0 };
+    u64 operations  { 0 };
+
+    public:
+    /// @brief Value of a constant expression
+    using Constant = std::variant<Long, Double, Boolean, Character>;
+
+    ConstantFolder() noexcept = default;
+
+    /// @brief Folds every constant expression of a program in place
+    /// @param program the program to fold
+    auto fold(Program& program) -> void;
+
+    /// @brief Number of expressions replaced by a literal
+    auto folded() const noexcept -> u64;
+
+    /// @brief Number of operators evaluated while folding
+    auto evaluated() const noexcept -> u64;
+
+    /// @brief Applies a prefix operator to a constant
+    /// @return the result or std::nullopt if the operator does not apply to the operand
+    /// @throws std::overflow_error, std::domain_error or std::out_of_range if the program would fault
+    static auto unary(Token::Type oper, Constant const& operand) -> std::optional<Constant>;
+
+    /// @brief Applies an infix operator to constants
+    /// @return the result or std::nullopt if the operator does not apply to the operands
+    /// @throws std::overflow_error, std::domain_error or std::out_of_range if the program would fault
+    static auto binary(Token::Type oper, Constant const& lhs, Constant const& rhs) -> std::optional<Constant>;
+
+    using Walker::operator();
+
+    auto operator()(BoolLiteral& arg) noexcept -> std::any override;
+    auto operator()(FloatLiteral& arg) noexcept -> std::any override;
+    auto operator()(IntLiteral& arg) noexcept -> std::any override;
+    auto operator()(CharLiteral& arg) noexcept -> std::any override;
+    auto operator()(PrefixExpression& arg) noexcept -> std::any override;
+    auto operator()(InfixExpression& arg) noexcept -> std::any override;
+    auto operator()(CallExpression& arg) noexcept -> std::any override;
+    auto operator()(SubscriptExpression& arg) noexcept -> std::any override;
+    auto operator()(ExpressionStatement& arg) noexcept -> std::any override;
+    auto operator()(ArrayLiteral& arg) noexcept -> std::any override;
+    auto operator()(ReturnStatement& arg) noexcept -> std::any override;
+    auto operator()(PrintStatement& arg) noexcept -> std::any override;
+    auto operator()(IfStatement& arg) noexcept -> std::any override;
+    auto operator()(WhileStatement& arg) noexcept -> std::any override;
+    auto operator()(ForStatement& arg) noexcept -> std::any override;
+    auto operator()(DeclarationStatement& arg) noexcept -> std::any override;
+
+    private:
+    auto evaluate(Expression& expr) noexcept -> std::optional<Constant>;
+    auto replace(Box<Expression>& slot, std::optional<Constant> const& value) noexcept -> void;
+    auto fold(Box<Expression>& slot) noexcept -> void;
+  };
+
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Runtime.hpp"
+
+namespace fridayc::runtime {
+
+  /// @brief Loops over contiguous runs of ints or floats, built for several instruction sets
+  ///
+  /// Every set gives the same results bit for bit. Int arithmetic is checked
+  /// like the Executor's, and an int sum faults only if the exact sum does
+  /// not fit, whatever the order of the additions. A float sum adds in four
+  /// interleaved lanes, which are then added pairwise, in every set. A float
+  /// minimum or maximum is NaN if any element is, and orders -0.0 before 0.0.
+  /// Binary kernels stop at the first element that faults and return its
+  /// index, the caller reports it; what they wrote from it on is unspecified.
+  struct Kernels {
+    /// @brief Instruction sets the kernels are built for
+    enum struct Isa : u8 { SCALAR, AVX2 };
+
+    /// @brief out = lhs op rhs, returns the index of the first element that faulted or size
+    using Ints   = auto (*)(i64 const* lhs, i64 const* rhs, i64* out, u64 size) noexcept -> u64;
+    using Floats = auto (*)(f64 const* lhs, f64 const* rhs, f64* out, u64 size) noexcept -> u64;
+
+    /// @brief Sum of a run, false if it does not fit in an int
+    using IntSum = auto (*)(i64 const* values, u64 size, i64& result) noexcept -> bool;
+    using FloatSum = auto (*)(f64 const* values, u64 size) noexcept -> f64;
+
+    /// @brief Smallest or largest element of a run that is not empty
+    using IntBound = auto (*)(i64 const* values, u64 size) noexcept -> i64;
+    using FloatBound = auto (*)(f64 const* values, u64 size) noexcept -> f64;
+
+    using IntFill = auto (*)(i64* out, i64 value, u64 size) noexcept -> void;
+    using FloatFill = auto (*)(f64* out, f64 value, u64 size) noexcept -> void;
+
+    /// @brief Copies bytes between runs that do not overlap
+    using Copy = auto (*)(void const* from, void* to, u64 bytes) noexcept -> void;
+
+    Isa         isa;
+    const i8*   name;
+    Ints        add, sub, mul, div;
+    Floats      fadd, fsub, fmul, fdiv;
+    IntSum      sum;
+    FloatSum    fsum;
+    IntBound    min, max;
+    FloatBound  fmin, fmax;
+    IntFill     fill;
+    FloatFill   ffill;
+    Copy        copy;
+  };
+
+  /// @brief Kernels of an instruction set, nullptr if this machine cannot run them
+  auto kernels(Kernels::Isa isa) noexcept -> Kernels const*;
+
+  /// @brief Kernels of the widest instruction set this machine supports, selected on first use
+  auto kernels() noexcept -> Kernels const&;
+
+  /// @brief Extents written the way arrays print, as [2, 3]
+  auto describe(std::span<u64 const> extents) -> std::string;
+
+  /// @brief Operations a DenseArray applies element by element
+  enum struct Elementwise : u8 { ADD, SUB, MUL, DIV };
+
+  /// @brief An N-dimensional array of ints or floats in a single allocation
+  ///
+  /// The allocation begins with a header of the rank, the number of
+  /// elements, the extents and the row-major strides, in elements. The
+  /// elements follow, aligned for the widest vector the kernels load. An
+  /// int[][] is thus one dense block rather than an array of rows, each
+  /// allocated on its own. Element-wise operations, reductions, fill and
+  /// copy run over all the elements as one contiguous run, on the kernels
+  /// selected for the machine. They fault with the Executor's messages.
+  template<class T>
+  class DenseArray final : public Object {
+    static_assert(std::same_as<T, i64> or std::same_as<T, f64>, "Elements are ints or floats");
+
+    /// @brief Alignment of the elements, the width of an AVX2 vector
+    static constexpr u64 ALIGNMENT = 32;
+
+    /// @brief Rank, size, extents and strides, then the elements
+    u64* header { nullptr };
+
+    public:
+    /// @brief Constructs an array of zeros
+    /// @param extents the extents of the dimensions, at least one
+    /// @param span where the array is made, for the faults
+    DenseArray(std::span<u64 const> extents, Span span);
+
+    DenseArray(DenseArray const& other);
+    DenseArray(DenseArray&& other) noexcept;
+
+    /// @note Copies between arrays of the same shape are made with assign
+    auto operator=(DenseArray const& other) -> DenseArray& = delete;
+    auto operator=(DenseArray&& other) noexcept -> DenseArray&;
+
+    ~DenseArray() noexcept override;
+
+    auto rank() const noexcept -> u32;
+    auto size() const noexcept -> u64;
+    auto extents() const noexcept -> std::span<u64 const>;
+
+    /// @brief Elements between two consecutive indices of each dimension
+    auto strides() const noexcept -> std::span<u64 const>;
+
+    auto data() noexcept -> T*;
+    auto data() const noexcept -> T const*;
+    auto elements() noexcept -> std::span<T>;
+    auto elements() const noexcept -> std::span<T const>;
+
+    /// @brief Element at an index in every dimension, faults out of bounds
+    auto at(std::span<i64 const> indices, Span span) -> T&;
+    auto at(std::span<i64 const> indices, Span span) const -> T const&;
+
+    /// @brief Sets every element to a value
+    auto fill(T value) noexcept -> void;
+
+    /// @brief Copies the elements of an array of the same shape
+    auto assign(DenseArray const& from, Span span) -> void;
+
+    /// @brief Sets every element to the operation on the elements of two arrays of the same shape
+    /// @note The arrays may be this one
+    auto compute(Elementwise operation, DenseArray const& lhs, DenseArray const& rhs, Span span) -> void;
+
+    /// @brief Sum of the elements, faults on an int sum that does not fit
+    auto sum(Span span) const -> T;
+
+    /// @brief Smallest element, faults on an empty array
+    auto minimum(Span span) const -> T;
+
+    /// @brief Largest element, faults on an empty array
+    auto maximum(Span span) const -> T;
+
+    private:
+    /// @brief Offset of the elements from the start of the allocation, in bytes
+    static constexpr auto offset(u64 rank) noexcept -> u64;
+
+    /// @brief Faults unless an array has the same shape as this one
+    auto expect(DenseArray const& other, Span span) const -> void;
+  };
+
+}
+
+#include "DenseArray.inl"
@@ -0,0 +1,199 @@
+#ifdef __INTELLISENSE__
+#include "DenseArray.hpp"
+#endif
+
+namespace fridayc::runtime {
+
+  template<class T>
+  constexpr auto DenseArray<T>::offset(u64 rank) noexcept -> u64 {
+    const u64 bytes = (2 + 2 * rank) * sizeof(u64);
+    return (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+  }
+
+  template<class T>
+  DenseArray<T>::DenseArray(std::span<u64 const> extents, Span span) {
+    if(extents.empty()) fault("Array of no dimensions"s, span);
+
+    // * The bytes of the elements must fit alongside the header, rounded up to the alignment
+    u64 size = 1, bytes = 0;
+    for(u64 extent : extents)
+      if(__builtin_mul_overflow(size, extent, &size)) fault("Array too large"s, span);
+    if(__builtin_mul_overflow(size, sizeof(T), &bytes) or __builtin_add_overflow(bytes, offset(extents.size()) + ALIGNMENT - 1, &bytes))
+      fault("Array too large"s, span);
+    bytes = bytes / ALIGNMENT * ALIGNMENT;
+
+    header = static_cast<u64*>(std::aligned_alloc(ALIGNMENT, bytes));
+    if(not header) throw std::bad_alloc{ };
+
+    const u64 rank = extents.size();
+    header[0] = rank;
+    header[1] = size;
+    std::ranges::copy(extents, header + 2);
+
+    // * Row-major, the last dimension is contiguous
+    u64 stride = 1;
+    for(u64 i = rank; i-- > 0;) {
+      header[2 + rank + i] = stride;
+      stride *= extents[i];
+    }
+    fill(T{ 0 });
+  }
+
+  template<class T>
+  DenseArray<T>::DenseArray(DenseArray const& other) {
+    const u64 bytes = offset(other.rank()) + (other.size() * sizeof(T) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    header = static_cast<u64*>(std::aligned_alloc(ALIGNMENT, bytes));
+    if(not header) throw std::bad_alloc{ };
+    std::memcpy(header, other.header, offset(other.rank()));
+    kernels().copy(other.data(), data(), size() * sizeof(T));
+  }
+
+  template<class T>
+  DenseArray<T>::DenseArray(DenseArray&& other) noexcept
+    : header { std::exchange(other.header, nullptr) }
+  {}
+
+  template<class T>
+  auto DenseArray<T>::operator=(DenseArray&& other) noexcept -> DenseArray& {
+    if(this != &other) {
+      std::free(header);
+      header = std::exchange(other.header, nullptr);
+    }
+    return *this;
+  }
+
+  template<class T>
+  DenseArray<T>::~DenseArray() noexcept {
+    std::free(header);
+  }
+
+  template<class T>
+  auto DenseArray<T>::rank() const noexcept -> u32 {
+    return (u32)header[0];
+  }
+
+  template<class T>
+  auto DenseArray<T>::size() const noexcept -> u64 {
+    return header[1];
+  }
+
+  template<class T>
+  auto DenseArray<T>::extents() const noexcept -> std::span<u64 const> {
+    return { header + 2, header[0] };
+  }
+
+  template<class T>
+  auto DenseArray<T>::strides() const noexcept -> std::span<u64 const> {
+    return { header + 2 + header[0], header[0] };
+  }
+
+  template<class T>
+  auto DenseArray<T>::data() noexcept -> T* {
+    return reinterpret_cast<T*>(reinterpret_cast<std::byte*>(header) + offset(header[0]));
+  }
+
+  template<class T>
+  auto DenseArray<T>::data() const noexcept -> T const* {
+    return reinterpret_cast<T const*>(reinterpret_cast<std::byte const*>(header) + offset(header[0]));
+  }
+
+  template<class T>
+  auto DenseArray<T>::elements() noexcept -> std::span<T> {
+    return { data(), size() };
+  }
+
+  template<class T>
+  auto DenseArray<T>::elements() const noexcept -> std::span<T const> {
+    return { data(), size() };
+  }
+
+  template<class T>
+  auto DenseArray<T>::at(std::span<i64 const> indices, Span span) -> T& {
+    return const_cast<T&>(std::as_const(*this).at(indices, span));
+  }
+
+  template<class T>
+  auto DenseArray<T>::at(std::span<i64 const> indices, Span span) const -> T const& {
+    if(indices.size() != rank()) fault("Expected {} indices, found {}"f.format(rank(), indices.size()), span);
+
+    u64 position = 0;
+    for(u64 i = 0; i < indices.size(); ++i) {
+      const u64 extent = extents()[i];
+      if(indices[i] < 0 or (u64)indices[i] >= extent)
+        fault("Index {} out of bounds for length {}"f.format(indices[i], extent), span);
+      position += (u64)indices[i] * strides()[i];
+    }
+    return data()[position];
+  }
+
+  template<class T>
+  auto DenseArray<T>::fill(T value) noexcept -> void {
+    if constexpr (std::same_as<T, i64>) kernels().fill(data(), value, size());
+    else kernels().ffill(data(), value, size());
+  }
+
+  template<class T>
+  auto DenseArray<T>::assign(DenseArray const& from, Span span) -> void {
+    expect(from, span);
+    if(this != &from) kernels().copy(from.data(), data(), size() * sizeof(T));
+  }
+
+  template<class T>
+  auto DenseArray<T>::compute(Elementwise operation, DenseArray const& lhs, DenseArray const& rhs, Span span) -> void {
+    expect(lhs, span);
+    expect(rhs, span);
+
+    Kernels const& with = kernels();
+    u64 faulted = size();
+    if constexpr (std::same_as<T, i64>) {
+      switch(operation) {
+        case Elementwise::ADD: faulted = with.add(lhs.data(), rhs.data(), data(), size()); break;
+        case Elementwise::SUB: faulted = with.sub(lhs.data(), rhs.data(), data(), size()); break;
+        case Elementwise::MUL: faulted = with.mul(lhs.data(), rhs.data(), data(), size()); break;
+        case Elementwise::DIV: faulted = with.div(lhs.data(), rhs.data(), data(), size()); break;
+      }
+    } else {
+      switch(operation) {
+        case Elementwise::ADD: faulted = with.fadd(lhs.data(), rhs.data(), data(), size()); break;
+        case Elementwise::SUB: faulted = with.fsub(lhs.data(), rhs.data(), data(), size()); break;
+        case Elementwise::MUL: faulted = with.fmul(lhs.data(), rhs.data(), data(), size()); break;
+        case Elementwise::DIV: faulted = with.fdiv(lhs.data(), rhs.data(), data(), size()); break;
+      }
+    }
+    if(faulted == size()) return;
+
+    // * The kernels leave the faulting element unwritten, so its operands are intact even if this array is one of them
+    if(operation == Elementwise::DIV and rhs.data()[faulted] == T{ 0 }) fault("Division by 0"s, span);
+    fault("Integer overflow"s, span);
+  }
+
+  template<class T>
+  auto DenseArray<T>::sum(Span span) const -> T {
+    if constexpr (std::same_as<T, i64>) {
+      i64 result;
+      if(not kernels().sum(data(), size(), result)) fault("Integer overflow"s, span);
+      return result;
+    } else return kernels().fsum(data(), size());
+  }
+
+  template<class T>
+  auto DenseArray<T>::minimum(Span span) const -> T {
+    if(size() == 0) fault("Minimum of an empty array"s, span);
+    if constexpr (std::same_as<T, i64>) return kernels().min(data(), size());
+    else return kernels().fmin(data(), size());
+  }
+
+  template<class T>
+  auto DenseArray<T>::maximum(Span span) const -> T {
+    if(size() == 0) fault("Maximum of an empty array"s, span);
+    if constexpr (std::same_as<T, i64>) return kernels().max(data(), size());
+    else return kernels().fmax(data(), size());
+  }
+
+  template<class T>
+  auto DenseArray<T>::expect(DenseArray const& other, Span span) const -> void {
+    if(not std::ranges::equal(extents(), other.extents()))
+      fault("Shapes {} and {} differ"f.format(describe(extents()), describe(other.extents())), span);
+  }
+
+}
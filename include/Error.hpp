@@ -1,14 +1,13 @@
 #pragma once
 
+#include "Source.hpp"
 
 namespace fridayc {
   struct Error {
     std::string message;
-    u32 row;
-    u32 col;
-    u32 length;
+    Span span;
 
-    constexpr Error(std::string error, u32 row, u32 col, u32 length) noexcept;
+    constexpr Error(std::string error, Span span) noexcept;
   };
 
   struct RuntimeError : public Error {
@@ -35,6 +34,9 @@ namespace fridayc {
     
   };
 
+  /// @brief Prints an error to the standard output with the line of its source it points at
+  auto report(Error const& error) -> void;
+
 }
 
 #include "Error.inl"
\ No newline at end of file
@@ -4,11 +4,9 @@
 
 namespace fridayc {
 
-  constexpr Error::Error(std::string error, u32 row, u32 col, u32 length) noexcept
+  constexpr Error::Error(std::string error, Span span) noexcept
     : message { std::move(error) }
-    , row { row }
-    , col { col }
-    , length { length }
+    , span { span }
   {}
 
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Walker.hpp"
+#include "FlatMap.hpp"
+
+namespace fridayc {
+
+  /// @brief How long the struct or array made by a literal can live
+  struct Lifetime {
+
+    enum struct Kind : u8 {
+      HEAP,       // * the value may outlive the call that made it, it is reference counted on the general heap
+      CALL,       // * the value dies with the call that made it
+      ITERATION,  // * the value dies with the iteration of the loop that made it
+    };
+
+    /// @brief Kind of the lifetime
+    Kind kind { Kind::HEAP };
+
+    /// @brief For ITERATION, the 'for' or 'while' loop whose iteration the value dies with
+    Statement const* loop { nullptr };
+  };
+
+  /// @brief Finds the struct and array literals whose values never outlive their call or loop iteration
+  ///
+  /// A value escapes when it is passed to a function, returned, stored into
+  /// a field, an element or another literal, or assigned to a variable. A
+  /// literal that is only read in place, by a subscript, a field access, a
+  /// comparison or a print, dies with the expression. A literal that
+  /// initializes a local dies with the scope of the local if the local never
+  /// escapes; a local copied into another one escapes. Nothing that escapes
+  /// is ever stored into a value that does not, so values that do not escape
+  /// are only referenced from their local and from the expression using
+  /// them.
+  ///
+  /// The lifetime of a value that does not escape is the iteration of the
+  /// innermost loop whose body declares its local, or whose condition,
+  /// modifier or body computes it, and otherwise the call. Every iteration
+  /// of such a loop ends by clearing the locals it declared for values of
+  /// the iteration, after which none are referenced. Runs on a resolved
+  /// program.
+  class EscapeAnalyzer : public Walker {
+    struct Literal {
+      Expression const*           expr;
+      DeclarationStatement const* declaration;
+      Statement const*            loop;
+    };
+
+    FunctionStatement const*                     function  { nullptr };
+    std::vector<Statement const*>                loops     { };
+    std::vector<Literal>                         literals  { };
+    FlatMap<Expression const*, bool>             escaping  { };
+    FlatMap<DeclarationStatement const*, bool>   escaped   { };
+    FlatMap<Expression const*, Lifetime>         lifetimes { };
+    FlatMap<Statement const*, std::vector<u32>>  cleared   { };
+    FlatMap<FunctionStatement const*, bool>      regional  { };
+    std::vector<Expression const*>               order     { };
+    u64                                          counts[3] { 0, 0, 0 };
+
+    public:
+    /// @brief Finds the lifetime of every literal of a resolved program
+    /// @param program the program to analyze
+    auto analyze(Program& program) -> void;
+
+    /// @brief Finds the lifetime of a struct or array literal
+    /// @param literal an array literal or a call to a struct of the analyzed program
+    /// @return the lifetime, nullptr for literals outside of functions
+    auto lifetime(Expression const& literal) const noexcept -> Lifetime const*;
+
+    /// @brief Frame slots to clear at the end of every iteration of a loop
+    /// @param loop a 'for' or 'while' loop of the analyzed program
+    /// @return the slots, nullptr if no value dies with the iterations of the loop
+    auto slots(Statement const& loop) const noexcept -> std::vector<u32> const*;
+
+    /// @brief Whether a function makes values that do not escape it
+    auto allocates(FunctionStatement const& function) const noexcept -> bool;
+
+    /// @brief Number of literals of a lifetime
+    auto count(Lifetime::Kind kind) const noexcept -> u64;
+
+    /// @brief Writes the lifetime of every literal, one per line, in the order of the program
+    /// @param out the stream to write to
+    auto report(std::ostream& out) const -> void;
+
+    using Walker::operator();
+
+    auto operator()(InfixExpression& arg) noexcept -> std::any override;
+    auto operator()(CallExpression& arg) noexcept -> std::any override;
+    auto operator()(ArrayLiteral& arg) noexcept -> std::any override;
+    auto operator()(ReturnStatement& arg) noexcept -> std::any override;
+    auto operator()(WhileStatement& arg) noexcept -> std::any override;
+    auto operator()(ForStatement& arg) noexcept -> std::any override;
+    auto operator()(FunctionStatement& arg) noexcept -> std::any override;
+    auto operator()(DeclarationStatement& arg) noexcept -> std::any override;
+
+    private:
+    /// @brief Records that the value of an expression escapes, when it is a literal or a local
+    auto escape(Expression const& expr) noexcept -> void;
+
+    /// @brief Records a literal made in the current function
+    auto record(Expression const& expr) noexcept -> void;
+
+    /// @brief Gives a lifetime to the literals of the function just walked
+    auto classify() noexcept -> void;
+  };
+
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "Walker.hpp"
+#include "Region.hpp"
+
+namespace fridayc {
+
+  class EscapeAnalyzer;
+
+  /// @brief Runs a program by compiling it into a tree of closures first
+  ///
+  /// Every function is compiled once, on its first call, into closures
+  /// that only do the work left at run time: locals and parameters are
+  /// frame slots, operators are picked by the types of their operands,
+  /// calls hold the compiled callee, and literals and locals used as
+  /// operands are read in place instead of through a closure of their own.
+  /// Values of each type have their own closure type, so nothing is boxed.
+  ///
+  /// Ints, floats, bools, chars and enum constants live in the frame.
+  /// Strings, structs and arrays are shared and reference counted: structs
+  /// and arrays are references, strings never change. Runs on an analyzed
+  /// program and stops at the first fault, reported as a RuntimeError.
+  ///
+  /// Given an escape analysis, structs and arrays that do not escape are
+  /// made in a region instead of on the heap. A call that makes any rewinds
+  /// the region on return, after clearing its frame, and a loop whose
+  /// iterations make any rewinds it after every iteration, after clearing
+  /// the locals the analysis names.
+  class Executor : public Walker {
+    public:
+    using Cell = runtime::Cell;
+    using Ref = runtime::Ref;
+
+    enum struct Flow : u8 { NEXT, RETURN };
+
+    /// @brief Compiled code computing a value of type T in a frame
+    template<class T>
+    using Code = std::function<T(Cell*)>;
+
+    /// @brief Compiled expression, by the representation of its type
+    using Thunk = std::variant<Code<void>, Code<i64>, Code<f64>, Code<bool>, Code<i8>, Code<Ref>>;
+
+    private:
+    struct Procedure {
+      Code<Flow> body       { };
+      u32        frame      { 0 };
+      bool       references { false };
+      bool       regional   { false };
+    };
+
+    using Writer = std::function<void(Cell*, Cell*)>;
+
+    Analyzer const&                                  analyzer;
+    TypeTable const&                                 table;
+    std::ostream&                                    out;
+    ExecutionLimits                                  limits;
+    EscapeAnalyzer const*                            escapes;
+    FlatMap<FunctionStatement const*, Box<Procedure>> procedures { };
+    runtime::Printer                                 printer;
+    std::vector<Error>                               errors     { };
+
+    /// @brief Memory of the values that do not escape, outliving every reference to them
+    runtime::Region                                  region     { };
+    std::vector<Cell>                                stack      { };
+    Procedure*                                       current    { nullptr };
+    Cell*                                            top        { nullptr };
+    Cell                                             result     { };
+    u32                                              depth      { 0 };
+    std::string                                      buffer     { };
+    i64                                              exit       { 0 };
+
+    /// @brief Structs and arrays made on the heap and the cells they hold, then the same in the region
+    u64                                              made[4]    { 0, 0, 0, 0 };
+
+    public:
+    /// @brief Constructs an executor
+    /// @param analyzer the analyzer that checked the program
+    /// @param table the table interning the types of the program
+    /// @param out the stream 'print' writes to
+    /// @param limits the bounds of the run
+    /// @param escapes the escape analysis of the program, nullptr to make every struct and array on the heap
+    Executor(Analyzer const& analyzer, TypeTable const& table, std::ostream& out, ExecutionLimits limits = { }, EscapeAnalyzer const* escapes = nullptr) noexcept;
+
+    /// @brief Compiles and runs 'main', which must take no parameters
+    /// @param program the analyzed program to run
+    /// @return the errors, empty if the program ran to completion
+    auto run(Program& program) -> std::vector<Error>;
+
+    /// @brief Value returned by 'main' if it returns an int, 0 otherwise
+    auto status() const noexcept -> i64;
+
+    /// @brief Structs and arrays made so far on the heap and in the region, and the cells they hold
+    auto heapObjects() const noexcept -> u64;
+    auto heapCells() const noexcept -> u64;
+    auto regionObjects() const noexcept -> u64;
+    auto regionCells() const noexcept -> u64;
+
+    /// @brief Region the values that do not escape are made in
+    auto regions() const noexcept -> runtime::Region const&;
+
+    using Walker::operator();
+
+    auto operator()(Identifier& arg) noexcept -> std::any override;
+    auto operator()(BoolLiteral& arg) noexcept -> std::any override;
+    auto operator()(ObjectLiteral& arg) noexcept -> std::any override;
+    auto operator()(StringLiteral& arg) noexcept -> std::any override;
+    auto operator()(FloatLiteral& arg) noexcept -> std::any override;
+    auto operator()(IntLiteral& arg) noexcept -> std::any override;
+    auto operator()(CharLiteral& arg) noexcept -> std::any override;
+    auto operator()(PrefixExpression& arg) noexcept -> std::any override;
+    auto operator()(InfixExpression& arg) noexcept -> std::any override;
+    auto operator()(CallExpression& arg) noexcept -> std::any override;
+    auto operator()(SubscriptExpression& arg) noexcept -> std::any override;
+    auto operator()(ArrayLiteral& arg) noexcept -> std::any override;
+    auto operator()(ExpressionStatement& arg) noexcept -> std::any override;
+    auto operator()(ReturnStatement& arg) noexcept -> std::any override;
+    auto operator()(PrintStatement& arg) noexcept -> std::any override;
+    auto operator()(BlockStatement& arg) noexcept -> std::any override;
+    auto operator()(IfStatement& arg) noexcept -> std::any override;
+    auto operator()(WhileStatement& arg) noexcept -> std::any override;
+    auto operator()(ForStatement& arg) noexcept -> std::any override;
+    auto operator()(DeclarationStatement& arg) noexcept -> std::any override;
+
+    private:
+    auto procedure(FunctionStatement& function) noexcept -> Procedure&;
+    auto expression(Expression& expr) noexcept -> Thunk;
+    auto statement(Statement& stmt) noexcept -> Code<Flow>;
+    auto unsupported(Span span, std::string message) noexcept -> Thunk;
+    auto typeOf(Expression const& expr) const noexcept -> TypeId;
+    auto reference(TypeId type) const noexcept -> bool;
+    auto writer(Expression& expr, u32 index) noexcept -> Writer;
+    auto call(CallExpression& arg, FunctionStatement& function) noexcept -> Thunk;
+    auto construct(Expression const& literal, Container<Box<Expression>>& values) noexcept -> Thunk;
+    auto member(InfixExpression& arg) noexcept -> Thunk;
+    auto binary(InfixExpression& arg) noexcept -> Thunk;
+    auto assign(InfixExpression& arg) noexcept -> Thunk;
+
+    template<class T>
+    auto typed(Expression& expr) noexcept -> Code<T>;
+
+    /// @brief Literals and locals are read in place, anything else is compiled
+    template<class T>
+    auto operand(Expression& expr) noexcept -> std::variant<T, u32, Code<T>>;
+
+    /// @brief Calls make.operator()<T>() with the representation T of a type
+    template<class Make>
+    auto dispatch(TypeId type, Make&& make) noexcept -> Thunk;
+
+    template<class T, class Op>
+    auto store(InfixExpression& arg, Op op) noexcept -> Thunk;
+  };
+
+}
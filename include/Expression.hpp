@@ -2,7 +2,10 @@
 
 #include "Token.hpp"
 #include "Visitable.hpp"
+#include "Source.hpp"
+#include "Symbol.hpp"
 #include "Traits.hpp"
+#include "Binding.hpp"
 
 namespace fridayc {
 
@@ -18,6 +21,9 @@ namespace fridayc {
     /// @brief Converts an expression into a std::string
     /// @return std::string representation
     virtual auto toString() const noexcept -> std::string = 0;
+
+    /// @brief Location of the expression in the source
+    Span span { };
   };
 
   inline namespace expressions {
@@ -26,11 +32,14 @@ namespace fridayc {
     struct Identifier : public Expression {
 
       /// @brief Value of the identifier
-      std::string id;
+      Symbol id;
+
+      /// @brief Declaration the identifier refers to
+      Binding binding { };
 
       /// @brief Constructs an identifier
       /// @param id name of the identifier
-      Identifier(std::string id) noexcept;
+      Identifier(Symbol id) noexcept;
 
       /// @brief Converts an identifier expression into a std::string
       /// @return std::string representation
@@ -82,10 +91,17 @@ namespace fridayc {
 
     /// @brief std::string literal expression
     struct StringLiteral : public Expression {
-      /// @brief Value of the std::string literal
-      std::string value;
+      /// @brief Value of the std::string literal, without quotes and with escapes decoded
+      std::string_view value;
+
+      /// @brief Storage of the value, used only when it is not a view into the source
+      std::string storage;
 
-      /// @brief Constructs a std::string literal
+      /// @brief Constructs a std::string literal referencing text it does not own
+      /// @param value the value of the std::string literal, must outlive the node
+      StringLiteral(std::string_view value) noexcept;
+
+      /// @brief Constructs a std::string literal owning its value
       /// @param value the value of the std::string literal
       StringLiteral(std::string value) noexcept;
 
@@ -175,7 +191,7 @@ namespace fridayc {
     struct TypeExpression : public Expression {
       
       /// @brief Constructs a type expression
-      TypeExpression(std::string name, u32 dimensions) noexcept;
+      TypeExpression(Symbol name, u32 dimensions) noexcept;
       
       /// @brief Converts an array literal into a std::string
       /// @return std::string representation
@@ -186,10 +202,13 @@ namespace fridayc {
       auto operator()(Visitor& visitor) noexcept -> std::any override;
 
       /// @brief Name of the type
-      std::string name;
+      Symbol name;
 
       /// @brief Dimensions of the type
       u32 dimensions;
+
+      /// @brief Declaration the type name refers to
+      Binding binding { };
     };
 
     /// @brief Prefix expression
@@ -259,6 +278,10 @@ namespace fridayc {
       /// @param visitor the visitor object
       auto operator()(Visitor& visitor) noexcept -> std::any override;
 
+      /// @brief Name of the called function or struct, plain or qualified by a namespace
+      /// @return the name or nullptr if the callee is computed
+      auto callee() const noexcept -> Identifier const*;
+
       /// @brief Value of the function name
       Box<Expression> function;
     };
@@ -0,0 +1,58 @@
+#pragma once
+
+namespace fridayc {
+
+  /// @brief Open-addressing hash map with linear probing, keys and values stored inline
+  /// @note Entries are never erased: callers that need removal store a sentinel value instead
+  template<class Key, class Value, class Hash = std::hash<Key>>
+  class FlatMap {
+    struct Slot {
+      Key   key;
+      Value value;
+    };
+
+    std::vector<Slot> slots { };
+    std::vector<u8>   used  { };
+    u64               count { 0 };
+
+    public:
+    /// @brief Constructs an empty map, no memory is allocated until the first insertion
+    constexpr FlatMap() noexcept = default;
+
+    /// @brief Finds the value of a key
+    /// @param key the key to look up
+    /// @return pointer to the value or nullptr, invalidated by the next insertion
+    constexpr auto find(Key const& key) noexcept -> Value*;
+    constexpr auto find(Key const& key) const noexcept -> Value const*;
+
+    /// @brief Inserts a key if absent
+    /// @param key the key
+    /// @param value the value stored if the key is absent
+    /// @return pointer to the value of the key and true if it was inserted
+    constexpr auto insert(Key const& key, Value value) -> std::pair<Value*, bool>;
+
+    /// @brief Value of a key, default constructed if absent
+    constexpr auto operator[](Key const& key) -> Value&;
+
+    constexpr auto contains(Key const& key) const noexcept -> bool;
+    constexpr auto size() const noexcept -> u64;
+    constexpr auto empty() const noexcept -> bool;
+
+    /// @brief Makes room for a number of keys without rehashing
+    constexpr auto reserve(u64 keys) -> void;
+
+    /// @brief Removes every key, keeping the capacity
+    constexpr auto clear() noexcept -> void;
+
+    /// @brief Calls a function on each key and value, in unspecified order
+    template<class Function>
+    constexpr auto forEach(Function&& function) const -> void;
+
+    private:
+    constexpr auto probe(Key const& key) const noexcept -> u64;
+    constexpr auto rehash(u64 capacity) -> void;
+  };
+
+}
+
+#include "FlatMap.inl"
@@ -0,0 +1,98 @@
+#ifdef __INTELLISENSE__
+#include "FlatMap.hpp"
+#endif
+
+namespace fridayc {
+
+  template<class Key, class Value, class Hash>
+  constexpr auto FlatMap<Key, Value, Hash>::find(Key const& key) noexcept -> Value* {
+    if(slots.empty()) return nullptr;
+    const u64 position = probe(key);
+    return used[position] ? &slots[position].value : nullptr;
+  }
+
+  template<class Key, class Value, class Hash>
+  constexpr auto FlatMap<Key, Value, Hash>::find(Key const& key) const noexcept -> Value const* {
+    if(slots.empty()) return nullptr;
+    const u64 position = probe(key);
+    return used[position] ? &slots[position].value : nullptr;
+  }
+
+  template<class Key, class Value, class Hash>
+  constexpr auto FlatMap<Key, Value, Hash>::insert(Key const& key, Value value) -> std::pair<Value*, bool> {
+    // * Keep the load factor at or below 1/2
+    if((count + 1) * 2 > slots.size()) rehash(std::max<u64>(16, slots.size() * 2));
+
+    const u64 position = probe(key);
+    if(used[position]) return { &slots[position].value, false };
+
+    slots[position] = Slot{ key, std::move(value) };
+    used[position] = 1;
+    ++count;
+    return { &slots[position].value, true };
+  }
+
+  template<class Key, class Value, class Hash>
+  constexpr auto FlatMap<Key, Value, Hash>::operator[](Key const& key) -> Value& {
+    return *insert(key, Value{ }).first;
+  }
+
+  template<class Key, class Value, class Hash>
+  constexpr auto FlatMap<Key, Value, Hash>::contains(Key const& key) const noexcept -> bool {
+    return find(key) != nullptr;
+  }
+
+  template<class Key, class Value, class Hash>
+  constexpr auto FlatMap<Key, Value, Hash>::size() const noexcept -> u64 {
+    return count;
+  }
+
+  template<class Key, class Value, class Hash>
+  constexpr auto FlatMap<Key, Value, Hash>::empty() const noexcept -> bool {
+    return count == 0;
+  }
+
+  template<class Key, class Value, class Hash>
+  constexpr auto FlatMap<Key, Value, Hash>::reserve(u64 keys) -> void {
+    if(keys * 2 > slots.size()) rehash(std::bit_ceil(std::max<u64>(16, keys * 2)));
+  }
+
+  template<class Key, class Value, class Hash>
+  constexpr auto FlatMap<Key, Value, Hash>::clear() noexcept -> void {
+    std::ranges::fill(used, 0);
+    count = 0;
+  }
+
+  template<class Key, class Value, class Hash>
+  template<class Function>
+  constexpr auto FlatMap<Key, Value, Hash>::forEach(Function&& function) const -> void {
+    for(u64 i = 0; i < slots.size(); ++i)
+      if(used[i]) std::invoke(function, slots[i].key, slots[i].value);
+  }
+
+  template<class Key, class Value, class Hash>
+  constexpr auto FlatMap<Key, Value, Hash>::probe(Key const& key) const noexcept -> u64 {
+    // * Fibonacci hashing spreads weak hashes (such as identity) over the table
+    const u64 mask = slots.size() - 1;
+    u64 position = (static_cast<u64>(Hash{}(key)) * 0x9E3779B97F4A7C15ull >> 32) & mask;
+
+    while(used[position] and not (slots[position].key == key))
+      position = (position + 1) & mask;
+
+    return position;
+  }
+
+  template<class Key, class Value, class Hash>
+  constexpr auto FlatMap<Key, Value, Hash>::rehash(u64 capacity) -> void {
+    std::vector<Slot> old_slots = std::exchange(slots, std::vector<Slot>(capacity));
+    std::vector<u8> old_used = std::exchange(used, std::vector<u8>(capacity, 0));
+
+    for(u64 i = 0; i < old_slots.size(); ++i) {
+      if(not old_used[i]) continue;
+      const u64 position = probe(old_slots[i].key);
+      slots[position] = std::move(old_slots[i]);
+      used[position] = 1;
+    }
+  }
+
+}
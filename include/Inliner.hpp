@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Cloner.hpp"
+#include "FlatMap.hpp"
+
+namespace fridayc {
+
+  /// @brief Bounds of the inliner
+  struct InlineLimits {
+    /// @brief Nodes in the returned expression of an inlined function
+    u32 size  { 24 };
+
+    /// @brief Inlined calls nested inside one another
+    u32 depth { 4 };
+
+    /// @brief Nodes added to a single function by inlining
+    u32 growth { 256 };
+  };
+
+  /// @brief Replaces calls to small functions by their returned expression
+  ///
+  /// A function is inlined when its body is a single 'return' of an
+  /// expression, as written by the '=>' form, that assigns nothing, is no
+  /// larger than the size limit, and does not lead into a cycle of
+  /// inlinable functions. The body is copied as it was before inlining, so
+  /// only the depth limit decides how far nested calls are expanded.
+  ///
+  /// Parameters are replaced by the arguments. Names and literals may be
+  /// copied freely; any other argument must be the only one of its kind,
+  /// used exactly once and not on the right-hand side of 'and'/'or', by a
+  /// body that neither calls nor may fail, as SideEffects tells, so that it
+  /// is still evaluated once and before anything that could fail. Calls
+  /// are left alone when the caller declares a local named like a global the
+  /// body refers to, so the result can be resolved again. Runs on a resolved
+  /// program and keeps its bindings.
+  class Inliner : public Walker {
+    struct Candidate {
+      Box<Expression>      body     { };
+      std::vector<u32>     uses     { };
+      std::vector<bool>    guarded  { };
+      std::vector<Symbol>  globals  { };
+      u32                  size     { 0 };
+      bool                 effects  { false };
+    };
+
+    InlineLimits                                   limits;
+    FlatMap<FunctionStatement const*, Candidate>   candidates { };
+    FlatMap<Symbol, bool>                          shadowing  { };
+    u32                                            depth      { 0 };
+    u32                                            budget     { 0 };
+    u64                                            inlined    { 0 };
+
+    public:
+    /// @brief Constructs an inliner
+    /// @param limits the bounds of inlining
+    explicit Inliner(InlineLimits limits = { }) noexcept;
+
+    /// @brief Inlines the small functions of a resolved program into their callers
+    /// @param program the program to transform
+    auto expand(Program& program) -> void;
+
+    /// @brief Number of calls replaced by the body of their callee
+    auto inlinedCalls() const noexcept -> u64;
+
+    using Walker::operator();
+
+    auto operator()(PrefixExpression& arg) noexcept -> std::any override;
+    auto operator()(InfixExpression& arg) noexcept -> std::any override;
+    auto operator()(CallExpression& arg) noexcept -> std::any override;
+    auto operator()(SubscriptExpression& arg) noexcept -> std::any override;
+    auto operator()(ExpressionStatement& arg) noexcept -> std::any override;
+    auto operator()(ArrayLiteral& arg) noexcept -> std::any override;
+    auto operator()(ReturnStatement& arg) noexcept -> std::any override;
+    auto operator()(PrintStatement& arg) noexcept -> std::any override;
+    auto operator()(IfStatement& arg) noexcept -> std::any override;
+    auto operator()(WhileStatement& arg) noexcept -> std::any override;
+    auto operator()(ForStatement& arg) noexcept -> std::any override;
+    auto operator()(FunctionStatement& arg) noexcept -> std::any override;
+    auto operator()(DeclarationStatement& arg) noexcept -> std::any override;
+
+    private:
+    auto select(Program& program) -> void;
+    auto expand(Box<Expression>& slot) noexcept -> void;
+    auto inlinable(CallExpression& call, Candidate const& candidate) const noexcept -> bool;
+  };
+
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "Walker.hpp"
+#include "FlatMap.hpp"
+
+namespace fridayc {
+
+  /// @brief Value computed at compile time
+  struct Value {
+    using Array = std::vector<Value>;
+
+    /// @brief Contents, std::monostate for 'void' and for locals not assigned yet
+    std::variant<std::monostate, Long, Double, Boolean, Character, std::string, std::shared_ptr<Array const>> data { };
+
+    /// @brief Tells whether two values are the same, elementwise for arrays and bitwise for floats
+    auto operator==(Value const& other) const noexcept -> bool;
+  };
+
+}
+
+template<>
+struct std::hash<fridayc::Value> {
+  auto operator()(fridayc::Value const& value) const noexcept -> u64;
+};
+
+namespace fridayc {
+
+  /// @brief Bounds of a single compile-time evaluation
+  struct EvaluationLimits {
+    /// @brief Nodes visited
+    u64 steps  { 1'000'000 };
+
+    /// @brief Bytes of strings, arrays and frames created
+    u64 memory { 16 * 1024 * 1024 };
+
+    /// @brief Nested calls
+    u32 depth  { 256 };
+
+    /// @brief Memoized calls kept across evaluations
+    u64 memo   { 64 * 1024 };
+  };
+
+  /// @brief Evaluates resolved expressions at compile time
+  ///
+  /// Locals and parameters live in frames indexed by the slots of the
+  /// Resolver. Only functions listed as pure may be called, and calls are
+  /// memoized by argument values. An evaluation fails, leaving nothing
+  /// behind, when it reads something that is not constant, exceeds its
+  /// limits, or would fault at run time.
+  class Interpreter : public Walker {
+    struct Call {
+      FunctionStatement const* function { nullptr };
+      std::vector<Value>       arguments { };
+
+      auto operator==(Call const& other) const noexcept -> bool = default;
+    };
+
+    struct CallHash {
+      auto operator()(Call const& call) const noexcept -> u64;
+    };
+
+    FlatMap<FunctionStatement const*, bool> const&  pure;
+    EvaluationLimits                                limits;
+    FlatMap<DeclarationStatement const*, Value>     constants { };
+    FlatMap<Call, Value, CallHash>                  memo      { };
+    std::vector<std::vector<Value>>                 frames    { };
+    Value                                           result    { };
+    u64                                             steps     { 0 };
+    u64                                             memory    { 0 };
+    u64                                             hits      { 0 };
+    bool                                            returning { false };
+    bool                                            failed    { false };
+
+    public:
+    /// @brief Constructs an interpreter
+    /// @param pure the functions that may be called, mapped to true
+    /// @param limits the bounds of each evaluation
+    Interpreter(FlatMap<FunctionStatement const*, bool> const& pure, EvaluationLimits limits = { }) noexcept;
+
+    /// @brief Evaluates an expression outside of any function
+    /// @note Locals can only be read if they are constants given to define()
+    /// @return the value or std::nullopt if the expression cannot be evaluated
+    auto evaluate(Expression& expr) noexcept -> std::optional<Value>;
+
+    /// @brief Records the value of a constant local
+    /// @note Only scalars are recorded, strings and arrays stay unknown since their elements can be assigned
+    auto define(DeclarationStatement const& constant, Value value) -> void;
+
+    /// @brief Value of a constant local given to define()
+    /// @return the value or nullptr if it is unknown
+    auto constant(DeclarationStatement const& constant) const noexcept -> Value const*;
+
+    /// @brief Number of calls answered from the memo
+    auto memoized() const noexcept -> u64;
+
+    using Walker::operator();
+
+    auto operator()(Identifier& arg) noexcept -> std::any override;
+    auto operator()(BoolLiteral& arg) noexcept -> std::any override;
+    auto operator()(ObjectLiteral& arg) noexcept -> std::any override;
+    auto operator()(StringLiteral& arg) noexcept -> std::any override;
+    auto operator()(FloatLiteral& arg) noexcept -> std::any override;
+    auto operator()(IntLiteral& arg) noexcept -> std::any override;
+    auto operator()(CharLiteral& arg) noexcept -> std::any override;
+    auto operator()(PrefixExpression& arg) noexcept -> std::any override;
+    auto operator()(InfixExpression& arg) noexcept -> std::any override;
+    auto operator()(CallExpression& arg) noexcept -> std::any override;
+    auto operator()(SubscriptExpression& arg) noexcept -> std::any override;
+    auto operator()(ArrayLiteral& arg) noexcept -> std::any override;
+    auto operator()(ExpressionStatement& arg) noexcept -> std::any override;
+    auto operator()(ReturnStatement& arg) noexcept -> std::any override;
+    auto operator()(PrintStatement& arg) noexcept -> std::any override;
+    auto operator()(BlockStatement& arg) noexcept -> std::any override;
+    auto operator()(IfStatement& arg) noexcept -> std::any override;
+    auto operator()(WhileStatement& arg) noexcept -> std::any override;
+    auto operator()(ForStatement& arg) noexcept -> std::any override;
+    auto operator()(DeclarationStatement& arg) noexcept -> std::any override;
+
+    private:
+    auto fail() noexcept -> std::any;
+    auto step() noexcept -> bool;
+    auto allocate(u64 bytes) noexcept -> bool;
+    auto eval(Expression& expr) noexcept -> std::optional<Value>;
+    auto condition(Expression& expr) noexcept -> std::optional<bool>;
+    auto variable(Identifier const& name) noexcept -> Value*;
+    auto assign(InfixExpression& arg) noexcept -> std::any;
+    auto combine(Token::Type oper, Value const& lhs, Value const& rhs) noexcept -> std::optional<Value>;
+  };
+
+}
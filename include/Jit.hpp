@@ -0,0 +1,82 @@
+#pragma once
+
+#include "NativeRuntime.hpp"
+
+namespace fridayc {
+
+  namespace x86 {
+    class Assembler;
+  }
+
+  /// @brief Compiles the bytecode of a module to x86-64 machine code and runs it
+  ///
+  /// A baseline JIT: every instruction is translated on its own, from a
+  /// template of machine code, in a single pass over the function, and runs
+  /// on the NativeRuntime, so scalars are read and written in place in the
+  /// register windows of the VirtualMachine. Int and float arithmetic,
+  /// comparisons, branches and calls are translated inline; strings,
+  /// structs, arrays and 'print' call back into the runtime. The code is
+  /// written to memory that is then made executable and never writable
+  /// again, and every function is listed in /tmp/perf-<pid>.map, so Linux
+  /// perf attributes samples to it.
+  /// @note Needs x86-64 and the System V calling convention, see available()
+  class Jit {
+    public:
+    /// @brief Machine code of a function, at an offset from the start of the code
+    struct Compiled {
+      Symbol name   { };
+      u32    offset { 0 };
+      u32    size   { 0 };
+    };
+
+    private:
+    /// @brief A call whose displacement is patched once every function is placed
+    struct Call {
+      u32 position { 0 };
+      u32 callee   { 0 };
+    };
+
+    bytecode::Module&      module;
+    std::vector<Compiled>  compiled { };
+    std::vector<Call>      calls    { };
+    u8*                    memory   { nullptr };
+    u64                    mapped   { 0 };
+    NativeRuntime          native;
+    std::vector<Error>     errors   { };
+
+    public:
+    /// @brief Constructs a JIT
+    /// @param module the module to compile, which must outlive the JIT
+    /// @param out the stream 'print' writes to
+    /// @param limits the bounds of the run
+    Jit(bytecode::Module& module, std::ostream& out, ExecutionLimits limits = { }) noexcept;
+    Jit(Jit const&) = delete;
+    auto operator=(Jit const&) -> Jit& = delete;
+    ~Jit() noexcept;
+
+    /// @brief Tells whether the machine code can run on this platform
+    static auto available() noexcept -> bool;
+
+    /// @brief Compiles every function of the module, materializing those of a module file
+    /// @return the errors, empty if the code is ready to run
+    auto compile() -> std::vector<Error>;
+
+    /// @brief Runs 'main', which must have been compiled
+    /// @return the errors, empty if the program ran to completion
+    auto run() -> std::vector<Error>;
+
+    /// @brief Value returned by 'main' if it returns an int, 0 otherwise
+    auto status() const noexcept -> i64;
+
+    /// @brief Compiled functions, in the order of the module
+    auto functions() const noexcept -> std::vector<Compiled> const&;
+
+    private:
+    /// @brief Appends the machine code of a function
+    auto translate(x86::Assembler& assembler, u32 function) -> void;
+
+    /// @brief Lists the compiled functions in the perf map of the process
+    auto publish() const -> void;
+  };
+
+}
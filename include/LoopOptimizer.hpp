@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Walker.hpp"
+#include "FlatMap.hpp"
+#include "TypeTable.hpp"
+
+namespace fridayc {
+
+  class Analyzer;
+
+  /// @brief Hoists loop-invariant expressions and strength-reduces subscripts of 'for' loops
+  ///
+  /// Inner loops are optimized first. An expression is invariant when every
+  /// local it reads is neither assigned nor declared in the loop, and it
+  /// calls nothing; field and element reads are invariant only in loops that
+  /// neither call nor store into fields or elements. Invariant expressions
+  /// that cannot fail are computed once before the loop, even if the loop
+  /// never runs. Field reads, subscripts, divisions, shifts and int
+  /// arithmetic that may overflow can fail, so they are only hoisted from
+  /// the condition, which runs before anything else in the loop, and only
+  /// from the part of it that runs before any call.
+  ///
+  /// In a 'for' loop stepping a local by a positive literal, from a literal
+  /// towards a literal bound, products of that local and a literal inside
+  /// subscript indices are replaced by a local kept equal to the product by
+  /// an addition per iteration. The local is computed before the first
+  /// iteration and past the last one, where the loop never multiplies, so
+  /// none of the products from the first value to one step past the bound
+  /// may overflow. Such a loop becomes a 'while' loop with the step after
+  /// its body, since nothing can skip to the step.
+  ///
+  /// The results live in temporaries declared in a block wrapping the loop,
+  /// with frame slots appended to the function. Runs on an analyzed
+  /// program, whose types describe the temporaries.
+  class LoopOptimizer : public Walker {
+    enum struct Invariance : u8 { SAFE, FALLIBLE, VARIANT };
+
+    struct Loop {
+      std::vector<bool> variant { };
+      bool writes      { false };
+      bool calls       { false };
+      bool fallible    { false };
+    };
+
+    enum struct Mode : u8 { SEARCH, HOIST, REDUCE };
+
+    Analyzer const&                                   analyzer;
+    TypeTable const&                                  table;
+    FunctionStatement*                                function    { nullptr };
+    Loop                                              loop        { };
+    Mode                                              mode        { Mode::SEARCH };
+    bool                                              anticipated { false };
+    bool                                              indexed     { false };
+    std::vector<Box<Statement>>                       temporaries { };
+    FlatMap<std::string, DeclarationStatement*>       hoisted     { };
+    Identifier const*                                 induction   { nullptr };
+    Expression*                                       amount      { nullptr };
+    bool                                              descending  { false };
+    i64                                               lowest      { 0 };
+    i64                                               highest     { 0 };
+    FlatMap<std::string, DeclarationStatement*>       reduced     { };
+    std::vector<Box<Statement>>                       updates     { };
+    u32                                               names       { 0 };
+    u64                                               expressions { 0 };
+    u64                                               products    { 0 };
+
+    public:
+    /// @brief Constructs a loop optimizer
+    /// @param analyzer the analyzer that checked the program
+    /// @param table the table interning the types of the program
+    LoopOptimizer(Analyzer const& analyzer, TypeTable const& table) noexcept;
+
+    /// @brief Optimizes every loop of an analyzed program
+    /// @param program the program to transform
+    auto optimize(Program& program) -> void;
+
+    /// @brief Number of distinct expressions hoisted out of loops
+    auto hoistedExpressions() const noexcept -> u64;
+
+    /// @brief Number of products replaced by additions
+    auto reducedProducts() const noexcept -> u64;
+
+    using Walker::operator();
+
+    auto operator()(PrefixExpression& arg) noexcept -> std::any override;
+    auto operator()(InfixExpression& arg) noexcept -> std::any override;
+    auto operator()(CallExpression& arg) noexcept -> std::any override;
+    auto operator()(SubscriptExpression& arg) noexcept -> std::any override;
+    auto operator()(ExpressionStatement& arg) noexcept -> std::any override;
+    auto operator()(ArrayLiteral& arg) noexcept -> std::any override;
+    auto operator()(ReturnStatement& arg) noexcept -> std::any override;
+    auto operator()(PrintStatement& arg) noexcept -> std::any override;
+    auto operator()(BlockStatement& arg) noexcept -> std::any override;
+    auto operator()(IfStatement& arg) noexcept -> std::any override;
+    auto operator()(WhileStatement& arg) noexcept -> std::any override;
+    auto operator()(ForStatement& arg) noexcept -> std::any override;
+    auto operator()(FunctionStatement& arg) noexcept -> std::any override;
+    auto operator()(DeclarationStatement& arg) noexcept -> std::any override;
+
+    private:
+    auto optimize(Box<Statement>& slot) noexcept -> void;
+    auto summarize(Statement& stmt) noexcept -> void;
+    auto summarize(Expression& expr) noexcept -> void;
+    auto rewrite(Box<Expression>& slot) noexcept -> void;
+    auto hoist(Box<Expression>& slot) noexcept -> void;
+    auto reduce(Box<Expression>& slot) noexcept -> void;
+    auto reduce(ForStatement& loop) noexcept -> bool;
+    auto invariance(Expression& expr) const noexcept -> Invariance;
+    auto temporary(Box<Expression> init, Box<TypeExpression> type, bool constant) noexcept -> DeclarationStatement*;
+    auto typeExpression(TypeId type) const noexcept -> Box<TypeExpression>;
+    auto reference(DeclarationStatement& temporary, Span span) const noexcept -> Box<Expression>;
+  };
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Expression.hpp"
+
+namespace fridayc {
+
+  /// @brief Named and typed entry of a struct field list or a function parameter list
+  struct Member {
+
+    /// @brief Name of the member
+    Symbol name;
+
+    /// @brief Type of the member
+    Box<TypeExpression> type;
+  };
+
+  /// @brief Contiguous, declaration-ordered list of members
+  /// @note Small lists are searched linearly, larger ones build an open-addressing index
+  class Members {
+    std::vector<Member> members { };
+    std::vector<u32>    slots   { };
+
+    public:
+    using value_type     = Member;
+    using iterator       = std::vector<Member>::iterator;
+    using const_iterator = std::vector<Member>::const_iterator;
+
+    /// @brief Member count from which lookups go through the hash index
+    static constexpr u64 INDEX_THRESHOLD = 16;
+
+    /// @brief Default constructor
+    Members() noexcept = default;
+
+    /// @brief Appends a member, keeping declaration order
+    /// @param name the name of the member
+    /// @param type the type of the member
+    /// @return false if a member with the same name already exists
+    auto add(Symbol name, Box<TypeExpression> type) noexcept -> bool;
+
+    /// @brief Finds the declaration position of a member
+    /// @param name the name of the member
+    /// @return the position or std::nullopt if there is no such member
+    auto indexOf(Symbol name) const noexcept -> std::optional<u32>;
+
+    /// @brief Finds the type of a member
+    /// @param name the name of the member
+    /// @return the type or nullptr if there is no such member
+    auto find(Symbol name) const noexcept -> TypeExpression*;
+
+    /// @brief Tells whether a member exists
+    /// @param name the name of the member
+    auto contains(Symbol name) const noexcept -> bool;
+
+    auto begin() noexcept -> iterator;
+    auto begin() const noexcept -> const_iterator;
+    auto end() noexcept -> iterator;
+    auto end() const noexcept -> const_iterator;
+    auto size() const noexcept -> u64;
+    auto empty() const noexcept -> bool;
+    auto operator[](u64 index) noexcept -> Member&;
+    auto operator[](u64 index) const noexcept -> Member const&;
+
+    private:
+    static constexpr u32 EMPTY_SLOT = std::numeric_limits<u32>::max();
+
+    auto indexed() const noexcept -> bool;
+    auto probe(Symbol name) const noexcept -> u64;
+    auto rehash(u64 capacity) noexcept -> void;
+  };
+
+}
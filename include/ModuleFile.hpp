@@ -0,0 +1,141 @@
+#pragma once
+
+#include "Bytecode.hpp"
+
+namespace fridayc::bytecode {
+
+  /// @brief A precompiled module (.fxc), mapped into memory
+  ///
+  /// The file is a header followed by sections at offsets from the start of
+  /// the file, so it reads the same wherever it is mapped: a symbol table
+  /// of every name, path and string constant, their text, the string
+  /// constants, the shapes of the printed types, the formats, a table with
+  /// the offset of every function, and the functions. Code refers to
+  /// functions, constants and formats by index and jumps by instruction, so
+  /// it is stored as the compiler left it. Spans are stored without their
+  /// file, which is the source the module was compiled from, recorded by
+  /// path along with a hash of its text: a module whose source has changed
+  /// since is refused. Loading reads the header and the pools only, the code
+  /// of a function is decoded out of the mapping on its first call.
+  /// @note Integers are stored in the byte order of the machine that wrote them
+  class ModuleFile {
+    /// @brief Offset of a section from the start of the file, and its number of entries
+    struct Section {
+      u32 offset { 0 };
+      u32 count  { 0 };
+    };
+
+    struct Header {
+      u32     magic     { 0 };
+      u32     version   { 0 };
+
+      /// @brief Hash of the text of the source
+      u64     hash      { 0 };
+
+      /// @brief Symbol of the path of the source
+      u32     source    { 0 };
+
+      /// @brief Whether 'main' returns an int
+      u32     returns   { 0 };
+
+      /// @brief Names, an offset into the text and a length each
+      Section symbols   { };
+      Section text      { };
+
+      /// @brief Symbols of the string constants
+      Section strings   { };
+
+      /// @brief Words of the shapes: kind, name, names and their symbols, parts and their shapes
+      Section shapes    { };
+      Section formats   { };
+      Section functions { };
+    };
+
+    struct Name {
+      u32 offset { 0 };
+      u32 length { 0 };
+    };
+
+    /// @brief Entry of the function table, the body at offset holds the code, the constants, then the spans
+    struct Entry {
+      u32  name          { 0 };
+      u32  offset        { 0 };
+      Span span          { };
+      u32  instructions  { 0 };
+      u32  constants     { 0 };
+      u16  parameters    { 0 };
+      u16  constant_base { 0 };
+      u16  temporaries   { 0 };
+      u16  registers     { 0 };
+      u32  references    { 0 };
+    };
+
+    static constexpr u32 MAGIC   = 0x00435846; // * "FXC\0"
+    static constexpr u32 VERSION = 1;          // * Bumped whenever the layout or the opcodes change
+
+    u8 const* data     { nullptr };
+    u64       size     { 0 };
+    void*     mapping  { nullptr };
+
+    /// @brief Whether the bytes belong to someone else, as an image linked into a native program does
+    bool      borrowed { false };
+    Header    header   { };
+
+    /// @brief Registered source the spans of the functions point into
+    u32       source   { Sources::NONE };
+
+    public:
+    /// @brief Maps a file, empty if it cannot be mapped
+    explicit ModuleFile(std::string const& path) noexcept;
+
+    /// @brief Reads a module image already in memory, which must outlive it
+    ModuleFile(u8 const* image, u64 length) noexcept;
+
+    ModuleFile(ModuleFile const&) = delete;
+    auto operator=(ModuleFile const&) -> ModuleFile& = delete;
+
+    ~ModuleFile() noexcept;
+
+    /// @brief Writes a compiled module
+    /// @param module the module, with every function materialized
+    /// @param source the registered source the module was compiled from
+    /// @param path the path of the file to write
+    /// @return the errors, empty if the file was written
+    static auto write(Module const& module, u32 source, std::string const& path) -> std::vector<Error>;
+
+    /// @brief Bytes of the module file of a compiled module, as write() stores them
+    /// @return the bytes and the errors, empty if the module fits in a module file
+    static auto encode(Module const& module, u32 source) -> std::pair<std::string, std::vector<Error>>;
+
+    /// @brief Maps a module file and reads its pools, registering the source it was compiled from
+    /// @param path the path of the file
+    /// @return the module, whose functions are materialized on first use, and the errors, empty if it loaded
+    static auto load(std::string const& path) -> std::pair<Module, std::vector<Error>>;
+
+    /// @brief Reads a module image in memory, as encode() leaves it
+    /// @param image the bytes, which must outlive the module
+    /// @param length the number of bytes
+    /// @param name what errors call the image
+    /// @return the module and the errors, empty if it loaded
+    /// @note A source that changed since is read without its text rather than refused, the image cannot be rebuilt
+    static auto load(u8 const* image, u64 length, std::string const& name) -> std::pair<Module, std::vector<Error>>;
+
+    /// @brief Decodes the function of an index, faults on a corrupt body
+    auto decode(u32 index, Function& into) const -> void;
+
+    private:
+    /// @brief Reads the pools of a mapped file or image
+    static auto open(std::shared_ptr<ModuleFile> file, std::string const& path, bool image) -> std::pair<Module, std::vector<Error>>;
+
+    /// @brief Tells whether a section lies inside the file
+    auto holds(Section section, u64 unit) const noexcept -> bool;
+
+    /// @brief Value of type T at an offset
+    template<class T>
+    auto read(u64 offset) const noexcept -> T;
+
+    /// @brief Text of a symbol, empty if it is out of range
+    auto name(u32 symbol) const noexcept -> std::string_view;
+  };
+
+}
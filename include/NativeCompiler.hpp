@@ -0,0 +1,141 @@
+#pragma once
+
+#include "NativeRuntime.hpp"
+#include "ObjectFile.hpp"
+
+namespace fridayc {
+
+  namespace x86 {
+    class Assembler;
+  }
+
+  /// @brief Compiles the bytecode of a module ahead of time to an x86-64 ELF object
+  ///
+  /// Every function is lowered to a machine IR: its instructions with the
+  /// scalar registers they read and write made explicit, and whether they
+  /// call out of the function. Registers that only ever hold scalars get
+  /// a live interval from a liveness analysis over the control flow, and a
+  /// linear scan gives them machine registers: callee-saved ones to the
+  /// intervals that live across a call, caller-saved ones first to the
+  /// others, spilling the interval that ends last when they run out.
+  /// Spilled registers, and registers that hold references, stay in the
+  /// cells of the frame, which are the register windows of the
+  /// VirtualMachine, so the code runs on the NativeRuntime like the Jit's.
+  ///
+  /// The object defines 'main', which passes the module, embedded in
+  /// .rodata as the bytes of a module file, and its compiled 'main' to
+  /// fx_rt_start. The runtime is in fridaylib, its strings in
+  /// fridaystrings, so the object is linked as
+  ///   cc program.o -L<fridaylib directory> -lfridaylib -lfridaystrings -lstdc++exp -lstdc++ -lm -o program
+  /// see link(). Calls into the runtime go through the PLT, the module is
+  /// reached relative to the code, so the program may be position independent.
+  /// @note Writes code for x86-64 and the System V calling convention, wherever it runs
+  class NativeCompiler {
+    public:
+    /// @brief Where a register lives, a machine register or its cell in the frame
+    static constexpr u8 IN_MEMORY = 0xFF;
+
+    private:
+    /// @brief An instruction of the machine IR
+    struct Operation {
+      bytecode::Instruction instruction { };
+
+      /// @brief Scalar registers read, the first count of them
+      std::array<u16, 3>    reads       { };
+      u8                    count       { 0 };
+
+      /// @brief Scalar register written, if any
+      std::optional<u16>    writes      { };
+
+      /// @brief Argument window of a call, read by it
+      u16                   window      { 0 };
+      u16                   arguments   { 0 };
+
+      /// @brief Whether it calls a function or the runtime, which may clobber caller-saved registers
+      bool                  calls       { false };
+    };
+
+    /// @brief Instructions a scalar register is live across, as positions of the code
+    struct Interval {
+      u16  reg      { 0 };
+      u32  start    { 0 };
+      u32  end      { 0 };
+
+      /// @brief Whether it is live across an operation that calls
+      bool crosses  { false };
+      u8   location { IN_MEMORY };
+    };
+
+    /// @brief A function lowered to the machine IR and allocated
+    struct Lowered {
+      std::vector<Operation> code      { };
+
+      /// @brief Whether a register only ever holds scalars
+      std::vector<bool>      scalar    { };
+
+      /// @brief Location of every register
+      std::vector<u8>        locations { };
+
+      /// @brief Scalar registers the code reads before writing, which the entry must set up
+      std::vector<bool>      entering  { };
+
+      /// @brief Callee-saved machine registers the allocation uses
+      std::vector<u8>        saved     { };
+    };
+
+    /// @brief A call to an other function, patched once every function is placed
+    struct Call {
+      u32 position { 0 };
+      u32 callee   { 0 };
+    };
+
+    bytecode::Module&  module;
+    u32                source;
+    ObjectFile         object    { };
+    std::vector<u32>   offsets   { };
+    std::vector<Call>  calls     { };
+    u32                slow      { 0 };
+    u32                fail      { 0 };
+    u64                allocated { 0 };
+    u64                spilled   { 0 };
+
+    public:
+    /// @brief Constructs a compiler
+    /// @param module the module to compile, which must outlive the compiler
+    /// @param source the registered source the module was compiled from
+    NativeCompiler(bytecode::Module& module, u32 source) noexcept;
+
+    /// @brief Compiles every function of the module and the entry point of the program
+    /// @return the errors, empty if the object is ready to be written
+    auto compile() -> std::vector<Error>;
+
+    /// @brief Writes the compiled object
+    /// @return the errors, empty if the file was written
+    auto write(std::string const& path) const -> std::vector<Error>;
+
+    /// @brief Links an object with the runtime into an executable, with the system C compiler as the driver
+    /// @param object the written object
+    /// @param output the executable
+    /// @param library the directory of fridaylib
+    /// @return the errors, empty if the link succeeded
+    /// @note The compiler is $CC, cc by default, run without a shell
+    static auto link(std::string const& object, std::string const& output, std::string const& library) -> std::vector<Error>;
+
+    /// @brief Intervals given a machine register
+    auto allocatedIntervals() const noexcept -> u64;
+
+    /// @brief Intervals left in memory
+    auto spilledIntervals() const noexcept -> u64;
+
+    private:
+    /// @brief Lowers a function to the machine IR
+    auto lower(u32 function) const -> Lowered;
+
+    /// @brief Computes the live intervals of the scalar registers and allocates them by linear scan
+    auto allocate(bytecode::Function const& function, Lowered& lowered) -> void;
+
+    /// @brief Appends the machine code of a lowered function
+    auto emit(x86::Assembler& assembler, u32 function, Lowered const& lowered) -> void;
+  };
+
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Bytecode.hpp"
+
+namespace fridayc {
+
+  /// @brief What machine code compiled from bytecode runs against
+  ///
+  /// Frames are the register windows of the VirtualMachine, held in one
+  /// stack of cells. The machine code gets the base of its frame and a
+  /// Context, reads and writes scalars in place, and calls back here for
+  /// what it leaves to the runtime: strings, structs, arrays, 'print' and
+  /// releasing the references of a frame. Every function returns a status,
+  /// 0 or 1 if it faulted, rather than throwing, and faults are recorded
+  /// with the same message at the same span as the VirtualMachine. Both the
+  /// Jit and the objects of the NativeCompiler run on it, the latter through
+  /// the C entry points at the end of this file.
+  class NativeRuntime {
+    public:
+    /// @brief Faults the machine code raises itself, the runtime reports the others
+    enum struct Fault : u32 { INTEGER_OVERFLOW, DIVISION_BY_ZERO, SHIFT_OUT_OF_RANGE, STACK_OVERFLOW, ENDED };
+
+    /// @brief What a function returns, known from its return instructions
+    enum struct Returns : u8 { NOTHING, SCALAR, REFERENCE };
+
+    /// @brief Site of the call to 'main', which has no caller
+    static constexpr u64 NO_SITE = ~0ull;
+
+    /// @brief What the machine code reads and writes besides the registers, at offsets its templates know
+    struct Context {
+      NativeRuntime* native { nullptr };
+      runtime::Cell* end    { nullptr };
+
+      /// @brief Scalar returned by the last call
+      i64            value  { 0 };
+
+      /// @brief Function and instruction of the last call to a function that may end without a value
+      u64            site   { 0 };
+      u32            depth  { 0 };
+      u32            limit  { 0 };
+    };
+
+    /// @brief Machine code of a function, called with the base of its frame
+    using Entry = u32 (*)(runtime::Cell* base, Context* context);
+
+    private:
+    using Cell = runtime::Cell;
+
+    bytecode::Module&   module;
+    std::ostream&       out;
+    ExecutionLimits     limits;
+    std::vector<Cell>   stack    { };
+    Context             context  { };
+
+    /// @brief Reference returned by the last call
+    runtime::Ref        returned { };
+    std::vector<Error>  errors   { };
+    std::string         buffer   { };
+    i64                 exit     { 0 };
+
+    public:
+    /// @brief Constructs a runtime
+    /// @param module the module the machine code was compiled from, with every function materialized
+    /// @param out the stream 'print' writes to
+    /// @param limits the bounds of the run
+    NativeRuntime(bytecode::Module& module, std::ostream& out, ExecutionLimits limits = { }) noexcept;
+
+    /// @brief Runs the machine code of 'main'
+    /// @return the errors, empty if the program ran to completion
+    auto run(Entry main) -> std::vector<Error>;
+
+    /// @brief Value returned by 'main' if it returns an int, 0 otherwise
+    auto status() const noexcept -> i64;
+
+    /// @brief Runs an instruction the machine code leaves to the runtime
+    /// @return 0, or 1 if it faulted
+    static auto slow(Context* context, Cell* base, u32 function, u32 at) noexcept -> u32;
+
+    /// @brief Records a fault raised by the machine code of an instruction
+    static auto fail(Context* context, u32 function, u32 at, u32 kind, u64 site) noexcept -> void;
+
+    static auto returnsOf(bytecode::Function const& function) noexcept -> Returns;
+
+    /// @brief Tells whether a function may end without returning a value
+    static auto falls(bytecode::Function const& function) noexcept -> bool;
+  };
+
+}
+
+/// @brief Entry points of the runtime a native object links against, see NativeCompiler
+extern "C" {
+
+  /// @brief Loads the module image embedded in the object, runs its 'main' and reports the errors
+  /// @return the exit status of the program
+  auto fx_rt_start(u8 const* image, u64 size, fridayc::NativeRuntime::Entry main) -> i32;
+
+  auto fx_rt_slow(fridayc::NativeRuntime::Context* context, fridayc::runtime::Cell* base, u32 function, u32 at) -> u32;
+
+  auto fx_rt_fail(fridayc::NativeRuntime::Context* context, u32 function, u32 at, u32 kind, u64 site) -> void;
+
+}
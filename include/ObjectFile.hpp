@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Error.hpp"
+
+namespace fridayc {
+
+  /// @brief An x86-64 ELF relocatable object, built in memory then written
+  ///
+  /// Holds code in .text and read-only data in .rodata, the symbols defined
+  /// in them or left to the linker, and the relocations of .text against
+  /// those symbols. The file also gets an empty .note.GNU-stack, so the
+  /// linked program keeps a stack that is not executable.
+  /// @note Little-endian x86-64 only, as the NativeCompiler writes it
+  class ObjectFile {
+    public:
+    enum struct Section : u16 { UNDEFINED = 0, TEXT = 1, RODATA = 2 };
+
+    /// @brief Relocation types of the x86-64 psABI the code needs
+    enum struct Relocation : u32 { PC32 = 2, PLT32 = 4 };
+
+    private:
+    struct Definition {
+      std::string name     { };
+      Section     section  { Section::UNDEFINED };
+      u64         offset   { 0 };
+      u64         size     { 0 };
+      bool        global   { false };
+      bool        function { false };
+    };
+
+    struct Fixup {
+      u64        offset { 0 };
+      u32        symbol { 0 };
+      Relocation type   { Relocation::PC32 };
+      i64        addend { 0 };
+    };
+
+    std::vector<u8>          text    { };
+    std::string              rodata  { };
+    std::vector<Definition>  symbols { };
+    std::vector<Fixup>       fixups  { };
+
+    public:
+    /// @brief Bytes of .text
+    auto code() noexcept -> std::vector<u8>&;
+
+    /// @brief Bytes of .rodata
+    auto data() noexcept -> std::string&;
+
+    /// @brief Defines a symbol at an offset of a section
+    /// @return the symbol, for relocations
+    auto define(std::string name, Section section, u64 offset, u64 size, bool global, bool function) -> u32;
+
+    /// @brief Declares a symbol another object defines
+    /// @return the symbol, for relocations
+    auto declare(std::string name) -> u32;
+
+    /// @brief Has the linker write the address of a symbol, plus an addend, relative to the field at an offset of .text
+    auto relocate(u64 offset, u32 symbol, Relocation type, i64 addend) -> void;
+
+    /// @brief Bytes of the object file
+    auto encode() const -> std::string;
+
+    /// @brief Writes the object file
+    /// @return the errors, empty if the file was written
+    auto write(std::string const& path) const -> std::vector<Error>;
+  };
+
+}
@@ -9,13 +9,16 @@ namespace fridayc {
   class Parser {
     std::vector<Error> error_queue { };
     std::vector<Token> tokens      { };
+    std::string_view   source      { };
     u64           pos              { 0 };
+    u32           file             { Sources::NONE };
     bool          panic_mode       { false };
 
     public:
     /// @brief Construct a parser from source code
     /// @param tokens token stream
-    Parser(std::vector<Token> tokens) noexcept;
+    /// @param file identifier of the registered source the tokens come from, used to fill node spans
+    Parser(std::vector<Token> tokens, u32 file = Sources::NONE) noexcept;
 
     /// @brief Move constructor
     /// @param other rvalue reference to the moved object
@@ -64,6 +67,9 @@ namespace fridayc {
     auto peek(u64 ahead = 0) -> Token const&;
     auto consume() noexcept -> Token;
 
+    auto spanOf(Token const& token) const noexcept -> Span;
+    auto spanFrom(Token const& start) const noexcept -> Span;
+
     auto parseStatement() noexcept -> Box<Statement>;
     auto parseTopLevelStatement() noexcept -> Box<Statement>;
     auto parseExpressionStatement() noexcept -> Box<Statement>;
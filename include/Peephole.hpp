@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Bytecode.hpp"
+
+namespace fridayc {
+
+  /// @brief Forms superinstructions out of the bytecode of a module
+  ///
+  /// Three patterns are rewritten, all of them what an assignment from an
+  /// infix expression leaves behind:
+  ///  - an instruction computing a temporary that is only moved somewhere
+  ///    else computes into the destination of the move instead, so
+  ///    'x = y + z' runs as a single ADD,
+  ///  - an ADD or a SUB of a constant that fits 16 bits becomes an ADD_IMM,
+  ///    which reads its constant from the instruction,
+  ///  - 'i += 1' followed by the branch back of 'i < n' becomes an INC_JLT.
+  /// An instruction some jump lands on is never merged into the one before.
+  class Peephole {
+    u64 moves      { 0 };
+    u64 immediates { 0 };
+    u64 steps      { 0 };
+
+    public:
+    constexpr Peephole() noexcept = default;
+
+    /// @brief Rewrites every function of a module in place
+    auto optimize(bytecode::Module& module) -> void;
+
+    /// @brief Number of superinstructions formed
+    auto superinstructions() const noexcept -> u64;
+
+    /// @brief Number of instructions removed by merging them into another
+    auto removedInstructions() const noexcept -> u64;
+
+    private:
+    auto optimize(bytecode::Function& function) -> void;
+    auto immediate(bytecode::Function const& function, bytecode::Instruction& instruction) noexcept -> void;
+  };
+
+}
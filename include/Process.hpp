@@ -0,0 +1,29 @@
+#pragma once
+
+namespace fridayc {
+
+  /// @brief File that discards what is written to it
+#if defined(_WIN32)
+  inline const std::string NOWHERE = "NUL"s;
+#else
+  inline const std::string NOWHERE = "/dev/null"s;
+#endif
+
+  /// @brief Runs a program and waits for it to exit
+  ///
+  /// The arguments are passed as they are, without a shell, so paths need
+  /// no quoting and nothing in them is interpreted.
+  /// @param arguments the program, looked up in the PATH, then its arguments
+  /// @param output file the standard output of the program is written to, NOWHERE to discard it, empty to share ours
+  /// @return the exit status, std::nullopt if the program could not start or did not exit by itself
+  auto spawn(std::vector<std::string> const& arguments, std::string const& output = { }) -> std::optional<i32>;
+
+  /// @brief Words of the command a variable such as $CC names, split at spaces
+  /// @param variable the environment variable
+  /// @param fallback the command when the variable is unset or empty
+  auto command(i8 const* variable, std::string_view fallback) -> std::vector<std::string>;
+
+  /// @brief Arguments joined by spaces, as a shell would show them
+  auto commandLine(std::vector<std::string> const& arguments) -> std::string;
+
+}
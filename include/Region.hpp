@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Runtime.hpp"
+
+namespace fridayc::runtime {
+
+  /// @brief Memory of values that die together, handed out by bumping a pointer
+  ///
+  /// Allocations are laid out one after the other in chunks that double in
+  /// size, and are never freed one by one. A mark remembers the position
+  /// reached so far, rewinding to it frees everything allocated since in
+  /// constant time; chunks are kept for the next allocations. Marks nest,
+  /// a region can serve the calls and the loop iterations of a run as a
+  /// stack. Objects must be destroyed before the memory they live in is
+  /// rewound, their destructors run when the last reference goes.
+  class Region final : public std::pmr::memory_resource {
+    public:
+    /// @brief Position in a region
+    struct Mark {
+      u32 chunk { 0 };
+      u64 used  { 0 };
+      u64 base  { 0 };
+    };
+
+    private:
+    struct Chunk {
+      Box<std::byte[]> bytes;
+      u64              size;
+    };
+
+    /// @brief Size of the first chunk
+    static constexpr u64 FIRST = 64 << 10;
+
+    std::vector<Chunk> chunks      { };
+    Mark               position    { };
+    u64                allocations { 0 };
+    u64                allocated   { 0 };
+    u64                peak        { 0 };
+
+    public:
+    Region() noexcept = default;
+    Region(Region const&) = delete;
+    auto operator=(Region const&) -> Region& = delete;
+
+    /// @brief Position reached so far, to rewind to
+    auto mark() const noexcept -> Mark;
+
+    /// @brief Frees everything allocated since a mark, which must not be past the current position
+    auto rewind(Mark to) noexcept -> void;
+
+    /// @brief Allocations made so far
+    auto allocationCount() const noexcept -> u64;
+
+    /// @brief Bytes allocated so far, counting the ones rewound
+    auto allocatedBytes() const noexcept -> u64;
+
+    /// @brief Most bytes in use at once, counting the ends of chunks skipped over
+    auto peakBytes() const noexcept -> u64;
+
+    private:
+    auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override;
+    auto do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) -> void override;
+    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override;
+  };
+
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Walker.hpp"
+#include "FlatMap.hpp"
+#include "Error.hpp"
+
+namespace fridayc {
+
+  /// @brief Binds every identifier and type name of a program to its declaration
+  ///
+  /// Top-level declarations are collected first, so functions, structs and
+  /// enums can be used before they are declared. Locals and parameters live in
+  /// one table holding the innermost declaration of each name plus an undo
+  /// log, so entering and leaving a scope costs nothing and every lookup is a
+  /// single probe. Parameters and locals get frame slots, the slots of a block
+  /// are reused once the block ends. Functions, structs and enums declared
+  /// inside a function body are reported and left unresolved.
+  ///
+  /// Function bodies only read the top-level declarations, so once declare()
+  /// has run, resolvers sharing its declarations can resolve different
+  /// functions on different threads.
+  class Resolver : public Walker {
+    struct Local {
+      Symbol  name;
+      Binding binding;
+      u32     depth;
+      u32     shadowed;
+    };
+
+    std::vector<Error>                              error_queue { };
+    FlatMap<Symbol, Binding>                        globals     { };
+    FlatMap<Symbol, u32>                            visible     { };
+    std::vector<Local>                              locals      { };
+    FlatMap<Visitable const*, FlatMap<Symbol, u32>> constants   { };
+    Resolver const*                                 shared      { nullptr };
+    FunctionStatement*                              function    { nullptr };
+    u32                                             depth       { 0 };
+    u32                                             next_slot   { 0 };
+    bool                                            declaring   { false };
+
+    public:
+    /// @brief Names of the primitive types
+    static constexpr std::array PRIMITIVES = { "int"sv, "float"sv, "bool"sv, "char"sv, "string"sv, "void"sv };
+
+    Resolver() noexcept = default;
+
+    /// @brief Constructs a resolver for function bodies
+    /// @param declarations the resolver whose declare() collected the top-level declarations
+    explicit Resolver(Resolver const& declarations) noexcept;
+
+    /// @brief Resolves a program, filling bindings and frame slots
+    /// @param program the program to resolve
+    /// @return the errors, empty on success
+    auto resolve(Program& program) -> std::vector<Error>;
+
+    /// @brief Collects the top-level declarations and resolves everything but function bodies
+    /// @param program the program to resolve
+    /// @return the errors, empty on success
+    auto declare(Program& program) -> std::vector<Error>;
+
+    /// @brief Resolves a top-level function, after declare()
+    /// @param function the function to resolve
+    /// @return the errors, empty on success
+    auto resolve(FunctionStatement& function) -> std::vector<Error>;
+
+    using Walker::operator();
+
+    auto operator()(Identifier& arg) noexcept -> std::any override;
+    auto operator()(TypeExpression& arg) noexcept -> std::any override;
+    auto operator()(InfixExpression& arg) noexcept -> std::any override;
+    auto operator()(BlockStatement& arg) noexcept -> std::any override;
+    auto operator()(StructStatement& arg) noexcept -> std::any override;
+    auto operator()(EnumStatement& arg) noexcept -> std::any override;
+    auto operator()(FunctionStatement& arg) noexcept -> std::any override;
+    auto operator()(NamespaceStatement& arg) noexcept -> std::any override;
+    auto operator()(UsingStatement& arg) noexcept -> std::any override;
+    auto operator()(DeclarationStatement& arg) noexcept -> std::any override;
+    auto operator()(Program& arg) noexcept -> std::any override;
+
+    private:
+    static constexpr u32 NONE = std::numeric_limits<u32>::max();
+
+    auto errorAt(Span span, std::string error) noexcept -> void;
+    auto nested(Span span) noexcept -> void;
+    auto collect(Program& program) noexcept -> void;
+    auto declarations() const noexcept -> Resolver const&;
+
+    auto declareGlobal(Symbol name, Binding binding, Span span) noexcept -> void;
+    auto declareLocal(Symbol name, Binding binding, Span span) noexcept -> void;
+    auto lookup(Symbol name) const noexcept -> Binding const*;
+
+    auto enterScope() noexcept -> u32;
+    auto exitScope(u32 first_slot) noexcept -> void;
+  };
+
+}
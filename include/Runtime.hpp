@@ -0,0 +1,156 @@
+#pragma once
+
+#include "TypeTable.hpp"
+#include "Error.hpp"
+#include "String.hpp"
+
+namespace fridayc {
+
+  class Analyzer;
+
+  /// @brief Bounds of a run
+  struct ExecutionLimits {
+    /// @brief Frame slots or registers of all active calls together
+    u64 stack { 1 << 20 };
+
+    /// @brief Nested calls
+    u32 depth { 10'000 };
+  };
+
+}
+
+/// @brief Values of running programs, shared by the Executor and the VirtualMachine
+namespace fridayc::runtime {
+
+  /// @brief A string, a struct or an array
+  struct Object {
+    virtual ~Object() noexcept = default;
+  };
+
+  using Ref = std::shared_ptr<Object>;
+
+  /// @brief A frame slot, a register, a field or an element
+  /// @note Bools, chars and enum constants are held as ints, so equal scalars have equal bits
+  struct Cell {
+    union {
+      i64 integer { 0 };
+      f64 real;
+    };
+    Ref object { };
+  };
+
+  /// @brief Contents of a string
+  struct Text final : public Object {
+    String value;
+
+    explicit Text(String value) noexcept;
+  };
+
+  /// @brief Fields of a struct or elements of an array
+  struct Cells final : public Object {
+    std::pmr::vector<Cell> cells;
+
+    /// @brief Constructs cells, on the general heap unless they are given the memory of a region
+    explicit Cells(u64 size, std::pmr::memory_resource* memory = std::pmr::new_delete_resource());
+  };
+
+  /// @brief Value of type T held by a cell, T is i64, f64, bool, i8 or Ref
+  template<class T>
+  constexpr auto load(Cell const& cell) noexcept -> T;
+
+  /// @brief Stores a value of type T in a cell, T is i64, f64, bool, i8 or Ref
+  template<class T>
+  constexpr auto store(Cell& cell, T value) noexcept -> void;
+
+  /// @brief Stops the run with a RuntimeError
+  [[noreturn]] auto fault(std::string message, Span span) -> void;
+
+  /// @brief Contents of a string, faults on null
+  auto text(Ref const& object, Span span) -> String const&;
+
+  /// @brief Fields of a struct or elements of an array, faults on null
+  auto cells(Ref const& object, Span span) -> std::pmr::vector<Cell>&;
+
+  /// @brief Element of an array, faults on null and out of bounds
+  auto element(Ref const& object, i64 index, Span span) -> Cell&;
+
+  /// @brief Character of a string, faults on null and out of bounds
+  auto character(Ref const& object, i64 index, Span span) -> i8;
+
+  /// @brief Concatenation of two strings, faults on null
+  auto concatenate(Ref const& lhs, Ref const& rhs, Span span) -> Ref;
+
+  /// @brief Tells whether two strings are equal by value, null only equals null
+  auto equal(Ref const& lhs, Ref const& rhs) -> bool;
+
+  // * Checked operations, they fault where the ConstantFolder refuses to fold
+  constexpr auto sum(i64 lhs, i64 rhs, Span span) -> i64;
+  constexpr auto difference(i64 lhs, i64 rhs, Span span) -> i64;
+  constexpr auto product(i64 lhs, i64 rhs, Span span) -> i64;
+  constexpr auto quotient(i64 lhs, i64 rhs, Span span) -> i64;
+  constexpr auto remainder(i64 lhs, i64 rhs, Span span) -> i64;
+  constexpr auto negation(i64 value, Span span) -> i64;
+  constexpr auto shiftLeft(i64 lhs, i64 rhs, Span span) -> i64;
+  constexpr auto shiftRight(i64 lhs, i64 rhs, Span span) -> i64;
+  constexpr auto quotient(f64 lhs, f64 rhs, Span span) -> f64;
+
+  /// @brief Layout of a printed type, all a Printer needs to know of it
+  struct Shape {
+    TypeInfo::Kind       kind  { TypeInfo::Kind::ERROR };
+
+    /// @brief Name of a struct
+    Symbol               name  { };
+
+    /// @brief Names of the constants of an enum
+    std::vector<Symbol>  names { };
+
+    /// @brief Shape of the element of an array, of every field of a struct
+    std::vector<u32>     parts { };
+  };
+
+  /// @brief Writes values the way 'print' shows them
+  ///
+  /// Ints and floats in their shortest form, floats always with a fraction
+  /// or an exponent, strings and chars as they are, enum constants by name,
+  /// arrays as [a, b] and structs as Name(a, b). Objects nested deeper than
+  /// a fixed depth are elided, as objects can refer to themselves. Types are
+  /// first described as shapes, so a printer can also be rebuilt from the
+  /// shapes alone, without the analysis, as loaded modules do.
+  class Printer {
+    public:
+    using Format = std::function<void(std::string&, Cell const&, u32)>;
+
+    private:
+    Analyzer const*           analyzer { nullptr };
+    TypeTable const*          table    { nullptr };
+    FlatMap<TypeId, u32>      indices  { };
+    std::vector<Shape>        layouts  { };
+    std::vector<Box<Format>>  formats  { };
+
+    public:
+    /// @brief Constructs a printer
+    /// @param analyzer the analyzer that typed the fields of structs
+    /// @param table the table interning the types
+    Printer(Analyzer const& analyzer, TypeTable const& table) noexcept;
+
+    /// @brief Constructs a printer of known shapes only
+    /// @param shapes the shapes, whose parts are indices among them
+    explicit Printer(std::vector<Shape> shapes) noexcept;
+
+    /// @brief Format of a type, built once and valid as long as the printer
+    auto format(TypeId type) -> Format const&;
+
+    /// @brief Format of a shape, built once and valid as long as the printer
+    auto formatOf(u32 shape) -> Format const&;
+
+    /// @brief Shape of a type, described once
+    /// @note Needs the analysis, the printer must not have been built from shapes
+    auto shapeOf(TypeId type) -> u32;
+
+    /// @brief Shapes described so far, parts are indices among them
+    auto shapes() const noexcept -> std::vector<Shape> const&;
+  };
+
+}
+
+#include "Runtime.inl"
@@ -0,0 +1,77 @@
+#ifdef __INTELLISENSE__
+#include "Runtime.hpp"
+#endif
+
+namespace fridayc::runtime {
+
+  template<class T>
+  constexpr auto load(Cell const& cell) noexcept -> T {
+    if constexpr (std::same_as<T, i64>) return cell.integer;
+    else if constexpr (std::same_as<T, f64>) return cell.real;
+    else if constexpr (std::same_as<T, bool>) return cell.integer != 0;
+    else if constexpr (std::same_as<T, i8>) return static_cast<i8>(cell.integer);
+    else return cell.object;
+  }
+
+  template<class T>
+  constexpr auto store(Cell& cell, T value) noexcept -> void {
+    if constexpr (std::same_as<T, f64>) cell.real = value;
+    else if constexpr (std::same_as<T, Ref>) cell.object = std::move(value);
+    else cell.integer = value;
+  }
+
+  constexpr auto sum(i64 lhs, i64 rhs, Span span) -> i64 {
+    i64 result;
+    if(__builtin_add_overflow(lhs, rhs, &result)) fault("Integer overflow"s, span);
+    return result;
+  }
+
+  constexpr auto difference(i64 lhs, i64 rhs, Span span) -> i64 {
+    i64 result;
+    if(__builtin_sub_overflow(lhs, rhs, &result)) fault("Integer overflow"s, span);
+    return result;
+  }
+
+  constexpr auto product(i64 lhs, i64 rhs, Span span) -> i64 {
+    i64 result;
+    if(__builtin_mul_overflow(lhs, rhs, &result)) fault("Integer overflow"s, span);
+    return result;
+  }
+
+  constexpr auto quotient(i64 lhs, i64 rhs, Span span) -> i64 {
+    if(rhs == 0) fault("Division by 0"s, span);
+    if(lhs == std::numeric_limits<i64>::min() and rhs == -1) fault("Integer overflow"s, span);
+    return lhs / rhs;
+  }
+
+  constexpr auto remainder(i64 lhs, i64 rhs, Span span) -> i64 {
+    if(rhs == 0) fault("Division by 0"s, span);
+    if(lhs == std::numeric_limits<i64>::min() and rhs == -1) fault("Integer overflow"s, span);
+    return lhs % rhs;
+  }
+
+  constexpr auto negation(i64 value, Span span) -> i64 {
+    if(value == std::numeric_limits<i64>::min()) fault("Integer overflow"s, span);
+    return -value;
+  }
+
+  constexpr auto shiftLeft(i64 lhs, i64 rhs, Span span) -> i64 {
+    if(rhs < 0 or rhs >= 64) fault("Shift count out of range"s, span);
+
+    // * Bits shifted out, including into the sign, are an overflow
+    const i64 shifted = static_cast<i64>(static_cast<u64>(lhs) << rhs);
+    if(shifted >> rhs != lhs) fault("Integer overflow"s, span);
+    return shifted;
+  }
+
+  constexpr auto shiftRight(i64 lhs, i64 rhs, Span span) -> i64 {
+    if(rhs < 0 or rhs >= 64) fault("Shift count out of range"s, span);
+    return lhs >> rhs;
+  }
+
+  constexpr auto quotient(f64 lhs, f64 rhs, Span span) -> f64 {
+    if(rhs == 0.) fault("Division by 0"s, span);
+    return lhs / rhs;
+  }
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Walker.hpp"
+
+namespace fridayc {
+
+  /// @brief Collects what a piece of code assigns, declares, stores, calls and may fail on
+  ///
+  /// Locals and parameters are tracked by frame slot: a slot is marked when
+  /// the code assigns or declares it. A local declared outside the code
+  /// keeps its slot to itself while the code runs, so an unmarked slot is
+  /// one the code leaves alone.
+  struct SideEffects : public Walker {
+    /// @brief Assigned or declared frame slots, slots past the end are not tracked
+    std::vector<bool>& variant;
+
+    /// @brief Whether the code stores into a field or an element
+    bool writes   { false };
+
+    /// @brief Whether the code calls a function
+    bool calls    { false };
+
+    /// @brief Whether the code reads a field, subscripts, divides, shifts or does arithmetic that may overflow
+    bool fallible { false };
+
+    /// @brief Constructs a collector
+    /// @param variant the slots to mark, sized by the frame of the function
+    explicit SideEffects(std::vector<bool>& variant) noexcept;
+
+    using Walker::operator();
+
+    auto operator()(PrefixExpression& arg) noexcept -> std::any override;
+    auto operator()(InfixExpression& arg) noexcept -> std::any override;
+    auto operator()(CallExpression& arg) noexcept -> std::any override;
+    auto operator()(SubscriptExpression& arg) noexcept -> std::any override;
+    auto operator()(DeclarationStatement& arg) noexcept -> std::any override;
+
+    private:
+    auto mark(u32 slot) noexcept -> void;
+  };
+
+}
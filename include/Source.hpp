@@ -0,0 +1,79 @@
+#pragma once
+
+namespace fridayc {
+
+  /// @brief Packed location of a node inside a registered source file
+  struct Span {
+
+    /// @brief Byte offset of the first character
+    u32 offset    { 0 };
+
+    /// @brief Length in bytes, saturated to MAX_LENGTH
+    u32 length:24 { 0 };
+
+    /// @brief Identifier of the source file, see Sources
+    u32 file:8    { 0 };
+
+    /// @brief Longest length a span holds, a longer one is cut to it rather than wrapped around
+    static constexpr u32 MAX_LENGTH = (1u << 24) - 1;
+
+    /// @brief Byte offset one past the last character, within the first MAX_LENGTH bytes of the node
+    constexpr auto end() const noexcept -> u32;
+
+    /// @brief A length in bytes as a span holds it
+    constexpr static auto saturate(u64 length) noexcept -> u32;
+
+    /// @brief Span covering two spans and everything in between
+    /// @param first the leftmost span
+    /// @param last the rightmost span
+    constexpr static auto join(Span first, Span last) noexcept -> Span;
+  };
+
+  static_assert(sizeof(Span) == 8);
+
+  /// @brief Human readable position, 1-based
+  struct Location {
+    u32 row;
+    u32 col;
+  };
+
+  /// @brief Process-wide registry of the source files being compiled
+  class Sources {
+    public:
+    /// @brief Identifier returned for files that are not registered
+    static constexpr u32 NONE = 0xFF;
+
+    /// @brief Registers a source file, the registry owns its text from now on
+    /// @param path the path of the file
+    /// @param text the content of the file
+    /// @return the identifier of the file
+    static auto add(std::string path, std::string text) -> u32;
+
+    /// @brief Path of a registered file
+    static auto path(u32 file) -> std::string_view;
+
+    /// @brief Text of a registered file, empty if the file is unknown
+    static auto text(u32 file) -> std::string_view;
+
+    /// @brief Text of a single line, without the line break
+    /// @param file the file identifier
+    /// @param row the 1-based row
+    static auto line(u32 file, u32 row) -> std::string_view;
+
+    /// @brief Number of lines of a registered file
+    static auto lines(u32 file) -> u32;
+
+    /// @brief Resolves the start of a span to row and column
+    /// @note The line table of a file is built on first use only
+    static auto locate(Span span) -> Location;
+
+    /// @brief Builds a span from a view into the text of a registered file
+    /// @param file the file identifier
+    /// @param slice a view into the text of the file
+    /// @return the span of the slice, or an empty span if the slice lies outside the file
+    static auto spanOf(u32 file, std::string_view slice) -> Span;
+  };
+
+}
+
+#include "Source.inl"
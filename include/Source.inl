@@ -0,0 +1,23 @@
+#ifdef __INTELLISENSE__
+#include "Source.hpp"
+#endif
+
+namespace fridayc {
+
+  constexpr auto Span::end() const noexcept -> u32 {
+    return offset + length;
+  }
+
+  constexpr auto Span::saturate(u64 length) noexcept -> u32 {
+    return (u32)std::min<u64>(length, MAX_LENGTH);
+  }
+
+  constexpr auto Span::join(Span first, Span last) noexcept -> Span {
+    Span span;
+    span.offset = first.offset;
+    span.length = saturate(std::max(first.end(), last.end()) - first.offset);
+    span.file = first.file;
+    return span;
+  }
+
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "TypeTable.hpp"
+#include "Error.hpp"
+
+/// @brief Intermediate representation in static single assignment form, built by the SsaBuilder
+namespace fridayc::ssa {
+
+  /// @brief Type of a value
+  /// @note Bools, chars and enum constants keep their own type, but are held as ints like in runtime::Cell
+  enum struct Type : u8 { VOID, INT, FLOAT, BOOL, CHAR, REFERENCE };
+
+  /// @brief Operation of an instruction
+  ///
+  /// Every instruction defines the value of its index in the function, of
+  /// type VOID if it computes nothing. Operands are values, immediates are
+  /// constants of the instruction and blocks are its successors, or the
+  /// predecessors a phi takes each of its operands from.
+  enum struct Opcode : u8 {
+    // * Parameter immediate, scalar of the bits immediate or null for a REFERENCE, string constant immediate of the module
+    PARAMETER, CONSTANT, STRING,
+
+    // * Slot of a local in the frame, load from slot a, store b to slot a, promoted to values by mem2reg
+    SLOT, LOAD, STORE,
+
+    // * a op b on ints, checked like the Executor
+    ADD, SUB, MUL, DIV, MOD, BIT_AND, BIT_OR, SHL, SHR,
+
+    // * op a on ints
+    NEG, BIT_NOT,
+
+    // * a op b, op a on floats
+    FADD, FSUB, FMUL, FDIV, FNEG,
+
+    // * a op b on ints, bools, chars and enum constants, on floats, by identity and on strings by value
+    EQ, NE, LT, LE, FEQ, FNE, FLT, FLE, REQ, RNE, SEQ, SNE,
+
+    // * not a, a + b on strings
+    NOT, CONCAT,
+
+    // * New struct or array of immediate cells, field immediate of a, field immediate of a = b
+    NEW, GET_FIELD, SET_FIELD,
+
+    // * a[b], a[b] = c, character b of the string a
+    GET_ELEM, SET_ELEM, GET_CHAR,
+
+    // * Function immediate of the module called with the operands, print a with the type of the immediate
+    CALL, PRINT,
+
+    // * Operand k if control came from block k
+    PHI,
+
+    // * Jump to block 0, to block 0 if a and to block 1 otherwise, return a if any, fault on a function ending without a value
+    JUMP, BRANCH, RETURN, FALL_OFF,
+
+    COUNT
+  };
+
+  using Value = u32;
+
+  /// @brief Block or value that does not exist
+  static constexpr u32 NONE = ~0u;
+
+  /// @brief Name of an opcode, as the dump shows it
+  auto nameOf(Opcode op) noexcept -> std::string_view;
+
+  auto nameOf(Type type) noexcept -> std::string_view;
+
+  /// @brief Tells whether an opcode ends a block
+  constexpr auto terminates(Opcode op) noexcept -> bool;
+
+  /// @brief Tells whether an opcode may stop the run with a fault
+  constexpr auto faults(Opcode op) noexcept -> bool;
+
+  /// @brief Tells whether an opcode changes memory, prints or calls
+  constexpr auto writes(Opcode op) noexcept -> bool;
+
+  /// @brief Tells whether an opcode computes its value from its operands and immediate alone
+  /// @note Faulting operations are pure: a second evaluation faults only if the first did
+  constexpr auto pure(Opcode op) noexcept -> bool;
+
+  /// @brief Tells whether the operands of an opcode can be swapped
+  constexpr auto commutes(Opcode op) noexcept -> bool;
+
+  struct Instruction {
+    Opcode              op        { Opcode::RETURN };
+    Type                type      { Type::VOID };
+
+    /// @brief Block holding the instruction, NONE once it is removed
+    u32                 block     { NONE };
+    i64                 immediate { 0 };
+    std::vector<Value>  operands  { };
+    std::vector<u32>    blocks    { };
+    Span                span      { };
+  };
+
+  /// @brief Straight-line code, phis first and a terminator last
+  struct Block {
+    std::vector<Value> code { };
+  };
+
+  /// @brief Immediate dominators of the blocks of a function reachable from its entry
+  struct Dominators {
+    /// @brief Immediate dominator of every block, the entry is its own and unreachable blocks have NONE
+    std::vector<u32>               idom     { };
+
+    /// @brief Blocks immediately dominated by every block
+    std::vector<std::vector<u32>>  children { };
+
+    /// @brief Reachable blocks in reverse postorder, the entry first
+    std::vector<u32>               order    { };
+
+    /// @brief Position of every block in the reverse postorder
+    std::vector<u32>               position { };
+
+    auto dominates(u32 dominator, u32 block) const noexcept -> bool;
+  };
+
+  /// @brief A function, whose entry is block 0
+  struct Function {
+    Symbol                    name       { };
+    Span                      span       { };
+    std::vector<Type>         parameters { };
+    Type                      returns    { Type::VOID };
+    std::vector<Instruction>  values     { };
+    std::vector<Block>        blocks     { };
+
+    /// @brief Appends an instruction to a block
+    /// @return its value
+    auto append(u32 block, Instruction instruction) -> Value;
+
+    /// @brief Inserts an instruction into a block before the position of its code
+    /// @return its value
+    auto insert(u32 block, u32 position, Instruction instruction) -> Value;
+
+    /// @brief Appends an empty block
+    /// @return its index
+    auto add() -> u32;
+
+    /// @brief Last instruction of a block, NONE if it has none yet
+    auto terminator(u32 block) const noexcept -> Value;
+
+    auto successors(u32 block) const noexcept -> std::span<u32 const>;
+
+    /// @brief Predecessors of every block, once per edge
+    auto predecessors() const -> std::vector<std::vector<u32>>;
+
+    auto dominators() const -> Dominators;
+
+    /// @brief Uses of every value, as the instructions reading it
+    auto uses() const -> std::vector<std::vector<Value>>;
+
+    /// @brief Replaces the operands of every instruction by what they map to
+    /// @param replacement value to use instead of every value, chains are followed, NONE keeps the value
+    auto replace(std::vector<Value>& replacement) -> void;
+
+    /// @brief Removes an instruction from its block
+    auto remove(Value value) noexcept -> void;
+
+    /// @brief Drops the blocks unreachable from the entry and the removed instructions, and renumbers what is left in order
+    ///
+    /// Phis drop the operands coming from blocks that are no longer their
+    /// predecessors. Passes end with it, so they can leave blocks behind.
+    auto compact() -> void;
+  };
+
+  /// @brief Functions of a program reachable from 'main', which is the first one
+  struct Module {
+    std::vector<Function>     functions   { };
+
+    /// @brief String constants
+    std::vector<std::string>  strings     { };
+
+    /// @brief Whether 'main' returns an int, which is then the exit status
+    bool                      returns_int { false };
+
+    /// @brief Writes every function, one block per paragraph and one instruction per line
+    auto print(std::ostream& out, TypeTable const& table) const -> void;
+
+    /// @brief Checks that every function is well formed
+    ///
+    /// Blocks end with their only terminator and begin with their phis,
+    /// which have one operand per predecessor. Operands are typed as their
+    /// operation expects and every definition dominates its uses, those of
+    /// a phi at the end of the block the operand comes from.
+    /// @return the errors, empty if the module is well formed
+    auto verify() const -> std::vector<Error>;
+  };
+
+}
+
+#include "Ssa.inl"
@@ -0,0 +1,63 @@
+#ifdef __INTELLISENSE__
+#include "Ssa.hpp"
+#endif
+
+namespace fridayc::ssa {
+
+  constexpr auto terminates(Opcode op) noexcept -> bool {
+    switch(op) {
+      case Opcode::JUMP:
+      case Opcode::BRANCH:
+      case Opcode::RETURN:
+      case Opcode::FALL_OFF: return true;
+      default: return false;
+    }
+  }
+
+  constexpr auto faults(Opcode op) noexcept -> bool {
+    switch(op) {
+      case Opcode::ADD: case Opcode::SUB: case Opcode::MUL: case Opcode::DIV: case Opcode::MOD:
+      case Opcode::SHL: case Opcode::SHR: case Opcode::NEG: case Opcode::FDIV: case Opcode::CONCAT:
+      case Opcode::GET_FIELD: case Opcode::SET_FIELD: case Opcode::GET_ELEM: case Opcode::SET_ELEM: case Opcode::GET_CHAR:
+      case Opcode::CALL: case Opcode::FALL_OFF: return true;
+      default: return false;
+    }
+  }
+
+  constexpr auto writes(Opcode op) noexcept -> bool {
+    switch(op) {
+      case Opcode::STORE:
+      case Opcode::SET_FIELD:
+      case Opcode::SET_ELEM:
+      case Opcode::CALL:
+      case Opcode::PRINT: return true;
+      default: return false;
+    }
+  }
+
+  constexpr auto pure(Opcode op) noexcept -> bool {
+    switch(op) {
+      case Opcode::PARAMETER: case Opcode::CONSTANT: case Opcode::STRING:
+      case Opcode::ADD: case Opcode::SUB: case Opcode::MUL: case Opcode::DIV: case Opcode::MOD:
+      case Opcode::BIT_AND: case Opcode::BIT_OR: case Opcode::SHL: case Opcode::SHR:
+      case Opcode::NEG: case Opcode::BIT_NOT:
+      case Opcode::FADD: case Opcode::FSUB: case Opcode::FMUL: case Opcode::FDIV: case Opcode::FNEG:
+      case Opcode::EQ: case Opcode::NE: case Opcode::LT: case Opcode::LE:
+      case Opcode::FEQ: case Opcode::FNE: case Opcode::FLT: case Opcode::FLE:
+      case Opcode::REQ: case Opcode::RNE: case Opcode::SEQ: case Opcode::SNE:
+      case Opcode::NOT: return true;
+      default: return false;
+    }
+  }
+
+  constexpr auto commutes(Opcode op) noexcept -> bool {
+    switch(op) {
+      case Opcode::ADD: case Opcode::MUL: case Opcode::BIT_AND: case Opcode::BIT_OR:
+      case Opcode::FADD: case Opcode::FMUL:
+      case Opcode::EQ: case Opcode::NE: case Opcode::FEQ: case Opcode::FNE:
+      case Opcode::REQ: case Opcode::RNE: case Opcode::SEQ: case Opcode::SNE: return true;
+      default: return false;
+    }
+  }
+
+}
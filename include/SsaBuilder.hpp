@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Walker.hpp"
+#include "FlatMap.hpp"
+#include "Ssa.hpp"
+
+namespace fridayc {
+
+  class Analyzer;
+
+  /// @brief Builds the SSA form of the functions reachable from 'main'
+  ///
+  /// Every parameter and local gets a slot in the entry block, which its
+  /// reads load from and its assignments store to; mem2reg of the
+  /// SsaOptimizer turns them into values and phis. The statements become
+  /// blocks: an 'if' branches to its block and its alternative, loops
+  /// branch on their condition in a header block their body jumps back to,
+  /// and 'and' and 'or' branch around their right-hand side and join with
+  /// a phi. Code after a 'return' lands in blocks that nothing reaches,
+  /// dropped once the function is built. Runs on an analyzed program, like
+  /// the BytecodeCompiler.
+  class SsaBuilder : public Walker {
+    Analyzer const&                         analyzer;
+    TypeTable const&                        table;
+    ssa::Module                             built      { };
+    FlatMap<FunctionStatement const*, u32>  indices    { };
+    std::vector<FunctionStatement*>         pending    { };
+    FlatMap<std::string_view, u32>          strings    { };
+    FlatMap<Visitable const*, ssa::Value>   locals     { };
+    std::vector<ssa::Value>                 parameters { };
+    std::vector<Error>                      errors     { };
+    ssa::Function*                          function   { nullptr };
+    u32                                     block      { 0 };
+
+    public:
+    /// @brief Constructs a builder
+    /// @param analyzer the analyzer that checked the program
+    /// @param table the table interning the types of the program
+    SsaBuilder(Analyzer const& analyzer, TypeTable const& table) noexcept;
+
+    /// @brief Builds 'main', which must take no parameters, and every function it may call
+    /// @param program the analyzed program to build
+    /// @return the errors, empty if the whole program was built
+    auto build(Program& program) -> std::vector<Error>;
+
+    /// @brief Built module, 'main' is its first function
+    auto module() noexcept -> ssa::Module&;
+
+    using Walker::operator();
+
+    auto operator()(Identifier& arg) noexcept -> std::any override;
+    auto operator()(BoolLiteral& arg) noexcept -> std::any override;
+    auto operator()(ObjectLiteral& arg) noexcept -> std::any override;
+    auto operator()(StringLiteral& arg) noexcept -> std::any override;
+    auto operator()(FloatLiteral& arg) noexcept -> std::any override;
+    auto operator()(IntLiteral& arg) noexcept -> std::any override;
+    auto operator()(CharLiteral& arg) noexcept -> std::any override;
+    auto operator()(PrefixExpression& arg) noexcept -> std::any override;
+    auto operator()(InfixExpression& arg) noexcept -> std::any override;
+    auto operator()(CallExpression& arg) noexcept -> std::any override;
+    auto operator()(SubscriptExpression& arg) noexcept -> std::any override;
+    auto operator()(ArrayLiteral& arg) noexcept -> std::any override;
+    auto operator()(ExpressionStatement& arg) noexcept -> std::any override;
+    auto operator()(ReturnStatement& arg) noexcept -> std::any override;
+    auto operator()(PrintStatement& arg) noexcept -> std::any override;
+    auto operator()(BlockStatement& arg) noexcept -> std::any override;
+    auto operator()(IfStatement& arg) noexcept -> std::any override;
+    auto operator()(WhileStatement& arg) noexcept -> std::any override;
+    auto operator()(ForStatement& arg) noexcept -> std::any override;
+    auto operator()(DeclarationStatement& arg) noexcept -> std::any override;
+
+    private:
+    /// @brief Index of a function, which is queued to be built on first use
+    auto index(FunctionStatement& declaration) -> u32;
+    auto build(FunctionStatement& declaration, u32 index) -> void;
+    auto expression(Expression& expr) noexcept -> ssa::Value;
+    auto statement(Statement& stmt) noexcept -> void;
+    auto unsupported(Span span, std::string message) noexcept -> ssa::Value;
+    auto typeOf(Expression const& expr) const noexcept -> TypeId;
+
+    /// @brief Type of the values of a type of the program
+    auto lower(TypeId type) const noexcept -> ssa::Type;
+
+    /// @brief Appends an instruction to the current block, or to a new one if the current block ended
+    auto emit(ssa::Instruction instruction) -> ssa::Value;
+
+    /// @brief Ends the current block with a jump
+    auto jump(u32 target, Span span) -> void;
+
+    /// @brief Slot of a local, made in the entry block on first use
+    /// @param declaration the DeclarationStatement of the local
+    auto slot(Visitable const* declaration, ssa::Type type, u32 frame, Span span) -> ssa::Value;
+
+    /// @brief Slot an identifier of a local or a parameter refers to
+    auto slot(Identifier const& name) -> ssa::Value;
+
+    /// @brief Operation of a binary operator, and whether its operands are swapped
+    auto operation(Token::Type oper, TypeId lhs, TypeId rhs) const noexcept -> std::optional<std::pair<ssa::Opcode, bool>>;
+
+    auto call(CallExpression& arg, FunctionStatement& callee) noexcept -> ssa::Value;
+    auto construct(Container<Box<Expression>>& values, Span span) noexcept -> ssa::Value;
+    auto member(InfixExpression& arg) noexcept -> ssa::Value;
+    auto binary(InfixExpression& arg) noexcept -> ssa::Value;
+    auto logical(InfixExpression& arg) noexcept -> ssa::Value;
+    auto assign(InfixExpression& arg) noexcept -> ssa::Value;
+  };
+
+}
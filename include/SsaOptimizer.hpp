@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Ssa.hpp"
+
+namespace fridayc {
+
+  /// @brief Optimizes the SSA form of a module with a fixed pipeline of passes
+  ///
+  /// In order, on every function:
+  ///  - mem2reg promotes the slots of locals to values, with phis placed at
+  ///    the iterated dominance frontiers of their stores and loads renamed
+  ///    over the dominator tree,
+  ///  - sparse conditional constant propagation folds the values that are
+  ///    constant on every path actually taken, and the branches on them,
+  ///  - global value numbering replaces a pure value by an equal one that
+  ///    dominates it,
+  ///  - dead code elimination removes the values nothing observable uses,
+  ///  - CFG simplification folds the remaining constant branches, removes
+  ///    trivial phis, merges blocks into their only predecessor and routes
+  ///    jumps around empty blocks.
+  /// Operations that may fault, like an int addition, are only folded when
+  /// they do not, and are never removed for being unused, so the optimized
+  /// program faults where the original one does.
+  class SsaOptimizer {
+    u64 slots        { 0 };
+    u64 phis         { 0 };
+    u64 folds        { 0 };
+    u64 branches     { 0 };
+    u64 redundancies { 0 };
+    u64 removals     { 0 };
+    u64 merges       { 0 };
+
+    public:
+    constexpr SsaOptimizer() noexcept = default;
+
+    /// @brief Runs the pipeline on every function of a module in place
+    /// @param verify whether to verify the module after every pass
+    /// @return the errors of the first verification that failed, naming the pass
+    auto optimize(ssa::Module& module, bool verify = false) -> std::vector<Error>;
+
+    /// @brief Number of slots promoted to values
+    auto promotedSlots() const noexcept -> u64;
+
+    /// @brief Number of phis placed by mem2reg
+    auto placedPhis() const noexcept -> u64;
+
+    /// @brief Number of values replaced by a constant
+    auto foldedValues() const noexcept -> u64;
+
+    /// @brief Number of branches replaced by a jump
+    auto foldedBranches() const noexcept -> u64;
+
+    /// @brief Number of values replaced by an equal dominating one
+    auto numberedValues() const noexcept -> u64;
+
+    /// @brief Number of unused values removed
+    auto removedValues() const noexcept -> u64;
+
+    /// @brief Number of blocks merged or routed around
+    auto removedBlocks() const noexcept -> u64;
+
+    private:
+    auto promote(ssa::Function& function) -> void;
+    auto propagate(ssa::Function& function) -> void;
+    auto number(ssa::Function& function) -> void;
+    auto eliminate(ssa::Function& function) -> void;
+    auto simplify(ssa::Function& function) -> void;
+  };
+
+}
@@ -3,7 +3,9 @@
 #include "Traits.hpp"
 #include "Token.hpp"
 #include "Visitable.hpp"
+#include "Source.hpp"
 #include "Expression.hpp"
+#include "Members.hpp"
 
 namespace fridayc {
 
@@ -19,6 +21,9 @@ namespace fridayc {
     /// @brief Converts a statement into a std::string
     /// @return std::string representation
     virtual auto toString() const noexcept -> std::string = 0;
+
+    /// @brief Location of the statement in the source
+    Span span { };
   };
 
   inline namespace statements {
@@ -163,7 +168,7 @@ namespace fridayc {
 
       /// @brief Constructs a struct statement
       /// @param name the name of the struct
-      StructStatement(std::string name) noexcept;
+      StructStatement(Symbol name) noexcept;
 
       /// @brief Converts a struct statement into a std::string
       /// @return std::string representation
@@ -174,17 +179,18 @@ namespace fridayc {
       auto operator()(Visitor& visitor) noexcept -> std::any override;
 
       /// @brief Value of the name of the struct
-      std::string name;
+      Symbol name;
 
-      std::map<std::string, Box<TypeExpression>> fields;
+      /// @brief Struct fields in declaration order
+      Members fields;
     };
 
     /// @brief Enum statement
-    struct EnumStatement : public Statement, public Container<std::string> {
+    struct EnumStatement : public Statement, public Container<Symbol> {
       
       /// @brief Constructs an enum statement
       /// @param name the name of the enum
-      EnumStatement(std::string name) noexcept;
+      EnumStatement(Symbol name) noexcept;
 
       /// @brief Converts an enum statement into a std::string
       /// @return std::string representation
@@ -195,7 +201,7 @@ namespace fridayc {
       auto operator()(Visitor& visitor) noexcept -> std::any override;
 
       /// @brief Value of the name of the enum
-      std::string name;
+      Symbol name;
     };
     
     /// @brief Function statement
@@ -203,7 +209,7 @@ namespace fridayc {
       
       /// @brief Constructs a function statement
       /// @param name the function name
-      FunctionStatement(std::string name) noexcept;
+      FunctionStatement(Symbol name) noexcept;
 
       /// @brief Converts a function statement into a std::string
       /// @return std::string representation
@@ -220,21 +226,24 @@ namespace fridayc {
       Box<TypeExpression> return_type;
 
       /// @brief Value of the name of the function
-      std::string name;
+      Symbol name;
+
+      /// @brief Function parameters in declaration order
+      Members args;
 
-      /// @brief Function parameter names mapped with types
-      std::map<std::string, Box<TypeExpression>> args;
+      /// @brief Number of frame slots needed by parameters and locals, filled by the Resolver
+      u32 frame_size { 0 };
     };
 
     /// @brief Namespace statement
     struct NamespaceStatement : public Statement {
 
       /// @brief Value of the name of the namespace
-      std::string name;
+      Symbol name;
 
       /// @brief Constructs a namespace statement
       /// @param name the name of the namespace
-      NamespaceStatement(std::string name) noexcept;
+      NamespaceStatement(Symbol name) noexcept;
 
       /// @brief Converts a namespace statement into a std::string
       /// @return std::string representation
@@ -250,11 +259,11 @@ namespace fridayc {
     struct UsingStatement : public Statement {
 
       /// @brief Value of the name of the identifier
-      std::string name;
+      Symbol name;
 
       /// @brief Constructs a using statement
       /// @param name the name of the identifier
-      UsingStatement(std::string name) noexcept;
+      UsingStatement(Symbol name) noexcept;
 
       /// @brief Converts a using statement into a std::string
       /// @return std::string representation
@@ -270,7 +279,7 @@ namespace fridayc {
     struct DeclarationStatement : public Statement {
 
       /// @brief Value of the name of the declared variable
-      std::string id;
+      Symbol id;
       
       /// @brief Value of the type of the variable
       Box<TypeExpression> type;
@@ -280,12 +289,15 @@ namespace fridayc {
 
       /// @brief Tells whether the declared variable is a constant
       bool constant;
+
+      /// @brief Frame slot of the variable, filled by the Resolver
+      u32 slot { 0 };
     
       /// @brief Constructs a declaration statement
       /// @param id the name of the declared variable
       /// @param expr the expression assigned to the declared variable
       /// @param constant true to declare variable as a constant
-      DeclarationStatement(std::string id, Box<Expression> expr, Box<TypeExpression> type, bool constant = false) noexcept;
+      DeclarationStatement(Symbol id, Box<Expression> expr, Box<TypeExpression> type, bool constant = false) noexcept;
 
       /// @brief Converts a declaration statement into a std::string
       /// @return std::string representation
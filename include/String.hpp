@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Symbol.hpp"
+
+namespace fridayc::runtime {
+
+  /// @brief Immutable string of running programs, cheap to copy and to concatenate
+  ///
+  /// A string is held in one of four ways:
+  ///  - inline, up to SMALL bytes, without an allocation,
+  ///  - interned, as a Symbol, equal to another interned string only if it
+  ///    is the same symbol,
+  ///  - flat, as a prefix of a buffer shared with the strings it was built
+  ///    from or extended into,
+  ///  - as a rope joining two strings, flattened the first time it is read.
+  /// Appending to a flat string that covers all its buffer has written
+  /// fills the spare capacity in place: the result covers a longer prefix
+  /// of the same buffer, the original still sees its own. Otherwise, when it
+  /// is the longer side, the bytes move to a buffer twice as large, so
+  /// 's = s + x' in a loop copies each byte a bounded number of times on
+  /// average. Any other long concatenation, such as 's = x + s', makes a
+  /// rope in constant time, flattened without recursion
+  /// into a buffer with room to grow, once for all the strings sharing it.
+  /// @note Buffers are shared without locks, a string belongs to one run
+  class String final {
+    public:
+    /// @brief Longest string held inline, in what the other members leave of 48 bytes
+    static constexpr u64 SMALL = 19;
+
+    /// @brief Length from which a concatenation that cannot grow in place makes a rope rather than copying
+    static constexpr u64 ROPE = 256;
+
+    enum struct Storage : u8 { SMALL, INTERNED, FLAT, ROPE };
+
+    private:
+    struct Buffer;
+    struct Node;
+
+    /// @brief Buffer of a flat string or node of a rope
+    std::shared_ptr<void>  shared  { };
+    u64                    size    { 0 };
+    Symbol                 symbol  { };
+    std::array<i8, SMALL>  bytes   { };
+    Storage                storage { Storage::SMALL };
+
+    public:
+    /// @brief Constructs the empty string
+    constexpr String() noexcept = default;
+
+    /// @brief Constructs a string of a copy of some text, inline if it is short enough
+    explicit String(std::string_view text);
+
+    /// @brief String of some text for literals and names that are compared often, interned unless it fits inline
+    static auto intern(std::string_view text) -> String;
+
+    auto length() const noexcept -> u64;
+    auto empty() const noexcept -> bool;
+    auto kind() const noexcept -> Storage;
+
+    /// @brief Contents of the string, flattening a rope
+    /// @return a view valid as long as this string or a copy of it
+    auto view() const -> std::string_view;
+
+    /// @brief Byte at an index below the length
+    auto operator[](u64 index) const -> i8;
+
+    /// @brief Concatenation, in place in the buffer of the left-hand side when it has room
+    friend auto operator+(String const& lhs, String const& rhs) -> String;
+    auto operator+=(String const& rhs) -> String&;
+
+    /// @brief Equality by contents, by identity between interned strings
+    auto operator==(String const& other) const -> bool;
+
+    /// @brief Byte-wise order of the contents
+    auto operator<=>(String const& other) const -> std::strong_ordering;
+
+    private:
+    /// @brief Flat string of the first bytes of a buffer
+    String(std::shared_ptr<Buffer> buffer, u64 size) noexcept;
+
+    /// @brief Buffer of a flat string or of a flattened rope, nullptr otherwise
+    auto buffer() const noexcept -> std::shared_ptr<Buffer>;
+
+    /// @brief Copies the contents into a new buffer with room for more
+    static auto flatten(String const& value, u64 capacity) -> std::shared_ptr<Buffer>;
+
+    /// @brief Contents of a rope, flattened on first use
+    auto rope() const -> std::string_view;
+
+    /// @brief Releases a string, taking apart the ropes only it holds without recursion
+    static auto release(String&& value) noexcept -> void;
+  };
+
+}
+
+template<>
+struct std::hash<fridayc::runtime::String> {
+  auto operator()(fridayc::runtime::String const& value) const -> u64;
+};
+
+template<>
+struct std::formatter<fridayc::runtime::String> : std::formatter<std::string_view> {
+  auto format(fridayc::runtime::String const& value, std::format_context& context) const;
+};
+
+#include "String.inl"
@@ -0,0 +1,59 @@
+#ifdef __INTELLISENSE__
+#include "String.hpp"
+#endif
+
+namespace fridayc::runtime {
+
+  struct String::Buffer {
+    Box<i8[]>  bytes;
+    u64        capacity;
+
+    /// @brief Bytes written so far, the length of the longest string on the buffer
+    u64        used;
+  };
+
+  struct String::Node {
+    String                   left;
+    String                   right;
+
+    /// @brief Contents once flattened, when the children are released
+    std::shared_ptr<Buffer>  flat { };
+
+    ~Node() noexcept;
+  };
+
+  inline auto String::length() const noexcept -> u64 {
+    return size;
+  }
+
+  inline auto String::empty() const noexcept -> bool {
+    return size == 0;
+  }
+
+  inline auto String::kind() const noexcept -> Storage {
+    return storage;
+  }
+
+  inline auto String::view() const -> std::string_view {
+    switch(storage) {
+      case Storage::SMALL: return { bytes.data(), size };
+      case Storage::INTERNED: return symbol.view();
+      case Storage::FLAT: return { static_cast<Buffer const*>(shared.get())->bytes.get(), size };
+      case Storage::ROPE: return rope();
+    }
+    return { };
+  }
+
+  inline auto String::operator[](u64 index) const -> i8 {
+    return view()[index];
+  }
+
+  inline auto String::operator+=(String const& rhs) -> String& {
+    return *this = *this + rhs;
+  }
+
+}
+
+inline auto std::formatter<fridayc::runtime::String>::format(fridayc::runtime::String const& value, std::format_context& context) const {
+  return std::formatter<std::string_view>::format(value.view(), context);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+namespace fridayc {
+
+  /// @brief Interned spelling of a name, compared by identity
+  /// @note Each distinct spelling is stored once for the whole process and never freed
+  struct Symbol final {
+
+    /// @brief Constructs the empty symbol
+    constexpr Symbol() noexcept = default;
+
+    constexpr auto operator==(Symbol const& other) const noexcept -> bool = default;
+
+    /// @brief Interns a spelling, thread-safe
+    /// @param spelling the text to intern
+    /// @return the unique symbol for the spelling
+    static auto intern(std::string_view spelling) -> Symbol;
+
+    /// @brief Text of the symbol, lock-free
+    /// @return a view valid for the lifetime of the process
+    auto view() const noexcept -> std::string_view;
+
+    /// @brief Numeric identifier of the symbol
+    constexpr auto value() const noexcept -> u32;
+
+    /// @brief Tells whether this is the empty symbol
+    constexpr auto empty() const noexcept -> bool;
+
+    /// @brief Number of distinct spellings interned so far
+    static auto count() noexcept -> u64;
+
+    private:
+    constexpr explicit Symbol(u32 id) noexcept;
+
+    u32 id { 0 };
+  };
+
+}
+
+template<>
+struct std::hash<fridayc::Symbol> {
+  constexpr auto operator()(fridayc::Symbol symbol) const noexcept -> u64;
+};
+
+template<>
+struct std::formatter<fridayc::Symbol> : std::formatter<std::string_view> {
+  auto format(fridayc::Symbol symbol, std::format_context& context) const;
+};
+
+#include "Symbol.inl"
@@ -0,0 +1,28 @@
+#ifdef __INTELLISENSE__
+#include "Symbol.hpp"
+#endif
+
+namespace fridayc {
+
+  constexpr Symbol::Symbol(u32 id) noexcept
+    : id { id }
+  {}
+
+  constexpr auto Symbol::value() const noexcept -> u32 {
+    return id;
+  }
+
+  constexpr auto Symbol::empty() const noexcept -> bool {
+    return id == 0;
+  }
+
+}
+
+constexpr auto std::hash<fridayc::Symbol>::operator()(fridayc::Symbol symbol) const noexcept -> u64 {
+  // * Fibonacci hashing spreads consecutive identifiers over the whole range
+  return symbol.value() * 0x9E3779B97F4A7C15ull;
+}
+
+inline auto std::formatter<fridayc::Symbol>::format(fridayc::Symbol symbol, std::format_context& context) const {
+  return std::formatter<std::string_view>::format(symbol.view(), context);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+namespace fridayc {
+
+  /// @brief Fixed-size pool of worker threads running submitted tasks
+  ///
+  /// Each worker owns a queue. Tasks submitted by a worker go to its own
+  /// queue and are taken back last-in first-out, which keeps related work on
+  /// the same thread; tasks submitted from outside are spread round-robin.
+  /// A worker whose queue is empty steals the oldest task of another one.
+  class ThreadPool {
+    struct Queue {
+      std::mutex                        mutex { };
+      std::deque<std::function<void()>> tasks { };
+    };
+
+    std::vector<Box<Queue>>   queues    { };
+    std::vector<std::jthread> workers   { };
+    std::mutex                mutex     { };
+    std::condition_variable   available { };
+    std::condition_variable   idle      { };
+    std::atomic<u64>          pending   { 0 };
+    std::atomic<u64>          queued    { 0 };
+    std::atomic<u32>          next      { 0 };
+    bool                      stopping  { false };
+
+    public:
+    /// @brief Starts the worker threads
+    /// @param threads number of workers, 0 to use one per hardware thread
+    explicit ThreadPool(u32 threads = 0);
+
+    ThreadPool(ThreadPool const&) = delete;
+    auto operator=(ThreadPool const&) -> ThreadPool& = delete;
+
+    /// @brief Waits for the queued tasks and joins the workers
+    ~ThreadPool();
+
+    /// @brief Queues a task
+    /// @param task the task to run on a worker
+    auto submit(std::function<void()> task) -> void;
+
+    /// @brief Blocks until every submitted task has completed
+    /// @note Must not be called from a task
+    auto wait() -> void;
+
+    /// @brief Number of worker threads
+    auto size() const noexcept -> u32;
+
+    /// @brief Index of the calling worker, in [0, size())
+    /// @return the index or std::nullopt if the caller is not a worker of this pool
+    auto worker() const noexcept -> std::optional<u32>;
+
+    private:
+    auto work(u32 index) -> void;
+    auto take(u32 index) -> std::function<void()>;
+  };
+
+}
@@ -161,6 +161,21 @@ namespace fridayc {
     return std::vector<std::string_view>{ NAMES.begin(), NAMES.end() };
   }
 
+  constexpr auto Token::compoundOperatorOf(Token::Type type) noexcept -> Token::Type {
+    switch(type) {
+      case Token::Type::PLUS_EQ: return Token::Type::PLUS;
+      case Token::Type::MINUS_EQ: return Token::Type::MINUS;
+      case Token::Type::STAR_EQ: return Token::Type::STAR;
+      case Token::Type::SLASH_EQ: return Token::Type::SLASH;
+      case Token::Type::MODULO_EQ: return Token::Type::MODULO;
+      case Token::Type::LSHIFT_EQ: return Token::Type::LSHIFT;
+      case Token::Type::RSHIFT_EQ: return Token::Type::RSHIFT;
+      case Token::Type::BIT_AND_EQ: return Token::Type::BIT_AND;
+      case Token::Type::BIT_OR_EQ: return Token::Type::BIT_OR;
+      default: return Token::Type::ILLEGAL;
+    }
+  }
+
   constexpr auto Token::identifierTypeOf(std::string_view literal) noexcept -> Token::Type {
     if("fn"sv == literal) return Token::Type::FN;
     else if("this"sv == literal) return Token::Type::THIS;
@@ -179,7 +194,7 @@ namespace fridayc {
     else if("print"sv == literal) return Token::Type::PRINT;
     else if("let"sv == literal) return Token::Type::LET;
     else if("using"sv == literal) return Token::Type::USING;
-    else if("namespace"sv == literal)  Token::Type::NAMESPACE;
+    else if("namespace"sv == literal) return Token::Type::NAMESPACE;
     else if("and"sv == literal) return Token::Type::AND;
     else if("or"sv == literal) return Token::Type::OR;
     else if("not"sv == literal) return Token::Type::NOT;
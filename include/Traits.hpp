@@ -32,6 +32,9 @@ namespace fridayc {
     constexpr auto at(u64 index) const -> value_type const&;
     constexpr auto operator[](u64 index) noexcept -> value_type&;
     constexpr auto operator[](u64 index) const noexcept -> value_type const&;
+
+    template<class Predicate>
+    constexpr auto removeIf(Predicate&& predicate) -> u64;
   
     private:
     std::vector<T> values;
@@ -57,5 +57,11 @@ namespace fridayc {
   template<class T>
   constexpr auto Container<T>::operator[](u64 index) const noexcept -> value_type const& {
     return values[index];
-  }  
+  }
+
+  template<class T>
+  template<class Predicate>
+  constexpr auto Container<T>::removeIf(Predicate&& predicate) -> u64 {
+    return std::erase_if(values, std::forward<Predicate>(predicate));
+  }
 }
\ No newline at end of file
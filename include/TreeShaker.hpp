@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Walker.hpp"
+#include "FlatMap.hpp"
+
+namespace fridayc {
+
+  /// @brief Removes the functions, structs and enums that cannot be reached from the roots
+  ///
+  /// Runs on the parsed program, before any semantic pass, so that later
+  /// passes never see the removed declarations. References are followed by
+  /// name: namespaces and 'using' share the top-level scope, so a qualified
+  /// name reaches the declaration of its last component. A local or a field
+  /// named like a declaration keeps it alive, which errs on the side of
+  /// keeping too much. Namespace and using statements are always kept.
+  class TreeShaker : public Walker {
+    FlatMap<Symbol, std::vector<u32>> declarations { };
+    std::vector<bool>                 reached      { };
+    std::vector<u32>                  worklist     { };
+    std::vector<Symbol>               roots;
+    u64                               declarations_removed { 0 };
+    u64                               bytes_removed        { 0 };
+
+    public:
+    /// @brief Constructs a tree shaker
+    /// @param roots names of the declarations to keep with everything they use
+    explicit TreeShaker(std::vector<Symbol> roots = { Symbol::intern("main"sv) }) noexcept;
+
+    /// @brief Removes the unreachable top-level declarations of a program
+    /// @note Nothing is removed when none of the roots is declared
+    /// @param program the program to shake
+    auto shake(Program& program) -> void;
+
+    /// @brief Number of declarations removed
+    auto removed() const noexcept -> u64;
+
+    /// @brief Number of source bytes spanned by the removed declarations
+    auto removedBytes() const noexcept -> u64;
+
+    using Walker::operator();
+
+    auto operator()(Identifier& arg) noexcept -> std::any override;
+    auto operator()(TypeExpression& arg) noexcept -> std::any override;
+
+    private:
+    auto reach(Symbol name) noexcept -> void;
+  };
+
+}
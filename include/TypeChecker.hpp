@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Walker.hpp"
+#include "TypeTable.hpp"
+#include "Error.hpp"
+
+namespace fridayc {
+
+  /// @brief Checks the types of a resolved program
+  ///
+  /// Every expression, type name and declaration gets a canonical type in a
+  /// side table. Signatures of functions and fields of structs are typed
+  /// first, so bodies can be checked in a single walk. Expressions that fail
+  /// to type get TypeId::ERROR, which is accepted everywhere so that one
+  /// mistake is reported once.
+  ///
+  /// After declare(), checkers sharing its signatures can check different
+  /// function bodies on different threads. Each one records the types of its
+  /// bodies in its own side table and keeps the nominal and array types it
+  /// looked up, so the shared TypeTable is rarely locked.
+  class TypeChecker : public Walker {
+    std::vector<Error>                   error_queue { };
+    TypeTable&                           table;
+    TypeChecker const*                   shared      { nullptr };
+    FlatMap<Visitable const*, TypeId>    types       { };
+    FlatMap<Statement const*, TypeId>    nominals    { };
+    FlatMap<TypeId, TypeId>              arrays      { };
+    FunctionStatement*                   function    { nullptr };
+    bool                                 declaring   { false };
+
+    public:
+    /// @brief Constructs a type checker
+    /// @param table the table interning the types
+    TypeChecker(TypeTable& table) noexcept;
+
+    /// @brief Constructs a type checker for function bodies
+    /// @param declarations the checker whose declare() typed the signatures
+    explicit TypeChecker(TypeChecker const& declarations) noexcept;
+
+    /// @brief Checks a program resolved by the Resolver
+    /// @param program the program to check
+    /// @return the errors, empty on success
+    auto check(Program& program) -> std::vector<Error>;
+
+    /// @brief Types the signatures of functions and the fields of structs
+    /// @param program the program to check
+    /// @return the errors, empty on success
+    auto declare(Program& program) -> std::vector<Error>;
+
+    /// @brief Checks the body of a top-level function, after declare()
+    /// @param function the function to check
+    /// @return the errors, empty on success
+    auto check(FunctionStatement& function) -> std::vector<Error>;
+
+    /// @brief Type of a checked expression, type name or declaration
+    /// @return the type, TypeId::ERROR if the node was not checked by this checker or its declarations
+    auto typeOf(Visitable const& node) const noexcept -> TypeId;
+
+    /// @brief Type of a node checked by this checker or its declarations
+    /// @return the type or nullptr if the node was not checked
+    auto find(Visitable const& node) const noexcept -> TypeId const*;
+
+    /// @brief Moves the types recorded by check() into a table, this checker keeps none of them
+    /// @param into the table, the keys of which no other checker recorded
+    auto gather(FlatMap<Visitable const*, TypeId>& into) -> void;
+
+    using Walker::operator();
+
+    auto operator()(Identifier& arg) noexcept -> std::any override;
+    auto operator()(BoolLiteral& arg) noexcept -> std::any override;
+    auto operator()(ObjectLiteral& arg) noexcept -> std::any override;
+    auto operator()(StringLiteral& arg) noexcept -> std::any override;
+    auto operator()(FloatLiteral& arg) noexcept -> std::any override;
+    auto operator()(IntLiteral& arg) noexcept -> std::any override;
+    auto operator()(CharLiteral& arg) noexcept -> std::any override;
+    auto operator()(PrefixExpression& arg) noexcept -> std::any override;
+    auto operator()(InfixExpression& arg) noexcept -> std::any override;
+    auto operator()(CallExpression& arg) noexcept -> std::any override;
+    auto operator()(SubscriptExpression& arg) noexcept -> std::any override;
+    auto operator()(TypeExpression& arg) noexcept -> std::any override;
+    auto operator()(ArrayLiteral& arg) noexcept -> std::any override;
+    auto operator()(ReturnStatement& arg) noexcept -> std::any override;
+    auto operator()(PrintStatement& arg) noexcept -> std::any override;
+    auto operator()(IfStatement& arg) noexcept -> std::any override;
+    auto operator()(WhileStatement& arg) noexcept -> std::any override;
+    auto operator()(ForStatement& arg) noexcept -> std::any override;
+    auto operator()(StructStatement& arg) noexcept -> std::any override;
+    auto operator()(FunctionStatement& arg) noexcept -> std::any override;
+    auto operator()(DeclarationStatement& arg) noexcept -> std::any override;
+    auto operator()(Program& arg) noexcept -> std::any override;
+
+    private:
+    auto errorAt(Span span, std::string error) noexcept -> void;
+
+    auto infer(Expression& expr) noexcept -> TypeId;
+    auto structure(StructStatement& declaration) noexcept -> TypeId;
+    auto enumeration(EnumStatement& declaration) noexcept -> TypeId;
+    auto array(TypeId element, u32 dimensions = 1) noexcept -> TypeId;
+    auto record(Visitable const& node, TypeId type) noexcept -> std::any;
+    template<class Describe>
+    auto expect(Expression& expr, TypeId expected, Describe&& describe) noexcept -> void;
+
+    auto assignable(TypeId to, TypeId from) const noexcept -> bool;
+    auto numeric(TypeId type) const noexcept -> bool;
+    auto callee(CallExpression& call) noexcept -> Binding const*;
+    auto member(InfixExpression& access) noexcept -> TypeId;
+    auto binary(InfixExpression& arg, Token::Type oper, TypeId lhs, TypeId rhs) noexcept -> TypeId;
+    auto assignment(InfixExpression& arg, TypeId lhs, TypeId rhs) noexcept -> TypeId;
+    auto arguments(CallExpression& call, Members const& parameters, std::string_view callee) noexcept -> void;
+  };
+
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Statement.hpp"
+#include "FlatMap.hpp"
+
+namespace fridayc {
+
+  /// @brief Canonical type, equal types have equal identifiers
+  enum struct TypeId : u32 {
+    ERROR,  // * type of an ill-typed expression, compatible with everything to avoid cascading errors
+    INT,
+    FLOAT,
+    BOOL,
+    CHAR,
+    STRING,
+    VOID,
+    NUL,    // * type of 'null', assignable to strings, structs and arrays
+  };
+
+  /// @brief Description of an interned type
+  struct TypeInfo {
+
+    enum struct Kind : u8 { ERROR, INT, FLOAT, BOOL, CHAR, STRING, VOID, NUL, STRUCT, ENUM, ARRAY };
+
+    /// @brief Kind of the type
+    Kind kind;
+
+    /// @brief Element type of an array, the type itself otherwise
+    TypeId element;
+
+    /// @brief Declaring StructStatement or EnumStatement, nullptr otherwise
+    Statement* declaration;
+  };
+
+  /// @brief Interns types so each one is described once and compared by identifier
+  ///
+  /// Interning is thread-safe. Descriptions are listed in fixed-size segments
+  /// that never move, so info() and name() need no lock.
+  /// @note An N-dimensional array is an array of (N-1)-dimensional arrays
+  class TypeTable {
+    static constexpr u64 SEGMENT_BITS = 8;
+    static constexpr u64 SEGMENT_SIZE = 1 << SEGMENT_BITS;
+    static constexpr u64 MAX_SEGMENTS = 1 << 14;
+
+    mutable std::mutex                                mutex          { };
+    std::array<std::atomic<TypeInfo*>, MAX_SEGMENTS>  segments       { };
+    std::vector<Box<TypeInfo[]>>                      owned_segments { };
+    u32                                               count          { 0 };
+    FlatMap<Statement const*, TypeId>                 nominals       { };
+    FlatMap<TypeId, TypeId>                           arrays         { };
+
+    public:
+    /// @brief Constructs a table holding the predefined types
+    TypeTable();
+
+    TypeTable(TypeTable const&) = delete;
+    auto operator=(TypeTable const&) -> TypeTable& = delete;
+
+    /// @brief Type of a primitive type name
+    /// @return the type or std::nullopt if the name is not primitive
+    auto primitive(Symbol name) const noexcept -> std::optional<TypeId>;
+
+    /// @brief Type declared by a struct
+    auto structure(StructStatement& declaration) -> TypeId;
+
+    /// @brief Type declared by an enum
+    auto enumeration(EnumStatement& declaration) -> TypeId;
+
+    /// @brief Array type
+    /// @param element the element type
+    /// @param dimensions the number of dimensions, 0 returns the element type
+    auto array(TypeId element, u32 dimensions = 1) -> TypeId;
+
+    /// @brief Description of a type, lock-free
+    auto info(TypeId type) const noexcept -> TypeInfo const&;
+
+    /// @brief Spelling of a type, for diagnostics
+    auto name(TypeId type) const -> std::string;
+
+    /// @brief Number of distinct types
+    auto size() const noexcept -> u64;
+
+    private:
+    auto intern(Statement& declaration, TypeInfo::Kind kind) -> TypeId;
+    auto append(TypeInfo description) -> TypeId;
+  };
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Bytecode.hpp"
+
+namespace fridayc {
+
+  /// @brief Runs the bytecode of a module
+  ///
+  /// Frames are windows of one register stack: the frame of a callee
+  /// starts at the arguments of its call, and calls keep an explicit list
+  /// of return addresses instead of recursing. Instructions are dispatched
+  /// either by a switch, or by direct threading, where every instruction
+  /// holds the address of its handler and each handler jumps straight to
+  /// the next one. Threading needs computed gotos, compilers without them
+  /// always run the switch. Functions of a module file are materialized on
+  /// their first call. Faults are reported as a RuntimeError at the span of
+  /// the instruction that raised them, like the Executor does.
+  class VirtualMachine {
+    public:
+    enum struct Dispatch : u8 { THREADED, SWITCH };
+
+    private:
+    using Cell = runtime::Cell;
+
+    /// @brief Instruction holding the address of its handler
+    struct Threaded {
+      void*            handler { nullptr };
+      bytecode::Opcode op      { };
+      u16              a       { 0 };
+      u16              b       { 0 };
+      u16              c       { 0 };
+    };
+
+    /// @brief Caller of an active call, with the index of the call instruction
+    struct Frame {
+      u32   function { 0 };
+      u32   at       { 0 };
+      Cell* base     { nullptr };
+    };
+
+    bytecode::Module&                   module;
+    std::ostream&                       out;
+    ExecutionLimits                     limits;
+    void* const*                        handlers { nullptr };
+    std::vector<std::vector<Threaded>>  threaded { };
+    std::vector<Cell>                   stack    { };
+    std::vector<Frame>                  frames   { };
+    std::vector<Error>                  errors   { };
+    std::string                         buffer   { };
+    i64                                 exit     { 0 };
+
+    public:
+    /// @brief Constructs a virtual machine
+    /// @param module the module to run, which must outlive the machine
+    /// @param out the stream 'print' writes to
+    /// @param limits the bounds of the run
+    VirtualMachine(bytecode::Module& module, std::ostream& out, ExecutionLimits limits = { }) noexcept;
+
+    /// @brief Runs 'main'
+    /// @param dispatch how instructions are dispatched
+    /// @return the errors, empty if the program ran to completion
+    auto run(Dispatch dispatch = Dispatch::THREADED) -> std::vector<Error>;
+
+    /// @brief Value returned by 'main' if it returns an int, 0 otherwise
+    auto status() const noexcept -> i64;
+
+    private:
+    /// @brief Runs 'main' on code of Step, which is an Instruction or a Threaded one
+    template<class Step>
+    auto execute() -> void;
+
+    template<class Step>
+    auto codeOf(u32 function) const noexcept -> Step const*;
+
+    /// @brief Translates the code of a function to threaded code
+    auto thread(u32 function) -> void;
+
+    /// @brief Materializes a function, and threads it if the code run is threaded
+    auto load(u32 function) -> bytecode::Function const&;
+  };
+
+}
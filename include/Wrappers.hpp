@@ -196,6 +196,10 @@ namespace fridayc {
     constexpr static auto product(Long lhs, Long rhs) noexcept -> Long;
     constexpr static auto quotient(Long lhs, Long rhs) -> Long;  
     constexpr static auto remainder(Long lhs, Long rhs) -> Long;
+    constexpr static auto checkedSum(Long lhs, Long rhs) -> Long;
+    constexpr static auto checkedDifference(Long lhs, Long rhs) -> Long;
+    constexpr static auto checkedProduct(Long lhs, Long rhs) -> Long;
+    constexpr static auto checkedNegation(Long value) -> Long;
   
     private:
     value_type value;
@@ -4,6 +4,18 @@
 
 
 namespace fridayc {
+
+  /// @brief Parses exactly the characters of a view as a number
+  /// @note std::sto* would need a null-terminated copy of the view
+  template<class T>
+  constexpr auto parseNumber(std::string_view value) -> T {
+    T result { };
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.length(), result);
+    if(error == std::errc::result_out_of_range) throw std::out_of_range("Failed to parse \"{}\": out of range"f.format(value));
+    if(error != std::errc{ } or end != value.data() + value.length()) throw std::invalid_argument("Failed to parse \"{}\" as a number"f.format(value));
+    return result;
+  }
+
   constexpr Long::Long(value_type other) noexcept
     : value { other } 
   {}
@@ -27,7 +39,7 @@ namespace fridayc {
   }
   
   constexpr auto Long::parse(std::string_view str) -> Long {
-    return std::stoll(str.data());
+    return parseNumber<value_type>(str);
   }
   
   constexpr auto Long::wrap(value_type other) noexcept -> Long { 
@@ -52,13 +64,37 @@ namespace fridayc {
   
   constexpr auto Long::quotient(Long lhs, Long rhs) -> Long { 
     if(rhs == 0LL) throw std::domain_error("Division by 0.");
+    if(lhs == std::numeric_limits<value_type>::min() and rhs == -1LL) throw std::overflow_error("Integer overflow.");
     return Long{lhs / rhs}; 
   }
   
   constexpr auto Long::remainder(Long lhs, Long rhs) -> Long { 
     if(rhs == 0LL) throw std::domain_error("Division by 0.");
+    if(lhs == std::numeric_limits<value_type>::min() and rhs == -1LL) throw std::overflow_error("Integer overflow.");
     return Long{lhs % rhs};
   }
+
+  constexpr auto Long::checkedSum(Long lhs, Long rhs) -> Long {
+    value_type result;
+    if(__builtin_add_overflow(lhs.value, rhs.value, &result)) throw std::overflow_error("Integer overflow.");
+    return Long{result};
+  }
+
+  constexpr auto Long::checkedDifference(Long lhs, Long rhs) -> Long {
+    value_type result;
+    if(__builtin_sub_overflow(lhs.value, rhs.value, &result)) throw std::overflow_error("Integer overflow.");
+    return Long{result};
+  }
+
+  constexpr auto Long::checkedProduct(Long lhs, Long rhs) -> Long {
+    value_type result;
+    if(__builtin_mul_overflow(lhs.value, rhs.value, &result)) throw std::overflow_error("Integer overflow.");
+    return Long{result};
+  }
+
+  constexpr auto Long::checkedNegation(Long value) -> Long {
+    return checkedDifference(Long{0}, value);
+  }
   
   constexpr auto Long::isEven() const noexcept -> bool { 
     return unwrap() % 2 == 0; 
@@ -89,7 +125,7 @@ namespace fridayc {
   }
   
   constexpr auto Integer::parse(std::string_view value) -> Integer {
-    return std::stoi(value.data());
+    return parseNumber<value_type>(value);
   }
   
   constexpr auto Integer::wrap(value_type other) noexcept -> Integer { 
@@ -152,7 +188,7 @@ namespace fridayc {
   }
   
   constexpr auto Double::parse(std::string_view value) -> Double {
-    return std::stod(value.data());
+    return parseNumber<value_type>(value);
   }
   
   constexpr auto Double::wrap(value_type other) noexcept -> Double { 
@@ -205,7 +241,7 @@ namespace fridayc {
   }
   
   constexpr auto Float::parse(std::string_view value) -> Float {
-    return std::stof(value.data());
+    return parseNumber<value_type>(value);
   }
   
   constexpr auto Float::wrap(value_type other) noexcept -> Float { 
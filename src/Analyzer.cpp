@@ -0,0 +1,75 @@
+#include "Analyzer.hpp"
+#include "ThreadPool.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    /// @brief Number of analysis tasks created per worker, to balance functions of uneven size
+    constexpr u64 TASKS_PER_WORKER = 8;
+
+  }
+
+  Analyzer::Analyzer(TypeTable& table, ThreadPool& pool)
+    : pool { pool }
+    , signatures { table }
+  {
+    resolvers.reserve(pool.size());
+    checkers.reserve(pool.size());
+    for(u32 i = 0; i < pool.size(); ++i) {
+      resolvers.push_back(std::make_unique<Resolver>(declarations));
+      checkers.push_back(std::make_unique<TypeChecker>(signatures));
+    }
+  }
+
+  auto Analyzer::analyze(Program& program) -> std::vector<Error> {
+    std::vector<Error> errors = declarations.declare(program);
+    std::ranges::move(signatures.declare(program), std::back_inserter(errors));
+
+    std::vector<FunctionStatement*> functions;
+    for(auto& stmt : *program.block)
+      if(auto* function = dynamic_cast<FunctionStatement*>(stmt.get())) functions.push_back(function);
+
+    const u64 count = functions.size();
+    const u64 tasks = std::min(count, pool.size() * TASKS_PER_WORKER);
+
+    // * Each task reports into its own list, concatenated in task order once all are done
+    std::vector<std::vector<Error>> diagnostics(tasks);
+
+    for(u64 task = 0; task < tasks; ++task) {
+      pool.submit([this, task, tasks, count, &functions, &diagnostics] {
+        const u64 begin = count * task / tasks;
+        const u64 end = count * (task + 1) / tasks;
+
+        const u32 worker = *pool.worker();
+        Resolver& resolver = *resolvers[worker];
+        TypeChecker& checker = *checkers[worker];
+
+        std::vector<Error>& found = diagnostics[task];
+        for(u64 i = begin; i < end; ++i) {
+          std::ranges::move(resolver.resolve(*functions[i]), std::back_inserter(found));
+          std::ranges::move(checker.check(*functions[i]), std::back_inserter(found));
+        }
+      });
+    }
+    pool.wait();
+
+    for(std::vector<Error>& found : diagnostics)
+      std::ranges::move(found, std::back_inserter(errors));
+
+    // * Declarations were checked before any body, errors at the same place keep the order they were found in
+    std::ranges::stable_sort(errors, { }, [](Error const& error) { return std::pair<u32, u32>{ error.span.file, error.span.offset }; });
+
+    // * Every node is recorded by exactly one checker, whichever worker analyzed its function
+    types.clear();
+    for(auto& checker : checkers) checker->gather(types);
+
+    return errors;
+  }
+
+  auto Analyzer::typeOf(Visitable const& node) const noexcept -> TypeId {
+    if(TypeId const* type = types.find(&node)) return *type;
+    return signatures.typeOf(node);
+  }
+
+}
@@ -0,0 +1,115 @@
+#include "Assembler.hpp"
+
+namespace fridayc::x86 {
+
+  auto Assembler::size() const noexcept -> u32 {
+    return (u32)bytes.size();
+  }
+
+  auto Assembler::code() const noexcept -> std::vector<u8> const& {
+    return bytes;
+  }
+
+  auto Assembler::byte(u8 value) -> void {
+    bytes.push_back(value);
+  }
+
+  auto Assembler::raw(std::initializer_list<u8> values) -> void {
+    bytes.insert(bytes.end(), values);
+  }
+
+  auto Assembler::dword(u32 value) -> void {
+    for(u32 shift = 0; shift < 32; shift += 8) byte((u8)(value >> shift));
+  }
+
+  auto Assembler::qword(u64 value) -> void {
+    for(u32 shift = 0; shift < 64; shift += 8) byte((u8)(value >> shift));
+  }
+
+  auto Assembler::rex(bool wide, u8 reg, u8 base) -> void {
+    const u8 prefix = 0x40 | wide << 3 | (reg >> 3) << 2 | base >> 3;
+    if(prefix != 0x40) byte(prefix);
+  }
+
+  auto Assembler::memory(u8 reg, u8 base, i32 disp) -> void {
+    const u8 mod = disp == 0 and (base & 7) != RBP ? 0 : disp >= -128 and disp <= 127 ? 1 : 2;
+    byte(mod << 6 | (reg & 7) << 3 | (base & 7));
+    if((base & 7) == RSP) byte(0x24);
+    if(mod == 1) byte((u8)(i8)disp);
+    else if(mod == 2) dword((u32)disp);
+  }
+
+  auto Assembler::load(u16 op, u8 reg, u8 base, i32 disp, bool wide) -> void {
+    rex(wide, reg, base);
+    if(op > 0xFF) byte((u8)(op >> 8));
+    byte((u8)op);
+    memory(reg, base, disp);
+  }
+
+  auto Assembler::store(u8 base, i32 disp, u8 reg, bool wide) -> void {
+    rex(wide, reg, base);
+    byte(0x89);
+    memory(reg, base, disp);
+  }
+
+  auto Assembler::direct(u16 op, u8 reg, u8 rm, bool wide) -> void {
+    rex(wide, reg, rm);
+    if(op > 0xFF) byte((u8)(op >> 8));
+    byte((u8)op);
+    byte(0xC0 | (reg & 7) << 3 | (rm & 7));
+  }
+
+  auto Assembler::group(u8 op, u8 extension, u8 base, i32 disp, bool wide) -> void {
+    rex(wide, 0, base);
+    byte(op);
+    memory(extension, base, disp);
+  }
+
+  auto Assembler::sse(u8 prefix, u8 op, u8 xmm, u8 base, i32 disp) -> void {
+    byte(prefix);
+    rex(false, xmm, base);
+    raw({ 0x0F, op });
+    memory(xmm, base, disp);
+  }
+
+  auto Assembler::movq(u8 xmm, u8 reg, bool to_general) -> void {
+    byte(0x66);
+    direct(to_general ? 0x0F7E : 0x0F6E, xmm, reg);
+  }
+
+  auto Assembler::immediate(u8 reg, u64 value) -> void {
+    const bool wide = value > std::numeric_limits<u32>::max();
+    rex(wide, 0, reg);
+    byte(0xB8 + (reg & 7));
+    if(wide) qword(value);
+    else dword((u32)value);
+  }
+
+  auto Assembler::set(Condition condition) -> void {
+    raw({ 0x0F, (u8)(0x90 | condition), 0xC0, 0x0F, 0xB6, 0xC0 });
+  }
+
+  auto Assembler::jump(Condition condition) -> u32 {
+    raw({ 0x0F, (u8)(0x80 | condition) });
+    dword(0);
+    return size() - 4;
+  }
+
+  auto Assembler::jump() -> u32 {
+    byte(0xE9);
+    dword(0);
+    return size() - 4;
+  }
+
+  auto Assembler::call() -> u32 {
+    byte(0xE8);
+    dword(0);
+    return size() - 4;
+  }
+
+  auto Assembler::patch(u32 position, u32 target) noexcept -> void {
+    const u32 displacement = target - (position + 4);
+    std::memcpy(bytes.data() + position, &displacement, 4);
+  }
+
+}
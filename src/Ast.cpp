@@ -1,13 +1,62 @@
 #include "Ast.hpp"
 #include "Visitor.hpp"
+#include "ThreadPool.hpp"
 
 namespace fridayc {
 
+  namespace {
+
+    /// @brief Number of serialization tasks created per worker, to balance uneven statements
+    constexpr u64 TASKS_PER_WORKER = 8;
+
+  }
+
   auto Program::toString() const noexcept -> std::string {
     return "{{\"type\": \"Program\", \"block\": {}}}"f.format(block->toString());
   }
+
+  auto Program::toString(ThreadPool& pool) const -> std::string {
+    std::ostringstream stream;
+    write(stream, pool);
+    return std::move(stream).str();
+  }
+
+  auto Program::write(std::ostream& stream, ThreadPool& pool) const -> void {
+    const u64 count = block->size();
+    const u64 tasks = std::min(count, pool.size() * TASKS_PER_WORKER);
+    
+    std::vector<std::string> buffers(tasks);
+    auto ready = std::make_unique<std::atomic<bool>[]>(tasks);
+
+    for(u64 task = 0; task < tasks; ++task) {
+      pool.submit([this, task, tasks, count, &buffers, &ready] {
+        const u64 begin = count * task / tasks;
+        const u64 end = count * (task + 1) / tasks;
+
+        std::string& buffer = buffers[task];
+        for(u64 i = begin; i < end; ++i) {
+          if(i != begin) buffer += ", ";
+          buffer += (*block)[i]->toString();
+        }
+
+        ready[task].store(true, std::memory_order_release);
+        ready[task].notify_one();
+      });
+    }
+
+    stream << "{\"type\": \"Program\", \"block\": {\"type\": \"BlockStatement\", \"statements\": [";
+    for(u64 task = 0; task < tasks; ++task) {
+      ready[task].wait(false, std::memory_order_acquire);
+      if(task != 0) stream << ", ";
+      stream << buffers[task];
+      std::string{}.swap(buffers[task]);
+    }
+    stream << "]}}";
+
+    pool.wait();
+  }
   
   auto Program::operator()(Visitor& visitor) noexcept -> std::any {
     return visitor.visit(*this);
   }
-}
\ No newline at end of file
+}
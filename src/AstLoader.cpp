@@ -0,0 +1,910 @@
+#include "AstLoader.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace fridayc {
+
+  namespace {
+
+    constexpr auto isBlank(i8 c) noexcept -> bool {
+      return c == ' ' or c == '\n' or c == '\r' or c == '\t';
+    }
+
+    /// @brief Position of the first blank character at or after pos, or input.size()
+    auto skipBlanks(std::string_view input, u64 pos) noexcept -> u64 {
+      const i8* data = input.data();
+      const u64 size = input.size();
+
+      // * Compact output has at most one blank between tokens
+      if(pos < size and not isBlank(data[pos])) return pos;
+
+#if defined(__SSE2__)
+      while(pos + 16 <= size) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        const __m128i blank = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n'))),
+          _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')))
+        );
+        const u32 solid = ~static_cast<u32>(_mm_movemask_epi8(blank)) & 0xFFFF;
+        if(solid) return pos + std::countr_zero(solid);
+        pos += 16;
+      }
+#endif
+
+      while(pos < size and isBlank(data[pos])) ++pos;
+      return pos;
+    }
+
+    /// @brief Position of the first '"' or '\\' at or after pos, or input.size()
+    auto findQuoteOrEscape(std::string_view input, u64 pos) noexcept -> u64 {
+      const i8* data = input.data();
+      const u64 size = input.size();
+
+#if defined(__SSE2__)
+      const __m128i quote = _mm_set1_epi8('"');
+      const __m128i escape = _mm_set1_epi8('\\');
+      while(pos + 16 <= size) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        const u32 special = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, escape)));
+        if(special) return pos + std::countr_zero(special);
+        pos += 16;
+      }
+#endif
+
+      while(pos < size and data[pos] != '"' and data[pos] != '\\') ++pos;
+      return pos;
+    }
+
+    /// @brief Appends a code point encoded as UTF-8
+    auto appendUtf8(std::string& out, u32 code) -> void {
+      if(code < 0x80) {
+        out += static_cast<i8>(code);
+      } else if(code < 0x800) {
+        out += static_cast<i8>(0xC0 | code >> 6);
+        out += static_cast<i8>(0x80 | (code & 0x3F));
+      } else if(code < 0x10000) {
+        out += static_cast<i8>(0xE0 | code >> 12);
+        out += static_cast<i8>(0x80 | (code >> 6 & 0x3F));
+        out += static_cast<i8>(0x80 | (code & 0x3F));
+      } else {
+        out += static_cast<i8>(0xF0 | code >> 18);
+        out += static_cast<i8>(0x80 | (code >> 12 & 0x3F));
+        out += static_cast<i8>(0x80 | (code >> 6 & 0x3F));
+        out += static_cast<i8>(0x80 | (code & 0x3F));
+      }
+    }
+
+  }
+
+  const std::map<std::string_view, AstLoader::StatementLoader> AstLoader::stmtLoaders {
+    { "ExpressionStatement"sv  , AstLoader::loadExpressionStatement  },
+    { "PrintStatement"sv       , AstLoader::loadPrintStatement       },
+    { "ReturnStatement"sv      , AstLoader::loadReturnStatement      },
+    { "BlockStatement"sv       , AstLoader::loadBlockStatement       },
+    { "IfStatement"sv          , AstLoader::loadIfStatement          },
+    { "WhileStatement"sv       , AstLoader::loadWhileStatement       },
+    { "ForStatement"sv         , AstLoader::loadForStatement         },
+    { "StructStatement"sv      , AstLoader::loadStructStatement      },
+    { "EnumStatement"sv        , AstLoader::loadEnumStatement        },
+    { "FunctionStatement"sv    , AstLoader::loadFunctionStatement    },
+    { "NamespaceStatement"sv   , AstLoader::loadNamespaceStatement   },
+    { "UsingStatement"sv       , AstLoader::loadUsingStatement       },
+    { "DeclarationStatement"sv , AstLoader::loadDeclarationStatement },
+  };
+
+  const std::map<std::string_view, AstLoader::ExpressionLoader> AstLoader::exprLoaders {
+    { "Identifier"sv           , AstLoader::loadIdentifier           },
+    { "BoolLiteral"sv          , AstLoader::loadBoolLiteral          },
+    { "ObjectLiteral"sv        , AstLoader::loadObjectLiteral        },
+    { "StringLiteral"sv        , AstLoader::loadStringLiteral        },
+    { "FloatLiteral"sv         , AstLoader::loadFloatLiteral         },
+    { "IntLiteral"sv           , AstLoader::loadIntLiteral           },
+    { "CharLiteral"sv          , AstLoader::loadCharLiteral          },
+    { "ArrayLiteral"sv         , AstLoader::loadArrayLiteral         },
+    { "TypeExpression"sv       , AstLoader::loadTypeExpression       },
+    { "PrefixExpression"sv     , AstLoader::loadPrefixExpression     },
+    { "InfixExpression"sv      , AstLoader::loadInfixExpression      },
+    { "CallExpression"sv       , AstLoader::loadCallExpression       },
+    { "SubscriptExpression"sv  , AstLoader::loadSubscriptExpression  },
+  };
+
+  const std::map<std::string_view, Token::Type> AstLoader::operators = [] {
+    std::map<std::string_view, Token::Type> result;
+    const auto names = Token::names();
+    const auto values = Token::values();
+    for(u64 i = 0; i < names.size(); ++i)
+      result.emplace(names[i], static_cast<Token::Type>(values[i]));
+    return result;
+  }();
+
+  AstLoader::AstLoader(u32 file) noexcept
+    : input { Sources::text(file) }
+    , file { file }
+  {}
+
+  auto AstLoader::load() -> std::tuple<Program, std::vector<Error>> {
+    pos = 0;
+
+    Program program;
+    skipWhitespace();
+    const u64 at = pos;
+    std::string_view type = beginNode();
+    if(good() and type != "Program"sv)
+      errorAt(at, "Expected a Program node, got '{}'"f.format(type));
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "block"sv) program.block = loadBlock();
+      else skipValue();
+    }
+    require(program.block.get(), "Program"sv, "block"sv, at);
+
+    skipWhitespace();
+    if(good() and pos < input.size())
+      errorAt(pos, "Unexpected '{}' after the program"f.format(input[pos]));
+
+    return std::make_tuple(std::move(program), std::move(error_queue));
+  }
+
+  auto AstLoader::good() const noexcept -> bool {
+    return error_queue.empty();
+  }
+
+  auto AstLoader::errorAt(u64 offset, std::string error) noexcept -> void {
+    Span span;
+    span.file = file;
+    span.offset = std::min<u64>(offset, input.size());
+    span.length = 1;
+    error_queue.emplace_back(std::move(error), span);
+  }
+
+  auto AstLoader::skipWhitespace() noexcept -> void {
+    pos = skipBlanks(input, pos);
+  }
+
+  auto AstLoader::peek() noexcept -> i8 {
+    skipWhitespace();
+    return pos < input.size() ? input[pos] : '\0';
+  }
+
+  auto AstLoader::expect(i8 c) noexcept -> void {
+    if(not good()) return;
+    if(peek() == c) {
+      ++pos;
+      return;
+    }
+
+    if(pos < input.size()) errorAt(pos, "Expected '{}', got '{}'"f.format(c, input[pos]));
+    else errorAt(pos, "Expected '{}', got end of input"f.format(c));
+  }
+
+  auto AstLoader::readString(bool* escaped) noexcept -> std::string_view {
+    expect('"');
+    if(not good()) return { };
+
+    const u64 start = pos;
+    pos = findQuoteOrEscape(input, pos);
+
+    // * Fast path: no escape sequence, the value is a slice of the input
+    if(pos < input.size() and input[pos] == '"') {
+      if(escaped) *escaped = false;
+      return input.substr(start, pos++ - start);
+    }
+
+    scratch.assign(input.substr(start, pos - start));
+    while(pos < input.size() and input[pos] == '\\') {
+      if(++pos == input.size()) break;
+
+      switch(const i8 c = input[pos++]; c) {
+        case 'n': scratch += '\n'; break;
+        case 't': scratch += '\t'; break;
+        case 'r': scratch += '\r'; break;
+        case 'b': scratch += '\b'; break;
+        case 'f': scratch += '\f'; break;
+        case 'u': {
+          u32 code = 0;
+          const auto result = std::from_chars(input.data() + pos, input.data() + std::min(pos + 4, input.size()), code, 16);
+          if(result.ec != std::errc{} or result.ptr != input.data() + pos + 4) {
+            errorAt(pos, "Invalid unicode escape sequence"s);
+            return { };
+          }
+          pos += 4;
+
+          // * Combine a surrogate pair
+          u32 low = 0;
+          if(code >= 0xD800 and code < 0xDC00 and input.substr(pos, 2) == "\\u"sv) {
+            const auto next = std::from_chars(input.data() + pos + 2, input.data() + std::min(pos + 6, input.size()), low, 16);
+            if(next.ec == std::errc{} and next.ptr == input.data() + pos + 6 and low >= 0xDC00 and low < 0xE000) {
+              code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+              pos += 6;
+            }
+          }
+          appendUtf8(scratch, code);
+          break;
+        }
+        default: scratch += c;
+      }
+
+      const u64 run = pos;
+      pos = findQuoteOrEscape(input, pos);
+      scratch.append(input.substr(run, pos - run));
+    }
+
+    if(pos >= input.size()) {
+      errorAt(start - 1, "Unterminated string"s);
+      return { };
+    }
+
+    ++pos; // '"'
+    if(escaped) *escaped = true;
+    return scratch;
+  }
+
+  auto AstLoader::readSymbol() noexcept -> Symbol {
+    std::string_view spelling = readString();
+    return good() ? Symbol::intern(spelling) : Symbol{};
+  }
+
+  auto AstLoader::readInteger() noexcept -> i64 {
+    if(not good()) return 0;
+    skipWhitespace();
+
+    i64 value = 0;
+    const auto result = std::from_chars(input.data() + pos, input.data() + input.size(), value);
+    if(result.ec != std::errc{}) {
+      errorAt(pos, "Expected an integer"s);
+      return 0;
+    }
+
+    pos = result.ptr - input.data();
+    return value;
+  }
+
+  auto AstLoader::readDouble() noexcept -> f64 {
+    if(not good()) return 0;
+    skipWhitespace();
+
+    f64 value = 0;
+    const auto result = std::from_chars(input.data() + pos, input.data() + input.size(), value);
+    if(result.ec != std::errc{}) {
+      errorAt(pos, "Expected a number"s);
+      return 0;
+    }
+
+    pos = result.ptr - input.data();
+    return value;
+  }
+
+  auto AstLoader::readBool() noexcept -> bool {
+    if(not good()) return false;
+
+    // * Booleans are written as strings, plain JSON literals are accepted as well
+    const u64 at = pos;
+    std::string_view value;
+    if(peek() == '"') {
+      value = readString();
+    } else {
+      value = input.substr(pos, input.substr(pos, 5).starts_with("false"sv) ? 5 : 4);
+      pos += value.length();
+    }
+
+    if(value == "true"sv) return true;
+    if(value == "false"sv) return false;
+
+    if(good()) errorAt(at, "Expected a boolean"s);
+    return false;
+  }
+
+  auto AstLoader::readOperator() noexcept -> Token::Type {
+    skipWhitespace();
+    const u64 at = pos;
+    std::string_view name = readString();
+    if(not good()) return Token::Type::ILLEGAL;
+
+    if(auto it = operators.find(name); it != operators.end()) return it->second;
+
+    errorAt(at, "Unknown operator '{}'"f.format(name));
+    return Token::Type::ILLEGAL;
+  }
+
+  auto AstLoader::skipValue() noexcept -> void {
+    u64 depth = 0;
+    do {
+      switch(peek()) {
+        case '"': readString(); break;
+        case '{': case '[': ++depth; ++pos; break;
+        case '}': case ']':
+          if(depth == 0) {
+            errorAt(pos, "Expected a value, got '{}'"f.format(input[pos]));
+            return;
+          }
+          --depth; ++pos;
+          break;
+        case ',': case ':': ++pos; break;
+        case '\0':
+          if(pos >= input.size()) {
+            errorAt(pos, "Unexpected end of input"s);
+            return;
+          }
+          [[fallthrough]];
+        default:
+          // * Scalar: number, true, false or null
+          while(pos < input.size() and not isBlank(input[pos]) and not "{}[],:\""sv.contains(input[pos])) ++pos;
+      }
+    } while(depth > 0 and good());
+  }
+
+  auto AstLoader::beginNode() noexcept -> std::string_view {
+    expect('{');
+
+    const u64 at = pos;
+    std::string_view key = readString();
+    if(good() and key != "type"sv) errorAt(at, "Expected the \"type\" key first, got \"{}\""f.format(key));
+
+    expect(':');
+    return readString();
+  }
+
+  auto AstLoader::nextKey(std::string_view& key) noexcept -> bool {
+    if(not good()) return false;
+    if(peek() == '}') {
+      ++pos;
+      return false;
+    }
+
+    expect(',');
+    key = readString();
+    expect(':');
+    return good();
+  }
+
+  auto AstLoader::nextElement(bool& first) noexcept -> bool {
+    if(not good()) return false;
+    if(peek() == ']') {
+      ++pos;
+      return false;
+    }
+
+    if(not first) expect(',');
+    first = false;
+    return good();
+  }
+
+  auto AstLoader::require(void const* child, std::string_view node, std::string_view key, u64 at) noexcept -> void {
+    if(good() and not child) errorAt(at, "Missing key \"{}\" in {}"f.format(key, node));
+  }
+
+  auto AstLoader::loadStatement() noexcept -> Box<Statement> {
+    skipWhitespace();
+    const u64 at = pos;
+    std::string_view type = beginNode();
+    if(not good()) return nullptr;
+
+    if(auto it = stmtLoaders.find(type); it != stmtLoaders.end())
+      return std::invoke(it->second, this);
+
+    errorAt(at, "Unknown statement type '{}'"f.format(type));
+    return nullptr;
+  }
+
+  auto AstLoader::loadExpression() noexcept -> Box<Expression> {
+    skipWhitespace();
+    const u64 at = pos;
+    std::string_view type = beginNode();
+    if(not good()) return nullptr;
+
+    if(auto it = exprLoaders.find(type); it != exprLoaders.end())
+      return std::invoke(it->second, this);
+
+    errorAt(at, "Unknown expression type '{}'"f.format(type));
+    return nullptr;
+  }
+
+  auto AstLoader::loadType() noexcept -> Box<TypeExpression> {
+    skipWhitespace();
+    const u64 at = pos;
+    std::string_view type = beginNode();
+    if(good() and type != "TypeExpression"sv) errorAt(at, "Expected a TypeExpression, got '{}'"f.format(type));
+    return loadTypeFields();
+  }
+
+  auto AstLoader::loadTypeFields() noexcept -> Box<TypeExpression> {
+    const u64 at = pos;
+    Symbol name;
+    i64 dimensions = 0;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "name"sv) name = readSymbol();
+      else if(key == "dimensions"sv) dimensions = readInteger();
+      else skipValue();
+    }
+
+    if(good() and name.empty()) errorAt(at, "Missing key \"name\" in TypeExpression"s);
+    if(good() and (dimensions < 0 or dimensions > std::numeric_limits<u32>::max())) errorAt(at, "Invalid type dimensions"s);
+    if(not good()) return nullptr;
+
+    return std::make_unique<TypeExpression>(name, static_cast<u32>(dimensions));
+  }
+
+  auto AstLoader::loadBlock() noexcept -> Box<BlockStatement> {
+    skipWhitespace();
+    const u64 at = pos;
+    std::string_view type = beginNode();
+    if(good() and type != "BlockStatement"sv) errorAt(at, "Expected a BlockStatement, got '{}'"f.format(type));
+    return loadBlockFields();
+  }
+
+  auto AstLoader::loadBlockFields() noexcept -> Box<BlockStatement> {
+    auto block = std::make_unique<BlockStatement>();
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "statements"sv) {
+        expect('[');
+        for(bool first = true; nextElement(first); ) {
+          auto stmt = loadStatement();
+          if(good()) block->add(std::move(stmt));
+        }
+      } else skipValue();
+    }
+
+    if(not good()) return nullptr;
+    return block;
+  }
+
+  auto AstLoader::loadMembers(Members& members, std::string_view kind) noexcept -> void {
+    expect('[');
+    for(bool first = true; nextElement(first); ) {
+      skipWhitespace();
+      const u64 at = pos;
+      std::string_view type = beginNode();
+      if(good() and type != kind) errorAt(at, "Expected a {}, got '{}'"f.format(kind, type));
+
+      Symbol name;
+      Box<TypeExpression> datatype;
+      std::string_view key;
+      while(nextKey(key)) {
+        if(key == "identifier"sv) name = readSymbol();
+        else if(key == "datatype"sv) datatype = loadType();
+        else skipValue();
+      }
+
+      if(good() and name.empty()) errorAt(at, "Missing key \"identifier\" in {}"f.format(kind));
+      require(datatype.get(), kind, "datatype"sv, at);
+      if(good() and not members.add(name, std::move(datatype)))
+        errorAt(at, "Duplicate {} '{}'"f.format(kind == "Field"sv ? "struct field" : "function parameter", name));
+    }
+  }
+
+  auto AstLoader::loadArguments(Container<Box<Expression>>& arguments) noexcept -> void {
+    expect('[');
+    for(bool first = true; nextElement(first); ) {
+      auto expr = loadExpression();
+      if(good()) arguments.add(std::move(expr));
+    }
+  }
+
+  auto AstLoader::loadExpressionStatement() noexcept -> Box<Statement> {
+    const u64 at = pos;
+    Box<Expression> expr;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "expr"sv) expr = loadExpression();
+      else skipValue();
+    }
+
+    require(expr.get(), "ExpressionStatement"sv, "expr"sv, at);
+    if(not good()) return nullptr;
+    return std::make_unique<ExpressionStatement>(std::move(expr));
+  }
+
+  auto AstLoader::loadPrintStatement() noexcept -> Box<Statement> {
+    const u64 at = pos;
+    Box<Expression> expr;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "expr"sv) expr = loadExpression();
+      else skipValue();
+    }
+
+    require(expr.get(), "PrintStatement"sv, "expr"sv, at);
+    if(not good()) return nullptr;
+    return std::make_unique<PrintStatement>(std::move(expr));
+  }
+
+  auto AstLoader::loadReturnStatement() noexcept -> Box<Statement> {
+    const u64 at = pos;
+    Box<Expression> expr;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "expr"sv) expr = loadExpression();
+      else skipValue();
+    }
+
+    require(expr.get(), "ReturnStatement"sv, "expr"sv, at);
+    if(not good()) return nullptr;
+    return std::make_unique<ReturnStatement>(std::move(expr));
+  }
+
+  auto AstLoader::loadBlockStatement() noexcept -> Box<Statement> {
+    return loadBlockFields();
+  }
+
+  auto AstLoader::loadIfStatement() noexcept -> Box<Statement> {
+    const u64 at = pos;
+    auto stmt = std::make_unique<IfStatement>();
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "condition"sv) stmt->condition = loadExpression();
+      else if(key == "block"sv) stmt->block = loadBlock();
+      else if(key == "alternative"sv) stmt->alternative = loadStatement();
+      else skipValue();
+    }
+
+    require(stmt->condition.get(), "IfStatement"sv, "condition"sv, at);
+    require(stmt->block.get(), "IfStatement"sv, "block"sv, at);
+    if(not good()) return nullptr;
+    return std::move(stmt);
+  }
+
+  auto AstLoader::loadWhileStatement() noexcept -> Box<Statement> {
+    const u64 at = pos;
+    Box<Expression> condition;
+    Box<BlockStatement> block;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "condition"sv) condition = loadExpression();
+      else if(key == "block"sv) block = loadBlock();
+      else skipValue();
+    }
+
+    require(condition.get(), "WhileStatement"sv, "condition"sv, at);
+    require(block.get(), "WhileStatement"sv, "block"sv, at);
+    if(not good()) return nullptr;
+    return std::make_unique<WhileStatement>(std::move(condition), std::move(block));
+  }
+
+  auto AstLoader::loadForStatement() noexcept -> Box<Statement> {
+    const u64 at = pos;
+    auto stmt = std::make_unique<ForStatement>();
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "initializer"sv) stmt->initializer = loadExpression();
+      else if(key == "condition"sv) stmt->condition = loadExpression();
+      else if(key == "modifier"sv) stmt->modifier = loadExpression();
+      else if(key == "block"sv) stmt->block = loadBlock();
+      else skipValue();
+    }
+
+    require(stmt->initializer.get(), "ForStatement"sv, "initializer"sv, at);
+    require(stmt->condition.get(), "ForStatement"sv, "condition"sv, at);
+    require(stmt->modifier.get(), "ForStatement"sv, "modifier"sv, at);
+    require(stmt->block.get(), "ForStatement"sv, "block"sv, at);
+    if(not good()) return nullptr;
+    return std::move(stmt);
+  }
+
+  auto AstLoader::loadStructStatement() noexcept -> Box<Statement> {
+    const u64 at = pos;
+    auto stmt = std::make_unique<StructStatement>(Symbol{});
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "name"sv) stmt->name = readSymbol();
+      else if(key == "fields"sv) loadMembers(stmt->fields, "Field"sv);
+      else skipValue();
+    }
+
+    if(good() and stmt->name.empty()) errorAt(at, "Missing key \"name\" in StructStatement"s);
+    if(not good()) return nullptr;
+    return std::move(stmt);
+  }
+
+  auto AstLoader::loadEnumStatement() noexcept -> Box<Statement> {
+    const u64 at = pos;
+    auto stmt = std::make_unique<EnumStatement>(Symbol{});
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "name"sv) stmt->name = readSymbol();
+      else if(key == "constants"sv) {
+        expect('[');
+        for(bool first = true; nextElement(first); ) {
+          Symbol constant = readSymbol();
+          if(good()) stmt->add(constant);
+        }
+      } else skipValue();
+    }
+
+    if(good() and stmt->name.empty()) errorAt(at, "Missing key \"name\" in EnumStatement"s);
+    if(not good()) return nullptr;
+    return std::move(stmt);
+  }
+
+  auto AstLoader::loadFunctionStatement() noexcept -> Box<Statement> {
+    const u64 at = pos;
+    auto stmt = std::make_unique<FunctionStatement>(Symbol{});
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "name"sv) stmt->name = readSymbol();
+      else if(key == "args"sv) loadMembers(stmt->args, "Parameter"sv);
+      else if(key == "return_type"sv) stmt->return_type = loadType();
+      else if(key == "block"sv) stmt->block = loadBlock();
+      else skipValue();
+    }
+
+    if(good() and stmt->name.empty()) errorAt(at, "Missing key \"name\" in FunctionStatement"s);
+    require(stmt->return_type.get(), "FunctionStatement"sv, "return_type"sv, at);
+    require(stmt->block.get(), "FunctionStatement"sv, "block"sv, at);
+    if(not good()) return nullptr;
+    return std::move(stmt);
+  }
+
+  auto AstLoader::loadNamespaceStatement() noexcept -> Box<Statement> {
+    const u64 at = pos;
+    Symbol name;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "name"sv) name = readSymbol();
+      else skipValue();
+    }
+
+    if(good() and name.empty()) errorAt(at, "Missing key \"name\" in NamespaceStatement"s);
+    if(not good()) return nullptr;
+    return std::make_unique<NamespaceStatement>(name);
+  }
+
+  auto AstLoader::loadUsingStatement() noexcept -> Box<Statement> {
+    const u64 at = pos;
+    Symbol name;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "identifier"sv) name = readSymbol();
+      else skipValue();
+    }
+
+    if(good() and name.empty()) errorAt(at, "Missing key \"identifier\" in UsingStatement"s);
+    if(not good()) return nullptr;
+    return std::make_unique<UsingStatement>(name);
+  }
+
+  auto AstLoader::loadDeclarationStatement() noexcept -> Box<Statement> {
+    const u64 at = pos;
+    Symbol id;
+    Box<TypeExpression> type;
+    Box<Expression> expr;
+    bool constant = false;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "constant"sv) constant = readBool();
+      else if(key == "identifier"sv) id = readSymbol();
+      else if(key == "datatype"sv) type = loadType();
+      else if(key == "value"sv) {
+        // * A declaration without initializer is written as an empty string
+        if(peek() == '"') readString();
+        else expr = loadExpression();
+      }
+      else skipValue();
+    }
+
+    if(good() and id.empty()) errorAt(at, "Missing key \"identifier\" in DeclarationStatement"s);
+    require(type.get(), "DeclarationStatement"sv, "datatype"sv, at);
+    if(not good()) return nullptr;
+    return std::make_unique<DeclarationStatement>(id, std::move(expr), std::move(type), constant);
+  }
+
+  auto AstLoader::loadIdentifier() noexcept -> Box<Expression> {
+    const u64 at = pos;
+    Symbol id;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "id"sv) id = readSymbol();
+      else skipValue();
+    }
+
+    if(good() and id.empty()) errorAt(at, "Missing key \"id\" in Identifier"s);
+    if(not good()) return nullptr;
+    return std::make_unique<Identifier>(id);
+  }
+
+  auto AstLoader::loadBoolLiteral() noexcept -> Box<Expression> {
+    bool value = false;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "value"sv) value = readBool();
+      else skipValue();
+    }
+
+    if(not good()) return nullptr;
+    return std::make_unique<BoolLiteral>(value);
+  }
+
+  auto AstLoader::loadObjectLiteral() noexcept -> Box<Expression> {
+    const u64 at = pos;
+    Token value = Tokens::NUL;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "value"sv) {
+        const u64 start = pos;
+        std::string_view literal = readString();
+        if(literal == Tokens::NUL.getLiteral()) value = Tokens::NUL;
+        else if(literal == Tokens::THIS.getLiteral()) value = Tokens::THIS;
+        else if(good()) errorAt(start, "Unknown object literal '{}'"f.format(literal));
+      } else skipValue();
+    }
+
+    if(not good()) return nullptr;
+    return std::make_unique<ObjectLiteral>(value);
+  }
+
+  auto AstLoader::loadStringLiteral() noexcept -> Box<Expression> {
+    Box<StringLiteral> literal;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "value"sv) {
+        bool escaped = false;
+        std::string_view value = readString(&escaped);
+        // * Unescaped values reference the registered source, decoded ones are owned
+        literal = escaped ? std::make_unique<StringLiteral>(std::string(value)) : std::make_unique<StringLiteral>(value);
+      } else skipValue();
+    }
+
+    if(not good()) return nullptr;
+    return literal ? std::move(literal) : std::make_unique<StringLiteral>(""sv);
+  }
+
+  auto AstLoader::loadFloatLiteral() noexcept -> Box<Expression> {
+    f64 value = 0;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "value"sv) value = readDouble();
+      else skipValue();
+    }
+
+    if(not good()) return nullptr;
+    return std::make_unique<FloatLiteral>(value);
+  }
+
+  auto AstLoader::loadIntLiteral() noexcept -> Box<Expression> {
+    i64 value = 0;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "value"sv) value = readInteger();
+      else skipValue();
+    }
+
+    if(not good()) return nullptr;
+    return std::make_unique<IntLiteral>(value);
+  }
+
+  auto AstLoader::loadCharLiteral() noexcept -> Box<Expression> {
+    i8 value = '\0';
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "value"sv) {
+        const u64 at = pos;
+        std::string_view literal = readString();
+        if(good() and literal.length() != 1) errorAt(at, "Expected a single character"s);
+        if(good()) value = literal[0];
+      } else skipValue();
+    }
+
+    if(not good()) return nullptr;
+    return std::make_unique<CharLiteral>(value);
+  }
+
+  auto AstLoader::loadArrayLiteral() noexcept -> Box<Expression> {
+    auto array = std::make_unique<ArrayLiteral>();
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "values"sv) loadArguments(*array);
+      else skipValue();
+    }
+
+    if(not good()) return nullptr;
+    return std::move(array);
+  }
+
+  auto AstLoader::loadTypeExpression() noexcept -> Box<Expression> {
+    return loadTypeFields();
+  }
+
+  auto AstLoader::loadPrefixExpression() noexcept -> Box<Expression> {
+    const u64 at = pos;
+    Token::Type oper = Token::Type::ILLEGAL;
+    Box<Expression> expr;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "oper"sv) oper = readOperator();
+      else if(key == "expr"sv) expr = loadExpression();
+      else skipValue();
+    }
+
+    if(good() and oper == Token::Type::ILLEGAL) errorAt(at, "Missing key \"oper\" in PrefixExpression"s);
+    require(expr.get(), "PrefixExpression"sv, "expr"sv, at);
+    if(not good()) return nullptr;
+    return std::make_unique<PrefixExpression>(oper, std::move(expr));
+  }
+
+  auto AstLoader::loadInfixExpression() noexcept -> Box<Expression> {
+    const u64 at = pos;
+    Token::Type oper = Token::Type::ILLEGAL;
+    Box<Expression> lhs;
+    Box<Expression> rhs;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "lhs"sv) lhs = loadExpression();
+      else if(key == "oper"sv) oper = readOperator();
+      else if(key == "rhs"sv) rhs = loadExpression();
+      else skipValue();
+    }
+
+    require(lhs.get(), "InfixExpression"sv, "lhs"sv, at);
+    if(good() and oper == Token::Type::ILLEGAL) errorAt(at, "Missing key \"oper\" in InfixExpression"s);
+    require(rhs.get(), "InfixExpression"sv, "rhs"sv, at);
+    if(not good()) return nullptr;
+    return std::make_unique<InfixExpression>(std::move(lhs), oper, std::move(rhs));
+  }
+
+  auto AstLoader::loadCallExpression() noexcept -> Box<Expression> {
+    const u64 at = pos;
+    Box<Expression> function;
+    Container<Box<Expression>> args;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "function"sv) function = loadExpression();
+      else if(key == "args"sv) loadArguments(args);
+      else skipValue();
+    }
+
+    require(function.get(), "CallExpression"sv, "function"sv, at);
+    if(not good()) return nullptr;
+
+    auto call = std::make_unique<CallExpression>(std::move(function));
+    for(auto& arg : args) call->add(std::move(arg));
+    return std::move(call);
+  }
+
+  auto AstLoader::loadSubscriptExpression() noexcept -> Box<Expression> {
+    const u64 at = pos;
+    Box<Expression> array;
+    Box<Expression> index;
+
+    std::string_view key;
+    while(nextKey(key)) {
+      if(key == "array"sv) array = loadExpression();
+      else if(key == "index"sv) index = loadExpression();
+      else skipValue();
+    }
+
+    require(array.get(), "SubscriptExpression"sv, "array"sv, at);
+    require(index.get(), "SubscriptExpression"sv, "index"sv, at);
+    if(not good()) return nullptr;
+    return std::make_unique<SubscriptExpression>(std::move(array), std::move(index));
+  }
+
+}
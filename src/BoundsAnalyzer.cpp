@@ -0,0 +1,312 @@
+#include "BoundsAnalyzer.hpp"
+#include "SideEffects.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    auto local(Expression const& expr) noexcept -> Identifier const* {
+      auto const* name = dynamic_cast<Identifier const*>(&expr);
+      if(name and (name->binding.kind == Binding::Kind::LOCAL or name->binding.kind == Binding::Kind::PARAMETER)) return name;
+      return nullptr;
+    }
+
+    auto same(Identifier const& variable, Expression const& expr) noexcept -> bool {
+      Identifier const* name = local(expr);
+      return name and name->binding.kind == variable.binding.kind
+        and name->binding.slot == variable.binding.slot
+        and name->binding.declaration == variable.binding.declaration;
+    }
+
+    auto integer(Expression const* expr) noexcept -> std::optional<i64> {
+      if(auto const* literal = dynamic_cast<IntLiteral const*>(expr)) return literal->value.unwrap();
+      auto const* negation = dynamic_cast<PrefixExpression const*>(expr);
+      if(not negation or negation->oper != Token::Type::MINUS) return std::nullopt;
+      auto const* literal = dynamic_cast<IntLiteral const*>(negation->expr.get());
+      if(not literal or literal->value.unwrap() == std::numeric_limits<i64>::min()) return std::nullopt;
+      return -literal->value.unwrap();
+    }
+
+    /// @brief Adds a signed product to an accumulator, failing on overflow
+    auto accumulate(i64& into, i64 factor, i64 value, bool negated) noexcept -> bool {
+      i64 product;
+      if(__builtin_mul_overflow(factor, value, &product)) return false;
+      return negated ? not __builtin_sub_overflow(into, product, &into) : not __builtin_add_overflow(into, product, &into);
+    }
+
+  }
+
+  auto BoundsAnalyzer::analyze(Program& program) -> void {
+    visit(program);
+  }
+
+  auto BoundsAnalyzer::check(SubscriptExpression const& subscript) const noexcept -> BoundsCheck const* {
+    return checks.find(&subscript);
+  }
+
+  auto BoundsAnalyzer::count(BoundsCheck::Kind kind) const noexcept -> u64 {
+    return counts[(u8)kind];
+  }
+
+  auto BoundsAnalyzer::report(std::ostream& out) const -> void {
+    for(SubscriptExpression const* subscript : order) {
+      BoundsCheck const& check = *checks.find(subscript);
+      const Span span = subscript->span;
+      const Location at = Sources::locate(span);
+      std::string_view text = Sources::text(span.file).substr(span.offset, span.length);
+      out << "{}:{}:{}: '{}' "f.format(Sources::path(span.file), at.row, at.col, text);
+
+      switch(check.kind) {
+        case BoundsCheck::Kind::IN_BOUNDS:
+          out << "is in bounds";
+          break;
+        case BoundsCheck::Kind::HOISTED: {
+          const Location loop = Sources::locate(check.loop->span);
+          out << "is checked on entry to the loop at {}:{}"f.format(loop.row, loop.col);
+          break;
+        }
+        case BoundsCheck::Kind::CHECKED:
+          out << "is checked";
+          break;
+      }
+      out << '\n';
+    }
+  }
+
+  auto BoundsAnalyzer::operator()(SubscriptExpression& arg) noexcept -> std::any {
+    Walker::operator()(arg);
+    if(not function) return { };
+
+    BoundsCheck check = classify(arg);
+    ++counts[(u8)check.kind];
+    checks.insert(&arg, std::move(check));
+    order.push_back(&arg);
+    return { };
+  }
+
+  auto BoundsAnalyzer::operator()(WhileStatement& arg) noexcept -> std::any {
+    visit(*arg.condition);
+    enter(arg, *arg.condition, nullptr, nullptr, *arg.block);
+    return { };
+  }
+
+  auto BoundsAnalyzer::operator()(ForStatement& arg) noexcept -> std::any {
+    visit(*arg.initializer);
+    visit(*arg.condition);
+    visit(*arg.modifier);
+    enter(arg, *arg.condition, arg.modifier.get(), arg.initializer.get(), *arg.block);
+    return { };
+  }
+
+  auto BoundsAnalyzer::operator()(FunctionStatement& arg) noexcept -> std::any {
+    function = &arg;
+    loops.clear();
+    visit(*arg.block);
+    function = nullptr;
+    return { };
+  }
+
+  auto BoundsAnalyzer::enter(Statement const& stmt, Expression& condition, Expression* modifier, Expression* initializer, BlockStatement& block) noexcept -> void {
+    Loop loop;
+    loop.statement = &stmt;
+
+    // * A 'while' loop steps its variable in the last statement of its body
+    Expression* step = modifier;
+    u64 body = block.size();
+    if(not step and body) {
+      if(auto* last = dynamic_cast<ExpressionStatement*>(block[body - 1].get())) {
+        step = last->expr.get();
+        --body;
+      }
+    }
+
+    std::vector<bool> others(function->frame_size, false);
+    SideEffects effects(others);
+    effects.visit(condition);
+    for(u64 i = 0; i < body; ++i) effects.visit(*block[i]);
+    loop.variant = others;
+    if(step) SideEffects(loop.variant).visit(*step);
+
+    // * i += c, i -= c, i = i + c, i = c + i and i = i - c with a positive literal c
+    auto* update = dynamic_cast<InfixExpression*>(step);
+    Identifier const* variable = update ? local(*update->lhs) : nullptr;
+    std::optional<i64> amount;
+    bool descending = false;
+    if(variable) {
+      descending = update->oper == Token::Type::MINUS_EQ;
+      if(update->oper == Token::Type::PLUS_EQ or update->oper == Token::Type::MINUS_EQ) amount = integer(update->rhs.get());
+      else if(auto* sum = dynamic_cast<InfixExpression*>(update->rhs.get()); sum and update->oper == Token::Type::ASSIGN) {
+        descending = sum->oper == Token::Type::MINUS;
+        if((sum->oper == Token::Type::PLUS or sum->oper == Token::Type::MINUS) and same(*variable, *sum->lhs)) amount = integer(sum->rhs.get());
+        else if(sum->oper == Token::Type::PLUS and same(*variable, *sum->rhs)) amount = integer(sum->lhs.get());
+      }
+    }
+
+    // * The step must be the only assignment of the variable, and the condition must compare it with an invariant
+    auto* relation = dynamic_cast<InfixExpression*>(&condition);
+    if(amount and *amount > 0 and relation and variable->binding.slot < others.size() and not others[variable->binding.slot]) {
+      Token::Type oper = relation->oper;
+      Expression const* bound = nullptr;
+      if(same(*variable, *relation->lhs)) bound = relation->rhs.get();
+      else if(same(*variable, *relation->rhs)) {
+        bound = relation->lhs.get();
+        switch(oper) {
+          case Token::Type::LESS:       oper = Token::Type::GREATER;    break;
+          case Token::Type::LESS_EQ:    oper = Token::Type::GREATER_EQ; break;
+          case Token::Type::GREATER:    oper = Token::Type::LESS;       break;
+          case Token::Type::GREATER_EQ: oper = Token::Type::LESS_EQ;    break;
+          default: break;
+        }
+      }
+
+      const bool ascending = oper == Token::Type::LESS or oper == Token::Type::LESS_EQ;
+      const bool counting = ascending ? not descending : descending and (oper == Token::Type::GREATER or oper == Token::Type::GREATER_EQ);
+      if(bound and counting and invariant(*bound, loop)) {
+        loop.variable = variable;
+        loop.bound = bound;
+        loop.step = *amount;
+        loop.ascending = ascending;
+        loop.inclusive = oper == Token::Type::LESS_EQ or oper == Token::Type::GREATER_EQ;
+        if(auto* init = dynamic_cast<InfixExpression*>(initializer); init and init->oper == Token::Type::ASSIGN and same(*variable, *init->lhs))
+          loop.first = init->rhs.get();
+      }
+    }
+
+    loops.push_back(std::move(loop));
+    visit(block);
+    loops.pop_back();
+  }
+
+  auto BoundsAnalyzer::classify(SubscriptExpression const& arg) const noexcept -> BoundsCheck {
+    BoundsCheck check;
+    const std::optional<i64> size = length(*arg.array);
+
+    // * The innermost loop the array or the index depends on decides
+    Loop const* home = nullptr;
+    for(u64 i = loops.size(); i-- > 0;) {
+      if(invariant(*arg.array, loops[i]) and invariant(*arg.index, loops[i])) continue;
+      home = &loops[i];
+      break;
+    }
+
+    if(not home) {
+      static const Loop outside { };
+      if(not affine(*arg.index, loops.empty() ? outside : loops.front(), check, false)) return { };
+
+      if(size and check.terms.empty() and within(check, nullptr, *size)) check.kind = BoundsCheck::Kind::IN_BOUNDS;
+      else if(not loops.empty()) {
+        check.kind = BoundsCheck::Kind::HOISTED;
+        check.loop = loops.front().statement;
+      }
+      return check;
+    }
+
+    if(not home->variable or not invariant(*arg.array, *home)) return { };
+    if(not affine(*arg.index, *home, check, false) or check.scale == 0) return { };
+
+    check.loop = home->statement;
+    check.variable = home->variable;
+    check.bound = home->bound;
+    check.step = home->step;
+    check.ascending = home->ascending;
+    check.inclusive = home->inclusive;
+    check.kind = size and check.terms.empty() and within(check, home, *size) ? BoundsCheck::Kind::IN_BOUNDS : BoundsCheck::Kind::HOISTED;
+    return check;
+  }
+
+  auto BoundsAnalyzer::invariant(Expression const& expr, Loop const& loop) const noexcept -> bool {
+    if(dynamic_cast<IntLiteral const*>(&expr) or dynamic_cast<StringLiteral const*>(&expr)) return true;
+
+    if(auto const* name = dynamic_cast<Identifier const*>(&expr)) {
+      if(name->binding.kind != Binding::Kind::LOCAL and name->binding.kind != Binding::Kind::PARAMETER) return false;
+      return name->binding.slot >= loop.variant.size() or not loop.variant[name->binding.slot];
+    }
+
+    if(auto const* prefix = dynamic_cast<PrefixExpression const*>(&expr))
+      return prefix->oper == Token::Type::MINUS and invariant(*prefix->expr, loop);
+
+    // * Only operators that cannot fail, so the check can compute them early
+    if(auto const* infix = dynamic_cast<InfixExpression const*>(&expr)) {
+      if(infix->oper != Token::Type::PLUS and infix->oper != Token::Type::MINUS and infix->oper != Token::Type::STAR) return false;
+      return invariant(*infix->lhs, loop) and invariant(*infix->rhs, loop);
+    }
+
+    return false;
+  }
+
+  auto BoundsAnalyzer::affine(Expression const& expr, Loop const& loop, BoundsCheck& into, bool negated) const noexcept -> bool {
+    if(std::optional<i64> value = integer(&expr)) return accumulate(into.offset, 1, *value, negated);
+    if(loop.variable and same(*loop.variable, expr)) return accumulate(into.scale, 1, 1, negated);
+
+    auto const* infix = dynamic_cast<InfixExpression const*>(&expr);
+    if(infix and (infix->oper == Token::Type::PLUS or infix->oper == Token::Type::MINUS)) {
+      BoundsCheck sum = into;
+      if(affine(*infix->lhs, loop, sum, negated) and affine(*infix->rhs, loop, sum, negated != (infix->oper == Token::Type::MINUS))) {
+        into = std::move(sum);
+        return true;
+      }
+    }
+
+    // * A literal factor scales the variable and the offset, terms only keep their sign
+    if(infix and infix->oper == Token::Type::STAR) {
+      std::optional<i64> factor = integer(infix->lhs.get());
+      Expression const* other = infix->rhs.get();
+      if(not factor) {
+        factor = integer(infix->rhs.get());
+        other = infix->lhs.get();
+      }
+
+      BoundsCheck product;
+      if(factor and affine(*other, loop, product, false) and (product.terms.empty() or *factor == 1 or *factor == -1)) {
+        BoundsCheck sum = into;
+        bool fits = accumulate(sum.scale, *factor, product.scale, negated) and accumulate(sum.offset, *factor, product.offset, negated);
+        for(auto term : product.terms) sum.terms.push_back({ term.expr, term.negated != negated != (*factor < 0) });
+        if(fits) {
+          into = std::move(sum);
+          return true;
+        }
+      }
+    }
+
+    if(not invariant(expr, loop)) return false;
+    into.terms.push_back({ &expr, negated });
+    return true;
+  }
+
+  auto BoundsAnalyzer::length(Expression const& array) const noexcept -> std::optional<i64> {
+    Expression const* value = &array;
+    if(Identifier const* name = local(array); name and name->binding.kind == Binding::Kind::LOCAL) {
+      auto const* declaration = static_cast<DeclarationStatement const*>(name->binding.declaration);
+      if(not declaration->constant or not declaration->expr) return std::nullopt;
+      value = declaration->expr.get();
+    }
+
+    if(auto const* text = dynamic_cast<StringLiteral const*>(value)) return (i64)text->value.size();
+    if(auto const* elements = dynamic_cast<ArrayLiteral const*>(value)) return (i64)elements->size();
+    return std::nullopt;
+  }
+
+  auto BoundsAnalyzer::within(BoundsCheck const& check, Loop const* loop, i64 length) const noexcept -> bool {
+    if(not loop) return check.offset >= 0 and check.offset < length;
+
+    // * The variable ranges from its first value to the last one before the bound
+    std::optional<i64> first = integer(loop->first);
+    std::optional<i64> bound = integer(loop->bound);
+    if(not first or not bound) return false;
+
+    const i64 margin = loop->inclusive ? 0 : 1;
+    i64 low = *first, high = *first, next;
+    if(loop->ascending) {
+      if(__builtin_sub_overflow(*bound, margin, &high) or __builtin_add_overflow(high, loop->step, &next)) return false;
+    } else if(__builtin_add_overflow(*bound, margin, &low) or __builtin_sub_overflow(low, loop->step, &next)) return false;
+
+    // * A loop that never runs never subscripts
+    if(low > high) return true;
+
+    i64 lowest = check.offset, highest = check.offset;
+    if(not accumulate(lowest, check.scale, low, false) or not accumulate(highest, check.scale, high, false)) return false;
+    if(lowest > highest) std::swap(lowest, highest);
+    return lowest >= 0 and highest < length;
+  }
+
+}
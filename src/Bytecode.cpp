@@ -0,0 +1,55 @@
+#include "ModuleFile.hpp"
+
+namespace fridayc::bytecode {
+
+  namespace {
+
+    constexpr std::array<std::string_view, (u64)Opcode::COUNT> NAMES = {
+      "MOVE"sv, "MOVE_REF"sv, "CONSTANT"sv, "CLEAR"sv,
+      "ADD"sv, "SUB"sv, "MUL"sv, "DIV"sv, "MOD"sv, "BIT_AND"sv, "BIT_OR"sv, "SHL"sv, "SHR"sv,
+      "NEG"sv, "BIT_NOT"sv, "ADD_IMM"sv,
+      "FADD"sv, "FSUB"sv, "FMUL"sv, "FDIV"sv, "FNEG"sv,
+      "EQ"sv, "NE"sv, "LT"sv, "LE"sv, "FEQ"sv, "FNE"sv, "FLT"sv, "FLE"sv, "REQ"sv, "RNE"sv, "SEQ"sv, "SNE"sv,
+      "NOT"sv, "CONCAT"sv,
+      "NEW"sv, "GET_FIELD"sv, "GET_FIELD_REF"sv, "SET_FIELD"sv, "SET_FIELD_REF"sv,
+      "GET_ELEM"sv, "GET_ELEM_REF"sv, "SET_ELEM"sv, "SET_ELEM_REF"sv, "GET_CHAR"sv,
+      "JUMP"sv, "JUMP_IF"sv, "JUMP_IF_NOT"sv, "JEQ"sv, "JNE"sv, "JLT"sv, "JLE"sv,
+      "INC_JLT"sv,
+      "CALL"sv,
+      "RETURN"sv, "RETURN_REF"sv, "RETURN_VOID"sv, "FALL_OFF"sv,
+      "PRINT"sv,
+    };
+
+  }
+
+  auto nameOf(Opcode op) noexcept -> std::string_view {
+    return op < Opcode::COUNT ? NAMES[(u64)op] : "?"sv;
+  }
+
+  auto Module::materialize(u32 index) -> Function const& {
+    Function& function = functions[index];
+    if(function.code.empty() and file) file->decode(index, function);
+    return function;
+  }
+
+  auto Module::disassemble(std::ostream& out) const -> void {
+    for(u64 index = 0; index < functions.size(); ++index) {
+      Function const& function = functions[index];
+      out << "fn {} #{}: {} parameters, constants from r{}, temporaries from r{}, {} registers\n"f.format(
+        function.name, index, function.parameters, function.constant_base, function.temporaries, function.registers);
+
+      for(u64 k = 0; k < function.constants.size(); ++k)
+        out << "  r{} = {}\n"f.format(function.constant_base + k, function.constants[k]);
+
+      for(u64 at = 0; at < function.code.size(); ++at) {
+        Instruction const& instruction = function.code[at];
+        out << "  {:>5}  {:<14}{} {} {}\n"f.format(at, nameOf(instruction.op), instruction.a, instruction.b,
+          instruction.op == Opcode::ADD_IMM ? (i64)(i16)instruction.c : (i64)instruction.c);
+      }
+    }
+
+    for(u64 k = 0; k < constants.size(); ++k)
+      out << "string #{} = \"{}\"\n"f.format(k, static_cast<runtime::Text const&>(*constants[k]).value.view());
+  }
+
+}
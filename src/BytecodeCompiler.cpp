@@ -0,0 +1,659 @@
+#include "BytecodeCompiler.hpp"
+#include "SideEffects.hpp"
+#include "Analyzer.hpp"
+
+namespace fridayc {
+
+  using bytecode::Opcode;
+
+  namespace {
+
+    /// @brief Largest register, function and field number an operand holds
+    constexpr u32 OPERAND_LIMIT = std::numeric_limits<u16>::max();
+
+    /// @brief Collects the scalar constants of a function, each once, in order of appearance
+    struct Literals : public Walker {
+      FlatMap<i64, BytecodeCompiler::Register>& registers;
+      std::vector<i64>&                         bits;
+      u32                                       base;
+
+      Literals(FlatMap<i64, BytecodeCompiler::Register>& registers, std::vector<i64>& bits, u32 base) noexcept
+        : registers { registers }
+        , bits { bits }
+        , base { base }
+      {}
+
+      using Walker::operator();
+
+      auto add(i64 value) -> void {
+        if(registers.insert(value, (BytecodeCompiler::Register)(base + bits.size())).second) bits.push_back(value);
+      }
+
+      auto operator()(Identifier& arg) noexcept -> std::any override {
+        if(arg.binding.kind == Binding::Kind::CONSTANT) add(arg.binding.slot);
+        return { };
+      }
+
+      auto operator()(BoolLiteral& arg) noexcept -> std::any override {
+        add(arg.value.unwrap());
+        return { };
+      }
+
+      auto operator()(FloatLiteral& arg) noexcept -> std::any override {
+        add(std::bit_cast<i64>(arg.value.unwrap()));
+        return { };
+      }
+
+      auto operator()(IntLiteral& arg) noexcept -> std::any override {
+        add(arg.value.unwrap());
+        return { };
+      }
+
+      auto operator()(CharLiteral& arg) noexcept -> std::any override {
+        add(arg.value.unwrap());
+        return { };
+      }
+    };
+
+    /// @brief Fused branch on ints, and whether its operands are swapped, for a comparison taken when 'when'
+    auto fused(Token::Type oper, bool when) noexcept -> std::optional<std::pair<Opcode, bool>> {
+      switch(oper) {
+        case Token::Type::LESS: return when ? std::pair{ Opcode::JLT, false } : std::pair{ Opcode::JLE, true };
+        case Token::Type::LESS_EQ: return when ? std::pair{ Opcode::JLE, false } : std::pair{ Opcode::JLT, true };
+        case Token::Type::GREATER: return when ? std::pair{ Opcode::JLT, true } : std::pair{ Opcode::JLE, false };
+        case Token::Type::GREATER_EQ: return when ? std::pair{ Opcode::JLE, true } : std::pair{ Opcode::JLT, false };
+        case Token::Type::EQUALS: return std::pair{ when ? Opcode::JEQ : Opcode::JNE, false };
+        case Token::Type::NOT_EQ: return std::pair{ when ? Opcode::JNE : Opcode::JEQ, false };
+        default: return std::nullopt;
+      }
+    }
+
+    /// @brief Comparison computing a value, on ints or on floats
+    auto ordered(Token::Type oper, bool floats) noexcept -> std::optional<std::pair<Opcode, bool>> {
+      const Opcode less = floats ? Opcode::FLT : Opcode::LT;
+      const Opcode less_equal = floats ? Opcode::FLE : Opcode::LE;
+      switch(oper) {
+        case Token::Type::LESS: return std::pair{ less, false };
+        case Token::Type::LESS_EQ: return std::pair{ less_equal, false };
+        case Token::Type::GREATER: return std::pair{ less, true };
+        case Token::Type::GREATER_EQ: return std::pair{ less_equal, true };
+        case Token::Type::EQUALS: return std::pair{ floats ? Opcode::FEQ : Opcode::EQ, false };
+        case Token::Type::NOT_EQ: return std::pair{ floats ? Opcode::FNE : Opcode::NE, false };
+        default: return std::nullopt;
+      }
+    }
+
+  }
+
+  BytecodeCompiler::BytecodeCompiler(Analyzer const& analyzer, TypeTable const& table) noexcept
+    : analyzer { analyzer }
+    , table { table }
+  {}
+
+  auto BytecodeCompiler::compile(Program& program) -> std::vector<Error> {
+    errors.clear();
+    compiled = { };
+    compiled.printer = std::make_unique<runtime::Printer>(analyzer, table);
+    indices.clear();
+    strings.clear();
+    formats.clear();
+
+    FunctionStatement* entry = nullptr;
+    for(auto& stmt : *program.block)
+      if(auto* declaration = dynamic_cast<FunctionStatement*>(stmt.get()); declaration and declaration->name.view() == "main"sv)
+        entry = declaration;
+
+    if(not entry) {
+      errors.emplace_back("No 'main' function to run"s, Span{ });
+      return std::move(errors);
+    }
+    if(not entry->args.empty()) {
+      errors.emplace_back("'main' cannot take parameters"s, entry->span);
+      return std::move(errors);
+    }
+
+    compiled.returns_int = analyzer.typeOf(*entry->return_type) == TypeId::INT;
+    index(*entry);
+
+    // * Functions are compiled one at a time, each call queues the callees seen for the first time
+    while(not pending.empty()) {
+      FunctionStatement* declaration = pending.back();
+      pending.pop_back();
+      build(*declaration, *indices.find(declaration));
+    }
+    return std::move(errors);
+  }
+
+  auto BytecodeCompiler::module() noexcept -> bytecode::Module& {
+    return compiled;
+  }
+
+  auto BytecodeCompiler::operator()(Identifier& arg) noexcept -> std::any {
+    switch(arg.binding.kind) {
+      case Binding::Kind::LOCAL:
+      case Binding::Kind::PARAMETER: return (Register)arg.binding.slot;
+      case Binding::Kind::CONSTANT: return constant(arg.binding.slot, arg.span);
+      default: return unsupported(arg.span, "'{}' is not a value"f.format(arg.id));
+    }
+  }
+
+  auto BytecodeCompiler::operator()(BoolLiteral& arg) noexcept -> std::any {
+    return constant(arg.value.unwrap(), arg.span);
+  }
+
+  auto BytecodeCompiler::operator()(ObjectLiteral& arg) noexcept -> std::any {
+    if(arg.value.getType() != Token::Type::NUL)
+      return unsupported(arg.span, "Cannot use '{}' outside of a method"f.format(arg.value.getLiteral()));
+
+    const Register target = temporary();
+    emit(Opcode::CLEAR, target, 0, 0, arg.span);
+    return target;
+  }
+
+  auto BytecodeCompiler::operator()(StringLiteral& arg) noexcept -> std::any {
+    // * Strings never change, every evaluation shares the constant
+    auto [index, added] = strings.insert(arg.value, (u16)compiled.constants.size());
+    if(added) {
+      if(compiled.constants.size() > OPERAND_LIMIT) errors.emplace_back("Too many strings for the bytecode"s, arg.span);
+      compiled.constants.push_back(std::make_shared<runtime::Text>(runtime::String::intern(arg.value)));
+    }
+
+    const Register target = temporary();
+    emit(Opcode::CONSTANT, target, *index, 0, arg.span);
+    return target;
+  }
+
+  auto BytecodeCompiler::operator()(FloatLiteral& arg) noexcept -> std::any {
+    return constant(std::bit_cast<i64>(arg.value.unwrap()), arg.span);
+  }
+
+  auto BytecodeCompiler::operator()(IntLiteral& arg) noexcept -> std::any {
+    return constant(arg.value.unwrap(), arg.span);
+  }
+
+  auto BytecodeCompiler::operator()(CharLiteral& arg) noexcept -> std::any {
+    return constant(arg.value.unwrap(), arg.span);
+  }
+
+  auto BytecodeCompiler::operator()(PrefixExpression& arg) noexcept -> std::any {
+    if(arg.oper == Token::Type::PLUS) return expression(*arg.expr);
+
+    const u32 mark = next;
+    const Register value = expression(*arg.expr);
+    next = mark;
+    const Register target = temporary();
+
+    switch(arg.oper) {
+      case Token::Type::MINUS:
+        emit(typeOf(arg) == TypeId::FLOAT ? Opcode::FNEG : Opcode::NEG, target, value, 0, arg.span);
+        break;
+      case Token::Type::NOT:
+        emit(Opcode::NOT, target, value, 0, arg.span);
+        break;
+      case Token::Type::BIT_NOT:
+        emit(Opcode::BIT_NOT, target, value, 0, arg.span);
+        break;
+      default:
+        return unsupported(arg.span, "Cannot run this operator"s);
+    }
+    return target;
+  }
+
+  auto BytecodeCompiler::operator()(InfixExpression& arg) noexcept -> std::any {
+    if(arg.oper == Token::Type::DOT) return member(arg);
+    if(arg.oper == Token::Type::ASSIGN or Token::compoundOperatorOf(arg.oper) != Token::Type::ILLEGAL) return assign(arg);
+    return binary(arg);
+  }
+
+  auto BytecodeCompiler::operator()(CallExpression& arg) noexcept -> std::any {
+    Identifier const* name = arg.callee();
+    if(name and name->binding.kind == Binding::Kind::FUNCTION)
+      return call(arg, *static_cast<FunctionStatement*>(name->binding.declaration));
+    if(name and name->binding.kind == Binding::Kind::STRUCT)
+      return construct(arg, arg.span);
+    return unsupported(arg.function->span, "Only functions and structs can be called"s);
+  }
+
+  auto BytecodeCompiler::operator()(SubscriptExpression& arg) noexcept -> std::any {
+    const u32 mark = next;
+    const TypeId type = typeOf(*arg.array);
+    const Register array = stable(expression(*arg.array), type, *arg.index);
+    const Register index = expression(*arg.index);
+    next = mark;
+
+    const Register target = temporary();
+    const Opcode op = type == TypeId::STRING ? Opcode::GET_CHAR : reference(typeOf(arg)) ? Opcode::GET_ELEM_REF : Opcode::GET_ELEM;
+    emit(op, target, array, index, arg.span);
+    return target;
+  }
+
+  auto BytecodeCompiler::operator()(ArrayLiteral& arg) noexcept -> std::any {
+    return construct(arg, arg.span);
+  }
+
+  auto BytecodeCompiler::operator()(ExpressionStatement& arg) noexcept -> std::any {
+    expression(*arg.expr);
+    return { };
+  }
+
+  auto BytecodeCompiler::operator()(ReturnStatement& arg) noexcept -> std::any {
+    const TypeId type = typeOf(*arg.expr);
+    const Register value = expression(*arg.expr);
+    if(type == TypeId::VOID) emit(Opcode::RETURN_VOID, 0, 0, 0, arg.span);
+    else emit(reference(type) ? Opcode::RETURN_REF : Opcode::RETURN, value, 0, 0, arg.span);
+    return { };
+  }
+
+  auto BytecodeCompiler::operator()(PrintStatement& arg) noexcept -> std::any {
+    const TypeId type = typeOf(*arg.expr);
+    const Register value = expression(*arg.expr);
+    if(type == TypeId::VOID) return { };
+
+    auto [format, added] = formats.insert(type, (u16)compiled.formats.size());
+    if(added) {
+      const u32 shape = compiled.printer->shapeOf(type);
+      compiled.shapes.push_back(shape);
+      compiled.formats.push_back(&compiled.printer->formatOf(shape));
+    }
+    emit(Opcode::PRINT, value, *format, 0, arg.span);
+    return { };
+  }
+
+  auto BytecodeCompiler::operator()(BlockStatement& arg) noexcept -> std::any {
+    for(auto& stmt : arg) statement(*stmt);
+    return { };
+  }
+
+  auto BytecodeCompiler::operator()(IfStatement& arg) noexcept -> std::any {
+    const std::vector<u32> otherwise = branch(*arg.condition, false);
+    statement(*arg.block);
+    if(not arg.alternative) {
+      land(otherwise);
+      return { };
+    }
+
+    const u32 skip = emit(Opcode::JUMP, 0, 0, 0, arg.span);
+    land(otherwise);
+    statement(*arg.alternative);
+    land({ skip });
+    return { };
+  }
+
+  auto BytecodeCompiler::operator()(WhileStatement& arg) noexcept -> std::any {
+    // * The condition is tested before the first iteration and after every one, so each iteration takes a single branch
+    const std::vector<u32> exits = branch(*arg.condition, false);
+    const u32 body = (u32)function->code.size();
+    statement(*arg.block);
+    patch(branch(*arg.condition, true), body);
+    land(exits);
+    return { };
+  }
+
+  auto BytecodeCompiler::operator()(ForStatement& arg) noexcept -> std::any {
+    const u32 mark = next;
+    expression(*arg.initializer);
+    next = mark;
+    const std::vector<u32> exits = branch(*arg.condition, false);
+    const u32 body = (u32)function->code.size();
+    statement(*arg.block);
+    expression(*arg.modifier);
+    next = mark;
+    patch(branch(*arg.condition, true), body);
+    land(exits);
+    return { };
+  }
+
+  auto BytecodeCompiler::operator()(DeclarationStatement& arg) noexcept -> std::any {
+    if(reference(analyzer.typeOf(arg))) function->references = true;
+    if(not arg.expr) emit(Opcode::CLEAR, arg.slot, 0, 0, arg.span);
+    else into(*arg.expr, arg.slot);
+    return { };
+  }
+
+  auto BytecodeCompiler::index(FunctionStatement& declaration) -> u16 {
+    auto [index, added] = indices.insert(&declaration, (u16)compiled.functions.size());
+    if(added) {
+      if(compiled.functions.size() > OPERAND_LIMIT) errors.emplace_back("Too many functions for the bytecode"s, declaration.span);
+      compiled.functions.emplace_back();
+      pending.push_back(&declaration);
+    }
+    return *index;
+  }
+
+  auto BytecodeCompiler::build(FunctionStatement& declaration, u16 index) -> void {
+    bytecode::Function built { .name = declaration.name, .span = declaration.span };
+    function = &built;
+    frame = std::max<u32>(declaration.frame_size, (u32)declaration.args.size());
+    built.parameters = (u16)declaration.args.size();
+    for(Member const& parameter : declaration.args)
+      if(reference(analyzer.typeOf(*parameter.type))) built.references = true;
+
+    constants.clear();
+    Literals literals(constants, built.constants, frame);
+    literals.visit(*declaration.block);
+
+    built.constant_base = (u16)frame;
+    next = frame + (u32)built.constants.size();
+    built.temporaries = (u16)next;
+    peak = next;
+    statement(*declaration.block);
+
+    const bool returns = analyzer.typeOf(*declaration.return_type) != TypeId::VOID;
+    emit(returns ? Opcode::FALL_OFF : Opcode::RETURN_VOID, 0, 0, 0, declaration.span);
+
+    if(peak > OPERAND_LIMIT)
+      errors.emplace_back("'{}' has too many locals and temporaries for the bytecode"f.format(declaration.name), declaration.span);
+
+    // * Jumps name their target in a 16-bit operand
+    if(built.code.size() > OPERAND_LIMIT)
+      errors.emplace_back("'{}' is too large for the bytecode"f.format(declaration.name), declaration.span);
+    built.registers = (u16)std::min(peak, OPERAND_LIMIT);
+
+    function = nullptr;
+    compiled.functions[index] = std::move(built);
+  }
+
+  auto BytecodeCompiler::expression(Expression& expr) noexcept -> Register {
+    if(reference(typeOf(expr))) function->references = true;
+
+    std::any result = visit(expr);
+    if(auto* value = std::any_cast<Register>(&result)) return *value;
+    return unsupported(expr.span, "Cannot run this expression"s);
+  }
+
+  auto BytecodeCompiler::statement(Statement& stmt) noexcept -> void {
+    const u32 mark = next;
+    visit(stmt);
+    next = mark;
+  }
+
+  auto BytecodeCompiler::unsupported(Span span, std::string message) noexcept -> Register {
+    errors.emplace_back(std::move(message), span);
+    return 0;
+  }
+
+  auto BytecodeCompiler::typeOf(Expression const& expr) const noexcept -> TypeId {
+    return analyzer.typeOf(expr);
+  }
+
+  auto BytecodeCompiler::reference(TypeId type) const noexcept -> bool {
+    switch(table.info(type).kind) {
+      case TypeInfo::Kind::STRING:
+      case TypeInfo::Kind::NUL:
+      case TypeInfo::Kind::STRUCT:
+      case TypeInfo::Kind::ARRAY: return true;
+      default: return false;
+    }
+  }
+
+  auto BytecodeCompiler::emit(Opcode op, u32 a, u32 b, u32 c, Span span) -> u32 {
+    function->code.push_back({ op, (u16)a, (u16)b, (u16)c });
+    function->spans.push_back(span);
+    return (u32)function->code.size() - 1;
+  }
+
+  auto BytecodeCompiler::land(std::vector<u32> const& jumps) noexcept -> void {
+    patch(jumps, (u32)function->code.size());
+  }
+
+  auto BytecodeCompiler::patch(std::vector<u32> const& jumps, u32 target) noexcept -> void {
+    for(u32 jump : jumps) function->code[jump].c = (u16)target;
+  }
+
+  auto BytecodeCompiler::temporary() noexcept -> Register {
+    peak = std::max(peak, next + 1);
+    return (Register)next++;
+  }
+
+  auto BytecodeCompiler::constant(i64 bits, Span span) noexcept -> Register {
+    if(Register const* known = constants.find(bits)) return *known;
+    return unsupported(span, "Cannot run this expression"s);
+  }
+
+  auto BytecodeCompiler::move(TypeId type) const noexcept -> Opcode {
+    return reference(type) ? Opcode::MOVE_REF : Opcode::MOVE;
+  }
+
+  auto BytecodeCompiler::into(Expression& expr, Register target) noexcept -> void {
+    const u32 mark = next;
+    const TypeId type = typeOf(expr);
+    const Register value = expression(expr);
+    next = mark;
+    if(type != TypeId::VOID and value != target) emit(move(type), target, value, 0, expr.span);
+  }
+
+  auto BytecodeCompiler::stable(Register value, TypeId type, Expression& later) noexcept -> Register {
+    if(value >= frame) return value;
+
+    std::vector<bool> assigned(frame, false);
+    SideEffects effects(assigned);
+    effects.visit(later);
+    if(not assigned[value]) return value;
+
+    const Register copy = temporary();
+    emit(move(type), copy, value, 0, later.span);
+    return copy;
+  }
+
+  auto BytecodeCompiler::branch(Expression& condition, bool when) noexcept -> std::vector<u32> {
+    if(auto* prefix = dynamic_cast<PrefixExpression*>(&condition); prefix and prefix->oper == Token::Type::NOT)
+      return branch(*prefix->expr, not when);
+
+    if(auto* infix = dynamic_cast<InfixExpression*>(&condition)) {
+      if(infix->oper == Token::Type::AND or infix->oper == Token::Type::OR) {
+        // * 'a and b' is false as soon as a is, 'a or b' is true as soon as a is
+        const bool conjunction = infix->oper == Token::Type::AND;
+        if(conjunction != when) {
+          std::vector<u32> jumps = branch(*infix->lhs, when);
+          std::ranges::copy(branch(*infix->rhs, when), std::back_inserter(jumps));
+          return jumps;
+        }
+
+        const std::vector<u32> shortcut = branch(*infix->lhs, not when);
+        std::vector<u32> jumps = branch(*infix->rhs, when);
+        land(shortcut);
+        return jumps;
+      }
+
+      const TypeInfo::Kind kind = table.info(typeOf(*infix->lhs)).kind;
+      const bool integral = kind == TypeInfo::Kind::INT or kind == TypeInfo::Kind::ENUM or kind == TypeInfo::Kind::CHAR or kind == TypeInfo::Kind::BOOL;
+      if(auto jump = fused(infix->oper, when); jump and integral) {
+        const u32 mark = next;
+        const Register lhs = stable(expression(*infix->lhs), typeOf(*infix->lhs), *infix->rhs);
+        const Register rhs = expression(*infix->rhs);
+        next = mark;
+
+        auto [op, swapped] = *jump;
+        return { emit(op, swapped ? rhs : lhs, swapped ? lhs : rhs, 0, infix->span) };
+      }
+    }
+
+    const u32 mark = next;
+    const Register value = expression(condition);
+    next = mark;
+    return { emit(when ? Opcode::JUMP_IF : Opcode::JUMP_IF_NOT, value, 0, 0, condition.span) };
+  }
+
+  auto BytecodeCompiler::operation(Token::Type oper, TypeId lhs, TypeId rhs) const noexcept -> std::optional<std::pair<Opcode, bool>> {
+    // * Strings are equal by value, other references by identity
+    if(reference(lhs) and (oper == Token::Type::EQUALS or oper == Token::Type::NOT_EQ)) {
+      const bool strings = lhs == TypeId::STRING or rhs == TypeId::STRING;
+      const bool equals = oper == Token::Type::EQUALS;
+      return std::pair{ strings ? (equals ? Opcode::SEQ : Opcode::SNE) : (equals ? Opcode::REQ : Opcode::RNE), false };
+    }
+
+    switch(table.info(lhs).kind) {
+      case TypeInfo::Kind::INT:
+      case TypeInfo::Kind::ENUM:
+        switch(oper) {
+          case Token::Type::PLUS: return std::pair{ Opcode::ADD, false };
+          case Token::Type::MINUS: return std::pair{ Opcode::SUB, false };
+          case Token::Type::STAR: return std::pair{ Opcode::MUL, false };
+          case Token::Type::SLASH: return std::pair{ Opcode::DIV, false };
+          case Token::Type::MODULO: return std::pair{ Opcode::MOD, false };
+          case Token::Type::BIT_AND: return std::pair{ Opcode::BIT_AND, false };
+          case Token::Type::BIT_OR: return std::pair{ Opcode::BIT_OR, false };
+          case Token::Type::LSHIFT: return std::pair{ Opcode::SHL, false };
+          case Token::Type::RSHIFT: return std::pair{ Opcode::SHR, false };
+          default: return ordered(oper, false);
+        }
+      case TypeInfo::Kind::FLOAT:
+        switch(oper) {
+          case Token::Type::PLUS: return std::pair{ Opcode::FADD, false };
+          case Token::Type::MINUS: return std::pair{ Opcode::FSUB, false };
+          case Token::Type::STAR: return std::pair{ Opcode::FMUL, false };
+          case Token::Type::SLASH: return std::pair{ Opcode::FDIV, false };
+          default: return ordered(oper, true);
+        }
+      case TypeInfo::Kind::STRING:
+        if(oper != Token::Type::PLUS) return std::nullopt;
+        return std::pair{ Opcode::CONCAT, false };
+      case TypeInfo::Kind::BOOL:
+        if(oper != Token::Type::EQUALS and oper != Token::Type::NOT_EQ) return std::nullopt;
+        return ordered(oper, false);
+      case TypeInfo::Kind::CHAR:
+        return ordered(oper, false);
+      default:
+        return std::nullopt;
+    }
+  }
+
+  auto BytecodeCompiler::call(CallExpression& arg, FunctionStatement& callee) noexcept -> Register {
+    const u16 target = index(callee);
+
+    // * Arguments go to the topmost registers, in the order of the parameters of the callee frame starting there
+    const u32 mark = next;
+    const u32 window = std::max<u32>(arg.size(), 1);
+    for(u32 i = 0; i < window; ++i) temporary();
+    for(u32 i = 0; i < arg.size(); ++i) into(*arg[i], mark + i);
+
+    next = mark;
+    const Register result = temporary();
+    emit(Opcode::CALL, result, target, mark, arg.span);
+    return result;
+  }
+
+  auto BytecodeCompiler::construct(Container<Box<Expression>>& values, Span span) noexcept -> Register {
+    if(values.size() > OPERAND_LIMIT) return unsupported(span, "Too many values for the bytecode"s);
+
+    const Register object = temporary();
+    emit(Opcode::NEW, object, (u32)values.size(), 0, span);
+    for(u32 i = 0; i < values.size(); ++i) {
+      const u32 mark = next;
+      const TypeId type = typeOf(*values[i]);
+      const Register value = expression(*values[i]);
+      next = mark;
+      if(type != TypeId::VOID) emit(reference(type) ? Opcode::SET_FIELD_REF : Opcode::SET_FIELD, object, i, value, values[i]->span);
+    }
+    return object;
+  }
+
+  auto BytecodeCompiler::member(InfixExpression& arg) noexcept -> Register {
+    auto* object = dynamic_cast<Identifier*>(arg.lhs.get());
+    auto* name = dynamic_cast<Identifier*>(arg.rhs.get());
+    if(not name) return unsupported(arg.span, "Cannot run this expression"s);
+
+    // * Enum constants and namespace members are resolved already, only fields are read at run time
+    if(object and (object->binding.kind == Binding::Kind::ENUM or object->binding.kind == Binding::Kind::NAMESPACE))
+      return expression(*name);
+
+    const u32 mark = next;
+    const Register structure = expression(*arg.lhs);
+    next = mark;
+
+    const Register target = temporary();
+    emit(reference(typeOf(arg)) ? Opcode::GET_FIELD_REF : Opcode::GET_FIELD, target, structure, name->binding.slot, arg.lhs->span);
+    return target;
+  }
+
+  auto BytecodeCompiler::binary(InfixExpression& arg) noexcept -> Register {
+    const TypeId lhs = typeOf(*arg.lhs);
+    const TypeId rhs = typeOf(*arg.rhs);
+
+    if(arg.oper == Token::Type::AND or arg.oper == Token::Type::OR) {
+      const Register target = temporary();
+      into(*arg.lhs, target);
+      const u32 shortcut = emit(arg.oper == Token::Type::AND ? Opcode::JUMP_IF_NOT : Opcode::JUMP_IF, target, 0, 0, arg.span);
+      into(*arg.rhs, target);
+      land({ shortcut });
+      return target;
+    }
+
+    const std::optional<std::pair<Opcode, bool>> op = operation(arg.oper, lhs, rhs);
+    if(not op) return unsupported(arg.span, "Cannot run this operator"s);
+
+    const u32 mark = next;
+    const Register left = stable(expression(*arg.lhs), lhs, *arg.rhs);
+    const Register right = expression(*arg.rhs);
+    next = mark;
+
+    const Register target = temporary();
+    auto [opcode, swapped] = *op;
+    emit(opcode, target, swapped ? right : left, swapped ? left : right, arg.span);
+    return target;
+  }
+
+  auto BytecodeCompiler::assign(InfixExpression& arg) noexcept -> Register {
+    if(auto* subscript = dynamic_cast<SubscriptExpression*>(arg.lhs.get()); subscript and typeOf(*subscript->array) == TypeId::STRING)
+      return unsupported(arg.lhs->span, "Characters of a string cannot be assigned"s);
+
+    const TypeId type = typeOf(*arg.lhs);
+    const Token::Type oper = Token::compoundOperatorOf(arg.oper);
+    std::optional<std::pair<Opcode, bool>> op;
+    if(oper != Token::Type::ILLEGAL) {
+      op = operation(oper, type, typeOf(*arg.rhs));
+      if(not op) return unsupported(arg.span, "Cannot run this assignment"s);
+    }
+
+    if(auto* name = dynamic_cast<Identifier*>(arg.lhs.get())) {
+      const Register slot = name->binding.slot;
+      if(not op) into(*arg.rhs, slot);
+      else {
+        const u32 mark = next;
+        const Register value = expression(*arg.rhs);
+        next = mark;
+        emit(op->first, slot, slot, value, arg.span);
+      }
+      return slot;
+    }
+
+    const bool references = reference(type);
+
+    if(auto* access = dynamic_cast<InfixExpression*>(arg.lhs.get())) {
+      const u32 field = static_cast<Identifier&>(*access->rhs).binding.slot;
+      const Register structure = stable(expression(*access->lhs), typeOf(*access->lhs), *arg.rhs);
+      const Register value = expression(*arg.rhs);
+      const Opcode set = references ? Opcode::SET_FIELD_REF : Opcode::SET_FIELD;
+      if(not op) {
+        emit(set, structure, field, value, access->lhs->span);
+        return value;
+      }
+
+      // * The result stays above the registers it is computed from, they are freed by the enclosing statement
+      const Register result = temporary();
+      emit(references ? Opcode::GET_FIELD_REF : Opcode::GET_FIELD, result, structure, field, access->lhs->span);
+      emit(op->first, result, result, value, arg.span);
+      emit(set, structure, field, result, access->lhs->span);
+      return result;
+    }
+
+    auto& subscript = static_cast<SubscriptExpression&>(*arg.lhs);
+    const TypeId array_type = typeOf(*subscript.array);
+    Register array = stable(expression(*subscript.array), array_type, *subscript.index);
+    array = stable(array, array_type, *arg.rhs);
+    const Register index = stable(expression(*subscript.index), TypeId::INT, *arg.rhs);
+    const Register value = expression(*arg.rhs);
+    const Opcode set = references ? Opcode::SET_ELEM_REF : Opcode::SET_ELEM;
+    if(not op) {
+      emit(set, array, index, value, subscript.span);
+      return value;
+    }
+
+    const Register result = temporary();
+    emit(references ? Opcode::GET_ELEM_REF : Opcode::GET_ELEM, result, array, index, subscript.span);
+    emit(op->first, result, result, value, arg.span);
+    emit(set, array, index, result, subscript.span);
+    return result;
+  }
+
+}
@@ -0,0 +1,1012 @@
+#include "CBackend.hpp"
+#include "SideEffects.hpp"
+#include "Analyzer.hpp"
+#include "Process.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    /// @brief Nesting of arrays and structs printed before the rest is elided, as by runtime::Printer
+    constexpr u32 PRINT_DEPTH = 16;
+
+    /// @brief Declarations the tables of fault sites need, written first
+    constexpr auto HEADER = R"(/* Generated by fridayc, do not edit */
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include <math.h>
+
+#if defined(__GNUC__)
+#define FX_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define FX_NORETURN __attribute__((noreturn, cold))
+#else
+#define FX_UNLIKELY(x) (x)
+#define FX_NORETURN
+#endif
+
+#if defined(_WIN32)
+#define FX_EXPORT __declspec(dllexport)
+#elif defined(__GNUC__)
+#define FX_EXPORT __attribute__((visibility("default")))
+#else
+#define FX_EXPORT
+#endif
+
+typedef struct {
+  int64_t length;
+  const char* data;
+} fx_string;
+
+/* Where a fault points: the row, column and length of its span, and its line of source */
+typedef struct {
+  uint32_t row, col, length, line;
+} fx_site;
+)"sv;
+
+    /// @brief Checked operations, strings, output and faults, written after the tables of fault sites
+    constexpr auto RUNTIME = R"(
+static jmp_buf fx_escape;
+static uint32_t fx_depth;
+
+static char fx_out[1 << 16];
+static size_t fx_used;
+
+static void fx_flush(void) {
+  fwrite(fx_out, 1, fx_used, stdout);
+  fx_used = 0;
+  fflush(stdout);
+}
+
+static void fx_write(const char* data, size_t length) {
+  if(length > sizeof fx_out - fx_used) {
+    fx_flush();
+    if(length > sizeof fx_out) {
+      fwrite(data, 1, length, stdout);
+      return;
+    }
+  }
+  memcpy(fx_out + fx_used, data, length);
+  fx_used += length;
+}
+
+static void fx_text(const char* text) {
+  fx_write(text, strlen(text));
+}
+
+static void fx_put(char c) {
+  if(fx_used == sizeof fx_out) fx_flush();
+  fx_out[fx_used++] = c;
+}
+
+/* Prints the fault the way fridayc reports errors, then leaves the run */
+static FX_NORETURN void fx_fault(const char* message, uint32_t at) {
+  const fx_site* site = &fx_sites[at];
+  const char* line = fx_lines[site->line];
+  const size_t size = strlen(line);
+  const size_t col = site->col - 1 < size ? site->col - 1 : size;
+  const size_t shown = site->length < size - col ? site->length : size - col;
+  uint32_t i;
+
+  fx_flush();
+  printf("\x1b[31m[ERROR] \x1b[37mIn file %s:%u:%u: \x1b[31m%s\x1b[37m\n", fx_path, (unsigned)site->row, (unsigned)site->col, message);
+  printf("  %*u  |  %.*s\x1b[31m%.*s\x1b[37m%s\n", fx_digits, (unsigned)site->row, (int)col, line, (int)shown, line + col, line + col + shown);
+  printf("%*s|  %*s\x1b[31m^", fx_digits + 4, "", (int)col, "");
+  for(i = 1; i < site->length; ++i) putchar('~');
+  printf("\x1b[37m\n");
+  fflush(stdout);
+  longjmp(fx_escape, 1);
+}
+
+static FX_NORETURN void fx_null(uint32_t at) {
+  fx_fault("Null dereference", at);
+}
+
+static FX_NORETURN void fx_bounds(int64_t index, int64_t length, uint32_t at) {
+  char message[96];
+  snprintf(message, sizeof message, "Index %" PRId64 " out of bounds for length %" PRId64, index, length);
+  fx_fault(message, at);
+}
+
+/* Objects are never freed, a program runs once and exits */
+static void* fx_alloc(size_t size) {
+  void* object = calloc(1, size);
+  if(FX_UNLIKELY(!object)) fx_fault("Out of memory", 0);
+  return object;
+}
+
+#define FX_CHECK(array, index, at) do { \
+    if(FX_UNLIKELY(!(array))) fx_null(at); \
+    if(FX_UNLIKELY((uint64_t)(index) >= (uint64_t)(array)->length)) fx_bounds((index), (array)->length, (at)); \
+  } while(0)
+
+#if defined(__GNUC__)
+#define fx_add_overflow __builtin_add_overflow
+#define fx_sub_overflow __builtin_sub_overflow
+#define fx_mul_overflow __builtin_mul_overflow
+#else
+static int fx_add_overflow(int64_t lhs, int64_t rhs, int64_t* result) {
+  if((rhs > 0 && lhs > INT64_MAX - rhs) || (rhs < 0 && lhs < INT64_MIN - rhs)) return 1;
+  *result = lhs + rhs;
+  return 0;
+}
+
+static int fx_sub_overflow(int64_t lhs, int64_t rhs, int64_t* result) {
+  if((rhs < 0 && lhs > INT64_MAX + rhs) || (rhs > 0 && lhs < INT64_MIN + rhs)) return 1;
+  *result = lhs - rhs;
+  return 0;
+}
+
+static int fx_mul_overflow(int64_t lhs, int64_t rhs, int64_t* result) {
+  if(lhs > 0 ? (rhs > 0 ? lhs > INT64_MAX / rhs : rhs < INT64_MIN / lhs)
+             : (rhs > 0 ? lhs < INT64_MIN / rhs : (lhs != 0 && rhs < INT64_MAX / lhs))) return 1;
+  *result = lhs * rhs;
+  return 0;
+}
+#endif
+
+static inline int64_t fx_add(int64_t lhs, int64_t rhs, uint32_t at) {
+  int64_t result;
+  if(FX_UNLIKELY(fx_add_overflow(lhs, rhs, &result))) fx_fault("Integer overflow", at);
+  return result;
+}
+
+static inline int64_t fx_sub(int64_t lhs, int64_t rhs, uint32_t at) {
+  int64_t result;
+  if(FX_UNLIKELY(fx_sub_overflow(lhs, rhs, &result))) fx_fault("Integer overflow", at);
+  return result;
+}
+
+static inline int64_t fx_mul(int64_t lhs, int64_t rhs, uint32_t at) {
+  int64_t result;
+  if(FX_UNLIKELY(fx_mul_overflow(lhs, rhs, &result))) fx_fault("Integer overflow", at);
+  return result;
+}
+
+static inline int64_t fx_div(int64_t lhs, int64_t rhs, uint32_t at) {
+  if(FX_UNLIKELY(rhs == 0)) fx_fault("Division by 0", at);
+  if(FX_UNLIKELY(lhs == INT64_MIN && rhs == -1)) fx_fault("Integer overflow", at);
+  return lhs / rhs;
+}
+
+static inline int64_t fx_mod(int64_t lhs, int64_t rhs, uint32_t at) {
+  if(FX_UNLIKELY(rhs == 0)) fx_fault("Division by 0", at);
+  if(FX_UNLIKELY(lhs == INT64_MIN && rhs == -1)) fx_fault("Integer overflow", at);
+  return lhs % rhs;
+}
+
+static inline int64_t fx_neg(int64_t value, uint32_t at) {
+  if(FX_UNLIKELY(value == INT64_MIN)) fx_fault("Integer overflow", at);
+  return -value;
+}
+
+static inline int64_t fx_shl(int64_t lhs, int64_t rhs, uint32_t at) {
+  int64_t shifted;
+  if(FX_UNLIKELY(rhs < 0 || rhs >= 64)) fx_fault("Shift count out of range", at);
+  /* Bits shifted out, including into the sign, are an overflow */
+  shifted = (int64_t)((uint64_t)lhs << rhs);
+  if(FX_UNLIKELY(shifted >> rhs != lhs)) fx_fault("Integer overflow", at);
+  return shifted;
+}
+
+static inline int64_t fx_shr(int64_t lhs, int64_t rhs, uint32_t at) {
+  if(FX_UNLIKELY(rhs < 0 || rhs >= 64)) fx_fault("Shift count out of range", at);
+  return lhs >> rhs;
+}
+
+static inline double fx_fdiv(double lhs, double rhs, uint32_t at) {
+  if(FX_UNLIKELY(rhs == 0.)) fx_fault("Division by 0", at);
+  return lhs / rhs;
+}
+
+static fx_string* fx_concat(fx_string* lhs, fx_string* rhs, uint32_t at) {
+  fx_string* result;
+  char* data;
+  if(FX_UNLIKELY(!lhs || !rhs)) fx_null(at);
+  result = (fx_string*)fx_alloc(sizeof(fx_string) + (size_t)lhs->length + (size_t)rhs->length + 1);
+  data = (char*)(result + 1);
+  memcpy(data, lhs->data, (size_t)lhs->length);
+  memcpy(data + lhs->length, rhs->data, (size_t)rhs->length);
+  result->length = lhs->length + rhs->length;
+  result->data = data;
+  return result;
+}
+
+/* Strings are equal by value, null only equals null */
+static int64_t fx_equal(fx_string* lhs, fx_string* rhs) {
+  if(lhs == rhs) return 1;
+  if(!lhs || !rhs) return 0;
+  return lhs->length == rhs->length && memcmp(lhs->data, rhs->data, (size_t)lhs->length) == 0;
+}
+
+static int64_t fx_char(fx_string* text, int64_t index, uint32_t at) {
+  FX_CHECK(text, index, at);
+  return (signed char)text->data[index];
+}
+
+static void fx_put_int(int64_t value) {
+  char digits[24];
+  fx_write(digits, (size_t)snprintf(digits, sizeof digits, "%" PRId64, value));
+}
+
+/* Shortest digits that read back as the value, fixed or scientific whichever is shorter, as std::to_chars */
+static void fx_put_float(double value) {
+  char scientific[40], fixed[400], digits[24];
+  const char* shortest;
+  int precision, exponent, count = 0, length = 0, i;
+  char* mark;
+
+  if(isnan(value) || isinf(value)) {
+    fx_text(signbit(value) ? "-" : "");
+    fx_text(isnan(value) ? "nan" : "inf");
+    return;
+  }
+
+  for(precision = 0; precision < 17; ++precision) {
+    snprintf(scientific, sizeof scientific, "%.*e", precision, value);
+    if(strtod(scientific, NULL) == value) break;
+  }
+
+  /* Significant digits without trailing zeros, and the decimal exponent */
+  mark = strchr(scientific, 'e');
+  exponent = atoi(mark + 1);
+  for(i = 0; scientific + i != mark; ++i)
+    if(scientific[i] >= '0' && scientific[i] <= '9') digits[count++] = scientific[i];
+  while(count > 1 && digits[count - 1] == '0') --count;
+
+  length = snprintf(scientific, sizeof scientific, "%s%c%s%.*se%c%02d", signbit(value) ? "-" : "", digits[0], count > 1 ? "." : "",
+    count - 1, digits + 1, exponent < 0 ? '-' : '+', exponent < 0 ? -exponent : exponent);
+
+  i = 0;
+  if(signbit(value)) fixed[i++] = '-';
+  if(exponent < 0) {
+    fixed[i++] = '0';
+    fixed[i++] = '.';
+    for(precision = -1; precision > exponent; --precision) fixed[i++] = '0';
+    memcpy(fixed + i, digits, (size_t)count);
+    i += count;
+  } else if(count <= exponent + 1) {
+    memcpy(fixed + i, digits, (size_t)count);
+    i += count;
+    for(precision = count; precision <= exponent; ++precision) fixed[i++] = '0';
+  } else {
+    memcpy(fixed + i, digits, (size_t)exponent + 1);
+    i += exponent + 1;
+    fixed[i++] = '.';
+    memcpy(fixed + i, digits + exponent + 1, (size_t)(count - exponent - 1));
+    i += count - exponent - 1;
+  }
+  fixed[i] = '\0';
+
+  shortest = i <= length ? fixed : scientific;
+  fx_text(shortest);
+  /* Whole floats keep a fraction, so they do not read as ints */
+  if(!strpbrk(shortest, ".eEin")) fx_text(".0");
+}
+
+static void fx_put_string(fx_string* value) {
+  if(!value) fx_text("null");
+  else fx_write(value->data, (size_t)value->length);
+}
+)"sv;
+
+    /// @brief C string literal of a text
+    auto quote(std::string_view text) -> std::string {
+      std::string quoted = "\"";
+      for(const i8 c : text) {
+        if(c == '"' or c == '\\' or c == '?') quoted += '\\', quoted += c;
+        else if(c >= ' ' and c <= '~') quoted += c;
+        else {
+          const u8 byte = (u8)c;
+          quoted += '\\';
+          for(const u32 shift : { 6u, 3u, 0u }) quoted += (i8)('0' + (byte >> shift & 7));
+        }
+      }
+      return quoted += '"';
+    }
+
+    auto integer(i64 value) -> std::string {
+      if(value == std::numeric_limits<i64>::min()) return "INT64_MIN"s;
+      return "INT64_C({})"f.format(value);
+    }
+
+    /// @brief Exact C literal of a float, in hexadecimal
+    auto real(f64 value) -> std::string {
+      if(std::isnan(value)) return std::signbit(value) ? "(-NAN)"s : "NAN"s;
+      if(std::isinf(value)) return value < 0 ? "(-INFINITY)"s : "INFINITY"s;
+
+      std::array<i8, 40> digits;
+      const auto end = std::to_chars(digits.data(), digits.data() + digits.size(), std::abs(value), std::chars_format::hex).ptr;
+      const std::string_view hexadecimal(digits.data(), end);
+      return std::signbit(value) ? "(-0x{})"f.format(hexadecimal) : "0x{}"f.format(hexadecimal);
+    }
+
+  }
+
+  CBackend::CBackend(Analyzer const& analyzer, TypeTable const& table) noexcept
+    : analyzer { analyzer }
+    , table { table }
+  {}
+
+  auto CBackend::generate(Program& program) -> std::vector<Error> {
+    errors.clear();
+    indices.clear();
+    pending.clear();
+    aggregates.clear();
+    printers.clear();
+    strings.clear();
+    sites.clear();
+    lines.clear();
+    for(std::string* section : { &site_table, &line_table, &forwards, &arrays, &structs, &literals, &prototypes, &prints, &entries, &functions })
+      section->clear();
+
+    FunctionStatement* entry = nullptr;
+    for(auto& stmt : *program.block)
+      if(auto* declaration = dynamic_cast<FunctionStatement*>(stmt.get()); declaration and declaration->name.view() == "main"sv)
+        entry = declaration;
+
+    if(not entry) {
+      errors.emplace_back("No 'main' function to run"s, Span{ });
+      return std::move(errors);
+    }
+    if(not entry->args.empty()) {
+      errors.emplace_back("'main' cannot take parameters"s, entry->span);
+      return std::move(errors);
+    }
+
+    // * The span of 'main' is the first site, where running out of memory and ending without a value fault
+    file = entry->span.file;
+    site(entry->span);
+
+    const TypeId returns = analyzer.typeOf(*entry->return_type);
+    const std::string invoke = "{}({})"f.format(index(*entry), passesSite(*entry) ? "0u"sv : ""sv);
+    entries += "FX_EXPORT int fx_main(int64_t* status) {\n"
+      "  fx_depth = 0;\n"
+      "  fx_used = 0;\n"
+      "  if(setjmp(fx_escape)) return 1;\n";
+    entries += returns == TypeId::INT ? "  *status = {};\n"f.format(invoke) : "  {};\n  *status = 0;\n"f.format(invoke);
+    entries += "  fx_flush();\n"
+      "  return 0;\n"
+      "}\n\n"
+      "#ifndef FX_LIBRARY\n"
+      "int main(void) {\n"
+      "  int64_t status = 0;\n"
+      "  if(fx_main(&status)) return 1;\n"
+      "  return (int)status;\n"
+      "}\n"
+      "#endif\n\n";
+
+    // * Functions are generated one at a time, each call queues the callees seen for the first time
+    while(not pending.empty()) {
+      FunctionStatement* declaration = pending.back();
+      pending.pop_back();
+      build(*declaration, *indices.find(declaration));
+    }
+    return std::move(errors);
+  }
+
+  auto CBackend::write(std::string const& path) const -> std::vector<Error> {
+    std::ofstream out(path, std::ios::binary);
+    if(not out) return { Error{ "Cannot write '{}'"f.format(path), Span{ } } };
+
+    const auto digits = (u32)std::ceil(std::log10(Sources::lines(file) + 1));
+    out << HEADER
+      << "\n#define FX_DEPTH " << ExecutionLimits{ }.depth << "u\n"
+      << "#define FX_PRINT_DEPTH " << PRINT_DEPTH << "\n\n"
+      << "static const char fx_path[] = " << quote(Sources::path(file)) << ";\n"
+      << "static const int fx_digits = " << digits << ";\n\n"
+      << "static const char* const fx_lines[] = {\n" << line_table << "};\n\n"
+      << "static const fx_site fx_sites[] = {\n" << site_table << "};\n"
+      << RUNTIME << '\n'
+      << forwards << '\n' << arrays << '\n' << structs << '\n' << literals << '\n'
+      << prototypes << '\n' << prints << entries << functions;
+
+    out.close();
+    if(not out) return { Error{ "Cannot write '{}'"f.format(path), Span{ } } };
+    return { };
+  }
+
+  auto CBackend::build(std::string const& source, std::string const& output) -> std::vector<Error> {
+    const bool library = output.ends_with(".so"sv) or output.ends_with(".dylib"sv) or output.ends_with(".dll"sv);
+
+    std::vector<std::string> arguments = command("CC", "cc"sv);
+    arguments.push_back("-O2"s);
+    if(library) arguments.insert(arguments.end(), { "-shared"s, "-fPIC"s, "-DFX_LIBRARY"s });
+    arguments.insert(arguments.end(), { "-o"s, output, source, "-lm"s });
+
+    if(spawn(arguments) != 0) return { Error{ "'{}' failed"f.format(commandLine(arguments)), Span{ } } };
+    return { };
+  }
+
+  auto CBackend::operator()(Identifier& arg) noexcept -> std::any {
+    switch(arg.binding.kind) {
+      case Binding::Kind::LOCAL:
+        return Operand{ "v{}"f.format(*locals.find(static_cast<DeclarationStatement const*>(arg.binding.declaration))), arg.binding.slot };
+      case Binding::Kind::PARAMETER:
+        return Operand{ "p{}"f.format(arg.binding.slot), arg.binding.slot };
+      case Binding::Kind::CONSTANT:
+        return Operand{ integer(arg.binding.slot) };
+      default:
+        return unsupported(arg.span, "'{}' is not a value"f.format(arg.id));
+    }
+  }
+
+  auto CBackend::operator()(BoolLiteral& arg) noexcept -> std::any {
+    return Operand{ arg.value.unwrap() ? "1"s : "0"s };
+  }
+
+  auto CBackend::operator()(ObjectLiteral& arg) noexcept -> std::any {
+    if(arg.value.getType() != Token::Type::NUL)
+      return unsupported(arg.span, "Cannot use '{}' outside of a method"f.format(arg.value.getLiteral()));
+    return Operand{ "NULL"s };
+  }
+
+  auto CBackend::operator()(StringLiteral& arg) noexcept -> std::any {
+    // * Strings never change, every evaluation shares the same one
+    auto [index, added] = strings.insert(arg.value, (u32)strings.size());
+    if(added) literals += "static fx_string fx_str{} = {{ {}, {} }};\n"f.format(*index, arg.value.size(), quote(arg.value));
+    return Operand{ "&fx_str{}"f.format(*index) };
+  }
+
+  auto CBackend::operator()(FloatLiteral& arg) noexcept -> std::any {
+    return Operand{ real(arg.value.unwrap()) };
+  }
+
+  auto CBackend::operator()(IntLiteral& arg) noexcept -> std::any {
+    return Operand{ integer(arg.value.unwrap()) };
+  }
+
+  auto CBackend::operator()(CharLiteral& arg) noexcept -> std::any {
+    return Operand{ integer(arg.value.unwrap()) };
+  }
+
+  auto CBackend::operator()(PrefixExpression& arg) noexcept -> std::any {
+    if(arg.oper == Token::Type::PLUS) return expression(*arg.expr);
+
+    const TypeId type = typeOf(arg);
+    const Operand value = expression(*arg.expr);
+    switch(arg.oper) {
+      case Token::Type::MINUS:
+        if(type == TypeId::FLOAT) return temporary(type, "-" + value.code);
+        return temporary(type, "fx_neg({}, {}u)"f.format(value.code, site(arg.span)));
+      case Token::Type::NOT:
+        return temporary(type, "!" + value.code);
+      case Token::Type::BIT_NOT:
+        return temporary(type, "~" + value.code);
+      default:
+        return unsupported(arg.span, "Cannot run this operator"s);
+    }
+  }
+
+  auto CBackend::operator()(InfixExpression& arg) noexcept -> std::any {
+    if(arg.oper == Token::Type::DOT) return member(arg);
+    if(arg.oper == Token::Type::ASSIGN or Token::compoundOperatorOf(arg.oper) != Token::Type::ILLEGAL) return assign(arg);
+    return binary(arg);
+  }
+
+  auto CBackend::operator()(CallExpression& arg) noexcept -> std::any {
+    Identifier const* name = arg.callee();
+    if(name and name->binding.kind == Binding::Kind::FUNCTION)
+      return call(arg, *static_cast<FunctionStatement*>(name->binding.declaration));
+    if(name and name->binding.kind == Binding::Kind::STRUCT)
+      return construct(arg, typeOf(arg), arg.span);
+    return unsupported(arg.function->span, "Only functions and structs can be called"s);
+  }
+
+  auto CBackend::operator()(SubscriptExpression& arg) noexcept -> std::any {
+    const TypeId type = typeOf(*arg.array);
+    const Operand array = stable(expression(*arg.array), type, *arg.index);
+    const Operand index = expression(*arg.index);
+
+    if(type == TypeId::STRING) return temporary(typeOf(arg), "fx_char({}, {}, {}u)"f.format(array.code, index.code, site(arg.span)));
+    return temporary(typeOf(arg), element(array.code, index.code, site(arg.span)));
+  }
+
+  auto CBackend::operator()(ArrayLiteral& arg) noexcept -> std::any {
+    return construct(arg, typeOf(arg), arg.span);
+  }
+
+  auto CBackend::operator()(ExpressionStatement& arg) noexcept -> std::any {
+    expression(*arg.expr);
+    return { };
+  }
+
+  auto CBackend::operator()(ReturnStatement& arg) noexcept -> std::any {
+    const TypeId type = typeOf(*arg.expr);
+    const Operand value = expression(*arg.expr);
+    line(type == TypeId::VOID ? "return;"s : "return {};"f.format(value.code));
+    return { };
+  }
+
+  auto CBackend::operator()(PrintStatement& arg) noexcept -> std::any {
+    const TypeId type = typeOf(*arg.expr);
+    const Operand value = expression(*arg.expr);
+    if(type == TypeId::VOID) return { };
+
+    line("{}({}, 0); fx_put('\\n');"f.format(printer(type), value.code));
+    return { };
+  }
+
+  auto CBackend::operator()(BlockStatement& arg) noexcept -> std::any {
+    line("{"sv);
+    nested(arg);
+    line("}"sv);
+    return { };
+  }
+
+  auto CBackend::operator()(IfStatement& arg) noexcept -> std::any {
+    const Operand condition = expression(*arg.condition);
+    line("if({}) {{"f.format(condition.code));
+    nested(*arg.block);
+    if(arg.alternative) {
+      line("} else {"sv);
+      nested(*arg.alternative);
+    }
+    line("}"sv);
+    return { };
+  }
+
+  auto CBackend::operator()(WhileStatement& arg) noexcept -> std::any {
+    // * The condition may need statements of its own, so it is tested inside the loop
+    line("for(;;) {"sv);
+    ++indent;
+    const Operand condition = expression(*arg.condition);
+    line("if(!{}) break;"f.format(condition.code));
+    --indent;
+    nested(*arg.block);
+    line("}"sv);
+    return { };
+  }
+
+  auto CBackend::operator()(ForStatement& arg) noexcept -> std::any {
+    expression(*arg.initializer);
+    line("for(;;) {"sv);
+    ++indent;
+    const Operand condition = expression(*arg.condition);
+    line("if(!{}) break;"f.format(condition.code));
+    --indent;
+    nested(*arg.block);
+    ++indent;
+    expression(*arg.modifier);
+    --indent;
+    line("}"sv);
+    return { };
+  }
+
+  auto CBackend::operator()(DeclarationStatement& arg) noexcept -> std::any {
+    const TypeId type = analyzer.typeOf(arg);
+    std::string initial = "0"s;
+    if(arg.expr) {
+      const Operand value = expression(*arg.expr);
+      if(typeOf(*arg.expr) != TypeId::VOID) initial = value.code;
+    }
+
+    const u32 local = *locals.insert(&arg, (u32)locals.size()).first;
+    line("{} v{} = {};"f.format(ctype(type), local, initial));
+    return { };
+  }
+
+  auto CBackend::index(FunctionStatement& declaration) -> std::string {
+    auto [index, added] = indices.insert(&declaration, (u32)indices.size());
+    if(added) pending.push_back(&declaration);
+    return "fx_f{}_{}"f.format(*index, declaration.name);
+  }
+
+  auto CBackend::build(FunctionStatement& declaration, u32 index) -> void {
+    function = &declaration;
+    locals.clear();
+    temporaries = 0;
+    indent = 1;
+    body.clear();
+
+    const std::string name = signature(declaration, index);
+    prototypes += name + ";\n";
+
+    row = Sources::locate(declaration.span).row;
+    functions += "#line {} {}\n{} {{\n"f.format(row, quote(Sources::path(file)), name);
+    mapped = row + 1;
+
+    for(auto& stmt : *declaration.block) statement(*stmt);
+    if(passesSite(declaration)) {
+      row = Sources::locate(declaration.span).row;
+      const std::string message = "'{}' ended without returning a value"f.format(declaration.name);
+      line("fx_fault({}, fx_site);"f.format(quote(message)));
+    }
+
+    functions += body;
+    functions += "}\n\n"sv;
+    function = nullptr;
+  }
+
+  auto CBackend::signature(FunctionStatement& declaration, u32 index) -> std::string {
+    std::string parameters;
+    for(u32 slot = 0; Member const& parameter : declaration.args) {
+      if(slot) parameters += ", "sv;
+      parameters += "{} p{}"f.format(ctype(analyzer.typeOf(*parameter.type)), slot++);
+    }
+    if(passesSite(declaration)) parameters += parameters.empty() ? "uint32_t fx_site"sv : ", uint32_t fx_site"sv;
+    if(parameters.empty()) parameters = "void"s;
+
+    return "static {} fx_f{}_{}({})"f.format(ctype(analyzer.typeOf(*declaration.return_type)), index, declaration.name, parameters);
+  }
+
+  auto CBackend::expression(Expression& expr) noexcept -> Operand {
+    std::any result = visit(expr);
+    if(auto* value = std::any_cast<Operand>(&result)) return std::move(*value);
+    return unsupported(expr.span, "Cannot run this expression"s);
+  }
+
+  auto CBackend::statement(Statement& stmt) noexcept -> void {
+    const u32 enclosing = row;
+    if(not dynamic_cast<BlockStatement*>(&stmt)) row = Sources::locate(stmt.span).row;
+    visit(stmt);
+    row = enclosing;
+  }
+
+  auto CBackend::nested(Statement& stmt) noexcept -> void {
+    ++indent;
+    if(auto* block = dynamic_cast<BlockStatement*>(&stmt))
+      for(auto& each : *block) statement(*each);
+    else statement(stmt);
+    --indent;
+  }
+
+  auto CBackend::unsupported(Span span, std::string message) noexcept -> Operand {
+    errors.emplace_back(std::move(message), span);
+    return { "0"s };
+  }
+
+  auto CBackend::typeOf(Expression const& expr) const noexcept -> TypeId {
+    return analyzer.typeOf(expr);
+  }
+
+  auto CBackend::falls(Statement const& stmt) const noexcept -> bool {
+    if(dynamic_cast<ReturnStatement const*>(&stmt)) return false;
+    if(auto* block = dynamic_cast<BlockStatement const*>(&stmt))
+      return std::ranges::all_of(*block, [this](Box<Statement> const& each) { return falls(*each); });
+    if(auto* branch = dynamic_cast<IfStatement const*>(&stmt))
+      return not branch->alternative or falls(*branch->block) or falls(*branch->alternative);
+    return true;
+  }
+
+  auto CBackend::passesSite(FunctionStatement& declaration) const noexcept -> bool {
+    return analyzer.typeOf(*declaration.return_type) != TypeId::VOID and falls(*declaration.block);
+  }
+
+  auto CBackend::line(std::string_view code) -> void {
+    if(mapped != row) {
+      body += "#line {} {}\n"f.format(row, quote(Sources::path(file)));
+      mapped = row;
+    }
+    body.append(2 * indent, ' ');
+    body += code;
+    body += '\n';
+    ++mapped;
+  }
+
+  auto CBackend::temporary(TypeId type, std::string_view code) -> Operand {
+    if(type == TypeId::VOID) {
+      line("{};"f.format(code));
+      return { };
+    }
+
+    std::string name = "t{}"f.format(temporaries++);
+    line("{} {} = {};"f.format(ctype(type), name, code));
+    return { std::move(name) };
+  }
+
+  auto CBackend::stable(Operand value, TypeId type, Expression& later) -> Operand {
+    if(not value.slot) return value;
+
+    std::vector<bool> assigned(std::max<u32>(function->frame_size, (u32)function->args.size()), false);
+    SideEffects effects(assigned);
+    effects.visit(later);
+    if(*value.slot >= assigned.size() or not assigned[*value.slot]) return value;
+    return temporary(type, value.code);
+  }
+
+  auto CBackend::site(Span span) -> u32 {
+    auto [index, added] = sites.insert((u64)span.offset << 32 | span.length, (u32)sites.size());
+    if(added) {
+      const Location at = Sources::locate(span);
+      auto [text, first] = lines.insert(at.row, (u32)lines.size());
+      if(first) line_table += "  {},\n"f.format(quote(Sources::line(file, at.row)));
+      site_table += "  {{ {}, {}, {}, {} }},\n"f.format(at.row, at.col, std::max<u32>(span.length, 1), *text);
+    }
+    return *index;
+  }
+
+  auto CBackend::ctype(TypeId type) -> std::string {
+    TypeInfo const& info = table.info(type);
+    switch(info.kind) {
+      case TypeInfo::Kind::FLOAT: return "double"s;
+      case TypeInfo::Kind::STRING: return "fx_string*"s;
+      case TypeInfo::Kind::VOID: return "void"s;
+      case TypeInfo::Kind::NUL: return "void*"s;
+      case TypeInfo::Kind::STRUCT: {
+        // * Registered before its fields are described, so structs that contain themselves find it
+        auto [index, added] = aggregates.insert(type, (u32)aggregates.size());
+        const u32 number = *index;
+        if(added) {
+          forwards += "struct fx_s{};\n"f.format(number);
+          std::string fields;
+          for(u32 field = 0; Member const& member : static_cast<StructStatement const*>(info.declaration)->fields)
+            fields += "  {} f{};\n"f.format(ctype(analyzer.typeOf(*member.type)), field++);
+          structs += "struct fx_s{} {{\n{}}};\n"f.format(number, fields.empty() ? "  char empty;\n"s : fields);
+        }
+        return "struct fx_s{}*"f.format(number);
+      }
+      case TypeInfo::Kind::ARRAY: {
+        if(u32 const* known = aggregates.find(type)) return "fx_a{}*"f.format(*known);
+
+        // * The element comes first, so its type is declared before the array of it
+        const std::string element = ctype(info.element);
+        const u32 number = *aggregates.insert(type, (u32)aggregates.size()).first;
+        arrays += "typedef struct {{\n  int64_t length;\n  {} data[];\n}} fx_a{};\n"f.format(element, number);
+        return "fx_a{}*"f.format(number);
+      }
+      default: return "int64_t"s;
+    }
+  }
+
+  auto CBackend::printer(TypeId type) -> std::string {
+    // * Registered before it is generated, so types that contain themselves find it
+    auto [index, added] = printers.insert(type, (u32)printers.size());
+    const std::string name = "fx_print{}"f.format(*index);
+    if(not added) return name;
+
+    TypeInfo const& info = table.info(type);
+    const std::string value = ctype(type);
+    prototypes += "static void {}({} value, int depth);\n"f.format(name, value);
+
+    std::string code;
+    switch(info.kind) {
+      case TypeInfo::Kind::INT: code = "  fx_put_int(value);\n"s; break;
+      case TypeInfo::Kind::FLOAT: code = "  fx_put_float(value);\n"s; break;
+      case TypeInfo::Kind::BOOL: code = "  fx_text(value ? \"true\" : \"false\");\n"s; break;
+      case TypeInfo::Kind::CHAR: code = "  fx_put((char)value);\n"s; break;
+      case TypeInfo::Kind::STRING: code = "  fx_put_string(value);\n"s; break;
+      case TypeInfo::Kind::ENUM: {
+        std::string names;
+        for(Symbol constant : *static_cast<EnumStatement const*>(info.declaration)) names += "{}, "f.format(quote(constant.view()));
+        code = "  static const char* const names[] = {{ {}\"\" }};\n  fx_text(names[value]);\n"f.format(names);
+        break;
+      }
+      case TypeInfo::Kind::ARRAY: {
+        const std::string element = printer(info.element);
+        code = "  int64_t i;\n"
+          "  if(!value) { fx_text(\"null\"); return; }\n"
+          "  if(depth == FX_PRINT_DEPTH) { fx_text(\"[...]\"); return; }\n"
+          "  fx_put('[');\n"
+          "  for(i = 0; i < value->length; ++i) {\n"
+          "    if(i) fx_text(\", \");\n"
+          "    " + element + "(value->data[i], depth + 1);\n"
+          "  }\n"
+          "  fx_put(']');\n";
+        break;
+      }
+      case TypeInfo::Kind::STRUCT: {
+        auto* declaration = static_cast<StructStatement const*>(info.declaration);
+        code = "  if(!value) {{ fx_text(\"null\"); return; }}\n"
+          "  if(depth == FX_PRINT_DEPTH) {{ fx_text({}); return; }}\n"
+          "  fx_text({});\n"f.format(quote("{}(...)"f.format(declaration->name)), quote("{}("f.format(declaration->name)));
+        for(u32 field = 0; Member const& member : declaration->fields) {
+          if(field) code += "  fx_text(\", \");\n"sv;
+          code += "  {}(value->f{}, depth + 1);\n"f.format(printer(analyzer.typeOf(*member.type)), field++);
+        }
+        code += "  fx_put(')');\n"sv;
+        break;
+      }
+      default: code = "  fx_text(\"null\");\n"s; break;
+    }
+    prints += "static void {}({} value, int depth) {{\n  (void)depth;\n{}}}\n\n"f.format(name, value, code);
+    return name;
+  }
+
+  auto CBackend::operation(Token::Type oper, TypeId lhs, TypeId rhs, std::string_view left, std::string_view right, u32 at) const
+    -> std::optional<std::string> {
+    const TypeInfo::Kind kind = table.info(lhs).kind;
+    const bool reference = kind == TypeInfo::Kind::STRING or kind == TypeInfo::Kind::NUL or kind == TypeInfo::Kind::STRUCT or kind == TypeInfo::Kind::ARRAY;
+
+    // * Strings are equal by value, other references by identity
+    if(reference and (oper == Token::Type::EQUALS or oper == Token::Type::NOT_EQ)) {
+      const std::string_view negation = oper == Token::Type::NOT_EQ ? "!"sv : ""sv;
+      if(lhs == TypeId::STRING or rhs == TypeId::STRING) return "{}fx_equal({}, {})"f.format(negation, left, right);
+      return "{}((void*){} == (void*){})"f.format(negation, left, right);
+    }
+
+    const auto checked = [&](std::string_view name) { return "{}({}, {}, {}u)"f.format(name, left, right, at); };
+    const auto infix = [&](std::string_view op) { return "({} {} {})"f.format(left, op, right); };
+    const auto compare = [&]() -> std::optional<std::string> {
+      switch(oper) {
+        case Token::Type::LESS: return infix("<"sv);
+        case Token::Type::LESS_EQ: return infix("<="sv);
+        case Token::Type::GREATER: return infix(">"sv);
+        case Token::Type::GREATER_EQ: return infix(">="sv);
+        case Token::Type::EQUALS: return infix("=="sv);
+        case Token::Type::NOT_EQ: return infix("!="sv);
+        default: return std::nullopt;
+      }
+    };
+
+    switch(kind) {
+      case TypeInfo::Kind::INT:
+      case TypeInfo::Kind::ENUM:
+        switch(oper) {
+          case Token::Type::PLUS: return checked("fx_add"sv);
+          case Token::Type::MINUS: return checked("fx_sub"sv);
+          case Token::Type::STAR: return checked("fx_mul"sv);
+          case Token::Type::SLASH: return checked("fx_div"sv);
+          case Token::Type::MODULO: return checked("fx_mod"sv);
+          case Token::Type::BIT_AND: return infix("&"sv);
+          case Token::Type::BIT_OR: return infix("|"sv);
+          case Token::Type::LSHIFT: return checked("fx_shl"sv);
+          case Token::Type::RSHIFT: return checked("fx_shr"sv);
+          default: return compare();
+        }
+      case TypeInfo::Kind::FLOAT:
+        switch(oper) {
+          case Token::Type::PLUS: return infix("+"sv);
+          case Token::Type::MINUS: return infix("-"sv);
+          case Token::Type::STAR: return infix("*"sv);
+          case Token::Type::SLASH: return checked("fx_fdiv"sv);
+          default: return compare();
+        }
+      case TypeInfo::Kind::STRING:
+        if(oper != Token::Type::PLUS) return std::nullopt;
+        return checked("fx_concat"sv);
+      case TypeInfo::Kind::BOOL:
+        if(oper != Token::Type::EQUALS and oper != Token::Type::NOT_EQ) return std::nullopt;
+        return compare();
+      case TypeInfo::Kind::CHAR:
+        return compare();
+      default:
+        return std::nullopt;
+    }
+  }
+
+  auto CBackend::call(CallExpression& arg, FunctionStatement& callee) noexcept -> Operand {
+    const std::string name = index(callee);
+
+    // * Arguments are evaluated left to right, before the callee counts as entered
+    std::string arguments;
+    for(u32 i = 0; i < arg.size(); ++i) {
+      const TypeId type = typeOf(*arg[i]);
+      Operand value = expression(*arg[i]);
+      for(u32 later = i + 1; later < arg.size(); ++later) value = stable(std::move(value), type, *arg[later]);
+      if(i) arguments += ", "sv;
+      arguments += value.code;
+    }
+
+    const u32 at = site(arg.span);
+    if(passesSite(callee)) arguments += arguments.empty() ? "{}u"f.format(at) : ", {}u"f.format(at);
+
+    line("if(FX_UNLIKELY(++fx_depth > FX_DEPTH)) fx_fault(\"Stack overflow\", {}u);"f.format(at));
+    Operand result = temporary(typeOf(arg), "{}({})"f.format(name, arguments));
+    line("--fx_depth;"sv);
+    return result;
+  }
+
+  auto CBackend::construct(Container<Box<Expression>>& values, TypeId type, Span span) noexcept -> Operand {
+    std::string object = ctype(type);
+    object.pop_back();
+
+    const bool array = table.info(type).kind == TypeInfo::Kind::ARRAY;
+    const std::string size = array ? "sizeof({}) + {} * sizeof({})"f.format(object, values.size(), ctype(table.info(type).element)) : "sizeof({})"f.format(object);
+    const Operand result = temporary(type, "fx_alloc({})"f.format(size));
+    if(array) line("{}->length = {};"f.format(result.code, values.size()));
+
+    for(u32 i = 0; i < values.size(); ++i) {
+      const TypeId part = typeOf(*values[i]);
+      const Operand value = expression(*values[i]);
+      if(part != TypeId::VOID) line(array ? "{}->data[{}] = {};"f.format(result.code, i, value.code) : "{}->f{} = {};"f.format(result.code, i, value.code));
+    }
+    return result;
+  }
+
+  auto CBackend::member(InfixExpression& arg) noexcept -> Operand {
+    auto* object = dynamic_cast<Identifier*>(arg.lhs.get());
+    auto* name = dynamic_cast<Identifier*>(arg.rhs.get());
+    if(not name) return unsupported(arg.span, "Cannot run this expression"s);
+
+    // * Enum constants and namespace members are resolved already, only fields are read at run time
+    if(object and (object->binding.kind == Binding::Kind::ENUM or object->binding.kind == Binding::Kind::NAMESPACE))
+      return expression(*name);
+
+    const Operand structure = expression(*arg.lhs);
+    line("if(FX_UNLIKELY(!{})) fx_null({}u);"f.format(structure.code, site(arg.lhs->span)));
+    return temporary(typeOf(arg), "{}->f{}"f.format(structure.code, name->binding.slot));
+  }
+
+  auto CBackend::binary(InfixExpression& arg) noexcept -> Operand {
+    const TypeId lhs = typeOf(*arg.lhs);
+    const TypeId rhs = typeOf(*arg.rhs);
+
+    if(arg.oper == Token::Type::AND or arg.oper == Token::Type::OR) {
+      const Operand result = temporary(typeOf(arg), expression(*arg.lhs).code);
+      line("if({}{}) {{"f.format(arg.oper == Token::Type::AND ? ""sv : "!"sv, result.code));
+      ++indent;
+      const Operand right = expression(*arg.rhs);
+      line("{} = {};"f.format(result.code, right.code));
+      --indent;
+      line("}"sv);
+      return result;
+    }
+
+    const Operand left = stable(expression(*arg.lhs), lhs, *arg.rhs);
+    const Operand right = expression(*arg.rhs);
+    const std::optional<std::string> code = operation(arg.oper, lhs, rhs, left.code, right.code, site(arg.span));
+    if(not code) return unsupported(arg.span, "Cannot run this operator"s);
+    return temporary(typeOf(arg), *code);
+  }
+
+  auto CBackend::assign(InfixExpression& arg) noexcept -> Operand {
+    if(auto* subscript = dynamic_cast<SubscriptExpression*>(arg.lhs.get()); subscript and typeOf(*subscript->array) == TypeId::STRING)
+      return unsupported(arg.lhs->span, "Characters of a string cannot be assigned"s);
+
+    const TypeId type = typeOf(*arg.lhs);
+    const Token::Type oper = Token::compoundOperatorOf(arg.oper);
+    const bool compound = oper != Token::Type::ILLEGAL;
+
+    // * The new value of a target read as 'current', after every operand is evaluated
+    const auto update = [&](std::string_view current, std::string_view value) -> std::optional<std::string> {
+      if(not compound) return std::string(value);
+      return operation(oper, type, typeOf(*arg.rhs), current, value, site(arg.span));
+    };
+
+    if(auto* name = dynamic_cast<Identifier*>(arg.lhs.get())) {
+      Operand target = expression(*name);
+      const Operand value = expression(*arg.rhs);
+      const std::optional<std::string> code = update(target.code, value.code);
+      if(not code) return unsupported(arg.span, "Cannot run this assignment"s);
+      line("{} = {};"f.format(target.code, *code));
+      return target;
+    }
+
+    if(auto* access = dynamic_cast<InfixExpression*>(arg.lhs.get())) {
+      const u32 field = static_cast<Identifier&>(*access->rhs).binding.slot;
+      const Operand structure = stable(expression(*access->lhs), typeOf(*access->lhs), *arg.rhs);
+      const Operand value = expression(*arg.rhs);
+      line("if(FX_UNLIKELY(!{})) fx_null({}u);"f.format(structure.code, site(access->lhs->span)));
+
+      const std::string target = "{}->f{}"f.format(structure.code, field);
+      const std::optional<std::string> code = update(target, value.code);
+      if(not code) return unsupported(arg.span, "Cannot run this assignment"s);
+      if(not compound) {
+        line("{} = {};"f.format(target, *code));
+        return value;
+      }
+      const Operand result = temporary(type, *code);
+      line("{} = {};"f.format(target, result.code));
+      return result;
+    }
+
+    auto& subscript = static_cast<SubscriptExpression&>(*arg.lhs);
+    const TypeId array_type = typeOf(*subscript.array);
+    Operand array = stable(expression(*subscript.array), array_type, *subscript.index);
+    array = stable(std::move(array), array_type, *arg.rhs);
+    const Operand index = stable(expression(*subscript.index), TypeId::INT, *arg.rhs);
+    const Operand value = expression(*arg.rhs);
+
+    const std::string target = element(array.code, index.code, site(subscript.span));
+    const std::optional<std::string> code = update(target, value.code);
+    if(not code) return unsupported(arg.span, "Cannot run this assignment"s);
+    if(not compound) {
+      line("{} = {};"f.format(target, *code));
+      return value;
+    }
+    const Operand result = temporary(type, *code);
+    line("{} = {};"f.format(target, result.code));
+    return result;
+  }
+
+  auto CBackend::element(std::string_view array, std::string_view index, u32 at) -> std::string {
+    line("FX_CHECK({}, {}, {}u);"f.format(array, index, at));
+    return "{}->data[{}]"f.format(array, index);
+  }
+
+}
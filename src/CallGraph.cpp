@@ -0,0 +1,304 @@
+#include "CallGraph.hpp"
+#include "ThreadPool.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    /// @brief Number of collection tasks created per worker, to balance functions of uneven size
+    constexpr u64 TASKS_PER_WORKER = 8;
+
+    /// @brief Ready components a summary task hands to another task once it holds twice as many
+    constexpr u64 GRAIN = 64;
+
+    constexpr u32 NONE = std::numeric_limits<u32>::max();
+
+    /// @brief Collects the direct callees and the own effects of one function
+    struct Calls : public Walker {
+      FlatMap<FunctionStatement const*, u32> const& indices;
+      std::vector<u32>&                             callees;
+      FunctionSummary&                              summary;
+
+      Calls(FlatMap<FunctionStatement const*, u32> const& indices, std::vector<u32>& callees, FunctionSummary& summary) noexcept
+        : indices { indices }
+        , callees { callees }
+        , summary { summary }
+      {}
+
+      using Walker::operator();
+
+      auto operator()(PrintStatement& arg) noexcept -> std::any override {
+        summary.pure = false;
+        return Walker::operator()(arg);
+      }
+
+      auto operator()(InfixExpression& arg) noexcept -> std::any override {
+        // * Locals and parameters belong to the call, elements and fields may be shared with the caller
+        const bool assignment = arg.oper == Token::Type::ASSIGN or Token::compoundOperatorOf(arg.oper) != Token::Type::ILLEGAL;
+        if(assignment and not dynamic_cast<Identifier*>(arg.lhs.get())) summary.pure = false;
+        return Walker::operator()(arg);
+      }
+
+      auto operator()(ArrayLiteral& arg) noexcept -> std::any override {
+        summary.no_alloc = false;
+        return Walker::operator()(arg);
+      }
+
+      auto operator()(CallExpression& arg) noexcept -> std::any override {
+        Identifier const* name = arg.callee();
+        u32 const* callee = name and name->binding.kind == Binding::Kind::FUNCTION ?
+          indices.find(static_cast<FunctionStatement const*>(name->binding.declaration)) : nullptr;
+
+        if(callee) callees.push_back(*callee);
+        else if(name and name->binding.kind == Binding::Kind::STRUCT) summary.no_alloc = false;
+        else {
+          // * Unknown code may do anything, including calling back into this function
+          summary = { false, false, true, FunctionSummary::UNBOUNDED };
+          if(not name) visit(*arg.function);
+        }
+
+        for(auto& argument : arg) visit(*argument);
+        return { };
+      }
+    };
+
+    auto deeper(u64 frame, u64 callees) noexcept -> u64 {
+      if(frame == FunctionSummary::UNBOUNDED or callees == FunctionSummary::UNBOUNDED) return FunctionSummary::UNBOUNDED;
+      return frame + callees;
+    }
+
+  }
+
+  CallGraph::CallGraph(ThreadPool& pool) noexcept
+    : pool { pool }
+  {}
+
+  auto CallGraph::build(Program& program) -> void {
+    collect(program);
+    connect();
+    summarize();
+  }
+
+  auto CallGraph::summary(FunctionStatement const& function) const noexcept -> FunctionSummary const* {
+    u32 const* index = indices.find(&function);
+    return index ? &summaries[components[*index]] : nullptr;
+  }
+
+  auto CallGraph::callees(FunctionStatement const& function) const -> std::vector<FunctionStatement const*> {
+    std::vector<FunctionStatement const*> result;
+    if(u32 const* index = indices.find(&function))
+      for(u32 edge = offsets[*index]; edge < offsets[*index + 1]; ++edge) result.push_back(functions[targets[edge]]);
+    return result;
+  }
+
+  auto CallGraph::component(FunctionStatement const& function) const noexcept -> std::optional<u32> {
+    u32 const* index = indices.find(&function);
+    if(not index) return std::nullopt;
+    return components[*index];
+  }
+
+  auto CallGraph::functionCount() const noexcept -> u64 {
+    return functions.size();
+  }
+
+  auto CallGraph::edgeCount() const noexcept -> u64 {
+    return targets.size();
+  }
+
+  auto CallGraph::componentCount() const noexcept -> u64 {
+    return summaries.size();
+  }
+
+  auto CallGraph::collect(Program& program) -> void {
+    for(auto& stmt : *program.block) {
+      auto* function = dynamic_cast<FunctionStatement*>(stmt.get());
+      if(not function) continue;
+      indices.insert(function, (u32)functions.size());
+      functions.push_back(function);
+    }
+
+    const u64 count = functions.size();
+    const u64 tasks = std::min(count, pool.size() * TASKS_PER_WORKER);
+    std::vector<std::vector<u32>> calls(count);
+    locals.assign(count, { });
+
+    for(u64 task = 0; task < tasks; ++task) {
+      pool.submit([this, task, tasks, count, &calls] {
+        const u64 begin = count * task / tasks;
+        const u64 end = count * (task + 1) / tasks;
+
+        for(u64 i = begin; i < end; ++i) {
+          FunctionStatement* function = functions[i];
+          FunctionSummary& local = locals[i];
+          local.stack = function->frame_size;
+
+          Calls(indices, calls[i], local).visit(*function->block);
+          std::ranges::sort(calls[i]);
+          calls[i].erase(std::ranges::unique(calls[i]).begin(), calls[i].end());
+        }
+      });
+    }
+    pool.wait();
+
+    offsets.assign(count + 1, 0);
+    for(u64 i = 0; i < count; ++i) offsets[i + 1] = offsets[i] + (u32)calls[i].size();
+
+    targets.resize(offsets[count]);
+    for(u64 i = 0; i < count; ++i) std::ranges::copy(calls[i], targets.begin() + offsets[i]);
+  }
+
+  auto CallGraph::connect() -> void {
+    // * Tarjan's algorithm with an explicit stack, call chains can be deeper than the native stack
+    struct Frame {
+      u32 node;
+      u32 edge;
+    };
+
+    const u32 count = (u32)functions.size();
+    std::vector<u32> order(count, NONE);
+    std::vector<u32> low(count, 0);
+    std::vector<bool> open(count, false);
+    std::vector<u32> stack;
+    std::vector<Frame> frames;
+    u32 visited = 0;
+
+    components.assign(count, NONE);
+    starts.assign(1, 0);
+    members.clear();
+    members.reserve(count);
+
+    const auto discover = [&](u32 node) {
+      order[node] = low[node] = visited++;
+      stack.push_back(node);
+      open[node] = true;
+      frames.push_back({ node, offsets[node] });
+    };
+
+    for(u32 root = 0; root < count; ++root) {
+      if(order[root] != NONE) continue;
+      discover(root);
+
+      while(not frames.empty()) {
+        Frame& frame = frames.back();
+        if(frame.edge < offsets[frame.node + 1]) {
+          const u32 callee = targets[frame.edge++];
+          if(order[callee] == NONE) discover(callee);
+          else if(open[callee]) low[frame.node] = std::min(low[frame.node], order[callee]);
+          continue;
+        }
+
+        const u32 node = frame.node;
+        frames.pop_back();
+        if(not frames.empty()) low[frames.back().node] = std::min(low[frames.back().node], low[node]);
+        if(low[node] != order[node]) continue;
+
+        // * A root closes its component, every callee outside of it was closed before
+        const u32 component = (u32)starts.size() - 1;
+        u32 member;
+        do {
+          member = stack.back();
+          stack.pop_back();
+          open[member] = false;
+          components[member] = component;
+          members.push_back(member);
+        } while(member != node);
+        starts.push_back((u32)members.size());
+      }
+    }
+  }
+
+  auto CallGraph::summarize() -> void {
+    const u32 count = (u32)starts.size() - 1;
+    summaries.assign(count, { });
+
+    // * The callers of each component, and how many distinct components each one still waits for
+    std::vector<std::atomic<u32>> pending(count);
+    std::vector<u32> first(count + 1, 0);
+    std::vector<u32> callers;
+    std::vector<u32> seen(count, NONE);
+
+    const auto dependencies = [&](auto&& each) {
+      std::ranges::fill(seen, NONE);
+      for(u32 component = 0; component < count; ++component)
+        for(u32 i = starts[component]; i < starts[component + 1]; ++i)
+          for(u32 edge = offsets[members[i]]; edge < offsets[members[i] + 1]; ++edge) {
+            const u32 callee = components[targets[edge]];
+            if(callee == component or seen[callee] == component) continue;
+            seen[callee] = component;
+            each(component, callee);
+          }
+    };
+
+    dependencies([&](u32 component, u32 callee) {
+      pending[component].fetch_add(1, std::memory_order_relaxed);
+      ++first[callee + 1];
+    });
+    for(u32 component = 0; component < count; ++component) first[component + 1] += first[component];
+
+    callers.resize(first[count]);
+    std::vector<u32> cursor(first.begin(), first.end() - 1);
+    dependencies([&](u32 component, u32 callee) { callers[cursor[callee]++] = component; });
+
+    // * A task runs what its components make ready and shares the surplus with idle workers
+    std::function<void(std::vector<u32>)> run = [&](std::vector<u32> ready) {
+      while(not ready.empty()) {
+        const u32 component = ready.back();
+        ready.pop_back();
+        summarize(component);
+
+        for(u32 i = first[component]; i < first[component + 1]; ++i)
+          if(pending[callers[i]].fetch_sub(1, std::memory_order_acq_rel) == 1) ready.push_back(callers[i]);
+
+        if(ready.size() > 2 * GRAIN) {
+          std::vector<u32> shared(ready.end() - GRAIN, ready.end());
+          ready.resize(ready.size() - GRAIN);
+          pool.submit([&run, shared = std::move(shared)] { run(std::move(shared)); });
+        }
+      }
+    };
+
+    std::vector<u32> leaves;
+    for(u32 component = 0; component < count; ++component)
+      if(pending[component].load(std::memory_order_relaxed) == 0) leaves.push_back(component);
+
+    const u64 tasks = std::min<u64>(leaves.size(), pool.size() * TASKS_PER_WORKER);
+    for(u64 task = 0; task < tasks; ++task) {
+      std::vector<u32> batch(leaves.begin() + leaves.size() * task / tasks, leaves.begin() + leaves.size() * (task + 1) / tasks);
+      pool.submit([&run, batch = std::move(batch)] { run(std::move(batch)); });
+    }
+    pool.wait();
+  }
+
+  auto CallGraph::summarize(u32 component) noexcept -> void {
+    FunctionSummary result;
+    result.recursive = starts[component + 1] - starts[component] > 1;
+    u64 deepest = 0;
+
+    for(u32 i = starts[component]; i < starts[component + 1]; ++i) {
+      const u32 member = members[i];
+      FunctionSummary const& local = locals[member];
+      result.pure = result.pure and local.pure;
+      result.no_alloc = result.no_alloc and local.no_alloc;
+      result.recursive = result.recursive or local.recursive;
+      result.stack = std::max(result.stack, local.stack);
+
+      for(u32 edge = offsets[member]; edge < offsets[member + 1]; ++edge) {
+        const u32 callee = components[targets[edge]];
+        if(callee == component) {
+          result.recursive = true;
+          continue;
+        }
+
+        FunctionSummary const& summary = summaries[callee];
+        result.pure = result.pure and summary.pure;
+        result.no_alloc = result.no_alloc and summary.no_alloc;
+        deepest = std::max(deepest, summary.stack);
+      }
+    }
+
+    // * A component of several functions always recurses, so its frames only stack up when it is a single one
+    result.stack = result.recursive ? FunctionSummary::UNBOUNDED : deeper(result.stack, deepest);
+    summaries[component] = result;
+  }
+
+}
@@ -0,0 +1,76 @@
+#include "Cloner.hpp"
+
+namespace fridayc {
+
+  auto Cloner::clone(Expression& expr) noexcept -> Box<Expression> {
+    return Box<Expression>(std::any_cast<Expression*>(visit(expr)));
+  }
+
+  auto Cloner::operator()(Identifier& arg) noexcept -> std::any {
+    auto copy = std::make_unique<Identifier>(arg.id);
+    copy->binding = arg.binding;
+    return copied(arg, std::move(copy));
+  }
+
+  auto Cloner::operator()(BoolLiteral& arg) noexcept -> std::any {
+    return copied(arg, std::make_unique<BoolLiteral>(arg.value));
+  }
+
+  auto Cloner::operator()(ObjectLiteral& arg) noexcept -> std::any {
+    return copied(arg, std::make_unique<ObjectLiteral>(arg.value));
+  }
+
+  auto Cloner::operator()(StringLiteral& arg) noexcept -> std::any {
+    // * A view into the source stays a view, an owned value is copied
+    if(arg.storage.empty()) return copied(arg, std::make_unique<StringLiteral>(arg.value));
+    return copied(arg, std::make_unique<StringLiteral>(arg.storage));
+  }
+
+  auto Cloner::operator()(FloatLiteral& arg) noexcept -> std::any {
+    return copied(arg, std::make_unique<FloatLiteral>(arg.value));
+  }
+
+  auto Cloner::operator()(IntLiteral& arg) noexcept -> std::any {
+    return copied(arg, std::make_unique<IntLiteral>(arg.value));
+  }
+
+  auto Cloner::operator()(CharLiteral& arg) noexcept -> std::any {
+    return copied(arg, std::make_unique<CharLiteral>(arg.value));
+  }
+
+  auto Cloner::operator()(PrefixExpression& arg) noexcept -> std::any {
+    return copied(arg, std::make_unique<PrefixExpression>(arg.oper, clone(*arg.expr)));
+  }
+
+  auto Cloner::operator()(InfixExpression& arg) noexcept -> std::any {
+    return copied(arg, std::make_unique<InfixExpression>(clone(*arg.lhs), arg.oper, clone(*arg.rhs)));
+  }
+
+  auto Cloner::operator()(CallExpression& arg) noexcept -> std::any {
+    auto copy = std::make_unique<CallExpression>(clone(*arg.function));
+    for(auto& argument : arg) copy->add(clone(*argument));
+    return copied(arg, std::move(copy));
+  }
+
+  auto Cloner::operator()(SubscriptExpression& arg) noexcept -> std::any {
+    return copied(arg, std::make_unique<SubscriptExpression>(clone(*arg.array), clone(*arg.index)));
+  }
+
+  auto Cloner::operator()(TypeExpression& arg) noexcept -> std::any {
+    auto copy = std::make_unique<TypeExpression>(arg.name, arg.dimensions);
+    copy->binding = arg.binding;
+    return copied(arg, std::move(copy));
+  }
+
+  auto Cloner::operator()(ArrayLiteral& arg) noexcept -> std::any {
+    auto copy = std::make_unique<ArrayLiteral>();
+    for(auto& value : arg) copy->add(clone(*value));
+    return copied(arg, std::move(copy));
+  }
+
+  auto Cloner::copied(Expression const& original, Box<Expression> copy) const noexcept -> std::any {
+    copy->span = original.span;
+    return copy.release();
+  }
+
+}
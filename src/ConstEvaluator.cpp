@@ -0,0 +1,243 @@
+#include "ConstEvaluator.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    /// @brief Collects the direct effects and callees of one function
+    struct Effects : public Walker {
+      std::vector<FunctionStatement const*> callees { };
+      bool impure { false };
+
+      using Walker::operator();
+
+      auto operator()(PrintStatement& arg) noexcept -> std::any override {
+        impure = true;
+        return { };
+      }
+
+      auto operator()(InfixExpression& arg) noexcept -> std::any override {
+        // * Locals and parameters belong to the call, elements and fields may be shared with the caller
+        const bool assignment = arg.oper == Token::Type::ASSIGN or Token::compoundOperatorOf(arg.oper) != Token::Type::ILLEGAL;
+        if(assignment and not dynamic_cast<Identifier*>(arg.lhs.get())) impure = true;
+        return Walker::operator()(arg);
+      }
+
+      auto operator()(CallExpression& arg) noexcept -> std::any override {
+        Identifier const* name = arg.callee();
+        if(name and name->binding.kind == Binding::Kind::FUNCTION)
+          callees.push_back(static_cast<FunctionStatement const*>(name->binding.declaration));
+        else if(not name or name->binding.kind != Binding::Kind::STRUCT)
+          impure = true;
+
+        for(auto& argument : arg) visit(*argument);
+        return { };
+      }
+    };
+
+  }
+
+  ConstEvaluator::ConstEvaluator(EvaluationLimits limits) noexcept
+    : interpreter { pure, limits }
+  {}
+
+  auto ConstEvaluator::evaluate(Program& program) -> void {
+    purity(program);
+    visit(program);
+  }
+
+  auto ConstEvaluator::evaluatedConstants() const noexcept -> u64 {
+    return constants;
+  }
+
+  auto ConstEvaluator::substitutedCalls() const noexcept -> u64 {
+    return calls;
+  }
+
+  auto ConstEvaluator::memoizedCalls() const noexcept -> u64 {
+    return interpreter.memoized();
+  }
+
+  auto ConstEvaluator::operator()(PrefixExpression& arg) noexcept -> std::any {
+    substitute(arg.expr);
+    return { };
+  }
+
+  auto ConstEvaluator::operator()(InfixExpression& arg) noexcept -> std::any {
+    // * Assigned variables and member names stay as they are
+    if(arg.oper == Token::Type::DOT) substitute(arg.lhs);
+    else if(arg.oper == Token::Type::ASSIGN or Token::compoundOperatorOf(arg.oper) != Token::Type::ILLEGAL) {
+      visit(*arg.lhs);
+      substitute(arg.rhs);
+    } else {
+      substitute(arg.lhs);
+      substitute(arg.rhs);
+    }
+    return { };
+  }
+
+  auto ConstEvaluator::operator()(CallExpression& arg) noexcept -> std::any {
+    for(auto& argument : arg) substitute(argument);
+    return { };
+  }
+
+  auto ConstEvaluator::operator()(SubscriptExpression& arg) noexcept -> std::any {
+    substitute(arg.array);
+    substitute(arg.index);
+    return { };
+  }
+
+  auto ConstEvaluator::operator()(ExpressionStatement& arg) noexcept -> std::any {
+    substitute(arg.expr);
+    return { };
+  }
+
+  auto ConstEvaluator::operator()(ArrayLiteral& arg) noexcept -> std::any {
+    for(auto& value : arg) substitute(value);
+    return { };
+  }
+
+  auto ConstEvaluator::operator()(ReturnStatement& arg) noexcept -> std::any {
+    substitute(arg.expr);
+    return { };
+  }
+
+  auto ConstEvaluator::operator()(PrintStatement& arg) noexcept -> std::any {
+    substitute(arg.expr);
+    return { };
+  }
+
+  auto ConstEvaluator::operator()(IfStatement& arg) noexcept -> std::any {
+    substitute(arg.condition);
+    visit(*arg.block);
+    if(arg.alternative) visit(*arg.alternative);
+    return { };
+  }
+
+  auto ConstEvaluator::operator()(WhileStatement& arg) noexcept -> std::any {
+    substitute(arg.condition);
+    visit(*arg.block);
+    return { };
+  }
+
+  auto ConstEvaluator::operator()(ForStatement& arg) noexcept -> std::any {
+    substitute(arg.initializer);
+    substitute(arg.condition);
+    substitute(arg.modifier);
+    visit(*arg.block);
+    return { };
+  }
+
+  auto ConstEvaluator::operator()(DeclarationStatement& arg) noexcept -> std::any {
+    if(not arg.expr) return { };
+
+    if(arg.constant) {
+      if(std::optional<Value> value = interpreter.evaluate(*arg.expr)) {
+        ++constants;
+        if(Box<Expression> replacement = literal(*value, arg.expr->span)) arg.expr = std::move(replacement);
+        interpreter.define(arg, std::move(*value));
+        return { };
+      }
+    }
+
+    substitute(arg.expr);
+    return { };
+  }
+
+  auto ConstEvaluator::purity(Program& program) -> void {
+    std::vector<FunctionStatement const*> functions;
+    FlatMap<FunctionStatement const*, std::vector<FunctionStatement const*>> callers;
+
+    for(auto& stmt : *program.block) {
+      auto* function = dynamic_cast<FunctionStatement*>(stmt.get());
+      if(not function) continue;
+
+      Effects effects;
+      effects.visit(*function->block);
+
+      functions.push_back(function);
+      pure.insert(function, not effects.impure);
+      for(FunctionStatement const* callee : effects.callees) callers[callee].push_back(function);
+    }
+
+    // * Impurity flows from callees to their callers, each function is queued at most once
+    std::vector<FunctionStatement const*> impure;
+    for(FunctionStatement const* function : functions)
+      if(not *pure.find(function)) impure.push_back(function);
+
+    while(not impure.empty()) {
+      FunctionStatement const* function = impure.back();
+      impure.pop_back();
+
+      if(auto* affected = callers.find(function)) {
+        for(FunctionStatement const* caller : *affected) {
+          bool& caller_pure = *pure.find(caller);
+          if(caller_pure) {
+            caller_pure = false;
+            impure.push_back(caller);
+          }
+        }
+      }
+    }
+  }
+
+  auto ConstEvaluator::substitute(Box<Expression>& slot) noexcept -> void {
+    // * Only constants holding a scalar are known, they are inlined
+    if(auto* name = dynamic_cast<Identifier*>(slot.get())) {
+      if(name->binding.kind != Binding::Kind::LOCAL) return;
+
+      Value const* value = interpreter.constant(*static_cast<DeclarationStatement*>(name->binding.declaration));
+      if(value)
+        if(Box<Expression> replacement = literal(*value, slot->span)) slot = std::move(replacement);
+      return;
+    }
+
+    if(auto* call = dynamic_cast<CallExpression*>(slot.get())) {
+      Identifier const* name = call->callee();
+      bool const* callable = name and name->binding.kind == Binding::Kind::FUNCTION
+        ? pure.find(static_cast<FunctionStatement const*>(name->binding.declaration)) : nullptr;
+
+      if(callable and *callable) {
+        if(std::optional<Value> value = interpreter.evaluate(*call)) {
+          if(Box<Expression> replacement = literal(*value, slot->span)) {
+            slot = std::move(replacement);
+            ++calls;
+            return;
+          }
+        }
+      }
+    }
+
+    visit(*slot);
+  }
+
+  auto ConstEvaluator::literal(Value const& value, Span span) const -> Box<Expression> {
+    Box<Expression> node = std::visit([this, span](auto const& data) -> Box<Expression> {
+      using T = std::decay_t<decltype(data)>;
+
+      if constexpr (std::same_as<T, Long>) return std::make_unique<IntLiteral>(data);
+      else if constexpr (std::same_as<T, Boolean>) return std::make_unique<BoolLiteral>(data);
+      else if constexpr (std::same_as<T, Character>) return std::make_unique<CharLiteral>(data);
+      else if constexpr (std::same_as<T, std::string>) return std::make_unique<StringLiteral>(data);
+      else if constexpr (std::same_as<T, Double>) {
+        // * Infinities and NaN have no literal
+        if(not std::isfinite(data.unwrap())) return nullptr;
+        return std::make_unique<FloatLiteral>(data);
+      }
+      else if constexpr (std::same_as<T, std::shared_ptr<Value::Array const>>) {
+        auto array = std::make_unique<ArrayLiteral>();
+        for(Value const& element : *data) {
+          Box<Expression> item = literal(element, span);
+          if(not item) return nullptr;
+          array->add(std::move(item));
+        }
+        return array;
+      }
+      else return nullptr;
+    }, value.data);
+
+    if(node) node->span = span;
+    return node;
+  }
+
+}
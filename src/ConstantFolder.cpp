@@ -0,0 +1,266 @@
+#include "ConstantFolder.hpp"
+#include "Math.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    using Constant = ConstantFolder::Constant;
+
+    /// @brief Result of an ordered comparison
+    template<class T>
+    constexpr auto compare(Token::Type oper, T lhs, T rhs) noexcept -> std::optional<Constant> {
+      switch(oper) {
+        case Token::Type::LESS: return Boolean{ lhs < rhs };
+        case Token::Type::GREATER: return Boolean{ lhs > rhs };
+        case Token::Type::LESS_EQ: return Boolean{ lhs <= rhs };
+        case Token::Type::GREATER_EQ: return Boolean{ lhs >= rhs };
+        case Token::Type::EQUALS: return Boolean{ lhs == rhs };
+        case Token::Type::NOT_EQ: return Boolean{ lhs != rhs };
+        default: return std::nullopt;
+      }
+    }
+
+    /// @brief Integer operation, throws when the program would overflow or divide by zero
+    auto integer(Token::Type oper, Long lhs, Long rhs) -> std::optional<Constant> {
+      switch(oper) {
+        case Token::Type::PLUS: return Long::checkedSum(lhs, rhs);
+        case Token::Type::MINUS: return Long::checkedDifference(lhs, rhs);
+        case Token::Type::STAR: return Long::checkedProduct(lhs, rhs);
+        case Token::Type::SLASH: return Long::quotient(lhs, rhs);
+        case Token::Type::MODULO: return Long::remainder(lhs, rhs);
+        case Token::Type::BIT_AND: return Long{ lhs & rhs };
+        case Token::Type::BIT_OR: return Long{ lhs | rhs };
+        case Token::Type::LSHIFT:
+        case Token::Type::RSHIFT: {
+          if(rhs < 0 or rhs >= 64) throw std::out_of_range("Shift count out of range.");
+          if(oper == Token::Type::RSHIFT) return Long{ lhs >> rhs };
+
+          // * Bits shifted out, including into the sign, are an overflow
+          const Long shifted = static_cast<i64>(static_cast<u64>(lhs.unwrap()) << rhs);
+          if(shifted >> rhs != lhs) throw std::overflow_error("Integer overflow.");
+          return shifted;
+        }
+        default: return compare<i64>(oper, lhs, rhs);
+      }
+    }
+
+    /// @brief Float operation, std::nullopt unless the result is finite
+    auto floating(Token::Type oper, Double lhs, Double rhs) -> std::optional<Constant> {
+      Double result;
+      switch(oper) {
+        case Token::Type::PLUS: result = Double::sum(lhs, rhs); break;
+        case Token::Type::MINUS: result = Double::difference(lhs, rhs); break;
+        case Token::Type::STAR: result = Double::product(lhs, rhs); break;
+        case Token::Type::SLASH: result = Double::quotient(lhs, rhs); break;
+        default: return compare<f64>(oper, lhs, rhs);
+      }
+
+      if(not math::isfinite(result.unwrap())) return std::nullopt;
+      return result;
+    }
+
+    /// @brief Boolean operation
+    constexpr auto logical(Token::Type oper, Boolean lhs, Boolean rhs) noexcept -> std::optional<Constant> {
+      switch(oper) {
+        case Token::Type::AND: return Boolean::logicAnd(lhs, rhs);
+        case Token::Type::OR: return Boolean::logicOr(lhs, rhs);
+        case Token::Type::EQUALS: return Boolean{ lhs == rhs };
+        case Token::Type::NOT_EQ: return Boolean{ lhs != rhs };
+        default: return std::nullopt;
+      }
+    }
+
+  }
+
+  auto ConstantFolder::fold(Program& program) -> void {
+    visit(program);
+  }
+
+  auto ConstantFolder::folded() const noexcept -> u64 {
+    return expressions;
+  }
+
+  auto ConstantFolder::evaluated() const noexcept -> u64 {
+    return operations;
+  }
+
+  auto ConstantFolder::operator()(BoolLiteral& arg) noexcept -> std::any {
+    return Constant{ arg.value };
+  }
+
+  auto ConstantFolder::operator()(FloatLiteral& arg) noexcept -> std::any {
+    return Constant{ arg.value };
+  }
+
+  auto ConstantFolder::operator()(IntLiteral& arg) noexcept -> std::any {
+    return Constant{ arg.value };
+  }
+
+  auto ConstantFolder::operator()(CharLiteral& arg) noexcept -> std::any {
+    return Constant{ arg.value };
+  }
+
+  auto ConstantFolder::operator()(PrefixExpression& arg) noexcept -> std::any {
+    const std::optional<Constant> operand = evaluate(*arg.expr);
+
+    try {
+      if(operand) {
+        if(std::optional<Constant> value = unary(arg.oper, *operand)) {
+          ++operations;
+          return *value;
+        }
+      }
+    } catch(std::exception const&) {
+      // * Faulting operations are left to run time, their operand is still folded
+    }
+
+    replace(arg.expr, operand);
+    return { };
+  }
+
+  auto ConstantFolder::operator()(InfixExpression& arg) noexcept -> std::any {
+    // * The right-hand side of a member access is a name
+    if(arg.oper == Token::Type::DOT) {
+      fold(arg.lhs);
+      return { };
+    }
+
+    const std::optional<Constant> lhs = evaluate(*arg.lhs);
+    const std::optional<Constant> rhs = evaluate(*arg.rhs);
+
+    try {
+      if(lhs and rhs) {
+        if(std::optional<Constant> value = binary(arg.oper, *lhs, *rhs)) {
+          ++operations;
+          return *value;
+        }
+      }
+    } catch(std::exception const&) {
+      // * Faulting operations are left to run time, their operands are still folded
+    }
+
+    replace(arg.lhs, lhs);
+    replace(arg.rhs, rhs);
+    return { };
+  }
+
+  auto ConstantFolder::operator()(CallExpression& arg) noexcept -> std::any {
+    fold(arg.function);
+    for(auto& argument : arg) fold(argument);
+    return { };
+  }
+
+  auto ConstantFolder::operator()(SubscriptExpression& arg) noexcept -> std::any {
+    fold(arg.array);
+    fold(arg.index);
+    return { };
+  }
+
+  auto ConstantFolder::operator()(ExpressionStatement& arg) noexcept -> std::any {
+    fold(arg.expr);
+    return { };
+  }
+
+  auto ConstantFolder::operator()(ArrayLiteral& arg) noexcept -> std::any {
+    for(auto& value : arg) fold(value);
+    return { };
+  }
+
+  auto ConstantFolder::operator()(ReturnStatement& arg) noexcept -> std::any {
+    fold(arg.expr);
+    return { };
+  }
+
+  auto ConstantFolder::operator()(PrintStatement& arg) noexcept -> std::any {
+    fold(arg.expr);
+    return { };
+  }
+
+  auto ConstantFolder::operator()(IfStatement& arg) noexcept -> std::any {
+    fold(arg.condition);
+    visit(*arg.block);
+    if(arg.alternative) visit(*arg.alternative);
+    return { };
+  }
+
+  auto ConstantFolder::operator()(WhileStatement& arg) noexcept -> std::any {
+    fold(arg.condition);
+    visit(*arg.block);
+    return { };
+  }
+
+  auto ConstantFolder::operator()(ForStatement& arg) noexcept -> std::any {
+    fold(arg.initializer);
+    fold(arg.condition);
+    fold(arg.modifier);
+    visit(*arg.block);
+    return { };
+  }
+
+  auto ConstantFolder::operator()(DeclarationStatement& arg) noexcept -> std::any {
+    if(arg.expr) fold(arg.expr);
+    return { };
+  }
+
+  auto ConstantFolder::evaluate(Expression& expr) noexcept -> std::optional<Constant> {
+    const std::any value = visit(expr);
+    Constant const* constant = std::any_cast<Constant>(&value);
+    return constant ? std::optional<Constant>{ *constant } : std::nullopt;
+  }
+
+  auto ConstantFolder::replace(Box<Expression>& slot, std::optional<Constant> const& value) noexcept -> void {
+    // * Literals are already folded, only operators are replaced
+    if(not value or not (dynamic_cast<PrefixExpression*>(slot.get()) or dynamic_cast<InfixExpression*>(slot.get()))) return;
+
+    Box<Expression> literal = std::visit([](auto constant) -> Box<Expression> {
+      using T = decltype(constant);
+      if constexpr (std::same_as<T, Long>) return std::make_unique<IntLiteral>(constant);
+      else if constexpr (std::same_as<T, Double>) return std::make_unique<FloatLiteral>(constant);
+      else if constexpr (std::same_as<T, Boolean>) return std::make_unique<BoolLiteral>(constant);
+      else return std::make_unique<CharLiteral>(constant);
+    }, *value);
+
+    literal->span = slot->span;
+    slot = std::move(literal);
+    ++expressions;
+  }
+
+  auto ConstantFolder::fold(Box<Expression>& slot) noexcept -> void {
+    replace(slot, evaluate(*slot));
+  }
+
+  auto ConstantFolder::unary(Token::Type oper, Constant const& operand) -> std::optional<Constant> {
+    if(Long const* value = std::get_if<Long>(&operand)) {
+      switch(oper) {
+        case Token::Type::PLUS: return *value;
+        case Token::Type::MINUS: return Long::checkedNegation(*value);
+        case Token::Type::BIT_NOT: return Long{ ~value->unwrap() };
+        default: return std::nullopt;
+      }
+    }
+
+    if(Double const* value = std::get_if<Double>(&operand)) {
+      switch(oper) {
+        case Token::Type::PLUS: return *value;
+        case Token::Type::MINUS: return Double{ -value->unwrap() };
+        default: return std::nullopt;
+      }
+    }
+
+    if(Boolean const* value = std::get_if<Boolean>(&operand); value and oper == Token::Type::NOT)
+      return Boolean::logicNot(*value);
+
+    return std::nullopt;
+  }
+
+  auto ConstantFolder::binary(Token::Type oper, Constant const& lhs, Constant const& rhs) -> std::optional<Constant> {
+    if(lhs.index() != rhs.index()) return std::nullopt;
+
+    if(Long const* value = std::get_if<Long>(&lhs)) return integer(oper, *value, std::get<Long>(rhs));
+    if(Double const* value = std::get_if<Double>(&lhs)) return floating(oper, *value, std::get<Double>(rhs));
+    if(Boolean const* value = std::get_if<Boolean>(&lhs)) return logical(oper, *value, std::get<Boolean>(rhs));
+    return compare<i8>(oper, std::get<Character>(lhs), std::get<Character>(rhs));
+  }
+
+}
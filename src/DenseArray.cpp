@@ -0,0 +1,384 @@
+#include "DenseArray.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace fridayc::runtime {
+
+  namespace {
+
+    /// @brief Key of a float that orders like the float as an int, -0.0 before 0.0, NaNs aside
+    /// @note The mapping is its own inverse
+    constexpr auto key(i64 bits) noexcept -> i64 {
+      return bits ^ (i64)((u64)(bits >> 63) >> 1);
+    }
+
+    /// @brief Stores an exact sum if it fits in an int
+    auto fits(__int128 total, i64& result) noexcept -> bool {
+      if(total < std::numeric_limits<i64>::min() or total > std::numeric_limits<i64>::max()) return false;
+      result = (i64)total;
+      return true;
+    }
+
+    namespace scalar {
+
+      auto add(i64 const* lhs, i64 const* rhs, i64* out, u64 size) noexcept -> u64 {
+        for(u64 i = 0; i < size; ++i)
+          if(i64 result; __builtin_add_overflow(lhs[i], rhs[i], &result)) return i;
+          else out[i] = result;
+        return size;
+      }
+
+      auto sub(i64 const* lhs, i64 const* rhs, i64* out, u64 size) noexcept -> u64 {
+        for(u64 i = 0; i < size; ++i)
+          if(i64 result; __builtin_sub_overflow(lhs[i], rhs[i], &result)) return i;
+          else out[i] = result;
+        return size;
+      }
+
+      auto mul(i64 const* lhs, i64 const* rhs, i64* out, u64 size) noexcept -> u64 {
+        for(u64 i = 0; i < size; ++i)
+          if(i64 result; __builtin_mul_overflow(lhs[i], rhs[i], &result)) return i;
+          else out[i] = result;
+        return size;
+      }
+
+      auto div(i64 const* lhs, i64 const* rhs, i64* out, u64 size) noexcept -> u64 {
+        for(u64 i = 0; i < size; ++i) {
+          if(rhs[i] == 0 or (lhs[i] == std::numeric_limits<i64>::min() and rhs[i] == -1)) return i;
+          out[i] = lhs[i] / rhs[i];
+        }
+        return size;
+      }
+
+      auto fadd(f64 const* lhs, f64 const* rhs, f64* out, u64 size) noexcept -> u64 {
+        for(u64 i = 0; i < size; ++i) out[i] = lhs[i] + rhs[i];
+        return size;
+      }
+
+      auto fsub(f64 const* lhs, f64 const* rhs, f64* out, u64 size) noexcept -> u64 {
+        for(u64 i = 0; i < size; ++i) out[i] = lhs[i] - rhs[i];
+        return size;
+      }
+
+      auto fmul(f64 const* lhs, f64 const* rhs, f64* out, u64 size) noexcept -> u64 {
+        for(u64 i = 0; i < size; ++i) out[i] = lhs[i] * rhs[i];
+        return size;
+      }
+
+      auto fdiv(f64 const* lhs, f64 const* rhs, f64* out, u64 size) noexcept -> u64 {
+        for(u64 i = 0; i < size; ++i) {
+          if(rhs[i] == 0.) return i;
+          out[i] = lhs[i] / rhs[i];
+        }
+        return size;
+      }
+
+      auto sum(i64 const* values, u64 size, i64& result) noexcept -> bool {
+        __int128 total = 0;
+        for(u64 i = 0; i < size; ++i) total += values[i];
+        return fits(total, result);
+      }
+
+      auto fsum(f64 const* values, u64 size) noexcept -> f64 {
+        f64 lanes[4] = { 0., 0., 0., 0. };
+        u64 i = 0;
+        for(; i + 4 <= size; i += 4)
+          for(u64 lane = 0; lane < 4; ++lane) lanes[lane] += values[i + lane];
+
+        f64 total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        for(; i < size; ++i) total += values[i];
+        return total;
+      }
+
+      auto min(i64 const* values, u64 size) noexcept -> i64 {
+        return *std::min_element(values, values + size);
+      }
+
+      auto max(i64 const* values, u64 size) noexcept -> i64 {
+        return *std::max_element(values, values + size);
+      }
+
+      /// @brief Bound of a float run through the keys of its elements
+      template<bool MAX>
+      auto bound(f64 const* values, u64 size) noexcept -> f64 {
+        i64 best = key(std::bit_cast<i64>(values[0]));
+        for(u64 i = 0; i < size; ++i) {
+          if(std::isnan(values[i])) return std::numeric_limits<f64>::quiet_NaN();
+          const i64 candidate = key(std::bit_cast<i64>(values[i]));
+          best = MAX ? std::max(best, candidate) : std::min(best, candidate);
+        }
+        return std::bit_cast<f64>(key(best));
+      }
+
+      auto fill(i64* out, i64 value, u64 size) noexcept -> void {
+        std::fill_n(out, size, value);
+      }
+
+      auto ffill(f64* out, f64 value, u64 size) noexcept -> void {
+        std::fill_n(out, size, value);
+      }
+
+      auto copy(void const* from, void* to, u64 bytes) noexcept -> void {
+        std::memcpy(to, from, bytes);
+      }
+
+    }
+
+#if defined(__x86_64__)
+    /// @brief Kernels on 4 lanes of 64 bits, the rest of a run goes to the scalar ones
+    /// @note A vector with a faulting lane is left to the scalar kernels too, which write the lanes before it
+    /// @note AVX2 has no 64-bit multiplication or division, those stay scalar
+    namespace avx2 {
+
+      [[gnu::target("avx2")]] auto load(i64 const* at) noexcept -> __m256i {
+        return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(at));
+      }
+
+      [[gnu::target("avx2")]] auto store(i64* at, __m256i value) noexcept -> void {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(at), value);
+      }
+
+      /// @brief Lanes whose sign bit is set, as the low 4 bits
+      [[gnu::target("avx2")]] auto signs(__m256i value) noexcept -> u32 {
+        return (u32)_mm256_movemask_pd(_mm256_castsi256_pd(value));
+      }
+
+      [[gnu::target("avx2")]] auto add(i64 const* lhs, i64 const* rhs, i64* out, u64 size) noexcept -> u64 {
+        u64 i = 0;
+        for(; i + 4 <= size; i += 4) {
+          const __m256i a = load(lhs + i), b = load(rhs + i);
+          const __m256i result = _mm256_add_epi64(a, b);
+
+          // * A sum overflowed when its sign differs from the signs of both operands
+          if(signs(_mm256_and_si256(_mm256_xor_si256(a, result), _mm256_xor_si256(b, result)))) break;
+          store(out + i, result);
+        }
+        return i + scalar::add(lhs + i, rhs + i, out + i, size - i);
+      }
+
+      [[gnu::target("avx2")]] auto sub(i64 const* lhs, i64 const* rhs, i64* out, u64 size) noexcept -> u64 {
+        u64 i = 0;
+        for(; i + 4 <= size; i += 4) {
+          const __m256i a = load(lhs + i), b = load(rhs + i);
+          const __m256i result = _mm256_sub_epi64(a, b);
+
+          // * A difference overflowed when the operands differ in sign and the result has the sign of the subtrahend
+          if(signs(_mm256_and_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, result)))) break;
+          store(out + i, result);
+        }
+        return i + scalar::sub(lhs + i, rhs + i, out + i, size - i);
+      }
+
+      [[gnu::target("avx2")]] auto fadd(f64 const* lhs, f64 const* rhs, f64* out, u64 size) noexcept -> u64 {
+        u64 i = 0;
+        for(; i + 4 <= size; i += 4) _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+        return i + scalar::fadd(lhs + i, rhs + i, out + i, size - i);
+      }
+
+      [[gnu::target("avx2")]] auto fsub(f64 const* lhs, f64 const* rhs, f64* out, u64 size) noexcept -> u64 {
+        u64 i = 0;
+        for(; i + 4 <= size; i += 4) _mm256_storeu_pd(out + i, _mm256_sub_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+        return i + scalar::fsub(lhs + i, rhs + i, out + i, size - i);
+      }
+
+      [[gnu::target("avx2")]] auto fmul(f64 const* lhs, f64 const* rhs, f64* out, u64 size) noexcept -> u64 {
+        u64 i = 0;
+        for(; i + 4 <= size; i += 4) _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+        return i + scalar::fmul(lhs + i, rhs + i, out + i, size - i);
+      }
+
+      [[gnu::target("avx2")]] auto fdiv(f64 const* lhs, f64 const* rhs, f64* out, u64 size) noexcept -> u64 {
+        const __m256d zero = _mm256_setzero_pd();
+        u64 i = 0;
+        for(; i + 4 <= size; i += 4) {
+          const __m256d b = _mm256_loadu_pd(rhs + i);
+          if(_mm256_movemask_pd(_mm256_cmp_pd(b, zero, _CMP_EQ_OQ))) break;
+          _mm256_storeu_pd(out + i, _mm256_div_pd(_mm256_loadu_pd(lhs + i), b));
+        }
+        return i + scalar::fdiv(lhs + i, rhs + i, out + i, size - i);
+      }
+
+      [[gnu::target("avx2")]] auto sum(i64 const* values, u64 size, i64& result) noexcept -> bool {
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i sums = zero, carries = zero;
+        u64 i = 0;
+        for(; i + 4 <= size; i += 4) {
+          const __m256i value = load(values + i);
+          const __m256i next = _mm256_add_epi64(sums, value);
+
+          // * Each lane wraps around, counting +1 when a positive value carried out of it and -1 when a negative one did
+          const __m256i wrapped = _mm256_cmpgt_epi64(zero, _mm256_and_si256(_mm256_xor_si256(sums, next), _mm256_xor_si256(value, next)));
+          const __m256i negative = _mm256_cmpgt_epi64(zero, value);
+          carries = _mm256_sub_epi64(carries, _mm256_andnot_si256(negative, wrapped));
+          carries = _mm256_add_epi64(carries, _mm256_and_si256(negative, wrapped));
+          sums = next;
+        }
+
+        alignas(32) i64 lanes[4], counts[4];
+        store(lanes, sums);
+        store(counts, carries);
+
+        __int128 total = 0;
+        for(u64 lane = 0; lane < 4; ++lane) total += lanes[lane] + (__int128)counts[lane] * ((__int128)1 << 64);
+        for(; i < size; ++i) total += values[i];
+        return fits(total, result);
+      }
+
+      [[gnu::target("avx2")]] auto fsum(f64 const* values, u64 size) noexcept -> f64 {
+        __m256d sums = _mm256_setzero_pd();
+        u64 i = 0;
+        for(; i + 4 <= size; i += 4) sums = _mm256_add_pd(sums, _mm256_loadu_pd(values + i));
+
+        alignas(32) f64 lanes[4];
+        _mm256_store_pd(lanes, sums);
+        f64 total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        for(; i < size; ++i) total += values[i];
+        return total;
+      }
+
+      /// @brief Bound of the ints of a run, or of the keys of its floats
+      template<bool MAX>
+      [[gnu::target("avx2")]] auto bound(__m256i best, i64 const* values, u64 size, u64& i) noexcept -> __m256i {
+        for(; i + 4 <= size; i += 4) {
+          const __m256i value = load(values + i);
+          const __m256i better = MAX ? _mm256_cmpgt_epi64(value, best) : _mm256_cmpgt_epi64(best, value);
+          best = _mm256_blendv_epi8(best, value, better);
+        }
+        return best;
+      }
+
+      template<bool MAX>
+      [[gnu::target("avx2")]] auto ints(i64 const* values, u64 size) noexcept -> i64 {
+        u64 i = 0;
+        alignas(32) i64 lanes[4];
+        store(lanes, bound<MAX>(_mm256_set1_epi64x(values[0]), values, size, i));
+
+        i64 best = MAX ? *std::max_element(lanes, lanes + 4) : *std::min_element(lanes, lanes + 4);
+        for(; i < size; ++i) best = MAX ? std::max(best, values[i]) : std::min(best, values[i]);
+        return best;
+      }
+
+      [[gnu::target("avx2")]] auto min(i64 const* values, u64 size) noexcept -> i64 {
+        return ints<false>(values, size);
+      }
+
+      [[gnu::target("avx2")]] auto max(i64 const* values, u64 size) noexcept -> i64 {
+        return ints<true>(values, size);
+      }
+
+      template<bool MAX>
+      [[gnu::target("avx2")]] auto floats(f64 const* values, u64 size) noexcept -> f64 {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i magnitude = _mm256_set1_epi64x(std::numeric_limits<i64>::max());
+        __m256d nans = _mm256_setzero_pd();
+        __m256i best = _mm256_set1_epi64x(key(std::bit_cast<i64>(values[0])));
+        u64 i = 0;
+        for(; i + 4 <= size; i += 4) {
+          const __m256d value = _mm256_loadu_pd(values + i);
+          nans = _mm256_or_pd(nans, _mm256_cmp_pd(value, value, _CMP_UNORD_Q));
+
+          // * The keys of negative floats flip all bits but the sign
+          const __m256i bits = _mm256_castpd_si256(value);
+          const __m256i keys = _mm256_xor_si256(bits, _mm256_and_si256(_mm256_cmpgt_epi64(zero, bits), magnitude));
+          const __m256i better = MAX ? _mm256_cmpgt_epi64(keys, best) : _mm256_cmpgt_epi64(best, keys);
+          best = _mm256_blendv_epi8(best, keys, better);
+        }
+        if(_mm256_movemask_pd(nans)) return std::numeric_limits<f64>::quiet_NaN();
+
+        alignas(32) i64 lanes[4];
+        store(lanes, best);
+        i64 bound = MAX ? *std::max_element(lanes, lanes + 4) : *std::min_element(lanes, lanes + 4);
+        for(; i < size; ++i) {
+          if(std::isnan(values[i])) return std::numeric_limits<f64>::quiet_NaN();
+          const i64 candidate = key(std::bit_cast<i64>(values[i]));
+          bound = MAX ? std::max(bound, candidate) : std::min(bound, candidate);
+        }
+        return std::bit_cast<f64>(key(bound));
+      }
+
+      [[gnu::target("avx2")]] auto fmin(f64 const* values, u64 size) noexcept -> f64 {
+        return floats<false>(values, size);
+      }
+
+      [[gnu::target("avx2")]] auto fmax(f64 const* values, u64 size) noexcept -> f64 {
+        return floats<true>(values, size);
+      }
+
+      [[gnu::target("avx2")]] auto fill(i64* out, i64 value, u64 size) noexcept -> void {
+        const __m256i values = _mm256_set1_epi64x(value);
+        u64 i = 0;
+        for(; i + 4 <= size; i += 4) store(out + i, values);
+        scalar::fill(out + i, value, size - i);
+      }
+
+      [[gnu::target("avx2")]] auto ffill(f64* out, f64 value, u64 size) noexcept -> void {
+        const __m256d values = _mm256_set1_pd(value);
+        u64 i = 0;
+        for(; i + 4 <= size; i += 4) _mm256_storeu_pd(out + i, values);
+        scalar::ffill(out + i, value, size - i);
+      }
+
+      [[gnu::target("avx2")]] auto copy(void const* from, void* to, u64 bytes) noexcept -> void {
+        auto* source = static_cast<u8 const*>(from);
+        auto* target = static_cast<u8*>(to);
+        u64 i = 0;
+        for(; i + 64 <= bytes; i += 64) {
+          const __m256i first = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(source + i));
+          const __m256i second = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(source + i + 32));
+          _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), first);
+          _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i + 32), second);
+        }
+        scalar::copy(source + i, target + i, bytes - i);
+      }
+
+    }
+#endif
+
+    constexpr Kernels SCALAR {
+      .isa = Kernels::Isa::SCALAR, .name = "scalar",
+      .add = scalar::add, .sub = scalar::sub, .mul = scalar::mul, .div = scalar::div,
+      .fadd = scalar::fadd, .fsub = scalar::fsub, .fmul = scalar::fmul, .fdiv = scalar::fdiv,
+      .sum = scalar::sum, .fsum = scalar::fsum,
+      .min = scalar::min, .max = scalar::max, .fmin = scalar::bound<false>, .fmax = scalar::bound<true>,
+      .fill = scalar::fill, .ffill = scalar::ffill, .copy = scalar::copy
+    };
+
+#if defined(__x86_64__)
+    constexpr Kernels AVX2 {
+      .isa = Kernels::Isa::AVX2, .name = "avx2",
+      .add = avx2::add, .sub = avx2::sub, .mul = scalar::mul, .div = scalar::div,
+      .fadd = avx2::fadd, .fsub = avx2::fsub, .fmul = avx2::fmul, .fdiv = avx2::fdiv,
+      .sum = avx2::sum, .fsum = avx2::fsum,
+      .min = avx2::min, .max = avx2::max, .fmin = avx2::fmin, .fmax = avx2::fmax,
+      .fill = avx2::fill, .ffill = avx2::ffill, .copy = avx2::copy
+    };
+#endif
+
+  }
+
+  auto kernels(Kernels::Isa isa) noexcept -> Kernels const* {
+    switch(isa) {
+      case Kernels::Isa::SCALAR: return &SCALAR;
+      case Kernels::Isa::AVX2:
+#if defined(__x86_64__)
+        if(__builtin_cpu_supports("avx2")) return &AVX2;
+#endif
+        return nullptr;
+    }
+    return nullptr;
+  }
+
+  auto kernels() noexcept -> Kernels const& {
+    static Kernels const& selected = kernels(Kernels::Isa::AVX2) ? *kernels(Kernels::Isa::AVX2) : SCALAR;
+    return selected;
+  }
+
+  auto describe(std::span<u64 const> extents) -> std::string {
+    std::string result = "["s;
+    for(u64 i = 0; i < extents.size(); ++i) result += "{}{}"f.format(i ? ", "sv : ""sv, extents[i]);
+    return result + "]"s;
+  }
+
+}
@@ -0,0 +1,42 @@
+#include "Error.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    struct ConsoleColor {
+      static constexpr const auto BLACK = "\u001B[30m"sv;
+      static constexpr const auto RED = "\u001B[31m"sv;
+      static constexpr const auto GREEN = "\u001B[32m"sv;
+      static constexpr const auto YELLOW = "\u001B[33m"sv;
+      static constexpr const auto BLUE = "\u001B[34m"sv;
+      static constexpr const auto PURPLE = "\u001B[35m"sv;
+      static constexpr const auto CYAN = "\u001B[36m"sv;
+      static constexpr const auto WHITE = "\u001B[37m"sv;  
+    };
+
+  }
+
+  auto report(Error const& error) -> void {
+    const u32 file = error.span.file;
+    const auto max_digits = (u32)std::ceil(std::log10(Sources::lines(file) + 1)); 
+    const Location at = Sources::locate(error.span);
+    const u32 length = std::max<u32>(error.span.length, 1);
+    std::string_view line = Sources::line(file, at.row);
+    u64 col = std::min(line.length(), (u64)at.col-1);
+    u64 col2 = std::min(line.length(), col + length);
+
+    std::cout 
+    << ConsoleColor::RED << "[ERROR] " << ConsoleColor::WHITE 
+    << "In file " << Sources::path(file) << ':' << at.row << ':' << at.col << ": " 
+    << ConsoleColor::RED << error.message << ConsoleColor::WHITE << '\n'
+    << "  " << std::setfill(' ') << std::setw(max_digits) << std::right << at.row << "  |  "
+    << line.substr(0, col) << ConsoleColor::RED 
+    << line.substr(col, length) << ConsoleColor::WHITE 
+    << line.substr(col2) << '\n'
+    << std::setfill(' ') << std::setw(max_digits + 4) << "" << "|  "
+    << std::setfill(' ') << std::setw(col) << "" << ConsoleColor::RED << '^'
+    << std::setfill('~') << std::setw(length-1) << "" << ConsoleColor::WHITE << std::endl;
+  }
+
+}
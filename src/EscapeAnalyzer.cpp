@@ -0,0 +1,154 @@
+#include "EscapeAnalyzer.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    /// @brief Whether an expression makes a new struct or array
+    auto constructs(Expression const& expr) noexcept -> bool {
+      if(dynamic_cast<ArrayLiteral const*>(&expr)) return true;
+      auto const* call = dynamic_cast<CallExpression const*>(&expr);
+      Identifier const* name = call ? call->callee() : nullptr;
+      return name and name->binding.kind == Binding::Kind::STRUCT;
+    }
+
+  }
+
+  auto EscapeAnalyzer::analyze(Program& program) -> void {
+    visit(program);
+  }
+
+  auto EscapeAnalyzer::lifetime(Expression const& literal) const noexcept -> Lifetime const* {
+    return lifetimes.find(&literal);
+  }
+
+  auto EscapeAnalyzer::slots(Statement const& loop) const noexcept -> std::vector<u32> const* {
+    return cleared.find(&loop);
+  }
+
+  auto EscapeAnalyzer::allocates(FunctionStatement const& function) const noexcept -> bool {
+    return regional.contains(&function);
+  }
+
+  auto EscapeAnalyzer::count(Lifetime::Kind kind) const noexcept -> u64 {
+    return counts[(u8)kind];
+  }
+
+  auto EscapeAnalyzer::report(std::ostream& out) const -> void {
+    for(Expression const* expr : order) {
+      Lifetime const& lifetime = *lifetimes.find(expr);
+      const Span span = expr->span;
+      const Location at = Sources::locate(span);
+      std::string_view text = Sources::text(span.file).substr(span.offset, span.length);
+      out << "{}:{}:{}: '{}' "f.format(Sources::path(span.file), at.row, at.col, text);
+
+      switch(lifetime.kind) {
+        case Lifetime::Kind::HEAP:
+          out << "escapes to the heap";
+          break;
+        case Lifetime::Kind::CALL:
+          out << "dies with its call";
+          break;
+        case Lifetime::Kind::ITERATION: {
+          const Location loop = Sources::locate(lifetime.loop->span);
+          out << "dies with each iteration of the loop at {}:{}"f.format(loop.row, loop.col);
+          break;
+        }
+      }
+      out << '\n';
+    }
+  }
+
+  auto EscapeAnalyzer::operator()(InfixExpression& arg) noexcept -> std::any {
+    if(arg.oper == Token::Type::ASSIGN or Token::compoundOperatorOf(arg.oper) != Token::Type::ILLEGAL) escape(*arg.rhs);
+    return Walker::operator()(arg);
+  }
+
+  auto EscapeAnalyzer::operator()(CallExpression& arg) noexcept -> std::any {
+    for(auto const& argument : arg) escape(*argument);
+    record(arg);
+    return Walker::operator()(arg);
+  }
+
+  auto EscapeAnalyzer::operator()(ArrayLiteral& arg) noexcept -> std::any {
+    for(auto const& value : arg) escape(*value);
+    record(arg);
+    return Walker::operator()(arg);
+  }
+
+  auto EscapeAnalyzer::operator()(ReturnStatement& arg) noexcept -> std::any {
+    escape(*arg.expr);
+    return Walker::operator()(arg);
+  }
+
+  auto EscapeAnalyzer::operator()(WhileStatement& arg) noexcept -> std::any {
+    loops.push_back(&arg);
+    Walker::operator()(arg);
+    loops.pop_back();
+    return { };
+  }
+
+  // * The initializer runs once, before the first iteration, it belongs to the enclosing loop
+  auto EscapeAnalyzer::operator()(ForStatement& arg) noexcept -> std::any {
+    visit(*arg.initializer);
+    loops.push_back(&arg);
+    visit(*arg.condition);
+    visit(*arg.modifier);
+    visit(*arg.block);
+    loops.pop_back();
+    return { };
+  }
+
+  auto EscapeAnalyzer::operator()(FunctionStatement& arg) noexcept -> std::any {
+    function = &arg;
+    loops.clear();
+    literals.clear();
+    escaping.clear();
+    escaped.clear();
+    visit(*arg.block);
+    classify();
+    function = nullptr;
+    return { };
+  }
+
+  auto EscapeAnalyzer::operator()(DeclarationStatement& arg) noexcept -> std::any {
+    // * Literals are recorded before the ones nested in them, so the initializer is the first recorded while walking it
+    const u64 first = literals.size();
+    Walker::operator()(arg);
+    if(not arg.expr) return { };
+
+    if(first < literals.size() and literals[first].expr == arg.expr.get()) literals[first].declaration = &arg;
+    else escape(*arg.expr);
+    return { };
+  }
+
+  auto EscapeAnalyzer::escape(Expression const& expr) noexcept -> void {
+    if(constructs(expr)) escaping.insert(&expr, true);
+    else if(auto const* name = dynamic_cast<Identifier const*>(&expr); name and name->binding.kind == Binding::Kind::LOCAL)
+      escaped.insert(static_cast<DeclarationStatement const*>(name->binding.declaration), true);
+  }
+
+  auto EscapeAnalyzer::record(Expression const& expr) noexcept -> void {
+    if(function and constructs(expr)) literals.push_back(Literal{ &expr, nullptr, loops.empty() ? nullptr : loops.back() });
+  }
+
+  auto EscapeAnalyzer::classify() noexcept -> void {
+    for(Literal const& literal : literals) {
+      Lifetime lifetime;
+      const bool escapes = escaping.contains(literal.expr) or (literal.declaration and escaped.contains(literal.declaration));
+      if(not escapes and literal.loop) {
+        lifetime = Lifetime{ Lifetime::Kind::ITERATION, literal.loop };
+
+        // * Every loop making values of its iterations gets slots to clear, even if they are all temporaries
+        std::vector<u32>& slots = cleared[literal.loop];
+        if(literal.declaration and std::ranges::find(slots, literal.declaration->slot) == slots.end()) slots.push_back(literal.declaration->slot);
+      } else if(not escapes) lifetime = Lifetime{ Lifetime::Kind::CALL };
+
+      if(lifetime.kind != Lifetime::Kind::HEAP) regional.insert(function, true);
+      ++counts[(u8)lifetime.kind];
+      lifetimes.insert(literal.expr, lifetime);
+      order.push_back(literal.expr);
+    }
+  }
+
+}
@@ -0,0 +1,729 @@
+#include "Executor.hpp"
+#include "Analyzer.hpp"
+#include "EscapeAnalyzer.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    using namespace runtime;
+
+    using Flow = Executor::Flow;
+    using Thunk = Executor::Thunk;
+
+    template<class T>
+    using Code = Executor::Code<T>;
+
+    /// @brief Moves references out of a cell, so the cell does not keep them alive
+    template<class T>
+    auto take(Cell& cell) noexcept -> T {
+      if constexpr (std::same_as<T, Ref>) return std::move(cell.object);
+      else return load<T>(cell);
+    }
+
+    /// @brief Operands read in place, they are inlined into the closure of the operation
+    template<class T>
+    struct Constant {
+      T value;
+      auto operator()(Cell*) const noexcept -> T { return value; }
+    };
+
+    template<class T>
+    struct Slot {
+      u32 slot;
+      auto operator()(Cell* frame) const noexcept -> T { return load<T>(frame[slot]); }
+    };
+
+    template<class T>
+    struct Computed {
+      Code<T> code;
+      auto operator()(Cell* frame) const -> T { return code(frame); }
+    };
+
+    template<class T>
+    using Operand = std::variant<T, u32, Code<T>>;
+
+    template<class T, class Body>
+    auto with(Operand<T> operand, Body&& body) -> Thunk {
+      switch(operand.index()) {
+        case 0: return body(Constant<T>{ std::get<0>(operand) });
+        case 1: return body(Slot<T>{ std::get<1>(operand) });
+        default: return body(Computed<T>{ std::get<2>(std::move(operand)) });
+      }
+    }
+
+    /// @brief Closure of a binary operation, operands are evaluated left to right
+    template<class T, class Op>
+    auto combine(Operand<T> lhs, Operand<T> rhs, Op op) -> Thunk {
+      return with<T>(std::move(lhs), [&](auto left) {
+        return with<T>(std::move(rhs), [&](auto right) -> Thunk {
+          using R = std::invoke_result_t<Op, T, T>;
+          return Code<R>{ [left, right, op](Cell* frame) -> R {
+            const T value = left(frame);
+            return op(value, right(frame));
+          } };
+        });
+      });
+    }
+
+    template<class T, class Use>
+    auto ordered(Token::Type oper, Use&& use) -> std::optional<Thunk> {
+      switch(oper) {
+        case Token::Type::LESS: return use(std::less<T>{ });
+        case Token::Type::GREATER: return use(std::greater<T>{ });
+        case Token::Type::LESS_EQ: return use(std::less_equal<T>{ });
+        case Token::Type::GREATER_EQ: return use(std::greater_equal<T>{ });
+        case Token::Type::EQUALS: return use(std::equal_to<T>{ });
+        case Token::Type::NOT_EQ: return use(std::not_equal_to<T>{ });
+        default: return std::nullopt;
+      }
+    }
+
+    /// @brief Calls use() with the operation of an operator on two values of type T
+    /// @return what use() returns, std::nullopt if the operator does not apply to T
+    template<class T, class Use>
+    auto operation(Token::Type oper, Span span, Use&& use) -> std::optional<Thunk> {
+      if constexpr (std::same_as<T, i64>) {
+        switch(oper) {
+          case Token::Type::PLUS: return use([span](i64 lhs, i64 rhs) { return sum(lhs, rhs, span); });
+          case Token::Type::MINUS: return use([span](i64 lhs, i64 rhs) { return difference(lhs, rhs, span); });
+          case Token::Type::STAR: return use([span](i64 lhs, i64 rhs) { return product(lhs, rhs, span); });
+          case Token::Type::SLASH: return use([span](i64 lhs, i64 rhs) { return quotient(lhs, rhs, span); });
+          case Token::Type::MODULO: return use([span](i64 lhs, i64 rhs) { return remainder(lhs, rhs, span); });
+          case Token::Type::BIT_AND: return use([](i64 lhs, i64 rhs) { return lhs & rhs; });
+          case Token::Type::BIT_OR: return use([](i64 lhs, i64 rhs) { return lhs | rhs; });
+          case Token::Type::LSHIFT: return use([span](i64 lhs, i64 rhs) { return shiftLeft(lhs, rhs, span); });
+          case Token::Type::RSHIFT: return use([span](i64 lhs, i64 rhs) { return shiftRight(lhs, rhs, span); });
+          default: return ordered<i64>(oper, use);
+        }
+      } else if constexpr (std::same_as<T, f64>) {
+        switch(oper) {
+          case Token::Type::PLUS: return use(std::plus<f64>{ });
+          case Token::Type::MINUS: return use(std::minus<f64>{ });
+          case Token::Type::STAR: return use(std::multiplies<f64>{ });
+          case Token::Type::SLASH: return use([span](f64 lhs, f64 rhs) { return quotient(lhs, rhs, span); });
+          default: return ordered<f64>(oper, use);
+        }
+      } else if constexpr (std::same_as<T, Ref>) {
+        if(oper != Token::Type::PLUS) return std::nullopt;
+        return use([span](Ref const& lhs, Ref const& rhs) { return concatenate(lhs, rhs, span); });
+      } else if constexpr (std::same_as<T, bool>) {
+        if(oper != Token::Type::EQUALS and oper != Token::Type::NOT_EQ) return std::nullopt;
+        return ordered<bool>(oper, use);
+      } else return ordered<T>(oper, use);
+    }
+
+    /// @brief Drops the value of an expression evaluated for its effects
+    auto discard(Thunk thunk) -> Code<void> {
+      return std::visit([]<class T>(Code<T>& code) -> Code<void> {
+        if constexpr (std::same_as<T, void>) return std::move(code);
+        else return [code = std::move(code)](Cell* frame) { code(frame); };
+      }, thunk);
+    }
+
+  }
+
+  Executor::Executor(Analyzer const& analyzer, TypeTable const& table, std::ostream& out, ExecutionLimits limits, EscapeAnalyzer const* escapes) noexcept
+    : analyzer { analyzer }
+    , table { table }
+    , out { out }
+    , limits { limits }
+    , escapes { escapes }
+    , printer { analyzer, table }
+  {}
+
+  auto Executor::run(Program& program) -> std::vector<Error> {
+    errors.clear();
+    exit = 0;
+
+    FunctionStatement* entry = nullptr;
+    for(auto& stmt : *program.block)
+      if(auto* function = dynamic_cast<FunctionStatement*>(stmt.get()); function and function->name.view() == "main"sv)
+        entry = function;
+
+    if(not entry) {
+      errors.emplace_back("No 'main' function to run"s, Span{ });
+      return std::move(errors);
+    }
+    if(not entry->args.empty()) {
+      errors.emplace_back("'main' cannot take parameters"s, entry->span);
+      return std::move(errors);
+    }
+
+    Procedure& main = procedure(*entry);
+    if(not errors.empty()) return std::move(errors);
+
+    stack.assign(limits.stack, Cell{ });
+    top = stack.data();
+    depth = 0;
+
+    try {
+      if(main.frame > stack.size()) fault("Stack overflow"s, entry->span);
+      Cell* frame = top;
+      top += main.frame;
+
+      const TypeId returns = analyzer.typeOf(*entry->return_type);
+      if(main.body(frame) == Flow::NEXT and returns != TypeId::VOID)
+        fault("'main' ended without returning a value"s, entry->span);
+      if(returns == TypeId::INT) exit = result.integer;
+    } catch(RuntimeError const& error) {
+      errors.push_back(error);
+    } catch(std::bad_alloc const&) {
+      errors.emplace_back("Out of memory"s, entry->span);
+    }
+
+    // * Objects still referenced from the stack are released now rather than with the executor, then the region they may live in
+    stack.clear();
+    result = { };
+    region.rewind({ });
+    return std::move(errors);
+  }
+
+  auto Executor::status() const noexcept -> i64 {
+    return exit;
+  }
+
+  auto Executor::heapObjects() const noexcept -> u64 {
+    return made[0];
+  }
+
+  auto Executor::heapCells() const noexcept -> u64 {
+    return made[1];
+  }
+
+  auto Executor::regionObjects() const noexcept -> u64 {
+    return made[2];
+  }
+
+  auto Executor::regionCells() const noexcept -> u64 {
+    return made[3];
+  }
+
+  auto Executor::regions() const noexcept -> runtime::Region const& {
+    return region;
+  }
+
+  auto Executor::operator()(Identifier& arg) noexcept -> std::any {
+    const Binding& binding = arg.binding;
+    switch(binding.kind) {
+      case Binding::Kind::LOCAL:
+      case Binding::Kind::PARAMETER:
+        return dispatch(typeOf(arg), [slot = binding.slot]<class T>() -> Thunk {
+          if constexpr (std::same_as<T, void>) return Code<void>{ };
+          else return Code<T>{ Slot<T>{ slot } };
+        });
+      case Binding::Kind::CONSTANT:
+        return Thunk{ Code<i64>{ Constant<i64>{ binding.slot } } };
+      default:
+        return unsupported(arg.span, "'{}' is not a value"f.format(arg.id));
+    }
+  }
+
+  auto Executor::operator()(BoolLiteral& arg) noexcept -> std::any {
+    return Thunk{ Code<bool>{ Constant<bool>{ arg.value.unwrap() } } };
+  }
+
+  auto Executor::operator()(ObjectLiteral& arg) noexcept -> std::any {
+    if(arg.value.getType() != Token::Type::NUL)
+      return unsupported(arg.span, "Cannot use '{}' outside of a method"f.format(arg.value.getLiteral()));
+    return Thunk{ Code<Ref>{ Constant<Ref>{ nullptr } } };
+  }
+
+  auto Executor::operator()(StringLiteral& arg) noexcept -> std::any {
+    // * Strings never change, every evaluation shares the same one
+    return Thunk{ Code<Ref>{ Constant<Ref>{ std::make_shared<runtime::Text>(runtime::String::intern(arg.value)) } } };
+  }
+
+  auto Executor::operator()(FloatLiteral& arg) noexcept -> std::any {
+    return Thunk{ Code<f64>{ Constant<f64>{ arg.value.unwrap() } } };
+  }
+
+  auto Executor::operator()(IntLiteral& arg) noexcept -> std::any {
+    return Thunk{ Code<i64>{ Constant<i64>{ arg.value.unwrap() } } };
+  }
+
+  auto Executor::operator()(CharLiteral& arg) noexcept -> std::any {
+    return Thunk{ Code<i8>{ Constant<i8>{ arg.value.unwrap() } } };
+  }
+
+  auto Executor::operator()(PrefixExpression& arg) noexcept -> std::any {
+    const TypeId type = typeOf(arg);
+    switch(arg.oper) {
+      case Token::Type::PLUS:
+        return expression(*arg.expr);
+      case Token::Type::MINUS:
+        if(type == TypeId::FLOAT)
+          return Thunk{ Code<f64>{ [value = typed<f64>(*arg.expr)](Cell* frame) { return -value(frame); } } };
+        return Thunk{ Code<i64>{ [value = typed<i64>(*arg.expr), span = arg.span](Cell* frame) { return negation(value(frame), span); } } };
+      case Token::Type::NOT:
+        return Thunk{ Code<bool>{ [value = typed<bool>(*arg.expr)](Cell* frame) { return not value(frame); } } };
+      case Token::Type::BIT_NOT:
+        return Thunk{ Code<i64>{ [value = typed<i64>(*arg.expr)](Cell* frame) { return ~value(frame); } } };
+      default:
+        return unsupported(arg.span, "Cannot run this operator"s);
+    }
+  }
+
+  auto Executor::operator()(InfixExpression& arg) noexcept -> std::any {
+    if(arg.oper == Token::Type::DOT) return member(arg);
+    if(arg.oper == Token::Type::ASSIGN or Token::compoundOperatorOf(arg.oper) != Token::Type::ILLEGAL) return assign(arg);
+    return binary(arg);
+  }
+
+  auto Executor::operator()(CallExpression& arg) noexcept -> std::any {
+    Identifier const* name = arg.callee();
+    if(name and name->binding.kind == Binding::Kind::FUNCTION)
+      return call(arg, *static_cast<FunctionStatement*>(name->binding.declaration));
+    if(name and name->binding.kind == Binding::Kind::STRUCT)
+      return construct(arg, arg);
+    return unsupported(arg.function->span, "Only functions and structs can be called"s);
+  }
+
+  auto Executor::operator()(SubscriptExpression& arg) noexcept -> std::any {
+    Operand<i64> index = operand<i64>(*arg.index);
+    auto* array = dynamic_cast<Identifier*>(arg.array.get());
+    const bool local = array and (array->binding.kind == Binding::Kind::LOCAL or array->binding.kind == Binding::Kind::PARAMETER);
+    const u32 slot = local ? array->binding.slot : 0;
+    const Span span = arg.span;
+
+    // * The array of a local is read after the index, nothing the index does can release it then
+    if(typeOf(*arg.array) == TypeId::STRING) {
+      if(local) return with<i64>(std::move(index), [&](auto at) -> Thunk {
+        return Code<i8>{ [at, slot, span](Cell* frame) { const i64 i = at(frame); return character(frame[slot].object, i, span); } };
+      });
+      return with<i64>(std::move(index), [&, string = typed<Ref>(*arg.array)](auto at) -> Thunk {
+        return Code<i8>{ [at, string, span](Cell* frame) { const Ref value = string(frame); return character(value, at(frame), span); } };
+      });
+    }
+
+    return dispatch(typeOf(arg), [&]<class T>() -> Thunk {
+      if constexpr (std::same_as<T, void>) return Code<void>{ };
+      else if(local) return with<i64>(std::move(index), [&](auto at) -> Thunk {
+        return Code<T>{ [at, slot, span](Cell* frame) -> T { const i64 i = at(frame); return load<T>(element(frame[slot].object, i, span)); } };
+      });
+      else return with<i64>(std::move(index), [&, elements = typed<Ref>(*arg.array)](auto at) -> Thunk {
+        return Code<T>{ [at, elements, span](Cell* frame) -> T { const Ref value = elements(frame); return load<T>(element(value, at(frame), span)); } };
+      });
+    });
+  }
+
+  auto Executor::operator()(ArrayLiteral& arg) noexcept -> std::any {
+    return construct(arg, arg);
+  }
+
+  auto Executor::operator()(ExpressionStatement& arg) noexcept -> std::any {
+    return Code<Flow>{ [effect = discard(expression(*arg.expr))](Cell* frame) {
+      effect(frame);
+      return Flow::NEXT;
+    } };
+  }
+
+  auto Executor::operator()(ReturnStatement& arg) noexcept -> std::any {
+    Thunk value = expression(*arg.expr);
+    return std::visit([this]<class T>(Code<T>& code) -> Code<Flow> {
+      if constexpr (std::same_as<T, void>) return [code = std::move(code)](Cell* frame) {
+        code(frame);
+        return Flow::RETURN;
+      };
+      else return [this, code = std::move(code)](Cell* frame) {
+        runtime::store<T>(result, code(frame));
+        return Flow::RETURN;
+      };
+    }, value);
+  }
+
+  auto Executor::operator()(PrintStatement& arg) noexcept -> std::any {
+    runtime::Printer::Format const* format = &printer.format(typeOf(*arg.expr));
+    Thunk value = expression(*arg.expr);
+    return std::visit([this, format]<class T>(Code<T>& code) -> Code<Flow> {
+      if constexpr (std::same_as<T, void>) return [](Cell*) { return Flow::NEXT; };
+      else return [this, format, code = std::move(code)](Cell* frame) {
+        Cell cell;
+        runtime::store<T>(cell, code(frame));
+        buffer.clear();
+        (*format)(buffer, cell, 0);
+        buffer += '\n';
+        out.write(buffer.data(), (std::streamsize)buffer.size());
+        return Flow::NEXT;
+      };
+    }, value);
+  }
+
+  auto Executor::operator()(BlockStatement& arg) noexcept -> std::any {
+    std::vector<Code<Flow>> statements;
+    statements.reserve(arg.size());
+    for(auto& stmt : arg) statements.push_back(statement(*stmt));
+
+    if(statements.size() == 1) return std::move(statements.front());
+    return Code<Flow>{ [statements = std::move(statements)](Cell* frame) {
+      for(auto const& stmt : statements)
+        if(stmt(frame) == Flow::RETURN) return Flow::RETURN;
+      return Flow::NEXT;
+    } };
+  }
+
+  auto Executor::operator()(IfStatement& arg) noexcept -> std::any {
+    Code<bool> condition = typed<bool>(*arg.condition);
+    Code<Flow> then = statement(*arg.block);
+    if(not arg.alternative)
+      return Code<Flow>{ [condition = std::move(condition), then = std::move(then)](Cell* frame) {
+        return condition(frame) ? then(frame) : Flow::NEXT;
+      } };
+
+    return Code<Flow>{ [condition = std::move(condition), then = std::move(then), otherwise = statement(*arg.alternative)](Cell* frame) {
+      return condition(frame) ? then(frame) : otherwise(frame);
+    } };
+  }
+
+  auto Executor::operator()(WhileStatement& arg) noexcept -> std::any {
+    Code<bool> condition = typed<bool>(*arg.condition);
+    Code<Flow> body = statement(*arg.block);
+
+    // * Values of an iteration die with it: their locals are cleared, then the region is rewound
+    if(std::vector<u32> const* slots = escapes ? escapes->slots(arg) : nullptr)
+      return Code<Flow>{ [this, condition = std::move(condition), body = std::move(body), slots = *slots](Cell* frame) {
+        const runtime::Region::Mark mark = region.mark();
+        Flow flow = Flow::NEXT;
+        while(flow == Flow::NEXT and condition(frame)) {
+          flow = body(frame);
+          for(u32 slot : slots) frame[slot].object.reset();
+          region.rewind(mark);
+        }
+        region.rewind(mark);
+        return flow;
+      } };
+
+    return Code<Flow>{ [condition = std::move(condition), body = std::move(body)](Cell* frame) {
+      while(condition(frame))
+        if(body(frame) == Flow::RETURN) return Flow::RETURN;
+      return Flow::NEXT;
+    } };
+  }
+
+  auto Executor::operator()(ForStatement& arg) noexcept -> std::any {
+    Code<void> initializer = discard(expression(*arg.initializer));
+    Code<bool> condition = typed<bool>(*arg.condition);
+    Code<void> modifier = discard(expression(*arg.modifier));
+    Code<Flow> body = statement(*arg.block);
+
+    // * The modifier runs in the iteration it ends, the initializer before the mark
+    if(std::vector<u32> const* slots = escapes ? escapes->slots(arg) : nullptr)
+      return Code<Flow>{ [this, initializer = std::move(initializer), condition = std::move(condition), modifier = std::move(modifier), body = std::move(body), slots = *slots](Cell* frame) {
+        initializer(frame);
+        const runtime::Region::Mark mark = region.mark();
+        Flow flow = Flow::NEXT;
+        while(flow == Flow::NEXT and condition(frame)) {
+          flow = body(frame);
+          if(flow == Flow::NEXT) modifier(frame);
+          for(u32 slot : slots) frame[slot].object.reset();
+          region.rewind(mark);
+        }
+        region.rewind(mark);
+        return flow;
+      } };
+
+    return Code<Flow>{ [initializer = std::move(initializer), condition = std::move(condition), modifier = std::move(modifier), body = std::move(body)](Cell* frame) {
+      for(initializer(frame); condition(frame); modifier(frame))
+        if(body(frame) == Flow::RETURN) return Flow::RETURN;
+      return Flow::NEXT;
+    } };
+  }
+
+  auto Executor::operator()(DeclarationStatement& arg) noexcept -> std::any {
+    const u32 slot = arg.slot;
+    const TypeId type = analyzer.typeOf(arg);
+    if(current and reference(type)) current->references = true;
+
+    if(not arg.expr) return Code<Flow>{ [slot](Cell* frame) {
+      frame[slot] = Cell{ };
+      return Flow::NEXT;
+    } };
+
+    Thunk value = expression(*arg.expr);
+    return std::visit([slot]<class T>(Code<T>& code) -> Code<Flow> {
+      if constexpr (std::same_as<T, void>) return [](Cell*) { return Flow::NEXT; };
+      else return [slot, code = std::move(code)](Cell* frame) {
+        runtime::store<T>(frame[slot], code(frame));
+        return Flow::NEXT;
+      };
+    }, value);
+  }
+
+  auto Executor::procedure(FunctionStatement& function) noexcept -> Procedure& {
+    if(Box<Procedure>* known = procedures.find(&function)) return **known;
+
+    // * Registered before its body is compiled, so recursive calls find it
+    Procedure& compiled = **procedures.insert(&function, std::make_unique<Procedure>()).first;
+    compiled.frame = std::max<u32>(function.frame_size, (u32)function.args.size());
+    compiled.regional = escapes and escapes->allocates(function);
+    for(Member const& parameter : function.args)
+      if(reference(analyzer.typeOf(*parameter.type))) compiled.references = true;
+
+    Procedure* enclosing = std::exchange(current, &compiled);
+    compiled.body = statement(*function.block);
+    current = enclosing;
+    return compiled;
+  }
+
+  auto Executor::expression(Expression& expr) noexcept -> Thunk {
+    std::any compiled = visit(expr);
+    if(auto* thunk = std::any_cast<Thunk>(&compiled)) return std::move(*thunk);
+    return unsupported(expr.span, "Cannot run this expression"s);
+  }
+
+  auto Executor::statement(Statement& stmt) noexcept -> Code<Flow> {
+    std::any compiled = visit(stmt);
+    if(auto* code = std::any_cast<Code<Flow>>(&compiled)) return std::move(*code);
+    unsupported(stmt.span, "Cannot run this statement"s);
+    return [](Cell*) { return Flow::NEXT; };
+  }
+
+  auto Executor::unsupported(Span span, std::string message) noexcept -> Thunk {
+    errors.emplace_back(std::move(message), span);
+    return Code<void>{ };
+  }
+
+  auto Executor::typeOf(Expression const& expr) const noexcept -> TypeId {
+    return analyzer.typeOf(expr);
+  }
+
+  auto Executor::reference(TypeId type) const noexcept -> bool {
+    switch(table.info(type).kind) {
+      case TypeInfo::Kind::STRING:
+      case TypeInfo::Kind::NUL:
+      case TypeInfo::Kind::STRUCT:
+      case TypeInfo::Kind::ARRAY: return true;
+      default: return false;
+    }
+  }
+
+  template<class T>
+  auto Executor::typed(Expression& expr) noexcept -> Code<T> {
+    Thunk thunk = expression(expr);
+    if(auto* code = std::get_if<Code<T>>(&thunk)) return std::move(*code);
+
+    unsupported(expr.span, "Cannot run this expression"s);
+    return [](Cell*) -> T { if constexpr (not std::same_as<T, void>) return T{ }; };
+  }
+
+  template<class T>
+  auto Executor::operand(Expression& expr) noexcept -> std::variant<T, u32, Code<T>> {
+    if constexpr (std::same_as<T, i64>) {
+      if(auto* literal = dynamic_cast<IntLiteral*>(&expr)) return literal->value.unwrap();
+    } else if constexpr (std::same_as<T, f64>) {
+      if(auto* literal = dynamic_cast<FloatLiteral*>(&expr)) return literal->value.unwrap();
+    } else if constexpr (std::same_as<T, i8>) {
+      if(auto* literal = dynamic_cast<CharLiteral*>(&expr)) return literal->value.unwrap();
+    } else if constexpr (std::same_as<T, bool>) {
+      if(auto* literal = dynamic_cast<BoolLiteral*>(&expr)) return literal->value.unwrap();
+    }
+
+    if(auto* name = dynamic_cast<Identifier*>(&expr))
+      if(name->binding.kind == Binding::Kind::LOCAL or name->binding.kind == Binding::Kind::PARAMETER)
+        return std::variant<T, u32, Code<T>>{ std::in_place_index<1>, name->binding.slot };
+
+    return std::variant<T, u32, Code<T>>{ std::in_place_index<2>, typed<T>(expr) };
+  }
+
+  template<class Make>
+  auto Executor::dispatch(TypeId type, Make&& make) noexcept -> Thunk {
+    switch(table.info(type).kind) {
+      case TypeInfo::Kind::INT:
+      case TypeInfo::Kind::ENUM: return make.template operator()<i64>();
+      case TypeInfo::Kind::FLOAT: return make.template operator()<f64>();
+      case TypeInfo::Kind::BOOL: return make.template operator()<bool>();
+      case TypeInfo::Kind::CHAR: return make.template operator()<i8>();
+      case TypeInfo::Kind::VOID: return make.template operator()<void>();
+      default: return make.template operator()<Ref>();
+    }
+  }
+
+  auto Executor::writer(Expression& expr, u32 index) noexcept -> Writer {
+    Thunk value = expression(expr);
+    return std::visit([index]<class T>(Code<T>& code) -> Writer {
+      if constexpr (std::same_as<T, void>) return [code = std::move(code)](Cell* frame, Cell*) { code(frame); };
+      else return [index, code = std::move(code)](Cell* frame, Cell* into) { runtime::store<T>(into[index], code(frame)); };
+    }, value);
+  }
+
+  auto Executor::call(CallExpression& arg, FunctionStatement& function) noexcept -> Thunk {
+    Procedure* callee = &procedure(function);
+    std::vector<Writer> arguments;
+    arguments.reserve(arg.size());
+    for(u32 i = 0; i < arg.size(); ++i) arguments.push_back(writer(*arg[i], i));
+
+    return dispatch(typeOf(arg), [&]<class T>() -> Thunk {
+      return Code<T>{ [this, callee, arguments, span = arg.span, name = function.name](Cell* frame) -> T {
+        // * The callee frame starts above every active one, arguments are written straight into its parameters
+        Cell* base = top;
+        if(depth == limits.depth or callee->frame > (u64)(stack.data() + stack.size() - base)) fault("Stack overflow"s, span);
+        top = base + callee->frame;
+        ++depth;
+
+        for(Writer const& write : arguments) write(frame, base);
+        const runtime::Region::Mark mark = region.mark();
+        const Flow flow = callee->body(base);
+
+        // * Nothing the callee made in the region is referenced once its frame is cleared
+        if(callee->references)
+          for(Cell* cell = base; cell != top; ++cell) cell->object.reset();
+        if(callee->regional) region.rewind(mark);
+        top = base;
+        --depth;
+
+        if constexpr (not std::same_as<T, void>) {
+          if(flow == Flow::NEXT) fault("'{}' ended without returning a value"f.format(name), span);
+          return take<T>(result);
+        }
+      } };
+    });
+  }
+
+  auto Executor::construct(Expression const& literal, Container<Box<Expression>>& values) noexcept -> Thunk {
+    std::vector<Writer> initializers;
+    initializers.reserve(values.size());
+    for(u32 i = 0; i < values.size(); ++i) initializers.push_back(writer(*values[i], i));
+
+    // * The object is made before its initializers run, anything they make in the region is rewound above it
+    Lifetime const* lifetime = escapes ? escapes->lifetime(literal) : nullptr;
+    if(lifetime and lifetime->kind != Lifetime::Kind::HEAP)
+      return Code<Ref>{ [this, initializers = std::move(initializers)](Cell* frame) -> Ref {
+        auto object = std::allocate_shared<runtime::Cells>(std::pmr::polymorphic_allocator<runtime::Cells>{ &region }, initializers.size(), &region);
+        ++made[2];
+        made[3] += initializers.size();
+        for(Writer const& initialize : initializers) initialize(frame, object->cells.data());
+        return object;
+      } };
+
+    return Code<Ref>{ [this, initializers = std::move(initializers)](Cell* frame) -> Ref {
+      auto object = std::make_shared<runtime::Cells>(initializers.size());
+      ++made[0];
+      made[1] += initializers.size();
+      for(Writer const& initialize : initializers) initialize(frame, object->cells.data());
+      return object;
+    } };
+  }
+
+  auto Executor::member(InfixExpression& arg) noexcept -> Thunk {
+    auto* object = dynamic_cast<Identifier*>(arg.lhs.get());
+    auto* name = dynamic_cast<Identifier*>(arg.rhs.get());
+    if(not name) return unsupported(arg.span, "Cannot run this expression"s);
+
+    // * Enum constants and namespace members are resolved already, only fields are read at run time
+    if(object and (object->binding.kind == Binding::Kind::ENUM or object->binding.kind == Binding::Kind::NAMESPACE))
+      return expression(*name);
+
+    const u32 index = name->binding.slot;
+    const bool local = object and (object->binding.kind == Binding::Kind::LOCAL or object->binding.kind == Binding::Kind::PARAMETER);
+    const Span span = arg.lhs->span;
+
+    return dispatch(typeOf(arg), [&]<class T>() -> Thunk {
+      if constexpr (std::same_as<T, void>) return Code<void>{ };
+      else if(local) return Code<T>{ [slot = object->binding.slot, index, span](Cell* frame) -> T {
+        return load<T>(cells(frame[slot].object, span)[index]);
+      } };
+      else return Code<T>{ [structure = typed<Ref>(*arg.lhs), index, span](Cell* frame) -> T {
+        const Ref value = structure(frame);
+        return load<T>(cells(value, span)[index]);
+      } };
+    });
+  }
+
+  auto Executor::binary(InfixExpression& arg) noexcept -> Thunk {
+    const TypeId lhs = typeOf(*arg.lhs);
+    const TypeId rhs = typeOf(*arg.rhs);
+
+    if(arg.oper == Token::Type::AND)
+      return Code<bool>{ [left = typed<bool>(*arg.lhs), right = typed<bool>(*arg.rhs)](Cell* frame) { return left(frame) and right(frame); } };
+    if(arg.oper == Token::Type::OR)
+      return Code<bool>{ [left = typed<bool>(*arg.lhs), right = typed<bool>(*arg.rhs)](Cell* frame) { return left(frame) or right(frame); } };
+
+    // * Strings are equal by value, other references by identity
+    if(reference(lhs) and (arg.oper == Token::Type::EQUALS or arg.oper == Token::Type::NOT_EQ)) {
+      const bool strings = lhs == TypeId::STRING or rhs == TypeId::STRING;
+      const bool equals = arg.oper == Token::Type::EQUALS;
+      return combine<Ref>(operand<Ref>(*arg.lhs), operand<Ref>(*arg.rhs), [strings, equals](Ref const& left, Ref const& right) {
+        return (strings ? equal(left, right) : left == right) == equals;
+      });
+    }
+
+    Thunk compiled = dispatch(lhs, [&]<class T>() -> Thunk {
+      if constexpr (std::same_as<T, void>) return Code<void>{ };
+      else {
+        std::optional<Thunk> thunk = operation<T>(arg.oper, arg.span, [&](auto op) {
+          return combine<T>(operand<T>(*arg.lhs), operand<T>(*arg.rhs), op);
+        });
+        return thunk ? std::move(*thunk) : Code<void>{ };
+      }
+    });
+
+    if(auto* empty = std::get_if<Code<void>>(&compiled); empty and not *empty)
+      return unsupported(arg.span, "Cannot run this operator"s);
+    return compiled;
+  }
+
+  auto Executor::assign(InfixExpression& arg) noexcept -> Thunk {
+    if(auto* subscript = dynamic_cast<SubscriptExpression*>(arg.lhs.get()); subscript and typeOf(*subscript->array) == TypeId::STRING)
+      return unsupported(arg.lhs->span, "Characters of a string cannot be assigned"s);
+
+    const Token::Type oper = Token::compoundOperatorOf(arg.oper);
+    Thunk compiled = dispatch(typeOf(*arg.lhs), [&]<class T>() -> Thunk {
+      if constexpr (std::same_as<T, void>) return Code<void>{ };
+      else {
+        if(oper == Token::Type::ILLEGAL) return store<T>(arg, [](T const&, T const& value) { return value; });
+
+        std::optional<Thunk> thunk = operation<T>(oper, arg.span, [&](auto op) { return store<T>(arg, op); });
+        return thunk ? std::move(*thunk) : Code<void>{ };
+      }
+    });
+
+    if(auto* empty = std::get_if<Code<void>>(&compiled); empty and not *empty)
+      return unsupported(arg.span, "Cannot run this assignment"s);
+    return compiled;
+  }
+
+  template<class T, class Op>
+  auto Executor::store(InfixExpression& arg, Op op) noexcept -> Thunk {
+    Operand<T> value = operand<T>(*arg.rhs);
+
+    if(auto* name = dynamic_cast<Identifier*>(arg.lhs.get())) {
+      return with<T>(std::move(value), [&, slot = name->binding.slot](auto right) -> Thunk {
+        return Code<T>{ [slot, right, op](Cell* frame) -> T {
+          const T rhs = right(frame);
+          Cell& target = frame[slot];
+          const T result = op(load<T>(target), rhs);
+          runtime::store<T>(target, result);
+          return result;
+        } };
+      });
+    }
+
+    if(auto* access = dynamic_cast<InfixExpression*>(arg.lhs.get())) {
+      const u32 index = static_cast<Identifier&>(*access->rhs).binding.slot;
+      return with<T>(std::move(value), [&, structure = typed<Ref>(*access->lhs), span = access->lhs->span](auto right) -> Thunk {
+        return Code<T>{ [structure, index, right, op, span](Cell* frame) -> T {
+          const Ref object = structure(frame);
+          const T rhs = right(frame);
+          Cell& target = cells(object, span)[index];
+          const T result = op(load<T>(target), rhs);
+          runtime::store<T>(target, result);
+          return result;
+        } };
+      });
+    }
+
+    auto& subscript = static_cast<SubscriptExpression&>(*arg.lhs);
+    return with<T>(std::move(value), [&, elements = typed<Ref>(*subscript.array), at = typed<i64>(*subscript.index), span = subscript.span](auto right) -> Thunk {
+      return Code<T>{ [elements, at, right, op, span](Cell* frame) -> T {
+        const Ref object = elements(frame);
+        const i64 index = at(frame);
+        const T rhs = right(frame);
+        Cell& target = element(object, index, span);
+        const T result = op(load<T>(target), rhs);
+        runtime::store<T>(target, result);
+        return result;
+      } };
+    });
+  }
+
+}
@@ -5,10 +5,33 @@
 
 namespace fridayc {
 
+  namespace {
+
+    /// @brief Escapes a string for a JSON string literal
+    auto escape(std::string_view value) -> std::string {
+      std::string result;
+      result.reserve(value.length());
+      for(i8 c : value) {
+        switch(c) {
+          case '"': result += "\\\""; break;
+          case '\\': result += "\\\\"; break;
+          case '\n': result += "\\n"; break;
+          case '\t': result += "\\t"; break;
+          case '\r': result += "\\r"; break;
+          default:
+            if(static_cast<u8>(c) < 0x20) result += "\\u{:04x}"f.format(static_cast<u32>(c));
+            else result += c;
+        }
+      }
+      return result;
+    }
+
+  }
+
   inline namespace expressions {
 
-    Identifier::Identifier(std::string id) noexcept 
-      : id { std::move(id) }
+    Identifier::Identifier(Symbol id) noexcept 
+      : id { id }
     {}
     
     auto Identifier::toString() const noexcept -> std::string {
@@ -43,12 +66,18 @@ namespace fridayc {
       return visitor.visit(*this);
     }
 
-    StringLiteral::StringLiteral(std::string value) noexcept 
-      : value { std::move(value) }
+    StringLiteral::StringLiteral(std::string_view value) noexcept 
+      : value { value }
     {}
+
+    StringLiteral::StringLiteral(std::string value) noexcept 
+      : storage { std::move(value) }
+    {
+      this->value = storage;
+    }
     
     auto StringLiteral::toString() const noexcept -> std::string {
-      return "{{\"type\": \"StringLiteral\", \"value\": {}}}"f.format(value);
+      return "{{\"type\": \"StringLiteral\", \"value\": \"{}\"}}"f.format(escape(value));
     }
 
     auto StringLiteral::operator()(Visitor& visitor) noexcept -> std::any {
@@ -84,7 +113,7 @@ namespace fridayc {
     {}
     
     auto CharLiteral::toString() const noexcept -> std::string {
-      return "{{\"type\": \"CharLiteral\", \"value\": \"{}\"}}"f.format(value.unwrap());
+      return "{{\"type\": \"CharLiteral\", \"value\": \"{}\"}}"f.format(escape(value.toString()));
     }
 
     auto CharLiteral::operator()(Visitor& visitor) noexcept -> std::any {
@@ -107,8 +136,8 @@ namespace fridayc {
       return visitor.visit(*this);
     }
 
-    TypeExpression::TypeExpression(std::string name, u32 dimensions) noexcept
-      : name { std::move(name) }
+    TypeExpression::TypeExpression(Symbol name, u32 dimensions) noexcept
+      : name { name }
       , dimensions { dimensions }
     {}
 
@@ -169,6 +198,16 @@ namespace fridayc {
       return visitor.visit(*this);
     }
 
+    auto CallExpression::callee() const noexcept -> Identifier const* {
+      // * Namespace-qualified names are plain top-level names
+      if(auto* access = dynamic_cast<InfixExpression const*>(function.get()); access and access->oper == Token::Type::DOT) {
+        auto* space = dynamic_cast<Identifier const*>(access->lhs.get());
+        if(space and space->binding.kind == Binding::Kind::NAMESPACE) return dynamic_cast<Identifier const*>(access->rhs.get());
+        return nullptr;
+      }
+      return dynamic_cast<Identifier const*>(function.get());
+    }
+
     SubscriptExpression::SubscriptExpression(Box<Expression> array, Box<Expression> index) noexcept 
       : array { std::move(array) }
       , index { std::move(index) }
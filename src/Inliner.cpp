@@ -0,0 +1,332 @@
+#include "Inliner.hpp"
+#include "SideEffects.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    /// @brief Measures the returned expression of a function and records how it uses its parameters
+    struct Shape : public Walker {
+      FunctionStatement const*              function;
+      std::vector<u32>                      uses;
+      std::vector<bool>                     guarded;
+      std::vector<Symbol>                   globals  { };
+      std::vector<FunctionStatement const*> callees  { };
+      u32                                   size     { 0 };
+      u32                                   guard    { 0 };
+      bool                                  assigns  { false };
+
+      explicit Shape(FunctionStatement const& function) noexcept
+        : function { &function }
+        , uses(function.args.size(), 0)
+        , guarded(function.args.size(), false)
+      {}
+
+      using Walker::operator();
+
+      auto operator()(Identifier& arg) noexcept -> std::any override {
+        ++size;
+        switch(arg.binding.kind) {
+          case Binding::Kind::PARAMETER:
+            if(arg.binding.declaration != function) break;
+            ++uses[arg.binding.slot];
+            if(guard) guarded[arg.binding.slot] = true;
+            break;
+          case Binding::Kind::FUNCTION:
+          case Binding::Kind::STRUCT:
+          case Binding::Kind::ENUM:
+          case Binding::Kind::NAMESPACE:
+            globals.push_back(arg.id);
+            break;
+          default:
+            break;
+        }
+        return { };
+      }
+
+      auto operator()(BoolLiteral& arg) noexcept -> std::any override { ++size; return { }; }
+      auto operator()(ObjectLiteral& arg) noexcept -> std::any override { ++size; return { }; }
+      auto operator()(StringLiteral& arg) noexcept -> std::any override { ++size; return { }; }
+      auto operator()(FloatLiteral& arg) noexcept -> std::any override { ++size; return { }; }
+      auto operator()(IntLiteral& arg) noexcept -> std::any override { ++size; return { }; }
+      auto operator()(CharLiteral& arg) noexcept -> std::any override { ++size; return { }; }
+
+      auto operator()(PrefixExpression& arg) noexcept -> std::any override {
+        ++size;
+        return Walker::operator()(arg);
+      }
+
+      auto operator()(InfixExpression& arg) noexcept -> std::any override {
+        ++size;
+        if(arg.oper == Token::Type::ASSIGN or Token::compoundOperatorOf(arg.oper) != Token::Type::ILLEGAL) assigns = true;
+
+        // * The right-hand side of 'and'/'or' may not be evaluated
+        if(arg.oper == Token::Type::AND or arg.oper == Token::Type::OR) {
+          visit(*arg.lhs);
+          ++guard;
+          visit(*arg.rhs);
+          --guard;
+          return { };
+        }
+        return Walker::operator()(arg);
+      }
+
+      auto operator()(CallExpression& arg) noexcept -> std::any override {
+        ++size;
+        Identifier const* name = arg.callee();
+        if(name and name->binding.kind == Binding::Kind::FUNCTION)
+          callees.push_back(static_cast<FunctionStatement const*>(name->binding.declaration));
+        return Walker::operator()(arg);
+      }
+
+      auto operator()(SubscriptExpression& arg) noexcept -> std::any override {
+        ++size;
+        return Walker::operator()(arg);
+      }
+
+      auto operator()(ArrayLiteral& arg) noexcept -> std::any override {
+        ++size;
+        return Walker::operator()(arg);
+      }
+    };
+
+    /// @brief Collects the names of the parameters and locals of a function
+    struct Locals : public Walker {
+      FlatMap<Symbol, bool>& names;
+
+      explicit Locals(FlatMap<Symbol, bool>& names) noexcept
+        : names { names }
+      {}
+
+      using Walker::operator();
+
+      auto operator()(DeclarationStatement& arg) noexcept -> std::any override {
+        names.insert(arg.id, true);
+        return { };
+      }
+    };
+
+    /// @brief Copies the returned expression of a function with its parameters replaced by arguments
+    struct Substitution : public Cloner {
+      FunctionStatement const* function;
+      CallExpression&          call;
+
+      Substitution(FunctionStatement const& function, CallExpression& call) noexcept
+        : function { &function }
+        , call { call }
+      {}
+
+      using Cloner::operator();
+
+      auto operator()(Identifier& arg) noexcept -> std::any override {
+        if(arg.binding.kind == Binding::Kind::PARAMETER and arg.binding.declaration == function)
+          return clone(*call[arg.binding.slot]).release();
+        return Cloner::operator()(arg);
+      }
+    };
+
+    auto simple(Expression const& expr) noexcept -> bool {
+      return dynamic_cast<Identifier const*>(&expr)
+        or dynamic_cast<IntLiteral const*>(&expr)
+        or dynamic_cast<FloatLiteral const*>(&expr)
+        or dynamic_cast<BoolLiteral const*>(&expr)
+        or dynamic_cast<CharLiteral const*>(&expr)
+        or dynamic_cast<StringLiteral const*>(&expr);
+    }
+
+  }
+
+  Inliner::Inliner(InlineLimits limits) noexcept
+    : limits { limits }
+  {}
+
+  auto Inliner::expand(Program& program) -> void {
+    select(program);
+    if(not candidates.empty()) visit(program);
+  }
+
+  auto Inliner::inlinedCalls() const noexcept -> u64 {
+    return inlined;
+  }
+
+  auto Inliner::operator()(PrefixExpression& arg) noexcept -> std::any {
+    expand(arg.expr);
+    return { };
+  }
+
+  auto Inliner::operator()(InfixExpression& arg) noexcept -> std::any {
+    expand(arg.lhs);
+    expand(arg.rhs);
+    return { };
+  }
+
+  auto Inliner::operator()(CallExpression& arg) noexcept -> std::any {
+    expand(arg.function);
+    for(auto& argument : arg) expand(argument);
+    return { };
+  }
+
+  auto Inliner::operator()(SubscriptExpression& arg) noexcept -> std::any {
+    expand(arg.array);
+    expand(arg.index);
+    return { };
+  }
+
+  auto Inliner::operator()(ExpressionStatement& arg) noexcept -> std::any {
+    expand(arg.expr);
+    return { };
+  }
+
+  auto Inliner::operator()(ArrayLiteral& arg) noexcept -> std::any {
+    for(auto& value : arg) expand(value);
+    return { };
+  }
+
+  auto Inliner::operator()(ReturnStatement& arg) noexcept -> std::any {
+    expand(arg.expr);
+    return { };
+  }
+
+  auto Inliner::operator()(PrintStatement& arg) noexcept -> std::any {
+    expand(arg.expr);
+    return { };
+  }
+
+  auto Inliner::operator()(IfStatement& arg) noexcept -> std::any {
+    expand(arg.condition);
+    visit(*arg.block);
+    if(arg.alternative) visit(*arg.alternative);
+    return { };
+  }
+
+  auto Inliner::operator()(WhileStatement& arg) noexcept -> std::any {
+    expand(arg.condition);
+    visit(*arg.block);
+    return { };
+  }
+
+  auto Inliner::operator()(ForStatement& arg) noexcept -> std::any {
+    expand(arg.initializer);
+    expand(arg.condition);
+    expand(arg.modifier);
+    visit(*arg.block);
+    return { };
+  }
+
+  auto Inliner::operator()(FunctionStatement& arg) noexcept -> std::any {
+    shadowing.clear();
+    for(Member& parameter : arg.args) shadowing.insert(parameter.name, true);
+    Locals(shadowing).visit(*arg.block);
+
+    budget = limits.growth;
+    visit(*arg.block);
+    return { };
+  }
+
+  auto Inliner::operator()(DeclarationStatement& arg) noexcept -> std::any {
+    if(arg.expr) expand(arg.expr);
+    return { };
+  }
+
+  auto Inliner::select(Program& program) -> void {
+    std::vector<FunctionStatement const*> selected;
+    FlatMap<FunctionStatement const*, std::vector<FunctionStatement const*>> callees;
+
+    for(auto& stmt : *program.block) {
+      auto* function = dynamic_cast<FunctionStatement*>(stmt.get());
+      if(not function or function->block->size() != 1) continue;
+
+      auto* body = dynamic_cast<ReturnStatement*>((*function->block)[0].get());
+      if(not body or not body->expr) continue;
+
+      Shape shape(*function);
+      shape.visit(*body->expr);
+      if(shape.assigns or shape.size > limits.size) continue;
+
+      Candidate& candidate = candidates[function];
+      candidate.body = Cloner().clone(*body->expr);
+      candidate.uses = std::move(shape.uses);
+      candidate.guarded = std::move(shape.guarded);
+      candidate.globals = std::move(shape.globals);
+      candidate.size = shape.size;
+
+      // * Anything that calls or may fault, checked int arithmetic included, must not run before a complex argument
+      std::vector<bool> assigned;
+      SideEffects effects(assigned);
+      effects.visit(*body->expr);
+      candidate.effects = effects.calls or effects.fallible;
+
+      selected.push_back(function);
+      callees.insert(function, std::move(shape.callees));
+    }
+
+    // * Functions calling no remaining candidate are peeled off repeatedly, what is left leads into a cycle
+    FlatMap<FunctionStatement const*, u32> pending;
+    FlatMap<FunctionStatement const*, std::vector<FunctionStatement const*>> callers;
+    std::vector<FunctionStatement const*> peeled;
+
+    for(FunctionStatement const* function : selected) {
+      u32& count = pending[function];
+      for(FunctionStatement const* callee : *callees.find(function)) {
+        if(not candidates.contains(callee)) continue;
+        ++count;
+        callers[callee].push_back(function);
+      }
+    }
+    for(FunctionStatement const* function : selected)
+      if(*pending.find(function) == 0) peeled.push_back(function);
+
+    for(u64 i = 0; i < peeled.size(); ++i) {
+      if(auto* affected = callers.find(peeled[i]))
+        for(FunctionStatement const* caller : *affected)
+          if(--*pending.find(caller) == 0) peeled.push_back(caller);
+    }
+
+    if(peeled.size() == selected.size()) return;
+
+    FlatMap<FunctionStatement const*, Candidate> acyclic;
+    acyclic.reserve(peeled.size());
+    for(FunctionStatement const* function : peeled) acyclic.insert(function, std::move(*candidates.find(function)));
+    candidates = std::move(acyclic);
+  }
+
+  auto Inliner::expand(Box<Expression>& slot) noexcept -> void {
+    visit(*slot);
+
+    auto* call = dynamic_cast<CallExpression*>(slot.get());
+    if(not call or depth == limits.depth) return;
+
+    Identifier const* name = call->callee();
+    if(not name or name->binding.kind != Binding::Kind::FUNCTION) return;
+
+    auto const* function = static_cast<FunctionStatement const*>(name->binding.declaration);
+    Candidate const* candidate = candidates.find(function);
+    if(not candidate or not inlinable(*call, *candidate)) return;
+
+    Box<Expression> body = Substitution(*function, *call).clone(*candidate->body);
+    body->span = call->span;
+    slot = std::move(body);
+    budget -= candidate->size;
+    ++inlined;
+
+    // * The arguments were expanded already, expanding them again finds nothing new
+    ++depth;
+    expand(slot);
+    --depth;
+  }
+
+  auto Inliner::inlinable(CallExpression& call, Candidate const& candidate) const noexcept -> bool {
+    if(call.size() != candidate.uses.size() or candidate.size > budget) return false;
+
+    for(Symbol global : candidate.globals)
+      if(shadowing.contains(global)) return false;
+
+    u32 complex = 0;
+    for(u32 i = 0; i < call.size(); ++i) {
+      if(simple(*call[i])) continue;
+      if(++complex > 1 or candidate.effects or candidate.uses[i] != 1 or candidate.guarded[i]) return false;
+    }
+    return true;
+  }
+
+}
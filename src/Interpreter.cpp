@@ -0,0 +1,405 @@
+#include "Interpreter.hpp"
+#include "ConstantFolder.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    using Constant = ConstantFolder::Constant;
+
+    /// @brief Scalar held by a value, std::nullopt for strings, arrays and 'void'
+    auto scalar(Value const& value) noexcept -> std::optional<Constant> {
+      return std::visit([](auto const& data) -> std::optional<Constant> {
+        using T = std::decay_t<decltype(data)>;
+        if constexpr (std::same_as<T, Long> or std::same_as<T, Double> or std::same_as<T, Boolean> or std::same_as<T, Character>)
+          return Constant{ data };
+        else return std::nullopt;
+      }, value.data);
+    }
+
+    auto wrap(Constant const& constant) noexcept -> Value {
+      return std::visit([](auto data) { return Value{ data }; }, constant);
+    }
+
+  }
+
+  auto Value::operator==(Value const& other) const noexcept -> bool {
+    if(data.index() != other.data.index()) return false;
+
+    return std::visit([&other](auto const& lhs) -> bool {
+      using T = std::decay_t<decltype(lhs)>;
+      T const& rhs = std::get<T>(other.data);
+
+      if constexpr (std::same_as<T, std::monostate>) return true;
+      else if constexpr (std::same_as<T, std::string>) return lhs == rhs;
+      else if constexpr (std::same_as<T, Double>) return std::bit_cast<u64>(lhs.unwrap()) == std::bit_cast<u64>(rhs.unwrap());
+      else if constexpr (std::same_as<T, std::shared_ptr<Array const>>) return lhs == rhs or (lhs and rhs and *lhs == *rhs);
+      else return lhs.unwrap() == rhs.unwrap();
+    }, data);
+  }
+
+  Interpreter::Interpreter(FlatMap<FunctionStatement const*, bool> const& pure, EvaluationLimits limits) noexcept
+    : pure { pure }
+    , limits { limits }
+  {}
+
+  auto Interpreter::CallHash::operator()(Call const& call) const noexcept -> u64 {
+    u64 hash = std::hash<FunctionStatement const*>{}(call.function);
+    for(Value const& argument : call.arguments) hash = hash * 31 + std::hash<Value>{}(argument);
+    return hash;
+  }
+
+  auto Interpreter::evaluate(Expression& expr) noexcept -> std::optional<Value> {
+    steps = 0;
+    memory = 0;
+    failed = false;
+    returning = false;
+
+    std::optional<Value> value = eval(expr);
+    return failed ? std::nullopt : value;
+  }
+
+  auto Interpreter::define(DeclarationStatement const& constant, Value value) -> void {
+    // * The elements of a constant string or array can still be assigned, through it or through a copy of it
+    if(std::holds_alternative<std::string>(value.data) or std::holds_alternative<std::shared_ptr<Value::Array const>>(value.data)) return;
+    constants[&constant] = std::move(value);
+  }
+
+  auto Interpreter::constant(DeclarationStatement const& constant) const noexcept -> Value const* {
+    return constants.find(&constant);
+  }
+
+  auto Interpreter::memoized() const noexcept -> u64 {
+    return hits;
+  }
+
+  auto Interpreter::operator()(Identifier& arg) noexcept -> std::any {
+    Value const* value = variable(arg);
+    if(not value or std::holds_alternative<std::monostate>(value->data)) return fail();
+    return *value;
+  }
+
+  auto Interpreter::operator()(BoolLiteral& arg) noexcept -> std::any {
+    return Value{ arg.value };
+  }
+
+  auto Interpreter::operator()(ObjectLiteral& arg) noexcept -> std::any {
+    return fail();
+  }
+
+  auto Interpreter::operator()(StringLiteral& arg) noexcept -> std::any {
+    if(not allocate(arg.value.size())) return fail();
+    return Value{ std::string(arg.value) };
+  }
+
+  auto Interpreter::operator()(FloatLiteral& arg) noexcept -> std::any {
+    return Value{ arg.value };
+  }
+
+  auto Interpreter::operator()(IntLiteral& arg) noexcept -> std::any {
+    return Value{ arg.value };
+  }
+
+  auto Interpreter::operator()(CharLiteral& arg) noexcept -> std::any {
+    return Value{ arg.value };
+  }
+
+  auto Interpreter::operator()(PrefixExpression& arg) noexcept -> std::any {
+    const std::optional<Value> operand = eval(*arg.expr);
+    if(not operand) return fail();
+
+    const std::optional<Constant> constant = scalar(*operand);
+    if(not constant) return fail();
+
+    try {
+      if(std::optional<Constant> value = ConstantFolder::unary(arg.oper, *constant)) return wrap(*value);
+    } catch(std::exception const&) {
+      // * The program would fault here
+    }
+    return fail();
+  }
+
+  auto Interpreter::operator()(InfixExpression& arg) noexcept -> std::any {
+    if(arg.oper == Token::Type::DOT) return fail();
+    if(arg.oper == Token::Type::ASSIGN or Token::compoundOperatorOf(arg.oper) != Token::Type::ILLEGAL) return assign(arg);
+
+    // * 'and' and 'or' do not evaluate their right-hand side once the result is known
+    if(arg.oper == Token::Type::AND or arg.oper == Token::Type::OR) {
+      const std::optional<bool> lhs = condition(*arg.lhs);
+      if(not lhs) return fail();
+      if(*lhs == (arg.oper == Token::Type::OR)) return Value{ Boolean{ *lhs } };
+
+      const std::optional<bool> rhs = condition(*arg.rhs);
+      if(not rhs) return fail();
+      return Value{ Boolean{ *rhs } };
+    }
+
+    const std::optional<Value> lhs = eval(*arg.lhs);
+    if(not lhs) return fail();
+    const std::optional<Value> rhs = eval(*arg.rhs);
+    if(not rhs) return fail();
+
+    std::optional<Value> value = combine(arg.oper, *lhs, *rhs);
+    if(not value) return fail();
+    return std::move(*value);
+  }
+
+  auto Interpreter::operator()(CallExpression& arg) noexcept -> std::any {
+    Identifier const* name = arg.callee();
+    if(not name or name->binding.kind != Binding::Kind::FUNCTION) return fail();
+
+    auto* function = static_cast<FunctionStatement*>(name->binding.declaration);
+    bool const* callable = pure.find(function);
+    if(not callable or not *callable or frames.size() >= limits.depth) return fail();
+
+    Call call { function, { } };
+    call.arguments.reserve(arg.size());
+    for(auto& argument : arg) {
+      std::optional<Value> value = eval(*argument);
+      if(not value) return fail();
+      call.arguments.push_back(std::move(*value));
+    }
+
+    if(Value const* known = memo.find(call)) {
+      ++hits;
+      return *known;
+    }
+
+    // * Parameters take the first slots of the frame, in order
+    if(not allocate(function->frame_size * sizeof(Value))) return fail();
+    frames.emplace_back(std::max<u64>(function->frame_size, call.arguments.size()));
+    std::ranges::copy(call.arguments, frames.back().begin());
+
+    visit(*function->block);
+
+    Value value = returning ? std::move(result) : Value{ };
+    returning = false;
+    result = Value{ };
+    frames.pop_back();
+
+    if(failed) return { };
+    if(memo.size() < limits.memo) memo.insert(call, value);
+    return value;
+  }
+
+  auto Interpreter::operator()(SubscriptExpression& arg) noexcept -> std::any {
+    const std::optional<Value> array = eval(*arg.array);
+    if(not array) return fail();
+    const std::optional<Value> index = eval(*arg.index);
+    if(not index) return fail();
+
+    Long const* position = std::get_if<Long>(&index->data);
+    if(not position or *position < 0) return fail();
+    const u64 at = position->unwrap();
+
+    if(std::string const* text = std::get_if<std::string>(&array->data); text and at < text->size())
+      return Value{ Character{ (*text)[at] } };
+
+    if(auto const* elements = std::get_if<std::shared_ptr<Value::Array const>>(&array->data); elements and *elements and at < (*elements)->size())
+      return (**elements)[at];
+
+    return fail();
+  }
+
+  auto Interpreter::operator()(ArrayLiteral& arg) noexcept -> std::any {
+    if(not allocate(arg.size() * sizeof(Value))) return fail();
+
+    auto elements = std::make_shared<Value::Array>();
+    elements->reserve(arg.size());
+    for(auto& element : arg) {
+      std::optional<Value> value = eval(*element);
+      if(not value) return fail();
+      elements->push_back(std::move(*value));
+    }
+    return Value{ std::shared_ptr<Value::Array const>{ std::move(elements) } };
+  }
+
+  auto Interpreter::operator()(ExpressionStatement& arg) noexcept -> std::any {
+    if(not eval(*arg.expr)) return fail();
+    return { };
+  }
+
+  auto Interpreter::operator()(ReturnStatement& arg) noexcept -> std::any {
+    std::optional<Value> value = eval(*arg.expr);
+    if(not value) return fail();
+
+    result = std::move(*value);
+    returning = true;
+    return { };
+  }
+
+  auto Interpreter::operator()(PrintStatement& arg) noexcept -> std::any {
+    return fail();
+  }
+
+  auto Interpreter::operator()(BlockStatement& arg) noexcept -> std::any {
+    for(auto& stmt : arg) {
+      if(not step()) return fail();
+      visit(*stmt);
+      if(failed or returning) break;
+    }
+    return { };
+  }
+
+  auto Interpreter::operator()(IfStatement& arg) noexcept -> std::any {
+    const std::optional<bool> taken = condition(*arg.condition);
+    if(not taken) return fail();
+
+    if(*taken) visit(*arg.block);
+    else if(arg.alternative) visit(*arg.alternative);
+    return { };
+  }
+
+  auto Interpreter::operator()(WhileStatement& arg) noexcept -> std::any {
+    while(not failed and not returning) {
+      const std::optional<bool> taken = condition(*arg.condition);
+      if(not taken) return fail();
+      if(not *taken) break;
+      visit(*arg.block);
+    }
+    return { };
+  }
+
+  auto Interpreter::operator()(ForStatement& arg) noexcept -> std::any {
+    if(not eval(*arg.initializer)) return fail();
+
+    while(not failed and not returning) {
+      const std::optional<bool> taken = condition(*arg.condition);
+      if(not taken) return fail();
+      if(not *taken) break;
+
+      visit(*arg.block);
+      if(failed or returning) break;
+      if(not eval(*arg.modifier)) return fail();
+    }
+    return { };
+  }
+
+  auto Interpreter::operator()(DeclarationStatement& arg) noexcept -> std::any {
+    // * Uninitialized locals have no defined value to start from
+    if(frames.empty() or not arg.expr) return fail();
+
+    std::optional<Value> value = eval(*arg.expr);
+    if(not value) return fail();
+
+    std::vector<Value>& frame = frames.back();
+    if(arg.slot >= frame.size()) return fail();
+
+    frame[arg.slot] = std::move(*value);
+    return { };
+  }
+
+  auto Interpreter::fail() noexcept -> std::any {
+    failed = true;
+    return { };
+  }
+
+  auto Interpreter::step() noexcept -> bool {
+    return ++steps <= limits.steps;
+  }
+
+  auto Interpreter::allocate(u64 bytes) noexcept -> bool {
+    memory += bytes;
+    return memory <= limits.memory;
+  }
+
+  auto Interpreter::eval(Expression& expr) noexcept -> std::optional<Value> {
+    if(failed or not step()) {
+      failed = true;
+      return std::nullopt;
+    }
+
+    std::any value = visit(expr);
+    Value* result = std::any_cast<Value>(&value);
+    if(failed or not result) return std::nullopt;
+    return std::move(*result);
+  }
+
+  auto Interpreter::condition(Expression& expr) noexcept -> std::optional<bool> {
+    const std::optional<Value> value = eval(expr);
+    Boolean const* truth = value ? std::get_if<Boolean>(&value->data) : nullptr;
+    return truth ? std::optional<bool>{ truth->unwrap() } : std::nullopt;
+  }
+
+  auto Interpreter::variable(Identifier const& name) noexcept -> Value* {
+    const Binding& binding = name.binding;
+    if(binding.kind != Binding::Kind::LOCAL and binding.kind != Binding::Kind::PARAMETER) return nullptr;
+
+    // * Outside of a call, only constants recorded by define() are known
+    if(frames.empty()) {
+      if(binding.kind != Binding::Kind::LOCAL) return nullptr;
+      return constants.find(static_cast<DeclarationStatement*>(binding.declaration));
+    }
+
+    std::vector<Value>& frame = frames.back();
+    return binding.slot < frame.size() ? &frame[binding.slot] : nullptr;
+  }
+
+  auto Interpreter::assign(InfixExpression& arg) noexcept -> std::any {
+    auto* name = dynamic_cast<Identifier*>(arg.lhs.get());
+    if(frames.empty() or not name) return fail();
+
+    std::optional<Value> value = eval(*arg.rhs);
+    if(not value) return fail();
+
+    Value* target = variable(*name);
+    if(not target) return fail();
+
+    const Token::Type oper = Token::compoundOperatorOf(arg.oper);
+    if(oper != Token::Type::ILLEGAL) {
+      value = combine(oper, *target, *value);
+      if(not value) return fail();
+    }
+
+    *target = *value;
+    return std::move(*value);
+  }
+
+  auto Interpreter::combine(Token::Type oper, Value const& lhs, Value const& rhs) noexcept -> std::optional<Value> {
+    std::string const* left = std::get_if<std::string>(&lhs.data);
+    std::string const* right = std::get_if<std::string>(&rhs.data);
+
+    if(left and right) {
+      switch(oper) {
+        case Token::Type::PLUS:
+          if(not allocate(left->size() + right->size())) return std::nullopt;
+          return Value{ *left + *right };
+        case Token::Type::EQUALS: return Value{ Boolean{ *left == *right } };
+        case Token::Type::NOT_EQ: return Value{ Boolean{ *left != *right } };
+        default: return std::nullopt;
+      }
+    }
+
+    const std::optional<Constant> lhs_constant = scalar(lhs);
+    const std::optional<Constant> rhs_constant = scalar(rhs);
+    if(not lhs_constant or not rhs_constant) return std::nullopt;
+
+    try {
+      if(std::optional<Constant> value = ConstantFolder::binary(oper, *lhs_constant, *rhs_constant)) return wrap(*value);
+    } catch(std::exception const&) {
+      // * The program would fault here
+    }
+    return std::nullopt;
+  }
+
+}
+
+auto std::hash<fridayc::Value>::operator()(fridayc::Value const& value) const noexcept -> u64 {
+  using namespace fridayc;
+
+  const u64 contents = std::visit([](auto const& data) -> u64 {
+    using T = std::decay_t<decltype(data)>;
+
+    if constexpr (std::same_as<T, std::monostate>) return 0;
+    else if constexpr (std::same_as<T, std::string>) return std::hash<std::string>{}(data);
+    else if constexpr (std::same_as<T, Double>) return std::bit_cast<u64>(data.unwrap());
+    else if constexpr (std::same_as<T, std::shared_ptr<Value::Array const>>) {
+      u64 hash = 0;
+      if(data) for(Value const& element : *data) hash = hash * 31 + std::hash<Value>{}(element);
+      return hash;
+    }
+    else return static_cast<u64>(data.unwrap());
+  }, value.data);
+
+  return contents * 8 + value.data.index();
+}
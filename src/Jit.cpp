@@ -0,0 +1,430 @@
+#include "Jit.hpp"
+#include "Assembler.hpp"
+
+#if defined(__x86_64__) and defined(__unix__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace fridayc {
+
+  using bytecode::Opcode;
+  using namespace x86;
+
+  namespace {
+
+    using Context = NativeRuntime::Context;
+    using Fault = NativeRuntime::Fault;
+    using Returns = NativeRuntime::Returns;
+
+    /// @brief Scalars are the first 8 bytes of a cell
+    constexpr i32 CELL = sizeof(runtime::Cell);
+
+    /// @brief Where the frame pointer keeps the site of the call, under the saved rbx and r12
+    constexpr i32 SITE_SLOT = -24;
+
+    constexpr auto R(u32 reg) noexcept -> i32 {
+      return (i32)reg * CELL;
+    }
+
+  }
+
+  Jit::Jit(bytecode::Module& module, std::ostream& out, ExecutionLimits limits) noexcept
+    : module { module }
+    , native { module, out, limits }
+  {}
+
+  Jit::~Jit() noexcept {
+#if defined(__x86_64__) and defined(__unix__)
+    if(memory) munmap(memory, mapped);
+#endif
+  }
+
+  auto Jit::available() noexcept -> bool {
+#if defined(__x86_64__) and defined(__unix__)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  auto Jit::compile() -> std::vector<Error> {
+    errors.clear();
+    compiled.clear();
+    calls.clear();
+
+#if defined(__x86_64__) and defined(__unix__)
+    // * Code of an earlier compilation is released first, a compilation that fails leaves nothing to run
+    if(memory) munmap(memory, mapped);
+    memory = nullptr;
+#endif
+
+    if(not available()) {
+      errors.emplace_back("The JIT needs x86-64 and a Unix-like system"s, Span{ });
+      return std::move(errors);
+    }
+    if(module.functions.empty()) {
+      errors.emplace_back("No 'main' function to run"s, Span{ });
+      return std::move(errors);
+    }
+
+    try {
+      for(u32 index = 0; index < module.functions.size(); ++index) module.materialize(index);
+    } catch(RuntimeError const& error) {
+      errors.push_back(error);
+      return std::move(errors);
+    }
+
+    Assembler assembler;
+    for(u32 index = 0; index < module.functions.size(); ++index) {
+      const u32 start = assembler.size();
+      translate(assembler, index);
+      compiled.push_back({ module.functions[index].name, start, assembler.size() - start });
+    }
+    for(Call const& call : calls) assembler.patch(call.position, compiled[call.callee].offset);
+
+#if defined(__x86_64__) and defined(__unix__)
+    // * Written while the pages are only writable, then they are only executable
+    const u64 page = (u64)sysconf(_SC_PAGESIZE);
+    mapped = (assembler.size() + page - 1) / page * page;
+    void* pages = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(pages == MAP_FAILED) {
+      errors.emplace_back("Cannot map memory for the machine code"s, module.functions.front().span);
+      return std::move(errors);
+    }
+    std::memcpy(pages, assembler.code().data(), assembler.size());
+    if(mprotect(pages, mapped, PROT_READ | PROT_EXEC) != 0) {
+      munmap(pages, mapped);
+      errors.emplace_back("Cannot make the machine code executable"s, module.functions.front().span);
+      return std::move(errors);
+    }
+    memory = static_cast<u8*>(pages);
+#endif
+
+    publish();
+    return std::move(errors);
+  }
+
+  auto Jit::run() -> std::vector<Error> {
+    if(not memory) {
+      errors.clear();
+      errors.emplace_back("No compiled 'main' to run"s, Span{ });
+      return std::move(errors);
+    }
+    return native.run(reinterpret_cast<NativeRuntime::Entry>(memory + compiled.front().offset));
+  }
+
+  auto Jit::status() const noexcept -> i64 {
+    return native.status();
+  }
+
+  auto Jit::functions() const noexcept -> std::vector<Compiled> const& {
+    return compiled;
+  }
+
+  auto Jit::translate(Assembler& assembler, u32 index) -> void {
+    bytecode::Function const& function = module.functions[index];
+    Assembler& a = assembler;
+
+    // * Native offset of every instruction, and the jumps to patch once they are all placed
+    std::vector<u32> labels(function.code.size(), 0);
+    std::vector<std::pair<u32, u32>> jumps;
+    std::vector<u32> exits;
+
+    /// @brief A jump to the out of line code raising a fault, with the instruction it is raised by
+    struct Stub {
+      u32   position;
+      Fault kind;
+      u32   at;
+    };
+    std::vector<Stub> stubs;
+
+    const auto raise = [&](Condition condition, Fault kind, u32 at) { stubs.push_back({ a.jump(condition), kind, at }); };
+    const auto leave = [&](Condition condition) { exits.push_back(a.jump(condition)); };
+
+    // * The runtime is called as slow(context, base, function, at) and returns whether it faulted
+    const auto callback = [&](u32 at) {
+      a.raw({ 0x4C, 0x89, 0xE7, 0x48, 0x89, 0xDE });  // mov rdi, r12; mov rsi, rbx
+      a.immediate(RDX, index);
+      a.immediate(RCX, at);
+      a.immediate(RAX, reinterpret_cast<u64>(&NativeRuntime::slow));
+      a.raw({ 0xFF, 0xD0, 0x85, 0xC0 });              // call rax; test eax, eax
+      leave(Condition::NE);
+    };
+
+    // * Frame pointer, rbx and r12 saved, 16 bytes of locals keep the stack aligned for calls
+    a.raw({ 0x55, 0x48, 0x89, 0xE5, 0x53, 0x41, 0x54, 0x48, 0x83, 0xEC, 0x10 });
+    a.raw({ 0x48, 0x89, 0xFB, 0x49, 0x89, 0xF4 });  // mov rbx, rdi; mov r12, rsi
+    if(NativeRuntime::falls(function)) {
+      a.load(0x8B, RAX, R12, offsetof(Context, site));
+      a.store(RBP, SITE_SLOT, RAX);
+    }
+    for(u64 k = 0; k < function.constants.size(); ++k) {
+      a.immediate(RAX, (u64)function.constants[k]);
+      a.store(RBX, R(function.constant_base + (u32)k), RAX);
+    }
+
+    for(u32 at = 0; at < function.code.size(); ++at) {
+      bytecode::Instruction const& ip = function.code[at];
+      labels[at] = a.size();
+
+      const auto binary = [&](u8 op) {
+        a.load(0x8B, RAX, RBX, R(ip.b));
+        a.load(op, RAX, RBX, R(ip.c));
+      };
+      const auto checked = [&](u16 op) {
+        a.load(0x8B, RAX, RBX, R(ip.b));
+        a.load(op, RAX, RBX, R(ip.c));
+        raise(Condition::O, Fault::INTEGER_OVERFLOW, at);
+        a.store(RBX, R(ip.a), RAX);
+      };
+      const auto compare = [&](Condition condition) {
+        binary(0x3B);
+        a.set(condition);
+        a.store(RBX, R(ip.a), RAX);
+      };
+      const auto real = [&](u8 op) {
+        a.sse(0xF2, 0x10, 0, RBX, R(ip.b));
+        a.sse(0xF2, op, 0, RBX, R(ip.c));
+        a.sse(0xF2, 0x11, 0, RBX, R(ip.a));
+      };
+      // * Unordered floats compare false, so greater is tested with the operands swapped
+      const auto greater = [&](Condition condition) {
+        a.sse(0xF2, 0x10, 0, RBX, R(ip.c));
+        a.sse(0x66, 0x2E, 0, RBX, R(ip.b));
+        a.set(condition);
+        a.store(RBX, R(ip.a), RAX);
+      };
+      const auto branch = [&](Condition condition) {
+        a.load(0x8B, RAX, RBX, R(ip.a));
+        a.load(0x3B, RAX, RBX, R(ip.b));
+        jumps.emplace_back(a.jump(condition), ip.c);
+      };
+      const auto test = [&](Condition condition) {
+        a.group(0x83, 7, RBX, R(ip.a));
+        a.byte(0);
+        jumps.emplace_back(a.jump(condition), ip.c);
+      };
+      const auto divide = [&](Register result) {
+        a.load(0x8B, RCX, RBX, R(ip.c));
+        a.raw({ 0x48, 0x85, 0xC9 });                // test rcx, rcx
+        raise(Condition::E, Fault::DIVISION_BY_ZERO, at);
+        a.load(0x8B, RAX, RBX, R(ip.b));
+        a.raw({ 0x48, 0x83, 0xF9, 0xFF });          // cmp rcx, -1
+        const u32 skip = a.jump(Condition::NE);
+        a.immediate(RDX, (u64)std::numeric_limits<i64>::min());
+        a.raw({ 0x48, 0x39, 0xD0 });                // cmp rax, rdx
+        raise(Condition::E, Fault::INTEGER_OVERFLOW, at);
+        a.patch(skip, a.size());
+        a.raw({ 0x48, 0x99, 0x48, 0xF7, 0xF9 });    // cqo; idiv rcx
+        a.store(RBX, R(ip.a), result);
+      };
+      const auto shift = [&] {
+        a.load(0x8B, RCX, RBX, R(ip.c));
+        a.raw({ 0x48, 0x83, 0xF9, 0x3F });          // cmp rcx, 63
+        raise(Condition::A, Fault::SHIFT_OUT_OF_RANGE, at);
+        a.load(0x8B, RAX, RBX, R(ip.b));
+      };
+
+      switch(ip.op) {
+        case Opcode::MOVE:
+          a.load(0x8B, RAX, RBX, R(ip.b));
+          a.store(RBX, R(ip.a), RAX);
+          break;
+
+        case Opcode::ADD: checked(0x03); break;
+        case Opcode::SUB: checked(0x2B); break;
+        case Opcode::MUL: checked(0x0FAF); break;
+        case Opcode::DIV: divide(RAX); break;
+        case Opcode::MOD: divide(RDX); break;
+        case Opcode::BIT_AND: binary(0x23); a.store(RBX, R(ip.a), RAX); break;
+        case Opcode::BIT_OR: binary(0x0B); a.store(RBX, R(ip.a), RAX); break;
+        case Opcode::SHL:
+          // * Shifted back, a value that lost bits to the shift differs from the original
+          shift();
+          a.raw({ 0x48, 0x89, 0xC2, 0x48, 0xD3, 0xE2 });  // mov rdx, rax; shl rdx, cl
+          a.raw({ 0x49, 0x89, 0xD0, 0x49, 0xD3, 0xF8 });  // mov r8, rdx; sar r8, cl
+          a.raw({ 0x49, 0x39, 0xC0 });                    // cmp r8, rax
+          raise(Condition::NE, Fault::INTEGER_OVERFLOW, at);
+          a.store(RBX, R(ip.a), RDX);
+          break;
+        case Opcode::SHR:
+          shift();
+          a.raw({ 0x48, 0xD3, 0xF8 });                    // sar rax, cl
+          a.store(RBX, R(ip.a), RAX);
+          break;
+        case Opcode::NEG:
+          a.load(0x8B, RAX, RBX, R(ip.b));
+          a.raw({ 0x48, 0xF7, 0xD8 });                    // neg rax
+          raise(Condition::O, Fault::INTEGER_OVERFLOW, at);
+          a.store(RBX, R(ip.a), RAX);
+          break;
+        case Opcode::BIT_NOT:
+          a.load(0x8B, RAX, RBX, R(ip.b));
+          a.raw({ 0x48, 0xF7, 0xD0 });                    // not rax
+          a.store(RBX, R(ip.a), RAX);
+          break;
+        case Opcode::ADD_IMM:
+          a.load(0x8B, RAX, RBX, R(ip.b));
+          a.raw({ 0x48, 0x05 });                          // add rax, imm32
+          a.dword((u32)(i32)(i16)ip.c);
+          raise(Condition::O, Fault::INTEGER_OVERFLOW, at);
+          a.store(RBX, R(ip.a), RAX);
+          break;
+
+        case Opcode::FADD: real(0x58); break;
+        case Opcode::FSUB: real(0x5C); break;
+        case Opcode::FMUL: real(0x59); break;
+        case Opcode::FDIV: {
+          // * Only a divisor equal to zero faults, a NaN compares unordered
+          a.raw({ 0x66, 0x0F, 0x57, 0xC9 });              // xorpd xmm1, xmm1
+          a.sse(0x66, 0x2E, 1, RBX, R(ip.c));
+          const u32 unordered = a.jump(Condition::P);
+          raise(Condition::E, Fault::DIVISION_BY_ZERO, at);
+          a.patch(unordered, a.size());
+          real(0x5E);
+          break;
+        }
+        case Opcode::FNEG:
+          a.load(0x8B, RAX, RBX, R(ip.b));
+          a.raw({ 0x48, 0x0F, 0xBA, 0xF8, 0x3F });        // btc rax, 63
+          a.store(RBX, R(ip.a), RAX);
+          break;
+
+        case Opcode::EQ: compare(Condition::E); break;
+        case Opcode::NE: compare(Condition::NE); break;
+        case Opcode::LT: compare(Condition::L); break;
+        case Opcode::LE: compare(Condition::LE); break;
+        case Opcode::FEQ:
+        case Opcode::FNE: {
+          // * Equal is ordered and zero, not equal is unordered or nonzero
+          const bool equal = ip.op == Opcode::FEQ;
+          a.sse(0xF2, 0x10, 0, RBX, R(ip.b));
+          a.sse(0x66, 0x2E, 0, RBX, R(ip.c));
+          a.raw({ 0x0F, (u8)(0x90 | (equal ? Condition::E : Condition::NE)), 0xC0 });
+          a.raw({ 0x0F, (u8)(0x90 | (equal ? Condition::NP : Condition::P)), 0xC1 });
+          a.raw({ (u8)(equal ? 0x20 : 0x08), 0xC8, 0x0F, 0xB6, 0xC0 });  // and or or al, cl; movzx eax, al
+          a.store(RBX, R(ip.a), RAX);
+          break;
+        }
+        case Opcode::FLT: greater(Condition::A); break;
+        case Opcode::FLE: greater(Condition::AE); break;
+
+        case Opcode::NOT:
+          a.group(0x83, 7, RBX, R(ip.b));
+          a.byte(0);
+          a.set(Condition::E);
+          a.store(RBX, R(ip.a), RAX);
+          break;
+
+        case Opcode::JUMP: jumps.emplace_back(a.jump(), ip.c); break;
+        case Opcode::JUMP_IF: test(Condition::NE); break;
+        case Opcode::JUMP_IF_NOT: test(Condition::E); break;
+        case Opcode::JEQ: branch(Condition::E); break;
+        case Opcode::JNE: branch(Condition::NE); break;
+        case Opcode::JLT: branch(Condition::L); break;
+        case Opcode::JLE: branch(Condition::LE); break;
+        case Opcode::INC_JLT:
+          a.load(0x8B, RAX, RBX, R(ip.a));
+          a.raw({ 0x48, 0x83, 0xC0, 0x01 });              // add rax, 1
+          raise(Condition::O, Fault::INTEGER_OVERFLOW, at);
+          a.store(RBX, R(ip.a), RAX);
+          a.load(0x3B, RAX, RBX, R(ip.b));
+          jumps.emplace_back(a.jump(Condition::L), ip.c);
+          break;
+
+        case Opcode::CALL: {
+          bytecode::Function const& callee = module.functions[ip.b];
+
+          // * As deep as the limit allows, and the frame of the callee must fit in the stack
+          a.load(0x8B, RAX, R12, offsetof(Context, depth), false);
+          a.load(0x3B, RAX, R12, offsetof(Context, limit), false);
+          raise(Condition::AE, Fault::STACK_OVERFLOW, at);
+          a.raw({ 0x83, 0xC0, 0x01 });                    // add eax, 1
+          a.store(R12, offsetof(Context, depth), RAX, false);
+          a.load(0x8D, RAX, RBX, R(ip.c + callee.registers));
+          a.load(0x3B, RAX, R12, offsetof(Context, end));
+          raise(Condition::A, Fault::STACK_OVERFLOW, at);
+
+          if(NativeRuntime::falls(callee)) {
+            a.immediate(RAX, (u64)index << 32 | at);
+            a.store(R12, offsetof(Context, site), RAX);
+          }
+          a.load(0x8D, RDI, RBX, R(ip.c));
+          a.raw({ 0x4C, 0x89, 0xE6 });                    // mov rsi, r12
+          calls.push_back({ a.call(), ip.b });
+          a.group(0xFF, 1, R12, offsetof(Context, depth), false);
+          a.raw({ 0x85, 0xC0 });                          // test eax, eax
+          leave(Condition::NE);
+
+          switch(NativeRuntime::returnsOf(callee)) {
+            case Returns::SCALAR:
+              a.load(0x8B, RAX, R12, offsetof(Context, value));
+              a.store(RBX, R(ip.a), RAX);
+              break;
+            case Returns::REFERENCE: callback(at); break;
+            case Returns::NOTHING: break;
+          }
+          break;
+        }
+
+        case Opcode::RETURN:
+          a.load(0x8B, RAX, RBX, R(ip.a));
+          a.store(R12, offsetof(Context, value), RAX);
+          [[fallthrough]];
+        case Opcode::RETURN_VOID:
+          if(function.references) callback(at);
+          a.raw({ 0x31, 0xC0 });                          // xor eax, eax
+          exits.push_back(a.jump());
+          break;
+        case Opcode::RETURN_REF:
+          callback(at);
+          a.raw({ 0x31, 0xC0 });
+          exits.push_back(a.jump());
+          break;
+        case Opcode::FALL_OFF:
+          stubs.push_back({ a.jump(), Fault::ENDED, at });
+          break;
+
+        default:
+          callback(at);
+          break;
+      }
+    }
+
+    // * Status in eax, whatever left the function
+    const u32 epilogue = a.size();
+    a.raw({ 0x48, 0x8D, 0x65, 0xF0, 0x41, 0x5C, 0x5B, 0x5D, 0xC3 });  // lea rsp, [rbp - 16]; pop r12; pop rbx; pop rbp; ret
+
+    // * Faults are raised out of line as fail(context, function, at, kind, site), then the status is 1
+    const u32 fault = a.size();
+    if(not stubs.empty()) {
+      a.raw({ 0x4C, 0x89, 0xE7 });                        // mov rdi, r12
+      a.immediate(RSI, index);
+      a.load(0x8B, R8, RBP, SITE_SLOT);
+      a.immediate(RAX, reinterpret_cast<u64>(&NativeRuntime::fail));
+      a.raw({ 0xFF, 0xD0 });                              // call rax
+      a.immediate(RAX, 1);
+      exits.push_back(a.jump());
+    }
+    for(Stub const& stub : stubs) {
+      a.patch(stub.position, a.size());
+      a.immediate(RDX, stub.at);
+      a.immediate(RCX, (u32)stub.kind);
+      a.patch(a.jump(), fault);
+    }
+
+    for(auto [position, target] : jumps) a.patch(position, labels[target]);
+    for(const u32 position : exits) a.patch(position, epilogue);
+  }
+
+  auto Jit::publish() const -> void {
+#if defined(__x86_64__) and defined(__unix__)
+    // * Appended, an earlier JIT of the same process may have listed its code already
+    std::ofstream map("/tmp/perf-{}.map"f.format(getpid()), std::ios::app);
+    for(Compiled const& function : compiled)
+      map << "{:x} {:x} fx::{}\n"f.format(reinterpret_cast<u64>(memory + function.offset), function.size, function.name);
+#endif
+  }
+
+}
@@ -0,0 +1,525 @@
+#include "LoopOptimizer.hpp"
+#include "Analyzer.hpp"
+#include "Cloner.hpp"
+#include "SideEffects.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    auto literal(Expression const& expr) noexcept -> bool {
+      return dynamic_cast<IntLiteral const*>(&expr)
+        or dynamic_cast<FloatLiteral const*>(&expr)
+        or dynamic_cast<BoolLiteral const*>(&expr)
+        or dynamic_cast<CharLiteral const*>(&expr)
+        or dynamic_cast<StringLiteral const*>(&expr)
+        or dynamic_cast<ObjectLiteral const*>(&expr);
+    }
+
+    /// @brief Tells whether computing an expression once saves anything
+    auto worthy(Expression const& expr) noexcept -> bool {
+      if(literal(expr) or dynamic_cast<Identifier const*>(&expr)) return false;
+
+      if(auto* prefix = dynamic_cast<PrefixExpression const*>(&expr)) return not literal(*prefix->expr);
+
+      if(auto* infix = dynamic_cast<InfixExpression const*>(&expr); infix and infix->oper == Token::Type::DOT) {
+        auto* object = dynamic_cast<Identifier const*>(infix->lhs.get());
+        return not object or object->binding.kind != Binding::Kind::ENUM;
+      }
+
+      return true;
+    }
+
+    auto same(Expression const& expr, Identifier const& variable) noexcept -> bool {
+      auto* name = dynamic_cast<Identifier const*>(&expr);
+      return name and name->binding.kind == variable.binding.kind and name->binding.slot == variable.binding.slot;
+    }
+
+    auto integer(Expression const* expr) noexcept -> std::optional<i64> {
+      if(auto const* literal = dynamic_cast<IntLiteral const*>(expr)) return literal->value.unwrap();
+      auto const* negation = dynamic_cast<PrefixExpression const*>(expr);
+      if(not negation or negation->oper != Token::Type::MINUS) return std::nullopt;
+      auto const* literal = dynamic_cast<IntLiteral const*>(negation->expr.get());
+      if(not literal or literal->value.unwrap() == std::numeric_limits<i64>::min()) return std::nullopt;
+      return -literal->value.unwrap();
+    }
+
+    /// @brief Tells whether int arithmetic is done on literals and cannot overflow
+    auto bounded(Expression const& expr) noexcept -> bool {
+      if(integer(&expr)) return true;
+
+      auto const* infix = dynamic_cast<InfixExpression const*>(&expr);
+      const std::optional<i64> lhs = infix ? integer(infix->lhs.get()) : std::nullopt;
+      const std::optional<i64> rhs = infix ? integer(infix->rhs.get()) : std::nullopt;
+      if(not lhs or not rhs) return false;
+
+      i64 result;
+      switch(infix->oper) {
+        case Token::Type::PLUS: return not __builtin_add_overflow(*lhs, *rhs, &result);
+        case Token::Type::MINUS: return not __builtin_sub_overflow(*lhs, *rhs, &result);
+        case Token::Type::STAR: return not __builtin_mul_overflow(*lhs, *rhs, &result);
+        default: return false;
+      }
+    }
+
+    /// @brief Tells whether an expression calls a function
+    auto calls(Expression& expr) noexcept -> bool {
+      std::vector<bool> slots;
+      SideEffects effects(slots);
+      effects.visit(expr);
+      return effects.calls;
+    }
+
+  }
+
+  LoopOptimizer::LoopOptimizer(Analyzer const& analyzer, TypeTable const& table) noexcept
+    : analyzer { analyzer }
+    , table { table }
+  {}
+
+  auto LoopOptimizer::optimize(Program& program) -> void {
+    visit(program);
+  }
+
+  auto LoopOptimizer::hoistedExpressions() const noexcept -> u64 {
+    return expressions;
+  }
+
+  auto LoopOptimizer::reducedProducts() const noexcept -> u64 {
+    return products;
+  }
+
+  auto LoopOptimizer::operator()(PrefixExpression& arg) noexcept -> std::any {
+    rewrite(arg.expr);
+    return { };
+  }
+
+  auto LoopOptimizer::operator()(InfixExpression& arg) noexcept -> std::any {
+    // * Member names are not expressions, and the right-hand side of 'and'/'or' may not run
+    if(arg.oper == Token::Type::DOT) rewrite(arg.lhs);
+    else if(arg.oper == Token::Type::AND or arg.oper == Token::Type::OR) {
+      rewrite(arg.lhs);
+      const bool entered = std::exchange(anticipated, false);
+      rewrite(arg.rhs);
+      anticipated = entered and not calls(*arg.rhs);
+    } else {
+      rewrite(arg.lhs);
+      rewrite(arg.rhs);
+    }
+    return { };
+  }
+
+  auto LoopOptimizer::operator()(CallExpression& arg) noexcept -> std::any {
+    for(auto& argument : arg) rewrite(argument);
+    // * What the condition computes after a call no longer runs first in the loop, the call may print or fail
+    anticipated = false;
+    return { };
+  }
+
+  auto LoopOptimizer::operator()(SubscriptExpression& arg) noexcept -> std::any {
+    rewrite(arg.array);
+    const bool outer = std::exchange(indexed, true);
+    rewrite(arg.index);
+    indexed = outer;
+    return { };
+  }
+
+  auto LoopOptimizer::operator()(ExpressionStatement& arg) noexcept -> std::any {
+    rewrite(arg.expr);
+    return { };
+  }
+
+  auto LoopOptimizer::operator()(ArrayLiteral& arg) noexcept -> std::any {
+    for(auto& value : arg) rewrite(value);
+    return { };
+  }
+
+  auto LoopOptimizer::operator()(ReturnStatement& arg) noexcept -> std::any {
+    rewrite(arg.expr);
+    return { };
+  }
+
+  auto LoopOptimizer::operator()(PrintStatement& arg) noexcept -> std::any {
+    rewrite(arg.expr);
+    return { };
+  }
+
+  auto LoopOptimizer::operator()(BlockStatement& arg) noexcept -> std::any {
+    if(mode != Mode::SEARCH) return Walker::operator()(arg);
+
+    for(auto& stmt : arg) {
+      if(dynamic_cast<WhileStatement*>(stmt.get()) or dynamic_cast<ForStatement*>(stmt.get())) optimize(stmt);
+      else visit(*stmt);
+    }
+    return { };
+  }
+
+  auto LoopOptimizer::operator()(IfStatement& arg) noexcept -> std::any {
+    rewrite(arg.condition);
+    visit(*arg.block);
+    if(arg.alternative) visit(*arg.alternative);
+    return { };
+  }
+
+  auto LoopOptimizer::operator()(WhileStatement& arg) noexcept -> std::any {
+    rewrite(arg.condition);
+    visit(*arg.block);
+    return { };
+  }
+
+  auto LoopOptimizer::operator()(ForStatement& arg) noexcept -> std::any {
+    rewrite(arg.initializer);
+    rewrite(arg.condition);
+    rewrite(arg.modifier);
+    visit(*arg.block);
+    return { };
+  }
+
+  auto LoopOptimizer::operator()(FunctionStatement& arg) noexcept -> std::any {
+    function = &arg;
+    names = 0;
+    visit(*arg.block);
+    function = nullptr;
+    return { };
+  }
+
+  auto LoopOptimizer::operator()(DeclarationStatement& arg) noexcept -> std::any {
+    if(arg.expr) rewrite(arg.expr);
+    return { };
+  }
+
+  auto LoopOptimizer::optimize(Box<Statement>& slot) noexcept -> void {
+    auto* while_loop = dynamic_cast<WhileStatement*>(slot.get());
+    auto* for_loop = dynamic_cast<ForStatement*>(slot.get());
+
+    // * Inner loops first, their temporaries may then leave this loop too
+    visit(while_loop ? *while_loop->block : *for_loop->block);
+
+    loop = Loop{ };
+    loop.variant.assign(function->frame_size, false);
+    temporaries.clear();
+    hoisted.clear();
+
+    mode = Mode::HOIST;
+    if(while_loop) {
+      summarize(*while_loop);
+      anticipated = true;
+      rewrite(while_loop->condition);
+      anticipated = false;
+      visit(*while_loop->block);
+    } else {
+      // * Temporaries are computed before the initializer, which must then have nothing to reorder with
+      summarize(*for_loop->initializer);
+      const bool quiet = not loop.writes and not loop.calls and not loop.fallible;
+      summarize(*for_loop->condition);
+      summarize(*for_loop->modifier);
+      summarize(*for_loop->block);
+
+      anticipated = quiet;
+      rewrite(for_loop->condition);
+      anticipated = false;
+      rewrite(for_loop->modifier);
+      visit(*for_loop->block);
+    }
+    mode = Mode::SEARCH;
+
+    const bool reduced_loop = for_loop and reduce(*for_loop);
+    if(temporaries.empty()) return;
+
+    auto wrapper = std::make_unique<BlockStatement>();
+    wrapper->span = slot->span;
+    for(auto& declaration : temporaries) wrapper->add(std::move(declaration));
+    temporaries.clear();
+
+    if(reduced_loop) {
+      // * The step runs after the body and the updates, the original body keeps its own scope
+      auto body = std::make_unique<BlockStatement>();
+      body->span = for_loop->block->span;
+      body->add(std::move(for_loop->block));
+      for(auto& update : updates) body->add(std::move(update));
+      updates.clear();
+
+      auto step = std::make_unique<ExpressionStatement>(std::move(for_loop->modifier));
+      step->span = step->expr->span;
+      body->add(std::move(step));
+
+      auto rewritten = std::make_unique<WhileStatement>(std::move(for_loop->condition), std::move(body));
+      rewritten->span = slot->span;
+      wrapper->add(std::move(rewritten));
+    } else wrapper->add(std::move(slot));
+
+    slot = std::move(wrapper);
+  }
+
+  auto LoopOptimizer::summarize(Statement& stmt) noexcept -> void {
+    SideEffects effects(loop.variant);
+    effects.visit(stmt);
+    loop.writes |= effects.writes;
+    loop.calls |= effects.calls;
+    loop.fallible |= effects.fallible;
+  }
+
+  auto LoopOptimizer::summarize(Expression& expr) noexcept -> void {
+    SideEffects effects(loop.variant);
+    effects.visit(expr);
+    loop.writes |= effects.writes;
+    loop.calls |= effects.calls;
+    loop.fallible |= effects.fallible;
+  }
+
+  auto LoopOptimizer::rewrite(Box<Expression>& slot) noexcept -> void {
+    switch(mode) {
+      case Mode::SEARCH: break;
+      case Mode::HOIST: hoist(slot); break;
+      case Mode::REDUCE: reduce(slot); break;
+    }
+  }
+
+  auto LoopOptimizer::hoist(Box<Expression>& slot) noexcept -> void {
+    Expression& expr = *slot;
+
+    const Invariance invariant = worthy(expr) ? invariance(expr) : Invariance::VARIANT;
+    if(invariant != Invariance::VARIANT) {
+      // * A read that could fail may reuse a value computed for the condition
+      std::string key = expr.toString();
+      if(DeclarationStatement** existing = hoisted.find(key)) {
+        slot = reference(**existing, expr.span);
+        return;
+      }
+
+      Box<TypeExpression> type = typeExpression(analyzer.typeOf(expr));
+      if(type and (invariant == Invariance::SAFE or anticipated)) {
+        const Span span = expr.span;
+        DeclarationStatement* result = temporary(std::move(slot), std::move(type), true);
+        hoisted.insert(std::move(key), result);
+        slot = reference(*result, span);
+        ++expressions;
+        return;
+      }
+    }
+
+    visit(expr);
+  }
+
+  auto LoopOptimizer::reduce(ForStatement& arg) noexcept -> bool {
+    auto* step = dynamic_cast<InfixExpression*>(arg.modifier.get());
+    auto* variable = step ? dynamic_cast<Identifier*>(step->lhs.get()) : nullptr;
+    if(not variable or (variable->binding.kind != Binding::Kind::LOCAL and variable->binding.kind != Binding::Kind::PARAMETER)) return false;
+
+    // * i += c, i -= c, i = i + c, i = c + i and i = i - c
+    amount = nullptr;
+    descending = step->oper == Token::Type::MINUS_EQ;
+    if(step->oper == Token::Type::PLUS_EQ or step->oper == Token::Type::MINUS_EQ) amount = step->rhs.get();
+    else if(auto* sum = dynamic_cast<InfixExpression*>(step->rhs.get()); sum and step->oper == Token::Type::ASSIGN) {
+      descending = sum->oper == Token::Type::MINUS;
+      if(sum->oper == Token::Type::PLUS or sum->oper == Token::Type::MINUS)
+        if(same(*sum->lhs, *variable)) amount = sum->rhs.get();
+      if(sum->oper == Token::Type::PLUS and not amount and same(*sum->rhs, *variable)) amount = sum->lhs.get();
+    }
+
+    if(not amount or analyzer.typeOf(*variable) != TypeId::INT) return false;
+
+    // * The variable runs from a literal towards a literal bound, by a positive literal
+    const std::optional<i64> stride = integer(amount);
+    auto* init = dynamic_cast<InfixExpression*>(arg.initializer.get());
+    auto* relation = dynamic_cast<InfixExpression*>(arg.condition.get());
+    const std::optional<i64> first = init and init->oper == Token::Type::ASSIGN and same(*init->lhs, *variable) ? integer(init->rhs.get()) : std::nullopt;
+    const std::optional<i64> last = relation and same(*relation->lhs, *variable) ? integer(relation->rhs.get()) : std::nullopt;
+    if(not stride or *stride <= 0 or not first or not last) return false;
+
+    const bool ascending = relation->oper == Token::Type::LESS or relation->oper == Token::Type::LESS_EQ;
+    const bool towards = ascending ? not descending : descending and (relation->oper == Token::Type::GREATER or relation->oper == Token::Type::GREATER_EQ);
+    if(not towards) return false;
+
+    // * The products go from the first value to one step past the bound
+    i64 beyond;
+    if(descending ? __builtin_sub_overflow(*last, *stride, &beyond) : __builtin_add_overflow(*last, *stride, &beyond)) return false;
+    lowest = std::min(*first, beyond);
+    highest = std::max(*first, beyond);
+
+    // * The step must be the only assignment of the variable in the loop
+    std::vector<bool> assigned(function->frame_size, false);
+    SideEffects effects(assigned);
+    effects.visit(*arg.condition);
+    effects.visit(*arg.block);
+    if(variable->binding.slot < assigned.size() and assigned[variable->binding.slot]) return false;
+
+    const u64 mark = temporaries.size();
+    induction = variable;
+    reduced.clear();
+
+    mode = Mode::REDUCE;
+    rewrite(arg.condition);
+    visit(*arg.block);
+    mode = Mode::SEARCH;
+    induction = nullptr;
+
+    if(temporaries.size() == mark) return false;
+
+    // * The products start from the value the initializer gives to the variable
+    auto initializer = std::make_unique<ExpressionStatement>(std::move(arg.initializer));
+    initializer->span = initializer->expr->span;
+    temporaries.insert(temporaries.begin() + mark, std::move(initializer));
+    return true;
+  }
+
+  auto LoopOptimizer::reduce(Box<Expression>& slot) noexcept -> void {
+    auto* product = indexed ? dynamic_cast<InfixExpression*>(slot.get()) : nullptr;
+    if(not product or product->oper != Token::Type::STAR) {
+      visit(*slot);
+      return;
+    }
+
+    Expression* factor = same(*product->lhs, *induction) ? product->rhs.get()
+      : same(*product->rhs, *induction) ? product->lhs.get() : nullptr;
+
+    // * The product is computed ahead of the iterations that need it, which is only safe when it never overflows
+    const std::optional<i64> scale = factor ? integer(factor) : std::nullopt;
+    i64 extreme;
+    if(not scale or analyzer.typeOf(*product) != TypeId::INT
+      or __builtin_mul_overflow(lowest, *scale, &extreme) or __builtin_mul_overflow(highest, *scale, &extreme)
+      or __builtin_mul_overflow(*integer(amount), *scale, &extreme)) {
+      visit(*slot);
+      return;
+    }
+
+    const Span span = product->span;
+    std::string key = factor->toString();
+    if(DeclarationStatement** existing = reduced.find(key)) {
+      slot = reference(**existing, span);
+      ++products;
+      return;
+    }
+
+    // * Each step of the variable moves the product by the step times the factor
+    Cloner cloner;
+    Box<Expression> delta = cloner.clone(*factor);
+    auto* unit = dynamic_cast<IntLiteral*>(amount);
+    if(not unit or unit->value.unwrap() != 1) {
+      delta = std::make_unique<InfixExpression>(cloner.clone(*amount), Token::Type::STAR, std::move(delta));
+      delta->span = span;
+    }
+
+    Box<Expression> product_slot = std::move(slot);
+    DeclarationStatement* result = temporary(std::move(product_slot), typeExpression(TypeId::INT), false);
+    if(worthy(*delta)) {
+      DeclarationStatement* increment = temporary(std::move(delta), typeExpression(TypeId::INT), true);
+      delta = reference(*increment, span);
+    }
+
+    auto update = std::make_unique<InfixExpression>(reference(*result, span), descending ? Token::Type::MINUS_EQ : Token::Type::PLUS_EQ, std::move(delta));
+    update->span = span;
+    updates.push_back(std::make_unique<ExpressionStatement>(std::move(update)));
+    updates.back()->span = span;
+
+    reduced.insert(std::move(key), result);
+    slot = reference(*result, span);
+    ++products;
+  }
+
+  auto LoopOptimizer::invariance(Expression& expr) const noexcept -> Invariance {
+    if(literal(expr)) return dynamic_cast<ObjectLiteral*>(&expr) ? Invariance::VARIANT : Invariance::SAFE;
+
+    if(auto* name = dynamic_cast<Identifier*>(&expr)) {
+      const Binding& binding = name->binding;
+      if(binding.kind != Binding::Kind::LOCAL and binding.kind != Binding::Kind::PARAMETER) return Invariance::VARIANT;
+      // * Temporaries of this loop lie past the slots it was summarized with
+      return binding.slot < loop.variant.size() and loop.variant[binding.slot] ? Invariance::VARIANT : Invariance::SAFE;
+    }
+
+    // * Checked int arithmetic faults on overflow
+    const bool checked = analyzer.typeOf(expr) == TypeId::INT and not bounded(expr);
+
+    if(auto* prefix = dynamic_cast<PrefixExpression*>(&expr)) {
+      const Invariance result = invariance(*prefix->expr);
+      return prefix->oper == Token::Type::MINUS and checked ? std::max(result, Invariance::FALLIBLE) : result;
+    }
+
+    if(auto* infix = dynamic_cast<InfixExpression*>(&expr)) {
+      if(infix->oper == Token::Type::ASSIGN or Token::compoundOperatorOf(infix->oper) != Token::Type::ILLEGAL) return Invariance::VARIANT;
+
+      if(infix->oper == Token::Type::DOT) {
+        auto* object = dynamic_cast<Identifier*>(infix->lhs.get());
+        if(object and object->binding.kind == Binding::Kind::ENUM) return Invariance::SAFE;
+        if(object and object->binding.kind == Binding::Kind::NAMESPACE) return Invariance::VARIANT;
+        if(loop.writes or loop.calls) return Invariance::VARIANT;
+        return std::max(invariance(*infix->lhs), Invariance::FALLIBLE);
+      }
+
+      Invariance result = std::max(invariance(*infix->lhs), invariance(*infix->rhs));
+      switch(infix->oper) {
+        case Token::Type::SLASH:
+        case Token::Type::MODULO:
+        case Token::Type::LSHIFT:
+        case Token::Type::RSHIFT:
+          return std::max(result, Invariance::FALLIBLE);
+        case Token::Type::PLUS:
+        case Token::Type::MINUS:
+        case Token::Type::STAR:
+          return checked ? std::max(result, Invariance::FALLIBLE) : result;
+        default:
+          return result;
+      }
+    }
+
+    if(auto* subscript = dynamic_cast<SubscriptExpression*>(&expr)) {
+      if(loop.writes or loop.calls) return Invariance::VARIANT;
+      return std::max({ invariance(*subscript->array), invariance(*subscript->index), Invariance::FALLIBLE });
+    }
+
+    // * Calls may have effects, array literals and structs are new objects each time
+    return Invariance::VARIANT;
+  }
+
+  auto LoopOptimizer::temporary(Box<Expression> init, Box<TypeExpression> type, bool constant) noexcept -> DeclarationStatement* {
+    const Span span = init->span;
+    auto declaration = std::make_unique<DeclarationStatement>(Symbol::intern("$t{}"f.format(names++)), std::move(init), std::move(type), constant);
+    declaration->span = span;
+    declaration->slot = function->frame_size++;
+
+    DeclarationStatement* result = declaration.get();
+    temporaries.push_back(std::move(declaration));
+    return result;
+  }
+
+  auto LoopOptimizer::typeExpression(TypeId type) const noexcept -> Box<TypeExpression> {
+    u32 dimensions = 0;
+    TypeInfo const* description = &table.info(type);
+    while(description->kind == TypeInfo::Kind::ARRAY) {
+      ++dimensions;
+      description = &table.info(description->element);
+    }
+
+    std::string_view name;
+    Binding binding { Binding::Kind::BUILTIN };
+    switch(description->kind) {
+      case TypeInfo::Kind::INT: name = "int"sv; break;
+      case TypeInfo::Kind::FLOAT: name = "float"sv; break;
+      case TypeInfo::Kind::BOOL: name = "bool"sv; break;
+      case TypeInfo::Kind::CHAR: name = "char"sv; break;
+      case TypeInfo::Kind::STRING: name = "string"sv; break;
+      case TypeInfo::Kind::STRUCT:
+        name = static_cast<StructStatement*>(description->declaration)->name.view();
+        binding = Binding{ Binding::Kind::STRUCT, 0, description->declaration };
+        break;
+      case TypeInfo::Kind::ENUM:
+        name = static_cast<EnumStatement*>(description->declaration)->name.view();
+        binding = Binding{ Binding::Kind::ENUM, 0, description->declaration };
+        break;
+      default:
+        return nullptr;
+    }
+
+    auto result = std::make_unique<TypeExpression>(Symbol::intern(name), dimensions);
+    result->binding = binding;
+    return result;
+  }
+
+  auto LoopOptimizer::reference(DeclarationStatement& temporary, Span span) const noexcept -> Box<Expression> {
+    auto name = std::make_unique<Identifier>(temporary.id);
+    name->binding = Binding{ Binding::Kind::LOCAL, temporary.slot, &temporary };
+    name->span = span;
+    return name;
+  }
+
+}
@@ -0,0 +1,94 @@
+#include "Members.hpp"
+
+namespace fridayc {
+
+  auto Members::add(Symbol name, Box<TypeExpression> type) noexcept -> bool {
+    if(contains(name)) return false;
+
+    members.push_back(Member{ name, std::move(type) });
+
+    if(indexed()) {
+      // * Keep the load factor at or below 1/2
+      if(members.size() * 2 > slots.size()) rehash(slots.size() * 2);
+      else slots[probe(members.back().name)] = members.size() - 1;
+    } else if(members.size() > INDEX_THRESHOLD) {
+      rehash(std::bit_ceil(members.size() * 4));
+    }
+
+    return true;
+  }
+
+  auto Members::indexOf(Symbol name) const noexcept -> std::optional<u32> {
+    if(indexed()) {
+      u32 slot = slots[probe(name)];
+      return slot == EMPTY_SLOT ? std::nullopt : std::optional<u32>{ slot };
+    }
+
+    for(u32 i = 0; i < members.size(); ++i)
+      if(members[i].name == name) return i;
+
+    return std::nullopt;
+  }
+
+  auto Members::find(Symbol name) const noexcept -> TypeExpression* {
+    auto position = indexOf(name);
+    return position ? members[*position].type.get() : nullptr;
+  }
+
+  auto Members::contains(Symbol name) const noexcept -> bool {
+    return indexOf(name).has_value();
+  }
+
+  auto Members::indexed() const noexcept -> bool {
+    return not slots.empty();
+  }
+
+  auto Members::probe(Symbol name) const noexcept -> u64 {
+    const u64 mask = slots.size() - 1;
+    u64 position = (std::hash<Symbol>{}(name) >> 32) & mask;
+
+    while(slots[position] != EMPTY_SLOT and members[slots[position]].name != name)
+      position = (position + 1) & mask;
+
+    return position;
+  }
+
+  auto Members::rehash(u64 capacity) noexcept -> void {
+    slots.assign(capacity, EMPTY_SLOT);
+    for(u32 i = 0; i < members.size(); ++i)
+      slots[probe(members[i].name)] = i;
+  }
+
+  auto Members::begin() noexcept -> iterator {
+    return members.begin();
+  }
+
+  auto Members::begin() const noexcept -> const_iterator {
+    return members.cbegin();
+  }
+
+  auto Members::end() noexcept -> iterator {
+    return members.end();
+  }
+
+  auto Members::end() const noexcept -> const_iterator {
+    return members.cend();
+  }
+
+  auto Members::size() const noexcept -> u64 {
+    return members.size();
+  }
+
+  auto Members::empty() const noexcept -> bool {
+    return members.empty();
+  }
+
+  auto Members::operator[](u64 index) noexcept -> Member& {
+    return members[index];
+  }
+
+  auto Members::operator[](u64 index) const noexcept -> Member const& {
+    return members[index];
+  }
+
+}
@@ -0,0 +1,378 @@
+#include "ModuleFile.hpp"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#define NOGDI
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fridayc::bytecode {
+
+  namespace {
+
+    /// @brief Hash of a text a word at a time, stable across builds unlike std::hash
+    auto hashOf(std::string_view text) noexcept -> u64 {
+      constexpr u64 MULTIPLIER = 0x9E3779B97F4A7C15;
+      u64 hash = 0xCBF29CE484222325 ^ text.size();
+      u64 at = 0;
+      for(; at + 8 <= text.size(); at += 8) {
+        u64 word;
+        std::memcpy(&word, text.data() + at, 8);
+        hash = std::rotl((hash ^ word) * MULTIPLIER, 29);
+      }
+      u64 tail = 0;
+      std::memcpy(&tail, text.data() + at, text.size() - at);
+      hash = std::rotl((hash ^ tail) * MULTIPLIER, 29);
+      return hash ^ hash >> 32;
+    }
+
+    /// @brief Operands of an opcode that name registers of the frame, one bit each for a, b and c
+    auto registersOf(Opcode op) noexcept -> u8 {
+      constexpr u8 A = 1, B = 2, C = 4;
+      switch(op) {
+        case Opcode::JUMP: case Opcode::RETURN_VOID: case Opcode::FALL_OFF:
+          return 0;
+        case Opcode::CONSTANT: case Opcode::CLEAR: case Opcode::NEW: case Opcode::JUMP_IF: case Opcode::JUMP_IF_NOT:
+        case Opcode::CALL: case Opcode::RETURN: case Opcode::RETURN_REF: case Opcode::PRINT:
+          return A;
+        case Opcode::MOVE: case Opcode::MOVE_REF: case Opcode::NEG: case Opcode::BIT_NOT: case Opcode::ADD_IMM:
+        case Opcode::FNEG: case Opcode::NOT: case Opcode::GET_FIELD: case Opcode::GET_FIELD_REF:
+        case Opcode::JEQ: case Opcode::JNE: case Opcode::JLT: case Opcode::JLE: case Opcode::INC_JLT:
+          return A | B;
+        case Opcode::SET_FIELD: case Opcode::SET_FIELD_REF:
+          return A | C;
+        default:
+          return A | B | C;
+      }
+    }
+
+    /// @brief Span pointing at the start of a registered file
+    auto startOf(u32 file) noexcept -> Span {
+      Span span;
+      span.file = file;
+      return span;
+    }
+
+    /// @brief Bytes of a file being written, every section starts 8-byte aligned
+    struct Writer {
+      std::string                     bytes   { };
+      std::vector<std::string_view>   names   { };
+      FlatMap<std::string_view, u32>  symbols { };
+
+      auto symbol(std::string_view text) -> u32 {
+        auto [index, added] = symbols.insert(text, (u32)names.size());
+        if(added) names.push_back(text);
+        return *index;
+      }
+
+      template<class T>
+      auto put(T const& value) -> void {
+        bytes.append(reinterpret_cast<i8 const*>(&value), sizeof(T));
+      }
+
+      template<class T>
+      auto put(std::vector<T> const& values) -> void {
+        bytes.append(reinterpret_cast<i8 const*>(values.data()), values.size() * sizeof(T));
+      }
+
+      auto align() -> u32 {
+        bytes.resize((bytes.size() + 7) & ~(u64)7, '\0');
+        return (u32)bytes.size();
+      }
+    };
+
+  }
+
+  template<class T>
+  auto ModuleFile::read(u64 offset) const noexcept -> T {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+  }
+
+  ModuleFile::ModuleFile(std::string const& path) noexcept {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE) return;
+
+    LARGE_INTEGER length;
+    if(GetFileSizeEx(file, &length) and length.QuadPart > 0) {
+      mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if(mapping) {
+        data = static_cast<u8 const*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        size = data ? (u64)length.QuadPart : 0;
+      }
+    }
+    CloseHandle(file);
+#else
+    const i32 file = ::open(path.c_str(), O_RDONLY);
+    if(file < 0) return;
+
+    struct stat status;
+    if(fstat(file, &status) == 0 and status.st_size > 0) {
+      void* mapped = mmap(nullptr, (u64)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+      if(mapped != MAP_FAILED) {
+        data = static_cast<u8 const*>(mapped);
+        size = (u64)status.st_size;
+      }
+    }
+    ::close(file);
+#endif
+    if(size >= sizeof(Header)) header = read<Header>(0);
+  }
+
+  ModuleFile::ModuleFile(u8 const* image, u64 length) noexcept
+    : data { image }
+    , size { image ? length : 0 }
+    , borrowed { true }
+  {
+    if(size >= sizeof(Header)) header = read<Header>(0);
+  }
+
+  ModuleFile::~ModuleFile() noexcept {
+    if(borrowed) return;
+#if defined(_WIN32)
+    if(data) UnmapViewOfFile(data);
+    if(mapping) CloseHandle(mapping);
+#else
+    if(data) munmap(const_cast<u8*>(data), size);
+#endif
+  }
+
+  auto ModuleFile::write(Module const& module, u32 source, std::string const& path) -> std::vector<Error> {
+    auto [bytes, errors] = encode(module, source);
+    if(not errors.empty()) return std::move(errors);
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(bytes.data(), (std::streamsize)bytes.size());
+    if(not file) errors.emplace_back("Cannot write '{}'"f.format(path), startOf(source));
+    return std::move(errors);
+  }
+
+  auto ModuleFile::encode(Module const& module, u32 source) -> std::pair<std::string, std::vector<Error>> {
+    Writer out;
+    Header header { .magic = MAGIC, .version = VERSION, .hash = hashOf(Sources::text(source)) };
+    header.source = out.symbol(Sources::path(source));
+    header.returns = module.returns_int;
+
+    // * Strings are interned first, the symbol table and its text come right after the header
+    std::vector<u32> strings;
+    for(runtime::Ref const& constant : module.constants)
+      strings.push_back(out.symbol(static_cast<runtime::Text const&>(*constant).value.view()));
+
+    std::vector<u32> shapes;
+    for(runtime::Shape const& shape : module.printer->shapes()) {
+      shapes.push_back((u32)shape.kind);
+      shapes.push_back(out.symbol(shape.name.view()));
+      shapes.push_back((u32)shape.names.size());
+      for(Symbol name : shape.names) shapes.push_back(out.symbol(name.view()));
+      shapes.push_back((u32)shape.parts.size());
+      shapes.insert(shapes.end(), shape.parts.begin(), shape.parts.end());
+    }
+
+    std::vector<Entry> entries;
+    for(Function const& function : module.functions) {
+      Span span = function.span;
+      span.file = 0;
+      entries.push_back({
+        .name = out.symbol(function.name.view()), .span = span,
+        .instructions = (u32)function.code.size(), .constants = (u32)function.constants.size(),
+        .parameters = function.parameters, .constant_base = function.constant_base,
+        .temporaries = function.temporaries, .registers = function.registers, .references = function.references,
+      });
+    }
+
+    out.put(header);
+    header.symbols = { out.align(), (u32)out.names.size() };
+    u64 text = 0;
+    for(std::string_view name : out.names) {
+      out.put(Name{ (u32)text, (u32)name.size() });
+      text += name.size();
+    }
+
+    header.text = { out.align(), (u32)text };
+    for(std::string_view name : out.names) out.bytes += name;
+
+    header.strings = { out.align(), (u32)strings.size() };
+    out.put(strings);
+    header.shapes = { out.align(), (u32)shapes.size() };
+    out.put(shapes);
+    header.formats = { out.align(), (u32)module.shapes.size() };
+    out.put(module.shapes);
+
+    // * The table is written once the offsets of the bodies are known
+    header.functions = { out.align(), (u32)entries.size() };
+    out.bytes.resize(out.bytes.size() + entries.size() * sizeof(Entry));
+
+    for(u64 index = 0; index < module.functions.size(); ++index) {
+      Function const& function = module.functions[index];
+      entries[index].offset = out.align();
+      out.put(function.code);
+      out.put(function.constants);
+
+      std::vector<Span> spans = function.spans;
+      for(Span& span : spans) span.file = 0;
+      out.put(spans);
+    }
+
+    std::memcpy(out.bytes.data(), &header, sizeof(Header));
+    std::memcpy(out.bytes.data() + header.functions.offset, entries.data(), entries.size() * sizeof(Entry));
+
+    std::vector<Error> errors;
+    if(out.bytes.size() > std::numeric_limits<u32>::max())
+      errors.emplace_back("The module is too large for a module file"s, startOf(source));
+    return { std::move(out.bytes), std::move(errors) };
+  }
+
+  auto ModuleFile::load(std::string const& path) -> std::pair<Module, std::vector<Error>> {
+    return open(std::make_shared<ModuleFile>(path), path, false);
+  }
+
+  auto ModuleFile::load(u8 const* image, u64 length, std::string const& name) -> std::pair<Module, std::vector<Error>> {
+    return open(std::make_shared<ModuleFile>(image, length), name, true);
+  }
+
+  auto ModuleFile::open(std::shared_ptr<ModuleFile> file, std::string const& path, bool image) -> std::pair<Module, std::vector<Error>> {
+    Module module;
+    std::vector<Error> errors;
+
+    Header const& header = file->header;
+    if(not file->data) {
+      errors.emplace_back("Cannot open '{}'"f.format(path), startOf(Sources::add(path, ""s)));
+      return { std::move(module), std::move(errors) };
+    }
+
+    const bool sound = header.magic == MAGIC and header.version == VERSION
+      and file->holds(header.symbols, sizeof(Name)) and file->holds(header.text, 1)
+      and file->holds(header.strings, sizeof(u32)) and file->holds(header.shapes, sizeof(u32))
+      and file->holds(header.formats, sizeof(u32)) and file->holds(header.functions, sizeof(Entry))
+      and header.source < header.symbols.count and header.functions.count <= std::numeric_limits<u16>::max() + 1;
+    if(not sound) {
+      errors.emplace_back("'{}' is not a module file of this version"f.format(path), startOf(Sources::add(path, ""s)));
+      return { std::move(module), std::move(errors) };
+    }
+
+    // * The source is read for its hash and for the lines of error messages, without it the module still runs
+    // * An image cannot be rebuilt, so it runs without the lines of a source that changed since
+    const std::string source_path(file->name(header.source));
+    std::ifstream stream(source_path, std::ios::binary | std::ios::ate);
+    bool found = stream.is_open();
+    std::string text(found ? (u64)stream.tellg() : 0, '\0');
+    stream.seekg(0);
+    stream.read(text.data(), (std::streamsize)text.size());
+    if(image and found and hashOf(text) != header.hash) found = false;
+    file->source = Sources::add(source_path, found ? std::move(text) : ""s);
+
+    if(found and hashOf(Sources::text(file->source)) != header.hash) {
+      errors.emplace_back("'{}' is out of date, '{}' changed since it was compiled"f.format(path, source_path), startOf(file->source));
+      return { std::move(module), std::move(errors) };
+    }
+
+    for(u32 k = 0; k < header.strings.count; ++k)
+      module.constants.push_back(std::make_shared<runtime::Text>(runtime::String::intern(file->name(file->read<u32>(header.strings.offset + 4 * k)))));
+
+    // * Shapes are checked word by word, a part or a name out of range marks the file as corrupt
+    std::vector<runtime::Shape> shapes;
+    bool corrupt = false;
+    for(u32 word = 0; word < header.shapes.count and not corrupt; ) {
+      const auto next = [&] { return word < header.shapes.count ? file->read<u32>(header.shapes.offset + 4 * word++) : (corrupt = true, 0u); };
+      runtime::Shape& shape = shapes.emplace_back();
+      shape.kind = (TypeInfo::Kind)next();
+      shape.name = Symbol::intern(file->name(next()));
+      for(u32 names = next(); names-- and not corrupt; ) shape.names.push_back(Symbol::intern(file->name(next())));
+      for(u32 parts = next(); parts-- and not corrupt; ) shape.parts.push_back(next());
+    }
+    for(runtime::Shape const& shape : shapes) {
+      corrupt |= shape.kind > TypeInfo::Kind::ARRAY or (shape.kind == TypeInfo::Kind::ARRAY and shape.parts.size() != 1);
+      for(u32 part : shape.parts) corrupt |= part >= shapes.size();
+    }
+    for(u32 k = 0; k < header.formats.count; ++k) {
+      module.shapes.push_back(file->read<u32>(header.formats.offset + 4 * k));
+      corrupt |= module.shapes.back() >= shapes.size();
+    }
+    if(corrupt) {
+      errors.emplace_back("'{}' is corrupt"f.format(path), startOf(file->source));
+      return { std::move(module), std::move(errors) };
+    }
+
+    module.printer = std::make_unique<runtime::Printer>(std::move(shapes));
+    for(u32 shape : module.shapes) module.formats.push_back(&module.printer->formatOf(shape));
+
+    module.functions.resize(header.functions.count);
+    module.returns_int = header.returns;
+    module.file = std::move(file);
+    return { std::move(module), std::move(errors) };
+  }
+
+  auto ModuleFile::decode(u32 index, Function& into) const -> void {
+    const Entry entry = read<Entry>(header.functions.offset + (u64)index * sizeof(Entry));
+    const u64 length = (u64)entry.instructions * (sizeof(Instruction) + sizeof(Span)) + (u64)entry.constants * sizeof(i64);
+    if(entry.offset % 8 or entry.offset + length > size or entry.instructions == 0 or entry.name >= header.symbols.count
+      or (u64)entry.constant_base + entry.constants > entry.registers)
+      runtime::fault("Function #{} of the module is corrupt"f.format(index), startOf(source));
+
+    Function function;
+    function.name = Symbol::intern(name(entry.name));
+    function.span = entry.span;
+    function.span.file = source;
+    function.parameters = entry.parameters;
+    function.constant_base = entry.constant_base;
+    function.temporaries = entry.temporaries;
+    function.registers = entry.registers;
+    function.references = entry.references;
+
+    u64 at = entry.offset;
+    function.code.resize(entry.instructions);
+    std::memcpy(function.code.data(), data + at, entry.instructions * sizeof(Instruction));
+    at += entry.instructions * sizeof(Instruction);
+    function.constants.resize(entry.constants);
+    std::memcpy(function.constants.data(), data + at, entry.constants * sizeof(i64));
+    at += entry.constants * sizeof(i64);
+    function.spans.resize(entry.instructions);
+    std::memcpy(function.spans.data(), data + at, entry.instructions * sizeof(Span));
+    for(Span& span : function.spans) span.file = source;
+
+    // * Operands that index the module or the code are checked once here, so the machine can trust them
+    for(Instruction const& instruction : function.code) {
+      const u8 operands = instruction.op < Opcode::COUNT ? registersOf(instruction.op) : 0;
+      bool valid = instruction.op < Opcode::COUNT
+        and (not (operands & 1) or instruction.a < entry.registers)
+        and (not (operands & 2) or instruction.b < entry.registers)
+        and (not (operands & 4) or instruction.c < entry.registers)
+        and (not jumps(instruction.op) or instruction.c < entry.instructions)
+        and (instruction.op != Opcode::CALL or instruction.b < header.functions.count)
+        and (instruction.op != Opcode::CONSTANT or instruction.b < header.strings.count)
+        and (instruction.op != Opcode::PRINT or instruction.b < header.formats.count);
+      if(valid and instruction.op == Opcode::CALL) {
+        // * The arguments sit in the registers of the caller from c on, one per parameter of the callee
+        const Entry callee = read<Entry>(header.functions.offset + (u64)instruction.b * sizeof(Entry));
+        valid = (u32)instruction.c + callee.parameters <= entry.registers;
+      }
+      if(not valid) runtime::fault("Function '{}' of the module is corrupt"f.format(function.name), function.span);
+    }
+    switch(function.code.back().op) {
+      case Opcode::JUMP: case Opcode::RETURN: case Opcode::RETURN_REF: case Opcode::RETURN_VOID: case Opcode::FALL_OFF: break;
+      default: runtime::fault("Function '{}' of the module is corrupt"f.format(function.name), function.span);
+    }
+
+    into = std::move(function);
+  }
+
+  auto ModuleFile::holds(Section section, u64 unit) const noexcept -> bool {
+    return section.offset % 8 == 0 and section.offset + section.count * unit <= size;
+  }
+
+  auto ModuleFile::name(u32 symbol) const noexcept -> std::string_view {
+    if(symbol >= header.symbols.count) return ""sv;
+    const Name entry = read<Name>(header.symbols.offset + (u64)symbol * sizeof(Name));
+    if((u64)entry.offset + entry.length > header.text.count) return ""sv;
+    return { reinterpret_cast<i8 const*>(data) + header.text.offset + entry.offset, entry.length };
+  }
+
+}
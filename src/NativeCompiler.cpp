@@ -0,0 +1,716 @@
+#include "NativeCompiler.hpp"
+#include "Assembler.hpp"
+#include "ModuleFile.hpp"
+#include "Process.hpp"
+
+namespace fridayc {
+
+  using bytecode::Opcode;
+  using namespace x86;
+
+  namespace {
+
+    using Context = NativeRuntime::Context;
+    using Fault = NativeRuntime::Fault;
+    using Returns = NativeRuntime::Returns;
+
+    /// @brief Scalars are the first 8 bytes of a cell
+    constexpr i32 CELL = sizeof(runtime::Cell);
+
+    constexpr auto R(u32 reg) noexcept -> i32 {
+      return (i32)reg * CELL;
+    }
+
+    // * rax, rcx, rdx and the xmm registers are scratch for the templates, rbx and r12 hold the frame and the context
+    constexpr std::array<u8, 6> CALLER_SAVED = { RSI, RDI, R8, R9, R10, R11 };
+    constexpr std::array<u8, 3> CALLEE_SAVED = { R13, R14, R15 };
+
+    constexpr auto calleeSaved(u8 reg) noexcept -> bool {
+      return reg != NativeCompiler::IN_MEMORY and reg >= R13;
+    }
+
+    /// @brief Sets of registers, one row of words per instruction
+    class Bits {
+      u32              words { 0 };
+      std::vector<u64> bits  { };
+
+      public:
+      Bits(u32 rows, u32 registers) : words { (registers + 63) / 64 }, bits(rows * words, 0) {}
+
+      auto set(u32 row, u32 reg) noexcept -> void {
+        bits[row * words + reg / 64] |= 1ull << reg % 64;
+      }
+
+      auto test(u32 row, u32 reg) const noexcept -> bool {
+        return bits[row * words + reg / 64] >> reg % 64 & 1;
+      }
+
+      auto row(u32 row) noexcept -> u64* {
+        return bits.data() + row * words;
+      }
+
+      auto width() const noexcept -> u32 {
+        return words;
+      }
+    };
+
+  }
+
+  NativeCompiler::NativeCompiler(bytecode::Module& module, u32 source) noexcept
+    : module { module }
+    , source { source }
+  {}
+
+  auto NativeCompiler::compile() -> std::vector<Error> {
+    std::vector<Error> errors;
+    object = ObjectFile{ };
+    offsets.clear();
+    calls.clear();
+    allocated = spilled = 0;
+
+    if(module.functions.empty()) {
+      errors.emplace_back("No 'main' function to compile"s, Span{ });
+      return errors;
+    }
+
+    try {
+      for(u32 index = 0; index < module.functions.size(); ++index) module.materialize(index);
+    } catch(RuntimeError const& error) {
+      errors.push_back(error);
+      return errors;
+    }
+
+    auto [image, encoded] = bytecode::ModuleFile::encode(module, source);
+    if(not encoded.empty()) return std::move(encoded);
+
+    slow = object.declare("fx_rt_slow"s);
+    fail = object.declare("fx_rt_fail"s);
+    const u32 start = object.declare("fx_rt_start"s);
+
+    // * Functions start 16-byte aligned, padded with int3
+    Assembler assembler;
+    std::vector<u32> sizes;
+    for(u32 index = 0; index < module.functions.size(); ++index) {
+      while(assembler.size() % 16) assembler.byte(0xCC);
+      offsets.push_back(assembler.size());
+      Lowered lowered = lower(index);
+      allocate(module.functions[index], lowered);
+      emit(assembler, index, lowered);
+      sizes.push_back(assembler.size() - offsets.back());
+    }
+    for(Call const& call : calls) assembler.patch(call.position, offsets[call.callee]);
+
+    // * main(argc, argv) tail calls fx_rt_start(image, size, compiled 'main')
+    while(assembler.size() % 16) assembler.byte(0xCC);
+    const u32 entry = assembler.size();
+    assembler.raw({ 0x48, 0x8D, 0x3D });                 // lea rdi, [rip + image]
+    const u32 image_at = assembler.size();
+    assembler.dword(0);
+    assembler.immediate(RSI, image.size());
+    assembler.raw({ 0x48, 0x8D, 0x15 });                 // lea rdx, [rip + main]
+    assembler.dword(0);
+    assembler.patch(assembler.size() - 4, offsets.front());
+    const u32 jump = assembler.jump();
+
+    object.code() = assembler.code();
+    object.data() = std::move(image);
+    for(u32 index = 0; index < module.functions.size(); ++index)
+      object.define("fx::{}"f.format(module.functions[index].name), ObjectFile::Section::TEXT, offsets[index], sizes[index], false, true);
+    const u32 data = object.define("fx_module"s, ObjectFile::Section::RODATA, 0, object.data().size(), false, false);
+    object.define("main"s, ObjectFile::Section::TEXT, entry, assembler.size() - entry, true, true);
+    object.relocate(image_at, data, ObjectFile::Relocation::PC32, -4);
+    object.relocate(jump, start, ObjectFile::Relocation::PLT32, -4);
+    return errors;
+  }
+
+  auto NativeCompiler::write(std::string const& path) const -> std::vector<Error> {
+    return object.write(path);
+  }
+
+  auto NativeCompiler::link(std::string const& object, std::string const& output, std::string const& library) -> std::vector<Error> {
+    std::vector<std::string> arguments = command("CC", "cc"sv);
+    arguments.insert(arguments.end(), { "-o"s, output, object, "-L"s + library, "-lfridaylib"s, "-lfridaystrings"s, "-lstdc++exp"s, "-lstdc++"s, "-lm"s });
+    if(spawn(arguments) != 0) return { Error{ "'{}' failed"f.format(commandLine(arguments)), Span{ } } };
+    return { };
+  }
+
+  auto NativeCompiler::allocatedIntervals() const noexcept -> u64 {
+    return allocated;
+  }
+
+  auto NativeCompiler::spilledIntervals() const noexcept -> u64 {
+    return spilled;
+  }
+
+  auto NativeCompiler::lower(u32 index) const -> Lowered {
+    bytecode::Function const& function = module.functions[index];
+    Lowered lowered;
+    lowered.scalar.assign(function.registers, true);
+
+    for(bytecode::Instruction const& ip : function.code) {
+      Operation& operation = lowered.code.emplace_back();
+      operation.instruction = ip;
+
+      const auto read = [&](u16 reg) { operation.reads[operation.count++] = reg; };
+      const auto reference = [&](u16 reg) { lowered.scalar[reg] = false; };
+
+      switch(ip.op) {
+        case Opcode::MOVE: case Opcode::NEG: case Opcode::BIT_NOT: case Opcode::ADD_IMM: case Opcode::FNEG: case Opcode::NOT:
+          operation.writes = ip.a;
+          read(ip.b);
+          break;
+
+        case Opcode::ADD: case Opcode::SUB: case Opcode::MUL: case Opcode::DIV: case Opcode::MOD:
+        case Opcode::BIT_AND: case Opcode::BIT_OR: case Opcode::SHL: case Opcode::SHR:
+        case Opcode::FADD: case Opcode::FSUB: case Opcode::FMUL: case Opcode::FDIV:
+        case Opcode::EQ: case Opcode::NE: case Opcode::LT: case Opcode::LE:
+        case Opcode::FEQ: case Opcode::FNE: case Opcode::FLT: case Opcode::FLE:
+          operation.writes = ip.a;
+          read(ip.b);
+          read(ip.c);
+          break;
+
+        // * Whether it is left to the runtime depends on what else the register holds, see below
+        case Opcode::CLEAR: operation.writes = ip.a; break;
+
+        case Opcode::MOVE_REF: reference(ip.a); reference(ip.b); operation.calls = true; break;
+        case Opcode::CONSTANT: case Opcode::NEW: reference(ip.a); operation.calls = true; break;
+        case Opcode::REQ: case Opcode::RNE: case Opcode::SEQ: case Opcode::SNE:
+          operation.writes = ip.a;
+          reference(ip.b);
+          reference(ip.c);
+          operation.calls = true;
+          break;
+        case Opcode::CONCAT: reference(ip.a); reference(ip.b); reference(ip.c); operation.calls = true; break;
+
+        case Opcode::GET_FIELD: operation.writes = ip.a; reference(ip.b); operation.calls = true; break;
+        case Opcode::GET_FIELD_REF: reference(ip.a); reference(ip.b); operation.calls = true; break;
+        case Opcode::SET_FIELD: reference(ip.a); read(ip.c); operation.calls = true; break;
+        case Opcode::SET_FIELD_REF: reference(ip.a); reference(ip.c); operation.calls = true; break;
+        case Opcode::GET_ELEM: case Opcode::GET_CHAR: operation.writes = ip.a; reference(ip.b); read(ip.c); operation.calls = true; break;
+        case Opcode::GET_ELEM_REF: reference(ip.a); reference(ip.b); read(ip.c); operation.calls = true; break;
+        case Opcode::SET_ELEM: reference(ip.a); read(ip.b); read(ip.c); operation.calls = true; break;
+        case Opcode::SET_ELEM_REF: reference(ip.a); read(ip.b); reference(ip.c); operation.calls = true; break;
+
+        case Opcode::JUMP: break;
+        case Opcode::JUMP_IF: case Opcode::JUMP_IF_NOT: read(ip.a); break;
+        case Opcode::JEQ: case Opcode::JNE: case Opcode::JLT: case Opcode::JLE: read(ip.a); read(ip.b); break;
+        case Opcode::INC_JLT:
+          operation.writes = ip.a;
+          read(ip.a);
+          read(ip.b);
+          break;
+
+        case Opcode::CALL: {
+          bytecode::Function const& callee = module.functions[ip.b];
+          operation.window = ip.c;
+          operation.arguments = callee.parameters;
+          operation.calls = true;
+          const Returns returns = NativeRuntime::returnsOf(callee);
+          if(returns == Returns::SCALAR) operation.writes = ip.a;
+          else if(returns == Returns::REFERENCE) reference(ip.a);
+          break;
+        }
+
+        case Opcode::RETURN: read(ip.a); operation.calls = function.references; break;
+        case Opcode::RETURN_REF: reference(ip.a); operation.calls = true; break;
+        case Opcode::RETURN_VOID: operation.calls = function.references; break;
+        case Opcode::FALL_OFF: break;
+        case Opcode::PRINT: read(ip.a); operation.calls = true; break;
+
+        default: operation.calls = true; break;
+      }
+    }
+
+    // * Clearing a register that may hold a reference releases it, which is left to the runtime
+    for(Operation& operation : lowered.code)
+      if(operation.instruction.op == Opcode::CLEAR and not lowered.scalar[operation.instruction.a]) {
+        operation.writes.reset();
+        operation.calls = true;
+      }
+    return lowered;
+  }
+
+  auto NativeCompiler::allocate(bytecode::Function const& function, Lowered& lowered) -> void {
+    const u32 size = (u32)lowered.code.size();
+    const u32 registers = function.registers;
+    std::vector<bool> const& scalar = lowered.scalar;
+
+    Bits uses(size, registers), defines(size, registers), in(size, registers), out(size, registers);
+    for(u32 at = 0; at < size; ++at) {
+      Operation const& operation = lowered.code[at];
+      for(u8 k = 0; k < operation.count; ++k)
+        if(scalar[operation.reads[k]]) uses.set(at, operation.reads[k]);
+      for(u32 reg = operation.window; reg < operation.window + operation.arguments; ++reg)
+        if(scalar[reg]) uses.set(at, reg);
+      if(operation.writes and scalar[*operation.writes]) defines.set(at, *operation.writes);
+    }
+
+    // * Backward dataflow to a fixed point, visiting the code in reverse converges in a few passes
+    const auto successors = [&](u32 at) -> std::array<u32, 2> {
+      bytecode::Instruction const& ip = lowered.code[at].instruction;
+      const u32 next = at + 1 < size ? at + 1 : size;
+      switch(ip.op) {
+        case Opcode::JUMP: return { ip.c, size };
+        case Opcode::RETURN: case Opcode::RETURN_REF: case Opcode::RETURN_VOID: case Opcode::FALL_OFF: return { size, size };
+        default: return { next, bytecode::jumps(ip.op) ? ip.c : size };
+      }
+    };
+    const u32 words = in.width();
+    for(bool changed = true; changed; ) {
+      changed = false;
+      for(u32 at = size; at-- > 0; ) {
+        u64* live_out = out.row(at);
+        for(const u32 successor : successors(at))
+          if(successor < size)
+            for(u32 w = 0; w < words; ++w) live_out[w] |= in.row(successor)[w];
+
+        u64* live_in = in.row(at);
+        for(u32 w = 0; w < words; ++w) {
+          const u64 word = uses.row(at)[w] | (live_out[w] & ~defines.row(at)[w]);
+          changed |= word != live_in[w];
+          live_in[w] = word;
+        }
+      }
+    }
+
+    // * One interval per register, from where it is first live or written to where it is last
+    std::vector<Interval> intervals;
+    for(u32 reg = 0; reg < registers; ++reg) {
+      if(not scalar[reg]) continue;
+      Interval interval { .reg = (u16)reg, .start = size };
+      for(u32 at = 0; at < size; ++at) {
+        if(not in.test(at, reg) and not defines.test(at, reg)) continue;
+        interval.start = std::min(interval.start, at);
+        interval.end = at;
+        interval.crosses |= lowered.code[at].calls and out.test(at, reg) and not defines.test(at, reg);
+      }
+      if(interval.start < size) intervals.push_back(interval);
+    }
+
+    // * Linear scan, caller-saved registers first for intervals that never see a call
+    std::ranges::sort(intervals, [](Interval const& left, Interval const& right) { return left.start < right.start; });
+    u32 free = 0;
+    for(const u8 reg : CALLER_SAVED) free |= 1u << reg;
+    for(const u8 reg : CALLEE_SAVED) free |= 1u << reg;
+
+    std::vector<u32> active;
+    for(u32 k = 0; k < intervals.size(); ++k) {
+      Interval& current = intervals[k];
+      std::erase_if(active, [&](u32 j) {
+        if(intervals[j].end >= current.start) return false;
+        free |= 1u << intervals[j].location;
+        return true;
+      });
+
+      const auto take = [&](auto const& pool) {
+        for(const u8 reg : pool)
+          if(free >> reg & 1) {
+            free &= ~(1u << reg);
+            current.location = reg;
+            return true;
+          }
+        return false;
+      };
+      if(current.crosses ? take(CALLEE_SAVED) : take(CALLER_SAVED) or take(CALLEE_SAVED)) {
+        active.push_back(k);
+        continue;
+      }
+
+      // * Out of registers, the active interval that ends last is spilled if it outlives the new one
+      auto victim = active.end();
+      for(auto it = active.begin(); it != active.end(); ++it) {
+        if(current.crosses and not calleeSaved(intervals[*it].location)) continue;
+        if(victim == active.end() or intervals[*it].end > intervals[*victim].end) victim = it;
+      }
+      if(victim != active.end() and intervals[*victim].end > current.end) {
+        current.location = intervals[*victim].location;
+        intervals[*victim].location = IN_MEMORY;
+        *victim = k;
+      }
+    }
+
+    lowered.locations.assign(registers, IN_MEMORY);
+    lowered.entering.assign(registers, false);
+    for(Interval const& interval : intervals) {
+      lowered.locations[interval.reg] = interval.location;
+      lowered.entering[interval.reg] = size and in.test(0, interval.reg);
+      if(interval.location == IN_MEMORY) ++spilled;
+      else ++allocated;
+    }
+    for(const u8 reg : CALLEE_SAVED)
+      if(std::ranges::contains(lowered.locations, reg)) lowered.saved.push_back(reg);
+  }
+
+  auto NativeCompiler::emit(Assembler& assembler, u32 index, Lowered const& lowered) -> void {
+    bytecode::Function const& function = module.functions[index];
+    Assembler& a = assembler;
+
+    // * Native offset of every instruction, and the jumps to patch once they are all placed
+    std::vector<u32> labels(function.code.size(), 0);
+    std::vector<std::pair<u32, u32>> jumps;
+    std::vector<u32> exits;
+
+    /// @brief A jump to the out of line code raising a fault, with the instruction it is raised by
+    struct Stub {
+      u32   position;
+      Fault kind;
+      u32   at;
+    };
+    std::vector<Stub> stubs;
+
+    const auto raise = [&](Condition condition, Fault kind, u32 at) { stubs.push_back({ a.jump(condition), kind, at }); };
+    const auto leave = [&](Condition condition) { exits.push_back(a.jump(condition)); };
+    const auto external = [&](u32 symbol) { object.relocate(a.call(), symbol, ObjectFile::Relocation::PLT32, -4); };
+
+    // * Operands in their machine register, or in their cell
+    const auto place = [&](u16 reg) { return lowered.locations[reg]; };
+    const auto fetch = [&](u8 target, u16 reg) {
+      if(place(reg) == IN_MEMORY) a.load(0x8B, target, RBX, R(reg));
+      else if(place(reg) != target) a.direct(0x8B, target, place(reg));
+    };
+    const auto value = [&](u16 reg, u8 scratch) -> u8 {
+      if(place(reg) != IN_MEMORY) return place(reg);
+      a.load(0x8B, scratch, RBX, R(reg));
+      return scratch;
+    };
+    const auto combine = [&](u16 op, u8 target, u16 reg) {
+      if(place(reg) == IN_MEMORY) a.load(op, target, RBX, R(reg));
+      else a.direct(op, target, place(reg));
+    };
+    const auto assign = [&](u16 reg, u8 from) {
+      if(place(reg) == IN_MEMORY) a.store(RBX, R(reg), from);
+      else if(place(reg) != from) a.direct(0x8B, place(reg), from);
+    };
+    const auto real = [&](u8 xmm, u16 reg) {
+      if(place(reg) == IN_MEMORY) a.sse(0xF2, 0x10, xmm, RBX, R(reg));
+      else a.movq(xmm, place(reg), false);
+    };
+    const auto operate = [&](u8 prefix, u8 op, u8 xmm, u16 reg, u8 temporary) {
+      if(place(reg) == IN_MEMORY) return a.sse(prefix, op, xmm, RBX, R(reg));
+      a.movq(temporary, place(reg), false);
+      a.byte(prefix);
+      a.direct(0x0F00 | op, xmm, temporary, false);
+    };
+    const auto realStore = [&](u16 reg, u8 xmm) {
+      if(place(reg) == IN_MEMORY) a.sse(0xF2, 0x11, xmm, RBX, R(reg));
+      else a.movq(xmm, place(reg), true);
+    };
+    const auto zero = [&](u16 reg) {
+      if(place(reg) != IN_MEMORY) return a.direct(0x85, place(reg), place(reg));
+      a.group(0x83, 7, RBX, R(reg));
+      a.byte(0);
+    };
+    const auto spill = [&](u16 reg) {
+      if(place(reg) != IN_MEMORY) a.store(RBX, R(reg), place(reg));
+    };
+
+    // * The runtime is called as fx_rt_slow(context, base, function, at), reading and writing scalars in their cells
+    const auto callback = [&](u32 at) {
+      Operation const& operation = lowered.code[at];
+      for(u8 k = 0; k < operation.count; ++k) spill(operation.reads[k]);
+      a.raw({ 0x4C, 0x89, 0xE7, 0x48, 0x89, 0xDE });  // mov rdi, r12; mov rsi, rbx
+      a.immediate(RDX, index);
+      a.immediate(RCX, at);
+      external(slow);
+      a.raw({ 0x85, 0xC0 });                          // test eax, eax
+      leave(Condition::NE);
+      if(operation.writes and place(*operation.writes) != IN_MEMORY) a.load(0x8B, place(*operation.writes), RBX, R(*operation.writes));
+    };
+
+    // * Frame pointer, rbx, r12 and the callee-saved registers in use saved, then the slot of the site keeps the stack aligned
+    const i32 pushed = 2 + (i32)lowered.saved.size();
+    const i32 site_slot = -8 * (pushed + 1);
+    a.raw({ 0x55, 0x48, 0x89, 0xE5, 0x53, 0x41, 0x54 });
+    for(const u8 reg : lowered.saved) {
+      a.rex(false, 0, reg);
+      a.byte(0x50 + (reg & 7));
+    }
+    a.raw({ 0x48, 0x83, 0xEC, (u8)(pushed % 2 ? 8 : 16) });
+    a.raw({ 0x48, 0x89, 0xFB, 0x49, 0x89, 0xF4 });  // mov rbx, rdi; mov r12, rsi
+    if(NativeRuntime::falls(function)) {
+      a.load(0x8B, RAX, R12, offsetof(Context, site));
+      a.store(RBP, site_slot, RAX);
+    }
+
+    // * Constants go to their register or their cell, the other registers the code reads first are loaded from theirs
+    const auto constant = [&](u32 reg) { return reg >= function.constant_base and reg < function.constant_base + function.constants.size(); };
+    for(u64 k = 0; k < function.constants.size(); ++k) {
+      const u16 reg = function.constant_base + (u16)k;
+      if(place(reg) == IN_MEMORY) {
+        a.immediate(RAX, (u64)function.constants[k]);
+        a.store(RBX, R(reg), RAX);
+      } else if(lowered.entering[reg]) a.immediate(place(reg), (u64)function.constants[k]);
+    }
+    for(u16 reg = 0; reg < function.registers; ++reg)
+      if(place(reg) != IN_MEMORY and lowered.entering[reg] and not constant(reg)) a.load(0x8B, place(reg), RBX, R(reg));
+
+    for(u32 at = 0; at < function.code.size(); ++at) {
+      bytecode::Instruction const& ip = function.code[at];
+      labels[at] = a.size();
+
+      const auto checked = [&](u16 op) {
+        fetch(RAX, ip.b);
+        combine(op, RAX, ip.c);
+        raise(Condition::O, Fault::INTEGER_OVERFLOW, at);
+        assign(ip.a, RAX);
+      };
+      const auto bitwise = [&](u16 op) {
+        fetch(RAX, ip.b);
+        combine(op, RAX, ip.c);
+        assign(ip.a, RAX);
+      };
+      const auto compare = [&](Condition condition) {
+        combine(0x3B, value(ip.b, RAX), ip.c);
+        a.set(condition);
+        assign(ip.a, RAX);
+      };
+      const auto arithmetic = [&](u8 op) {
+        real(0, ip.b);
+        operate(0xF2, op, 0, ip.c, 1);
+        realStore(ip.a, 0);
+      };
+      // * Unordered floats compare false, so greater is tested with the operands swapped
+      const auto greater = [&](Condition condition) {
+        real(0, ip.c);
+        operate(0x66, 0x2E, 0, ip.b, 1);
+        a.set(condition);
+        assign(ip.a, RAX);
+      };
+      const auto branch = [&](Condition condition) {
+        combine(0x3B, value(ip.a, RAX), ip.b);
+        jumps.emplace_back(a.jump(condition), ip.c);
+      };
+      const auto test = [&](Condition condition) {
+        zero(ip.a);
+        jumps.emplace_back(a.jump(condition), ip.c);
+      };
+      const auto divide = [&](Register result) {
+        fetch(RCX, ip.c);
+        a.raw({ 0x48, 0x85, 0xC9 });                // test rcx, rcx
+        raise(Condition::E, Fault::DIVISION_BY_ZERO, at);
+        fetch(RAX, ip.b);
+        a.raw({ 0x48, 0x83, 0xF9, 0xFF });          // cmp rcx, -1
+        const u32 skip = a.jump(Condition::NE);
+        a.immediate(RDX, (u64)std::numeric_limits<i64>::min());
+        a.raw({ 0x48, 0x39, 0xD0 });                // cmp rax, rdx
+        raise(Condition::E, Fault::INTEGER_OVERFLOW, at);
+        a.patch(skip, a.size());
+        a.raw({ 0x48, 0x99, 0x48, 0xF7, 0xF9 });    // cqo; idiv rcx
+        assign(ip.a, result);
+      };
+      const auto shift = [&] {
+        fetch(RCX, ip.c);
+        a.raw({ 0x48, 0x83, 0xF9, 0x3F });          // cmp rcx, 63
+        raise(Condition::A, Fault::SHIFT_OUT_OF_RANGE, at);
+        fetch(RAX, ip.b);
+      };
+
+      switch(ip.op) {
+        case Opcode::MOVE:
+          if(ip.a != ip.b) assign(ip.a, value(ip.b, place(ip.a) == IN_MEMORY ? RAX : place(ip.a)));
+          break;
+        case Opcode::CLEAR:
+          if(not lowered.scalar[ip.a]) callback(at);
+          else if(place(ip.a) == IN_MEMORY) {
+            a.group(0xC7, 0, RBX, R(ip.a));               // mov qword [rbx + a], 0
+            a.dword(0);
+          } else a.direct(0x33, place(ip.a), place(ip.a), false);
+          break;
+
+        case Opcode::ADD: checked(0x03); break;
+        case Opcode::SUB: checked(0x2B); break;
+        case Opcode::MUL: checked(0x0FAF); break;
+        case Opcode::DIV: divide(RAX); break;
+        case Opcode::MOD: divide(RDX); break;
+        case Opcode::BIT_AND: bitwise(0x23); break;
+        case Opcode::BIT_OR: bitwise(0x0B); break;
+        case Opcode::SHL:
+          // * Shifted back, a value that lost bits to the shift differs from the original
+          shift();
+          a.raw({ 0x48, 0x89, 0xC2, 0x48, 0xD3, 0xE2 });  // mov rdx, rax; shl rdx, cl
+          a.raw({ 0x48, 0xD3, 0xFA, 0x48, 0x39, 0xC2 });  // sar rdx, cl; cmp rdx, rax
+          raise(Condition::NE, Fault::INTEGER_OVERFLOW, at);
+          a.raw({ 0x48, 0xD3, 0xE0 });                    // shl rax, cl
+          assign(ip.a, RAX);
+          break;
+        case Opcode::SHR:
+          shift();
+          a.raw({ 0x48, 0xD3, 0xF8 });                    // sar rax, cl
+          assign(ip.a, RAX);
+          break;
+        case Opcode::NEG:
+          fetch(RAX, ip.b);
+          a.raw({ 0x48, 0xF7, 0xD8 });                    // neg rax
+          raise(Condition::O, Fault::INTEGER_OVERFLOW, at);
+          assign(ip.a, RAX);
+          break;
+        case Opcode::BIT_NOT:
+          fetch(RAX, ip.b);
+          a.raw({ 0x48, 0xF7, 0xD0 });                    // not rax
+          assign(ip.a, RAX);
+          break;
+        case Opcode::ADD_IMM:
+          fetch(RAX, ip.b);
+          a.raw({ 0x48, 0x05 });                          // add rax, imm32
+          a.dword((u32)(i32)(i16)ip.c);
+          raise(Condition::O, Fault::INTEGER_OVERFLOW, at);
+          assign(ip.a, RAX);
+          break;
+
+        case Opcode::FADD: arithmetic(0x58); break;
+        case Opcode::FSUB: arithmetic(0x5C); break;
+        case Opcode::FMUL: arithmetic(0x59); break;
+        case Opcode::FDIV: {
+          // * Only a divisor equal to zero faults, a NaN compares unordered
+          a.raw({ 0x66, 0x0F, 0x57, 0xC9 });              // xorpd xmm1, xmm1
+          operate(0x66, 0x2E, 1, ip.c, 2);
+          const u32 unordered = a.jump(Condition::P);
+          raise(Condition::E, Fault::DIVISION_BY_ZERO, at);
+          a.patch(unordered, a.size());
+          arithmetic(0x5E);
+          break;
+        }
+        case Opcode::FNEG:
+          fetch(RAX, ip.b);
+          a.raw({ 0x48, 0x0F, 0xBA, 0xF8, 0x3F });        // btc rax, 63
+          assign(ip.a, RAX);
+          break;
+
+        case Opcode::EQ: compare(Condition::E); break;
+        case Opcode::NE: compare(Condition::NE); break;
+        case Opcode::LT: compare(Condition::L); break;
+        case Opcode::LE: compare(Condition::LE); break;
+        case Opcode::FEQ:
+        case Opcode::FNE: {
+          // * Equal is ordered and zero, not equal is unordered or nonzero
+          const bool equal = ip.op == Opcode::FEQ;
+          real(0, ip.b);
+          operate(0x66, 0x2E, 0, ip.c, 1);
+          a.raw({ 0x0F, (u8)(0x90 | (equal ? Condition::E : Condition::NE)), 0xC0 });
+          a.raw({ 0x0F, (u8)(0x90 | (equal ? Condition::NP : Condition::P)), 0xC1 });
+          a.raw({ (u8)(equal ? 0x20 : 0x08), 0xC8, 0x0F, 0xB6, 0xC0 });  // and or or al, cl; movzx eax, al
+          assign(ip.a, RAX);
+          break;
+        }
+        case Opcode::FLT: greater(Condition::A); break;
+        case Opcode::FLE: greater(Condition::AE); break;
+
+        case Opcode::NOT:
+          zero(ip.b);
+          a.set(Condition::E);
+          assign(ip.a, RAX);
+          break;
+
+        case Opcode::JUMP: jumps.emplace_back(a.jump(), ip.c); break;
+        case Opcode::JUMP_IF: test(Condition::NE); break;
+        case Opcode::JUMP_IF_NOT: test(Condition::E); break;
+        case Opcode::JEQ: branch(Condition::E); break;
+        case Opcode::JNE: branch(Condition::NE); break;
+        case Opcode::JLT: branch(Condition::L); break;
+        case Opcode::JLE: branch(Condition::LE); break;
+        case Opcode::INC_JLT: {
+          // * Counted in place when the counter has a register
+          const u8 counter = place(ip.a) == IN_MEMORY ? RAX : place(ip.a);
+          fetch(counter, ip.a);
+          a.direct(0x83, 0, counter);                     // add counter, 1
+          a.byte(1);
+          raise(Condition::O, Fault::INTEGER_OVERFLOW, at);
+          assign(ip.a, counter);
+          combine(0x3B, counter, ip.b);
+          jumps.emplace_back(a.jump(Condition::L), ip.c);
+          break;
+        }
+
+        case Opcode::CALL: {
+          bytecode::Function const& callee = module.functions[ip.b];
+
+          // * As deep as the limit allows, and the frame of the callee must fit in the stack
+          a.load(0x8B, RAX, R12, offsetof(Context, depth), false);
+          a.load(0x3B, RAX, R12, offsetof(Context, limit), false);
+          raise(Condition::AE, Fault::STACK_OVERFLOW, at);
+          a.raw({ 0x83, 0xC0, 0x01 });                    // add eax, 1
+          a.store(R12, offsetof(Context, depth), RAX, false);
+          a.load(0x8D, RAX, RBX, R(ip.c + callee.registers));
+          a.load(0x3B, RAX, R12, offsetof(Context, end));
+          raise(Condition::A, Fault::STACK_OVERFLOW, at);
+
+          if(NativeRuntime::falls(callee)) {
+            a.immediate(RAX, (u64)index << 32 | at);
+            a.store(R12, offsetof(Context, site), RAX);
+          }
+
+          // * Arguments are passed in the cells of the window, the callee loads those it keeps in registers
+          for(u32 reg = ip.c; reg < (u32)ip.c + callee.parameters; ++reg) spill((u16)reg);
+          a.load(0x8D, RDI, RBX, R(ip.c));
+          a.raw({ 0x4C, 0x89, 0xE6 });                    // mov rsi, r12
+          calls.push_back({ a.call(), ip.b });
+          a.group(0xFF, 1, R12, offsetof(Context, depth), false);
+          a.raw({ 0x85, 0xC0 });                          // test eax, eax
+          leave(Condition::NE);
+
+          switch(NativeRuntime::returnsOf(callee)) {
+            case Returns::SCALAR:
+              a.load(0x8B, place(ip.a) == IN_MEMORY ? RAX : place(ip.a), R12, offsetof(Context, value));
+              if(place(ip.a) == IN_MEMORY) a.store(RBX, R(ip.a), RAX);
+              break;
+            case Returns::REFERENCE: callback(at); break;
+            case Returns::NOTHING: break;
+          }
+          break;
+        }
+
+        case Opcode::RETURN:
+          a.store(R12, offsetof(Context, value), value(ip.a, RAX));
+          [[fallthrough]];
+        case Opcode::RETURN_VOID:
+          if(function.references) callback(at);
+          a.raw({ 0x31, 0xC0 });                          // xor eax, eax
+          exits.push_back(a.jump());
+          break;
+        case Opcode::RETURN_REF:
+          callback(at);
+          a.raw({ 0x31, 0xC0 });
+          exits.push_back(a.jump());
+          break;
+        case Opcode::FALL_OFF:
+          stubs.push_back({ a.jump(), Fault::ENDED, at });
+          break;
+
+        default:
+          callback(at);
+          break;
+      }
+    }
+
+    // * Status in eax, whatever left the function
+    const u32 epilogue = a.size();
+    a.load(0x8D, RSP, RBP, -8 * pushed);                  // lea rsp, [rbp - saved]
+    for(auto reg = lowered.saved.rbegin(); reg != lowered.saved.rend(); ++reg) {
+      a.rex(false, 0, *reg);
+      a.byte(0x58 + (*reg & 7));
+    }
+    a.raw({ 0x41, 0x5C, 0x5B, 0x5D, 0xC3 });              // pop r12; pop rbx; pop rbp; ret
+
+    // * Faults are raised out of line as fx_rt_fail(context, function, at, kind, site), then the status is 1
+    const u32 fault = a.size();
+    if(not stubs.empty()) {
+      a.raw({ 0x4C, 0x89, 0xE7 });                        // mov rdi, r12
+      a.immediate(RSI, index);
+      a.load(0x8B, R8, RBP, site_slot);
+      external(fail);
+      a.immediate(RAX, 1);
+      exits.push_back(a.jump());
+    }
+    for(Stub const& stub : stubs) {
+      a.patch(stub.position, a.size());
+      a.immediate(RDX, stub.at);
+      a.immediate(RCX, (u32)stub.kind);
+      a.patch(a.jump(), fault);
+    }
+
+    for(auto [position, target] : jumps) a.patch(position, labels[target]);
+    for(const u32 position : exits) a.patch(position, epilogue);
+  }
+
+}
@@ -0,0 +1,180 @@
+#include "NativeRuntime.hpp"
+#include "ModuleFile.hpp"
+
+namespace fridayc {
+
+  using bytecode::Opcode;
+
+  NativeRuntime::NativeRuntime(bytecode::Module& module, std::ostream& out, ExecutionLimits limits) noexcept
+    : module { module }
+    , out { out }
+    , limits { limits }
+  {}
+
+  auto NativeRuntime::run(Entry main) -> std::vector<Error> {
+    errors.clear();
+    exit = 0;
+
+    if(module.functions.empty()) {
+      errors.emplace_back("No 'main' function to run"s, Span{ });
+      return std::move(errors);
+    }
+
+    bytecode::Function const& function = module.functions.front();
+    stack.assign(limits.stack, Cell{ });
+    if(function.registers > stack.size()) {
+      errors.emplace_back("Stack overflow"s, function.span);
+      return std::move(errors);
+    }
+
+    context = Context{ .native = this, .end = stack.data() + stack.size(), .site = NO_SITE, .limit = limits.depth };
+    if(main(stack.data(), &context) == 0 and module.returns_int) exit = context.value;
+
+    // * Objects still referenced from the stack are released now rather than with the runtime
+    stack.clear();
+    returned.reset();
+    return std::move(errors);
+  }
+
+  auto NativeRuntime::status() const noexcept -> i64 {
+    return exit;
+  }
+
+  auto NativeRuntime::slow(Context* context, Cell* base, u32 index, u32 at) noexcept -> u32 {
+    NativeRuntime& native = *context->native;
+    bytecode::Function const& function = native.module.functions[index];
+    bytecode::Instruction const& ip = function.code[at];
+    const Span span = function.spans[at];
+
+#define R(operand) base[ip.operand]
+    try {
+      switch(ip.op) {
+        case Opcode::MOVE_REF: R(a).object = R(b).object; break;
+        case Opcode::CONSTANT: R(a).object = native.module.constants[ip.b]; break;
+        case Opcode::CLEAR: R(a).integer = 0; R(a).object.reset(); break;
+
+        case Opcode::REQ: R(a).integer = R(b).object == R(c).object; break;
+        case Opcode::RNE: R(a).integer = R(b).object != R(c).object; break;
+        case Opcode::SEQ: R(a).integer = runtime::equal(R(b).object, R(c).object); break;
+        case Opcode::SNE: R(a).integer = not runtime::equal(R(b).object, R(c).object); break;
+        case Opcode::CONCAT: R(a).object = runtime::concatenate(R(b).object, R(c).object, span); break;
+
+        case Opcode::NEW: R(a).object = std::make_shared<runtime::Cells>(ip.b); break;
+        case Opcode::GET_FIELD: R(a).integer = runtime::cells(R(b).object, span)[ip.c].integer; break;
+        case Opcode::GET_FIELD_REF: {
+          runtime::Ref value = runtime::cells(R(b).object, span)[ip.c].object;
+          R(a).object = std::move(value);
+          break;
+        }
+        case Opcode::SET_FIELD: runtime::cells(R(a).object, span)[ip.b].integer = R(c).integer; break;
+        case Opcode::SET_FIELD_REF: runtime::cells(R(a).object, span)[ip.b].object = R(c).object; break;
+
+        case Opcode::GET_ELEM: R(a).integer = runtime::element(R(b).object, R(c).integer, span).integer; break;
+        case Opcode::GET_ELEM_REF: {
+          runtime::Ref value = runtime::element(R(b).object, R(c).integer, span).object;
+          R(a).object = std::move(value);
+          break;
+        }
+        case Opcode::SET_ELEM: runtime::element(R(a).object, R(b).integer, span).integer = R(c).integer; break;
+        case Opcode::SET_ELEM_REF: runtime::element(R(a).object, R(b).integer, span).object = R(c).object; break;
+        case Opcode::GET_CHAR: R(a).integer = runtime::character(R(b).object, R(c).integer, span); break;
+
+        // * The reference a call returned, taken once the callee released its registers
+        case Opcode::CALL: R(a).object = std::move(native.returned); break;
+
+        case Opcode::RETURN_REF:
+          native.returned = std::move(R(a).object);
+          [[fallthrough]];
+        case Opcode::RETURN:
+        case Opcode::RETURN_VOID:
+          if(function.references)
+            for(Cell* cell = base; cell != base + function.registers; ++cell) cell->object.reset();
+          break;
+
+        case Opcode::PRINT:
+          native.buffer.clear();
+          (*native.module.formats[ip.b])(native.buffer, R(a), 0);
+          native.buffer += '\n';
+          native.out.write(native.buffer.data(), (std::streamsize)native.buffer.size());
+          break;
+
+        default: break;
+      }
+    } catch(RuntimeError const& error) {
+      native.errors.push_back(error);
+      return 1;
+    } catch(std::bad_alloc const&) {
+      native.errors.emplace_back("Out of memory"s, span);
+      return 1;
+    }
+#undef R
+    return 0;
+  }
+
+  auto NativeRuntime::fail(Context* context, u32 index, u32 at, u32 kind, u64 site) noexcept -> void {
+    NativeRuntime& native = *context->native;
+    bytecode::Function const& function = native.module.functions[index];
+    const Span span = function.spans[at];
+
+    switch((Fault)kind) {
+      case Fault::INTEGER_OVERFLOW: native.errors.emplace_back("Integer overflow"s, span); break;
+      case Fault::DIVISION_BY_ZERO: native.errors.emplace_back("Division by 0"s, span); break;
+      case Fault::SHIFT_OUT_OF_RANGE: native.errors.emplace_back("Shift count out of range"s, span); break;
+      case Fault::STACK_OVERFLOW: native.errors.emplace_back("Stack overflow"s, span); break;
+      case Fault::ENDED:
+        // * At the call that reached the end, as the VirtualMachine reports it
+        if(site == NO_SITE) native.errors.emplace_back("'main' ended without returning a value"s, function.span);
+        else native.errors.emplace_back("'{}' ended without returning a value"f.format(function.name), native.module.functions[site >> 32].spans[(u32)site]);
+        break;
+    }
+  }
+
+  auto NativeRuntime::returnsOf(bytecode::Function const& function) noexcept -> Returns {
+    for(bytecode::Instruction const& instruction : function.code) {
+      if(instruction.op == Opcode::RETURN) return Returns::SCALAR;
+      if(instruction.op == Opcode::RETURN_REF) return Returns::REFERENCE;
+    }
+    return Returns::NOTHING;
+  }
+
+  auto NativeRuntime::falls(bytecode::Function const& function) noexcept -> bool {
+    return std::ranges::any_of(function.code, [](bytecode::Instruction const& instruction) { return instruction.op == Opcode::FALL_OFF; });
+  }
+
+}
+
+using namespace fridayc;
+
+extern "C" {
+
+  auto fx_rt_start(u8 const* image, u64 size, NativeRuntime::Entry main) -> i32 {
+    auto [module, errors] = bytecode::ModuleFile::load(image, size, "<native image>"s);
+
+    // * The runtime reads the bytecode of the instructions it runs, so every function is decoded up front
+    try {
+      for(u32 index = 0; index < module.functions.size() and errors.empty(); ++index) module.materialize(index);
+    } catch(RuntimeError const& error) {
+      errors.push_back(error);
+    }
+
+    i64 status = 0;
+    if(errors.empty()) {
+      NativeRuntime native(module, std::cout);
+      errors = native.run(main);
+      status = native.status();
+    }
+    std::cout.flush();
+
+    std::ranges::for_each(errors, report);
+    return errors.empty() ? (i32)status : 1;
+  }
+
+  auto fx_rt_slow(NativeRuntime::Context* context, runtime::Cell* base, u32 function, u32 at) -> u32 {
+    return NativeRuntime::slow(context, base, function, at);
+  }
+
+  auto fx_rt_fail(NativeRuntime::Context* context, u32 function, u32 at, u32 kind, u64 site) -> void {
+    NativeRuntime::fail(context, function, at, kind, site);
+  }
+
+}
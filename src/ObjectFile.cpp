@@ -0,0 +1,170 @@
+#include "ObjectFile.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    struct FileHeader {
+      u8  ident[16]   { 0x7F, 'E', 'L', 'F', 2, 1, 1 }; // * 64-bit, little-endian, version 1
+      u16 type        { 1 };                            // * Relocatable
+      u16 machine     { 62 };                           // * x86-64
+      u32 version     { 1 };
+      u64 entry       { 0 };
+      u64 phoff       { 0 };
+      u64 shoff       { 0 };
+      u32 flags       { 0 };
+      u16 ehsize      { sizeof(FileHeader) };
+      u16 phentsize   { 0 };
+      u16 phnum       { 0 };
+      u16 shentsize   { 64 };
+      u16 shnum       { 0 };
+      u16 shstrndx    { 0 };
+    };
+
+    struct SectionHeader {
+      u32 name      { 0 };
+      u32 type      { 0 };
+      u64 flags     { 0 };
+      u64 addr      { 0 };
+      u64 offset    { 0 };
+      u64 size      { 0 };
+      u32 link      { 0 };
+      u32 info      { 0 };
+      u64 addralign { 0 };
+      u64 entsize   { 0 };
+    };
+
+    struct SymbolEntry {
+      u32 name  { 0 };
+      u8  info  { 0 };
+      u8  other { 0 };
+      u16 shndx { 0 };
+      u64 value { 0 };
+      u64 size  { 0 };
+    };
+
+    struct RelocationEntry {
+      u64 offset { 0 };
+      u64 info   { 0 };
+      i64 addend { 0 };
+    };
+
+    static_assert(sizeof(FileHeader) == 64 and sizeof(SectionHeader) == 64);
+    static_assert(sizeof(SymbolEntry) == 24 and sizeof(RelocationEntry) == 24);
+
+    enum : u32 { SHT_PROGBITS = 1, SHT_SYMTAB = 2, SHT_STRTAB = 3, SHT_RELA = 4 };
+    enum : u64 { SHF_ALLOC = 0x2, SHF_EXECINSTR = 0x4, SHF_INFO_LINK = 0x40 };
+    enum : u8 { STB_LOCAL = 0, STB_GLOBAL = 1, STT_NOTYPE = 0, STT_OBJECT = 1, STT_FUNC = 2 };
+
+    /// @brief Sections in the order of their headers, the first two are the ones of ObjectFile::Section
+    enum : u16 { TEXT = 1, RODATA, SYMTAB, STRTAB, RELA_TEXT, NOTE_STACK, SHSTRTAB, SECTIONS };
+
+    template<class T>
+    auto put(std::string& bytes, T const& value) -> void {
+      bytes.append(reinterpret_cast<i8 const*>(&value), sizeof(T));
+    }
+
+    auto align(std::string& bytes, u64 alignment) -> u64 {
+      bytes.resize((bytes.size() + alignment - 1) / alignment * alignment, '\0');
+      return bytes.size();
+    }
+
+    /// @brief Appends a name to a string table, returning its offset
+    auto intern(std::string& table, std::string_view name) -> u32 {
+      const u32 offset = (u32)table.size();
+      table += name;
+      table += '\0';
+      return offset;
+    }
+
+  }
+
+  auto ObjectFile::code() noexcept -> std::vector<u8>& {
+    return text;
+  }
+
+  auto ObjectFile::data() noexcept -> std::string& {
+    return rodata;
+  }
+
+  auto ObjectFile::define(std::string name, Section section, u64 offset, u64 size, bool global, bool function) -> u32 {
+    symbols.push_back({ std::move(name), section, offset, size, global, function });
+    return (u32)symbols.size() - 1;
+  }
+
+  auto ObjectFile::declare(std::string name) -> u32 {
+    symbols.push_back({ .name = std::move(name), .global = true });
+    return (u32)symbols.size() - 1;
+  }
+
+  auto ObjectFile::relocate(u64 offset, u32 symbol, Relocation type, i64 addend) -> void {
+    fixups.push_back({ offset, symbol, type, addend });
+  }
+
+  auto ObjectFile::encode() const -> std::string {
+    // * Local symbols come first in the table, sh_info of .symtab is the first global one
+    std::vector<u32> order;
+    for(u32 k = 0; k < symbols.size(); ++k) if(not symbols[k].global) order.push_back(k);
+    const u32 first_global = (u32)order.size() + 1;
+    for(u32 k = 0; k < symbols.size(); ++k) if(symbols[k].global) order.push_back(k);
+
+    std::vector<u32> index(symbols.size());
+    std::string strtab(1, '\0');
+    std::vector<SymbolEntry> entries(1);
+    for(const u32 k : order) {
+      Definition const& symbol = symbols[k];
+      index[k] = (u32)entries.size();
+      const u8 type = symbol.section == Section::UNDEFINED ? STT_NOTYPE : symbol.function ? STT_FUNC : STT_OBJECT;
+      entries.push_back({
+        .name = intern(strtab, symbol.name), .info = (u8)((symbol.global ? STB_GLOBAL : STB_LOCAL) << 4 | type),
+        .shndx = (u16)symbol.section, .value = symbol.offset, .size = symbol.size,
+      });
+    }
+
+    std::string shstrtab(1, '\0');
+    std::array<SectionHeader, SECTIONS> sections { };
+    sections[TEXT] = { .name = intern(shstrtab, ".text"sv), .type = SHT_PROGBITS, .flags = SHF_ALLOC | SHF_EXECINSTR, .addralign = 16 };
+    sections[RODATA] = { .name = intern(shstrtab, ".rodata"sv), .type = SHT_PROGBITS, .flags = SHF_ALLOC, .addralign = 16 };
+    sections[SYMTAB] = { .name = intern(shstrtab, ".symtab"sv), .type = SHT_SYMTAB, .link = STRTAB, .info = first_global, .addralign = 8, .entsize = sizeof(SymbolEntry) };
+    sections[STRTAB] = { .name = intern(shstrtab, ".strtab"sv), .type = SHT_STRTAB, .addralign = 1 };
+    sections[RELA_TEXT] = { .name = intern(shstrtab, ".rela.text"sv), .type = SHT_RELA, .flags = SHF_INFO_LINK, .link = SYMTAB, .info = TEXT, .addralign = 8, .entsize = sizeof(RelocationEntry) };
+    sections[NOTE_STACK] = { .name = intern(shstrtab, ".note.GNU-stack"sv), .type = SHT_PROGBITS, .addralign = 1 };
+    sections[SHSTRTAB] = { .name = intern(shstrtab, ".shstrtab"sv), .type = SHT_STRTAB, .addralign = 1 };
+
+    // * Every section is appended at its alignment, and records where it landed
+    std::string bytes(sizeof(FileHeader), '\0');
+    const auto place = [&](u16 section, auto&& append) {
+      sections[section].offset = align(bytes, std::max<u64>(sections[section].addralign, 1));
+      append();
+      sections[section].size = bytes.size() - sections[section].offset;
+    };
+
+    place(TEXT, [&] { bytes.append(reinterpret_cast<i8 const*>(text.data()), text.size()); });
+    place(RODATA, [&] { bytes += rodata; });
+    place(SYMTAB, [&] { for(SymbolEntry const& entry : entries) put(bytes, entry); });
+    place(STRTAB, [&] { bytes += strtab; });
+    place(RELA_TEXT, [&] {
+      for(Fixup const& fixup : fixups)
+        put(bytes, RelocationEntry{ fixup.offset, (u64)index[fixup.symbol] << 32 | (u32)fixup.type, fixup.addend });
+    });
+    sections[NOTE_STACK].offset = bytes.size();
+    place(SHSTRTAB, [&] { bytes += shstrtab; });
+
+    FileHeader header;
+    header.shoff = align(bytes, 8);
+    header.shnum = SECTIONS;
+    header.shstrndx = SHSTRTAB;
+    for(SectionHeader const& section : sections) put(bytes, section);
+    std::memcpy(bytes.data(), &header, sizeof(FileHeader));
+    return bytes;
+  }
+
+  auto ObjectFile::write(std::string const& path) const -> std::vector<Error> {
+    const std::string bytes = encode();
+    std::ofstream file(path, std::ios::binary);
+    file.write(bytes.data(), (std::streamsize)bytes.size());
+    if(not file) return { Error{ "Cannot write '{}'"f.format(path), Span{ } } };
+    return { };
+  }
+
+}
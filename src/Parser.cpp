@@ -19,6 +19,7 @@ namespace fridayc {
     { Token::Type::NOT            ,  Parser::parsePrefix            },
     { Token::Type::BIT_NOT        ,  Parser::parsePrefix            },
     { Token::Type::LPAREN         ,  Parser::parseGroupedExpression },
+    { Token::Type::LSQUARE        ,  Parser::parseArrayLiteral      },
   };
   
   const std::map<Token::Type, Parser::InfixParser> Parser::infixParsers {
@@ -92,9 +93,11 @@ namespace fridayc {
     
   };
   
-  Parser::Parser(std::vector<Token> tokens) noexcept 
+  Parser::Parser(std::vector<Token> tokens, u32 file) noexcept 
     : tokens { std::move(tokens) }
+    , source { Sources::text(file) }
     , pos { 0 }
+    , file { file }
   {}
 
   auto Parser::getPrefixParser(Token::Type type) noexcept -> PrefixParser {
@@ -111,7 +114,7 @@ namespace fridayc {
 
   auto Parser::errorAt(Token const& token, std::string error) noexcept -> void {
     if(panic_mode) return;
-    error_queue.emplace_back(error, token.getRow(), token.getColumn(), token.getLiteral().length());
+    error_queue.emplace_back(error, spanOf(token));
     panic_mode = true;
   }
 
@@ -129,6 +132,29 @@ namespace fridayc {
     return Tokens::END;
   }
 
+  auto Parser::spanOf(Token const& token) const noexcept -> Span {
+    std::string_view literal = token.getLiteral();
+    const i8* begin = source.data();
+    const i8* end = source.data() + source.length();
+
+    Span span;
+    span.file = file;
+    if(literal.data() >= begin and literal.data() + literal.length() <= end) {
+      span.offset = literal.data() - begin;
+      span.length = Span::saturate(literal.length());
+    } else {
+      // * Tokens that are not part of the source (EOF) point past its end
+      span.offset = source.length();
+      span.length = 1;
+    }
+    return span;
+  }
+
+  auto Parser::spanFrom(Token const& start) const noexcept -> Span {
+    Span first = spanOf(start);
+    return pos > 0 ? Span::join(first, spanOf(tokens[pos - 1])) : first;
+  }
+
   auto Parser::good() const noexcept -> bool {
     return not panic_mode;
   }
@@ -2,8 +2,24 @@
 
 namespace fridayc {
 
+  namespace {
+
+    /// @brief Character denoted by an escape sequence, given the character after the backslash
+    constexpr auto unescape(i8 c) noexcept -> i8 {
+      switch(c) {
+        case 'n': return '\n';
+        case 't': return '\t';
+        case 'r': return '\r';
+        case '0': return '\0';
+        default: return c;
+      }
+    }
+
+  }
+
   auto Parser::parseExpression(Precedence precedence) noexcept -> Box<Expression> {
     Token token = consume();
+    const Token start = token;
     
     PrefixParser prefix_parser = Parser::getPrefixParser(token.getType());
     if(not prefix_parser) {
@@ -13,6 +29,7 @@ namespace fridayc {
 
     Box<Expression> left = std::invoke(prefix_parser, this, std::move(token));
     if(not left) return nullptr;
+    left->span = spanFrom(start);
 
     while(precedence < Parser::getPrecedence(peek().getType())) {
       token = consume();
@@ -25,6 +42,7 @@ namespace fridayc {
   
       left = std::invoke(infix_parser, this, std::move(left), std::move(token));
       if(not left) return nullptr;
+      left->span = spanFrom(start);
 
     }
 
@@ -55,7 +73,7 @@ namespace fridayc {
   }
   
   auto Parser::parseIdentifier(Token token) noexcept -> Box<Expression> {
-    return std::make_unique<Identifier>(std::string{ token.getLiteral() });
+    return std::make_unique<Identifier>(Symbol::intern(token.getLiteral()));
   }
 
   auto Parser::parseObjectLiteral(Token token) noexcept -> Box<Expression> {
@@ -67,7 +85,26 @@ namespace fridayc {
   }
 
   auto Parser::parseStringLiteral(Token token) noexcept -> Box<Expression> {    
-    return std::make_unique<StringLiteral>(std::string{ token.getLiteral() }); 
+    std::string_view literal = token.getLiteral();
+    literal.remove_prefix(1); // '"'
+    if(literal.ends_with('"')) literal.remove_suffix(1);
+
+    // * Literals without escapes stay views into the source text
+    if(not literal.contains('\\'))
+      return std::make_unique<StringLiteral>(literal);
+
+    std::string value;
+    value.reserve(literal.length());
+    for(u64 i = 0; i < literal.length(); ++i) {
+      if(literal[i] != '\\' or i + 1 == literal.length()) {
+        value += literal[i];
+        continue;
+      }
+
+      value += unescape(literal[++i]);
+    }
+
+    return std::make_unique<StringLiteral>(std::move(value)); 
   }
 
   auto Parser::parseFloatLiteral(Token token) noexcept -> Box<Expression> {
@@ -79,11 +116,23 @@ namespace fridayc {
   }
 
   auto Parser::parseCharLiteral(Token token) noexcept -> Box<Expression> {
-    return std::make_unique<CharLiteral>(Character::parse(token.getLiteral()));
+    std::string_view literal = token.getLiteral();
+    literal.remove_prefix(1); // '\''
+    if(literal.ends_with('\'')) literal.remove_suffix(1);
+
+    if(literal.empty()) {
+      errorAt(token, "Empty character literal"s);
+      return nullptr;
+    }
+
+    if(literal.starts_with('\\') and literal.length() > 1)
+      return std::make_unique<CharLiteral>(unescape(literal[1]));
+    
+    return std::make_unique<CharLiteral>(Character::parse(literal));
   }
 
   auto Parser::parseType(Token token) noexcept -> Box<TypeExpression> {
-    std::string name{ token.getLiteral() };
+    Symbol name = Symbol::intern(token.getLiteral());
     u32 dims = 0;
 
     while(peek().getType() == Token::Type::LSQUARE) {
@@ -97,7 +146,9 @@ namespace fridayc {
       ++dims;
     }
 
-    return std::make_unique<TypeExpression>(std::move(name), dims);
+    auto type = std::make_unique<TypeExpression>(name, dims);
+    type->span = spanFrom(token);
+    return std::move(type);
   }
 
   auto Parser::parseGroupedExpression(Token) noexcept -> Box<Expression> {
@@ -26,7 +26,10 @@ namespace fridayc {
 
   auto Parser::parseTopLevelStatement() noexcept -> Box<Statement> {
     if(auto it = topLevelStmtParsers.find(peek().getType()); it != topLevelStmtParsers.end()) {
-      return std::invoke(topLevelStmtParsers.at(peek().getType()), this);
+      const Token start = peek();
+      auto stmt = std::invoke(it->second, this);
+      if(stmt) stmt->span = spanFrom(start);
+      return std::move(stmt);
     } else {
       expect(
         Token::Type::FN,
@@ -38,9 +41,12 @@ namespace fridayc {
   }
 
   auto Parser::parseStatement() noexcept -> Box<Statement> {
-    return stmtParsers.contains(peek().getType()) ? 
+    const Token start = peek();
+    auto stmt = stmtParsers.contains(peek().getType()) ? 
       std::invoke(stmtParsers.at(peek().getType()), this) 
         : parseExpressionStatement();
+    if(stmt) stmt->span = spanFrom(start);
+    return std::move(stmt);
   }
 
   auto Parser::parsePrintStatement() noexcept -> Box<Statement> {
@@ -65,7 +71,7 @@ namespace fridayc {
     );
     if(not good()) return nullptr;
 
-    std::string id { consume().getLiteral() };
+    Symbol id = Symbol::intern(consume().getLiteral());
 
     expect(
       Token::Type::COLUMN,
@@ -103,7 +109,7 @@ namespace fridayc {
     consume();
 
     return std::make_unique<DeclarationStatement>(
-      std::move(id), 
+      id, 
       std::move(expr), 
       std::move(type), 
       constant
@@ -119,13 +125,13 @@ namespace fridayc {
     );
     if(not good()) return nullptr;
 
-    std::string name { consume().getLiteral() };
+    Symbol name = Symbol::intern(consume().getLiteral());
 
     expect(Token::Type::LPAREN, "Expected '(' after function name, got '{}'"f.format(peek().getLiteral()));
     if(not good()) return nullptr;
     consume();
 
-    auto function = std::make_unique<FunctionStatement>(std::move(name));
+    auto function = std::make_unique<FunctionStatement>(name);
 
     if(peek().getType() == Token::Type::IDENTIFIER) {
       do {
@@ -135,7 +141,7 @@ namespace fridayc {
         );
         if(not good()) return nullptr;
 
-        std::string id { consume().getLiteral() };
+        Token id = consume();
 
         expect(
           Token::Type::COLUMN, 
@@ -154,7 +160,10 @@ namespace fridayc {
         auto type = parseType(consume());
         if(not good()) return nullptr;
 
-        function->args[id] = std::move(type);
+        if(not function->args.add(Symbol::intern(id.getLiteral()), std::move(type))) {
+          errorAt(id, "Duplicate function parameter '{}'"f.format(id.getLiteral()));
+          return nullptr;
+        }
 
       } while(peek().getType() == Token::Type::COMMA and consume().getType() == Token::Type::COMMA);
     }
@@ -196,6 +205,7 @@ namespace fridayc {
 
       auto block = std::make_unique<BlockStatement>();
       auto return_stmt = std::make_unique<ReturnStatement>(std::move(expr));
+      block->span = return_stmt->span = return_stmt->expr->span;
       block->add(std::move(return_stmt));
       function->block = std::move(block);
     } else {
@@ -216,7 +226,7 @@ namespace fridayc {
     expect(Token::Type::IDENTIFIER, "Expected an identifier after keyword 'enum', got '{}'"f.format(peek().getLiteral()));
     if(not good()) return nullptr;
     
-    auto _enum = std::make_unique<EnumStatement>(std::string{ consume().getLiteral()} );
+    auto _enum = std::make_unique<EnumStatement>(Symbol::intern(consume().getLiteral()));
     
     expect(Token::Type::LBRACE, "Expected '{{' after enum name, got '{}'"f.format(peek().getLiteral()));
     if(not good()) return nullptr;
@@ -224,7 +234,7 @@ namespace fridayc {
 
     if(peek().getType() == Token::Type::IDENTIFIER) {
       do {
-        _enum->add(std::string{ consume().getLiteral() });
+        _enum->add(Symbol::intern(consume().getLiteral()));
       } while(peek().getType() == Token::Type::COMMA and consume().getType() == Token::Type::COMMA);
     }
 
@@ -241,7 +251,7 @@ namespace fridayc {
     expect(Token::Type::IDENTIFIER, "Expected an identifier after keyword 'struct', got '{}'"f.format(peek().getLiteral()));
     if(not good()) return nullptr;
     
-    auto _struct = std::make_unique<StructStatement>(std::string{ consume().getLiteral() });
+    auto _struct = std::make_unique<StructStatement>(Symbol::intern(consume().getLiteral()));
     
     expect(Token::Type::LBRACE, "Expected '{{' after struct name, got '{}'"f.format(peek().getLiteral()));
     if(not good()) return nullptr;
@@ -254,7 +264,7 @@ namespace fridayc {
       );
       if(not good()) return nullptr;
 
-      std::string id { consume().getLiteral() };
+      Token id = consume();
 
       expect(
         Token::Type::COLUMN, 
@@ -279,7 +289,10 @@ namespace fridayc {
       if(not good()) return nullptr;
       consume();
 
-      _struct->fields[id] = std::move(type);
+      if(not _struct->fields.add(Symbol::intern(id.getLiteral()), std::move(type))) {
+        errorAt(id, "Duplicate struct field '{}'"f.format(id.getLiteral()));
+        return nullptr;
+      }
     }
 
     expect(Token::Type::RBRACE, "Expected '}}' at the end of a struct, got '{}'"f.format(peek().getLiteral()));
@@ -295,14 +308,14 @@ namespace fridayc {
     expect(Token::Type::IDENTIFIER, "Expected an identifier after keyword 'namespace', got '{}'"f.format(peek().getLiteral()));
     if(not good()) return nullptr;
 
-    std::string id { consume().getLiteral() };
+    Symbol id = Symbol::intern(consume().getLiteral());
     
     expect(Token::Type::SEMICOL, "Expected ';' after a namespace statement, got '{}'"f.format(peek().getLiteral()));
     if(not good()) return nullptr;
 
     consume();
     
-    return std::make_unique<NamespaceStatement>(std::move(id));
+    return std::make_unique<NamespaceStatement>(id);
   }
 
   auto Parser::parseUsingStatement() noexcept -> Box<Statement> {
@@ -311,14 +324,14 @@ namespace fridayc {
     expect(Token::Type::IDENTIFIER, "Expected an identifier after keyword 'using', got '{}'"f.format(peek().getLiteral()));
     if(not good()) return nullptr;
 
-    std::string id { consume().getLiteral() };
+    Symbol id = Symbol::intern(consume().getLiteral());
     
     expect(Token::Type::SEMICOL, "Expected ';' after a using statement, got '{}'"f.format(peek().getLiteral()));
     if(not good()) return nullptr;
 
     consume();
     
-    return std::make_unique<UsingStatement>(std::move(id));
+    return std::make_unique<UsingStatement>(id);
 
   }
 
@@ -326,7 +339,7 @@ namespace fridayc {
     
     expect(Token::Type::LBRACE, "Expected '{{' to open a scope, got '{}'"f.format(peek().getLiteral()));
     if(not good()) return nullptr;
-    consume();
+    const Token start = consume();
     
     auto block = std::make_unique<BlockStatement>();
 
@@ -341,11 +354,12 @@ namespace fridayc {
     if(not good()) return nullptr;
     consume();
 
+    block->span = spanFrom(start);
     return std::move(block);
   }
 
   auto Parser::parseIfStatement() noexcept -> Box<Statement> {
-    consume(); // if or elif
+    const Token start = consume(); // if or elif
 
     auto stmt = std::make_unique<IfStatement>();
     stmt->condition = parseExpression();
@@ -363,6 +377,7 @@ namespace fridayc {
       if(not good()) return nullptr;
   }
 
+    stmt->span = spanFrom(start);
     return std::move(stmt);
   }
 
@@ -0,0 +1,89 @@
+#include "Peephole.hpp"
+
+namespace fridayc {
+
+  using bytecode::Opcode;
+  using bytecode::Instruction;
+
+  auto Peephole::optimize(bytecode::Module& module) -> void {
+    for(bytecode::Function& function : module.functions) optimize(function);
+  }
+
+  auto Peephole::superinstructions() const noexcept -> u64 {
+    return moves + immediates + steps;
+  }
+
+  auto Peephole::removedInstructions() const noexcept -> u64 {
+    return moves + steps;
+  }
+
+  auto Peephole::optimize(bytecode::Function& function) -> void {
+    std::vector<Instruction> const& code = function.code;
+    std::vector<bool> targets(code.size() + 1, false);
+    for(Instruction const& instruction : code)
+      if(bytecode::jumps(instruction.op)) targets[instruction.c] = true;
+
+    std::vector<Instruction> rewritten;
+    std::vector<Span> spans;
+    std::vector<u32> moved(code.size() + 1);
+    rewritten.reserve(code.size());
+    spans.reserve(code.size());
+
+    for(u64 at = 0; at < code.size(); ++at) {
+      Instruction instruction = code[at];
+      immediate(function, instruction);
+      moved[at] = (u32)rewritten.size();
+
+      if(not targets[at] and not rewritten.empty()) {
+        Instruction& last = rewritten.back();
+
+        // * Temporaries are read once, by the move here, so the last instruction can compute into its destination
+        const bool scalar = instruction.op == Opcode::MOVE and (bytecode::producesScalar(last.op) or last.op == Opcode::CALL);
+        const bool reference = instruction.op == Opcode::MOVE_REF and (bytecode::producesReference(last.op) or last.op == Opcode::CALL);
+        if((scalar or reference) and last.a == instruction.b and instruction.b >= function.temporaries) {
+          last.a = instruction.a;
+          ++moves;
+          continue;
+        }
+
+        if(instruction.op == Opcode::JLT and last.op == Opcode::ADD_IMM and last.a == last.b and (i16)last.c == 1 and instruction.a == last.a) {
+          last = { Opcode::INC_JLT, last.a, instruction.b, instruction.c };
+          ++steps;
+          continue;
+        }
+      }
+
+      rewritten.push_back(instruction);
+      spans.push_back(function.spans[at]);
+    }
+
+    moved[code.size()] = (u32)rewritten.size();
+    for(Instruction& instruction : rewritten)
+      if(bytecode::jumps(instruction.op)) instruction.c = (u16)moved[instruction.c];
+
+    function.code = std::move(rewritten);
+    function.spans = std::move(spans);
+  }
+
+  auto Peephole::immediate(bytecode::Function const& function, Instruction& instruction) noexcept -> void {
+    if(instruction.op != Opcode::ADD and instruction.op != Opcode::SUB) return;
+
+    const auto value = [&function](u16 operand) -> std::optional<i64> {
+      if(operand < function.constant_base or operand >= function.temporaries) return std::nullopt;
+      const i64 bits = function.constants[operand - function.constant_base];
+      if(bits < std::numeric_limits<i16>::min() or bits > std::numeric_limits<i16>::max()) return std::nullopt;
+      return bits;
+    };
+
+    // * Constants fit 16 bits here, so their negation does as well unless it is the largest one
+    if(instruction.op == Opcode::ADD) {
+      if(auto constant = value(instruction.c)) instruction = { Opcode::ADD_IMM, instruction.a, instruction.b, (u16)*constant };
+      else if(auto constant = value(instruction.b)) instruction = { Opcode::ADD_IMM, instruction.a, instruction.c, (u16)*constant };
+      else return;
+    } else if(auto constant = value(instruction.c); constant and *constant != std::numeric_limits<i16>::min()) {
+      instruction = { Opcode::ADD_IMM, instruction.a, instruction.b, (u16)-*constant };
+    } else return;
+    ++immediates;
+  }
+
+}
@@ -0,0 +1,90 @@
+#include "Process.hpp"
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <process.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+namespace fridayc {
+
+  auto spawn(std::vector<std::string> const& arguments, std::string const& output) -> std::optional<i32> {
+    if(arguments.empty()) return std::nullopt;
+
+    std::vector<i8*> argv;
+    for(std::string const& argument : arguments) argv.push_back(const_cast<i8*>(argument.c_str()));
+    argv.push_back(nullptr);
+
+#if defined(_WIN32)
+    // * The child inherits the standard output, which points at the output file while it runs
+    std::cout.flush();
+    std::fflush(stdout);
+    const bool redirected = not output.empty();
+    const i32 saved = redirected ? _dup(1) : -1;
+    if(redirected) {
+      const i32 file = _open(output.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC, _S_IREAD | _S_IWRITE);
+      if(file < 0) {
+        _close(saved);
+        return std::nullopt;
+      }
+      _dup2(file, 1);
+      _close(file);
+    }
+    const intptr_t status = _spawnvp(_P_WAIT, argv[0], argv.data());
+    if(redirected) {
+      _dup2(saved, 1);
+      _close(saved);
+    }
+    if(status < 0) return std::nullopt;
+    return (i32)status;
+#else
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    if(not output.empty()) posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    // * Buffered output written so far comes before the child's
+    std::cout.flush();
+    std::fflush(stdout);
+
+    pid_t child;
+    const i32 started = posix_spawnp(&child, argv[0], &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if(started != 0) return std::nullopt;
+
+    i32 status;
+    while(waitpid(child, &status, 0) < 0)
+      if(errno != EINTR) return std::nullopt;
+    if(not WIFEXITED(status)) return std::nullopt;
+    return WEXITSTATUS(status);
+#endif
+  }
+
+  auto command(i8 const* variable, std::string_view fallback) -> std::vector<std::string> {
+    i8 const* configured = std::getenv(variable);
+    std::string_view words = configured and *configured ? std::string_view{ configured } : fallback;
+
+    std::vector<std::string> arguments;
+    for(auto word : std::views::split(words, ' '))
+      if(not word.empty()) arguments.emplace_back(word.begin(), word.end());
+    if(arguments.empty()) arguments.emplace_back(fallback);
+    return arguments;
+  }
+
+  auto commandLine(std::vector<std::string> const& arguments) -> std::string {
+    std::string line;
+    for(std::string const& argument : arguments) {
+      if(not line.empty()) line += ' ';
+      line += argument;
+    }
+    return line;
+  }
+
+}
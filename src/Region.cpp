@@ -0,0 +1,58 @@
+#include "Region.hpp"
+
+namespace fridayc::runtime {
+
+  auto Region::mark() const noexcept -> Mark {
+    return position;
+  }
+
+  auto Region::rewind(Mark to) noexcept -> void {
+    position = to;
+  }
+
+  auto Region::allocationCount() const noexcept -> u64 {
+    return allocations;
+  }
+
+  auto Region::allocatedBytes() const noexcept -> u64 {
+    return allocated;
+  }
+
+  auto Region::peakBytes() const noexcept -> u64 {
+    return peak;
+  }
+
+  auto Region::do_allocate(std::size_t bytes, std::size_t alignment) -> void* {
+    // * Chunks too small for the allocation are skipped, they come back into use when the region is rewound before them
+    while(true) {
+      if(position.chunk < chunks.size()) {
+        Chunk const& chunk = chunks[position.chunk];
+        const u64 address = (u64)chunk.bytes.get();
+        const u64 start = ((address + position.used + alignment - 1) & ~(alignment - 1)) - address;
+        if(start + bytes <= chunk.size) {
+          position.used = start + bytes;
+          ++allocations;
+          allocated += bytes;
+          peak = std::max(peak, position.base + position.used);
+          return chunk.bytes.get() + start;
+        }
+        position.base += chunk.size;
+        position.used = 0;
+        ++position.chunk;
+      }
+      if(position.chunk == chunks.size()) {
+        const u64 size = std::max(chunks.empty() ? FIRST : 2 * chunks.back().size, std::bit_ceil<u64>(bytes + alignment));
+        chunks.push_back(Chunk{ std::make_unique_for_overwrite<std::byte[]>(size), size });
+      }
+    }
+  }
+
+  auto Region::do_deallocate(void*, std::size_t, std::size_t) -> void {
+    // * Memory comes back all at once, when the region is rewound
+  }
+
+  auto Region::do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool {
+    return this == &other;
+  }
+
+}
@@ -0,0 +1,250 @@
+#include "Resolver.hpp"
+
+namespace fridayc {
+
+  Resolver::Resolver(Resolver const& declarations) noexcept
+    : shared { &declarations }
+  {}
+
+  auto Resolver::resolve(Program& program) -> std::vector<Error> {
+    visit(program);
+    return std::move(error_queue);
+  }
+
+  auto Resolver::declare(Program& program) -> std::vector<Error> {
+    collect(program);
+    for(auto& stmt : *program.block)
+      if(not dynamic_cast<FunctionStatement*>(stmt.get())) visit(*stmt);
+    return std::move(error_queue);
+  }
+
+  auto Resolver::resolve(FunctionStatement& function) -> std::vector<Error> {
+    visit(function);
+    return std::move(error_queue);
+  }
+
+  auto Resolver::operator()(Identifier& arg) noexcept -> std::any {
+    if(Binding const* binding = lookup(arg.id)) arg.binding = *binding;
+    else errorAt(arg.span, "Undeclared identifier '{}'"f.format(arg.id));
+    return { };
+  }
+
+  auto Resolver::operator()(TypeExpression& arg) noexcept -> std::any {
+    // * Types are only declared at top level, locals cannot hide them
+    Binding const* binding = declarations().globals.find(arg.name);
+    if(not binding) {
+      errorAt(arg.span, "Unknown type '{}'"f.format(arg.name));
+      return { };
+    }
+
+    switch(binding->kind) {
+      case Binding::Kind::STRUCT:
+      case Binding::Kind::ENUM:
+      case Binding::Kind::BUILTIN:
+        arg.binding = *binding;
+        break;
+      default:
+        errorAt(arg.span, "'{}' is not a type"f.format(arg.name));
+    }
+    return { };
+  }
+
+  auto Resolver::operator()(InfixExpression& arg) noexcept -> std::any {
+    if(arg.oper != Token::Type::DOT) return Walker::operator()(arg);
+
+    visit(*arg.lhs);
+
+    auto* member = dynamic_cast<Identifier*>(arg.rhs.get());
+    if(not member) {
+      errorAt(arg.rhs->span, "Expected a member name after '.'"s);
+      return { };
+    }
+
+    auto* object = dynamic_cast<Identifier*>(arg.lhs.get());
+    const Binding::Kind kind = object ? object->binding.kind : Binding::Kind::UNRESOLVED;
+
+    if(kind == Binding::Kind::ENUM) {
+      // * Enum constants resolve to their ordinal
+      FlatMap<Symbol, u32> const* ordinals = declarations().constants.find(object->binding.declaration);
+      u32 const* ordinal = ordinals ? ordinals->find(member->id) : nullptr;
+      if(ordinal) member->binding = Binding{ Binding::Kind::CONSTANT, *ordinal, object->binding.declaration };
+      else errorAt(member->span, "Enum '{}' has no constant '{}'"f.format(object->id, member->id));
+    } else if(kind == Binding::Kind::NAMESPACE) {
+      // * There is a single translation unit, so a namespace exposes the top-level declarations
+      Binding const* binding = declarations().globals.find(member->id);
+      if(binding) member->binding = *binding;
+      else errorAt(member->span, "Namespace '{}' has no member '{}'"f.format(object->id, member->id));
+    } else {
+      // * Fields depend on the type of the object, they are checked once types are known
+      member->binding = Binding{ Binding::Kind::MEMBER };
+    }
+
+    return { };
+  }
+
+  auto Resolver::operator()(BlockStatement& arg) noexcept -> std::any {
+    const u32 first_slot = enterScope();
+    Walker::operator()(arg);
+    exitScope(first_slot);
+    return { };
+  }
+
+  auto Resolver::operator()(StructStatement& arg) noexcept -> std::any {
+    if(declaring) declareGlobal(arg.name, Binding{ Binding::Kind::STRUCT, 0, &arg }, arg.span);
+    else if(function) nested(arg.span);
+    else Walker::operator()(arg);
+    return { };
+  }
+
+  auto Resolver::operator()(EnumStatement& arg) noexcept -> std::any {
+    if(not declaring) {
+      if(function) nested(arg.span);
+      return { };
+    }
+
+    declareGlobal(arg.name, Binding{ Binding::Kind::ENUM, 0, &arg }, arg.span);
+
+    FlatMap<Symbol, u32>& ordinals = constants[&arg];
+    ordinals.reserve(arg.size());
+    for(u32 i = 0; i < arg.size(); ++i)
+      if(not ordinals.insert(arg[i], i).second)
+        errorAt(arg.span, "Duplicate constant '{}' in enum '{}'"f.format(arg[i], arg.name));
+
+    return { };
+  }
+
+  auto Resolver::operator()(FunctionStatement& arg) noexcept -> std::any {
+    if(declaring) {
+      declareGlobal(arg.name, Binding{ Binding::Kind::FUNCTION, 0, &arg }, arg.span);
+      return { };
+    }
+
+    // * The body of a nested function is left alone, the frame and scopes being built belong to the enclosing one
+    if(function) {
+      nested(arg.span);
+      // * Types only name top-level declarations, so the signature still resolves for the TypeChecker
+      for(Member& parameter : arg.args) visit(*parameter.type);
+      visit(*arg.return_type);
+      return { };
+    }
+
+    function = &arg;
+    arg.frame_size = 0;
+
+    // * Parameters and the outermost locals share a scope, so a local cannot redeclare a parameter
+    const u32 first_slot = enterScope();
+    for(Member& parameter : arg.args)
+      declareLocal(parameter.name, Binding{ Binding::Kind::PARAMETER, next_slot, &arg }, arg.span);
+
+    for(auto& stmt : *arg.block) visit(*stmt);
+    exitScope(first_slot);
+
+    function = nullptr;
+    return { };
+  }
+
+  auto Resolver::operator()(NamespaceStatement& arg) noexcept -> std::any {
+    if(declaring) {
+      // * Several files may open the same namespace
+      Binding const* existing = globals.find(arg.name);
+      if(not existing or existing->kind != Binding::Kind::NAMESPACE)
+        declareGlobal(arg.name, Binding{ Binding::Kind::NAMESPACE, 0, &arg }, arg.span);
+    }
+    return { };
+  }
+
+  auto Resolver::operator()(UsingStatement& arg) noexcept -> std::any {
+    if(declaring) return { };
+
+    Binding const* binding = declarations().globals.find(arg.name);
+    if(not binding or binding->kind != Binding::Kind::NAMESPACE)
+      errorAt(arg.span, "Unknown namespace '{}'"f.format(arg.name));
+
+    return { };
+  }
+
+  auto Resolver::operator()(DeclarationStatement& arg) noexcept -> std::any {
+    // * The initializer is resolved first: it cannot refer to the variable it initializes
+    Walker::operator()(arg);
+
+    arg.slot = next_slot;
+    declareLocal(arg.id, Binding{ Binding::Kind::LOCAL, arg.slot, &arg }, arg.span);
+    return { };
+  }
+
+  auto Resolver::operator()(Program& arg) noexcept -> std::any {
+    collect(arg);
+    for(auto& stmt : *arg.block) visit(*stmt);
+    return { };
+  }
+
+  auto Resolver::errorAt(Span span, std::string error) noexcept -> void {
+    error_queue.emplace_back(std::move(error), span);
+  }
+
+  auto Resolver::nested(Span span) noexcept -> void {
+    errorAt(span, "Nested declarations are not supported"s);
+  }
+
+  auto Resolver::collect(Program& program) noexcept -> void {
+    for(std::string_view primitive : PRIMITIVES)
+      globals.insert(Symbol::intern(primitive), Binding{ Binding::Kind::BUILTIN });
+
+    declaring = true;
+    for(auto& stmt : *program.block) visit(*stmt);
+    declaring = false;
+
+    // * Signatures are typed before any body is checked, so their types are resolved with the declarations
+    for(auto& stmt : *program.block) {
+      if(auto* function = dynamic_cast<FunctionStatement*>(stmt.get())) {
+        for(Member& parameter : function->args) visit(*parameter.type);
+        visit(*function->return_type);
+      }
+    }
+  }
+
+  auto Resolver::declarations() const noexcept -> Resolver const& {
+    return shared ? *shared : *this;
+  }
+
+  auto Resolver::declareGlobal(Symbol name, Binding binding, Span span) noexcept -> void {
+    if(not globals.insert(name, binding).second)
+      errorAt(span, "Redeclaration of '{}'"f.format(name));
+  }
+
+  auto Resolver::declareLocal(Symbol name, Binding binding, Span span) noexcept -> void {
+    u32& innermost = *visible.insert(name, NONE).first;
+    if(innermost != NONE and locals[innermost].depth == depth) {
+      errorAt(span, "Redeclaration of '{}'"f.format(name));
+      return;
+    }
+
+    locals.push_back(Local{ name, binding, depth, innermost });
+    innermost = locals.size() - 1;
+
+    ++next_slot;
+    if(function) function->frame_size = std::max(function->frame_size, next_slot);
+  }
+
+  auto Resolver::lookup(Symbol name) const noexcept -> Binding const* {
+    u32 const* innermost = visible.find(name);
+    if(innermost and *innermost != NONE) return &locals[*innermost].binding;
+    return declarations().globals.find(name);
+  }
+
+  auto Resolver::enterScope() noexcept -> u32 {
+    ++depth;
+    return next_slot;
+  }
+
+  auto Resolver::exitScope(u32 first_slot) noexcept -> void {
+    while(not locals.empty() and locals.back().depth == depth) {
+      *visible.find(locals.back().name) = locals.back().shadowed;
+      locals.pop_back();
+    }
+
+    --depth;
+    next_slot = first_slot;
+  }
+
+}
@@ -0,0 +1,187 @@
+#include "Runtime.hpp"
+#include "Analyzer.hpp"
+
+namespace fridayc::runtime {
+
+  namespace {
+
+    /// @brief Nesting of arrays and structs printed before the rest is elided
+    constexpr u32 PRINT_DEPTH = 16;
+
+  }
+
+  Text::Text(String value) noexcept
+    : value { std::move(value) }
+  {}
+
+  Cells::Cells(u64 size, std::pmr::memory_resource* memory)
+    : cells(size, memory)
+  {}
+
+  auto fault(std::string message, Span span) -> void {
+    throw RuntimeError{ Error{ std::move(message), span } };
+  }
+
+  auto text(Ref const& object, Span span) -> String const& {
+    if(not object) fault("Null dereference"s, span);
+    return static_cast<Text const&>(*object).value;
+  }
+
+  auto cells(Ref const& object, Span span) -> std::pmr::vector<Cell>& {
+    if(not object) fault("Null dereference"s, span);
+    return static_cast<Cells&>(*object).cells;
+  }
+
+  auto element(Ref const& object, i64 index, Span span) -> Cell& {
+    std::pmr::vector<Cell>& elements = cells(object, span);
+    if(index < 0 or (u64)index >= elements.size())
+      fault("Index {} out of bounds for length {}"f.format(index, elements.size()), span);
+    return elements[index];
+  }
+
+  auto character(Ref const& object, i64 index, Span span) -> i8 {
+    String const& value = text(object, span);
+    if(index < 0 or (u64)index >= value.length())
+      fault("Index {} out of bounds for length {}"f.format(index, value.length()), span);
+    return value[index];
+  }
+
+  auto concatenate(Ref const& lhs, Ref const& rhs, Span span) -> Ref {
+    return std::make_shared<Text>(text(lhs, span) + text(rhs, span));
+  }
+
+  auto equal(Ref const& lhs, Ref const& rhs) -> bool {
+    if(lhs == rhs) return true;
+    if(not lhs or not rhs) return false;
+    return static_cast<Text const&>(*lhs).value == static_cast<Text const&>(*rhs).value;
+  }
+
+  Printer::Printer(Analyzer const& analyzer, TypeTable const& table) noexcept
+    : analyzer { &analyzer }
+    , table { &table }
+  {}
+
+  Printer::Printer(std::vector<Shape> shapes) noexcept
+    : layouts { std::move(shapes) }
+  {}
+
+  auto Printer::format(TypeId type) -> Format const& {
+    return formatOf(shapeOf(type));
+  }
+
+  auto Printer::shapeOf(TypeId type) -> u32 {
+    if(u32* known = indices.find(type)) return *known;
+
+    // * Registered before its parts are described, so types that contain themselves find it
+    const u32 index = layouts.size();
+    indices.insert(type, index);
+    layouts.emplace_back();
+
+    TypeInfo const& info = table->info(type);
+    Shape shape { .kind = info.kind };
+    switch(info.kind) {
+      case TypeInfo::Kind::ENUM: {
+        auto* constants = static_cast<EnumStatement const*>(info.declaration);
+        shape.names.assign(constants->begin(), constants->end());
+        break;
+      }
+      case TypeInfo::Kind::ARRAY:
+        shape.parts.push_back(shapeOf(info.element));
+        break;
+      case TypeInfo::Kind::STRUCT: {
+        auto* declaration = static_cast<StructStatement const*>(info.declaration);
+        shape.name = declaration->name;
+        for(Member const& field : declaration->fields) shape.parts.push_back(shapeOf(analyzer->typeOf(*field.type)));
+        break;
+      }
+      default:
+        break;
+    }
+    layouts[index] = std::move(shape);
+    return index;
+  }
+
+  auto Printer::shapes() const noexcept -> std::vector<Shape> const& {
+    return layouts;
+  }
+
+  auto Printer::formatOf(u32 shape) -> Format const& {
+    if(formats.size() <= shape) formats.resize(layouts.size());
+    if(formats[shape]) return *formats[shape];
+
+    // * Registered before it is built, so shapes that contain themselves find it
+    Format& printer = *(formats[shape] = std::make_unique<Format>());
+    Shape const& layout = layouts[shape];
+
+    switch(layout.kind) {
+      case TypeInfo::Kind::INT:
+        printer = [](std::string& into, Cell const& cell, u32) { into += std::to_string(cell.integer); };
+        break;
+      case TypeInfo::Kind::FLOAT:
+        printer = [](std::string& into, Cell const& cell, u32) {
+          std::array<i8, 32> digits;
+          const auto end = std::to_chars(digits.data(), digits.data() + digits.size(), cell.real).ptr;
+          const std::string_view shortest(digits.data(), end);
+          into += shortest;
+          // * Whole floats keep a fraction, so they do not read as ints
+          if(shortest.find_first_of(".eEin"sv) == std::string_view::npos) into += ".0"sv;
+        };
+        break;
+      case TypeInfo::Kind::BOOL:
+        printer = [](std::string& into, Cell const& cell, u32) { into += cell.integer ? "true"sv : "false"sv; };
+        break;
+      case TypeInfo::Kind::CHAR:
+        printer = [](std::string& into, Cell const& cell, u32) { into += static_cast<i8>(cell.integer); };
+        break;
+      case TypeInfo::Kind::STRING:
+        printer = [](std::string& into, Cell const& cell, u32) {
+          into += cell.object ? static_cast<Text const&>(*cell.object).value.view() : "null"sv;
+        };
+        break;
+      case TypeInfo::Kind::ENUM:
+        printer = [names = layout.names](std::string& into, Cell const& cell, u32) {
+          into += names[cell.integer].view();
+        };
+        break;
+      case TypeInfo::Kind::ARRAY:
+        printer = [element = &formatOf(layout.parts.front())](std::string& into, Cell const& cell, u32 depth) {
+          if(not cell.object) into += "null"sv;
+          else if(depth == PRINT_DEPTH) into += "[...]"sv;
+          else {
+            into += '[';
+            for(bool first = true; Cell const& value : static_cast<Cells const&>(*cell.object).cells) {
+              if(not std::exchange(first, false)) into += ", "sv;
+              (*element)(into, value, depth + 1);
+            }
+            into += ']';
+          }
+        };
+        break;
+      case TypeInfo::Kind::STRUCT: {
+        std::vector<Format const*> fields;
+        for(u32 part : layout.parts) fields.push_back(&formatOf(part));
+
+        printer = [name = layout.name, fields = std::move(fields)](std::string& into, Cell const& cell, u32 depth) {
+          if(not cell.object) into += "null"sv;
+          else if(depth == PRINT_DEPTH) into += "{}(...)"f.format(name);
+          else {
+            into += name.view();
+            into += '(';
+            std::pmr::vector<Cell> const& values = static_cast<Cells const&>(*cell.object).cells;
+            for(u64 i = 0; i < values.size(); ++i) {
+              if(i) into += ", "sv;
+              (*fields[i])(into, values[i], depth + 1);
+            }
+            into += ')';
+          }
+        };
+        break;
+      }
+      default:
+        printer = [](std::string& into, Cell const&, u32) { into += "null"sv; };
+        break;
+    }
+    return printer;
+  }
+
+}
@@ -0,0 +1,72 @@
+#include "SideEffects.hpp"
+
+namespace fridayc {
+
+  SideEffects::SideEffects(std::vector<bool>& variant) noexcept
+    : variant { variant }
+  {}
+
+  // * Without types, every negation, addition, subtraction and multiplication counts as checked int arithmetic
+  auto SideEffects::operator()(PrefixExpression& arg) noexcept -> std::any {
+    if(arg.oper == Token::Type::MINUS) fallible = true;
+    return Walker::operator()(arg);
+  }
+
+  auto SideEffects::operator()(InfixExpression& arg) noexcept -> std::any {
+    const Token::Type compound = Token::compoundOperatorOf(arg.oper);
+    const Token::Type oper = compound != Token::Type::ILLEGAL ? compound : arg.oper;
+
+    if(arg.oper == Token::Type::ASSIGN or compound != Token::Type::ILLEGAL) {
+      auto* name = dynamic_cast<Identifier*>(arg.lhs.get());
+      if(name and (name->binding.kind == Binding::Kind::LOCAL or name->binding.kind == Binding::Kind::PARAMETER)) mark(name->binding.slot);
+      else writes = true;
+    }
+
+    switch(oper) {
+      case Token::Type::PLUS:
+      case Token::Type::MINUS:
+      case Token::Type::STAR:
+      case Token::Type::SLASH:
+      case Token::Type::MODULO:
+      case Token::Type::LSHIFT:
+      case Token::Type::RSHIFT:
+        fallible = true;
+        break;
+      default:
+        break;
+    }
+
+    if(arg.oper == Token::Type::DOT) {
+      // * Enum constants and namespace members are names, reading a field can meet 'null'
+      auto* object = dynamic_cast<Identifier*>(arg.lhs.get());
+      if(object and (object->binding.kind == Binding::Kind::ENUM or object->binding.kind == Binding::Kind::NAMESPACE)) return { };
+      fallible = true;
+      visit(*arg.lhs);
+      return { };
+    }
+
+    return Walker::operator()(arg);
+  }
+
+  auto SideEffects::operator()(CallExpression& arg) noexcept -> std::any {
+    Identifier const* name = arg.callee();
+    if(not name or name->binding.kind != Binding::Kind::STRUCT) calls = true;
+    for(auto& argument : arg) visit(*argument);
+    return { };
+  }
+
+  auto SideEffects::operator()(SubscriptExpression& arg) noexcept -> std::any {
+    fallible = true;
+    return Walker::operator()(arg);
+  }
+
+  auto SideEffects::operator()(DeclarationStatement& arg) noexcept -> std::any {
+    mark(arg.slot);
+    return Walker::operator()(arg);
+  }
+
+  auto SideEffects::mark(u32 slot) noexcept -> void {
+    if(slot < variant.size()) variant[slot] = true;
+  }
+
+}
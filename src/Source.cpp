@@ -0,0 +1,91 @@
+#include "Source.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    struct SourceFile {
+      std::string path;
+      std::string text;
+      std::vector<u32> line_starts { };
+      std::once_flag indexed { };
+
+      auto index() -> std::vector<u32> const& {
+        std::call_once(indexed, [this] {
+          line_starts.push_back(0);
+          for(u32 i = 0; i < text.length(); ++i)
+            if(text[i] == '\n') line_starts.push_back(i + 1);
+        });
+        return line_starts;
+      }
+    };
+
+    std::mutex registry_mutex;
+    std::vector<Box<SourceFile>> registry;
+
+    auto fileAt(u32 file) -> SourceFile* {
+      std::scoped_lock lock { registry_mutex };
+      return file < registry.size() ? registry[file].get() : nullptr;
+    }
+
+  }
+
+  auto Sources::add(std::string path, std::string text) -> u32 {
+    std::scoped_lock lock { registry_mutex };
+    if(registry.size() >= NONE) return NONE;
+
+    registry.push_back(std::make_unique<SourceFile>(std::move(path), std::move(text)));
+    return registry.size() - 1;
+  }
+
+  auto Sources::path(u32 file) -> std::string_view {
+    SourceFile* source = fileAt(file);
+    return source ? std::string_view{ source->path } : "<unknown>"sv;
+  }
+
+  auto Sources::text(u32 file) -> std::string_view {
+    SourceFile* source = fileAt(file);
+    return source ? std::string_view{ source->text } : ""sv;
+  }
+
+  auto Sources::line(u32 file, u32 row) -> std::string_view {
+    SourceFile* source = fileAt(file);
+    if(not source or row == 0) return ""sv;
+
+    auto const& starts = source->index();
+    if(row > starts.size()) return ""sv;
+
+    std::string_view text = source->text;
+    u32 begin = starts[row - 1];
+    u32 end = row < starts.size() ? starts[row] - 1 : text.length();
+    return text.substr(begin, end - begin);
+  }
+
+  auto Sources::lines(u32 file) -> u32 {
+    SourceFile* source = fileAt(file);
+    return source ? source->index().size() : 0;
+  }
+
+  auto Sources::locate(Span span) -> Location {
+    SourceFile* source = fileAt(span.file);
+    if(not source) return Location{ 0, 0 };
+
+    auto const& starts = source->index();
+    auto it = std::ranges::upper_bound(starts, span.offset);
+    u32 row = std::distance(starts.begin(), it);
+    return Location{ row, span.offset - starts[row - 1] + 1 };
+  }
+
+  auto Sources::spanOf(u32 file, std::string_view slice) -> Span {
+    std::string_view text = Sources::text(file);
+    if(text.empty() or slice.data() < text.data() or slice.data() > text.data() + text.length())
+      return Span{};
+
+    Span span;
+    span.offset = slice.data() - text.data();
+    span.length = Span::saturate(slice.length());
+    span.file = file;
+    return span;
+  }
+
+}
@@ -0,0 +1,495 @@
+#include "Ssa.hpp"
+
+namespace fridayc::ssa {
+
+  namespace {
+
+    constexpr std::array<std::string_view, (u64)Opcode::COUNT> NAMES = {
+      "parameter"sv, "constant"sv, "string"sv,
+      "slot"sv, "load"sv, "store"sv,
+      "add"sv, "sub"sv, "mul"sv, "div"sv, "mod"sv, "bit_and"sv, "bit_or"sv, "shl"sv, "shr"sv,
+      "neg"sv, "bit_not"sv,
+      "fadd"sv, "fsub"sv, "fmul"sv, "fdiv"sv, "fneg"sv,
+      "eq"sv, "ne"sv, "lt"sv, "le"sv, "feq"sv, "fne"sv, "flt"sv, "fle"sv, "req"sv, "rne"sv, "seq"sv, "sne"sv,
+      "not"sv, "concat"sv,
+      "new"sv, "get_field"sv, "set_field"sv,
+      "get_elem"sv, "set_elem"sv, "get_char"sv,
+      "call"sv, "print"sv,
+      "phi"sv,
+      "jump"sv, "branch"sv, "return"sv, "fall_off"sv,
+    };
+
+    constexpr std::array<std::string_view, 6> TYPES = { "void"sv, "int"sv, "float"sv, "bool"sv, "char"sv, "ref"sv };
+
+    /// @brief Number of operands of an opcode, NONE if it varies
+    constexpr auto arity(Opcode op) noexcept -> u32 {
+      switch(op) {
+        case Opcode::PARAMETER: case Opcode::CONSTANT: case Opcode::STRING: case Opcode::SLOT:
+        case Opcode::NEW: case Opcode::JUMP: case Opcode::FALL_OFF: return 0;
+        case Opcode::LOAD: case Opcode::NEG: case Opcode::BIT_NOT: case Opcode::FNEG: case Opcode::NOT:
+        case Opcode::GET_FIELD: case Opcode::PRINT: case Opcode::BRANCH: return 1;
+        case Opcode::SET_ELEM: return 3;
+        case Opcode::CALL: case Opcode::PHI: case Opcode::RETURN: return NONE;
+        default: return 2;
+      }
+    }
+
+    /// @brief Type of the operands of an operation, NONE if they are checked apart
+    constexpr auto operandType(Opcode op) noexcept -> std::optional<Type> {
+      switch(op) {
+        case Opcode::ADD: case Opcode::SUB: case Opcode::MUL: case Opcode::DIV: case Opcode::MOD:
+        case Opcode::BIT_AND: case Opcode::BIT_OR: case Opcode::SHL: case Opcode::SHR:
+        case Opcode::NEG: case Opcode::BIT_NOT: return Type::INT;
+        case Opcode::FADD: case Opcode::FSUB: case Opcode::FMUL: case Opcode::FDIV: case Opcode::FNEG:
+        case Opcode::FEQ: case Opcode::FNE: case Opcode::FLT: case Opcode::FLE: return Type::FLOAT;
+        case Opcode::REQ: case Opcode::RNE: case Opcode::SEQ: case Opcode::SNE: case Opcode::CONCAT: return Type::REFERENCE;
+        case Opcode::NOT: case Opcode::BRANCH: return Type::BOOL;
+        default: return std::nullopt;
+      }
+    }
+
+    /// @brief Type of the value of an operation, NONE if it is checked apart
+    constexpr auto resultType(Opcode op) noexcept -> std::optional<Type> {
+      switch(op) {
+        case Opcode::ADD: case Opcode::SUB: case Opcode::MUL: case Opcode::DIV: case Opcode::MOD:
+        case Opcode::BIT_AND: case Opcode::BIT_OR: case Opcode::SHL: case Opcode::SHR:
+        case Opcode::NEG: case Opcode::BIT_NOT: return Type::INT;
+        case Opcode::FADD: case Opcode::FSUB: case Opcode::FMUL: case Opcode::FDIV: case Opcode::FNEG: return Type::FLOAT;
+        case Opcode::EQ: case Opcode::NE: case Opcode::LT: case Opcode::LE:
+        case Opcode::FEQ: case Opcode::FNE: case Opcode::FLT: case Opcode::FLE:
+        case Opcode::REQ: case Opcode::RNE: case Opcode::SEQ: case Opcode::SNE: case Opcode::NOT: return Type::BOOL;
+        case Opcode::STRING: case Opcode::CONCAT: case Opcode::NEW: return Type::REFERENCE;
+        case Opcode::GET_CHAR: return Type::CHAR;
+        case Opcode::STORE: case Opcode::SET_FIELD: case Opcode::SET_ELEM: case Opcode::PRINT:
+        case Opcode::JUMP: case Opcode::BRANCH: case Opcode::RETURN: case Opcode::FALL_OFF: return Type::VOID;
+        default: return std::nullopt;
+      }
+    }
+
+    /// @brief Number of successors of a terminator
+    constexpr auto successorCount(Opcode op) noexcept -> u32 {
+      return op == Opcode::JUMP ? 1 : op == Opcode::BRANCH ? 2 : 0;
+    }
+
+    auto escaped(std::string_view text) -> std::string {
+      std::string result;
+      for(const i8 character : text) {
+        if(character == '\n') result += "\\n"sv;
+        else if(character == '"' or character == '\\') result += '\\', result += character;
+        else result += character;
+      }
+      return result;
+    }
+
+    /// @brief Spelling of a scalar constant of a type
+    auto literal(Type type, i64 bits) -> std::string {
+      switch(type) {
+        case Type::FLOAT: return "{}"f.format(std::bit_cast<f64>(bits));
+        case Type::BOOL: return bits ? "true"s : "false"s;
+        case Type::REFERENCE: return "null"s;
+        default: return "{}"f.format(bits);
+      }
+    }
+
+    /// @brief Checks one function, appending what is wrong to the errors
+    class Verifier {
+      Module const&             module;
+      Function const&           function;
+      std::vector<Error>&       errors;
+      Dominators                tree     { };
+      std::vector<u32>          position { };
+
+      public:
+      Verifier(Module const& module, Function const& function, std::vector<Error>& errors) noexcept
+        : module { module }
+        , function { function }
+        , errors { errors }
+      {}
+
+      auto verify() -> void {
+        if(function.blocks.empty()) return fail(function.span, "has no entry block"s);
+
+        tree = function.dominators();
+        const auto predecessors = function.predecessors();
+        position.assign(function.values.size(), NONE);
+        for(u32 block = 0; block < function.blocks.size(); ++block)
+          for(u32 k = 0; k < function.blocks[block].code.size(); ++k) {
+            const Value value = function.blocks[block].code[k];
+            if(value >= function.values.size()) return fail(function.span, "b{} lists %{}, which does not exist"f.format(block, value));
+            if(function.values[value].block != block) fail(function.values[value].span, "%{} is listed in b{} but belongs to b{}"f.format(value, block, function.values[value].block));
+            position[value] = k;
+          }
+
+        for(u32 block = 0; block < function.blocks.size(); ++block) {
+          auto const& code = function.blocks[block].code;
+          if(code.empty() or not terminates(function.values[code.back()].op)) {
+            fail(function.span, "b{} does not end with a terminator"f.format(block));
+            continue;
+          }
+
+          bool phis = true;
+          for(u32 k = 0; k < code.size(); ++k) {
+            Instruction const& instruction = function.values[code[k]];
+            if(instruction.op != Opcode::PHI) phis = false;
+            else if(not phis) fail(instruction.span, "phi %{} follows other instructions of b{}"f.format(code[k], block));
+            if(terminates(instruction.op) and k + 1 != code.size()) fail(instruction.span, "%{} ends b{} before its last instruction"f.format(code[k], block));
+            if(instruction.op == Opcode::SLOT and block != 0) fail(instruction.span, "slot %{} is not in the entry block"f.format(code[k]));
+            check(code[k], predecessors[block]);
+          }
+        }
+      }
+
+      private:
+      auto fail(Span span, std::string message) -> void {
+        errors.emplace_back("Invalid SSA in '{}': {}"f.format(function.name, message), span);
+      }
+
+      auto check(Value value, std::vector<u32> const& predecessors) -> void {
+        Instruction const& instruction = function.values[value];
+        const u32 expected = arity(instruction.op);
+        if(expected != NONE and instruction.operands.size() != expected)
+          return fail(instruction.span, "{} %{} takes {} operands, not {}"f.format(nameOf(instruction.op), value, expected, instruction.operands.size()));
+        if(instruction.op != Opcode::PHI and instruction.blocks.size() != successorCount(instruction.op))
+          return fail(instruction.span, "{} %{} has {} successors"f.format(nameOf(instruction.op), value, instruction.blocks.size()));
+        for(const u32 successor : instruction.blocks)
+          if(successor >= function.blocks.size()) return fail(instruction.span, "%{} refers to b{}, which does not exist"f.format(value, successor));
+
+        for(u32 k = 0; k < instruction.operands.size(); ++k) {
+          const Value operand = instruction.operands[k];
+          if(operand >= function.values.size() or function.values[operand].block == NONE)
+            return fail(instruction.span, "%{} reads %{}, which is not defined"f.format(value, operand));
+          if(function.values[operand].type == Type::VOID)
+            fail(instruction.span, "%{} reads %{}, which has no value"f.format(value, operand));
+
+          // * Unreachable code is never run, it only needs to be well formed
+          if(tree.idom[instruction.block] == NONE) continue;
+          const u32 at = instruction.op == Opcode::PHI ? instruction.blocks[k] : instruction.block;
+          if(not dominated(operand, at, instruction.op == Opcode::PHI ? NONE : position[value]))
+            fail(instruction.span, "the definition of %{} does not dominate its use by %{}"f.format(operand, value));
+        }
+
+        if(auto type = resultType(instruction.op); type and instruction.type != *type)
+          fail(instruction.span, "{} %{} has type {} rather than {}"f.format(nameOf(instruction.op), value, nameOf(instruction.type), nameOf(*type)));
+        if(auto type = operandType(instruction.op))
+          for(const Value operand : instruction.operands)
+            if(function.values[operand].type != *type)
+              fail(instruction.span, "{} %{} reads %{} of type {} rather than {}"f.format(nameOf(instruction.op), value, operand, nameOf(function.values[operand].type), nameOf(*type)));
+
+        auto typeOf = [&](u32 k) { return function.values[instruction.operands[k]].type; };
+        switch(instruction.op) {
+          case Opcode::PARAMETER:
+            if((u64)instruction.immediate >= function.parameters.size() or function.parameters[instruction.immediate] != instruction.type)
+              fail(instruction.span, "parameter %{} does not match the parameters of the function"f.format(value));
+            break;
+          case Opcode::STRING:
+            if((u64)instruction.immediate >= module.strings.size()) fail(instruction.span, "string %{} refers to no constant"f.format(value));
+            break;
+          case Opcode::LOAD:
+          case Opcode::STORE: {
+            Instruction const& slot = function.values[instruction.operands[0]];
+            if(slot.op != Opcode::SLOT) fail(instruction.span, "{} %{} does not access a slot"f.format(nameOf(instruction.op), value));
+            const Type type = instruction.op == Opcode::LOAD ? instruction.type : typeOf(1);
+            if(type != slot.type) fail(instruction.span, "{} %{} accesses a {} slot as {}"f.format(nameOf(instruction.op), value, nameOf(slot.type), nameOf(type)));
+            break;
+          }
+          case Opcode::EQ: case Opcode::NE: case Opcode::LT: case Opcode::LE:
+            if(typeOf(0) != typeOf(1) or typeOf(0) == Type::FLOAT or typeOf(0) == Type::REFERENCE)
+              fail(instruction.span, "{} %{} compares {} and {}"f.format(nameOf(instruction.op), value, nameOf(typeOf(0)), nameOf(typeOf(1))));
+            break;
+          case Opcode::GET_FIELD: case Opcode::SET_FIELD:
+            if(typeOf(0) != Type::REFERENCE) fail(instruction.span, "{} %{} does not access an object"f.format(nameOf(instruction.op), value));
+            break;
+          case Opcode::GET_ELEM: case Opcode::SET_ELEM: case Opcode::GET_CHAR:
+            if(typeOf(0) != Type::REFERENCE or typeOf(1) != Type::INT)
+              fail(instruction.span, "{} %{} does not index an object by an int"f.format(nameOf(instruction.op), value));
+            break;
+          case Opcode::CALL: {
+            if((u64)instruction.immediate >= module.functions.size()) {
+              fail(instruction.span, "call %{} refers to no function"f.format(value));
+              break;
+            }
+            Function const& callee = module.functions[instruction.immediate];
+            bool matches = callee.returns == instruction.type and callee.parameters.size() == instruction.operands.size();
+            for(u32 k = 0; matches and k < instruction.operands.size(); ++k) matches = callee.parameters[k] == typeOf(k);
+            if(not matches) fail(instruction.span, "call %{} does not match the signature of '{}'"f.format(value, callee.name));
+            break;
+          }
+          case Opcode::PHI: {
+            if(instruction.operands.size() != instruction.blocks.size()) {
+              fail(instruction.span, "phi %{} has {} operands for {} blocks"f.format(value, instruction.operands.size(), instruction.blocks.size()));
+              break;
+            }
+            for(u32 k = 0; k < instruction.operands.size(); ++k)
+              if(typeOf(k) != instruction.type) fail(instruction.span, "phi %{} of type {} takes %{} of type {}"f.format(value, nameOf(instruction.type), instruction.operands[k], nameOf(typeOf(k))));
+
+            std::vector<u32> incoming = instruction.blocks, expected = predecessors;
+            std::ranges::sort(incoming);
+            std::ranges::sort(expected);
+            if(incoming != expected) fail(instruction.span, "phi %{} does not take one operand per predecessor of b{}"f.format(value, instruction.block));
+            break;
+          }
+          case Opcode::RETURN:
+            if(function.returns == Type::VOID ? not instruction.operands.empty() : instruction.operands.size() != 1 or typeOf(0) != function.returns)
+              fail(instruction.span, "return %{} does not return a {}"f.format(value, nameOf(function.returns)));
+            break;
+          default:
+            break;
+        }
+      }
+
+      /// @brief Tells whether a value is defined before a position of a block, or anywhere in it for NONE, on every path
+      auto dominated(Value operand, u32 block, u32 before) const noexcept -> bool {
+        const u32 defined = function.values[operand].block;
+        if(defined == block) return before == NONE or position[operand] < before;
+        return tree.dominates(defined, block);
+      }
+    };
+
+  }
+
+  auto nameOf(Opcode op) noexcept -> std::string_view {
+    return op < Opcode::COUNT ? NAMES[(u64)op] : "?"sv;
+  }
+
+  auto nameOf(Type type) noexcept -> std::string_view {
+    return (u64)type < TYPES.size() ? TYPES[(u64)type] : "?"sv;
+  }
+
+  auto Dominators::dominates(u32 dominator, u32 block) const noexcept -> bool {
+    if(idom[block] == NONE or idom[dominator] == NONE) return false;
+    while(block != dominator) {
+      if(idom[block] == block) return false;
+      block = idom[block];
+    }
+    return true;
+  }
+
+  auto Function::append(u32 block, Instruction instruction) -> Value {
+    return insert(block, (u32)blocks[block].code.size(), std::move(instruction));
+  }
+
+  auto Function::insert(u32 block, u32 position, Instruction instruction) -> Value {
+    const Value value = (Value)values.size();
+    instruction.block = block;
+    values.push_back(std::move(instruction));
+    blocks[block].code.insert(blocks[block].code.begin() + position, value);
+    return value;
+  }
+
+  auto Function::add() -> u32 {
+    blocks.emplace_back();
+    return (u32)blocks.size() - 1;
+  }
+
+  auto Function::terminator(u32 block) const noexcept -> Value {
+    auto const& code = blocks[block].code;
+    if(code.empty() or not terminates(values[code.back()].op)) return NONE;
+    return code.back();
+  }
+
+  auto Function::successors(u32 block) const noexcept -> std::span<u32 const> {
+    const Value last = terminator(block);
+    if(last == NONE) return { };
+    return values[last].blocks;
+  }
+
+  auto Function::predecessors() const -> std::vector<std::vector<u32>> {
+    std::vector<std::vector<u32>> result(blocks.size());
+    for(u32 block = 0; block < blocks.size(); ++block)
+      for(const u32 successor : successors(block)) result[successor].push_back(block);
+    return result;
+  }
+
+  auto Function::dominators() const -> Dominators {
+    const u32 count = (u32)blocks.size();
+    Dominators tree {
+      .idom = std::vector<u32>(count, NONE),
+      .children = std::vector<std::vector<u32>>(count),
+      .position = std::vector<u32>(count, NONE),
+    };
+    if(blocks.empty()) return tree;
+
+    // * Postorder by an explicit stack of blocks and their next successor, long functions would overflow recursion
+    std::vector<u32> postorder;
+    std::vector<bool> seen(count, false);
+    std::vector<std::pair<u32, u32>> stack { { 0, 0 } };
+    seen[0] = true;
+    while(not stack.empty()) {
+      const u32 block = stack.back().first;
+      const auto next = successors(block);
+      if(stack.back().second < next.size()) {
+        const u32 successor = next[stack.back().second++];
+        if(not seen[successor]) {
+          seen[successor] = true;
+          stack.emplace_back(successor, 0);
+        }
+      } else {
+        postorder.push_back(block);
+        stack.pop_back();
+      }
+    }
+    tree.order.assign(postorder.rbegin(), postorder.rend());
+    for(u32 k = 0; k < tree.order.size(); ++k) tree.position[tree.order[k]] = k;
+
+    // * Cooper, Harvey and Kennedy: refine the dominators in reverse postorder until they settle
+    const auto predecessors = this->predecessors();
+    const auto intersect = [&](u32 a, u32 b) {
+      while(a != b) {
+        while(tree.position[a] > tree.position[b]) a = tree.idom[a];
+        while(tree.position[b] > tree.position[a]) b = tree.idom[b];
+      }
+      return a;
+    };
+
+    tree.idom[0] = 0;
+    for(bool changed = true; changed;) {
+      changed = false;
+      for(u32 k = 1; k < tree.order.size(); ++k) {
+        const u32 block = tree.order[k];
+        u32 dominator = NONE;
+        for(const u32 predecessor : predecessors[block]) {
+          if(tree.idom[predecessor] == NONE) continue;
+          dominator = dominator == NONE ? predecessor : intersect(predecessor, dominator);
+        }
+        if(dominator != tree.idom[block]) {
+          tree.idom[block] = dominator;
+          changed = true;
+        }
+      }
+    }
+
+    for(const u32 block : tree.order)
+      if(block != 0) tree.children[tree.idom[block]].push_back(block);
+    return tree;
+  }
+
+  auto Function::uses() const -> std::vector<std::vector<Value>> {
+    std::vector<std::vector<Value>> result(values.size());
+    for(Block const& block : blocks)
+      for(const Value value : block.code)
+        for(const Value operand : values[value].operands) result[operand].push_back(value);
+    return result;
+  }
+
+  auto Function::replace(std::vector<Value>& replacement) -> void {
+    const auto resolve = [&](Value value) {
+      Value target = value;
+      while(target < replacement.size() and replacement[target] != NONE and replacement[target] != target) target = replacement[target];
+      if(value < replacement.size() and replacement[value] != NONE) replacement[value] = target;
+      return target;
+    };
+
+    for(Block const& block : blocks)
+      for(const Value value : block.code)
+        for(Value& operand : values[value].operands) operand = resolve(operand);
+  }
+
+  auto Function::remove(Value value) noexcept -> void {
+    Instruction& instruction = values[value];
+    if(instruction.block == NONE) return;
+    std::erase(blocks[instruction.block].code, value);
+    instruction.block = NONE;
+  }
+
+  auto Function::compact() -> void {
+    if(blocks.empty()) return;
+
+    const Dominators tree = dominators();
+    std::vector<u32> renumbered(blocks.size(), NONE);
+    u32 kept = 0;
+    for(u32 block = 0; block < blocks.size(); ++block)
+      if(tree.idom[block] != NONE) renumbered[block] = kept++;
+
+    // * Phis keep an operand per edge that still reaches them, the first one listed for every edge
+    const auto predecessors = this->predecessors();
+    for(u32 block = 0; block < blocks.size(); ++block) {
+      if(renumbered[block] == NONE) continue;
+      for(const Value value : blocks[block].code) {
+        Instruction& phi = values[value];
+        if(phi.op != Opcode::PHI) break;
+
+        std::vector<u32> edges;
+        for(const u32 predecessor : predecessors[block]) if(renumbered[predecessor] != NONE) edges.push_back(predecessor);
+        std::vector<Value> operands;
+        std::vector<u32> incoming;
+        for(u32 k = 0; k < phi.blocks.size(); ++k)
+          if(auto edge = std::ranges::find(edges, phi.blocks[k]); edge != edges.end()) {
+            edges.erase(edge);
+            operands.push_back(phi.operands[k]);
+            incoming.push_back(phi.blocks[k]);
+          }
+        phi.operands = std::move(operands);
+        phi.blocks = std::move(incoming);
+      }
+    }
+
+    std::vector<Value> numbers(values.size(), NONE);
+    std::vector<Instruction> compacted;
+    std::vector<Block> remaining(kept);
+    for(u32 block = 0; block < blocks.size(); ++block) {
+      if(renumbered[block] == NONE) continue;
+      for(const Value value : blocks[block].code) {
+        numbers[value] = (Value)compacted.size();
+        remaining[renumbered[block]].code.push_back(numbers[value]);
+        compacted.push_back(std::move(values[value]));
+      }
+    }
+
+    for(Instruction& instruction : compacted) {
+      instruction.block = renumbered[instruction.block];
+      for(Value& operand : instruction.operands) operand = numbers[operand];
+      for(u32& block : instruction.blocks) block = renumbered[block];
+    }
+    values = std::move(compacted);
+    blocks = std::move(remaining);
+  }
+
+  auto Module::print(std::ostream& out, TypeTable const& table) const -> void {
+    for(u64 index = 0; index < functions.size(); ++index) {
+      Function const& function = functions[index];
+      std::string parameters;
+      for(u64 k = 0; k < function.parameters.size(); ++k) parameters += "{}{}"f.format(k ? ", "sv : ""sv, nameOf(function.parameters[k]));
+      out << "fn {} #{}({}) -> {}\n"f.format(function.name, index, parameters, nameOf(function.returns));
+
+      const auto predecessors = function.predecessors();
+      for(u32 block = 0; block < function.blocks.size(); ++block) {
+        std::string from;
+        for(const u32 predecessor : predecessors[block]) from += "{}b{}"f.format(from.empty() ? "; from "sv : ", "sv, predecessor);
+        out << "  b{}:{}{}\n"f.format(block, from.empty() ? ""sv : "  "sv, from);
+
+        for(const Value value : function.blocks[block].code) {
+          Instruction const& instruction = function.values[value];
+          std::string line = instruction.type == Type::VOID ? "    "s : "    %{} = "f.format(value);
+          line += nameOf(instruction.op);
+          if(instruction.type != Type::VOID) line += " {}"f.format(nameOf(instruction.type));
+
+          std::vector<std::string> parts;
+          switch(instruction.op) {
+            case Opcode::CONSTANT: parts.push_back(literal(instruction.type, instruction.immediate)); break;
+            case Opcode::STRING: parts.push_back("\"{}\""f.format(escaped(strings[instruction.immediate]))); break;
+            case Opcode::CALL: parts.push_back("{}"f.format(functions[instruction.immediate].name)); break;
+            case Opcode::PRINT: parts.push_back(table.name((TypeId)instruction.immediate)); break;
+            case Opcode::PARAMETER: case Opcode::SLOT: case Opcode::NEW: case Opcode::GET_FIELD: case Opcode::SET_FIELD:
+              parts.push_back("{}"f.format(instruction.immediate));
+              break;
+            default: break;
+          }
+          for(u64 k = 0; k < instruction.operands.size(); ++k)
+            parts.push_back(instruction.op == Opcode::PHI ? "[%{}, b{}]"f.format(instruction.operands[k], instruction.blocks[k]) : "%{}"f.format(instruction.operands[k]));
+          if(instruction.op != Opcode::PHI)
+            for(const u32 successor : instruction.blocks) parts.push_back("b{}"f.format(successor));
+
+          for(u64 k = 0; k < parts.size(); ++k) line += "{}{}"f.format(k ? ", "sv : " "sv, parts[k]);
+          out << line << '\n';
+        }
+      }
+    }
+  }
+
+  auto Module::verify() const -> std::vector<Error> {
+    std::vector<Error> errors;
+    for(Function const& function : functions) Verifier(*this, function, errors).verify();
+    return errors;
+  }
+
+}
@@ -0,0 +1,487 @@
+#include "SsaBuilder.hpp"
+#include "Analyzer.hpp"
+
+namespace fridayc {
+
+  using ssa::Opcode;
+  using ssa::Value;
+
+  namespace {
+
+    /// @brief Comparison on ints or on floats, the greater ones swap their operands
+    auto ordered(Token::Type oper, bool floats) noexcept -> std::optional<std::pair<Opcode, bool>> {
+      const Opcode less = floats ? Opcode::FLT : Opcode::LT;
+      const Opcode less_equal = floats ? Opcode::FLE : Opcode::LE;
+      switch(oper) {
+        case Token::Type::LESS: return std::pair{ less, false };
+        case Token::Type::LESS_EQ: return std::pair{ less_equal, false };
+        case Token::Type::GREATER: return std::pair{ less, true };
+        case Token::Type::GREATER_EQ: return std::pair{ less_equal, true };
+        case Token::Type::EQUALS: return std::pair{ floats ? Opcode::FEQ : Opcode::EQ, false };
+        case Token::Type::NOT_EQ: return std::pair{ floats ? Opcode::FNE : Opcode::NE, false };
+        default: return std::nullopt;
+      }
+    }
+
+  }
+
+  SsaBuilder::SsaBuilder(Analyzer const& analyzer, TypeTable const& table) noexcept
+    : analyzer { analyzer }
+    , table { table }
+  {}
+
+  auto SsaBuilder::build(Program& program) -> std::vector<Error> {
+    errors.clear();
+    built = { };
+    indices.clear();
+    strings.clear();
+
+    FunctionStatement* entry = nullptr;
+    for(auto& stmt : *program.block)
+      if(auto* declaration = dynamic_cast<FunctionStatement*>(stmt.get()); declaration and declaration->name.view() == "main"sv)
+        entry = declaration;
+
+    if(not entry) {
+      errors.emplace_back("No 'main' function to run"s, Span{ });
+      return std::move(errors);
+    }
+    if(not entry->args.empty()) {
+      errors.emplace_back("'main' cannot take parameters"s, entry->span);
+      return std::move(errors);
+    }
+
+    built.returns_int = analyzer.typeOf(*entry->return_type) == TypeId::INT;
+    index(*entry);
+
+    // * Functions are built one at a time, each call queues the callees seen for the first time
+    while(not pending.empty()) {
+      FunctionStatement* declaration = pending.back();
+      pending.pop_back();
+      build(*declaration, *indices.find(declaration));
+    }
+    return std::move(errors);
+  }
+
+  auto SsaBuilder::module() noexcept -> ssa::Module& {
+    return built;
+  }
+
+  auto SsaBuilder::operator()(Identifier& arg) noexcept -> std::any {
+    switch(arg.binding.kind) {
+      case Binding::Kind::LOCAL:
+      case Binding::Kind::PARAMETER: return emit({ .op = Opcode::LOAD, .type = lower(typeOf(arg)), .operands = { slot(arg) }, .span = arg.span });
+      case Binding::Kind::CONSTANT: return emit({ .op = Opcode::CONSTANT, .type = ssa::Type::INT, .immediate = arg.binding.slot, .span = arg.span });
+      default: return unsupported(arg.span, "'{}' is not a value"f.format(arg.id));
+    }
+  }
+
+  auto SsaBuilder::operator()(BoolLiteral& arg) noexcept -> std::any {
+    return emit({ .op = Opcode::CONSTANT, .type = ssa::Type::BOOL, .immediate = arg.value.unwrap(), .span = arg.span });
+  }
+
+  auto SsaBuilder::operator()(ObjectLiteral& arg) noexcept -> std::any {
+    if(arg.value.getType() != Token::Type::NUL)
+      return unsupported(arg.span, "Cannot use '{}' outside of a method"f.format(arg.value.getLiteral()));
+    return emit({ .op = Opcode::CONSTANT, .type = ssa::Type::REFERENCE, .span = arg.span });
+  }
+
+  auto SsaBuilder::operator()(StringLiteral& arg) noexcept -> std::any {
+    auto [index, added] = strings.insert(arg.value, (u32)built.strings.size());
+    if(added) built.strings.emplace_back(arg.value);
+    return emit({ .op = Opcode::STRING, .type = ssa::Type::REFERENCE, .immediate = *index, .span = arg.span });
+  }
+
+  auto SsaBuilder::operator()(FloatLiteral& arg) noexcept -> std::any {
+    return emit({ .op = Opcode::CONSTANT, .type = ssa::Type::FLOAT, .immediate = std::bit_cast<i64>(arg.value.unwrap()), .span = arg.span });
+  }
+
+  auto SsaBuilder::operator()(IntLiteral& arg) noexcept -> std::any {
+    return emit({ .op = Opcode::CONSTANT, .type = ssa::Type::INT, .immediate = arg.value.unwrap(), .span = arg.span });
+  }
+
+  auto SsaBuilder::operator()(CharLiteral& arg) noexcept -> std::any {
+    return emit({ .op = Opcode::CONSTANT, .type = ssa::Type::CHAR, .immediate = arg.value.unwrap(), .span = arg.span });
+  }
+
+  auto SsaBuilder::operator()(PrefixExpression& arg) noexcept -> std::any {
+    if(arg.oper == Token::Type::PLUS) return expression(*arg.expr);
+
+    const Value value = expression(*arg.expr);
+    const ssa::Type type = lower(typeOf(arg));
+    switch(arg.oper) {
+      case Token::Type::MINUS:
+        return emit({ .op = type == ssa::Type::FLOAT ? Opcode::FNEG : Opcode::NEG, .type = type, .operands = { value }, .span = arg.span });
+      case Token::Type::NOT:
+        return emit({ .op = Opcode::NOT, .type = ssa::Type::BOOL, .operands = { value }, .span = arg.span });
+      case Token::Type::BIT_NOT:
+        return emit({ .op = Opcode::BIT_NOT, .type = ssa::Type::INT, .operands = { value }, .span = arg.span });
+      default:
+        return unsupported(arg.span, "Cannot run this operator"s);
+    }
+  }
+
+  auto SsaBuilder::operator()(InfixExpression& arg) noexcept -> std::any {
+    if(arg.oper == Token::Type::DOT) return member(arg);
+    if(arg.oper == Token::Type::ASSIGN or Token::compoundOperatorOf(arg.oper) != Token::Type::ILLEGAL) return assign(arg);
+    if(arg.oper == Token::Type::AND or arg.oper == Token::Type::OR) return logical(arg);
+    return binary(arg);
+  }
+
+  auto SsaBuilder::operator()(CallExpression& arg) noexcept -> std::any {
+    Identifier const* name = arg.callee();
+    if(name and name->binding.kind == Binding::Kind::FUNCTION)
+      return call(arg, *static_cast<FunctionStatement*>(name->binding.declaration));
+    if(name and name->binding.kind == Binding::Kind::STRUCT)
+      return construct(arg, arg.span);
+    return unsupported(arg.function->span, "Only functions and structs can be called"s);
+  }
+
+  auto SsaBuilder::operator()(SubscriptExpression& arg) noexcept -> std::any {
+    const bool characters = typeOf(*arg.array) == TypeId::STRING;
+    const Value array = expression(*arg.array);
+    const Value index = expression(*arg.index);
+    return emit({ .op = characters ? Opcode::GET_CHAR : Opcode::GET_ELEM, .type = lower(typeOf(arg)), .operands = { array, index }, .span = arg.span });
+  }
+
+  auto SsaBuilder::operator()(ArrayLiteral& arg) noexcept -> std::any {
+    return construct(arg, arg.span);
+  }
+
+  auto SsaBuilder::operator()(ExpressionStatement& arg) noexcept -> std::any {
+    expression(*arg.expr);
+    return { };
+  }
+
+  auto SsaBuilder::operator()(ReturnStatement& arg) noexcept -> std::any {
+    const Value value = expression(*arg.expr);
+    if(typeOf(*arg.expr) == TypeId::VOID) emit({ .op = Opcode::RETURN, .span = arg.span });
+    else emit({ .op = Opcode::RETURN, .operands = { value }, .span = arg.span });
+    return { };
+  }
+
+  auto SsaBuilder::operator()(PrintStatement& arg) noexcept -> std::any {
+    const TypeId type = typeOf(*arg.expr);
+    const Value value = expression(*arg.expr);
+    if(type != TypeId::VOID) emit({ .op = Opcode::PRINT, .immediate = (i64)type, .operands = { value }, .span = arg.span });
+    return { };
+  }
+
+  auto SsaBuilder::operator()(BlockStatement& arg) noexcept -> std::any {
+    for(auto& stmt : arg) statement(*stmt);
+    return { };
+  }
+
+  auto SsaBuilder::operator()(IfStatement& arg) noexcept -> std::any {
+    const Value condition = expression(*arg.condition);
+    const u32 then = function->add();
+    const u32 otherwise = arg.alternative ? function->add() : ssa::NONE;
+    const u32 join = function->add();
+    emit({ .op = Opcode::BRANCH, .operands = { condition }, .blocks = { then, arg.alternative ? otherwise : join }, .span = arg.span });
+
+    block = then;
+    statement(*arg.block);
+    jump(join, arg.span);
+    if(arg.alternative) {
+      block = otherwise;
+      statement(*arg.alternative);
+      jump(join, arg.span);
+    }
+    block = join;
+    return { };
+  }
+
+  auto SsaBuilder::operator()(WhileStatement& arg) noexcept -> std::any {
+    const u32 header = function->add();
+    const u32 body = function->add();
+    const u32 exit = function->add();
+    jump(header, arg.span);
+
+    block = header;
+    const Value condition = expression(*arg.condition);
+    emit({ .op = Opcode::BRANCH, .operands = { condition }, .blocks = { body, exit }, .span = arg.condition->span });
+
+    block = body;
+    statement(*arg.block);
+    jump(header, arg.span);
+    block = exit;
+    return { };
+  }
+
+  auto SsaBuilder::operator()(ForStatement& arg) noexcept -> std::any {
+    expression(*arg.initializer);
+    const u32 header = function->add();
+    const u32 body = function->add();
+    const u32 exit = function->add();
+    jump(header, arg.span);
+
+    block = header;
+    const Value condition = expression(*arg.condition);
+    emit({ .op = Opcode::BRANCH, .operands = { condition }, .blocks = { body, exit }, .span = arg.condition->span });
+
+    block = body;
+    statement(*arg.block);
+    expression(*arg.modifier);
+    jump(header, arg.span);
+    block = exit;
+    return { };
+  }
+
+  auto SsaBuilder::operator()(DeclarationStatement& arg) noexcept -> std::any {
+    const ssa::Type type = lower(analyzer.typeOf(arg));
+    const Value local = slot(&arg, type, arg.slot, arg.span);
+
+    // * A local declared without a value holds zero or null, like a cleared register
+    const Value value = arg.expr ? expression(*arg.expr) : emit({ .op = Opcode::CONSTANT, .type = type, .span = arg.span });
+    emit({ .op = Opcode::STORE, .operands = { local, value }, .span = arg.span });
+    return { };
+  }
+
+  auto SsaBuilder::index(FunctionStatement& declaration) -> u32 {
+    auto [index, added] = indices.insert(&declaration, (u32)built.functions.size());
+    if(added) {
+      built.functions.emplace_back();
+      pending.push_back(&declaration);
+    }
+    return *index;
+  }
+
+  auto SsaBuilder::build(FunctionStatement& declaration, u32 index) -> void {
+    ssa::Function lowered {
+      .name = declaration.name,
+      .span = declaration.span,
+      .returns = lower(analyzer.typeOf(*declaration.return_type)),
+    };
+    function = &lowered;
+    locals.clear();
+    parameters.clear();
+
+    // * The entry block only sets up the slots, locals add theirs before its jump as they are declared
+    block = lowered.add();
+    for(Member const& parameter : declaration.args) {
+      const ssa::Type type = lower(analyzer.typeOf(*parameter.type));
+      const u32 position = (u32)lowered.parameters.size();
+      lowered.parameters.push_back(type);
+      const Value local = emit({ .op = Opcode::SLOT, .type = type, .immediate = position, .span = declaration.span });
+      const Value value = emit({ .op = Opcode::PARAMETER, .type = type, .immediate = position, .span = declaration.span });
+      emit({ .op = Opcode::STORE, .operands = { local, value }, .span = declaration.span });
+      parameters.push_back(local);
+    }
+    const u32 body = lowered.add();
+    jump(body, declaration.span);
+
+    block = body;
+    statement(*declaration.block);
+    emit({ .op = lowered.returns == ssa::Type::VOID ? Opcode::RETURN : Opcode::FALL_OFF, .span = declaration.span });
+    lowered.compact();
+
+    function = nullptr;
+    built.functions[index] = std::move(lowered);
+  }
+
+  auto SsaBuilder::expression(Expression& expr) noexcept -> Value {
+    std::any result = visit(expr);
+    if(auto* value = std::any_cast<Value>(&result)) return *value;
+    return unsupported(expr.span, "Cannot run this expression"s);
+  }
+
+  auto SsaBuilder::statement(Statement& stmt) noexcept -> void {
+    visit(stmt);
+  }
+
+  auto SsaBuilder::unsupported(Span span, std::string message) noexcept -> Value {
+    errors.emplace_back(std::move(message), span);
+    return emit({ .op = Opcode::CONSTANT, .type = ssa::Type::INT, .span = span });
+  }
+
+  auto SsaBuilder::typeOf(Expression const& expr) const noexcept -> TypeId {
+    return analyzer.typeOf(expr);
+  }
+
+  auto SsaBuilder::lower(TypeId type) const noexcept -> ssa::Type {
+    switch(table.info(type).kind) {
+      case TypeInfo::Kind::INT:
+      case TypeInfo::Kind::ENUM: return ssa::Type::INT;
+      case TypeInfo::Kind::FLOAT: return ssa::Type::FLOAT;
+      case TypeInfo::Kind::BOOL: return ssa::Type::BOOL;
+      case TypeInfo::Kind::CHAR: return ssa::Type::CHAR;
+      case TypeInfo::Kind::STRING:
+      case TypeInfo::Kind::NUL:
+      case TypeInfo::Kind::STRUCT:
+      case TypeInfo::Kind::ARRAY: return ssa::Type::REFERENCE;
+      default: return ssa::Type::VOID;
+    }
+  }
+
+  auto SsaBuilder::emit(ssa::Instruction instruction) -> Value {
+    if(function->terminator(block) != ssa::NONE) block = function->add();
+    return function->append(block, std::move(instruction));
+  }
+
+  auto SsaBuilder::jump(u32 target, Span span) -> void {
+    emit({ .op = Opcode::JUMP, .blocks = { target }, .span = span });
+  }
+
+  auto SsaBuilder::slot(Visitable const* declaration, ssa::Type type, u32 frame, Span span) -> Value {
+    if(Value const* known = locals.find(declaration)) return *known;
+
+    const u32 before = (u32)function->blocks[0].code.size() - 1;
+    const Value local = function->insert(0, before, { .op = Opcode::SLOT, .type = type, .immediate = frame, .span = span });
+    locals.insert(declaration, local);
+    return local;
+  }
+
+  auto SsaBuilder::slot(Identifier const& name) -> Value {
+    if(name.binding.kind == Binding::Kind::PARAMETER) return parameters[name.binding.slot];
+    auto const& declaration = *static_cast<DeclarationStatement const*>(name.binding.declaration);
+    return slot(name.binding.declaration, lower(analyzer.typeOf(declaration)), declaration.slot, declaration.span);
+  }
+
+  auto SsaBuilder::operation(Token::Type oper, TypeId lhs, TypeId rhs) const noexcept -> std::optional<std::pair<Opcode, bool>> {
+    // * Strings are equal by value, other references by identity
+    if(lower(lhs) == ssa::Type::REFERENCE and (oper == Token::Type::EQUALS or oper == Token::Type::NOT_EQ)) {
+      const bool strings = lhs == TypeId::STRING or rhs == TypeId::STRING;
+      const bool equals = oper == Token::Type::EQUALS;
+      return std::pair{ strings ? (equals ? Opcode::SEQ : Opcode::SNE) : (equals ? Opcode::REQ : Opcode::RNE), false };
+    }
+
+    switch(table.info(lhs).kind) {
+      case TypeInfo::Kind::INT:
+      case TypeInfo::Kind::ENUM:
+        switch(oper) {
+          case Token::Type::PLUS: return std::pair{ Opcode::ADD, false };
+          case Token::Type::MINUS: return std::pair{ Opcode::SUB, false };
+          case Token::Type::STAR: return std::pair{ Opcode::MUL, false };
+          case Token::Type::SLASH: return std::pair{ Opcode::DIV, false };
+          case Token::Type::MODULO: return std::pair{ Opcode::MOD, false };
+          case Token::Type::BIT_AND: return std::pair{ Opcode::BIT_AND, false };
+          case Token::Type::BIT_OR: return std::pair{ Opcode::BIT_OR, false };
+          case Token::Type::LSHIFT: return std::pair{ Opcode::SHL, false };
+          case Token::Type::RSHIFT: return std::pair{ Opcode::SHR, false };
+          default: return ordered(oper, false);
+        }
+      case TypeInfo::Kind::FLOAT:
+        switch(oper) {
+          case Token::Type::PLUS: return std::pair{ Opcode::FADD, false };
+          case Token::Type::MINUS: return std::pair{ Opcode::FSUB, false };
+          case Token::Type::STAR: return std::pair{ Opcode::FMUL, false };
+          case Token::Type::SLASH: return std::pair{ Opcode::FDIV, false };
+          default: return ordered(oper, true);
+        }
+      case TypeInfo::Kind::STRING:
+        if(oper != Token::Type::PLUS) return std::nullopt;
+        return std::pair{ Opcode::CONCAT, false };
+      case TypeInfo::Kind::BOOL:
+        if(oper != Token::Type::EQUALS and oper != Token::Type::NOT_EQ) return std::nullopt;
+        return ordered(oper, false);
+      case TypeInfo::Kind::CHAR:
+        return ordered(oper, false);
+      default:
+        return std::nullopt;
+    }
+  }
+
+  auto SsaBuilder::call(CallExpression& arg, FunctionStatement& callee) noexcept -> Value {
+    const u32 target = index(callee);
+    std::vector<Value> arguments;
+    for(auto& value : arg) arguments.push_back(expression(*value));
+    return emit({ .op = Opcode::CALL, .type = lower(typeOf(arg)), .immediate = target, .operands = std::move(arguments), .span = arg.span });
+  }
+
+  auto SsaBuilder::construct(Container<Box<Expression>>& values, Span span) noexcept -> Value {
+    const Value object = emit({ .op = Opcode::NEW, .type = ssa::Type::REFERENCE, .immediate = (i64)values.size(), .span = span });
+    for(u32 i = 0; i < values.size(); ++i) {
+      const bool stored = typeOf(*values[i]) != TypeId::VOID;
+      const Value value = expression(*values[i]);
+      if(stored) emit({ .op = Opcode::SET_FIELD, .immediate = i, .operands = { object, value }, .span = values[i]->span });
+    }
+    return object;
+  }
+
+  auto SsaBuilder::member(InfixExpression& arg) noexcept -> Value {
+    auto* object = dynamic_cast<Identifier*>(arg.lhs.get());
+    auto* name = dynamic_cast<Identifier*>(arg.rhs.get());
+    if(not name) return unsupported(arg.span, "Cannot run this expression"s);
+
+    // * Enum constants and namespace members are resolved already, only fields are read at run time
+    if(object and (object->binding.kind == Binding::Kind::ENUM or object->binding.kind == Binding::Kind::NAMESPACE))
+      return expression(*name);
+
+    const Value structure = expression(*arg.lhs);
+    return emit({ .op = Opcode::GET_FIELD, .type = lower(typeOf(arg)), .immediate = name->binding.slot, .operands = { structure }, .span = arg.lhs->span });
+  }
+
+  auto SsaBuilder::binary(InfixExpression& arg) noexcept -> Value {
+    const std::optional<std::pair<Opcode, bool>> op = operation(arg.oper, typeOf(*arg.lhs), typeOf(*arg.rhs));
+    if(not op) return unsupported(arg.span, "Cannot run this operator"s);
+
+    const Value left = expression(*arg.lhs);
+    const Value right = expression(*arg.rhs);
+    auto [opcode, swapped] = *op;
+    return emit({
+      .op = opcode, .type = lower(typeOf(arg)),
+      .operands = { swapped ? right : left, swapped ? left : right }, .span = arg.span,
+    });
+  }
+
+  auto SsaBuilder::logical(InfixExpression& arg) noexcept -> Value {
+    // * 'a and b' is a when a is false, 'a or b' is a when a is true, b otherwise
+    const Value left = expression(*arg.lhs);
+    const u32 rest = function->add();
+    const u32 join = function->add();
+    const bool conjunction = arg.oper == Token::Type::AND;
+    emit({ .op = Opcode::BRANCH, .operands = { left }, .blocks = { conjunction ? rest : join, conjunction ? join : rest }, .span = arg.span });
+    const u32 from = block;
+
+    block = rest;
+    const Value right = expression(*arg.rhs);
+    jump(join, arg.span);
+    const u32 to = block;
+
+    block = join;
+    return emit({ .op = Opcode::PHI, .type = ssa::Type::BOOL, .operands = { left, right }, .blocks = { from, to }, .span = arg.span });
+  }
+
+  auto SsaBuilder::assign(InfixExpression& arg) noexcept -> Value {
+    if(auto* subscript = dynamic_cast<SubscriptExpression*>(arg.lhs.get()); subscript and typeOf(*subscript->array) == TypeId::STRING)
+      return unsupported(arg.lhs->span, "Characters of a string cannot be assigned"s);
+
+    const ssa::Type type = lower(typeOf(*arg.lhs));
+    const Token::Type oper = Token::compoundOperatorOf(arg.oper);
+    std::optional<std::pair<Opcode, bool>> op;
+    if(oper != Token::Type::ILLEGAL) {
+      op = operation(oper, typeOf(*arg.lhs), typeOf(*arg.rhs));
+      if(not op) return unsupported(arg.span, "Cannot run this assignment"s);
+    }
+
+    // * A compound assignment reads its target after its value, like the other backends
+    const auto combine = [&](Value current, Value value) {
+      return emit({ .op = op->first, .type = type, .operands = { current, value }, .span = arg.span });
+    };
+
+    if(auto* name = dynamic_cast<Identifier*>(arg.lhs.get())) {
+      const Value local = slot(*name);
+      Value value = expression(*arg.rhs);
+      if(op) value = combine(emit({ .op = Opcode::LOAD, .type = type, .operands = { local }, .span = name->span }), value);
+      emit({ .op = Opcode::STORE, .operands = { local, value }, .span = arg.span });
+      return value;
+    }
+
+    if(auto* access = dynamic_cast<InfixExpression*>(arg.lhs.get())) {
+      const i64 field = static_cast<Identifier&>(*access->rhs).binding.slot;
+      const Value structure = expression(*access->lhs);
+      Value value = expression(*arg.rhs);
+      if(op) value = combine(emit({ .op = Opcode::GET_FIELD, .type = type, .immediate = field, .operands = { structure }, .span = access->lhs->span }), value);
+      emit({ .op = Opcode::SET_FIELD, .immediate = field, .operands = { structure, value }, .span = access->lhs->span });
+      return value;
+    }
+
+    auto& subscript = static_cast<SubscriptExpression&>(*arg.lhs);
+    const Value array = expression(*subscript.array);
+    const Value index = expression(*subscript.index);
+    Value value = expression(*arg.rhs);
+    if(op) value = combine(emit({ .op = Opcode::GET_ELEM, .type = type, .operands = { array, index }, .span = subscript.span }), value);
+    emit({ .op = Opcode::SET_ELEM, .operands = { array, index, value }, .span = subscript.span });
+    return value;
+  }
+
+}
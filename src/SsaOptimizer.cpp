@@ -0,0 +1,592 @@
+#include "SsaOptimizer.hpp"
+
+namespace fridayc {
+
+  using ssa::Opcode;
+  using ssa::Value;
+  using ssa::Instruction;
+  using ssa::NONE;
+
+  namespace {
+
+    /// @brief Value of an operation on the bits of constant operands, std::nullopt if it faults or is not folded
+    auto fold(Opcode op, i64 a, i64 b) noexcept -> std::optional<i64> {
+      const f64 x = std::bit_cast<f64>(a), y = std::bit_cast<f64>(b);
+      i64 result = 0;
+      switch(op) {
+        case Opcode::ADD: if(__builtin_add_overflow(a, b, &result)) return std::nullopt; return result;
+        case Opcode::SUB: if(__builtin_sub_overflow(a, b, &result)) return std::nullopt; return result;
+        case Opcode::MUL: if(__builtin_mul_overflow(a, b, &result)) return std::nullopt; return result;
+        case Opcode::DIV:
+          if(b == 0 or (a == std::numeric_limits<i64>::min() and b == -1)) return std::nullopt;
+          return a / b;
+        case Opcode::MOD:
+          if(b == 0 or (a == std::numeric_limits<i64>::min() and b == -1)) return std::nullopt;
+          return a % b;
+        case Opcode::BIT_AND: return a & b;
+        case Opcode::BIT_OR: return a | b;
+        case Opcode::SHL:
+          if((u64)b >= 64) return std::nullopt;
+          result = static_cast<i64>(static_cast<u64>(a) << b);
+          if(result >> b != a) return std::nullopt;
+          return result;
+        case Opcode::SHR:
+          if((u64)b >= 64) return std::nullopt;
+          return a >> b;
+        case Opcode::NEG:
+          if(a == std::numeric_limits<i64>::min()) return std::nullopt;
+          return -a;
+        case Opcode::BIT_NOT: return ~a;
+        case Opcode::FADD: return std::bit_cast<i64>(x + y);
+        case Opcode::FSUB: return std::bit_cast<i64>(x - y);
+        case Opcode::FMUL: return std::bit_cast<i64>(x * y);
+        case Opcode::FDIV:
+          if(y == 0.) return std::nullopt;
+          return std::bit_cast<i64>(x / y);
+        case Opcode::FNEG: return std::bit_cast<i64>(-x);
+        case Opcode::EQ: return a == b;
+        case Opcode::NE: return a != b;
+        case Opcode::LT: return a < b;
+        case Opcode::LE: return a <= b;
+        case Opcode::FEQ: return x == y;
+        case Opcode::FNE: return x != y;
+        case Opcode::FLT: return x < y;
+        case Opcode::FLE: return x <= y;
+        case Opcode::NOT: return a == 0;
+        default: return std::nullopt;
+      }
+    }
+
+    /// @brief Takes instructions out of their blocks, compact() then drops them
+    auto sweep(ssa::Function& function, std::vector<bool> const& removed) -> void {
+      for(ssa::Block& block : function.blocks)
+        std::erase_if(block.code, [&](Value value) {
+          if(value >= removed.size() or not removed[value]) return false;
+          function.values[value].block = NONE;
+          return true;
+        });
+    }
+
+    /// @brief Adds a constant at the start of the entry block, where it dominates every use
+    auto materialize(ssa::Function& function, ssa::Type type, i64 bits, Span span) -> Value {
+      return function.insert(0, 0, { .op = Opcode::CONSTANT, .type = type, .immediate = bits, .span = span });
+    }
+
+    /// @brief A block of a walk over the dominator tree, entered then left once its subtree is done
+    struct Visit {
+      u32  block   { 0 };
+      u64  mark    { 0 };
+      bool leaving { false };
+    };
+
+  }
+
+  auto SsaOptimizer::optimize(ssa::Module& module, bool verify) -> std::vector<Error> {
+    using Pass = auto (SsaOptimizer::*)(ssa::Function&) -> void;
+    const std::array<std::pair<std::string_view, Pass>, 5> pipeline = {{
+      { "mem2reg"sv, &SsaOptimizer::promote },
+      { "constant propagation"sv, &SsaOptimizer::propagate },
+      { "value numbering"sv, &SsaOptimizer::number },
+      { "dead code elimination"sv, &SsaOptimizer::eliminate },
+      { "CFG simplification"sv, &SsaOptimizer::simplify },
+    }};
+
+    for(auto [name, pass] : pipeline) {
+      for(ssa::Function& function : module.functions) (this->*pass)(function);
+      if(not verify) continue;
+
+      std::vector<Error> errors = module.verify();
+      for(Error& error : errors) error.message = "{} after {}"f.format(error.message, name);
+      if(not errors.empty()) return errors;
+    }
+    return { };
+  }
+
+  auto SsaOptimizer::promotedSlots() const noexcept -> u64 {
+    return slots;
+  }
+
+  auto SsaOptimizer::placedPhis() const noexcept -> u64 {
+    return phis;
+  }
+
+  auto SsaOptimizer::foldedValues() const noexcept -> u64 {
+    return folds;
+  }
+
+  auto SsaOptimizer::foldedBranches() const noexcept -> u64 {
+    return branches;
+  }
+
+  auto SsaOptimizer::numberedValues() const noexcept -> u64 {
+    return redundancies;
+  }
+
+  auto SsaOptimizer::removedValues() const noexcept -> u64 {
+    return removals;
+  }
+
+  auto SsaOptimizer::removedBlocks() const noexcept -> u64 {
+    return merges;
+  }
+
+  auto SsaOptimizer::promote(ssa::Function& function) -> void {
+    if(function.blocks.empty()) return;
+
+    // * A slot is promoted when it is only loaded from and stored to, never stored itself
+    const auto uses = function.uses();
+    std::vector<u32> promoted(function.values.size(), NONE);
+    std::vector<Value> promotable;
+    for(const Value value : function.blocks[0].code) {
+      if(function.values[value].op != Opcode::SLOT) continue;
+      const bool direct = std::ranges::all_of(uses[value], [&](Value use) {
+        Instruction const& user = function.values[use];
+        return user.op == Opcode::LOAD or (user.op == Opcode::STORE and user.operands[1] != value);
+      });
+      if(not direct) continue;
+      promoted[value] = (u32)promotable.size();
+      promotable.push_back(value);
+    }
+    if(promotable.empty()) return;
+
+    const ssa::Dominators tree = function.dominators();
+    const auto predecessors = function.predecessors();
+    std::vector<std::vector<u32>> frontier(function.blocks.size());
+    for(const u32 block : tree.order) {
+      if(predecessors[block].size() < 2) continue;
+      for(const u32 predecessor : predecessors[block])
+        for(u32 runner = predecessor; tree.idom[runner] != NONE and runner != tree.idom[block]; runner = tree.idom[runner]) {
+          if(std::ranges::find(frontier[runner], block) == frontier[runner].end()) frontier[runner].push_back(block);
+          if(runner == 0) break;
+        }
+    }
+
+    // * Phis go to the iterated dominance frontier of the blocks storing to the slot
+    std::vector<u32> owner(function.values.size(), NONE);
+    for(u32 k = 0; k < promotable.size(); ++k) {
+      std::vector<bool> placed(function.blocks.size(), false), queued(function.blocks.size(), false);
+      std::vector<u32> work;
+      for(const Value use : uses[promotable[k]])
+        if(Instruction const& store = function.values[use]; store.op == Opcode::STORE and not queued[store.block]) {
+          queued[store.block] = true;
+          work.push_back(store.block);
+        }
+
+      while(not work.empty()) {
+        const u32 block = work.back();
+        work.pop_back();
+        for(const u32 join : frontier[block]) {
+          if(placed[join]) continue;
+          placed[join] = true;
+          Instruction const& slot = function.values[promotable[k]];
+          const Value phi = function.insert(join, 0, { .op = Opcode::PHI, .type = slot.type, .span = slot.span });
+          owner.resize(function.values.size(), NONE);
+          owner[phi] = k;
+          ++phis;
+          if(not queued[join]) {
+            queued[join] = true;
+            work.push_back(join);
+          }
+        }
+      }
+    }
+
+    // * Loads before any store read the zero of the type, what a slot starts with
+    std::array<Value, 6> zeros;
+    zeros.fill(NONE);
+    for(const Value slot : promotable) {
+      const ssa::Type type = function.values[slot].type;
+      if(zeros[(u64)type] == NONE) zeros[(u64)type] = materialize(function, type, 0, function.values[slot].span);
+    }
+
+    // * Renaming walks the dominator tree with the value every slot holds, restored on the way back up
+    std::vector<Value> current(promotable.size(), NONE);
+    std::vector<std::pair<u32, Value>> log;
+    std::vector<Value> replacement(function.values.size(), NONE);
+    std::vector<bool> removed(function.values.size(), false);
+    const auto reaching = [&](u32 k) {
+      return current[k] != NONE ? current[k] : zeros[(u64)function.values[promotable[k]].type];
+    };
+
+    std::vector<Visit> stack { { 0, 0, false } };
+    while(not stack.empty()) {
+      const Visit visit = stack.back();
+      stack.pop_back();
+      if(visit.leaving) {
+        for(; log.size() > visit.mark; log.pop_back()) current[log.back().first] = log.back().second;
+        continue;
+      }
+      stack.push_back({ visit.block, log.size(), true });
+
+      for(const Value value : function.blocks[visit.block].code) {
+        Instruction const& instruction = function.values[value];
+        if(instruction.op == Opcode::PHI and owner[value] != NONE) {
+          log.emplace_back(owner[value], current[owner[value]]);
+          current[owner[value]] = value;
+        } else if(instruction.op == Opcode::LOAD and promoted[instruction.operands[0]] != NONE) {
+          replacement[value] = reaching(promoted[instruction.operands[0]]);
+          removed[value] = true;
+        } else if(instruction.op == Opcode::STORE and promoted[instruction.operands[0]] != NONE) {
+          const u32 k = promoted[instruction.operands[0]];
+          log.emplace_back(k, current[k]);
+          current[k] = instruction.operands[1];
+          removed[value] = true;
+        }
+      }
+
+      const std::vector<u32> successors(function.successors(visit.block).begin(), function.successors(visit.block).end());
+      for(const u32 successor : successors)
+        for(const Value value : function.blocks[successor].code) {
+          if(function.values[value].op != Opcode::PHI) break;
+          if(owner[value] == NONE) continue;
+          function.values[value].operands.push_back(reaching(owner[value]));
+          function.values[value].blocks.push_back(visit.block);
+        }
+
+      for(const u32 child : tree.children[visit.block]) stack.push_back({ child, 0, false });
+    }
+
+    for(const Value slot : promotable) removed[slot] = true;
+    sweep(function, removed);
+    function.replace(replacement);
+    function.compact();
+    slots += promotable.size();
+  }
+
+  auto SsaOptimizer::propagate(ssa::Function& function) -> void {
+    enum struct Level : u8 { UNKNOWN, CONSTANT, VARYING };
+    struct Lattice {
+      Level level { Level::UNKNOWN };
+      i64   bits  { 0 };
+    };
+
+    if(function.blocks.empty()) return;
+    const auto uses = function.uses();
+    std::vector<Lattice> cells(function.values.size());
+    std::vector<bool> reached(function.blocks.size(), false);
+    std::set<std::pair<u32, u32>> executable;
+    std::vector<std::pair<u32, u32>> flow { { NONE, 0 } };
+    std::vector<Value> work;
+
+    // * Cells only go down the lattice, a constant that changes is varying
+    const auto lower = [&](Value value, Lattice cell) {
+      Lattice& known = cells[value];
+      if(known.level == Level::CONSTANT and cell.level == Level::CONSTANT and known.bits != cell.bits) cell.level = Level::VARYING;
+      if(cell.level <= known.level) return;
+      known = cell;
+      work.push_back(value);
+    };
+
+    const auto evaluate = [&](Value value) {
+      Instruction const& instruction = function.values[value];
+      switch(instruction.op) {
+        case Opcode::PHI: {
+          Lattice meet;
+          for(u32 k = 0; k < instruction.operands.size(); ++k) {
+            if(not executable.contains({ instruction.blocks[k], instruction.block })) continue;
+            Lattice const& incoming = cells[instruction.operands[k]];
+            if(incoming.level == Level::UNKNOWN) continue;
+            if(meet.level == Level::UNKNOWN) meet = incoming;
+            else if(incoming.level == Level::VARYING or incoming.bits != meet.bits) meet.level = Level::VARYING;
+          }
+          if(meet.level != Level::UNKNOWN) lower(value, meet);
+          return;
+        }
+        case Opcode::JUMP:
+          flow.emplace_back(instruction.block, instruction.blocks[0]);
+          return;
+        case Opcode::BRANCH: {
+          Lattice const& condition = cells[instruction.operands[0]];
+          if(condition.level == Level::VARYING or condition.bits) flow.emplace_back(instruction.block, instruction.blocks[0]);
+          if(condition.level == Level::VARYING or (condition.level == Level::CONSTANT and not condition.bits)) flow.emplace_back(instruction.block, instruction.blocks[1]);
+          return;
+        }
+        case Opcode::CONSTANT:
+          lower(value, instruction.type == ssa::Type::REFERENCE ? Lattice{ Level::VARYING } : Lattice{ Level::CONSTANT, instruction.immediate });
+          return;
+        default:
+          break;
+      }
+
+      if(not ssa::pure(instruction.op) or instruction.op == Opcode::PARAMETER or instruction.op == Opcode::STRING or instruction.type == ssa::Type::VOID)
+        return lower(value, { Level::VARYING });
+
+      std::array<i64, 2> bits { };
+      for(u32 k = 0; k < instruction.operands.size(); ++k) {
+        Lattice const& operand = cells[instruction.operands[k]];
+        if(operand.level == Level::VARYING) return lower(value, { Level::VARYING });
+        if(operand.level == Level::UNKNOWN) return;
+        bits[k] = operand.bits;
+      }
+      const std::optional<i64> folded = fold(instruction.op, bits[0], bits[1]);
+      lower(value, folded ? Lattice{ Level::CONSTANT, *folded } : Lattice{ Level::VARYING });
+    };
+
+    while(not flow.empty() or not work.empty()) {
+      while(not flow.empty()) {
+        const auto [from, to] = flow.back();
+        flow.pop_back();
+        if(from != NONE and not executable.insert({ from, to }).second) continue;
+
+        // * A block is evaluated whole when first reached, only its phis gain an operand from another edge
+        const bool first = not reached[to];
+        reached[to] = true;
+        for(const Value value : function.blocks[to].code) {
+          if(not first and function.values[value].op != Opcode::PHI) break;
+          evaluate(value);
+        }
+      }
+
+      while(not work.empty() and flow.empty()) {
+        const Value value = work.back();
+        work.pop_back();
+        for(const Value use : uses[value])
+          if(reached[function.values[use].block]) evaluate(use);
+      }
+    }
+
+    // * Constants are materialized once the walk is done, inserting them would move the code it walks
+    std::vector<std::pair<Value, Lattice>> constants;
+    std::vector<bool> removed(function.values.size(), false);
+    for(u32 block = 0; block < function.blocks.size(); ++block) {
+      if(not reached[block]) continue;
+      for(const Value value : function.blocks[block].code) {
+        Instruction& instruction = function.values[value];
+        if(instruction.op == Opcode::BRANCH and cells[instruction.operands[0]].level == Level::CONSTANT) {
+          const u32 taken = instruction.blocks[cells[instruction.operands[0]].bits ? 0 : 1];
+          instruction = { .op = Opcode::JUMP, .block = block, .blocks = { taken }, .span = instruction.span };
+          ++branches;
+        } else if(cells[value].level == Level::CONSTANT and instruction.op != Opcode::CONSTANT and instruction.type != ssa::Type::VOID) {
+          constants.emplace_back(value, cells[value]);
+          removed[value] = true;
+        }
+      }
+    }
+
+    std::vector<Value> replacement(function.values.size(), NONE);
+    std::map<std::pair<ssa::Type, i64>, Value> materialized;
+    for(auto const& [value, cell] : constants) {
+      const ssa::Type type = function.values[value].type;
+      auto [known, added] = materialized.try_emplace({ type, cell.bits }, NONE);
+      if(added) known->second = materialize(function, type, cell.bits, function.values[value].span);
+      replacement[value] = known->second;
+      ++folds;
+    }
+
+    sweep(function, removed);
+    function.replace(replacement);
+    function.compact();
+  }
+
+  auto SsaOptimizer::number(ssa::Function& function) -> void {
+    using Key = std::tuple<Opcode, ssa::Type, i64, std::vector<Value>>;
+
+    if(function.blocks.empty()) return;
+    const ssa::Dominators tree = function.dominators();
+    std::vector<Value> replacement(function.values.size(), NONE);
+    std::vector<bool> removed(function.values.size(), false);
+    std::map<Key, Value> available;
+    std::vector<std::map<Key, Value>::iterator> log;
+
+    // * Values are looked up in the scope of the blocks dominating theirs, so an equal value found is always defined first
+    std::vector<Visit> stack { { 0, 0, false } };
+    while(not stack.empty()) {
+      const Visit visit = stack.back();
+      stack.pop_back();
+      if(visit.leaving) {
+        for(; log.size() > visit.mark; log.pop_back()) available.erase(log.back());
+        continue;
+      }
+      stack.push_back({ visit.block, log.size(), true });
+
+      for(const Value value : function.blocks[visit.block].code) {
+        Instruction const& instruction = function.values[value];
+        if(not ssa::pure(instruction.op)) continue;
+
+        std::vector<Value> operands;
+        for(Value operand : instruction.operands) {
+          while(replacement[operand] != NONE) operand = replacement[operand];
+          operands.push_back(operand);
+        }
+        if(ssa::commutes(instruction.op)) std::ranges::sort(operands);
+
+        auto [known, added] = available.try_emplace({ instruction.op, instruction.type, instruction.immediate, std::move(operands) }, value);
+        if(added) log.push_back(known);
+        else {
+          replacement[value] = known->second;
+          removed[value] = true;
+          ++redundancies;
+        }
+      }
+
+      for(const u32 child : tree.children[visit.block]) stack.push_back({ child, 0, false });
+    }
+
+    sweep(function, removed);
+    function.replace(replacement);
+    function.compact();
+  }
+
+  auto SsaOptimizer::eliminate(ssa::Function& function) -> void {
+    // * What changes memory, prints, calls, may fault or ends a block is live, and so is everything it reads
+    std::vector<bool> live(function.values.size(), false);
+    std::vector<Value> work;
+    for(ssa::Block const& block : function.blocks)
+      for(const Value value : block.code) {
+        const Opcode op = function.values[value].op;
+        if(not ssa::terminates(op) and not ssa::writes(op) and not ssa::faults(op)) continue;
+        live[value] = true;
+        work.push_back(value);
+      }
+
+    while(not work.empty()) {
+      const Value value = work.back();
+      work.pop_back();
+      for(const Value operand : function.values[value].operands)
+        if(not live[operand]) {
+          live[operand] = true;
+          work.push_back(operand);
+        }
+    }
+
+    std::vector<bool> removed(function.values.size(), false);
+    for(ssa::Block const& block : function.blocks)
+      for(const Value value : block.code)
+        if(not live[value]) {
+          removed[value] = true;
+          ++removals;
+        }
+    sweep(function, removed);
+    function.compact();
+  }
+
+  auto SsaOptimizer::simplify(ssa::Function& function) -> void {
+    // * Every rewrite changes the edges, so the function is compacted and scanned again after each round
+    for(bool changed = true; changed;) {
+      changed = false;
+      std::vector<Value> replacement(function.values.size(), NONE);
+      std::vector<bool> removed(function.values.size(), false);
+
+      // * Branches on a constant or to a single block become jumps
+      for(u32 block = 0; block < function.blocks.size(); ++block) {
+        const Value last = function.terminator(block);
+        if(last == NONE or function.values[last].op != Opcode::BRANCH) continue;
+        Instruction& branch = function.values[last];
+        Instruction const& condition = function.values[branch.operands[0]];
+
+        u32 taken = NONE;
+        if(condition.op == Opcode::CONSTANT) taken = branch.blocks[condition.immediate ? 0 : 1];
+        else if(branch.blocks[0] == branch.blocks[1]) {
+          // * Both edges merge into one, which the phis of the target must agree on
+          bool agree = true;
+          for(const Value value : function.blocks[branch.blocks[0]].code) {
+            Instruction const& phi = function.values[value];
+            if(phi.op != Opcode::PHI) break;
+            std::vector<Value> incoming;
+            for(u32 k = 0; k < phi.blocks.size(); ++k) if(phi.blocks[k] == block) incoming.push_back(phi.operands[k]);
+            agree = agree and std::ranges::adjacent_find(incoming, std::not_equal_to{ }) == incoming.end();
+          }
+          if(agree) taken = branch.blocks[0];
+        }
+        if(taken == NONE) continue;
+
+        branch = { .op = Opcode::JUMP, .block = block, .blocks = { taken }, .span = branch.span };
+        ++branches;
+        changed = true;
+      }
+
+      // * A phi whose operands are all one value, or itself, is that value
+      for(ssa::Block const& block : function.blocks)
+        for(const Value value : block.code) {
+          Instruction const& phi = function.values[value];
+          if(phi.op != Opcode::PHI) break;
+
+          Value unique = NONE;
+          bool trivial = true;
+          for(Value operand : phi.operands) {
+            while(replacement[operand] != NONE) operand = replacement[operand];
+            if(operand == value or operand == unique) continue;
+            trivial = trivial and unique == NONE;
+            unique = operand;
+          }
+          if(not trivial or unique == NONE) continue;
+          replacement[value] = unique;
+          removed[value] = true;
+          changed = true;
+        }
+
+      if(changed) {
+        sweep(function, removed);
+        function.replace(replacement);
+        function.compact();
+        continue;
+      }
+
+      const auto predecessors = function.predecessors();
+      for(u32 block = 0; block < function.blocks.size() and not changed; ++block) {
+        const Value last = function.terminator(block);
+        if(last == NONE or function.values[last].op != Opcode::JUMP) continue;
+        const u32 target = function.values[last].blocks[0];
+
+        // * A block jumping to a block only it reaches takes over its code, phis there have a single operand
+        if(target != 0 and target != block and predecessors[target].size() == 1) {
+          function.blocks[block].code.pop_back();
+          function.values[last].block = NONE;
+          for(const Value value : function.blocks[target].code) {
+            Instruction& instruction = function.values[value];
+            if(instruction.op == Opcode::PHI) {
+              replacement[value] = instruction.operands[0];
+              instruction.block = NONE;
+              continue;
+            }
+            instruction.block = block;
+            function.blocks[block].code.push_back(value);
+          }
+          function.blocks[target].code.clear();
+
+          for(const u32 successor : function.successors(block))
+            for(const Value value : function.blocks[successor].code) {
+              if(function.values[value].op != Opcode::PHI) break;
+              std::ranges::replace(function.values[value].blocks, target, block);
+            }
+          ++merges;
+          changed = true;
+          continue;
+        }
+
+        // * Edges into a block that only jumps go straight to its target, unless they would duplicate an edge its phis tell apart
+        if(block == 0 or target == block or function.blocks[block].code.size() != 1) continue;
+        std::vector<u32> sources = predecessors[block];
+        std::ranges::sort(sources);
+        const auto [first, end] = std::ranges::unique(sources);
+        sources.erase(first, end);
+
+        u32 routed = 0;
+        for(const u32 source : sources) {
+          if(source == block or std::ranges::find(predecessors[target], source) != predecessors[target].end()) continue;
+          for(u32& successor : function.values[function.terminator(source)].blocks) {
+            if(successor != block) continue;
+            successor = target;
+            for(const Value value : function.blocks[target].code) {
+              Instruction& phi = function.values[value];
+              if(phi.op != Opcode::PHI) break;
+              const auto incoming = std::ranges::find(phi.blocks, block);
+              const Value operand = phi.operands[incoming - phi.blocks.begin()];
+              phi.operands.push_back(operand);
+              phi.blocks.push_back(source);
+            }
+          }
+          ++routed;
+          changed = true;
+        }
+        if(routed == sources.size()) ++merges;
+      }
+
+      if(changed) {
+        function.replace(replacement);
+        function.compact();
+      }
+    }
+  }
+
+}
@@ -101,18 +101,19 @@ namespace fridayc {
       return visitor.visit(*this);
     }
 
-    StructStatement::StructStatement(std::string name) noexcept 
-      : name { std::move(name) }
+    StructStatement::StructStatement(Symbol name) noexcept 
+      : name { name }
     {}
 
     auto StructStatement::toString() const noexcept -> std::string {
       return std::format(
-        "{{\"type\": \"StructStatement\", \"fields\": [{}]}}", 
+        "{{\"type\": \"StructStatement\", \"name\": \"{}\", \"fields\": [{}]}}", 
+        name,
         std::ranges::to<std::string>(
           fields
-          | std::views::transform([](auto const& pair) { 
+          | std::views::transform([](Member const& field) { 
             return "{{\"type\": \"Field\", \"identifier\": \"{}\", \"datatype\": {}}}"f
-            .format(pair.first, pair.second->toString());
+            .format(field.name, field.type->toString());
           })
           | std::views::join_with(", "s)
         )
@@ -123,16 +124,17 @@ namespace fridayc {
       return visitor.visit(*this);
     }
 
-    EnumStatement::EnumStatement(std::string name) noexcept 
-      : name { std::move(name) }
+    EnumStatement::EnumStatement(Symbol name) noexcept 
+      : name { name }
     {}
 
     auto EnumStatement::toString() const noexcept -> std::string {
       return std::format(
-        "{{\"type\": \"EnumStatement\", \"constants\": [{}]}}", 
+        "{{\"type\": \"EnumStatement\", \"name\": \"{}\", \"constants\": [{}]}}", 
+        name,
         std::ranges::to<std::string>(
           *this 
-          | std::views::transform([](std::string constant) { return '"' + constant + '"'; })
+          | std::views::transform([](Symbol constant) { return "\"{}\""f.format(constant); })
           | std::views::join_with(", "s)
         )
       );
@@ -142,21 +144,23 @@ namespace fridayc {
       return visitor.visit(*this);
     }
 
-    FunctionStatement::FunctionStatement(std::string name) noexcept
-      : name { std::move(name) }
+    FunctionStatement::FunctionStatement(Symbol name) noexcept
+      : name { name }
     {}
       
     auto FunctionStatement::toString() const noexcept -> std::string {
       return std::format(
-        "{{\"type\": \"FunctionStatement\", \"args\": [{}], \"block\": {}}}", 
+        "{{\"type\": \"FunctionStatement\", \"name\": \"{}\", \"args\": [{}], \"return_type\": {}, \"block\": {}}}", 
+        name,
         std::ranges::to<std::string>(
           args
-          | std::views::transform([](auto const& pair) { 
+          | std::views::transform([](Member const& arg) { 
             return "{{\"type\": \"Parameter\", \"identifier\": \"{}\", \"datatype\": {}}}"f
-            .format(pair.first, pair.second->toString());
+            .format(arg.name, arg.type->toString());
           })
           | std::views::join_with(", "s)
         ),
+        return_type->toString(),
         block->toString()
       );
     }
@@ -165,13 +169,13 @@ namespace fridayc {
       return visitor.visit(*this);
     }
     
-    NamespaceStatement::NamespaceStatement(std::string name) noexcept 
-      : name { std::move(name) }
+    NamespaceStatement::NamespaceStatement(Symbol name) noexcept 
+      : name { name }
     {}
 
     auto NamespaceStatement::toString() const noexcept -> std::string {
       return std::format(
-        "{{\"type\": \"NamespaceStatement\", \"name\": {}}}", 
+        "{{\"type\": \"NamespaceStatement\", \"name\": \"{}\"}}", 
         name
       );
     }
@@ -180,13 +184,13 @@ namespace fridayc {
       return visitor.visit(*this);
     }
     
-    UsingStatement::UsingStatement(std::string name) noexcept 
-      : name { std::move(name) }
+    UsingStatement::UsingStatement(Symbol name) noexcept 
+      : name { name }
     {}
 
     auto UsingStatement::toString() const noexcept -> std::string {
       return std::format(
-        "{{\"type\": \"UsingStatement\", \"identifier\": {}}}", 
+        "{{\"type\": \"UsingStatement\", \"identifier\": \"{}\"}}", 
         name
       );
     }
@@ -195,8 +199,8 @@ namespace fridayc {
       return visitor.visit(*this);
     }
 
-    DeclarationStatement::DeclarationStatement(std::string id, Box<Expression> expr, Box<TypeExpression> type, bool constant) noexcept
-      : id { std::move(id) }
+    DeclarationStatement::DeclarationStatement(Symbol id, Box<Expression> expr, Box<TypeExpression> type, bool constant) noexcept
+      : id { id }
       , type { std::move(type) }
       , expr { std::move(expr) }
       , constant { constant }
@@ -0,0 +1,143 @@
+#include "String.hpp"
+
+namespace fridayc::runtime {
+
+  String::Node::~Node() noexcept {
+    release(std::move(left));
+    release(std::move(right));
+  }
+
+  String::String(std::string_view text)
+    : size { text.size() }
+  {
+    if(size <= SMALL) std::ranges::copy(text, bytes.begin());
+    else {
+      auto buffer = std::make_shared<Buffer>(std::make_unique_for_overwrite<i8[]>(size), size, size);
+      std::ranges::copy(text, buffer->bytes.get());
+      shared = std::move(buffer);
+      storage = Storage::FLAT;
+    }
+  }
+
+  String::String(std::shared_ptr<Buffer> buffer, u64 size) noexcept
+    : shared { std::move(buffer) }
+    , size { size }
+    , storage { Storage::FLAT }
+  {}
+
+  auto String::intern(std::string_view text) -> String {
+    if(text.size() <= SMALL) return String(text);
+
+    String result;
+    result.size = text.size();
+    result.symbol = Symbol::intern(text);
+    result.storage = Storage::INTERNED;
+    return result;
+  }
+
+  auto operator+(String const& lhs, String const& rhs) -> String {
+    if(rhs.empty()) return lhs;
+    if(lhs.empty()) return rhs;
+
+    const u64 size = lhs.size + rhs.size;
+    if(size <= String::SMALL) {
+      String result;
+      result.size = size;
+      std::ranges::copy(rhs.view(), std::ranges::copy(lhs.view(), result.bytes.begin()).out);
+      return result;
+    }
+
+    // * The left-hand side grows in place if it ends where its buffer was last written
+    std::shared_ptr<String::Buffer> buffer = lhs.buffer();
+    const bool tip = buffer and buffer->used == lhs.size;
+    if(tip and buffer->capacity - buffer->used >= rhs.size) {
+      std::ranges::copy(rhs.view(), buffer->bytes.get() + buffer->used);
+      buffer->used = size;
+      return String(std::move(buffer), size);
+    }
+
+    // * Short strings, and growing ones that are the longer side, are copied into a buffer twice as large, the rest make a rope
+    if(size < String::ROPE or (tip and lhs.size >= rhs.size)) {
+      buffer = String::flatten(lhs, 2 * size);
+      std::ranges::copy(rhs.view(), buffer->bytes.get() + lhs.size);
+      buffer->used = size;
+      return String(std::move(buffer), size);
+    }
+
+    String result;
+    result.shared = std::make_shared<String::Node>(lhs, rhs);
+    result.size = size;
+    result.storage = String::Storage::ROPE;
+    return result;
+  }
+
+  auto String::operator==(String const& other) const -> bool {
+    if(size != other.size) return false;
+    if(storage == Storage::INTERNED and other.storage == Storage::INTERNED) return symbol == other.symbol;
+
+    // * Strings on the same buffer or rope are the same bytes up to their length
+    if(shared and shared == other.shared) return true;
+    return view() == other.view();
+  }
+
+  auto String::operator<=>(String const& other) const -> std::strong_ordering {
+    return view().compare(other.view()) <=> 0;
+  }
+
+  auto String::buffer() const noexcept -> std::shared_ptr<Buffer> {
+    if(storage == Storage::FLAT) return std::static_pointer_cast<Buffer>(shared);
+    if(storage == Storage::ROPE) return static_cast<Node const*>(shared.get())->flat;
+    return nullptr;
+  }
+
+  auto String::flatten(String const& value, u64 capacity) -> std::shared_ptr<Buffer> {
+    auto buffer = std::make_shared<Buffer>(std::make_unique_for_overwrite<i8[]>(capacity), capacity, value.size);
+
+    // * Leaves are copied left to right, with the ropes still to visit on an explicit stack
+    i8* into = buffer->bytes.get();
+    std::vector<String const*> pending { &value };
+    while(not pending.empty()) {
+      String const* next = pending.back();
+      pending.pop_back();
+
+      auto const* node = next->storage == Storage::ROPE ? static_cast<Node const*>(next->shared.get()) : nullptr;
+      if(node and not node->flat) {
+        pending.push_back(&node->right);
+        pending.push_back(&node->left);
+      } else into = std::ranges::copy(next->view(), into).out;
+    }
+    return buffer;
+  }
+
+  auto String::rope() const -> std::string_view {
+    auto* node = static_cast<Node*>(shared.get());
+    if(not node->flat) {
+      node->flat = flatten(*this, size);
+      release(std::exchange(node->left, String{ }));
+      release(std::exchange(node->right, String{ }));
+    }
+    return { node->flat->bytes.get(), size };
+  }
+
+  auto String::release(String&& value) noexcept -> void {
+    if(value.storage != Storage::ROPE or not value.shared) return;
+
+    // * A node dies with the last reference, after its child ropes are moved here, so its destructor finds nothing left to release
+    std::vector<std::shared_ptr<void>> pending;
+    pending.push_back(std::move(value.shared));
+    while(not pending.empty()) {
+      std::shared_ptr<void> next = std::move(pending.back());
+      pending.pop_back();
+      if(next.use_count() != 1) continue;
+
+      auto* node = static_cast<Node*>(next.get());
+      for(String* child : { &node->left, &node->right })
+        if(child->storage == Storage::ROPE and child->shared) pending.push_back(std::move(child->shared));
+    }
+  }
+
+}
+
+auto std::hash<fridayc::runtime::String>::operator()(fridayc::runtime::String const& value) const -> u64 {
+  return std::hash<std::string_view>{}(value.view());
+}
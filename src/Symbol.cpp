@@ -0,0 +1,148 @@
+#include "Symbol.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    /// @brief One of the independently locked partitions of the interner
+    ///
+    /// A symbol identifier packs the shard in its low bits and the position
+    /// inside the shard in the remaining ones. Spellings are copied into
+    /// append-only chunks and listed in fixed-size segments that never move,
+    /// so Symbol::view() needs neither a lock nor a hash lookup.
+    class Shard {
+      static constexpr u64 SEGMENT_BITS = 10;
+      static constexpr u64 SEGMENT_SIZE = 1 << SEGMENT_BITS;
+      static constexpr u64 MAX_SEGMENTS = 1 << 12;
+      static constexpr u64 CHUNK_SIZE   = 64 * 1024;
+
+      struct Slot {
+        u64 hash;
+        u32 local;
+      };
+
+      std::mutex mutex { };
+      std::array<std::atomic<std::string_view*>, MAX_SEGMENTS> segments { };
+      std::vector<Box<std::string_view[]>> owned_segments { };
+      std::vector<Box<i8[]>> chunks { };
+      std::vector<Box<i8[]>> large { };
+      u64 chunk_used { CHUNK_SIZE };
+      std::vector<Slot> table { };
+      u32 count { 0 };
+
+      public:
+      static constexpr u32 EMPTY_SLOT = std::numeric_limits<u32>::max();
+
+      /// @brief Reserves position 0 for the empty spelling, so identifier 0 is never handed out
+      Shard() {
+        append(""sv);
+      }
+
+      auto find(std::string_view spelling, u64 hash) -> u32 {
+        std::scoped_lock lock { mutex };
+
+        if(table.empty()) table.assign(64, Slot{ 0, EMPTY_SLOT });
+
+        const u64 mask = table.size() - 1;
+        u64 position = (hash >> 8) & mask;
+        while(table[position].local != EMPTY_SLOT) {
+          Slot const& slot = table[position];
+          if(slot.hash == hash and at(slot.local) == spelling) return slot.local;
+          position = (position + 1) & mask;
+        }
+
+        const u32 local = append(store(spelling));
+        table[position] = Slot{ hash, local };
+        if(count * 2 > table.size()) grow();
+        return local;
+      }
+
+      auto at(u32 local) const noexcept -> std::string_view {
+        std::string_view* segment = segments[local >> SEGMENT_BITS].load(std::memory_order_acquire);
+        return segment[local & (SEGMENT_SIZE - 1)];
+      }
+
+      auto size() noexcept -> u32 {
+        std::scoped_lock lock { mutex };
+        return count;
+      }
+
+      private:
+      auto store(std::string_view spelling) -> std::string_view {
+        i8* data = nullptr;
+
+        if(spelling.length() > CHUNK_SIZE / 4) {
+          // * Large spellings get a dedicated allocation so chunks stay dense
+          data = large.emplace_back(std::make_unique<i8[]>(spelling.length())).get();
+        } else {
+          if(chunk_used + spelling.length() > CHUNK_SIZE) {
+            chunks.push_back(std::make_unique<i8[]>(CHUNK_SIZE));
+            chunk_used = 0;
+          }
+          data = chunks.back().get() + chunk_used;
+          chunk_used += spelling.length();
+        }
+
+        std::ranges::copy(spelling, data);
+        return std::string_view{ data, spelling.length() };
+      }
+
+      auto append(std::string_view stored) -> u32 {
+        const u32 local = count;
+        const u64 segment = local >> SEGMENT_BITS;
+
+        if((local & (SEGMENT_SIZE - 1)) == 0) {
+          owned_segments.push_back(std::make_unique<std::string_view[]>(SEGMENT_SIZE));
+          owned_segments.back()[0] = stored;
+          segments[segment].store(owned_segments.back().get(), std::memory_order_release);
+        } else {
+          segments[segment].load(std::memory_order_relaxed)[local & (SEGMENT_SIZE - 1)] = stored;
+        }
+
+        ++count;
+        return local;
+      }
+
+      auto grow() -> void {
+        std::vector<Slot> old = std::exchange(table, std::vector<Slot>(table.size() * 2, Slot{ 0, EMPTY_SLOT }));
+        const u64 mask = table.size() - 1;
+        for(Slot const& slot : old) {
+          if(slot.local == EMPTY_SLOT) continue;
+          u64 position = (slot.hash >> 8) & mask;
+          while(table[position].local != EMPTY_SLOT) position = (position + 1) & mask;
+          table[position] = slot;
+        }
+      }
+    };
+
+    constexpr u32 SHARD_BITS = 4;
+    constexpr u32 SHARD_COUNT = 1 << SHARD_BITS;
+
+    auto shards() -> std::array<Shard, SHARD_COUNT>& {
+      static std::array<Shard, SHARD_COUNT> instance;
+      return instance;
+    }
+
+  }
+
+  auto Symbol::intern(std::string_view spelling) -> Symbol {
+    if(spelling.empty()) return Symbol{};
+
+    const u64 hash = std::hash<std::string_view>{}(spelling);
+    const u32 shard = hash & (SHARD_COUNT - 1);
+    const u32 local = shards()[shard].find(spelling, hash);
+    return Symbol{ local << SHARD_BITS | shard };
+  }
+
+  auto Symbol::view() const noexcept -> std::string_view {
+    if(id == 0) return ""sv;
+    return shards()[id & (SHARD_COUNT - 1)].at(id >> SHARD_BITS);
+  }
+
+  auto Symbol::count() noexcept -> u64 {
+    u64 total = 1;
+    for(Shard& shard : shards()) total += shard.size() - 1;
+    return total;
+  }
+
+}
@@ -0,0 +1,108 @@
+#include "ThreadPool.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    thread_local ThreadPool const* current_pool = nullptr;
+    thread_local u32 current_worker = 0;
+
+  }
+
+  ThreadPool::ThreadPool(u32 threads) {
+    if(threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    queues.reserve(threads);
+    for(u32 i = 0; i < threads; ++i)
+      queues.push_back(std::make_unique<Queue>());
+
+    workers.reserve(threads);
+    for(u32 i = 0; i < threads; ++i)
+      workers.emplace_back([this, i] { work(i); });
+  }
+
+  ThreadPool::~ThreadPool() {
+    wait();
+    {
+      std::scoped_lock lock { mutex };
+      stopping = true;
+    }
+    available.notify_all();
+    workers.clear(); // * Join before the synchronization members are destroyed
+  }
+
+  auto ThreadPool::submit(std::function<void()> task) -> void {
+    const std::optional<u32> self = worker();
+    Queue& queue = *queues[self ? *self : next.fetch_add(1, std::memory_order_relaxed) % queues.size()];
+
+    pending.fetch_add(1, std::memory_order_relaxed);
+    {
+      std::scoped_lock lock { queue.mutex };
+      queue.tasks.push_back(std::move(task));
+    }
+
+    {
+      // * Published under the lock so a worker about to sleep cannot miss it
+      std::scoped_lock lock { mutex };
+      queued.fetch_add(1, std::memory_order_release);
+    }
+    available.notify_one();
+  }
+
+  auto ThreadPool::wait() -> void {
+    std::unique_lock lock { mutex };
+    idle.wait(lock, [this] { return pending.load(std::memory_order_acquire) == 0; });
+  }
+
+  auto ThreadPool::size() const noexcept -> u32 {
+    return workers.size();
+  }
+
+  auto ThreadPool::worker() const noexcept -> std::optional<u32> {
+    return current_pool == this ? std::optional<u32>{ current_worker } : std::nullopt;
+  }
+
+  auto ThreadPool::work(u32 index) -> void {
+    current_pool = this;
+    current_worker = index;
+
+    while(true) {
+      if(std::function<void()> task = take(index)) {
+        task();
+
+        if(pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          std::scoped_lock lock { mutex };
+          idle.notify_all();
+        }
+        continue;
+      }
+
+      std::unique_lock lock { mutex };
+      available.wait(lock, [this] { return stopping or queued.load(std::memory_order_acquire) > 0; });
+      if(stopping and queued.load(std::memory_order_acquire) == 0) return;
+    }
+  }
+
+  auto ThreadPool::take(u32 index) -> std::function<void()> {
+    std::function<void()> task;
+
+    // * Newest task of the own queue first, then the oldest task of the others
+    for(u32 i = 0; i < queues.size() and not task; ++i) {
+      Queue& queue = *queues[(index + i) % queues.size()];
+      std::scoped_lock lock { queue.mutex };
+      if(queue.tasks.empty()) continue;
+
+      if(i == 0) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      } else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+    }
+
+    if(task) queued.fetch_sub(1, std::memory_order_acq_rel);
+    return task;
+  }
+
+}
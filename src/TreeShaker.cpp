@@ -0,0 +1,70 @@
+#include "TreeShaker.hpp"
+
+namespace fridayc {
+
+  TreeShaker::TreeShaker(std::vector<Symbol> roots) noexcept
+    : roots { std::move(roots) }
+  {}
+
+  auto TreeShaker::shake(Program& program) -> void {
+    BlockStatement& block = *program.block;
+
+    // * Several declarations may share a name, a reference reaches all of them
+    for(u32 i = 0; i < block.size(); ++i) {
+      Statement* stmt = block[i].get();
+      if(auto* function = dynamic_cast<FunctionStatement*>(stmt)) declarations[function->name].push_back(i);
+      else if(auto* structure = dynamic_cast<StructStatement*>(stmt)) declarations[structure->name].push_back(i);
+      else if(auto* enumeration = dynamic_cast<EnumStatement*>(stmt)) declarations[enumeration->name].push_back(i);
+    }
+
+    reached.assign(block.size(), false);
+    for(Symbol root : roots) reach(root);
+    if(worklist.empty()) return;
+
+    while(not worklist.empty()) {
+      const u32 index = worklist.back();
+      worklist.pop_back();
+      visit(*block[index]);
+    }
+
+    u32 index = 0;
+    declarations_removed += block.removeIf([this, &index](Box<Statement> const& stmt) {
+      const bool removable = dynamic_cast<FunctionStatement*>(stmt.get())
+        or dynamic_cast<StructStatement*>(stmt.get())
+        or dynamic_cast<EnumStatement*>(stmt.get());
+      const bool remove = not reached[index++] and removable;
+      if(remove) bytes_removed += stmt->span.length;
+      return remove;
+    });
+  }
+
+  auto TreeShaker::removed() const noexcept -> u64 {
+    return declarations_removed;
+  }
+
+  auto TreeShaker::removedBytes() const noexcept -> u64 {
+    return bytes_removed;
+  }
+
+  auto TreeShaker::operator()(Identifier& arg) noexcept -> std::any {
+    reach(arg.id);
+    return { };
+  }
+
+  auto TreeShaker::operator()(TypeExpression& arg) noexcept -> std::any {
+    reach(arg.name);
+    return { };
+  }
+
+  auto TreeShaker::reach(Symbol name) noexcept -> void {
+    std::vector<u32> const* indices = declarations.find(name);
+    if(not indices) return;
+
+    for(u32 index : *indices) {
+      if(reached[index]) continue;
+      reached[index] = true;
+      worklist.push_back(index);
+    }
+  }
+
+}
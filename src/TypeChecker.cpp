@@ -0,0 +1,495 @@
+#include "TypeChecker.hpp"
+
+namespace fridayc {
+
+  namespace {
+
+    /// @brief Source spelling of an operator, for diagnostics
+    constexpr auto spelling(Token::Type oper) noexcept -> std::string_view {
+      switch(oper) {
+        case Token::Type::PLUS: return "+";
+        case Token::Type::MINUS: return "-";
+        case Token::Type::STAR: return "*";
+        case Token::Type::SLASH: return "/";
+        case Token::Type::MODULO: return "%";
+        case Token::Type::AND: return "and";
+        case Token::Type::OR: return "or";
+        case Token::Type::NOT: return "not";
+        case Token::Type::LSHIFT: return "<<";
+        case Token::Type::RSHIFT: return ">>";
+        case Token::Type::BIT_AND: return "&";
+        case Token::Type::BIT_OR: return "|";
+        case Token::Type::BIT_NOT: return "~";
+        case Token::Type::ASSIGN: return "=";
+        case Token::Type::PLUS_EQ: return "+=";
+        case Token::Type::MINUS_EQ: return "-=";
+        case Token::Type::STAR_EQ: return "*=";
+        case Token::Type::SLASH_EQ: return "/=";
+        case Token::Type::MODULO_EQ: return "%=";
+        case Token::Type::LSHIFT_EQ: return "<<=";
+        case Token::Type::RSHIFT_EQ: return ">>=";
+        case Token::Type::BIT_AND_EQ: return "&=";
+        case Token::Type::BIT_OR_EQ: return "|=";
+        case Token::Type::GREATER: return ">";
+        case Token::Type::LESS: return "<";
+        case Token::Type::EQUALS: return "==";
+        case Token::Type::GREATER_EQ: return ">=";
+        case Token::Type::LESS_EQ: return "<=";
+        case Token::Type::NOT_EQ: return "!=";
+        default: return "?";
+      }
+    }
+
+  }
+
+  TypeChecker::TypeChecker(TypeTable& table) noexcept
+    : table { table }
+  {}
+
+  TypeChecker::TypeChecker(TypeChecker const& declarations) noexcept
+    : table { declarations.table }
+    , shared { &declarations }
+  {}
+
+  /// @brief Infers the type of an expression and reports it unless assignable to the expected one
+  /// @param describe returns what the expression is for, only called on error
+  template<class Describe>
+  auto TypeChecker::expect(Expression& expr, TypeId expected, Describe&& describe) noexcept -> void {
+    const TypeId actual = infer(expr);
+    if(not assignable(expected, actual))
+      errorAt(expr.span, "Expected '{}' for {}, got '{}'"f.format(table.name(expected), describe(), table.name(actual)));
+  }
+
+  auto TypeChecker::check(Program& program) -> std::vector<Error> {
+    visit(program);
+    return std::move(error_queue);
+  }
+
+  auto TypeChecker::declare(Program& program) -> std::vector<Error> {
+    declaring = true;
+    for(auto& stmt : *program.block) visit(*stmt);
+    declaring = false;
+    return std::move(error_queue);
+  }
+
+  auto TypeChecker::check(FunctionStatement& function) -> std::vector<Error> {
+    visit(function);
+    return std::move(error_queue);
+  }
+
+  auto TypeChecker::typeOf(Visitable const& node) const noexcept -> TypeId {
+    TypeId const* type = find(node);
+    return type ? *type : TypeId::ERROR;
+  }
+
+  auto TypeChecker::find(Visitable const& node) const noexcept -> TypeId const* {
+    TypeId const* type = types.find(&node);
+    return type or not shared ? type : shared->find(node);
+  }
+
+  auto TypeChecker::gather(FlatMap<Visitable const*, TypeId>& into) -> void {
+    into.reserve(into.size() + types.size());
+    types.forEach([&into](Visitable const* node, TypeId type) { into.insert(node, type); });
+    types.clear();
+  }
+
+  auto TypeChecker::operator()(Identifier& arg) noexcept -> std::any {
+    Binding const& binding = arg.binding;
+    switch(binding.kind) {
+      case Binding::Kind::LOCAL:
+        return record(arg, typeOf(*binding.declaration));
+      case Binding::Kind::PARAMETER:
+        return record(arg, typeOf(*static_cast<FunctionStatement*>(binding.declaration)->args[binding.slot].type));
+      case Binding::Kind::CONSTANT:
+        return record(arg, enumeration(*static_cast<EnumStatement*>(binding.declaration)));
+      case Binding::Kind::UNRESOLVED:
+      case Binding::Kind::MEMBER:
+        return record(arg, TypeId::ERROR); // * Reported by the Resolver or by member()
+      default:
+        errorAt(arg.span, "'{}' is not a value"f.format(arg.id));
+        return record(arg, TypeId::ERROR);
+    }
+  }
+
+  auto TypeChecker::operator()(BoolLiteral& arg) noexcept -> std::any {
+    return record(arg, TypeId::BOOL);
+  }
+
+  auto TypeChecker::operator()(ObjectLiteral& arg) noexcept -> std::any {
+    if(arg.value.getType() == Token::Type::NUL) return record(arg, TypeId::NUL);
+
+    errorAt(arg.span, "Cannot use '{}' outside of a method"f.format(arg.value.getLiteral()));
+    return record(arg, TypeId::ERROR);
+  }
+
+  auto TypeChecker::operator()(StringLiteral& arg) noexcept -> std::any {
+    return record(arg, TypeId::STRING);
+  }
+
+  auto TypeChecker::operator()(FloatLiteral& arg) noexcept -> std::any {
+    return record(arg, TypeId::FLOAT);
+  }
+
+  auto TypeChecker::operator()(IntLiteral& arg) noexcept -> std::any {
+    return record(arg, TypeId::INT);
+  }
+
+  auto TypeChecker::operator()(CharLiteral& arg) noexcept -> std::any {
+    return record(arg, TypeId::CHAR);
+  }
+
+  auto TypeChecker::operator()(PrefixExpression& arg) noexcept -> std::any {
+    const TypeId operand = infer(*arg.expr);
+    if(operand == TypeId::ERROR) return record(arg, TypeId::ERROR);
+
+    bool valid = false;
+    switch(arg.oper) {
+      case Token::Type::PLUS:
+      case Token::Type::MINUS: valid = numeric(operand); break;
+      case Token::Type::NOT: valid = operand == TypeId::BOOL; break;
+      case Token::Type::BIT_NOT: valid = operand == TypeId::INT; break;
+      default: break;
+    }
+
+    if(valid) return record(arg, operand);
+
+    errorAt(arg.span, "Operator '{}' cannot be applied to '{}'"f.format(spelling(arg.oper), table.name(operand)));
+    return record(arg, TypeId::ERROR);
+  }
+
+  auto TypeChecker::operator()(InfixExpression& arg) noexcept -> std::any {
+    if(arg.oper == Token::Type::DOT) return record(arg, member(arg));
+
+    const TypeId lhs = infer(*arg.lhs);
+    const TypeId rhs = infer(*arg.rhs);
+
+    if(arg.oper == Token::Type::ASSIGN or Token::compoundOperatorOf(arg.oper) != Token::Type::ILLEGAL)
+      return record(arg, assignment(arg, lhs, rhs));
+
+    return record(arg, binary(arg, arg.oper, lhs, rhs));
+  }
+
+  auto TypeChecker::operator()(CallExpression& arg) noexcept -> std::any {
+    if(Binding const* binding = callee(arg)) {
+      if(binding->kind == Binding::Kind::FUNCTION) {
+        auto* declaration = static_cast<FunctionStatement*>(binding->declaration);
+        arguments(arg, declaration->args, declaration->name.view());
+        return record(arg, typeOf(*declaration->return_type));
+      }
+
+      // * Calling a struct constructs it from its fields, in declaration order
+      auto* declaration = static_cast<StructStatement*>(binding->declaration);
+      arguments(arg, declaration->fields, declaration->name.view());
+      return record(arg, structure(*declaration));
+    }
+
+    const TypeId function = infer(*arg.function);
+    for(auto& argument : arg) infer(*argument);
+
+    if(function != TypeId::ERROR)
+      errorAt(arg.function->span, "A value of type '{}' cannot be called"f.format(table.name(function)));
+    return record(arg, TypeId::ERROR);
+  }
+
+  auto TypeChecker::operator()(SubscriptExpression& arg) noexcept -> std::any {
+    const TypeId array = infer(*arg.array);
+    const TypeId index = infer(*arg.index);
+
+    if(index != TypeId::ERROR and index != TypeId::INT)
+      errorAt(arg.index->span, "Index must be 'int', got '{}'"f.format(table.name(index)));
+
+    if(array == TypeId::ERROR) return record(arg, TypeId::ERROR);
+    if(array == TypeId::STRING) return record(arg, TypeId::CHAR);
+
+    TypeInfo const& info = table.info(array);
+    if(info.kind == TypeInfo::Kind::ARRAY) return record(arg, info.element);
+
+    errorAt(arg.array->span, "A value of type '{}' cannot be subscripted"f.format(table.name(array)));
+    return record(arg, TypeId::ERROR);
+  }
+
+  auto TypeChecker::operator()(TypeExpression& arg) noexcept -> std::any {
+    TypeId base = TypeId::ERROR;
+    switch(arg.binding.kind) {
+      case Binding::Kind::BUILTIN: base = table.primitive(arg.name).value_or(TypeId::ERROR); break;
+      case Binding::Kind::STRUCT: base = structure(*static_cast<StructStatement*>(arg.binding.declaration)); break;
+      case Binding::Kind::ENUM: base = enumeration(*static_cast<EnumStatement*>(arg.binding.declaration)); break;
+      default: break; // * Reported by the Resolver
+    }
+
+    if(base == TypeId::VOID and arg.dimensions > 0) {
+      errorAt(arg.span, "Cannot declare an array of 'void'"s);
+      base = TypeId::ERROR;
+    }
+
+    return record(arg, base == TypeId::ERROR ? base : array(base, arg.dimensions));
+  }
+
+  auto TypeChecker::operator()(ArrayLiteral& arg) noexcept -> std::any {
+    if(arg.empty()) {
+      errorAt(arg.span, "Cannot infer the type of an empty array"s);
+      return record(arg, TypeId::ERROR);
+    }
+
+    const TypeId element = infer(*arg[0]);
+    for(u64 i = 1; i < arg.size(); ++i) expect(*arg[i], element, [] { return "an array element"s; });
+
+    return record(arg, element == TypeId::ERROR ? element : array(element));
+  }
+
+  auto TypeChecker::operator()(ReturnStatement& arg) noexcept -> std::any {
+    expect(*arg.expr, typeOf(*function->return_type), [this] { return "the value returned by '{}'"f.format(function->name); });
+    return { };
+  }
+
+  auto TypeChecker::operator()(PrintStatement& arg) noexcept -> std::any {
+    if(infer(*arg.expr) == TypeId::VOID) errorAt(arg.expr->span, "Cannot print a 'void' value"s);
+    return { };
+  }
+
+  auto TypeChecker::operator()(IfStatement& arg) noexcept -> std::any {
+    expect(*arg.condition, TypeId::BOOL, [] { return "the condition"s; });
+    visit(*arg.block);
+    if(arg.alternative) visit(*arg.alternative);
+    return { };
+  }
+
+  auto TypeChecker::operator()(WhileStatement& arg) noexcept -> std::any {
+    expect(*arg.condition, TypeId::BOOL, [] { return "the condition"s; });
+    visit(*arg.block);
+    return { };
+  }
+
+  auto TypeChecker::operator()(ForStatement& arg) noexcept -> std::any {
+    infer(*arg.initializer);
+    expect(*arg.condition, TypeId::BOOL, [] { return "the condition"s; });
+    infer(*arg.modifier);
+    visit(*arg.block);
+    return { };
+  }
+
+  auto TypeChecker::operator()(StructStatement& arg) noexcept -> std::any {
+    if(declaring) Walker::operator()(arg);
+    return { };
+  }
+
+  auto TypeChecker::operator()(FunctionStatement& arg) noexcept -> std::any {
+    if(declaring) {
+      for(Member& parameter : arg.args) {
+        if(std::any_cast<TypeId>(visit(*parameter.type)) == TypeId::VOID)
+          errorAt(parameter.type->span, "Parameter '{}' cannot have type 'void'"f.format(parameter.name));
+      }
+      visit(*arg.return_type);
+      return { };
+    }
+
+    // * A nested function is reported by the Resolver, its signature is typed here so its body can be checked against it
+    if(function) {
+      declaring = true;
+      visit(arg);
+      declaring = false;
+    }
+
+    FunctionStatement* enclosing = std::exchange(function, &arg);
+    visit(*arg.block);
+    function = enclosing;
+    return { };
+  }
+
+  auto TypeChecker::operator()(DeclarationStatement& arg) noexcept -> std::any {
+    const TypeId declared = std::any_cast<TypeId>(visit(*arg.type));
+    if(declared == TypeId::VOID) errorAt(arg.type->span, "Variable '{}' cannot have type 'void'"f.format(arg.id));
+
+    if(arg.expr) expect(*arg.expr, declared, [&arg] { return "the initializer of '{}'"f.format(arg.id); });
+
+    record(arg, declared);
+    return { };
+  }
+
+  auto TypeChecker::operator()(Program& arg) noexcept -> std::any {
+    // * Signatures and fields first, so calls and member accesses can be checked in any order
+    declaring = true;
+    for(auto& stmt : *arg.block) visit(*stmt);
+    declaring = false;
+
+    for(auto& stmt : *arg.block) visit(*stmt);
+    return { };
+  }
+
+  auto TypeChecker::errorAt(Span span, std::string error) noexcept -> void {
+    error_queue.emplace_back(std::move(error), span);
+  }
+
+  auto TypeChecker::infer(Expression& expr) noexcept -> TypeId {
+    const std::any type = visit(expr);
+    TypeId const* id = std::any_cast<TypeId>(&type);
+    return id ? *id : TypeId::ERROR;
+  }
+
+  auto TypeChecker::structure(StructStatement& declaration) noexcept -> TypeId {
+    auto [type, inserted] = nominals.insert(&declaration, TypeId::ERROR);
+    if(inserted) *type = table.structure(declaration);
+    return *type;
+  }
+
+  auto TypeChecker::enumeration(EnumStatement& declaration) noexcept -> TypeId {
+    auto [type, inserted] = nominals.insert(&declaration, TypeId::ERROR);
+    if(inserted) *type = table.enumeration(declaration);
+    return *type;
+  }
+
+  auto TypeChecker::array(TypeId element, u32 dimensions) noexcept -> TypeId {
+    for(; dimensions > 0; --dimensions) {
+      auto [type, inserted] = arrays.insert(element, TypeId::ERROR);
+      if(inserted) *type = table.array(element);
+      element = *type;
+    }
+    return element;
+  }
+
+  auto TypeChecker::record(Visitable const& node, TypeId type) noexcept -> std::any {
+    types[&node] = type;
+    return type;
+  }
+
+  auto TypeChecker::assignable(TypeId to, TypeId from) const noexcept -> bool {
+    if(to == from or to == TypeId::ERROR or from == TypeId::ERROR) return true;
+    if(from != TypeId::NUL) return false;
+
+    const TypeInfo::Kind kind = table.info(to).kind;
+    return kind == TypeInfo::Kind::STRING or kind == TypeInfo::Kind::STRUCT or kind == TypeInfo::Kind::ARRAY;
+  }
+
+  auto TypeChecker::numeric(TypeId type) const noexcept -> bool {
+    return type == TypeId::INT or type == TypeId::FLOAT;
+  }
+
+  auto TypeChecker::callee(CallExpression& call) noexcept -> Binding const* {
+    Identifier const* name = call.callee();
+    if(name and (name->binding.kind == Binding::Kind::FUNCTION or name->binding.kind == Binding::Kind::STRUCT))
+      return &name->binding;
+
+    return nullptr;
+  }
+
+  auto TypeChecker::member(InfixExpression& access) noexcept -> TypeId {
+    auto* object = dynamic_cast<Identifier*>(access.lhs.get());
+    auto* name = dynamic_cast<Identifier*>(access.rhs.get());
+    if(not name) return TypeId::ERROR; // * Reported by the Resolver
+
+    if(object and (object->binding.kind == Binding::Kind::ENUM or object->binding.kind == Binding::Kind::NAMESPACE))
+      return infer(*name);
+
+    const TypeId type = infer(*access.lhs);
+    TypeInfo const& info = table.info(type);
+    if(info.kind != TypeInfo::Kind::STRUCT) {
+      if(type != TypeId::ERROR) errorAt(access.lhs->span, "A value of type '{}' has no members"f.format(table.name(type)));
+      record(*name, TypeId::ERROR);
+      return TypeId::ERROR;
+    }
+
+    auto* declaration = static_cast<StructStatement*>(info.declaration);
+    const std::optional<u32> field = declaration->fields.indexOf(name->id);
+    if(not field) {
+      errorAt(name->span, "Struct '{}' has no field '{}'"f.format(declaration->name, name->id));
+      record(*name, TypeId::ERROR);
+      return TypeId::ERROR;
+    }
+
+    // * The field is known now, complete the binding left by the Resolver
+    name->binding.slot = *field;
+    name->binding.declaration = declaration;
+
+    const TypeId field_type = typeOf(*declaration->fields[*field].type);
+    record(*name, field_type);
+    return field_type;
+  }
+
+  auto TypeChecker::binary(InfixExpression& arg, Token::Type oper, TypeId lhs, TypeId rhs) noexcept -> TypeId {
+    if(lhs == TypeId::ERROR or rhs == TypeId::ERROR) return TypeId::ERROR;
+
+    switch(oper) {
+      case Token::Type::PLUS:
+        if(lhs == TypeId::STRING and rhs == TypeId::STRING) return TypeId::STRING;
+        [[fallthrough]];
+      case Token::Type::MINUS:
+      case Token::Type::STAR:
+      case Token::Type::SLASH:
+        if(lhs == rhs and numeric(lhs)) return lhs;
+        break;
+      case Token::Type::MODULO:
+      case Token::Type::LSHIFT:
+      case Token::Type::RSHIFT:
+      case Token::Type::BIT_AND:
+      case Token::Type::BIT_OR:
+        if(lhs == TypeId::INT and rhs == TypeId::INT) return TypeId::INT;
+        break;
+      case Token::Type::AND:
+      case Token::Type::OR:
+        if(lhs == TypeId::BOOL and rhs == TypeId::BOOL) return TypeId::BOOL;
+        break;
+      case Token::Type::LESS:
+      case Token::Type::GREATER:
+      case Token::Type::LESS_EQ:
+      case Token::Type::GREATER_EQ:
+        if(lhs == rhs and (numeric(lhs) or lhs == TypeId::CHAR)) return TypeId::BOOL;
+        break;
+      case Token::Type::EQUALS:
+      case Token::Type::NOT_EQ:
+        if(assignable(lhs, rhs) or assignable(rhs, lhs)) return TypeId::BOOL;
+        break;
+      default:
+        break;
+    }
+
+    errorAt(arg.span, "Operator '{}' cannot be applied to '{}' and '{}'"f.format(spelling(oper), table.name(lhs), table.name(rhs)));
+    return TypeId::ERROR;
+  }
+
+  auto TypeChecker::assignment(InfixExpression& arg, TypeId lhs, TypeId rhs) noexcept -> TypeId {
+    bool target = dynamic_cast<SubscriptExpression*>(arg.lhs.get()) != nullptr;
+
+    if(auto* access = dynamic_cast<InfixExpression*>(arg.lhs.get())) {
+      // * Fields can be assigned, enum constants cannot
+      auto* name = dynamic_cast<Identifier*>(access->rhs.get());
+      target = access->oper == Token::Type::DOT and name and name->binding.kind == Binding::Kind::MEMBER;
+    }
+
+    if(auto* name = dynamic_cast<Identifier*>(arg.lhs.get())) {
+      const Binding& binding = name->binding;
+      target = binding.kind == Binding::Kind::LOCAL or binding.kind == Binding::Kind::PARAMETER;
+
+      if(binding.kind == Binding::Kind::LOCAL and static_cast<DeclarationStatement*>(binding.declaration)->constant) {
+        errorAt(arg.lhs->span, "Cannot assign to constant '{}'"f.format(name->id));
+        return TypeId::ERROR;
+      }
+    }
+
+    if(not target) {
+      if(lhs != TypeId::ERROR) errorAt(arg.lhs->span, "Cannot assign to this expression"s);
+      return TypeId::ERROR;
+    }
+
+    const Token::Type oper = Token::compoundOperatorOf(arg.oper);
+    const TypeId value = oper == Token::Type::ILLEGAL ? rhs : binary(arg, oper, lhs, rhs);
+
+    if(not assignable(lhs, value)) {
+      errorAt(arg.span, "Cannot assign '{}' to '{}'"f.format(table.name(value), table.name(lhs)));
+      return TypeId::ERROR;
+    }
+
+    return lhs;
+  }
+
+  auto TypeChecker::arguments(CallExpression& call, Members const& parameters, std::string_view callee) noexcept -> void {
+    if(call.size() != parameters.size()) {
+      errorAt(call.span, "'{}' expects {} argument{}, got {}"f.format(callee, parameters.size(), parameters.size() == 1 ? "" : "s", call.size()));
+      for(auto& argument : call) infer(*argument);
+      return;
+    }
+
+    for(u64 i = 0; i < call.size(); ++i)
+      expect(*call[i], typeOf(*parameters[i].type), [i, callee] { return "argument {} of '{}'"f.format(i + 1, callee); });
+  }
+
+}
@@ -0,0 +1,95 @@
+#include "TypeTable.hpp"
+
+namespace fridayc {
+
+  TypeTable::TypeTable() {
+    using enum TypeInfo::Kind;
+    for(TypeInfo::Kind kind : { ERROR, INT, FLOAT, BOOL, CHAR, STRING, VOID, NUL })
+      append(TypeInfo{ kind, static_cast<TypeId>(count), nullptr });
+  }
+
+  auto TypeTable::primitive(Symbol name) const noexcept -> std::optional<TypeId> {
+    static const std::array<std::pair<Symbol, TypeId>, 6> PRIMITIVES {{
+      { Symbol::intern("int"sv),    TypeId::INT    },
+      { Symbol::intern("float"sv),  TypeId::FLOAT  },
+      { Symbol::intern("bool"sv),   TypeId::BOOL   },
+      { Symbol::intern("char"sv),   TypeId::CHAR   },
+      { Symbol::intern("string"sv), TypeId::STRING },
+      { Symbol::intern("void"sv),   TypeId::VOID   },
+    }};
+
+    for(auto const& [spelling, type] : PRIMITIVES)
+      if(spelling == name) return type;
+
+    return std::nullopt;
+  }
+
+  auto TypeTable::structure(StructStatement& declaration) -> TypeId {
+    return intern(declaration, TypeInfo::Kind::STRUCT);
+  }
+
+  auto TypeTable::enumeration(EnumStatement& declaration) -> TypeId {
+    return intern(declaration, TypeInfo::Kind::ENUM);
+  }
+
+  auto TypeTable::array(TypeId element, u32 dimensions) -> TypeId {
+    if(dimensions == 0) return element;
+
+    std::scoped_lock lock { mutex };
+    for(; dimensions > 0; --dimensions) {
+      auto [type, inserted] = arrays.insert(element, static_cast<TypeId>(count));
+      if(inserted) append(TypeInfo{ TypeInfo::Kind::ARRAY, element, nullptr });
+      element = *type;
+    }
+    return element;
+  }
+
+  auto TypeTable::info(TypeId type) const noexcept -> TypeInfo const& {
+    const u32 id = static_cast<u32>(type);
+    TypeInfo* segment = segments[id >> SEGMENT_BITS].load(std::memory_order_acquire);
+    return segment[id & (SEGMENT_SIZE - 1)];
+  }
+
+  auto TypeTable::name(TypeId type) const -> std::string {
+    TypeInfo const& description = info(type);
+    switch(description.kind) {
+      case TypeInfo::Kind::ERROR: return "<error>";
+      case TypeInfo::Kind::INT: return "int";
+      case TypeInfo::Kind::FLOAT: return "float";
+      case TypeInfo::Kind::BOOL: return "bool";
+      case TypeInfo::Kind::CHAR: return "char";
+      case TypeInfo::Kind::STRING: return "string";
+      case TypeInfo::Kind::VOID: return "void";
+      case TypeInfo::Kind::NUL: return "null";
+      case TypeInfo::Kind::STRUCT: return std::string(static_cast<StructStatement*>(description.declaration)->name.view());
+      case TypeInfo::Kind::ENUM: return std::string(static_cast<EnumStatement*>(description.declaration)->name.view());
+      case TypeInfo::Kind::ARRAY: return name(description.element) + "[]";
+    }
+    return "<error>";
+  }
+
+  auto TypeTable::size() const noexcept -> u64 {
+    std::scoped_lock lock { mutex };
+    return count;
+  }
+
+  auto TypeTable::intern(Statement& declaration, TypeInfo::Kind kind) -> TypeId {
+    std::scoped_lock lock { mutex };
+    auto [type, inserted] = nominals.insert(&declaration, static_cast<TypeId>(count));
+    if(inserted) append(TypeInfo{ kind, *type, &declaration });
+    return *type;
+  }
+
+  auto TypeTable::append(TypeInfo description) -> TypeId {
+    if((count & (SEGMENT_SIZE - 1)) == 0) {
+      // * Identifiers are handed out after their entry is written, so readers never see a partial one
+      Box<TypeInfo[]>& segment = owned_segments.emplace_back(std::make_unique<TypeInfo[]>(SEGMENT_SIZE));
+      segments[count >> SEGMENT_BITS].store(segment.get(), std::memory_order_release);
+    }
+
+    TypeInfo* segment = segments[count >> SEGMENT_BITS].load(std::memory_order_relaxed);
+    segment[count & (SEGMENT_SIZE - 1)] = description;
+    return static_cast<TypeId>(count++);
+  }
+
+}
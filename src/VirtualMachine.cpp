@@ -0,0 +1,377 @@
+#include "VirtualMachine.hpp"
+
+namespace fridayc {
+
+  using bytecode::Opcode;
+
+  VirtualMachine::VirtualMachine(bytecode::Module& module, std::ostream& out, ExecutionLimits limits) noexcept
+    : module { module }
+    , out { out }
+    , limits { limits }
+  {}
+
+  auto VirtualMachine::run([[maybe_unused]] Dispatch dispatch) -> std::vector<Error> {
+    errors.clear();
+    exit = 0;
+
+    if(module.functions.empty()) {
+      errors.emplace_back("No 'main' function to run"s, Span{ });
+      return std::move(errors);
+    }
+
+    stack.assign(limits.stack, Cell{ });
+    frames.clear();
+    frames.reserve(std::min<u64>(limits.depth, 1 << 12));
+
+    try {
+      module.materialize(0);
+#if defined(__GNUC__)
+      if(dispatch == Dispatch::THREADED) execute<Threaded>();
+      else execute<bytecode::Instruction>();
+#else
+      execute<bytecode::Instruction>();
+#endif
+    } catch(RuntimeError const& error) {
+      errors.push_back(error);
+    } catch(std::bad_alloc const&) {
+      errors.emplace_back("Out of memory"s, module.functions.front().span);
+    }
+
+    // * Objects still referenced from the stack are released now rather than with the machine
+    stack.clear();
+    frames.clear();
+    return std::move(errors);
+  }
+
+  auto VirtualMachine::status() const noexcept -> i64 {
+    return exit;
+  }
+
+  template<class Step>
+  auto VirtualMachine::codeOf(u32 function) const noexcept -> Step const* {
+    if constexpr (std::same_as<Step, Threaded>) return threaded[function].data();
+    else return module.functions[function].code.data();
+  }
+
+  auto VirtualMachine::thread(u32 function) -> void {
+    std::vector<bytecode::Instruction> const& code = module.functions[function].code;
+    threaded[function].reserve(code.size());
+    for(bytecode::Instruction const& instruction : code)
+      threaded[function].push_back({ handlers[(u64)instruction.op], instruction.op, instruction.a, instruction.b, instruction.c });
+  }
+
+  auto VirtualMachine::load(u32 function) -> bytecode::Function const& {
+    bytecode::Function const& loaded = module.materialize(function);
+    if(not threaded.empty()) thread(function);
+    return loaded;
+  }
+
+  template<class Step>
+  auto VirtualMachine::execute() -> void {
+    constexpr bool THREADED = std::same_as<Step, Threaded>;
+
+#if defined(__GNUC__)
+    if constexpr (THREADED) {
+      // * In the order of the opcodes
+      static void* const labels[] = {
+        &&handle_MOVE, &&handle_MOVE_REF, &&handle_CONSTANT, &&handle_CLEAR,
+        &&handle_ADD, &&handle_SUB, &&handle_MUL, &&handle_DIV, &&handle_MOD, &&handle_BIT_AND, &&handle_BIT_OR, &&handle_SHL, &&handle_SHR,
+        &&handle_NEG, &&handle_BIT_NOT, &&handle_ADD_IMM,
+        &&handle_FADD, &&handle_FSUB, &&handle_FMUL, &&handle_FDIV, &&handle_FNEG,
+        &&handle_EQ, &&handle_NE, &&handle_LT, &&handle_LE, &&handle_FEQ, &&handle_FNE, &&handle_FLT, &&handle_FLE,
+        &&handle_REQ, &&handle_RNE, &&handle_SEQ, &&handle_SNE,
+        &&handle_NOT, &&handle_CONCAT,
+        &&handle_NEW, &&handle_GET_FIELD, &&handle_GET_FIELD_REF, &&handle_SET_FIELD, &&handle_SET_FIELD_REF,
+        &&handle_GET_ELEM, &&handle_GET_ELEM_REF, &&handle_SET_ELEM, &&handle_SET_ELEM_REF, &&handle_GET_CHAR,
+        &&handle_JUMP, &&handle_JUMP_IF, &&handle_JUMP_IF_NOT, &&handle_JEQ, &&handle_JNE, &&handle_JLT, &&handle_JLE,
+        &&handle_INC_JLT,
+        &&handle_CALL,
+        &&handle_RETURN, &&handle_RETURN_REF, &&handle_RETURN_VOID, &&handle_FALL_OFF,
+        &&handle_PRINT,
+      };
+      static_assert(std::size(labels) == (u64)Opcode::COUNT);
+      if(threaded.empty()) {
+        handlers = labels;
+        threaded.assign(module.functions.size(), { });
+        for(u32 function = 0; function < module.functions.size(); ++function) thread(function);
+      }
+    }
+#endif
+
+    bytecode::Function const* function = &module.functions.front();
+    Step const* code = codeOf<Step>(0);
+    Step const* ip = code;
+    Cell* base = stack.data();
+    Cell* const end = stack.data() + stack.size();
+
+    // * Operands of the subscript that went out of bounds
+    i64 index = 0;
+    u64 length = 0;
+
+    if(function->registers > stack.size()) runtime::fault("Stack overflow"s, function->span);
+
+    // * Macros rather than lambdas: a lambda capturing ip and base by reference keeps them out of registers
+#define SPAN() (function->spans[ip - code])
+#define ENTER() do { \
+      Cell* constants = base + function->constant_base; \
+      for(u64 k = 0; k < function->constants.size(); ++k) constants[k].integer = function->constants[k]; \
+    } while(false)
+    // * Back to the call instruction of the caller, releasing what the registers of the callee still hold
+#define LEAVE() do { \
+      if(function->references) \
+        for(Cell* cell = base; cell != base + function->registers; ++cell) cell->object.reset(); \
+      Frame const& caller = frames.back(); \
+      function = &module.functions[caller.function]; \
+      code = codeOf<Step>(caller.function); \
+      ip = code + caller.at; \
+      base = caller.base; \
+      frames.pop_back(); \
+    } while(false)
+
+    ENTER();
+
+#define R(operand) base[ip->operand]
+#if defined(__GNUC__)
+#define DISPATCH() do { if constexpr (THREADED) goto *ip->handler; else goto dispatch; } while(false)
+#define CASE(name) case Opcode::name: handle_##name:
+#else
+#define DISPATCH() goto dispatch
+#define CASE(name) case Opcode::name:
+#endif
+#define NEXT() do { ++ip; DISPATCH(); } while(false)
+
+    DISPATCH();
+
+  dispatch:
+    switch(ip->op) {
+      CASE(MOVE) R(a).integer = R(b).integer; NEXT();
+      CASE(MOVE_REF) R(a).object = R(b).object; NEXT();
+      CASE(CONSTANT) R(a).object = module.constants[ip->b]; NEXT();
+      CASE(CLEAR) R(a).integer = 0; R(a).object.reset(); NEXT();
+
+      CASE(ADD) {
+        i64 value;
+        if(__builtin_add_overflow(R(b).integer, R(c).integer, &value)) [[unlikely]] goto integer_overflow;
+        R(a).integer = value;
+      } NEXT();
+      CASE(SUB) {
+        i64 value;
+        if(__builtin_sub_overflow(R(b).integer, R(c).integer, &value)) [[unlikely]] goto integer_overflow;
+        R(a).integer = value;
+      } NEXT();
+      CASE(MUL) {
+        i64 value;
+        if(__builtin_mul_overflow(R(b).integer, R(c).integer, &value)) [[unlikely]] goto integer_overflow;
+        R(a).integer = value;
+      } NEXT();
+      CASE(DIV) {
+        const i64 lhs = R(b).integer, rhs = R(c).integer;
+        if(rhs == 0) [[unlikely]] goto division_by_zero;
+        if(lhs == std::numeric_limits<i64>::min() and rhs == -1) [[unlikely]] goto integer_overflow;
+        R(a).integer = lhs / rhs;
+      } NEXT();
+      CASE(MOD) {
+        const i64 lhs = R(b).integer, rhs = R(c).integer;
+        if(rhs == 0) [[unlikely]] goto division_by_zero;
+        if(lhs == std::numeric_limits<i64>::min() and rhs == -1) [[unlikely]] goto integer_overflow;
+        R(a).integer = lhs % rhs;
+      } NEXT();
+      CASE(BIT_AND) R(a).integer = R(b).integer & R(c).integer; NEXT();
+      CASE(BIT_OR) R(a).integer = R(b).integer | R(c).integer; NEXT();
+      CASE(SHL) {
+        const i64 lhs = R(b).integer, rhs = R(c).integer;
+        if((u64)rhs >= 64) [[unlikely]] goto shift_out_of_range;
+        const i64 shifted = static_cast<i64>(static_cast<u64>(lhs) << rhs);
+        if(shifted >> rhs != lhs) [[unlikely]] goto integer_overflow;
+        R(a).integer = shifted;
+      } NEXT();
+      CASE(SHR) {
+        const i64 rhs = R(c).integer;
+        if((u64)rhs >= 64) [[unlikely]] goto shift_out_of_range;
+        R(a).integer = R(b).integer >> rhs;
+      } NEXT();
+      CASE(NEG) {
+        const i64 value = R(b).integer;
+        if(value == std::numeric_limits<i64>::min()) [[unlikely]] goto integer_overflow;
+        R(a).integer = -value;
+      } NEXT();
+      CASE(BIT_NOT) R(a).integer = ~R(b).integer; NEXT();
+      CASE(ADD_IMM) {
+        i64 value;
+        if(__builtin_add_overflow(R(b).integer, (i64)(i16)ip->c, &value)) [[unlikely]] goto integer_overflow;
+        R(a).integer = value;
+      } NEXT();
+
+      CASE(FADD) R(a).real = R(b).real + R(c).real; NEXT();
+      CASE(FSUB) R(a).real = R(b).real - R(c).real; NEXT();
+      CASE(FMUL) R(a).real = R(b).real * R(c).real; NEXT();
+      CASE(FDIV) {
+        if(R(c).real == 0.) [[unlikely]] goto division_by_zero;
+        R(a).real = R(b).real / R(c).real;
+      } NEXT();
+      CASE(FNEG) R(a).real = -R(b).real; NEXT();
+
+      CASE(EQ) R(a).integer = R(b).integer == R(c).integer; NEXT();
+      CASE(NE) R(a).integer = R(b).integer != R(c).integer; NEXT();
+      CASE(LT) R(a).integer = R(b).integer < R(c).integer; NEXT();
+      CASE(LE) R(a).integer = R(b).integer <= R(c).integer; NEXT();
+      CASE(FEQ) R(a).integer = R(b).real == R(c).real; NEXT();
+      CASE(FNE) R(a).integer = R(b).real != R(c).real; NEXT();
+      CASE(FLT) R(a).integer = R(b).real < R(c).real; NEXT();
+      CASE(FLE) R(a).integer = R(b).real <= R(c).real; NEXT();
+      CASE(REQ) R(a).integer = R(b).object == R(c).object; NEXT();
+      CASE(RNE) R(a).integer = R(b).object != R(c).object; NEXT();
+      CASE(SEQ) R(a).integer = runtime::equal(R(b).object, R(c).object); NEXT();
+      CASE(SNE) R(a).integer = not runtime::equal(R(b).object, R(c).object); NEXT();
+
+      CASE(NOT) R(a).integer = R(b).integer == 0; NEXT();
+      CASE(CONCAT) R(a).object = runtime::concatenate(R(b).object, R(c).object, SPAN()); NEXT();
+
+      CASE(NEW) R(a).object = std::make_shared<runtime::Cells>(ip->b); NEXT();
+      CASE(GET_FIELD) {
+        auto* object = static_cast<runtime::Cells*>(R(b).object.get());
+        if(not object) [[unlikely]] goto null_dereference;
+        R(a).integer = object->cells[ip->c].integer;
+      } NEXT();
+      CASE(GET_FIELD_REF) {
+        auto* object = static_cast<runtime::Cells*>(R(b).object.get());
+        if(not object) [[unlikely]] goto null_dereference;
+        runtime::Ref value = object->cells[ip->c].object;
+        R(a).object = std::move(value);
+      } NEXT();
+      CASE(SET_FIELD) {
+        auto* object = static_cast<runtime::Cells*>(R(a).object.get());
+        if(not object) [[unlikely]] goto null_dereference;
+        object->cells[ip->b].integer = R(c).integer;
+      } NEXT();
+      CASE(SET_FIELD_REF) {
+        auto* object = static_cast<runtime::Cells*>(R(a).object.get());
+        if(not object) [[unlikely]] goto null_dereference;
+        object->cells[ip->b].object = R(c).object;
+      } NEXT();
+
+      CASE(GET_ELEM) {
+        auto* object = static_cast<runtime::Cells*>(R(b).object.get());
+        if(not object) [[unlikely]] goto null_dereference;
+        index = R(c).integer;
+        if((u64)index >= object->cells.size()) [[unlikely]] { length = object->cells.size(); goto out_of_bounds; }
+        R(a).integer = object->cells[index].integer;
+      } NEXT();
+      CASE(GET_ELEM_REF) {
+        auto* object = static_cast<runtime::Cells*>(R(b).object.get());
+        if(not object) [[unlikely]] goto null_dereference;
+        index = R(c).integer;
+        if((u64)index >= object->cells.size()) [[unlikely]] { length = object->cells.size(); goto out_of_bounds; }
+        runtime::Ref value = object->cells[index].object;
+        R(a).object = std::move(value);
+      } NEXT();
+      CASE(SET_ELEM) {
+        auto* object = static_cast<runtime::Cells*>(R(a).object.get());
+        if(not object) [[unlikely]] goto null_dereference;
+        index = R(b).integer;
+        if((u64)index >= object->cells.size()) [[unlikely]] { length = object->cells.size(); goto out_of_bounds; }
+        object->cells[index].integer = R(c).integer;
+      } NEXT();
+      CASE(SET_ELEM_REF) {
+        auto* object = static_cast<runtime::Cells*>(R(a).object.get());
+        if(not object) [[unlikely]] goto null_dereference;
+        index = R(b).integer;
+        if((u64)index >= object->cells.size()) [[unlikely]] { length = object->cells.size(); goto out_of_bounds; }
+        object->cells[index].object = R(c).object;
+      } NEXT();
+      CASE(GET_CHAR) {
+        auto* object = static_cast<runtime::Text*>(R(b).object.get());
+        if(not object) [[unlikely]] goto null_dereference;
+        index = R(c).integer;
+        if((u64)index >= object->value.length()) [[unlikely]] { length = object->value.length(); goto out_of_bounds; }
+        R(a).integer = object->value[index];
+      } NEXT();
+
+      CASE(JUMP) ip = code + ip->c; DISPATCH();
+      CASE(JUMP_IF) ip = R(a).integer ? code + ip->c : ip + 1; DISPATCH();
+      CASE(JUMP_IF_NOT) ip = R(a).integer ? ip + 1 : code + ip->c; DISPATCH();
+      CASE(JEQ) ip = R(a).integer == R(b).integer ? code + ip->c : ip + 1; DISPATCH();
+      CASE(JNE) ip = R(a).integer != R(b).integer ? code + ip->c : ip + 1; DISPATCH();
+      CASE(JLT) ip = R(a).integer < R(b).integer ? code + ip->c : ip + 1; DISPATCH();
+      CASE(JLE) ip = R(a).integer <= R(b).integer ? code + ip->c : ip + 1; DISPATCH();
+      CASE(INC_JLT) {
+        i64 value;
+        if(__builtin_add_overflow(R(a).integer, (i64)1, &value)) [[unlikely]] goto integer_overflow;
+        R(a).integer = value;
+        ip = value < R(b).integer ? code + ip->c : ip + 1;
+      } DISPATCH();
+
+      CASE(CALL) {
+        const u32 callee = ip->b;
+        bytecode::Function const* target = &module.functions[callee];
+        if(target->code.empty()) [[unlikely]] target = &load(callee);
+        Cell* frame = base + ip->c;
+        if(frames.size() == limits.depth or target->registers > (u64)(end - frame)) [[unlikely]] goto stack_overflow;
+
+        frames.push_back({ (u32)(function - module.functions.data()), (u32)(ip - code), base });
+        function = target;
+        code = codeOf<Step>(callee);
+        ip = code;
+        base = frame;
+        ENTER();
+      } DISPATCH();
+      CASE(RETURN) {
+        const i64 value = R(a).integer;
+        if(frames.empty()) {
+          if(module.returns_int) exit = value;
+          return;
+        }
+        LEAVE();
+        R(a).integer = value;
+      } NEXT();
+      CASE(RETURN_REF) {
+        runtime::Ref value = std::move(R(a).object);
+        if(frames.empty()) return;
+        LEAVE();
+        R(a).object = std::move(value);
+      } NEXT();
+      CASE(RETURN_VOID) {
+        if(frames.empty()) return;
+        LEAVE();
+      } NEXT();
+      CASE(FALL_OFF) {
+        if(frames.empty()) runtime::fault("'main' ended without returning a value"s, function->span);
+        Frame const& caller = frames.back();
+        runtime::fault("'{}' ended without returning a value"f.format(function->name), module.functions[caller.function].spans[caller.at]);
+      }
+
+      CASE(PRINT) {
+        buffer.clear();
+        (*module.formats[ip->b])(buffer, R(a), 0);
+        buffer += '\n';
+        out.write(buffer.data(), (std::streamsize)buffer.size());
+      } NEXT();
+
+      case Opcode::COUNT: break;
+    }
+    return;
+
+#undef NEXT
+#undef CASE
+#undef DISPATCH
+#undef R
+#undef LEAVE
+#undef ENTER
+
+  integer_overflow:
+    runtime::fault("Integer overflow"s, SPAN());
+  division_by_zero:
+    runtime::fault("Division by 0"s, SPAN());
+  shift_out_of_range:
+    runtime::fault("Shift count out of range"s, SPAN());
+  null_dereference:
+    runtime::fault("Null dereference"s, SPAN());
+  out_of_bounds:
+    runtime::fault("Index {} out of bounds for length {}"f.format(index, length), SPAN());
+  stack_overflow:
+    runtime::fault("Stack overflow"s, SPAN());
+
+#undef SPAN
+  }
+
+}
@@ -0,0 +1,141 @@
+#include "Walker.hpp"
+
+namespace fridayc {
+
+  auto Walker::operator()(Identifier& arg) noexcept -> std::any {
+    return { };
+  }
+
+  auto Walker::operator()(BoolLiteral& arg) noexcept -> std::any {
+    return { };
+  }
+
+  auto Walker::operator()(ObjectLiteral& arg) noexcept -> std::any {
+    return { };
+  }
+
+  auto Walker::operator()(StringLiteral& arg) noexcept -> std::any {
+    return { };
+  }
+
+  auto Walker::operator()(FloatLiteral& arg) noexcept -> std::any {
+    return { };
+  }
+
+  auto Walker::operator()(IntLiteral& arg) noexcept -> std::any {
+    return { };
+  }
+
+  auto Walker::operator()(CharLiteral& arg) noexcept -> std::any {
+    return { };
+  }
+
+  auto Walker::operator()(PrefixExpression& arg) noexcept -> std::any {
+    visit(*arg.expr);
+    return { };
+  }
+
+  auto Walker::operator()(InfixExpression& arg) noexcept -> std::any {
+    visit(*arg.lhs);
+    visit(*arg.rhs);
+    return { };
+  }
+
+  auto Walker::operator()(CallExpression& arg) noexcept -> std::any {
+    visit(*arg.function);
+    for(auto& argument : arg) visit(*argument);
+    return { };
+  }
+
+  auto Walker::operator()(SubscriptExpression& arg) noexcept -> std::any {
+    visit(*arg.array);
+    visit(*arg.index);
+    return { };
+  }
+
+  auto Walker::operator()(TypeExpression& arg) noexcept -> std::any {
+    return { };
+  }
+
+  auto Walker::operator()(ExpressionStatement& arg) noexcept -> std::any {
+    visit(*arg.expr);
+    return { };
+  }
+
+  auto Walker::operator()(ArrayLiteral& arg) noexcept -> std::any {
+    for(auto& value : arg) visit(*value);
+    return { };
+  }
+
+  auto Walker::operator()(ReturnStatement& arg) noexcept -> std::any {
+    visit(*arg.expr);
+    return { };
+  }
+
+  auto Walker::operator()(PrintStatement& arg) noexcept -> std::any {
+    visit(*arg.expr);
+    return { };
+  }
+
+  auto Walker::operator()(BlockStatement& arg) noexcept -> std::any {
+    for(auto& stmt : arg) visit(*stmt);
+    return { };
+  }
+
+  auto Walker::operator()(IfStatement& arg) noexcept -> std::any {
+    visit(*arg.condition);
+    visit(*arg.block);
+    if(arg.alternative) visit(*arg.alternative);
+    return { };
+  }
+
+  auto Walker::operator()(WhileStatement& arg) noexcept -> std::any {
+    visit(*arg.condition);
+    visit(*arg.block);
+    return { };
+  }
+
+  auto Walker::operator()(ForStatement& arg) noexcept -> std::any {
+    visit(*arg.initializer);
+    visit(*arg.condition);
+    visit(*arg.modifier);
+    visit(*arg.block);
+    return { };
+  }
+
+  auto Walker::operator()(StructStatement& arg) noexcept -> std::any {
+    for(Member& field : arg.fields) visit(*field.type);
+    return { };
+  }
+
+  auto Walker::operator()(EnumStatement& arg) noexcept -> std::any {
+    return { };
+  }
+
+  auto Walker::operator()(FunctionStatement& arg) noexcept -> std::any {
+    for(Member& parameter : arg.args) visit(*parameter.type);
+    visit(*arg.return_type);
+    visit(*arg.block);
+    return { };
+  }
+
+  auto Walker::operator()(NamespaceStatement& arg) noexcept -> std::any {
+    return { };
+  }
+
+  auto Walker::operator()(UsingStatement& arg) noexcept -> std::any {
+    return { };
+  }
+
+  auto Walker::operator()(DeclarationStatement& arg) noexcept -> std::any {
+    visit(*arg.type);
+    if(arg.expr) visit(*arg.expr);
+    return { };
+  }
+
+  auto Walker::operator()(Program& arg) noexcept -> std::any {
+    visit(*arg.block);
+    return { };
+  }
+
+}
@@ -1,19 +1,30 @@
 #include "Math.hpp"
 #include "Tokenizer.hpp"
 #include "Parser.hpp"
+#include "AstLoader.hpp"
+#include "ConstantFolder.hpp"
+#include "ConstEvaluator.hpp"
+#include "TreeShaker.hpp"
+#include "Inliner.hpp"
+#include "LoopOptimizer.hpp"
+#include "BoundsAnalyzer.hpp"
+#include "EscapeAnalyzer.hpp"
+#include "CallGraph.hpp"
+#include "Executor.hpp"
+#include "BytecodeCompiler.hpp"
+#include "Peephole.hpp"
+#include "VirtualMachine.hpp"
+#include "Jit.hpp"
+#include "ModuleFile.hpp"
+#include "CBackend.hpp"
+#include "NativeCompiler.hpp"
+#include "SsaBuilder.hpp"
+#include "SsaOptimizer.hpp"
+#include "Analyzer.hpp"
+#include "ThreadPool.hpp"
 
 using namespace fridayc;
-
-struct ConsoleColor {
-  static constexpr const auto BLACK = "\u001B[30m"sv;
-  static constexpr const auto RED = "\u001B[31m"sv;
-  static constexpr const auto GREEN = "\u001B[32m"sv;
-  static constexpr const auto YELLOW = "\u001B[33m"sv;
-  static constexpr const auto BLUE = "\u001B[34m"sv;
-  static constexpr const auto PURPLE = "\u001B[35m"sv;
-  static constexpr const auto CYAN = "\u001B[36m"sv;
-  static constexpr const auto WHITE = "\u001B[37m"sv;  
-};
+using bytecode::ModuleFile;
 
 auto read(std::string path) noexcept -> std::string {
   const auto file = std::ifstream{ path };
@@ -22,43 +33,277 @@ auto read(std::string path) noexcept -> std::string {
   return stream.str();
 }
 
+/// @brief Runs 'main' of a bytecode module on the JIT
+auto runJit(bytecode::Module& module, i64& status) -> std::vector<Error> {
+  Jit jit(module, std::cout);
+  std::vector<Error> errors = jit.compile();
+  if(errors.empty()) errors = jit.run();
+  status = jit.status();
+  return errors;
+}
+
+/// @brief Runs 'main' of a precompiled module, or prints its bytecode
+auto runModule(std::string const& path, bool threaded, bool jit, bool bytecode) -> i32 {
+  auto [module, errors] = ModuleFile::load(path);
+
+  i64 status = 0;
+  if(errors.empty() and bytecode) {
+    for(u32 index = 0; index < module.functions.size(); ++index) module.materialize(index);
+    module.disassemble(std::cout);
+  } else if(errors.empty() and jit) {
+    errors = runJit(module, status);
+    std::cout.flush();
+  } else if(errors.empty()) {
+    VirtualMachine machine(module, std::cout);
+    errors = machine.run(threaded ? VirtualMachine::Dispatch::THREADED : VirtualMachine::Dispatch::SWITCH);
+    status = machine.status();
+    std::cout.flush();
+  }
+
+  std::ranges::for_each(errors, report);
+  return errors.empty() ? (i32)status : 1;
+}
+
 auto main(i32 argc, const i8* argv[]) -> i32 {
 
-  std::string path = argv[1];
-  std::string input = read(path);
+  // * --check runs the semantic passes and reports errors instead of printing the tree
+  // * --fold collapses constant expressions, evaluates constants and pure calls, and reports what was folded
+  // * --shake removes the declarations unreachable from main and from every --root=<name>
+  // * --hoist moves loop invariants out of loops and strength-reduces subscripts
+  // * --inline replaces calls to small expression-bodied functions by their body
+  // * --bounds reports the bounds check every subscript needs
+  // * --regions reports which struct and array literals die with their call or loop iteration, --run then makes those in a region
+  // * --calls builds the call graph and reports what the function summaries found
+  // * --run runs main instead of printing the tree, the exit status is what main returns
+  // * --vm runs main on the bytecode virtual machine instead, --switch dispatches its instructions with a plain switch
+  // * --jit compiles the bytecode to machine code and runs main on it instead, listing the functions for perf
+  // * --bytecode prints the bytecode of the functions reachable from main instead of the tree
+  // * --emit=<file> writes the bytecode of main to a precompiled module file, which runs on the vm when passed as <file>
+  // * --c=<file> writes main and every function it may call as C, --native=<file> also compiles it to an executable or a shared library
+  // * --object=<file> compiles the bytecode to an x86-64 ELF object, --aot=<file> also links it with the fridaylib next to fridayc into an executable
+  // * --ssa prints the SSA form of main and every function it may call after the optimization pipeline, verified after every pass
+  bool check = false;
+  bool fold = false;
+  bool shake = false;
+  bool hoist = false;
+  bool expand = false;
+  bool bounds = false;
+  bool regions = false;
+  bool calls = false;
+  bool run = false;
+  bool vm = false;
+  bool threaded = true;
+  bool jit = false;
+  bool bytecode = false;
+  bool ssa = false;
+  std::string emit;
+  std::string c;
+  std::string native;
+  std::string object;
+  std::string aot;
+  std::vector<Symbol> roots = { Symbol::intern("main"sv) };
+  std::string path;
+  for(i32 i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if(arg == "--check"sv) check = true;
+    else if(arg == "--fold"sv) fold = true;
+    else if(arg == "--shake"sv) shake = true;
+    else if(arg == "--hoist"sv) hoist = true;
+    else if(arg == "--inline"sv) expand = true;
+    else if(arg == "--bounds"sv) bounds = true;
+    else if(arg == "--regions"sv) regions = true;
+    else if(arg == "--calls"sv) calls = true;
+    else if(arg == "--run"sv) run = true;
+    else if(arg == "--vm"sv) vm = true;
+    else if(arg == "--switch"sv) vm = true, threaded = false;
+    else if(arg == "--jit"sv) jit = true;
+    else if(arg == "--bytecode"sv) bytecode = true;
+    else if(arg == "--ssa"sv) ssa = true;
+    else if(arg.starts_with("--emit="sv)) emit = arg.substr("--emit="sv.size());
+    else if(arg.starts_with("--c="sv)) c = arg.substr("--c="sv.size());
+    else if(arg.starts_with("--native="sv)) native = arg.substr("--native="sv.size());
+    else if(arg.starts_with("--object="sv)) object = arg.substr("--object="sv.size());
+    else if(arg.starts_with("--aot="sv)) aot = arg.substr("--aot="sv.size());
+    else if(arg.starts_with("--root="sv)) roots.push_back(Symbol::intern(arg.substr("--root="sv.size())));
+    else path = arg;
+  }
+
+  if(path.empty()) {
+    std::cerr << "Usage: fridayc [--check] [--fold] [--shake] [--root=<name>]... [--hoist] [--inline] [--bounds] [--regions] [--calls] [--run] [--vm] [--switch] [--jit] [--bytecode] [--ssa] [--emit=<file>] [--c=<file>] [--native=<file>] [--object=<file>] [--aot=<file>] <file>" << std::endl;
+    return 1;
+  }
+
+  // * A precompiled module is mapped and run as it is, none of the passes apply to it
+  if(path.ends_with(".fxc"sv)) return runModule(path, threaded, jit, bytecode);
+
+  const u32 file = Sources::add(path, read(path));
+  std::string_view input = Sources::text(file);
+
+  // * A dumped abstract syntax tree is loaded back instead of being parsed
+  auto [program, errors] = path.ends_with(".json") ?
+    AstLoader(file).load()
+      : Parser(Tokenizer(input).collect<std::vector>(), file).parse();
+
+  if(errors.empty() and shake) {
+    TreeShaker shaker(std::move(roots));
+    shaker.shake(program);
+    std::cerr << "Removed {} declarations ({} bytes)"f.format(shaker.removed(), shaker.removedBytes()) << std::endl;
+  }
+
+  ConstantFolder folder;
+  if(errors.empty() and fold) folder.fold(program);
+
+  ThreadPool pool;
+  TypeTable types;
+  Analyzer analyzer(types, pool);
+  if(errors.empty() and (check or fold or hoist or expand or bounds or regions or calls)) errors = analyzer.analyze(program);
+
+  // * Temporaries are typed from the analysis, so loops are optimized before inlining adds untyped copies
+  if(errors.empty() and hoist) {
+    LoopOptimizer optimizer(analyzer, types);
+    optimizer.optimize(program);
+    std::cerr << "Hoisted {} expressions, reduced {} products"f.format(optimizer.hoistedExpressions(), optimizer.reducedProducts()) << std::endl;
+  }
+
+  // * Inlining needs the bindings of the analysis, and what it inlines may fold further
+  if(errors.empty() and expand) {
+    Inliner inliner;
+    inliner.expand(program);
+    std::cerr << "Inlined {} calls"f.format(inliner.inlinedCalls()) << std::endl;
+    if(fold and inliner.inlinedCalls()) folder.fold(program);
+  }
+
+  if(errors.empty() and fold)
+    std::cerr << "Folded {} expressions ({} operations)"f.format(folder.folded(), folder.evaluated()) << std::endl;
+
+  // * Evaluation needs the bindings and frame slots of the analysis
+  if(errors.empty() and fold) {
+    ConstEvaluator evaluator;
+    evaluator.evaluate(program);
+    std::cerr << "Evaluated {} constants and {} calls ({} memoized)"f.format(evaluator.evaluatedConstants(), evaluator.substitutedCalls(), evaluator.memoizedCalls()) << std::endl;
+  }
+
+  // * Bounds are classified on the final tree, whose subscripts are the ones a backend sees
+  if(errors.empty() and bounds) {
+    BoundsAnalyzer analysis;
+    analysis.analyze(program);
+    analysis.report(std::cerr);
+    std::cerr << "Classified {} subscripts: {} in bounds, {} checked on loop entry, {} checked"f.format(
+      analysis.count(BoundsCheck::Kind::IN_BOUNDS) + analysis.count(BoundsCheck::Kind::HOISTED) + analysis.count(BoundsCheck::Kind::CHECKED),
+      analysis.count(BoundsCheck::Kind::IN_BOUNDS), analysis.count(BoundsCheck::Kind::HOISTED), analysis.count(BoundsCheck::Kind::CHECKED)) << std::endl;
+  }
+
+  if(errors.empty() and regions) {
+    EscapeAnalyzer analysis;
+    analysis.analyze(program);
+    analysis.report(std::cerr);
+    std::cerr << "Classified {} literals: {} die with their call, {} with a loop iteration, {} escape"f.format(
+      analysis.count(Lifetime::Kind::CALL) + analysis.count(Lifetime::Kind::ITERATION) + analysis.count(Lifetime::Kind::HEAP),
+      analysis.count(Lifetime::Kind::CALL), analysis.count(Lifetime::Kind::ITERATION), analysis.count(Lifetime::Kind::HEAP)) << std::endl;
+  }
+
+  if(errors.empty() and calls) {
+    CallGraph graph(pool);
+    graph.build(program);
+
+    u64 pure = 0, recursive = 0;
+    for(auto& stmt : *program.block)
+      if(auto* function = dynamic_cast<FunctionStatement*>(stmt.get())) {
+        FunctionSummary const* summary = graph.summary(*function);
+        pure += summary->pure;
+        recursive += summary->recursive;
+      }
+    std::cerr << "Call graph of {} functions and {} calls in {} components: {} pure, {} recursive"f.format(
+      graph.functionCount(), graph.edgeCount(), graph.componentCount(), pure, recursive) << std::endl;
+  }
+
+  // * Passes after the analysis add nodes it never typed, so the final tree is analyzed again
+  i64 status = 0;
+  const bool generates = not c.empty() or not native.empty();
+  const bool objects = not object.empty() or not aot.empty();
+  if(errors.empty() and (run or vm or jit or bytecode or ssa or not emit.empty() or generates or objects)) {
+    TypeTable final_types;
+    Analyzer final_analyzer(final_types, pool);
+    errors = final_analyzer.analyze(program);
+
+    if(errors.empty() and (vm or jit or bytecode or not emit.empty() or objects)) {
+      BytecodeCompiler compiler(final_analyzer, final_types);
+      errors = compiler.compile(program);
+
+      Peephole peephole;
+      if(errors.empty()) peephole.optimize(compiler.module());
+
+      if(errors.empty() and bytecode) {
+        compiler.module().disassemble(std::cout);
+        std::cerr << "Formed {} superinstructions, removed {} instructions"f.format(peephole.superinstructions(), peephole.removedInstructions()) << std::endl;
+      }
+
+      if(errors.empty() and not emit.empty()) errors = ModuleFile::write(compiler.module(), file, emit);
 
-  const auto tokens = Tokenizer(input).collect<std::vector>();
+      // * Without a file of its own, the object of an executable is written next to it
+      if(errors.empty() and objects) {
+        const std::string output = object.empty() ? aot + ".o" : object;
+        NativeCompiler native_compiler(compiler.module(), file);
+        errors = native_compiler.compile();
+        if(errors.empty()) errors = native_compiler.write(output);
+        if(errors.empty() and not aot.empty()) {
+          const auto library = std::filesystem::path(argv[0]).parent_path() / ".." / "lib";
+          errors = NativeCompiler::link(output, aot, library.string());
+        }
+        if(errors.empty())
+          std::cerr << "Allocated {} registers to machine registers, spilled {}"f.format(native_compiler.allocatedIntervals(), native_compiler.spilledIntervals()) << std::endl;
+      }
 
-  const auto [program, errors] = Parser(std::move(tokens)).parse();
+      if(errors.empty() and jit) errors = runJit(compiler.module(), status);
+      else if(errors.empty() and vm) {
+        VirtualMachine machine(compiler.module(), std::cout);
+        errors = machine.run(threaded ? VirtualMachine::Dispatch::THREADED : VirtualMachine::Dispatch::SWITCH);
+        status = machine.status();
+      }
+    }
 
-  const auto lines = input
-  | std::views::split('\n')
-  | std::views::transform([](auto view) { return std::string_view{view}; })
-  | std::ranges::to<std::vector>();
+    if(errors.empty() and ssa) {
+      SsaBuilder builder(final_analyzer, final_types);
+      errors = builder.build(program);
+      if(errors.empty()) errors = builder.module().verify();
 
-  const auto max_digits = (u32)std::ceil(std::log10(lines.size())); 
+      SsaOptimizer optimizer;
+      if(errors.empty()) errors = optimizer.optimize(builder.module(), true);
+      if(errors.empty()) {
+        builder.module().print(std::cout, final_types);
+        std::cerr << "Promoted {} slots ({} phis), folded {} values and {} branches, numbered {} values, removed {} values and {} blocks"f.format(
+          optimizer.promotedSlots(), optimizer.placedPhis(), optimizer.foldedValues(), optimizer.foldedBranches(),
+          optimizer.numberedValues(), optimizer.removedValues(), optimizer.removedBlocks()) << std::endl;
+      }
+    }
 
-  const auto raise_error = [&path, &lines, max_digits](Error const& error) {
-    std::string_view line = lines[error.row-1];
-    u64 col = std::min(line.length(), (u64)error.col-1);
-    u64 col2 = std::min(line.length(), col + error.length);
+    // * Without a file of its own, the C of a native build is written next to the output
+    if(errors.empty() and generates) {
+      const std::string source = c.empty() ? native + ".c" : c;
+      CBackend backend(final_analyzer, final_types);
+      errors = backend.generate(program);
+      if(errors.empty()) errors = backend.write(source);
+      if(errors.empty() and not native.empty()) errors = CBackend::build(source, native);
+    }
 
-    std::cout 
-    << ConsoleColor::RED << "[ERROR] " << ConsoleColor::WHITE 
-    << "In file " << path << ':' << error.row << ':' << error.col << ": " 
-    << ConsoleColor::RED << error.message << ConsoleColor::WHITE << '\n'
-    << "  " << std::setw(max_digits) << std::right << error.row << "  |  "
-    << line.substr(0, col) << ConsoleColor::RED 
-    << line.substr(col, error.length) << ConsoleColor::WHITE 
-    << line.substr(col2) << '\n'
-    << std::setfill(' ') << std::setw(max_digits + 4) << "" << "|  "
-    << std::setfill(' ') << std::setw(col) << "" << ConsoleColor::RED << '^'
-    << std::setfill('~') << std::setw(error.length-1) << "" << ConsoleColor::WHITE << std::endl;
-  };
+    // * Lifetimes are found again on the tree the final analysis bound
+    if(errors.empty() and run and not vm and not jit and not bytecode and not ssa and emit.empty()) {
+      EscapeAnalyzer escapes;
+      if(regions) escapes.analyze(program);
+      Executor executor(final_analyzer, final_types, std::cout, { }, regions ? &escapes : nullptr);
+      errors = executor.run(program);
+      status = executor.status();
+      if(regions)
+        std::cerr << "Made {} objects ({} cells) in regions and {} objects ({} cells) on the heap, regions peaked at {} bytes"f.format(
+          executor.regionObjects(), executor.regionCells(), executor.heapObjects(), executor.heapCells(), executor.regions().peakBytes()) << std::endl;
+    }
+    std::cout.flush();
+  }
 
-  if(errors.empty()) {
-    std::println("{}", program.toString());
-  } else std::ranges::for_each(errors, raise_error);
+  if(errors.empty() and not check and not run and not vm and not jit and not bytecode and not ssa and emit.empty() and not generates and not objects) {
+    program.write(std::cout, pool);
+    std::cout << std::endl;
+  } else std::ranges::for_each(errors, report);
 
-  return 0;
+  return errors.empty() ? (i32)status : 1;
 }
@@ -0,0 +1,44 @@
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Analyzes programs on the pool and checks errors come out in source order and every node keeps its type.
+
+auto main() -> i32 {
+  ThreadPool pool;
+
+  Compiled mixed("mixed"sv, R"(
+    fn first() -> int {
+      return true;
+    }
+
+    struct Point {
+      x: Missing;
+    }
+
+    fn second() -> int {
+      return 'c';
+    }
+  )"sv, pool);
+  check(mixed.errors.size() == 3, "every error is reported");
+  check(std::ranges::is_sorted(mixed.errors, { }, [](Error const& error) { return error.span.offset; }),
+    "errors of bodies and declarations come out in source order");
+  if(mixed.errors.size() == 3) check(mixed.errors[1].message.contains("Missing"sv), "the declaration error sits between the body errors");
+
+  // * Enough functions that every worker checks some of them
+  std::string source;
+  const u32 count = pool.size() * 16;
+  for(u32 i = 0; i < count; ++i) source += "fn f{}(x: int) -> int {{ return x + {}; }}\n"f.format(i, i);
+  Compiled many("many"sv, source, pool);
+  check(many.errors.empty(), "the functions check");
+
+  u32 typed = 0;
+  for(auto& stmt : *many.program.block)
+    if(auto* function = dynamic_cast<FunctionStatement*>(stmt.get()))
+      if(auto* body = dynamic_cast<ReturnStatement*>((*function->block)[0].get()))
+        typed += many.analyzer.typeOf(*body->expr) == TypeId::INT;
+  check(typed == count, "the analyzer knows the type of every body, whichever worker checked it");
+
+  return status();
+}
@@ -0,0 +1,74 @@
+#include "AstLoader.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Dumps a program using every kind of node, loads the dump back and checks it dumps the same,
+// * then checks malformed dumps are refused.
+
+namespace {
+
+  auto load(std::string_view name, std::string text) -> std::tuple<Program, std::vector<Error>> {
+    return AstLoader(Sources::add(std::string(name), std::move(text))).load();
+  }
+
+}
+
+auto main() -> i32 {
+  const u32 file = Sources::add("program"s, std::string(R"(
+    namespace shapes;
+    using math;
+
+    enum Color { RED, GREEN, BLUE }
+
+    struct Point {
+      y: float;
+      x: float;
+      tags: string[][];
+    }
+
+    fn area(w: int, h: int) -> int => w * h;
+
+    fn main() -> int {
+      let total: int = 0;
+      const name: string = "tab\there \"quoted\" \\ done";
+      const letter: char = '\n';
+      const ratio: float = 2.5;
+      let values: int[] = [1, -2, 3];
+      let i: int = 0;
+      for i = 0; i < 3; i += 1; {
+        total += values[i] * area(i, 2);
+      }
+      while not (total > 100) and total != 7 {
+        total = total * 2 + 1;
+      }
+      if total % 2 == 0 {
+        print name;
+      } elif total < 0 {
+        print letter;
+      } else {
+        print ratio;
+      }
+      return total;
+    }
+  )"sv));
+  auto [program, errors] = Parser(Tokenizer(Sources::text(file)).collect<std::vector>(), file).parse();
+  check(errors.empty(), "the program parses");
+
+  const std::string dump = program.toString();
+  auto [loaded, failures] = load("dump"sv, dump);
+  check(failures.empty(), "the dump loads");
+  check(loaded.toString() == dump, "the loaded program dumps as the parsed one");
+
+  auto [again, refused] = load("reloaded"sv, loaded.toString());
+  check(refused.empty() and again.toString() == dump, "a dump of a loaded program loads too");
+
+  check(not std::get<1>(load("truncated"sv, dump.substr(0, dump.size() / 2))).empty(), "a truncated dump is refused");
+  check(not std::get<1>(load("unknown"sv, R"({"type": "Program", "block": {"type": "BlockStatement", "statements": [{"type": "Bogus"}]}})"s)).empty(),
+    "an unknown node type is refused");
+  check(not std::get<1>(load("untyped"sv, R"({"block": {"type": "BlockStatement", "statements": []}, "type": "Program"})"s)).empty(),
+    "a node whose first key is not its type is refused");
+
+  return status();
+}
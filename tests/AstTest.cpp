@@ -0,0 +1,36 @@
+#include "Tokenizer.hpp"
+#include "Parser.hpp"
+#include "ThreadPool.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Serializes a program with many top-level statements on pools of different sizes
+// * and checks every way of writing it gives the text of the sequential toString().
+
+auto main() -> i32 {
+  std::string source;
+  for(u32 i = 0; i < 500; ++i)
+    source += "struct S{} {{ a: int; b: float; }}\nfn f{}(x: int) -> int {{ return x * {} + 1; }}\n"f.format(i, i, i);
+
+  const u32 file = Sources::add("many"s, std::move(source));
+  auto [program, errors] = Parser(Tokenizer(Sources::text(file)).collect<std::vector>(), file).parse();
+  check(errors.empty() and program.block->size() == 1000, "the program parses");
+
+  const std::string expected = program.toString();
+  for(const u32 threads : { 1u, 3u, 0u }) {
+    ThreadPool pool(threads);
+    check(program.toString(pool) == expected, "the text is the same with {} workers"f.format(pool.size()));
+
+    std::ostringstream stream;
+    program.write(stream, pool);
+    check(stream.str() == expected, "the stream gets the same text with {} workers"f.format(pool.size()));
+  }
+
+  auto [empty, none] = Parser(Tokenizer(""sv).collect<std::vector>(), file).parse();
+  ThreadPool pool;
+  check(empty.toString(pool) == empty.toString(), "an empty program is written alike");
+
+  return status();
+}
@@ -0,0 +1,120 @@
+#include "Executor.hpp"
+#include "BytecodeCompiler.hpp"
+#include "Peephole.hpp"
+#include "VirtualMachine.hpp"
+#include "Jit.hpp"
+#include "NativeCompiler.hpp"
+#include "Process.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Runs every benchmark program on the Executor, on the VirtualMachine with both dispatches, on the Jit
+// * and as an executable linked from the object of the NativeCompiler, and checks they all print and
+// * return the same. The Jit is skipped where it does not run, the executable without a C compiler or
+// * without the fridaylib of the build. The executable only exits with the low byte of what 'main' returns.
+
+namespace {
+
+  struct Run {
+    std::string          output;
+    std::optional<i64>   status;
+  };
+
+  auto read(std::filesystem::path const& path) -> std::string {
+    std::ifstream file { path };
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    return stream.str();
+  }
+
+  auto root() -> std::filesystem::path {
+    return std::filesystem::path(__FILE__).parent_path().parent_path();
+  }
+
+  auto programs() -> std::vector<std::filesystem::path> {
+    std::vector<std::filesystem::path> paths;
+    for(auto const& entry : std::filesystem::directory_iterator(root() / "benchmarks"))
+      if(entry.path().extension() == ".fx") paths.push_back(entry.path());
+    std::ranges::sort(paths);
+    return paths;
+  }
+
+  auto linkable(std::filesystem::path const& library) -> bool {
+    return std::filesystem::exists(library / "libfridaylib.a") and spawn({ command("CC", "cc"sv).front(), "--version"s }, NOWHERE) == 0;
+  }
+
+}
+
+auto main() -> i32 {
+  const std::vector<std::filesystem::path> paths = programs();
+  check(not paths.empty(), "the benchmarks directory has programs");
+
+  const auto library = root() / "lib";
+  const bool native = linkable(library);
+  if(not Jit::available()) std::cerr << "The JIT does not run on this platform, skipped" << std::endl;
+  if(not native) std::cerr << "No C compiler or no fridaylib in {}, executables skipped"f.format(library.string()) << std::endl;
+
+  const auto scratch = std::filesystem::temp_directory_path() / "fridayc-backends";
+  std::filesystem::create_directories(scratch);
+
+  ThreadPool pool;
+  for(auto const& path : paths) {
+    const std::string name = path.filename().string();
+    Compiled compiled(path.string(), read(path), pool);
+    check(compiled.errors.empty(), "{} compiles"f.format(name));
+    if(not compiled.errors.empty()) continue;
+
+    Run expected;
+    {
+      std::ostringstream out;
+      Executor executor(compiled.analyzer, compiled.types, out);
+      if(executor.run(compiled.program).empty()) expected = { out.str(), executor.status() };
+    }
+    check(expected.status.has_value(), "{} runs on the Executor"f.format(name));
+
+    BytecodeCompiler compiler(compiled.analyzer, compiled.types);
+    const bool lowered = compiler.compile(compiled.program).empty();
+    check(lowered, "{} compiles to bytecode"f.format(name));
+    if(not lowered) continue;
+    Peephole peephole;
+    peephole.optimize(compiler.module());
+
+    for(const auto dispatch : { VirtualMachine::Dispatch::THREADED, VirtualMachine::Dispatch::SWITCH }) {
+      std::ostringstream out;
+      VirtualMachine vm(compiler.module(), out);
+      const bool ran = vm.run(dispatch).empty();
+      check(ran and out.str() == expected.output and vm.status() == expected.status,
+        "{} runs on the VirtualMachine with {} dispatch like on the Executor"f.format(name, dispatch == VirtualMachine::Dispatch::THREADED ? "threaded"sv : "switch"sv));
+    }
+
+    if(Jit::available()) {
+      std::ostringstream out;
+      Jit jit(compiler.module(), out);
+      const bool ran = jit.compile().empty() and jit.run().empty();
+      check(ran and out.str() == expected.output and jit.status() == expected.status, "{} runs on the Jit like on the Executor"f.format(name));
+    }
+
+    if(native) {
+      const auto object = scratch / path.filename().replace_extension(".o");
+      const auto executable = scratch / path.filename().replace_extension("");
+      const auto printed = scratch / path.filename().replace_extension(".out");
+
+      NativeCompiler backend(compiler.module(), compiled.file);
+      std::vector<Error> errors = backend.compile();
+      if(errors.empty()) errors = backend.write(object.string());
+      if(errors.empty()) errors = NativeCompiler::link(object.string(), executable.string(), library.string());
+      check(errors.empty(), "{} links into an executable"f.format(name));
+
+      if(errors.empty()) {
+        const std::optional<i32> exited = spawn({ executable.string() }, printed.string());
+        check(read(printed) == expected.output and expected.status and exited == (*expected.status & 0xFF),
+          "{} runs as an executable like on the Executor"f.format(name));
+      }
+    }
+  }
+
+  std::filesystem::remove_all(scratch);
+  return status();
+}
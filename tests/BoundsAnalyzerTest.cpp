@@ -0,0 +1,104 @@
+#include "BoundsAnalyzer.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Classifies the subscripts of a function and checks which need no check, which are checked
+// * once on entry to their loop and which are checked on every access.
+
+namespace {
+
+  /// @brief Every subscript of a program, in the order the analyzer reports them
+  struct Subscripts : public Walker {
+    std::vector<SubscriptExpression const*> found { };
+
+    using Walker::operator();
+
+    auto operator()(SubscriptExpression& arg) noexcept -> std::any override {
+      Walker::operator()(arg);
+      found.push_back(&arg);
+      return { };
+    }
+  };
+
+}
+
+auto main() -> i32 {
+  ThreadPool pool;
+  Compiled compiled("bounds"sv, R"(
+    fn main(n: int) -> int {
+      const values: int[] = [1, 2, 3, 4];
+      let data: int[] = [5, 6, 7, 8];
+      let total: int = values[2] + values[7];
+      let i: int = 0;
+      for i = 0; i < 4; i += 1; {
+        total += values[i];
+      }
+      for i = 0; i <= 4; i += 1; {
+        total += values[i];
+      }
+      for i = 3; i >= 0; i -= 1; {
+        total += values[3 - i];
+      }
+      for i = 0; i < n; i += 1; {
+        total += data[2 * i + 1] + data[n] + data[total];
+      }
+      let j: int = 0;
+      while j < n {
+        total += data[j - 1];
+        j = j + 2;
+      }
+      while total < n {
+        total += data[total];
+      }
+      return total;
+    }
+  )"sv, pool);
+  check(compiled.errors.empty(), "the program compiles");
+
+  BoundsAnalyzer analysis;
+  analysis.analyze(compiled.program);
+  Subscripts subscripts;
+  subscripts.visit(compiled.program);
+
+  using enum BoundsCheck::Kind;
+  const std::vector<BoundsCheck::Kind> expected {
+    IN_BOUNDS, CHECKED,          // * constant indices of a constant array, within it and past it
+    IN_BOUNDS,                   // * a loop over exactly the constant array
+    HOISTED,                     // * a loop reaching one past its end
+    IN_BOUNDS,                   // * a loop counting down, the index counting up
+    HOISTED, HOISTED, CHECKED,   // * an affine index, an invariant one and one the loop assigns
+    HOISTED,                     // * a 'while' loop stepping its variable last
+    CHECKED,                     // * a 'while' loop without an induction variable
+  };
+
+  std::vector<BoundsCheck::Kind> kinds;
+  for(SubscriptExpression const* subscript : subscripts.found)
+    if(BoundsCheck const* found = analysis.check(*subscript)) kinds.push_back(found->kind);
+  check(kinds == expected, "every subscript gets the check it needs");
+  check(analysis.count(IN_BOUNDS) == 3 and analysis.count(HOISTED) == 4 and analysis.count(CHECKED) == 3, "each kind is counted");
+
+  if(subscripts.found.size() == expected.size()) {
+    BoundsCheck const& affine = *analysis.check(*subscripts.found[5]);
+    check(affine.variable and affine.variable->id.view() == "i"sv and affine.scale == 2 and affine.offset == 1 and affine.step == 1 and affine.ascending,
+      "an affine index keeps its scale and offset");
+
+    BoundsCheck const& invariant = *analysis.check(*subscripts.found[6]);
+    check(not invariant.variable and invariant.loop == affine.loop and invariant.terms.size() == 1, "an invariant index is checked on entry without a variable");
+
+    BoundsCheck const& stepped = *analysis.check(*subscripts.found[8]);
+    check(stepped.variable and stepped.variable->id.view() == "j"sv and stepped.step == 2 and stepped.offset == -1 and not stepped.inclusive,
+      "a 'while' loop steps by its last statement");
+
+    BoundsCheck const& down = *analysis.check(*subscripts.found[4]);
+    check(not down.ascending and down.inclusive and down.scale == -1 and down.offset == 3, "a loop counting down is described");
+  }
+
+  std::ostringstream report;
+  analysis.report(report);
+  check(std::ranges::count(report.str(), '\n') == (i64)expected.size() and report.str().contains("'values[2]' is in bounds"sv),
+    "the report has one line per subscript");
+
+  return status();
+}
@@ -0,0 +1,56 @@
+#include "BytecodeCompiler.hpp"
+#include "VirtualMachine.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Compiles programs to bytecode, runs them on the VirtualMachine with both dispatches,
+// * and checks what cannot be encoded in the 16-bit operands is refused.
+
+auto main() -> i32 {
+  ThreadPool pool;
+
+  Compiled loops("loops"sv, R"(
+    fn step(n: int) -> int {
+      if n % 2 == 0 {
+        return n / 2;
+      }
+      return 3 * n + 1;
+    }
+
+    fn main() -> int {
+      let n: int = 27;
+      let steps: int = 0;
+      while n != 1 {
+        n = step(n);
+        steps += 1;
+      }
+      print steps;
+      return steps;
+    }
+  )"sv, pool);
+  check(loops.errors.empty(), "the program compiles");
+
+  BytecodeCompiler compiler(loops.analyzer, loops.types);
+  if(loops.errors.empty()) check(compiler.compile(loops.program).empty(), "the program compiles to bytecode");
+
+  for(VirtualMachine::Dispatch dispatch : { VirtualMachine::Dispatch::THREADED, VirtualMachine::Dispatch::SWITCH }) {
+    std::ostringstream out;
+    VirtualMachine machine(compiler.module(), out);
+    check(machine.run(dispatch).empty() and machine.status() == 111 and out.str() == "111\n"s, "calls, loops and jumps run");
+  }
+
+  // * Past 65535 instructions, jumps could no longer reach every instruction
+  std::string source = "fn main() -> int {\n  let x: int = 1;\n  if x > 0 {\n"s;
+  for(u32 i = 0; i < 70'000; ++i) source += "    print x;\n"s;
+  source += "  }\n  return x;\n}\n"s;
+
+  Compiled large("large"sv, source, pool);
+  check(large.errors.empty(), "the large function compiles");
+
+  BytecodeCompiler refusing(large.analyzer, large.types);
+  if(large.errors.empty()) check(reports(refusing.compile(large.program), "'main' is too large for the bytecode"sv), "a function too large for its jumps is refused");
+
+  return status();
+}
@@ -0,0 +1,51 @@
+#include "Executor.hpp"
+#include "CBackend.hpp"
+#include "Process.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Builds a program with the CBackend into a directory whose name a shell would misread,
+// * and checks the executable exits like the Executor. Skipped without a C compiler.
+
+auto main() -> i32 {
+  if(spawn({ command("CC", "cc"sv).front(), "--version"s }, NOWHERE) != 0) {
+    std::cerr << "No C compiler, skipped" << std::endl;
+    return 0;
+  }
+
+  ThreadPool pool;
+  Compiled compiled("native"sv, R"(
+    fn main() -> int {
+      let total: int = 0;
+      let i: int = 0;
+      for i = 1; i <= 10; i += 1; {
+        total += i * i;
+      }
+      return total;
+    }
+  )"sv, pool);
+  check(compiled.errors.empty(), "the program compiles");
+
+  std::ostringstream out;
+  Executor executor(compiled.analyzer, compiled.types, out);
+  check(compiled.errors.empty() and executor.run(compiled.program).empty() and executor.status() == 385, "the program runs");
+
+  const auto scratch = std::filesystem::temp_directory_path() / "fridayc test \"$(quoted)\" dir";
+  std::filesystem::create_directories(scratch);
+  const std::string source = (scratch / "native.c").string();
+  const std::string executable = (scratch / "native").string();
+
+  CBackend backend(compiled.analyzer, compiled.types);
+  std::vector<Error> errors = backend.generate(compiled.program);
+  if(errors.empty()) errors = backend.write(source);
+  if(errors.empty()) errors = CBackend::build(source, executable);
+  check(errors.empty(), "the C compiler builds from a path with spaces, quotes and '$'");
+
+  const std::optional<i32> exited = spawn({ executable }, NOWHERE);
+  check(exited == (executor.status() & 0xFF), "the executable exits with the low byte of what 'main' returns");
+
+  std::filesystem::remove_all(scratch);
+  return status();
+}
@@ -0,0 +1,125 @@
+#include "CallGraph.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Builds the call graph of programs with leaves, printing, allocating and recursive functions
+// * on pools of different sizes, and checks the components and the summaries of every function.
+
+namespace {
+
+  auto function(Program& program, std::string_view name) -> FunctionStatement const* {
+    for(auto& stmt : *program.block)
+      if(auto* declared = dynamic_cast<FunctionStatement*>(stmt.get()); declared and declared->name.view() == name) return declared;
+    return nullptr;
+  }
+
+  constexpr std::string_view CALLS = R"(
+    fn add(a: int, b: int) -> int {
+      return a + b;
+    }
+
+    fn twice(x: int) -> int {
+      return add(x, x);
+    }
+
+    fn noisy(x: int) -> int {
+      print x;
+      return x;
+    }
+
+    fn caller(x: int) -> int {
+      return noisy(x) + add(x, 1);
+    }
+
+    fn even(n: int) -> bool {
+      if n == 0 {
+        return true;
+      }
+      return odd(n - 1);
+    }
+
+    fn odd(n: int) -> bool {
+      if n == 0 {
+        return false;
+      }
+      return even(n - 1);
+    }
+
+    fn fact(n: int) -> int {
+      if n < 2 {
+        return 1;
+      }
+      return n * fact(n - 1);
+    }
+
+    fn alloc(n: int) -> int {
+      let values: int[] = [n, n];
+      return values[0];
+    }
+
+    fn main() -> int {
+      if even(4) {
+        return twice(1) + caller(2) + fact(3) + alloc(4);
+      }
+      return 0;
+    }
+  )";
+
+}
+
+auto main() -> i32 {
+  for(const u32 threads : { 1u, 4u }) {
+    ThreadPool pool(threads);
+    Compiled compiled("calls"sv, CALLS, pool);
+    check(compiled.errors.empty(), "the program compiles");
+    if(not compiled.errors.empty()) continue;
+
+    CallGraph graph(pool);
+    graph.build(compiled.program);
+    check(graph.functionCount() == 9 and graph.edgeCount() == 11 and graph.componentCount() == 8,
+      "functions, distinct calls and components are counted with {} workers"f.format(pool.size()));
+
+    auto summary = [&](std::string_view name) { return *graph.summary(*function(compiled.program, name)); };
+    auto component = [&](std::string_view name) { return *graph.component(*function(compiled.program, name)); };
+    auto frame = [&](std::string_view name) { return function(compiled.program, name)->frame_size; };
+
+    const FunctionSummary add = summary("add"sv), twice = summary("twice"sv);
+    check(add.pure and add.no_alloc and not add.recursive and add.stack == frame("add"sv), "a leaf is pure and needs its own frame");
+    check(twice.pure and not twice.recursive and twice.stack == frame("twice"sv) + frame("add"sv), "a caller stacks the frames of its callees");
+    check(not summary("noisy"sv).pure and not summary("caller"sv).pure and summary("caller"sv).no_alloc, "printing is impure, for callers too");
+    check(not summary("alloc"sv).no_alloc and summary("alloc"sv).pure and not summary("main"sv).no_alloc, "an array literal allocates, for callers too");
+
+    const FunctionSummary even = summary("even"sv), fact = summary("fact"sv);
+    check(even.recursive and summary("odd"sv).recursive and even.pure and even.stack == FunctionSummary::UNBOUNDED, "mutual recursion is found");
+    check(component("even"sv) == component("odd"sv), "mutually recursive functions share a component");
+    check(fact.recursive and fact.stack == FunctionSummary::UNBOUNDED and component("fact"sv) != component("main"sv), "a function calling itself recurses alone");
+
+    const FunctionSummary main = summary("main"sv);
+    check(not main.recursive and not main.pure and main.stack == FunctionSummary::UNBOUNDED,
+      "the summary of main combines everything it calls without recursing itself");
+    check(component("add"sv) < component("twice"sv) and component("twice"sv) < component("main"sv)
+      and component("noisy"sv) < component("caller"sv) and component("even"sv) < component("main"sv), "callees are numbered first");
+
+    const auto callees = graph.callees(*function(compiled.program, "caller"sv));
+    check(callees.size() == 2 and std::ranges::contains(callees, function(compiled.program, "noisy"sv))
+      and std::ranges::contains(callees, function(compiled.program, "add"sv)), "the callees of a function are its distinct direct calls");
+  }
+
+  // * A long chain closed into a loop is one component, found without recursing natively
+  ThreadPool pool;
+  constexpr u32 CHAIN = 20'000;
+  std::string source;
+  for(u32 i = 0; i < CHAIN; ++i) source += "fn f{}(x: int) -> int {{ return f{}(x); }}\n"f.format(i, (i + 1) % CHAIN);
+  Compiled chain("chain"sv, source, pool);
+  check(chain.errors.empty(), "the chain compiles");
+  if(chain.errors.empty()) {
+    CallGraph graph(pool);
+    graph.build(chain.program);
+    check(graph.functionCount() == CHAIN and graph.edgeCount() == CHAIN and graph.componentCount() == 1, "a loop of calls is one component");
+    check(graph.summary(*function(chain.program, "f0"sv))->recursive, "every function of the loop recurses");
+  }
+
+  return status();
+}
@@ -0,0 +1,76 @@
+#include "ConstEvaluator.hpp"
+#include "Executor.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Evaluates the constants of programs at compile time and checks they still return what they return without it.
+
+namespace {
+
+  /// @brief Status of a program, analyzed again since evaluation adds literals the first analysis never typed
+  auto run(Program& program, ThreadPool& pool) -> std::optional<i64> {
+    TypeTable types;
+    Analyzer analyzer(types, pool);
+    if(not analyzer.analyze(program).empty()) return std::nullopt;
+
+    std::ostringstream out;
+    Executor executor(analyzer, types, out);
+    if(not executor.run(program).empty()) return std::nullopt;
+    return executor.status();
+  }
+
+  /// @brief Status of a program run as written and after evaluating its constants
+  auto statuses(std::string_view name, std::string_view source, ThreadPool& pool) -> std::pair<std::optional<i64>, std::optional<i64>> {
+    Compiled plain(name, source, pool);
+    Compiled evaluated(name, source, pool);
+    check(plain.errors.empty() and evaluated.errors.empty(), "{} compiles"f.format(name));
+    if(not plain.errors.empty() or not evaluated.errors.empty()) return { };
+
+    ConstEvaluator evaluator;
+    evaluator.evaluate(evaluated.program);
+    return { run(plain.program, pool), run(evaluated.program, pool) };
+  }
+
+}
+
+auto main() -> i32 {
+  ThreadPool pool;
+
+  const auto scalars = statuses("scalars"sv, R"(
+    fn square(x: int) -> int => x * x;
+
+    fn main() -> int {
+      const side: int = 6;
+      const area: int = square(side);
+      return area + side;
+    }
+  )"sv, pool);
+  check(scalars.first == 42 and scalars.second == 42, "scalar constants and pure calls evaluate to what they return");
+
+  const auto stored = statuses("stored"sv, R"(
+    fn main() -> int {
+      const values: int[] = [1, 2];
+      values[0] = 5;
+      const first: int = values[0];
+      return first;
+    }
+  )"sv, pool);
+  check(stored.first == 5 and stored.second == 5, "a constant array reads an element stored through it");
+
+  const auto aliased = statuses("aliased"sv, R"(
+    fn head(values: int[]) -> int => values[0];
+
+    fn main() -> int {
+      const values: int[] = [1, 2];
+      let copy: int[] = values;
+      copy[0] = 9;
+      const first: int = head(values);
+      return first;
+    }
+  )"sv, pool);
+  check(aliased.first.has_value() and aliased.second == aliased.first, "a pure call sees an element stored through a copy of a constant array");
+
+  return status();
+}
@@ -0,0 +1,76 @@
+#include "ConstantFolder.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Folds the returned expression of small functions and checks constants collapse into literals,
+// * while operations that would fault at run time are left for the program to perform.
+
+namespace {
+
+  /// @brief The returned expression of a function once folded, with the folder that folded it
+  struct Folded {
+    Program        program;
+    ConstantFolder folder;
+
+    auto expr() const -> Expression const* {
+      auto* function = program.block and program.block->size() ? dynamic_cast<FunctionStatement*>((*program.block)[0].get()) : nullptr;
+      auto* body = function and function->block->size() ? dynamic_cast<ReturnStatement*>((*function->block)[0].get()) : nullptr;
+      return body ? body->expr.get() : nullptr;
+    }
+  };
+
+  auto fold(std::string_view returned, std::string_view type = "int"sv) -> std::unique_ptr<Folded> {
+    const u32 file = Sources::add("fold"s, "fn f(x: int) -> {} {{ return {}; }}"f.format(type, returned));
+    auto folded = std::make_unique<Folded>();
+    std::vector<Error> errors;
+    std::tie(folded->program, errors) = Parser(Tokenizer(Sources::text(file)).collect<std::vector>(), file).parse();
+    check(errors.empty(), "{} parses"f.format(returned));
+    if(errors.empty()) folded->folder.fold(folded->program);
+    return folded;
+  }
+
+  auto intOf(Expression const* expr) -> std::optional<i64> {
+    auto* literal = dynamic_cast<IntLiteral const*>(expr);
+    return literal ? std::optional<i64>{ literal->value.unwrap() } : std::nullopt;
+  }
+
+}
+
+auto main() -> i32 {
+  check(intOf(fold("1 + 2 * 3"sv)->expr()) == 7, "integer arithmetic folds");
+  check(intOf(fold("-9223372036854775807 - 1"sv)->expr()) == std::numeric_limits<i64>::min(), "the smallest integer folds");
+  check(intOf(fold("1 << 62"sv)->expr()) == i64{ 1 } << 62, "a shift that keeps its bits folds");
+  check(intOf(fold("-8 >> 1"sv)->expr()) == -4, "a right shift keeps the sign");
+  check(dynamic_cast<BoolLiteral const*>(fold("1 < 2 and not false"sv, "bool"sv)->expr()), "comparisons and logic fold");
+
+  for(const std::string_view faulting : {
+    "9223372036854775807 + 1"sv, "-9223372036854775807 - 2"sv, "4611686018427387904 * 2"sv, "-(-9223372036854775807 - 1)"sv,
+    "1 << 64"sv, "1 << -1"sv, "1 >> 64"sv, "3 << 62"sv, "1 << 63"sv,
+    "1 / 0"sv, "1 % 0"sv, "(-9223372036854775807 - 1) / -1"sv,
+  }) {
+    const auto folded = fold(faulting);
+    check(not dynamic_cast<IntLiteral const*>(folded->expr()), "{} is left to run time"f.format(faulting));
+  }
+
+  const auto infinite = fold("1.0 / 0.0"sv, "float"sv);
+  check(dynamic_cast<InfixExpression const*>(infinite->expr()), "a float result that is not finite is left to run time");
+
+  // * Only the faulting operation stays, its constant operands are still folded
+  const auto partial = fold("(2 + 3) / (1 - 1)"sv);
+  auto* division = dynamic_cast<InfixExpression const*>(partial->expr());
+  check(division and intOf(division->lhs.get()) == 5 and intOf(division->rhs.get()) == 0, "the operands of a faulting operation fold");
+  check(partial->folder.folded() == 2 and partial->folder.evaluated() == 2, "each folded operand is counted once");
+
+  const auto variable = fold("x * (4 - 1)"sv);
+  auto* product = dynamic_cast<InfixExpression const*>(variable->expr());
+  check(product and intOf(product->rhs.get()) == 3, "a constant operand of a variable expression folds");
+
+  check(ConstantFolder::binary(Token::Type::PLUS, Long{ 1 }, Double{ 1.0 }) == std::nullopt, "operands of different types are left alone");
+  bool threw = false;
+  try { (void) ConstantFolder::binary(Token::Type::SLASH, Long{ 1 }, Long{ 0 }); } catch(std::exception const&) { threw = true; }
+  check(threw, "dividing by zero throws");
+
+  return status();
+}
@@ -0,0 +1,181 @@
+#include "DenseArray.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::runtime;
+using namespace fridayc::test;
+
+// * Runs the scalar and AVX2 kernels on the same runs, of every length around the vector width and
+// * with an overflowing element in every lane, and checks they agree bit for bit, then checks the
+// * faults of DenseArray.
+
+namespace {
+
+  constexpr i64 MIN = std::numeric_limits<i64>::min();
+  constexpr i64 MAX = std::numeric_limits<i64>::max();
+  constexpr f64 NaN = std::numeric_limits<f64>::quiet_NaN();
+
+  /// @brief Lengths below, at and past a few vector widths, and a long run
+  constexpr std::array<u64, 13> SIZES { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 1003 };
+
+  auto same(f64 lhs, f64 rhs) -> bool {
+    return std::bit_cast<u64>(lhs) == std::bit_cast<u64>(rhs) or (std::isnan(lhs) and std::isnan(rhs));
+  }
+
+  auto same(std::span<f64 const> lhs, std::span<f64 const> rhs) -> bool {
+    return std::ranges::equal(lhs, rhs, [](f64 a, f64 b) { return same(a, b); });
+  }
+
+  /// @brief Runs a binary int kernel of both sets, checking they fault at the same element and agree before it
+  auto agree(Kernels::Ints scalar, Kernels::Ints vector, std::vector<i64> const& lhs, std::vector<i64> const& rhs) -> bool {
+    std::vector<i64> expected(lhs.size()), found(lhs.size());
+    const u64 first = scalar(lhs.data(), rhs.data(), expected.data(), lhs.size());
+    const u64 second = vector(lhs.data(), rhs.data(), found.data(), lhs.size());
+    return first == second and std::equal(expected.begin(), expected.begin() + first, found.begin());
+  }
+
+  auto agree(Kernels::Floats scalar, Kernels::Floats vector, std::vector<f64> const& lhs, std::vector<f64> const& rhs) -> bool {
+    std::vector<f64> expected(lhs.size()), found(lhs.size());
+    const u64 first = scalar(lhs.data(), rhs.data(), expected.data(), lhs.size());
+    const u64 second = vector(lhs.data(), rhs.data(), found.data(), lhs.size());
+    return first == second and same(std::span(expected).first(first), std::span(found).first(first));
+  }
+
+  auto faults(auto&& run, std::string_view message) -> bool {
+    try {
+      run();
+    } catch(RuntimeError const& error) {
+      return error.message == message;
+    }
+    return false;
+  }
+
+}
+
+auto main() -> i32 {
+  Kernels const& scalar = *kernels(Kernels::Isa::SCALAR);
+  Kernels const* avx2 = kernels(Kernels::Isa::AVX2);
+  check(&kernels() == (avx2 ? avx2 : &scalar), "the widest set the machine runs is selected");
+
+  std::mt19937_64 random(42);
+  std::uniform_int_distribution<i64> small(-1000, 1000), any(MIN, MAX);
+  std::uniform_real_distribution<f64> real(-1e6, 1e6);
+
+  // * A set checks against itself when the machine has no other, so the test still runs everywhere
+  Kernels const& vector = avx2 ? *avx2 : scalar;
+  if(not avx2) std::cerr << "AVX2 is not supported, the scalar kernels only check against themselves" << std::endl;
+
+  bool ints = true, floats = true, overflows = true, sums = true, bounds = true, fills = true;
+  for(const u64 size : SIZES) {
+    std::vector<i64> a(size), b(size);
+    std::vector<f64> x(size), y(size);
+    for(u64 i = 0; i < size; ++i) {
+      a[i] = small(random), b[i] = small(random) | 1;
+      x[i] = real(random), y[i] = real(random);
+    }
+
+    ints = ints and agree(scalar.add, vector.add, a, b) and agree(scalar.sub, vector.sub, a, b)
+      and agree(scalar.mul, vector.mul, a, b) and agree(scalar.div, vector.div, a, b);
+    floats = floats and agree(scalar.fadd, vector.fadd, x, y) and agree(scalar.fsub, vector.fsub, x, y)
+      and agree(scalar.fmul, vector.fmul, x, y) and agree(scalar.fdiv, vector.fdiv, x, y);
+
+    // * An overflow or a zero divisor in every position, thus in every lane and in the scalar tail
+    for(u64 at = 0; at < std::min<u64>(size, 17); ++at) {
+      std::vector<i64> lhs = a, rhs = b;
+      std::vector<f64> divisors = y;
+      lhs[at] = MAX, rhs[at] = 1;
+      overflows = overflows and agree(scalar.add, vector.add, lhs, rhs);
+      lhs[at] = MIN, rhs[at] = 1;
+      overflows = overflows and agree(scalar.sub, vector.sub, lhs, rhs);
+      lhs[at] = MIN, rhs[at] = -1;
+      overflows = overflows and agree(scalar.mul, vector.mul, lhs, rhs) and agree(scalar.div, vector.div, lhs, rhs);
+      rhs[at] = 0;
+      divisors[at] = -0.;
+      overflows = overflows and agree(scalar.div, vector.div, lhs, rhs) and agree(scalar.fdiv, vector.fdiv, x, divisors);
+    }
+
+    // * Lanes overflow on the way while the exact sum fits, or does not
+    std::vector<i64> wide(size);
+    for(u64 i = 0; i < size; ++i) wide[i] = i % 3 == 2 ? -(MAX / 2) : MAX / 2 + (i % 5);
+    for(auto const& values : { a, wide, std::vector<i64>(size, MAX), std::vector<i64>(size, MIN) }) {
+      i64 expected = 0, found = 0;
+      const bool fits = scalar.sum(values.data(), size, expected);
+      sums = sums and fits == vector.sum(values.data(), size, found) and (not fits or expected == found);
+    }
+    sums = sums and same(scalar.fsum(x.data(), size), vector.fsum(x.data(), size));
+
+    if(size) {
+      for(auto const& values : { a, wide }) {
+        std::vector<i64> random_values(values);
+        for(u64 i = 0; i < size; i += 7) random_values[i] = any(random);
+        bounds = bounds and scalar.min(random_values.data(), size) == vector.min(random_values.data(), size)
+          and scalar.max(random_values.data(), size) == vector.max(random_values.data(), size)
+          and scalar.min(random_values.data(), size) == std::ranges::min(random_values)
+          and scalar.max(random_values.data(), size) == std::ranges::max(random_values);
+      }
+
+      std::vector<f64> zeros(size, 0.);
+      zeros[size / 2] = -0.;
+      std::vector<f64> nan = x;
+      nan[size - 1] = NaN;
+      for(auto const& values : { x, zeros, nan }) {
+        bounds = bounds and same(scalar.fmin(values.data(), size), vector.fmin(values.data(), size))
+          and same(scalar.fmax(values.data(), size), vector.fmax(values.data(), size));
+      }
+      bounds = bounds and std::signbit(vector.fmin(zeros.data(), size)) == (size > 0) and not std::signbit(vector.fmax(zeros.data(), size) + (size == 1));
+      bounds = bounds and std::isnan(vector.fmin(nan.data(), size)) and std::isnan(vector.fmax(nan.data(), size));
+    }
+
+    std::vector<i64> filled(size + 1, 7);
+    vector.fill(filled.data(), -3, size);
+    std::vector<f64> ffilled(size, 0.);
+    vector.ffill(ffilled.data(), 2.5, size);
+    std::vector<i64> copied(size);
+    vector.copy(a.data(), copied.data(), size * sizeof(i64));
+    fills = fills and std::all_of(filled.begin(), filled.begin() + size, [](i64 value) { return value == -3; }) and filled.back() == 7
+      and std::ranges::all_of(ffilled, [](f64 value) { return value == 2.5; }) and copied == a;
+  }
+  check(ints, "int kernels agree");
+  check(floats, "float kernels agree bit for bit");
+  check(overflows, "kernels stop at the same element when one overflows or divides by zero, in every lane");
+  check(sums, "sums agree, and fault alike when the exact sum does not fit");
+  check(bounds, "minimums and maximums agree, with NaNs and signed zeros");
+  check(fills, "fills and copies write exactly their run");
+
+  const std::array<u64, 2> shape { 3, 5 };
+  DenseArray<i64> lhs(shape, { }), rhs(shape, { });
+  check(lhs.rank() == 2 and lhs.size() == 15 and std::ranges::equal(lhs.strides(), std::array<u64, 2>{ 5, 1 }), "the header describes the shape");
+  check((std::bit_cast<std::uintptr_t>(lhs.data()) & 31) == 0, "the elements are aligned for the widest vector");
+  check(std::ranges::all_of(lhs.elements(), [](i64 value) { return value == 0; }), "a new array is zeros");
+
+  lhs.fill(4);
+  rhs.fill(2);
+  const std::array<i64, 2> corner { 2, 4 };
+  rhs.at(corner, { }) = MAX;
+  lhs.compute(Elementwise::DIV, lhs, rhs, { });
+  check(lhs.at(corner, { }) == 0 and lhs.data()[0] == 2, "an array divides in place");
+  check(lhs.sum({ }) == 28, "an int array sums");
+
+  lhs.fill(1);
+  check(faults([&] { lhs.compute(Elementwise::ADD, lhs, rhs, { }); }, "Integer overflow"sv), "an overflowing element faults");
+  check(lhs.at(corner, { }) == 1, "the overflowing element is left unwritten");
+  rhs.at(corner, { }) = 0;
+  check(faults([&] { lhs.compute(Elementwise::DIV, lhs, rhs, { }); }, "Division by 0"sv), "a zero divisor faults");
+  rhs.fill(MAX);
+  check(faults([&] { rhs.sum({ }); }, "Integer overflow"sv), "a sum that does not fit faults");
+
+  const std::array<i64, 2> outside { 3, 0 };
+  check(faults([&] { lhs.at(outside, { }); }, "Index 3 out of bounds for length 3"sv), "an index out of bounds faults");
+  const std::array<u64, 2> other { 5, 3 };
+  DenseArray<i64> transposed(other, { });
+  check(faults([&] { lhs.assign(transposed, { }); }, "Shapes [3, 5] and [5, 3] differ"sv), "arrays of other shapes fault");
+
+  DenseArray<f64> empty(std::array<u64, 1>{ 0 }, { });
+  check(empty.sum({ }) == 0. and faults([&] { empty.minimum({ }); }, "Minimum of an empty array"sv), "an empty array sums to zero and has no minimum");
+
+  DenseArray<f64> copy(empty);
+  DenseArray<i64> moved(std::move(rhs));
+  check(copy.size() == 0 and moved.size() == 15 and moved.data()[0] == MAX, "arrays copy and move");
+
+  return status();
+}
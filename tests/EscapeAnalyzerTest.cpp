@@ -0,0 +1,162 @@
+#include "EscapeAnalyzer.hpp"
+#include "Executor.hpp"
+#include "Region.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Finds the lifetimes of the literals of a program and checks which escape, then runs it with
+// * and without regions and checks the results agree while the region is rewound by calls and loops.
+
+namespace {
+
+  /// @brief Every struct and array literal of a program, in the order the analyzer records them
+  struct Literals : public Walker {
+    std::vector<Expression const*> found { };
+
+    using Walker::operator();
+
+    auto operator()(ArrayLiteral& arg) noexcept -> std::any override {
+      found.push_back(&arg);
+      return Walker::operator()(arg);
+    }
+
+    auto operator()(CallExpression& arg) noexcept -> std::any override {
+      if(Identifier const* name = arg.callee(); name and name->binding.kind == Binding::Kind::STRUCT) found.push_back(&arg);
+      return Walker::operator()(arg);
+    }
+  };
+
+  auto run(Compiled& compiled, EscapeAnalyzer const* escapes, std::string& output) -> std::unique_ptr<Executor> {
+    std::ostringstream out;
+    auto executor = std::make_unique<Executor>(compiled.analyzer, compiled.types, out, ExecutionLimits{ }, escapes);
+    const std::vector<Error> errors = executor->run(compiled.program);
+    check(errors.empty(), "the program runs");
+    output = out.str();
+    return executor;
+  }
+
+}
+
+auto main() -> i32 {
+  ThreadPool pool;
+  Compiled compiled("escapes"sv, R"(
+    struct Pair {
+      a: int;
+      b: int;
+    }
+
+    fn keep() -> int[] {
+      return [1, 2];
+    }
+
+    fn sum(values: int[]) -> int {
+      return values[0];
+    }
+
+    fn scratch(n: int) -> int {
+      let values: int[] = [n, n, n, n, n, n, n, n];
+      return values[7];
+    }
+
+    fn main() -> int {
+      let total: int = 0;
+      let i: int = 0;
+      let local: int[] = [1, 2, 3];
+      let shared: int[] = [4];
+      total += sum(shared) + local[2];
+      for i = 0; i < 5000; i += 1; {
+        let p: Pair = Pair(i, 1);
+        let row: int[] = [i, i, i, i];
+        total += p.a + row[3] + [5, 6][1] + scratch(i);
+      }
+      let kept: int[] = keep();
+      let nested: int[][] = [[1], [2]];
+      let alias: int[] = [7];
+      let other: int[] = alias;
+      let holder: Pair = Pair(0, 0);
+      holder.a = [8][0];
+      while i > 4990 {
+        let t: int[] = [i];
+        total += t[0] + nested[1][0] + other[0] + kept[1];
+        i -= 1;
+      }
+      print total;
+      return total % 256;
+    }
+  )"sv, pool);
+  check(compiled.errors.empty(), "the program compiles");
+  if(not compiled.errors.empty()) return status();
+
+  EscapeAnalyzer analysis;
+  analysis.analyze(compiled.program);
+  Literals literals;
+  literals.visit(compiled.program);
+
+  using enum Lifetime::Kind;
+  const std::vector<Lifetime::Kind> expected {
+    HEAP,                        // * returned
+    CALL,                        // * read in place by its own function
+    CALL, HEAP,                  // * read in place, passed to a function
+    ITERATION, ITERATION,        // * locals of the loop body
+    ITERATION,                   // * a temporary of the loop body
+    CALL, HEAP, HEAP,            // * a nested array, whose rows are stored into it
+    HEAP,                        // * copied into another local
+    CALL,                        // * a struct only written to
+    CALL,                        // * read in place
+    ITERATION,                   // * a local of a 'while' body
+  };
+
+  std::vector<Lifetime::Kind> kinds;
+  for(Expression const* literal : literals.found)
+    if(Lifetime const* found = analysis.lifetime(*literal)) kinds.push_back(found->kind);
+  check(kinds == expected, "every literal gets its lifetime");
+  check(analysis.count(HEAP) == 5 and analysis.count(CALL) == 5 and analysis.count(ITERATION) == 4, "each lifetime is counted");
+
+  if(literals.found.size() == expected.size()) {
+    Lifetime const& pair = *analysis.lifetime(*literals.found[4]);
+    Lifetime const& temporary = *analysis.lifetime(*literals.found[6]);
+    Lifetime const& body = *analysis.lifetime(*literals.found[13]);
+    check(pair.loop and pair.loop == temporary.loop and body.loop and body.loop != pair.loop, "a value dies with the innermost loop making it");
+    check(analysis.slots(*pair.loop) and analysis.slots(*pair.loop)->size() == 2 and analysis.slots(*body.loop)->size() == 1,
+      "a loop clears the locals of its iterations");
+  }
+
+  bool allocates = true;
+  for(auto& stmt : *compiled.program.block)
+    if(auto* function = dynamic_cast<FunctionStatement*>(stmt.get()))
+      allocates = allocates and analysis.allocates(*function) == (function->name.view() == "main"sv or function->name.view() == "scratch"sv);
+  check(allocates, "only functions making values that do not escape use the region");
+
+  // * The run with regions prints and returns the same, making the values that do not escape in the region
+  std::string heap_output, region_output;
+  const auto heap = run(compiled, nullptr, heap_output);
+  const auto regions = run(compiled, &analysis, region_output);
+  check(not heap_output.empty() and heap_output == region_output and heap->status() == regions->status(), "regions do not change the results");
+  check(heap->regionObjects() == 0 and regions->regionObjects() > 4 * 5000, "values that do not escape are made in the region");
+  check(regions->heapObjects() < 20 and regions->heapObjects() + regions->regionObjects() == heap->heapObjects(), "the others are still made on the heap");
+
+  // * Every iteration and call rewinds, so the region peaks at what a few iterations make
+  runtime::Region const& used = regions->regions();
+  check(used.allocationCount() >= regions->regionObjects() and used.peakBytes() < 4096 and used.allocatedBytes() > 100 * used.peakBytes(),
+    "the region is rewound after every iteration and call");
+
+  // * Marks nest, and rewinding to one reuses the memory allocated after it
+  runtime::Region region;
+  void* first = region.allocate(24, 8);
+  const runtime::Region::Mark mark = region.mark();
+  void* second = region.allocate(100, 32);
+  check((std::bit_cast<std::uintptr_t>(second) & 31) == 0, "allocations are aligned");
+  region.rewind(mark);
+  check(region.allocate(100, 32) == second and first != second, "rewinding to a mark reuses what came after it");
+
+  const u64 before = region.peakBytes();
+  void* large = region.allocate(1 << 20, 16);
+  check(large and region.peakBytes() > before + (1 << 20), "an allocation larger than a chunk gets a chunk of its own");
+  region.rewind(mark);
+  check(region.allocate(100, 32) == second, "rewinding goes back across chunks");
+  check(region.allocationCount() == 5 and region.allocatedBytes() == 24 + 3 * 100 + (1 << 20), "allocations are counted, rewound or not");
+
+  return status();
+}
@@ -0,0 +1,81 @@
+#include "Executor.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Runs small programs under the Executor and checks what they print, return and fault on.
+
+namespace {
+
+  struct Run {
+    std::vector<Error> errors;
+    std::string        output;
+    i64                status;
+  };
+
+  auto execute(std::string_view name, std::string_view source, ThreadPool& pool) -> Run {
+    Compiled compiled(name, source, pool);
+    check(compiled.errors.empty(), "{} compiles"f.format(name));
+    if(not compiled.errors.empty()) return { std::move(compiled.errors), ""s, 0 };
+
+    std::ostringstream out;
+    Executor executor(compiled.analyzer, compiled.types, out);
+    std::vector<Error> errors = executor.run(compiled.program);
+    return { std::move(errors), out.str(), executor.status() };
+  }
+
+}
+
+auto main() -> i32 {
+  ThreadPool pool;
+
+  const Run calls = execute("calls"sv, R"(
+    fn fib(n: int) -> int {
+      if n < 2 {
+        return n;
+      }
+      return fib(n - 1) + fib(n - 2);
+    }
+
+    fn main() -> int {
+      return fib(15);
+    }
+  )"sv, pool);
+  check(calls.errors.empty() and calls.status == 610, "recursive calls return their value");
+
+  const Run loops = execute("loops"sv, R"(
+    fn main() -> int {
+      let total: int = 0;
+      let i: int = 0;
+      for i = 0; i < 4; i += 1; {
+        print i * i;
+        total += i;
+      }
+      while total < 100 {
+        total *= 2;
+      }
+      return total;
+    }
+  )"sv, pool);
+  check(loops.errors.empty() and loops.output == "0\n1\n4\n9\n"s and loops.status == 192, "loops print and update their locals");
+
+  const Run overflow = execute("overflow"sv, R"(
+    fn main() -> int {
+      let x: int = 4611686018427387904;
+      return x * 2;
+    }
+  )"sv, pool);
+  check(reports(overflow.errors, "Integer overflow"sv), "int arithmetic faults on overflow");
+
+  const Run bounds = execute("bounds"sv, R"(
+    fn main() -> int {
+      const values: int[] = [1, 2, 3];
+      let i: int = 3;
+      return values[i];
+    }
+  )"sv, pool);
+  check(reports(bounds.errors, "out of bounds"sv), "subscripts fault past the end of an array");
+
+  return status();
+}
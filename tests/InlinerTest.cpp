@@ -0,0 +1,77 @@
+#include "Inliner.hpp"
+#include "Executor.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Inlines the small functions of programs and checks they still print, return and fault as they did.
+
+namespace {
+
+  struct Run {
+    std::vector<Error> errors;
+    std::string        output;
+    i64                status;
+  };
+
+  /// @brief Runs a program, analyzed again since inlining adds copies the first analysis never typed
+  auto run(Program& program, ThreadPool& pool) -> Run {
+    TypeTable types;
+    Analyzer analyzer(types, pool);
+    std::vector<Error> errors = analyzer.analyze(program);
+    if(not errors.empty()) return { std::move(errors), ""s, 0 };
+
+    std::ostringstream out;
+    Executor executor(analyzer, types, out);
+    errors = executor.run(program);
+    return { std::move(errors), out.str(), executor.status() };
+  }
+
+  /// @brief Runs of a program as written and inlined, with the number of calls inlined
+  auto runs(std::string_view name, std::string_view source, ThreadPool& pool) -> std::tuple<Run, Run, u64> {
+    Compiled plain(name, source, pool);
+    Compiled inlined(name, source, pool);
+    check(plain.errors.empty() and inlined.errors.empty(), "{} compiles"f.format(name));
+    if(not plain.errors.empty() or not inlined.errors.empty()) return { };
+
+    Inliner inliner;
+    inliner.expand(inlined.program);
+    return { run(plain.program, pool), run(inlined.program, pool), inliner.inlinedCalls() };
+  }
+
+}
+
+auto main() -> i32 {
+  ThreadPool pool;
+
+  const auto [plain, inlined, count] = runs("names"sv, R"(
+    fn twice(a: int) -> int => a * 2;
+
+    fn main() -> int {
+      let x: int = 21;
+      return twice(x);
+    }
+  )"sv, pool);
+  check(count == 1, "a call with a name for argument is inlined");
+  check(inlined.errors.empty() and inlined.status == 42 and plain.status == 42, "the inlined call returns what the call did");
+
+  const auto [faulting, reordered, moved] = runs("overflow"sv, R"(
+    fn noisy() -> int {
+      print 1;
+      return 1;
+    }
+
+    fn f(a: int, b: int) -> int => a * 4611686018427387904 + b;
+
+    fn main() -> int {
+      let x: int = 2;
+      return f(x, noisy());
+    }
+  )"sv, pool);
+  check(reports(faulting.errors, "Integer overflow"sv) and faulting.output == "1\n"s, "the call prints before its body overflows");
+  check(moved == 0, "a call is not inlined when its body may overflow before a complex argument");
+  check(reports(reordered.errors, "Integer overflow"sv) and reordered.output == faulting.output, "the argument still prints before the overflow");
+
+  return status();
+}
@@ -0,0 +1,55 @@
+#include "Interpreter.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Evaluates calls with the Interpreter used for compile-time evaluation, and checks it fails instead of faulting.
+
+namespace {
+
+  auto evaluate(Program& program, std::string_view name) -> std::optional<Value> {
+    FlatMap<FunctionStatement const*, bool> callable;
+    FunctionStatement* callee = nullptr;
+    for(auto& stmt : *program.block)
+      if(auto* function = dynamic_cast<FunctionStatement*>(stmt.get())) {
+        callable.insert(function, true);
+        if(function->name.view() == name) callee = function;
+      }
+    if(not callee) return std::nullopt;
+
+    Interpreter interpreter(callable);
+    auto identifier = std::make_unique<Identifier>(callee->name);
+    identifier->binding = Binding{ Binding::Kind::FUNCTION, 0, callee };
+    CallExpression call(std::move(identifier));
+    return interpreter.evaluate(call);
+  }
+
+}
+
+auto main() -> i32 {
+  ThreadPool pool;
+
+  Compiled compiled("locals"sv, R"(
+    fn square() -> int {
+      let x: int = 7;
+      let y: int = x * x;
+      return y;
+    }
+
+    fn main() -> int {
+      return square();
+    }
+  )"sv, pool);
+  check(compiled.errors.empty(), "the program compiles");
+
+  const std::optional<Value> value = evaluate(compiled.program, "square"sv);
+  check(value and std::holds_alternative<Long>(value->data) and std::get<Long>(value->data).unwrap() == 49, "locals are declared into the frame");
+
+  // * A frame too small for its declarations, as a damaged tree could have, fails the evaluation
+  for(auto& stmt : *compiled.program.block)
+    if(auto* function = dynamic_cast<FunctionStatement*>(stmt.get()); function and function->name.view() == "square"sv) function->frame_size = 1;
+  check(not evaluate(compiled.program, "square"sv), "a declaration past the end of the frame fails");
+
+  return status();
+}
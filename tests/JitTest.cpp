@@ -0,0 +1,41 @@
+#include "BytecodeCompiler.hpp"
+#include "Jit.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Compiles a program with the Jit, again over its own code, and checks only compiled code runs.
+// * Skipped where the Jit does not run.
+
+auto main() -> i32 {
+  if(not Jit::available()) {
+    std::cerr << "The JIT does not run on this platform, skipped" << std::endl;
+    return 0;
+  }
+
+  ThreadPool pool;
+  Compiled compiled("jit"sv, R"(
+    fn main() -> int {
+      let total: int = 0;
+      let i: int = 0;
+      for i = 0; i < 10; i += 1; {
+        total += i;
+      }
+      return total;
+    }
+  )"sv, pool);
+  check(compiled.errors.empty(), "the program compiles");
+
+  BytecodeCompiler compiler(compiled.analyzer, compiled.types);
+  if(compiled.errors.empty()) check(compiler.compile(compiled.program).empty(), "the program compiles to bytecode");
+
+  std::ostringstream out;
+  Jit jit(compiler.module(), out);
+  check(reports(jit.run(), "No compiled 'main'"sv), "nothing runs before a compilation");
+
+  check(jit.compile().empty() and jit.run().empty() and jit.status() == 45, "the compiled program runs");
+  check(jit.compile().empty() and jit.run().empty() and jit.status() == 45, "a second compilation replaces the code of the first");
+
+  return status();
+}
@@ -0,0 +1,124 @@
+#include "LoopOptimizer.hpp"
+#include "Executor.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Optimizes the loops of small programs, then runs them under the Executor and checks
+// * they print, return and fault as they did before.
+
+namespace {
+
+  struct Run {
+    u64                hoisted;
+    u64                reduced;
+    std::vector<Error> errors;
+    std::string        output;
+    i64                status;
+  };
+
+  auto optimize(std::string_view name, std::string_view source, ThreadPool& pool) -> Run {
+    Compiled compiled(name, source, pool);
+    check(compiled.errors.empty(), "{} compiles"f.format(name));
+    if(not compiled.errors.empty()) return { 0, 0, std::move(compiled.errors), ""s, 0 };
+
+    LoopOptimizer optimizer(compiled.analyzer, compiled.types);
+    optimizer.optimize(compiled.program);
+
+    // * The temporaries of the optimizer are typed by analyzing the tree again, as fridayc does
+    TypeTable types;
+    Analyzer analyzer(types, pool);
+    std::vector<Error> errors = analyzer.analyze(compiled.program);
+    check(errors.empty(), "{} still compiles once optimized"f.format(name));
+
+    std::ostringstream out;
+    Executor executor(analyzer, types, out);
+    if(errors.empty()) errors = executor.run(compiled.program);
+    return { optimizer.hoistedExpressions(), optimizer.reducedProducts(), std::move(errors), out.str(), executor.status() };
+  }
+
+}
+
+auto main() -> i32 {
+  ThreadPool pool;
+
+  const Run safe = optimize("safe"sv, R"(
+    fn main() -> int {
+      let a: float = 1.5;
+      let total: float = 0.0;
+      let i: int = 0;
+      for i = 0; i < 4; i += 1; {
+        total += a * a;
+      }
+      if total > 8.0 {
+        return 1;
+      }
+      return 0;
+    }
+  )"sv, pool);
+  check(safe.hoisted == 1 and safe.errors.empty() and safe.status == 1, "invariants that cannot fail are hoisted");
+
+  // * The loop never runs, so the multiplication never overflows
+  const Run empty = optimize("empty"sv, R"(
+    fn main() -> int {
+      let a: int = 4611686018427387904;
+      let total: int = 0;
+      let i: int = 0;
+      for i = 0; i < 0; i += 1; {
+        total += a * 2;
+      }
+      return total;
+    }
+  )"sv, pool);
+  check(empty.hoisted == 0 and empty.errors.empty() and empty.status == 0, "int arithmetic that may overflow stays in the body");
+
+  // * The call prints before the division by 0 faults
+  const Run ordered = optimize("ordered"sv, R"(
+    fn p() -> int {
+      print 1;
+      return 0;
+    }
+
+    fn main() -> int {
+      let q: int = 1;
+      let r: int = 0;
+      while p() + q / r > 0 {
+        print 2;
+      }
+      return 0;
+    }
+  )"sv, pool);
+  check(ordered.output == "1\n"s and reports(ordered.errors, "Division by 0"sv), "nothing fallible is hoisted past a call of the condition");
+
+  const Run reduced = optimize("reduced"sv, R"(
+    fn main() -> int {
+      const values: int[] = [0, 1, 2, 3, 4, 5, 6, 7, 8, 9];
+      let total: int = 0;
+      let i: int = 0;
+      for i = 0; i < 5; i += 1; {
+        total += values[i * 2];
+      }
+      return total;
+    }
+  )"sv, pool);
+  check(reduced.reduced == 1 and reduced.errors.empty() and reduced.status == 20, "products of bounded loops are strength-reduced");
+
+  // * The product would overflow one step past the bound, where the loop itself never multiplies
+  const Run unbounded = optimize("unbounded"sv, R"(
+    fn main() -> int {
+      const values: int[] = [0, 1, 2];
+      let total: int = 0;
+      let i: int = 0;
+      for i = 0; i < 10; i += 1; {
+        if i > 100 {
+          total += values[i * 1000000000000000000];
+        }
+      }
+      return total;
+    }
+  )"sv, pool);
+  check(unbounded.reduced == 0 and unbounded.errors.empty() and unbounded.status == 0, "products that may overflow are not strength-reduced");
+
+  return status();
+}
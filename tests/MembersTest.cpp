@@ -0,0 +1,64 @@
+#include "Members.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Fills member lists on both sides of the index threshold and checks they keep declaration order,
+// * find every member and refuse duplicates, then parses declarations that repeat a name.
+
+namespace {
+
+  auto type() -> Box<TypeExpression> {
+    return std::make_unique<TypeExpression>(Symbol::intern("int"sv), 0);
+  }
+
+}
+
+auto main() -> i32 {
+  for(const u64 count : { Members::INDEX_THRESHOLD - 1, Members::INDEX_THRESHOLD * 5 }) {
+    Members members;
+    for(u64 i = 0; i < count; ++i) check(members.add(Symbol::intern("m{}"f.format(count - i)), type()), "a new name is added");
+    check(members.size() == count, "every member is kept");
+    check(not members.add(Symbol::intern("m1"sv), type()) and not members.add(Symbol::intern("m{}"f.format(count)), type()),
+      "a name already there is refused, first or last");
+
+    bool ordered = true, found = true;
+    for(u64 i = 0; i < count; ++i) {
+      const Symbol name = Symbol::intern("m{}"f.format(count - i));
+      ordered = ordered and members[i].name == name;
+      found = found and members.indexOf(name) == i and members.find(name) == members[i].type.get();
+    }
+    check(ordered, "members stay in declaration order");
+    check(found, "every member is found at its position, {} members"f.format(count));
+    check(not members.contains(Symbol::intern("m0"sv)) and not members.indexOf(Symbol::intern("absent"sv)), "an absent name is not found");
+  }
+
+  ThreadPool pool;
+  Compiled fields("fields"sv, R"(
+    struct Point {
+      y: int;
+      x: int;
+      y: float;
+    }
+  )"sv, pool);
+  check(reports(fields.errors, "Duplicate struct field 'y'"sv), "a repeated field is an error");
+
+  Compiled parameters("parameters"sv, R"(
+    fn f(b: int, a: int, b: int) -> int {
+      return a;
+    }
+  )"sv, pool);
+  check(reports(parameters.errors, "Duplicate function parameter 'b'"sv), "a repeated parameter is an error");
+
+  Compiled ordered("ordered"sv, R"(
+    fn f(c: int, a: int, b: int) -> int {
+      return a;
+    }
+  )"sv, pool);
+  auto* function = ordered.program.block->size() ? dynamic_cast<FunctionStatement*>((*ordered.program.block)[0].get()) : nullptr;
+  check(function and function->args.size() == 3 and function->args[0].name.view() == "c"sv and function->args[2].name.view() == "b"sv,
+    "parameters are parsed in declaration order");
+
+  return status();
+}
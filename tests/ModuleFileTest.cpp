@@ -0,0 +1,101 @@
+#include "BytecodeCompiler.hpp"
+#include "ModuleFile.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::bytecode;
+using namespace fridayc::test;
+
+// * Writes a compiled module and maps it back, then damages the code of 'main' in its image
+// * and checks decoding refuses it.
+
+namespace {
+
+  /// @brief Whether decoding the function of an index from an image faults on a corrupt body
+  auto refused(std::string const& image, u32 index) -> bool {
+    auto [module, errors] = ModuleFile::load(reinterpret_cast<u8 const*>(image.data()), image.size(), "image"s);
+    if(not errors.empty()) return false;
+    try {
+      Function function;
+      module.file->decode(index, function);
+      return false;
+    } catch(RuntimeError const& error) {
+      return error.message.contains("corrupt"sv);
+    }
+  }
+
+  /// @brief Image with one instruction of a function rewritten
+  template<class Damage>
+  auto damaged(std::string image, Function const& function, Damage&& damage) -> std::string {
+    const std::string_view code { reinterpret_cast<i8 const*>(function.code.data()), function.code.size() * sizeof(Instruction) };
+    const u64 at = image.find(code);
+    check(at != std::string::npos, "the code of '{}' is stored as compiled"f.format(function.name));
+    if(at == std::string::npos) return image;
+
+    for(u64 i = 0; i < function.code.size(); ++i) {
+      Instruction instruction = function.code[i];
+      if(not damage(instruction)) continue;
+      std::memcpy(image.data() + at + i * sizeof(Instruction), &instruction, sizeof(Instruction));
+      break;
+    }
+    return image;
+  }
+
+}
+
+auto main() -> i32 {
+  ThreadPool pool;
+
+  Compiled compiled("module"sv, R"(
+    fn add(a: int, b: int) -> int {
+      return a + b;
+    }
+
+    fn main() -> int {
+      let x: int = add(1, 2);
+      return x * 3;
+    }
+  )"sv, pool);
+  check(compiled.errors.empty(), "the program compiles");
+
+  BytecodeCompiler compiler(compiled.analyzer, compiled.types);
+  if(compiled.errors.empty()) check(compiler.compile(compiled.program).empty(), "the program compiles to bytecode");
+
+  Module& module = compiler.module();
+  auto [image, errors] = ModuleFile::encode(module, compiled.file);
+  check(errors.empty() and not module.functions.empty(), "the module encodes");
+  if(not errors.empty() or module.functions.empty()) return status();
+
+  Function const& main = module.functions[0];
+  check(not refused(image, 0), "an intact function decodes");
+
+  const std::string path = (std::filesystem::temp_directory_path() / "fridayc-module-test.fxc").string();
+  check(ModuleFile::write(module, compiled.file, path).empty(), "the module is written");
+  {
+    auto [mapped, failures] = ModuleFile::load(path);
+    check(failures.empty() and mapped.file and mapped.functions.size() == module.functions.size(), "the written module maps back");
+    if(failures.empty() and mapped.file and not mapped.functions.empty()) {
+      Function function;
+      mapped.file->decode(0, function);
+      check(function.registers == main.registers and function.code.size() == main.code.size()
+        and std::memcmp(function.code.data(), main.code.data(), main.code.size() * sizeof(Instruction)) == 0, "a mapped function decodes as compiled");
+    }
+  }
+  std::filesystem::remove(path);
+
+  const std::string past_frame = damaged(image, main, [&main](Instruction& instruction) {
+    if(instruction.op != Opcode::RETURN) return false;
+    instruction.a = main.registers;
+    return true;
+  });
+  check(refused(past_frame, 0), "a register past the frame is refused");
+
+  const std::string past_window = damaged(image, main, [&main](Instruction& instruction) {
+    if(instruction.op != Opcode::CALL) return false;
+    instruction.a = instruction.c = main.registers - 1;
+    return true;
+  });
+  check(refused(past_window, 0), "arguments of a call past the frame are refused");
+
+  return status();
+}
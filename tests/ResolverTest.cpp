@@ -0,0 +1,58 @@
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Checks the bindings and frames the Resolver gives to functions.
+
+namespace {
+
+  auto function(Program& program, std::string_view name) -> FunctionStatement* {
+    for(auto& stmt : *program.block)
+      if(auto* declared = dynamic_cast<FunctionStatement*>(stmt.get()); declared and declared->name.view() == name) return declared;
+    return nullptr;
+  }
+
+}
+
+auto main() -> i32 {
+  ThreadPool pool;
+
+  Compiled frames("frames"sv, R"(
+    fn main(a: int) -> int {
+      let b: int = a;
+      if b > 0 {
+        let c: int = b;
+        b += c;
+      }
+      let d: int = b;
+      return d;
+    }
+  )"sv, pool);
+  check(frames.errors.empty(), "locals resolve");
+  FunctionStatement* main = function(frames.program, "main"sv);
+  check(main and main->frame_size == 3, "slots of a block are reused once it ends");
+
+  // * Nested declarations are reported, and the frame of the enclosing function is left whole
+  Compiled nested("nested"sv, R"(
+    fn main() -> int {
+      let before: int = 1;
+      fn inner(a: int) -> int {
+        return a + before;
+      }
+      struct Point {
+        x: int;
+      }
+      enum Color { RED, GREEN }
+      let after: int = 2;
+      return before + after;
+    }
+  )"sv, pool);
+  const auto rejected = std::ranges::count_if(nested.errors, [](Error const& error) { return error.message == "Nested declarations are not supported"sv; });
+  check(rejected == 3, "nested functions, structs and enums are reported");
+  check(not reports(nested.errors, "Undeclared identifier 'before'"sv), "the body of a nested function is not resolved");
+  FunctionStatement* outer = function(nested.program, "main"sv);
+  check(outer and outer->frame_size == 2, "locals after a nested function still count in the frame");
+
+  return status();
+}
@@ -0,0 +1,37 @@
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Builds spans of registered sources and checks lengths past 24 bits saturate instead of wrapping around.
+
+namespace {
+
+  auto spanAt(u32 file, u32 offset, u32 length) -> Span {
+    Span span;
+    span.file = file;
+    span.offset = offset;
+    span.length = length;
+    return span;
+  }
+
+}
+
+auto main() -> i32 {
+  const u32 file = Sources::add("large"s, std::string(Span::MAX_LENGTH + 1024, ' '));
+  const std::string_view text = Sources::text(file);
+
+  const Span word = Sources::spanOf(file, text.substr(10, 5));
+  check(word.offset == 10 and word.length == 5 and word.file == file, "a slice gets its offset and length");
+
+  const Span whole = Sources::spanOf(file, text);
+  check(whole.offset == 0 and whole.length == Span::MAX_LENGTH and whole.file == file, "a slice longer than 24 bits saturates");
+
+  const Span near = Span::join(spanAt(file, 10, 5), spanAt(file, 100, 3));
+  check(near.offset == 10 and near.length == 93 and near.file == file, "a join covers both spans");
+
+  const Span far = Span::join(spanAt(file, 10, 5), spanAt(file, Span::MAX_LENGTH + 100, 3));
+  check(far.offset == 10 and far.length == Span::MAX_LENGTH and far.file == file, "a join longer than 24 bits saturates");
+
+  return status();
+}
@@ -0,0 +1,192 @@
+#include "SsaBuilder.hpp"
+#include "SsaOptimizer.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Builds the SSA form of programs, verifies it after every pass of the optimizer and checks what
+// * the passes leave, then breaks built functions by hand and checks the verifier reports each one.
+
+namespace {
+
+  struct Optimized {
+    std::vector<Error> errors;
+    SsaOptimizer       optimizer;
+    std::string        dump;
+    ssa::Module        module;
+  };
+
+  auto optimize(std::string_view name, std::string_view source, ThreadPool& pool) -> Optimized {
+    Compiled compiled(name, source, pool);
+    check(compiled.errors.empty(), "{} compiles"f.format(name));
+    if(not compiled.errors.empty()) return { std::move(compiled.errors) };
+
+    Optimized optimized;
+    SsaBuilder builder(compiled.analyzer, compiled.types);
+    optimized.errors = builder.build(compiled.program);
+    if(optimized.errors.empty()) optimized.errors = builder.module().verify();
+    check(optimized.errors.empty(), "{} is built well formed"f.format(name));
+
+    if(optimized.errors.empty()) optimized.errors = optimized.optimizer.optimize(builder.module(), true);
+    for(Error const& error : optimized.errors) std::cerr << error.message << std::endl;
+    check(optimized.errors.empty(), "{} stays well formed after every pass"f.format(name));
+
+    std::ostringstream out;
+    builder.module().print(out, compiled.types);
+    optimized.dump = out.str();
+    optimized.module = std::move(builder.module());
+    return optimized;
+  }
+
+  auto counts(std::string_view dump, std::string_view text) -> u64 {
+    u64 found = 0;
+    for(u64 at = dump.find(text); at != std::string_view::npos; at = dump.find(text, at + 1)) ++found;
+    return found;
+  }
+
+  /// @brief Errors of a module broken by a change to its 'main'
+  auto broken(ssa::Module module, std::invocable<ssa::Function&> auto change) -> std::vector<Error> {
+    change(module.functions.front());
+    return module.verify();
+  }
+
+}
+
+auto main() -> i32 {
+  ThreadPool pool;
+
+  const Optimized loops = optimize("loops"sv, R"(
+    struct Point {
+      x: int;
+      y: int;
+    }
+
+    fn sum(n: int) -> int {
+      let total: int = 0;
+      let i: int = 0;
+      for i = 0; i < n; i += 1; {
+        if i % 2 == 0 and i != 4 {
+          total += i;
+        } else {
+          total -= 1;
+        }
+      }
+      while total > 100 or total < -100 {
+        total = total / 2;
+      }
+      return total;
+    }
+
+    fn main() -> int {
+      let p: Point = Point(1, 2);
+      let values: int[] = [3, 4];
+      let name: string = "a" + "b";
+      p.x = values[1] + sum(10);
+      print name;
+      return p.x + p.y;
+    }
+  )"sv, pool);
+  check(loops.optimizer.promotedSlots() > 0 and loops.optimizer.placedPhis() > 0, "locals of loops are promoted through phis");
+  check(not loops.dump.contains("slot"sv) and not loops.dump.contains("load"sv), "no slot is left once promoted");
+
+  const Optimized constant = optimize("constant"sv, R"(
+    fn main() -> int {
+      let a: int = 2;
+      let b: int = a * 3;
+      let unused: int = a + b;
+      if b > 5 {
+        return b;
+      }
+      return 0;
+    }
+  )"sv, pool);
+  check(constant.optimizer.foldedValues() > 0 and constant.optimizer.foldedBranches() == 1, "constants fold, and the branch on them");
+  check(constant.module.functions.size() == 1 and constant.module.functions.front().blocks.size() == 1, "the blocks of the folded branch are merged");
+  check(not constant.dump.contains("branch"sv) and not constant.dump.contains("mul"sv), "no operation is left to run");
+
+  const Optimized faulting = optimize("faulting"sv, R"(
+    fn main() -> int {
+      let zero: int = 0;
+      let unused: int = 7 / zero;
+      let same: int = 1 + 2;
+      return 0;
+    }
+  )"sv, pool);
+  check(counts(faulting.dump, "div"sv) == 1, "an unused division by zero is kept to fault");
+
+  const Optimized numbered = optimize("numbered"sv, R"(
+    fn f(a: int, b: int) -> int {
+      return (a * b) - (b * a);
+    }
+
+    fn main() -> int {
+      return f(2, 3);
+    }
+  )"sv, pool);
+  check(numbered.optimizer.numberedValues() == 1 and counts(numbered.dump, "mul"sv) == 1, "a commuted product is numbered like the first");
+
+  // * Every kind of damage is reported, against a function built well formed
+  if(loops.errors.empty()) {
+    const ssa::Module& module = loops.module;
+    auto reported = [](std::vector<Error> const& errors, std::string_view text) { return reports(errors, text) and errors.front().message.contains("Invalid SSA"sv); };
+
+    check(module.verify().empty(), "the optimized module verifies");
+    check(reported(broken(module, [](ssa::Function& function) {
+      function.remove(function.terminator(0));
+    }), "does not end with a terminator"sv), "a block without terminator is reported");
+
+    check(reported(broken(module, [](ssa::Function& function) {
+      const ssa::Value first = function.blocks[0].code.front();
+      function.values[first].operands.push_back(first);
+    }), "operands"sv), "a wrong operand count is reported");
+
+    check(reported(broken(module, [](ssa::Function& function) {
+      ssa::Instruction jump;
+      jump.op = ssa::Opcode::JUMP;
+      jump.blocks = { 0 };
+      function.insert(0, 0, std::move(jump));
+    }), "before its last instruction"sv), "a terminator in the middle of a block is reported");
+
+    check(reported(broken(module, [](ssa::Function& function) {
+      // * The sum reads the constant appended after it
+      ssa::Instruction sum;
+      sum.op = ssa::Opcode::ADD;
+      sum.type = ssa::Type::INT;
+      sum.operands = { (ssa::Value) function.values.size() + 1, (ssa::Value) function.values.size() + 1 };
+      function.insert(0, 0, std::move(sum));
+      ssa::Instruction one;
+      one.op = ssa::Opcode::CONSTANT;
+      one.type = ssa::Type::INT;
+      one.immediate = 1;
+      function.insert(0, 1, std::move(one));
+    }), "does not dominate"sv), "a use before the definition is reported");
+
+    check(reported(broken(module, [](ssa::Function& function) {
+      ssa::Instruction half;
+      half.op = ssa::Opcode::CONSTANT;
+      half.type = ssa::Type::FLOAT;
+      const ssa::Value value = function.insert(0, 0, std::move(half));
+      ssa::Instruction sum;
+      sum.op = ssa::Opcode::ADD;
+      sum.type = ssa::Type::INT;
+      sum.operands = { value, value };
+      function.insert(0, 1, std::move(sum));
+    }), "rather than int"sv), "an operand of the wrong type is reported");
+
+    const auto sum = std::ranges::find_if(module.functions, [](ssa::Function const& function) { return function.name.view() == "sum"sv; });
+    if(sum != module.functions.end()) {
+      ssa::Module copy = module;
+      ssa::Function& function = copy.functions[sum - module.functions.begin()];
+      const auto phi = std::ranges::find_if(function.values, [](ssa::Instruction const& instruction) { return instruction.op == ssa::Opcode::PHI and instruction.block != ssa::NONE; });
+      check(phi != function.values.end(), "the loop has a phi");
+      if(phi != function.values.end()) {
+        phi->operands.pop_back();
+        phi->blocks.pop_back();
+        check(reports(copy.verify(), "does not take one operand per predecessor"sv), "a phi missing a predecessor is reported");
+      }
+    }
+  }
+
+  return status();
+}
@@ -0,0 +1,105 @@
+#include "String.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::runtime;
+using namespace fridayc::test;
+
+// * Builds the same contents as inline, interned, flat and rope strings and checks they compare and
+// * hash alike, then grows strings from either end and checks every step keeps its own contents.
+
+namespace {
+
+  auto text(u64 length, char first = 'a') -> std::string {
+    std::string result(length, ' ');
+    for(u64 i = 0; i < length; ++i) result[i] = (char)(first + i % 26);
+    return result;
+  }
+
+  /// @brief Contents as two strings, the left one shorter so that joining them long makes a rope
+  auto split(std::string_view contents) -> std::pair<String, String> {
+    const u64 at = contents.size() / 5;
+    return { String(contents.substr(0, at)), String(contents.substr(at)) };
+  }
+
+}
+
+auto main() -> i32 {
+  using enum String::Storage;
+  check(String().kind() == SMALL and String().empty() and String().view().empty(), "the empty string is inline");
+  check(String(text(String::SMALL)).kind() == SMALL and String(text(String::SMALL + 1)).kind() == FLAT, "strings up to SMALL bytes are inline");
+  check(String::intern(text(5)).kind() == SMALL and String::intern(text(String::SMALL + 1)).kind() == INTERNED, "interning keeps short strings inline");
+  check(String::intern(text(40)) == String::intern(std::string(text(40))), "interning twice gives the same symbol");
+
+  const auto [small_left, small_right] = split("hello world"sv);
+  const String joined = small_left + small_right;
+  check(joined.kind() == SMALL and joined == String("hello world"sv) and joined.view() == "hello world"sv, "short strings join inline");
+
+  // * One contents, in every storage
+  const std::string contents = text(String::ROPE * 2);
+  const auto [left, right] = split(contents);
+  const String flat(contents), interned = String::intern(contents), rope = left + right;
+  const String grown = String(contents.substr(0, 300)) + String(contents.substr(300, 100)) + String(contents.substr(400));
+  check(rope.kind() == ROPE and flat.kind() == FLAT and interned.kind() == INTERNED and grown.kind() == FLAT, "each storage is made");
+
+  const std::array<String const*, 4> all { &flat, &interned, &rope, &grown };
+  bool equal = true, hashed = true;
+  for(String const* lhs : all)
+    for(String const* rhs : all) {
+      equal = equal and *lhs == *rhs and (*lhs <=> *rhs) == std::strong_ordering::equal;
+      hashed = hashed and std::hash<String>{}(*lhs) == std::hash<String>{}(*rhs);
+    }
+  check(equal, "the same contents are equal in every storage");
+  check(hashed, "the same contents hash alike in every storage");
+
+  // * Contents of the same length differing in one byte, in every storage
+  std::string changed = contents;
+  changed[contents.size() - 1] = '!';
+  const auto [changed_left, changed_right] = split(changed);
+  const std::array<String, 3> others { String(changed), String::intern(changed), changed_left + changed_right };
+  bool distinct = true;
+  for(String const* lhs : all)
+    for(String const& rhs : others) distinct = distinct and not (*lhs == rhs) and not (rhs == *lhs) and (*lhs <=> rhs) == std::strong_ordering::greater;
+  check(distinct, "contents differing in the last byte differ in every storage");
+  check(rope[contents.size() - 1] == contents.back() and rope.length() == contents.size(), "a rope is indexed");
+
+  // * s = s + x grows in place, the earlier steps keep their own prefix
+  String forward;
+  std::vector<String> steps;
+  std::string expected;
+  for(u32 i = 0; i < 5'000; ++i) {
+    const std::string piece = "{},"f.format(i);
+    forward = forward + String(piece);
+    expected += piece;
+    if(i % 500 == 0) steps.push_back(forward);
+  }
+  check(forward.view() == expected and forward.kind() == FLAT, "appending builds the string");
+  bool prefixes = true;
+  for(String const& step : steps) prefixes = prefixes and expected.starts_with(step.view()) and step.view().ends_with(',');
+  check(prefixes, "earlier steps keep their contents after later appends");
+
+  const String branch = steps[1] + String("branch"sv);
+  check(branch.view() == std::string(steps[1].view()) + "branch" and steps[2].view().starts_with(steps[1].view()) and steps[2].view()[steps[1].length()] != 'b',
+    "appending to an earlier step leaves the later ones alone");
+  check((forward + forward).view() == expected + expected, "a string appends to itself");
+
+  // * s = x + s builds a deep rope, flattened and released without recursion
+  String backward;
+  std::string reversed;
+  for(u32 i = 0; i < 200'000; ++i) {
+    backward = String("{}."f.format(i % 10)) + backward;
+    reversed.insert(0, "{}."f.format(i % 10));
+  }
+  const String copy = backward;
+  check(backward.kind() == ROPE and backward.length() == reversed.size(), "prepending makes a rope");
+  check(copy.view() == reversed and backward.view().data() == copy.view().data(), "copies of a rope share the flattened contents");
+  check(backward == String(reversed) and String::intern(reversed) == backward, "a rope equals its flat and interned contents");
+
+  String deep;
+  for(u32 i = 0; i < 200'000; ++i) deep = String("x"sv) + (deep + String(text(String::ROPE)));
+  check(deep.length() == 200'000 * (1 + String::ROPE), "a rope nested on both sides keeps its length");
+  deep = String();
+  check(deep.empty(), "a deep rope is released");
+
+  return status();
+}
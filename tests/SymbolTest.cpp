@@ -0,0 +1,51 @@
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Interns the same spellings from every worker of a pool at once and checks each spelling gets one symbol.
+
+auto main() -> i32 {
+  const Symbol none;
+  check(none.empty() and none.view().empty(), "the default symbol is empty");
+
+  const u64 before = Symbol::count();
+  constexpr u32 SPELLINGS = 20'000;
+  std::vector<std::string> spellings;
+  for(u32 i = 0; i < SPELLINGS; ++i) spellings.push_back("symbol_test_{}"f.format(i));
+
+  ThreadPool pool;
+  const u32 tasks = pool.size() * 4;
+  std::vector<std::vector<Symbol>> interned(tasks);
+  for(u32 task = 0; task < tasks; ++task) {
+    pool.submit([task, &spellings, &interned] {
+      // * Every task walks the spellings from another starting point, so the same ones race
+      std::vector<Symbol>& symbols = interned[task];
+      symbols.resize(spellings.size());
+      for(u32 i = 0; i < spellings.size(); ++i) {
+        const u32 at = (i + task * 997) % spellings.size();
+        symbols[at] = Symbol::intern(spellings[at]);
+      }
+    });
+  }
+  pool.wait();
+
+  check(Symbol::count() - before == SPELLINGS, "each spelling is stored once");
+  check(std::ranges::all_of(interned, [&](std::vector<Symbol> const& symbols) { return symbols == interned.front(); }), "every task gets the same symbols");
+
+  bool spelled = true;
+  std::unordered_set<u32> values;
+  for(u32 i = 0; i < SPELLINGS; ++i) {
+    spelled = spelled and interned.front()[i].view() == spellings[i];
+    values.insert(interned.front()[i].value());
+  }
+  check(spelled, "a symbol spells what was interned");
+  check(values.size() == SPELLINGS and not values.contains(0), "distinct spellings get distinct, non-empty symbols");
+  check(Symbol::intern(spellings.front()) == interned.front().front(), "interning again finds the symbol");
+
+  const std::string long_spelling(200'000, 'x');
+  const Symbol long_symbol = Symbol::intern(long_spelling);
+  check(long_symbol.view() == long_spelling and Symbol::intern(long_spelling) == long_symbol, "a spelling longer than a storage chunk is interned whole");
+
+  return status();
+}
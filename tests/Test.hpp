@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Tokenizer.hpp"
+#include "Parser.hpp"
+#include "Analyzer.hpp"
+#include "ThreadPool.hpp"
+
+// * Helpers of the regression tests. A test is an executable that makes its checks and exits
+// * with a non-zero status if any failed, after reporting each failure with the line it was made on.
+
+namespace fridayc::test {
+
+  inline u32 failures = 0;
+
+  /// @brief Reports a failed check
+  /// @param passed whether the check passed
+  /// @param what what was checked
+  inline auto check(bool passed, std::string_view what, std::source_location where = std::source_location::current()) -> void {
+    if(passed) return;
+    ++failures;
+    std::cerr << "{}:{}: {}"f.format(where.file_name(), where.line(), what) << std::endl;
+  }
+
+  /// @brief Exit status of the test, non-zero if a check failed
+  inline auto status() -> i32 {
+    if(failures) std::cerr << "{} checks failed"f.format(failures) << std::endl;
+    return failures ? 1 : 0;
+  }
+
+  /// @brief Tells whether one of some errors has a message containing a text
+  inline auto reports(std::vector<Error> const& errors, std::string_view text) -> bool {
+    return std::ranges::any_of(errors, [text](Error const& error) { return error.message.contains(text); });
+  }
+
+  /// @brief A program parsed and analyzed, with the errors of the phase that failed
+  struct Compiled {
+    u32                file     { Sources::NONE };
+    Program            program  { };
+    TypeTable          types    { };
+    Analyzer           analyzer;
+    std::vector<Error> errors   { };
+
+    /// @brief Parses and analyzes a program
+    /// @param name name of the source, as errors show it
+    /// @param source text of the program
+    /// @param pool the pool of the analysis
+    Compiled(std::string_view name, std::string_view source, ThreadPool& pool)
+      : analyzer { types, pool }
+    {
+      file = Sources::add(std::string(name), std::string(source));
+      std::tie(program, errors) = Parser(Tokenizer(Sources::text(file)).collect<std::vector>(), file).parse();
+      if(errors.empty()) errors = analyzer.analyze(program);
+    }
+  };
+
+}
@@ -0,0 +1,96 @@
+#include "TreeShaker.hpp"
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Shakes programs declaring more than their roots use, across a namespace and a 'using',
+// * and checks what is removed is counted and what is kept still compiles.
+
+namespace {
+
+  auto names(Program const& program) -> std::vector<std::string_view> {
+    std::vector<std::string_view> declared;
+    for(auto& stmt : *program.block) {
+      if(auto* function = dynamic_cast<FunctionStatement*>(stmt.get())) declared.push_back(function->name.view());
+      else if(auto* structure = dynamic_cast<StructStatement*>(stmt.get())) declared.push_back(structure->name.view());
+      else if(auto* enumeration = dynamic_cast<EnumStatement*>(stmt.get())) declared.push_back(enumeration->name.view());
+    }
+    return declared;
+  }
+
+  auto parse(std::string_view name, std::string_view source) -> Program {
+    const u32 file = Sources::add(std::string(name), std::string(source));
+    auto [program, errors] = Parser(Tokenizer(Sources::text(file)).collect<std::vector>(), file).parse();
+    check(errors.empty(), "{} parses"f.format(name));
+    return std::move(program);
+  }
+
+  constexpr std::string_view LIBRARY = R"(
+    namespace math;
+    using math;
+
+    enum Color { RED, GREEN }
+    enum Shade { DARK, LIGHT }
+
+    struct Point {
+      x: int;
+      y: int;
+    }
+
+    struct Segment {
+      from: Point;
+      to: Point;
+    }
+
+    fn square(x: int) -> int {
+      return x * x;
+    }
+
+    fn cube(x: int) -> int {
+      return x * square(x);
+    }
+
+    fn length(p: Point) -> int {
+      return math.square(p.x) + square(p.y);
+    }
+
+    fn main() -> int {
+      let c: Color = Color.RED;
+      return length(Point(3, 4));
+    }
+  )";
+
+}
+
+auto main() -> i32 {
+  Program program = parse("library"sv, LIBRARY);
+  const u64 statements = program.block->size();
+  TreeShaker shaker;
+  shaker.shake(program);
+
+  check(names(program) == std::vector{ "Color"sv, "Point"sv, "square"sv, "length"sv, "main"sv }, "what main reaches is kept in order");
+  check(shaker.removed() == 3 and program.block->size() == statements - 3, "the unused enum, struct and function are removed");
+  check(shaker.removedBytes() > "enum Shade { DARK, LIGHT }"sv.size() + "fn cube(x: int) -> int {}"sv.size(), "the bytes of the removed declarations are counted");
+  check(dynamic_cast<NamespaceStatement*>((*program.block)[0].get()) and dynamic_cast<UsingStatement*>((*program.block)[1].get()),
+    "namespace and using statements are kept");
+
+  // * The shaken program is analyzed as it would be by fridayc
+  ThreadPool pool;
+  TypeTable types;
+  Analyzer analyzer(types, pool);
+  check(analyzer.analyze(program).empty(), "the kept declarations still compile");
+
+  Program rooted = parse("rooted"sv, LIBRARY);
+  TreeShaker cubes({ Symbol::intern("cube"sv), Symbol::intern("Segment"sv) });
+  cubes.shake(rooted);
+  check(names(rooted) == std::vector{ "Point"sv, "Segment"sv, "square"sv, "cube"sv }, "configured roots keep what they use");
+  check(cubes.removed() == 4, "everything else is removed");
+
+  Program unrooted = parse("unrooted"sv, LIBRARY);
+  TreeShaker absent({ Symbol::intern("start"sv) });
+  absent.shake(unrooted);
+  check(absent.removed() == 0 and absent.removedBytes() == 0 and unrooted.block->size() == statements, "nothing is removed without a declared root");
+
+  return status();
+}
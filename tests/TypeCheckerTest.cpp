@@ -0,0 +1,37 @@
+#include "Test.hpp"
+
+using namespace fridayc;
+using namespace fridayc::test;
+
+// * Checks the types and type errors the TypeChecker finds in function bodies.
+
+auto main() -> i32 {
+  ThreadPool pool;
+
+  Compiled returns("returns"sv, R"(
+    fn half(n: int) -> float {
+      return n / 2;
+    }
+
+    fn main() -> int {
+      return 0;
+    }
+  )"sv, pool);
+  check(reports(returns.errors, "Expected 'float' for the value returned by 'half', got 'int'"sv), "returned values are checked against the signature");
+
+  // * A nested function is checked against its own signature, and the enclosing one is checked after it
+  Compiled nested("nested"sv, R"(
+    fn main() -> int {
+      let x: int = 1;
+      fn inner() -> int {
+        return true;
+      }
+      return x;
+    }
+  )"sv, pool);
+  check(reports(nested.errors, "Nested declarations are not supported"sv), "the nested function is reported");
+  check(reports(nested.errors, "Expected 'int' for the value returned by 'inner', got 'bool'"sv), "the nested function is checked against its signature");
+  check(not reports(nested.errors, "returned by 'main'"sv), "the enclosing function is checked against its own signature");
+
+  return status();
+}